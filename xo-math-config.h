@@ -38,6 +38,10 @@
 //      * A 16 byte aligned allocator can be provided to xo-math by advanced end users.
 //  XO_16ALIGNED_FREE(ptr)
 //      * A free method can be provided to xo-math by advanced end users.
+//  XO_ALIGNED_MALLOC(size, alignment) | XO_ALIGNED_FREE(ptr)
+//      * An allocator/free pair for larger alignments, used by stream types such as Vector3Stream. Define both or neither.
+//  XO_STREAM_ALIGNMENT
+//      * Byte alignment (and padding) of the arrays held by stream types. Defaults to 64, a cache line. Must be a multiple of 32.
 //  XO_EXPORT_ALL
 //      * Not for typical end users. This prevents the undefining of internal macros such as _XOINL or XO_INTERNAL for example.
 
@@ -25,1045 +25,5896 @@
 XOMATH_BEGIN_XO_NS();
 
 
-////////////////////////////////////////////////////////////////////////// Matrix4x4.cpp
+////////////////////////////////////////////////////////////////////////// AABB.cpp
 
-const Matrix4x4 Matrix4x4::Identity(Vector4(1.0f, 0.0f, 0.0f, 0.0f),
-                                    Vector4(0.0f, 1.0f, 0.0f, 0.0f),
-                                    Vector4(0.0f, 0.0f, 1.0f, 0.0f),
-                                    Vector4(0.0f, 0.0f, 0.0f, 1.0f));
+const AABB AABB::Empty(Vector3(std::numeric_limits<float>::infinity()), Vector3(-std::numeric_limits<float>::infinity()));
 
-const Matrix4x4 Matrix4x4::One(Vector4(1.0f, 1.0f, 1.0f, 1.0f),
-                               Vector4(1.0f, 1.0f, 1.0f, 1.0f),
-                               Vector4(1.0f, 1.0f, 1.0f, 1.0f),
-                               Vector4(1.0f, 1.0f, 1.0f, 1.0f));
+float AABB::SurfaceArea() const {
+    const Vector3 s = Size();
+    return 2.0f * (s.x * s.y + s.y * s.z + s.z * s.x);
+}
 
-const Matrix4x4 Matrix4x4::Zero(Vector4(0.0f, 0.0f, 0.0f, 0.0f),
-                                Vector4(0.0f, 0.0f, 0.0f, 0.0f),
-                                Vector4(0.0f, 0.0f, 0.0f, 0.0f),
-                                Vector4(0.0f, 0.0f, 0.0f, 0.0f));
+float AABB::Volume() const {
+    const Vector3 s = Size();
+    return s.x * s.y * s.z;
+}
 
-Matrix4x4::Matrix4x4() {
+AABB AABB::FromPoints(const Vector3* points, size_t count) {
+    if (count == 0) {
+        return Empty;
+    }
+    AABB box(points[0], points[0]);
+    for (size_t i = 1; i < count; ++i) {
+        box.Expand(points[i]);
+    }
+    return box;
+}
+
+void AABB::ClosestPoints(const Vector3Stream& points, Vector3Stream& outPoints, float* outDistancesSquared) const {
+    using namespace wide;
+    const size_t count = points.Size();
+    outPoints.Resize(count);
+    const Float3 lower = wide::Set(min.x, min.y, min.z), upper = wide::Set(max.x, max.y, max.z);
+    for (size_t i = 0; i < count; i += Width) {
+        const Float3 p = Load(points.X() + i, points.Y() + i, points.Z() + i);
+        Float3 closest;
+        closest.x = wide::Min(wide::Max(p.x, lower.x), upper.x);
+        closest.y = wide::Min(wide::Max(p.y, lower.y), upper.y);
+        closest.z = wide::Min(wide::Max(p.z, lower.z), upper.z);
+        Store(outPoints.X() + i, outPoints.Y() + i, outPoints.Z() + i, closest);
+        if (outDistancesSquared) {
+            const Float3 offset = Sub(p, closest);
+            if (i + Width <= count) {
+                StoreUnaligned(outDistancesSquared + i, Dot(offset, offset));
+            }
+            else {
+                StorePartial(outDistancesSquared + i, Dot(offset, offset), count - i);
+            }
+        }
+    }
 }
 
-Matrix4x4::Matrix4x4(float m)
+namespace
+{
+    // The matrix as Arvo's method uses it: half of each column and its absolute value, so that the new center is 
+    // half * (min + max) + translation and the new extents are |half| * (max - min), with no other scaling per box.
+    struct AABBTransformColumns {
+        AABBTransformColumns(const Matrix4x4& m) {
 #if defined(XO_SSE)
-{ 
-    r[0].xmm = r[1].xmm = r[2].xmm = r[3].xmm = _mm_set_ps1(m);
-}
+            __m128 c0 = m[0].xmm, c1 = m[1].xmm, c2 = m[2].xmm, c3 = m[3].xmm;
+            _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+            // Dropping the bottom row keeps the padding of every output corner at zero.
+            const __m128 mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+            const __m128 absMask = _mm_castsi128_ps(_mm_set_epi32(0, 0x7fffffff, 0x7fffffff, 0x7fffffff));
+            const __m128 half = _mm_set1_ps(0.5f);
+            half0 = _mm_mul_ps(c0, half);
+            half1 = _mm_mul_ps(c1, half);
+            half2 = _mm_mul_ps(c2, half);
+            abs0 = _mm_and_ps(half0, absMask);
+            abs1 = _mm_and_ps(half1, absMask);
+            abs2 = _mm_and_ps(half2, absMask);
+            half0 = _mm_and_ps(half0, mask);
+            half1 = _mm_and_ps(half1, mask);
+            half2 = _mm_and_ps(half2, mask);
+            translation = _mm_and_ps(c3, mask);
 #else
-{
-	r[0].Set(m);
-	r[1].Set(m);
-	r[2].Set(m);
-	r[3].Set(m);
-}
+            for (int r = 0; r < 3; ++r) {
+                for (int c = 0; c < 3; ++c) {
+                    half[r][c] = m(r, c) * 0.5f;
+                    abs[r][c] = Abs(half[r][c]);
+                }
+                translation[r] = m(r, 3);
+            }
 #endif
+        }
 
-Matrix4x4::Matrix4x4(float a0, float b0, float c0, float d0, float a1, float b1, float c1, float d1, float a2, float b2, float c2, float d2, float a3, float b3, float c3, float d3)
-{
-    r[0].Set(a0, b0, c0, d0);
-    r[1].Set(a1, b1, c1, d1);
-    r[2].Set(a2, b2, c2, d2);
-    r[3].Set(a3, b3, c3, d3);
+        _XOINL void Transform(const AABB& box, AABB& outBox) const {
+#if defined(XO_SSE)
+            const __m128 sum = _mm_add_ps(box.min.xmm, box.max.xmm);
+            const __m128 size = _mm_sub_ps(box.max.xmm, box.min.xmm);
+            __m128 center = sse::MulAdd(_mm_shuffle_ps(sum, sum, _MM_SHUFFLE(0, 0, 0, 0)), half0, translation);
+            __m128 extents = _mm_mul_ps(_mm_shuffle_ps(size, size, _MM_SHUFFLE(0, 0, 0, 0)), abs0);
+            center = sse::MulAdd(_mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1)), half1, center);
+            extents = sse::MulAdd(_mm_shuffle_ps(size, size, _MM_SHUFFLE(1, 1, 1, 1)), abs1, extents);
+            center = sse::MulAdd(_mm_shuffle_ps(sum, sum, _MM_SHUFFLE(2, 2, 2, 2)), half2, center);
+            extents = sse::MulAdd(_mm_shuffle_ps(size, size, _MM_SHUFFLE(2, 2, 2, 2)), abs2, extents);
+            outBox.min.xmm = _mm_sub_ps(center, extents);
+            outBox.max.xmm = _mm_add_ps(center, extents);
+#else
+            const float sum[3] = { box.min.x + box.max.x, box.min.y + box.max.y, box.min.z + box.max.z };
+            const float size[3] = { box.max.x - box.min.x, box.max.y - box.min.y, box.max.z - box.min.z };
+            for (int r = 0; r < 3; ++r) {
+                const float center = translation[r] + half[r][0] * sum[0] + half[r][1] * sum[1] + half[r][2] * sum[2];
+                const float extents = abs[r][0] * size[0] + abs[r][1] * size[1] + abs[r][2] * size[2];
+                outBox.min[r] = center - extents;
+                outBox.max[r] = center + extents;
+            }
+#endif
+        }
+
+#if defined(XO_SSE)
+        __m128 half0, half1, half2, abs0, abs1, abs2, translation;
+#else
+        float half[3][3];
+        float abs[3][3];
+        float translation[3];
+#endif
+    };
 }
 
-// TODO: couldn't this be faster with just a single copy?
-Matrix4x4::Matrix4x4(const Matrix4x4& m)
-{
-	r[0].Set(m.r[0]);
-	r[1].Set(m.r[1]);
-	r[2].Set(m.r[2]);
-	r[3].Set(m.r[3]);
+void AABB::Transform(const AABB& box, const Matrix4x4& m, AABB& outBox) {
+    AABBTransformColumns(m).Transform(box, outBox);
 }
 
-Matrix4x4::Matrix4x4(const Vector4& r0, const Vector4& r1, const Vector4& r2, const Vector4& r3)
-{
-	r[0].Set(r0);
-	r[1].Set(r1);
-	r[2].Set(r2);
-	r[3].Set(r3);
+void AABB::TransformArray(const Matrix4x4& m, const AABB* boxes, AABB* outBoxes, size_t count) {
+    const AABBTransformColumns columns(m);
+    for (size_t i = 0; i < count; ++i) {
+        columns.Transform(boxes[i], outBoxes[i]);
+    }
 }
 
-Matrix4x4::Matrix4x4(const Vector3& r0, const Vector3& r1, const Vector3& r2)
+
+////////////////////////////////////////////////////////////////////////// BoundingSphere.cpp
+
+const BoundingSphere BoundingSphere::Empty(Vector3(0.0f), -1.0f);
+
+namespace
 {
-	r[0].Set(r0);
-	r[1].Set(r1);
-	r[2].Set(r2);
-	r[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
-}
+    // Each thread gets at least this many points.
+    const size_t SphereThreadShare = 1 << 17;
+    // The wide passes track point indices in float lanes, which count exactly up to 2^24, so longer runs of points 
+    // are taken in blocks.
+    const size_t SphereBlockSize = 1 << 22;
+    // EPOS-14 finds extremes along the three axes and the four diagonals (1, 1, 1), (1, 1, -1), (1, -1, 1) and 
+    // (1, -1, -1). Ritter's method only uses the axes.
+    const int SphereAxisCount = 3;
+    const int SphereDirectionCount = 7;
+
+    // The point's projections onto the first D directions. The diagonals' components are all one or minus one, so 
+    // they need no multiplies. The directions aren't normalized, which leaves the extreme points unchanged.
+    template <int D>
+    _XOINL void SphereProject(float x, float y, float z, float* outDots) {
+        outDots[0] = x;
+        outDots[1] = y;
+        outDots[2] = z;
+        if (D > SphereAxisCount) {
+            const float xPlusY = x + y, xMinusY = x - y;
+            outDots[3] = xPlusY + z;
+            outDots[4] = xPlusY - z;
+            outDots[5] = xMinusY + z;
+            outDots[6] = xMinusY - z;
+        }
+    }
 
-Matrix4x4::Matrix4x4(const class Quaternion& q) {
-    Vector4* v4 = (Vector4*)&q;
-    Vector4 q2 = *v4 + *v4;
+    // The smallest and largest projections of a run of points onto each direction, and the points they came from.
+    struct SphereExtremes {
+        void Clear() {
+            for (int d = 0; d < SphereDirectionCount; ++d) {
+                min[d] = std::numeric_limits<float>::infinity();
+                max[d] = -std::numeric_limits<float>::infinity();
+                minIndex[d] = maxIndex[d] = 0;
+            }
+        }
+        void Add(const SphereExtremes& extremes) {
+            for (int d = 0; d < SphereDirectionCount; ++d) {
+                AddMin(d, extremes.min[d], extremes.minIndex[d]);
+                AddMax(d, extremes.max[d], extremes.maxIndex[d]);
+            }
+        }
+        void AddMin(int d, float dot, size_t index) {
+            if (dot < min[d]) {
+                min[d] = dot;
+                minIndex[d] = index;
+            }
+        }
+        void AddMax(int d, float dot, size_t index) {
+            if (dot > max[d]) {
+                max[d] = dot;
+                maxIndex[d] = index;
+            }
+        }
 
-    Vector4 qq2 = (*v4) * q2;
-    Vector4 wq2 = q2 * q.w;
+        float min[SphereDirectionCount];
+        float max[SphereDirectionCount];
+        size_t minIndex[SphereDirectionCount];
+        size_t maxIndex[SphereDirectionCount];
+    };
 
-    float xy2 = q.x * q2.y;
-    float xz2 = q.x * q2.z;
-    float yz2 = q.y * q2.z;
+#if defined(XO_SSE)
+    template <int D>
+    _XOINL void SphereProject(wide::Float x, wide::Float y, wide::Float z, wide::Float* outDots) {
+        using namespace wide;
+        outDots[0] = x;
+        outDots[1] = y;
+        outDots[2] = z;
+        if (D > SphereAxisCount) {
+            const Float xPlusY = Add(x, y), xMinusY = Sub(x, y);
+            outDots[3] = Add(xPlusY, z);
+            outDots[4] = Sub(xPlusY, z);
+            outDots[5] = Add(xMinusY, z);
+            outDots[6] = Sub(xMinusY, z);
+        }
+    }
 
-    r[0].Set( 1.0f - qq2.y - qq2.z,  xy2 + wq2.z,            xz2 - wq2.y,          0.0f);
-    r[1].Set( xy2 - wq2.z,           1.0f - qq2.x - qq2.z,   yz2 + wq2.x,          0.0f);
-    r[2].Set( xz2 + wq2.y,           yz2 - wq2.x,            1.0f - qq2.x - qq2.y, 0.0f);
-    r[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+    // Extremes of the points from begin, a multiple of wide::Width of them, kept per lane and reduced at the end.
+    template <int D>
+    void SphereWideExtremes(const Vector3* points, size_t begin, size_t end, SphereExtremes& inOutExtremes) {
+        using namespace wide;
+        _XOSIMDALIGN32 float lanes[Width];
+        for (int l = 0; l < Width; ++l) {
+            lanes[l] = (float)l;
+        }
+        Float min[D], max[D], minIndex[D], maxIndex[D];
+        for (int d = 0; d < D; ++d) {
+            min[d] = wide::Set(std::numeric_limits<float>::infinity());
+            max[d] = wide::Set(-std::numeric_limits<float>::infinity());
+            minIndex[d] = maxIndex[d] = Zero();
+        }
+        const Float step = wide::Set((float)Width);
+        Float index = Load(lanes);
+        for (size_t i = begin; i < end; i += Width) {
+            Float x, y, z, w, dots[D];
+            LoadTransposed4(&points[i].x, 4, x, y, z, w);
+            SphereProject<D>(x, y, z, dots);
+            for (int d = 0; d < D; ++d) {
+                minIndex[d] = Select(CmpLt(dots[d], min[d]), index, minIndex[d]);
+                maxIndex[d] = Select(CmpGt(dots[d], max[d]), index, maxIndex[d]);
+                min[d] = wide::Min(dots[d], min[d]);
+                max[d] = wide::Max(dots[d], max[d]);
+            }
+            index = Add(index, step);
+        }
+        _XOSIMDALIGN32 float dot[Width], at[Width];
+        for (int d = 0; d < D; ++d) {
+            Store(dot, min[d]);
+            Store(at, minIndex[d]);
+            for (int l = 0; l < Width; ++l) {
+                inOutExtremes.AddMin(d, dot[l], begin + (size_t)at[l]);
+            }
+            Store(dot, max[d]);
+            Store(at, maxIndex[d]);
+            for (int l = 0; l < Width; ++l) {
+                inOutExtremes.AddMax(d, dot[l], begin + (size_t)at[l]);
+            }
+        }
+    }
+#endif
+
+    template <int D>
+    void SphereFindExtremes(const Vector3* points, size_t begin, size_t end, SphereExtremes& outExtremes) {
+        outExtremes.Clear();
+        size_t i = begin;
+#if defined(XO_SSE)
+        while (end - i >= (size_t)wide::Width) {
+            const size_t blockEnd = i + _XO_MIN((end - i) / wide::Width * wide::Width, SphereBlockSize);
+            SphereWideExtremes<D>(points, i, blockEnd, outExtremes);
+            i = blockEnd;
+        }
+#endif
+        for (; i < end; ++i) {
+            float dots[SphereDirectionCount];
+            SphereProject<D>(points[i].x, points[i].y, points[i].z, dots);
+            for (int d = 0; d < D; ++d) {
+                outExtremes.AddMin(d, dots[d], i);
+                outExtremes.AddMax(d, dots[d], i);
+            }
+        }
+    }
+
+    // Ritter's growth step, on raw floats to keep Vector3's constructors out of the loop.
+    _XOINL void SphereGrowTo(const Vector3& point, float* center, float& radius) {
+        const float dx = point.x - center[0], dy = point.y - center[1], dz = point.z - center[2];
+        const float distanceSquared = dx * dx + dy * dy + dz * dz;
+        if (distanceSquared > radius * radius) {
+            const float distance = Sqrt(distanceSquared);
+            const float grownRadius = (radius + distance) * 0.5f;
+            const float move = (grownRadius - radius) / distance;
+            center[0] += dx * move;
+            center[1] += dy * move;
+            center[2] += dz * move;
+            radius = grownRadius;
+        }
+    }
+
+    // Grows the sphere over the points from begin to end. Only the rare points found outside it take the scalar path.
+    void SphereGrow(const Vector3* points, size_t begin, size_t end, float* center, float& radius) {
+        size_t i = begin;
+#if defined(XO_SSE)
+        using namespace wide;
+        Float x0 = wide::Set(center[0]), y0 = wide::Set(center[1]), z0 = wide::Set(center[2]), radiusSquared = wide::Set(radius * radius);
+        for (; end - i >= (size_t)Width; i += Width) {
+            Float x, y, z, w;
+            LoadTransposed4(&points[i].x, 4, x, y, z, w);
+            x = Sub(x, x0);
+            y = Sub(y, y0);
+            z = Sub(z, z0);
+            const int outside = MoveMask(CmpGt(MulAdd(z, z, MulAdd(y, y, Mul(x, x))), radiusSquared));
+            if (outside) {
+                for (int l = 0; l < Width; ++l) {
+                    if (outside & (1 << l)) {
+                        SphereGrowTo(points[i + l], center, radius);
+                    }
+                }
+                x0 = wide::Set(center[0]);
+                y0 = wide::Set(center[1]);
+                z0 = wide::Set(center[2]);
+                radiusSquared = wide::Set(radius * radius);
+            }
+        }
+#endif
+        for (; i < end; ++i) {
+            SphereGrowTo(points[i], center, radius);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////// Welzl's algorithm
+
+    // A sphere in double precision, with its squared radius negative when empty.
+    struct SphereBall {
+        bool Outside(const double* p) const {
+            const double dx = p[0] - center[0], dy = p[1] - center[1], dz = p[2] - center[2];
+            // the tolerance keeps points on the surface from being taken as new support points over rounding.
+            return dx * dx + dy * dy + dz * dz > radiusSquared * (1.0 + 1e-9);
+        }
+
+        double center[3];
+        double radiusSquared;
+    };
+
+    _XOINL void SphereSub(const double* a, const double* b, double* out) {
+        out[0] = a[0] - b[0];
+        out[1] = a[1] - b[1];
+        out[2] = a[2] - b[2];
+    }
+    _XOINL void SphereCross(const double* a, const double* b, double* out) {
+        out[0] = a[1] * b[2] - a[2] * b[1];
+        out[1] = a[2] * b[0] - a[0] * b[2];
+        out[2] = a[0] * b[1] - a[1] * b[0];
+    }
+    _XOINL double SphereDot(const double* a, const double* b) {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+
+    // The sphere centered at a + offset, passing through a.
+    SphereBall SphereBallAt(const double* a, const double* offset) {
+        SphereBall ball;
+        for (int axis = 0; axis < 3; ++axis) {
+            ball.center[axis] = a[axis] + offset[axis];
+        }
+        ball.radiusSquared = SphereDot(offset, offset);
+        return ball;
+    }
+
+    SphereBall SphereThrough2(const double* a, const double* b) {
+        double offset[3];
+        SphereSub(b, a, offset);
+        for (int axis = 0; axis < 3; ++axis) {
+            offset[axis] *= 0.5;
+        }
+        return SphereBallAt(a, offset);
+    }
+
+    // The smallest sphere through all three points: the circumcircle of their triangle, or the sphere around the two 
+    // farthest apart when they're on a line.
+    SphereBall SphereThrough3(const double* a, const double* b, const double* c) {
+        double u[3], v[3], n[3];
+        SphereSub(b, a, u);
+        SphereSub(c, a, v);
+        SphereCross(u, v, n);
+        const double uu = SphereDot(u, u), vv = SphereDot(v, v), nn = SphereDot(n, n);
+        if (nn <= uu * vv * 1e-14) {
+            double w[3];
+            SphereSub(c, b, w);
+            const double ww = SphereDot(w, w);
+            if (uu >= vv && uu >= ww) {
+                return SphereThrough2(a, b);
+            }
+            return vv >= ww ? SphereThrough2(a, c) : SphereThrough2(b, c);
+        }
+        // center - a = (|u|^2 (v x n) + |v|^2 (n x u)) / 2|n|^2
+        double vn[3], nu[3], offset[3];
+        SphereCross(v, n, vn);
+        SphereCross(n, u, nu);
+        for (int axis = 0; axis < 3; ++axis) {
+            offset[axis] = (uu * vn[axis] + vv * nu[axis]) / (2.0 * nn);
+        }
+        return SphereBallAt(a, offset);
+    }
+
+    // The sphere through all four points. When they're on a plane there may be none, and the smallest sphere 
+    // through three of them holding the fourth is used instead, or failing that the largest.
+    SphereBall SphereThrough4(const double* a, const double* b, const double* c, const double* d) {
+        double u[3], v[3], w[3], vw[3], wu[3], uv[3];
+        SphereSub(b, a, u);
+        SphereSub(c, a, v);
+        SphereSub(d, a, w);
+        SphereCross(v, w, vw);
+        SphereCross(w, u, wu);
+        SphereCross(u, v, uv);
+        const double uu = SphereDot(u, u), vv = SphereDot(v, v), ww = SphereDot(w, w);
+        const double volume = SphereDot(u, vw);
+        if (volume * volume > uu * vv * ww * 1e-20) {
+            // center - a = (|u|^2 (v x w) + |v|^2 (w x u) + |w|^2 (u x v)) / 2 (u . (v x w))
+            double offset[3];
+            for (int axis = 0; axis < 3; ++axis) {
+                offset[axis] = (uu * vw[axis] + vv * wu[axis] + ww * uv[axis]) / (2.0 * volume);
+            }
+            return SphereBallAt(a, offset);
+        }
+        const double* points[4] = { a, b, c, d };
+        SphereBall best, largest;
+        best.radiusSquared = std::numeric_limits<double>::infinity();
+        largest.radiusSquared = -1.0;
+        for (int skip = 0; skip < 4; ++skip) {
+            const SphereBall ball = SphereThrough3(points[skip == 0 ? 1 : 0], points[skip <= 1 ? 2 : 1], points[skip <= 2 ? 3 : 2]);
+            if (!ball.Outside(points[skip]) && ball.radiusSquared < best.radiusSquared) {
+                best = ball;
+            }
+            if (ball.radiusSquared > largest.radiusSquared) {
+                largest = ball;
+            }
+        }
+        return best.radiusSquared < std::numeric_limits<double>::infinity() ? best : largest;
+    }
+
+    SphereBall SphereThrough(const double (*support)[3], int supportCount) {
+        SphereBall ball;
+        switch (supportCount) {
+        case 0:
+            ball.center[0] = ball.center[1] = ball.center[2] = 0.0;
+            ball.radiusSquared = -1.0;
+            return ball;
+        case 1:
+            ball.center[0] = support[0][0];
+            ball.center[1] = support[0][1];
+            ball.center[2] = support[0][2];
+            ball.radiusSquared = 0.0;
+            return ball;
+        case 2:
+            return SphereThrough2(support[0], support[1]);
+        case 3:
+            return SphereThrough3(support[0], support[1], support[2]);
+        default:
+            return SphereThrough4(support[0], support[1], support[2], support[3]);
+        }
+    }
+
+    // The smallest sphere holding the first count points with every support point on its surface. Each point found 
+    // outside the sphere so far must be on the surface of the final one, and becomes a support point for the 
+    // sphere around the points before it.
+    SphereBall SphereWelzl(const Vector3* points, size_t count, double (*support)[3], int supportCount) {
+        SphereBall ball = SphereThrough(support, supportCount);
+        if (supportCount == 4) {
+            return ball;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            const double p[3] = { points[i].x, points[i].y, points[i].z };
+            if (ball.Outside(p)) {
+                support[supportCount][0] = p[0];
+                support[supportCount][1] = p[1];
+                support[supportCount][2] = p[2];
+                ball = SphereWelzl(points, i, support, supportCount + 1);
+            }
+        }
+        return ball;
+    }
+
+    ////////////////////////////////////////////////////////////////////////// Fitting
+
+    // Finds the starting sphere from the extremes of every point, then grows it over them.
+    template <int D>
+    BoundingSphere SphereFit(const Vector3* points, size_t count, unsigned threadCount) {
+        if (!count) {
+            return BoundingSphere::Empty;
+        }
+        const unsigned threads = xo_internal::ThreadCount(threadCount, count, SphereThreadShare);
+        const size_t share = (count + threads - 1) / threads;
+
+        SphereExtremes extremes[xo_internal::MaxThreads];
+        xo_internal::Parallel(threads, [&](unsigned t) {
+            SphereFindExtremes<D>(points, _XO_MIN(share * t, count), _XO_MIN(share * (t + 1), count), extremes[t]);
+        });
+        for (unsigned t = 1; t < threads; ++t) {
+            extremes[0].Add(extremes[t]);
+        }
+
+        float center[3] = { points[0].x, points[0].y, points[0].z }, radius = 0.0f;
+        if (D == SphereAxisCount) {
+            // Ritter: the sphere around the farthest apart pair.
+            float farthest = -1.0f;
+            for (int d = 0; d < D; ++d) {
+                const Vector3& a = points[extremes[0].minIndex[d]];
+                const Vector3& b = points[extremes[0].maxIndex[d]];
+                const float distanceSquared = Vector3::DistanceSquared(a, b);
+                if (distanceSquared > farthest) {
+                    farthest = distanceSquared;
+                    center[0] = (a.x + b.x) * 0.5f;
+                    center[1] = (a.y + b.y) * 0.5f;
+                    center[2] = (a.z + b.z) * 0.5f;
+                    radius = Sqrt(distanceSquared) * 0.5f;
+                }
+            }
+        }
+        else {
+            // EPOS: the smallest sphere around all the extreme points.
+            Vector3 extremePoints[SphereDirectionCount * 2];
+            for (int d = 0; d < D; ++d) {
+                extremePoints[d * 2] = points[extremes[0].minIndex[d]];
+                extremePoints[d * 2 + 1] = points[extremes[0].maxIndex[d]];
+            }
+            double support[4][3];
+            const SphereBall ball = SphereWelzl(extremePoints, D * 2, support, 0);
+            center[0] = (float)ball.center[0];
+            center[1] = (float)ball.center[1];
+            center[2] = (float)ball.center[2];
+            radius = (float)sqrt(ball.radiusSquared);
+        }
+
+        BoundingSphere grown[xo_internal::MaxThreads];
+        xo_internal::Parallel(threads, [&](unsigned t) {
+            float threadCenter[3] = { center[0], center[1], center[2] };
+            float threadRadius = radius;
+            SphereGrow(points, _XO_MIN(share * t, count), _XO_MIN(share * (t + 1), count), threadCenter, threadRadius);
+            grown[t].Set(Vector3(threadCenter[0], threadCenter[1], threadCenter[2]), threadRadius);
+        });
+        for (unsigned t = 1; t < threads; ++t) {
+            grown[0].Expand(grown[t]);
+        }
+        return grown[0];
+    }
 }
 
-const Vector4& Matrix4x4::GetRow(int i) const {
-    return r[i];
+BoundingSphere BoundingSphere::FromPoints(const Vector3* points, size_t count, unsigned threadCount) {
+    return SphereFit<SphereDirectionCount>(points, count, threadCount);
 }
 
-Vector4 Matrix4x4::GetColumn(int i) const {
-    return Vector4(r[0][i], r[1][i], r[2][i], r[3][i]);
+BoundingSphere BoundingSphere::FromPointsRitter(const Vector3* points, size_t count, unsigned threadCount) {
+    return SphereFit<SphereAxisCount>(points, count, threadCount);
+}
+
+BoundingSphere BoundingSphere::FromPointsExact(const Vector3* points, size_t count) {
+    if (!count) {
+        return Empty;
+    }
+    double support[4][3];
+    const SphereBall ball = SphereWelzl(points, count, support, 0);
+    // Rounding to float can leave a support point just outside, so the radius is taken from the farthest point.
+    const Vector3 center((float)ball.center[0], (float)ball.center[1], (float)ball.center[2]);
+    float farthest = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        farthest = Max(farthest, Vector3::DistanceSquared(center, points[i]));
+    }
+    return BoundingSphere(center, Sqrt(farthest));
 }
 
+
+////////////////////////////////////////////////////////////////////////// BVH.cpp
+
 namespace
 {
+    const int BVHBinCount = 16;
+    // Ranges with at least this many primitives are binned by all of their subtree's threads.
+    const size_t BVHParallelBinning = 1 << 16;
+    // Nodes with at least this many primitives build their children on separate threads.
+    const size_t BVHParallelSubtree = 1 << 12;
+    // Deeper ranges are split in half by count instead of by SAH. This bounds the depth of the tree, and so the size 
+    // of the traversal stacks, even for primitives the heuristic can't separate.
+    const int BVHMaxSahDepth = 48;
+    const int BVHStackSize = 256;
+
+    // Primitives are binned by the centers of their boxes, kept doubled (min + max) to save the multiply. The build's 
+    // inner loops keep centroids in raw lanes rather than in a Vector3, whose constructors aren't inline.
 #if defined(XO_SSE)
-    _XOINL void EarlyInverse(__m128& minor0, __m128& minor1, __m128& minor2, __m128& minor3,
-                             __m128& row0, __m128& row1, __m128& row2, __m128& row3,
-                             __m128& det, __m128& tmp1, float m[16])
-    {
-        // http://download.intel.com/design/PentiumIII/sml/24504301.pdf
-        // http://stackoverflow.com/questions/18743531/sse-half-loads-mm-loadh-pi-mm-loadl-pi-issue-warnings
-#   define _fake_initialization() _mm_setzero_ps()
+    typedef __m128 BVHPoint;
 
-        tmp1 = _mm_loadh_pi(_mm_loadl_pi(_fake_initialization(), (__m64*)(m)), (__m64*)(m + 4));
-        row1 = _mm_loadh_pi(_mm_loadl_pi(_fake_initialization(), (__m64*)(m + 8)), (__m64*)(m + 12));
-        row0 = _mm_shuffle_ps(tmp1, row1, 0x88);
-        row1 = _mm_shuffle_ps(row1, tmp1, 0xDD);
-        tmp1 = _mm_loadh_pi(_mm_loadl_pi(tmp1, (__m64*)(m + 2)), (__m64*)(m + 6));
-        row3 = _mm_loadh_pi(_mm_loadl_pi(_fake_initialization(), (__m64*)(m + 10)), (__m64*)(m + 14));
-        row2 = _mm_shuffle_ps(tmp1, row3, 0x88);
-        row3 = _mm_shuffle_ps(row3, tmp1, 0xDD);
-        // -----------------------------------------------
-        tmp1 = _mm_mul_ps(row2, row3);
-        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
-        minor0 = _mm_mul_ps(row1, tmp1);
-        minor1 = _mm_mul_ps(row0, tmp1);
-        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
-        minor0 = _mm_sub_ps(_mm_mul_ps(row1, tmp1), minor0);
-        minor1 = _mm_sub_ps(_mm_mul_ps(row0, tmp1), minor1);
-        minor1 = _mm_shuffle_ps(minor1, minor1, 0x4E);
-        // -----------------------------------------------
-        tmp1 = _mm_mul_ps(row1, row2);
-        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
-        minor0 = _mm_add_ps(_mm_mul_ps(row3, tmp1), minor0);
-        minor3 = _mm_mul_ps(row0, tmp1);
-        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
-        minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row3, tmp1));
-        minor3 = _mm_sub_ps(_mm_mul_ps(row0, tmp1), minor3);
-        minor3 = _mm_shuffle_ps(minor3, minor3, 0x4E);
-        // -----------------------------------------------
-        tmp1 = _mm_mul_ps(_mm_shuffle_ps(row1, row1, 0x4E), row3);
-        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
-        row2 = _mm_shuffle_ps(row2, row2, 0x4E);
-        minor0 = _mm_add_ps(_mm_mul_ps(row2, tmp1), minor0);
-        minor2 = _mm_mul_ps(row0, tmp1);
-        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
-        minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row2, tmp1));
-        minor2 = _mm_sub_ps(_mm_mul_ps(row0, tmp1), minor2);
-        minor2 = _mm_shuffle_ps(minor2, minor2, 0x4E);
-        // -----------------------------------------------
-        tmp1 = _mm_mul_ps(row0, row1);
-        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
-        minor2 = _mm_add_ps(_mm_mul_ps(row3, tmp1), minor2);
-        minor3 = _mm_sub_ps(_mm_mul_ps(row2, tmp1), minor3);
-        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
-        minor2 = _mm_sub_ps(_mm_mul_ps(row3, tmp1), minor2);
-        minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row2, tmp1));
-        // -----------------------------------------------
-        tmp1 = _mm_mul_ps(row0, row3);
-        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
-        minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row2, tmp1));
-        minor2 = _mm_add_ps(_mm_mul_ps(row1, tmp1), minor2);
-        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
-        minor1 = _mm_add_ps(_mm_mul_ps(row2, tmp1), minor1);
-        minor2 = _mm_sub_ps(minor2, _mm_mul_ps(row1, tmp1));
-        // -----------------------------------------------
-        tmp1 = _mm_mul_ps(row0, row2);
-        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
-        minor1 = _mm_add_ps(_mm_mul_ps(row3, tmp1), minor1);
-        minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row1, tmp1));
-        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
-        minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row3, tmp1));
-        minor3 = _mm_add_ps(_mm_mul_ps(row1, tmp1), minor3);
-        // -----------------------------------------------
-        det = _mm_mul_ps(row0, minor0);
-        det = _mm_add_ps(_mm_shuffle_ps(det, det, 0x4E), det);
-        det = _mm_add_ss(_mm_shuffle_ps(det, det, 0xB1), det);
-#   undef _fake_initialization
+    _XOINL BVHPoint BVHCentroid(const AABB& box) {
+        return _mm_add_ps(box.min.xmm, box.max.xmm);
     }
-
-    _XOINL void LateInverse(__m128& minor0, __m128& minor1, __m128& minor2, __m128& minor3,
-                            __m128& det, __m128& tmp1, float m[16])
-    {
-        // http://download.intel.com/design/PentiumIII/sml/24504301.pdf
-        tmp1 = _mm_rcp_ss(det);
-        det = _mm_sub_ss(_mm_add_ss(tmp1, tmp1), _mm_mul_ss(det, _mm_mul_ss(tmp1, tmp1)));
-        det = _mm_shuffle_ps(det, det, 0x00);
-        minor0 = _mm_mul_ps(det, minor0);
-        _mm_storel_pi((__m64*)(m), minor0);
-        _mm_storeh_pi((__m64*)(m + 2), minor0);
-        minor1 = _mm_mul_ps(det, minor1);
-        _mm_storel_pi((__m64*)(m + 4), minor1);
-        _mm_storeh_pi((__m64*)(m + 6), minor1);
-        minor2 = _mm_mul_ps(det, minor2);
-        _mm_storel_pi((__m64*)(m + 8), minor2);
-        _mm_storeh_pi((__m64*)(m + 10), minor2);
-        minor3 = _mm_mul_ps(det, minor3);
-        _mm_storel_pi((__m64*)(m + 12), minor3);
-        _mm_storeh_pi((__m64*)(m + 14), minor3);
+    _XOINL void BVHExpand(AABB& box, BVHPoint p) {
+        box.min.xmm = _mm_min_ps(box.min.xmm, p);
+        box.max.xmm = _mm_max_ps(box.max.xmm, p);
+    }
+    // (p - offset) * scale, no greater than last, truncated to int on each axis.
+    _XOINL void BVHBinIndices(BVHPoint p, const Vector3& offset, const Vector3& scale, const Vector3& last, int* outBins) {
+        _mm_storeu_si128((__m128i*)outBins, _mm_cvttps_epi32(_mm_min_ps(_mm_mul_ps(_mm_sub_ps(p, offset.xmm), scale.xmm), last.xmm)));
     }
 #else
-    _XOINL void EarlyInverse(float tmp[12], float src[16], float& det, float m[16])
-    {
-        // http://download.intel.com/design/PentiumIII/sml/24504301.pdf
-        // transpose matrix
-        for (int i = 0; i < 4; i++)
-        {
-            src[i] = m[i * 4];
-            src[i + 4] = m[i * 4 + 1];
-            src[i + 8] = m[i * 4 + 2];
-            src[i + 12] = m[i * 4 + 3];
+    struct BVHPoint {
+        float f[3];
+    };
+
+    _XOINL BVHPoint BVHCentroid(const AABB& box) {
+        BVHPoint p = { { box.min.x + box.max.x, box.min.y + box.max.y, box.min.z + box.max.z } };
+        return p;
+    }
+    _XOINL void BVHExpand(AABB& box, BVHPoint p) {
+        for (int axis = 0; axis < 3; ++axis) {
+            box.min[axis] = Min(box.min[axis], p.f[axis]);
+            box.max[axis] = Max(box.max[axis], p.f[axis]);
+        }
+    }
+    _XOINL void BVHBinIndices(BVHPoint p, const Vector3& offset, const Vector3& scale, const Vector3& last, int* outBins) {
+        for (int axis = 0; axis < 3; ++axis) {
+            outBins[axis] = (int)Min((p.f[axis] - offset[axis]) * scale[axis], last[axis]);
         }
-        // calculate pairs for first 8 elements (cofactors)
-        tmp[0] = src[10] * src[15];
-        tmp[1] = src[11] * src[14];
-        tmp[2] = src[9] * src[15];
-        tmp[3] = src[11] * src[13];
-        tmp[4] = src[9] * src[14];
-        tmp[5] = src[10] * src[13];
-        tmp[6] = src[8] * src[15];
-        tmp[7] = src[11] * src[12];
-        tmp[8] = src[8] * src[14];
-        tmp[9] = src[10] * src[12];
-        tmp[10] = src[8] * src[13];
-        tmp[11] = src[9] * src[12];
-        // calculate first 8 elements (cofactors)
-        m[0] = tmp[0] * src[5] + tmp[3] * src[6] + tmp[4] * src[7];
-        m[0] -= tmp[1] * src[5] + tmp[2] * src[6] + tmp[5] * src[7];
-        m[1] = tmp[1] * src[4] + tmp[6] * src[6] + tmp[9] * src[7];
-        m[1] -= tmp[0] * src[4] + tmp[7] * src[6] + tmp[8] * src[7];
-        m[2] = tmp[2] * src[4] + tmp[7] * src[5] + tmp[10] * src[7];
-        m[2] -= tmp[3] * src[4] + tmp[6] * src[5] + tmp[11] * src[7];
-        m[3] = tmp[5] * src[4] + tmp[8] * src[5] + tmp[11] * src[6];
-        m[3] -= tmp[4] * src[4] + tmp[9] * src[5] + tmp[10] * src[6];
-        m[4] = tmp[1] * src[1] + tmp[2] * src[2] + tmp[5] * src[3];
-        m[4] -= tmp[0] * src[1] + tmp[3] * src[2] + tmp[4] * src[3];
-        m[5] = tmp[0] * src[0] + tmp[7] * src[2] + tmp[8] * src[3];
-        m[5] -= tmp[1] * src[0] + tmp[6] * src[2] + tmp[9] * src[3];
-        m[6] = tmp[3] * src[0] + tmp[6] * src[1] + tmp[11] * src[3];
-        m[6] -= tmp[2] * src[0] + tmp[7] * src[1] + tmp[10] * src[3];
-        m[7] = tmp[4] * src[0] + tmp[9] * src[1] + tmp[10] * src[2];
-        m[7] -= tmp[5] * src[0] + tmp[8] * src[1] + tmp[11] * src[2];
-        // calculate pairs for second 8 elements (cofactors)
-        tmp[0] = src[2] * src[7];
-        tmp[1] = src[3] * src[6];
-        tmp[2] = src[1] * src[7];
-        tmp[3] = src[3] * src[5];
-        tmp[4] = src[1] * src[6];
-        tmp[5] = src[2] * src[5];
-        tmp[6] = src[0] * src[7];
-        tmp[7] = src[3] * src[4];
-        tmp[8] = src[0] * src[6];
-        tmp[9] = src[2] * src[4];
-        tmp[10] = src[0] * src[5];
-        tmp[11] = src[1] * src[4];
-        // calculate second 8 elements (cofactors)
-        m[8] = tmp[0] * src[13] + tmp[3] * src[14] + tmp[4] * src[15];
-        m[8] -= tmp[1] * src[13] + tmp[2] * src[14] + tmp[5] * src[15];
-        m[9] = tmp[1] * src[12] + tmp[6] * src[14] + tmp[9] * src[15];
-        m[9] -= tmp[0] * src[12] + tmp[7] * src[14] + tmp[8] * src[15];
-        m[10] = tmp[2] * src[12] + tmp[7] * src[13] + tmp[10] * src[15];
-        m[10] -= tmp[3] * src[12] + tmp[6] * src[13] + tmp[11] * src[15];
-        m[11] = tmp[5] * src[12] + tmp[8] * src[13] + tmp[11] * src[14];
-        m[11] -= tmp[4] * src[12] + tmp[9] * src[13] + tmp[10] * src[14];
-        m[12] = tmp[2] * src[10] + tmp[5] * src[11] + tmp[1] * src[9];
-        m[12] -= tmp[4] * src[11] + tmp[0] * src[9] + tmp[3] * src[10];
-        m[13] = tmp[8] * src[11] + tmp[0] * src[8] + tmp[7] * src[10];
-        m[13] -= tmp[6] * src[10] + tmp[9] * src[11] + tmp[1] * src[8];
-        m[14] = tmp[6] * src[9] + tmp[11] * src[11] + tmp[3] * src[8];
-        m[14] -= tmp[10] * src[11] + tmp[2] * src[8] + tmp[7] * src[9];
-        m[15] = tmp[10] * src[10] + tmp[4] * src[8] + tmp[9] * src[9];
-        m[15] -= tmp[8] * src[9] + tmp[11] * src[10] + tmp[5] * src[8];
-        // calculate determinant
-        det = src[0] * m[0] + src[1] * m[1] + src[2] * m[2] + src[3] * m[3];
     }
+#endif
 
-    _XOINL void LateInverse(float &det, float m[16])
-    {
-        // http://download.intel.com/design/PentiumIII/sml/24504301.pdf
-        // calculate matrix inverse 
-        det = 1 / det;
-        for (int j = 0; j < 16; j++)
-            m[j] *= det;
+    struct BVHBin {
+        void Clear() {
+            bounds = AABB::Empty;
+            count = 0;
+        }
+        void Add(const BVHBin& bin) {
+            bounds.Expand(bin.bounds);
+            count += bin.count;
+        }
+
+        AABB bounds;
+        size_t count;
+    };
+
+    // The primitives from begin to end, with the box around them and the box around their centroids.
+    struct BVHRange {
+        size_t Count() const { return end - begin; }
+
+        AABB bounds;
+        AABB centroids;
+        size_t begin;
+        size_t end;
+    };
+
+    void BVHRangeBounds(const AABB* boxes, BVHRange& range) {
+        range.bounds = range.centroids = AABB::Empty;
+        for (size_t i = range.begin; i < range.end; ++i) {
+            range.bounds.Expand(boxes[i]);
+            BVHExpand(range.centroids, BVHCentroid(boxes[i]));
+        }
+    }
+
+    // Maps centroids to bins along each axis. Small ranges use fewer bins, as binning costs them more than their 
+    // primitives do.
+    struct BVHBinMapping {
+        BVHBinMapping(const AABB& centroids, size_t count) : binCount((int)_XO_MIN(count, (size_t)BVHBinCount)) {
+            const Vector3 extent = centroids.max - centroids.min;
+            offset = centroids.min;
+            // just under binCount, so the largest centroid still lands in the last bin.
+            for (int axis = 0; axis < 3; ++axis) {
+                scale[axis] = extent[axis] > 0.0f ? binCount * 0.99999f / extent[axis] : 0.0f;
+            }
+            lastBin = Vector3((float)(binCount - 1));
+        }
+
+        // The bin of centroid along each axis. outBins holds four ints.
+        _XOINL void Bins(BVHPoint centroid, int* outBins) const {
+            BVHBinIndices(centroid, offset, scale, lastBin, outBins);
+        }
+
+        Vector3 offset;
+        Vector3 scale;
+        Vector3 lastBin;
+        int binCount;
+    };
+
+    struct BVHBuilder {
+        BVHBuilder(BVH::Node* nodes, uint32_t* indices, AABB* boxes, int leafSize) :
+            nodes(nodes), indices(indices), boxes(boxes), leafSize((size_t)leafSize), nodeCount(1) {
+        }
+
+        void BinRange(const BVHBinMapping& mapping, size_t begin, size_t end, BVHBin (&bins)[3][BVHBinCount]) const {
+            for (int axis = 0; axis < 3; ++axis) {
+                for (int b = 0; b < mapping.binCount; ++b) {
+                    bins[axis][b].Clear();
+                }
+            }
+            for (size_t i = begin; i < end; ++i) {
+                const AABB& box = boxes[i];
+                int b[4];
+                mapping.Bins(BVHCentroid(box), b);
+                BVHBin& x = bins[0][b[0]];
+                BVHBin& y = bins[1][b[1]];
+                BVHBin& z = bins[2][b[2]];
+                x.bounds.Expand(box);
+                y.bounds.Expand(box);
+                z.bounds.Expand(box);
+                ++x.count;
+                ++y.count;
+                ++z.count;
+            }
+        }
+
+        void Bin(const BVHBinMapping& mapping, const BVHRange& range, unsigned threads, BVHBin (&bins)[3][BVHBinCount]) const {
+            if (threads < 2 || range.Count() < BVHParallelBinning) {
+                BinRange(mapping, range.begin, range.end, bins);
+                return;
+            }
+            // each thread bins its own share of the range, and the bins are summed after.
+            typedef BVHBin Bins[3][BVHBinCount];
+            Bins* threadBins = (Bins*)XO_ALIGNED_MALLOC(sizeof(Bins) * threads, 64);
+            const size_t share = (range.Count() + threads - 1) / threads;
+            xo_internal::Parallel(threads, [&](unsigned t) {
+                const size_t begin = _XO_MIN(range.begin + share * t, range.end);
+                BinRange(mapping, begin, _XO_MIN(begin + share, range.end), threadBins[t]);
+            });
+            for (int axis = 0; axis < 3; ++axis) {
+                for (int b = 0; b < mapping.binCount; ++b) {
+                    bins[axis][b] = threadBins[0][axis][b];
+                    for (unsigned t = 1; t < threads; ++t) {
+                        bins[axis][b].Add(threadBins[t][axis][b]);
+                    }
+                }
+            }
+            XO_ALIGNED_FREE(threadBins);
+        }
+
+        void Swap(size_t a, size_t b) const {
+            AABB box;
+            box = boxes[a];
+            boxes[a] = boxes[b];
+            boxes[b] = box;
+            const uint32_t index = indices[a];
+            indices[a] = indices[b];
+            indices[b] = index;
+        }
+
+        // Splits range, which holds at least two primitives, in two.
+        void Split(const BVHRange& range, int depth, unsigned threads, BVHRange& outLeft, BVHRange& outRight) const {
+            const BVHBinMapping mapping(range.centroids, range.Count());
+            const int binCount = mapping.binCount;
+            int bestAxis = -1, bestBin = 0;
+            if (depth <= BVHMaxSahDepth && (mapping.scale.x > 0.0f || mapping.scale.y > 0.0f || mapping.scale.z > 0.0f)) {
+                BVHBin bins[3][BVHBinCount];
+                Bin(mapping, range, threads, bins);
+                // The cost of a split is the surface area of each side times the primitives in it. A sweep from the 
+                // right gives the cost of every split's right side, and a sweep from the left adds its left side.
+                float bestCost = std::numeric_limits<float>::infinity();
+                for (int axis = 0; axis < 3; ++axis) {
+                    if (mapping.scale[axis] == 0.0f) {
+                        continue;
+                    }
+                    float rightCost[BVHBinCount];
+                    BVHBin side;
+                    side.Clear();
+                    for (int b = binCount - 1; b > 0; --b) {
+                        side.Add(bins[axis][b]);
+                        rightCost[b] = side.count ? side.bounds.SurfaceArea() * side.count : -1.0f;
+                    }
+                    side.Clear();
+                    for (int b = 0; b < binCount - 1; ++b) {
+                        side.Add(bins[axis][b]);
+                        if (side.count == 0 || rightCost[b + 1] < 0.0f) {
+                            continue;
+                        }
+                        const float cost = side.bounds.SurfaceArea() * side.count + rightCost[b + 1];
+                        if (cost < bestCost) {
+                            bestCost = cost;
+                            bestAxis = axis;
+                            bestBin = b;
+                        }
+                    }
+                }
+            }
+
+            outLeft.begin = range.begin;
+            outRight.end = range.end;
+            if (bestAxis >= 0) {
+                // The centroid bounds of each side are gathered while partitioning, so the bins don't need to keep them.
+                AABB left = AABB::Empty, right = AABB::Empty, leftCentroids = AABB::Empty, rightCentroids = AABB::Empty;
+                size_t i = range.begin, j = range.end;
+                while (i < j) {
+                    const BVHPoint centroid = BVHCentroid(boxes[i]);
+                    int b[4];
+                    mapping.Bins(centroid, b);
+                    if (b[bestAxis] <= bestBin) {
+                        left.Expand(boxes[i]);
+                        BVHExpand(leftCentroids, centroid);
+                        ++i;
+                    }
+                    else {
+                        right.Expand(boxes[i]);
+                        BVHExpand(rightCentroids, centroid);
+                        Swap(i, --j);
+                    }
+                }
+                outLeft.end = outRight.begin = i;
+                outLeft.bounds = left;
+                outLeft.centroids = leftCentroids;
+                outRight.bounds = right;
+                outRight.centroids = rightCentroids;
+            }
+            else {
+                // too deep, or every centroid is in the same place.
+                outLeft.end = outRight.begin = range.begin + range.Count() / 2;
+                BVHRangeBounds(boxes, outLeft);
+                BVHRangeBounds(boxes, outRight);
+            }
+        }
+
+        void BuildNode(uint32_t nodeIndex, const BVHRange& range, int depth, unsigned threads) {
+            // Splits the range with the largest surface area until there are four, or every range fits in a leaf. 
+            // Each split replaces a range with its two halves in place, keeping the ranges in index order.
+            BVHRange ranges[4];
+            ranges[0] = range;
+            int rangeCount = 1;
+            while (rangeCount < 4) {
+                int largest = -1;
+                float largestArea = -1.0f;
+                for (int r = 0; r < rangeCount; ++r) {
+                    const float area = ranges[r].bounds.SurfaceArea();
+                    if (ranges[r].Count() > leafSize && area > largestArea) {
+                        largest = r;
+                        largestArea = area;
+                    }
+                }
+                if (largest < 0) {
+                    break;
+                }
+                BVHRange left, right;
+                Split(ranges[largest], depth, threads, left, right);
+                for (int r = rangeCount; r > largest + 1; --r) {
+                    ranges[r] = ranges[r - 1];
+                }
+                ranges[largest] = left;
+                ranges[largest + 1] = right;
+                ++rangeCount;
+            }
+
+            BVH::Node& node = nodes[nodeIndex];
+            uint32_t children[4];
+            BVHRange childRanges[4];
+            unsigned childCount = 0;
+            for (int slot = 0; slot < 4; ++slot) {
+                if (slot < rangeCount) {
+                    const BVHRange& r = ranges[slot];
+                    node.minX[slot] = r.bounds.min.x;
+                    node.minY[slot] = r.bounds.min.y;
+                    node.minZ[slot] = r.bounds.min.z;
+                    node.maxX[slot] = r.bounds.max.x;
+                    node.maxY[slot] = r.bounds.max.y;
+                    node.maxZ[slot] = r.bounds.max.z;
+                    node.count[slot] = (uint32_t)r.Count();
+                    if (r.Count() <= leafSize) {
+                        node.child[slot] = BVH::LeafBit | (uint32_t)r.begin;
+                    }
+                    else {
+                        node.child[slot] = nodeCount++;
+                        children[childCount] = node.child[slot];
+                        childRanges[childCount++] = r;
+                    }
+                }
+                else {
+                    node.minX[slot] = node.minY[slot] = node.minZ[slot] = std::numeric_limits<float>::infinity();
+                    node.maxX[slot] = node.maxY[slot] = node.maxZ[slot] = -std::numeric_limits<float>::infinity();
+                    node.child[slot] = 0;
+                    node.count[slot] = 0;
+                }
+            }
+
+            if (threads > 1 && childCount > 1 && range.Count() >= BVHParallelSubtree) {
+                const unsigned share = _XO_MAX(threads / childCount, 1u);
+                xo_internal::Parallel(childCount, [&](unsigned c) {
+                    BuildNode(children[c], childRanges[c], depth + 1, share);
+                });
+            }
+            else {
+                for (unsigned c = 0; c < childCount; ++c) {
+                    BuildNode(children[c], childRanges[c], depth + 1, threads);
+                }
+            }
+        }
+
+        BVH::Node* nodes;
+        uint32_t* indices;
+        AABB* boxes;
+        size_t leafSize;
+        std::atomic<uint32_t> nodeCount;
+    };
+
+    void BVHSetSlot(BVH::Node& node, int slot, const AABB& box) {
+        node.minX[slot] = box.min.x;
+        node.minY[slot] = box.min.y;
+        node.minZ[slot] = box.min.z;
+        node.maxX[slot] = box.max.x;
+        node.maxY[slot] = box.max.y;
+        node.maxZ[slot] = box.max.z;
     }
+
+    // The box around every slot of node. Empty slots hold an empty box, so they don't need to be skipped.
+    AABB BVHNodeBounds(const BVH::Node& node) {
+        AABB box;
+#if defined(XO_SSE)
+        __m128 minX = _mm_load_ps(node.minX), minY = _mm_load_ps(node.minY), minZ = _mm_load_ps(node.minZ);
+        __m128 maxX = _mm_load_ps(node.maxX), maxY = _mm_load_ps(node.maxY), maxZ = _mm_load_ps(node.maxZ);
+        __m128 w = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(minX, minY, minZ, w);
+        box.min.xmm = _mm_min_ps(_mm_min_ps(minX, minY), _mm_min_ps(minZ, w));
+        w = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(maxX, maxY, maxZ, w);
+        box.max.xmm = _mm_max_ps(_mm_max_ps(maxX, maxY), _mm_max_ps(maxZ, w));
+#else
+        box = AABB::Empty;
+        for (int slot = 0; slot < 4; ++slot) {
+            box.Expand(AABB(Vector3(node.minX[slot], node.minY[slot], node.minZ[slot]), Vector3(node.maxX[slot], node.maxY[slot], node.maxZ[slot])));
+        }
 #endif
-}
+        return box;
+    }
 
-void Matrix4x4::MakeInverse() {
+    // Children are allocated after their parents, so walking the nodes backward reaches every child before its parent.
+    template <class PrimitiveBounds>
+    void BVHRefit(BVH::Node* nodes, size_t nodeCount, const uint32_t* indices, const PrimitiveBounds& primitiveBounds) {
+        for (size_t n = nodeCount; n-- > 0; ) {
+            BVH::Node& node = nodes[n];
+            for (int slot = 0; slot < 4; ++slot) {
+                if (node.count[slot] == 0) {
+                    continue;
+                }
+                if (node.child[slot] & BVH::LeafBit) {
+                    const uint32_t first = node.child[slot] & ~BVH::LeafBit;
+                    AABB box = primitiveBounds(indices[first]);
+                    for (uint32_t i = 1; i < node.count[slot]; ++i) {
+                        box.Expand(primitiveBounds(indices[first + i]));
+                    }
+                    BVHSetSlot(node, slot, box);
+                }
+                else {
+                    BVHSetSlot(node, slot, BVHNodeBounds(nodes[node.child[slot]]));
+                }
+            }
+        }
+    }
+
+    _XOINL AABB BVHTriangleBounds(const Vector3* vertices, uint32_t triangle) {
+        const Vector3* v = vertices + triangle * 3;
+        return AABB(Vector3::Min(Vector3::Min(v[0], v[1]), v[2]), Vector3::Max(Vector3::Max(v[0], v[1]), v[2]));
+    }
+
+    _XOINL size_t BVHEmit(const uint32_t* indices, uint32_t first, uint32_t count, uint32_t* outIndices, size_t written) {
+        memcpy(outIndices + written, indices + first, count * sizeof(uint32_t));
+        return written + count;
+    }
+
+    // The ray with what the slab test needs of it in every lane.
+    struct BVHRay {
+        BVHRay(const Ray& ray) {
 #if defined(XO_SSE)
-    __m128 minor0, minor1, minor2, minor3;
-    __m128 row0, row1, row2, row3;
-    __m128 det, tmp1;
-    EarlyInverse(minor0, minor1, minor2, minor3, row0, row1, row2, row3, det, tmp1, m);
-    LateInverse(minor0, minor1, minor2, minor3, det, tmp1, m);
+            ox = _mm_set1_ps(ray.origin.x);
+            oy = _mm_set1_ps(ray.origin.y);
+            oz = _mm_set1_ps(ray.origin.z);
+            ix = _mm_set1_ps(1.0f / ray.direction.x);
+            iy = _mm_set1_ps(1.0f / ray.direction.y);
+            iz = _mm_set1_ps(1.0f / ray.direction.z);
 #else
-    float tmp[12]; // temp array for pairs
-    float src[16]; // array of transpose source matrix
-    float det; // determinant
-    EarlyInverse(tmp, src, det, m);
-    LateInverse(det, m);
+            o = ray.origin;
+            inverse = Vector3(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
 #endif
-}
+        }
 
-bool Matrix4x4::TryMakeInverse()
-{
+        // Slab tests the ray against the four slots of node, returning a bit for each slot hit between 0 and maxT and 
+        // the distance the ray enters each slot at.
+        _XOINL int Test(const BVH::Node& node, float maxT, float* outEnter) const {
 #if defined(XO_SSE)
-    __m128 minor0, minor1, minor2, minor3;
-    __m128 row0, row1, row2, row3;
-    __m128 det, tmp1;
-    EarlyInverse(minor0, minor1, minor2, minor3, row0, row1, row2, row3, det, tmp1, m);
-    if (_mm_cvtss_f32(det) == 0.0f)
-        return false;
-    LateInverse(minor0, minor1, minor2, minor3, det, tmp1, m);
-    return true;
+            const __m128 x0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minX), ox), ix), x1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxX), ox), ix);
+            const __m128 y0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minY), oy), iy), y1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxY), oy), iy);
+            const __m128 z0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minZ), oz), iz), z1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxZ), oz), iz);
+            const __m128 enter = _mm_max_ps(_mm_max_ps(_mm_min_ps(x0, x1), _mm_min_ps(y0, y1)), _mm_max_ps(_mm_min_ps(z0, z1), _mm_setzero_ps()));
+            const __m128 exit = _mm_min_ps(_mm_min_ps(_mm_max_ps(x0, x1), _mm_max_ps(y0, y1)), _mm_min_ps(_mm_max_ps(z0, z1), _mm_set1_ps(maxT)));
+            // empty slots are inside out boxes, which the swapping min and max above would take as infinite.
+            const __m128 used = _mm_castsi128_ps(_mm_cmpgt_epi32(_mm_load_si128((const __m128i*)node.count), _mm_setzero_si128()));
+            _mm_storeu_ps(outEnter, enter);
+            return _mm_movemask_ps(_mm_and_ps(_mm_cmple_ps(enter, exit), used));
 #else
-    float tmp[12]; // temp array for pairs
-    float src[16]; // array of transpose source matrix
-    float det; // determinant
-    EarlyInverse(tmp, src, det, m);
-    if (det == 0.0f)
-        return false;
-    LateInverse(det, m);
-    return true;
+            int bits = 0;
+            for (int slot = 0; slot < 4; ++slot) {
+                const float x0 = (node.minX[slot] - o.x) * inverse.x, x1 = (node.maxX[slot] - o.x) * inverse.x;
+                const float y0 = (node.minY[slot] - o.y) * inverse.y, y1 = (node.maxY[slot] - o.y) * inverse.y;
+                const float z0 = (node.minZ[slot] - o.z) * inverse.z, z1 = (node.maxZ[slot] - o.z) * inverse.z;
+                const float enter = Max(Max(Min(x0, x1), Min(y0, y1)), Max(Min(z0, z1), 0.0f));
+                const float exit = Min(Min(Max(x0, x1), Max(y0, y1)), Min(Max(z0, z1), maxT));
+                outEnter[slot] = enter;
+                bits |= (node.count[slot] && enter <= exit) << slot;
+            }
+            return bits;
 #endif
-}
+        }
 
-Matrix4x4& Matrix4x4::Transpose() {
 #if defined(XO_SSE)
-    _MM_TRANSPOSE4_PS(r[0].xmm, r[1].xmm, r[2].xmm, r[3].xmm);
+        __m128 ox, oy, oz, ix, iy, iz;
 #else
-    float t;
-#   define _XO_TRANSPOSE_SWAP(i,j) t = r[i][j]; r[i][j] = r[j][i]; r[j][i] = t;
-    // The number of swaps should be:
-    //      (((n*n)-n)/2) = 6
-    //      (((4*4)-4)/2) = 6
-    //      (((all elements)-identity)/(two elements processed per swap)) = 6
-    _XO_TRANSPOSE_SWAP(0, 1);
-    _XO_TRANSPOSE_SWAP(0, 2);
-    _XO_TRANSPOSE_SWAP(0, 3);
-    _XO_TRANSPOSE_SWAP(1, 2);
-    _XO_TRANSPOSE_SWAP(1, 3);
-    _XO_TRANSPOSE_SWAP(2, 3);
-#   undef _XO_TRANSPOSE_SWAP
+        Vector3 o, inverse;
 #endif
-    return *this;
+    };
+
+    // A bit for each slot of node that overlaps box.
+    _XOINL int BVHOverlaps(const BVH::Node& node, const AABB& box) {
+#if defined(XO_SSE)
+        __m128 overlap = _mm_and_ps(_mm_cmple_ps(_mm_load_ps(node.minX), _mm_set1_ps(box.max.x)), _mm_cmpge_ps(_mm_load_ps(node.maxX), _mm_set1_ps(box.min.x)));
+        overlap = _mm_and_ps(overlap, _mm_and_ps(_mm_cmple_ps(_mm_load_ps(node.minY), _mm_set1_ps(box.max.y)), _mm_cmpge_ps(_mm_load_ps(node.maxY), _mm_set1_ps(box.min.y))));
+        overlap = _mm_and_ps(overlap, _mm_and_ps(_mm_cmple_ps(_mm_load_ps(node.minZ), _mm_set1_ps(box.max.z)), _mm_cmpge_ps(_mm_load_ps(node.maxZ), _mm_set1_ps(box.min.z))));
+        return _mm_movemask_ps(overlap);
+#else
+        int bits = 0;
+        for (int slot = 0; slot < 4; ++slot) {
+            bits |= (node.minX[slot] <= box.max.x && node.maxX[slot] >= box.min.x &&
+                     node.minY[slot] <= box.max.y && node.maxY[slot] >= box.min.y &&
+                     node.minZ[slot] <= box.max.z && node.maxZ[slot] >= box.min.z) << slot;
+        }
+        return bits;
+#endif
+    }
+
+    // Tests the four slots of a node against the planes of a frustum, the same test as Frustum::IntersectsAABB.
+    struct BVHFrustum {
+        BVHFrustum(const Frustum& frustum) {
+            for (int i = 0; i < Frustum::PlaneCount; ++i) {
+                const Vector4& p = frustum.planes[i];
+                for (int slot = 0; slot < 4; ++slot) {
+                    halfX[i][slot] = p.x * 0.5f;
+                    halfY[i][slot] = p.y * 0.5f;
+                    halfZ[i][slot] = p.z * 0.5f;
+                    absHalfX[i][slot] = Abs(p.x) * 0.5f;
+                    absHalfY[i][slot] = Abs(p.y) * 0.5f;
+                    absHalfZ[i][slot] = Abs(p.z) * 0.5f;
+                    w[i][slot] = p.w;
+                }
+            }
+        }
+
+        // Returns a bit for each slot not outside any plane of planeMask, and for those slots outPlaneMasks holds the 
+        // planes they still cross.
+        _XOINL int Test(const BVH::Node& node, uint32_t planeMask, uint32_t* outPlaneMasks) const {
+            for (int slot = 0; slot < 4; ++slot) {
+                outPlaneMasks[slot] = planeMask;
+            }
+#if defined(XO_SSE)
+            const __m128 minX = _mm_load_ps(node.minX), minY = _mm_load_ps(node.minY), minZ = _mm_load_ps(node.minZ);
+            const __m128 maxX = _mm_load_ps(node.maxX), maxY = _mm_load_ps(node.maxY), maxZ = _mm_load_ps(node.maxZ);
+            const __m128 sumX = _mm_add_ps(minX, maxX), sumY = _mm_add_ps(minY, maxY), sumZ = _mm_add_ps(minZ, maxZ);
+            const __m128 sizeX = _mm_sub_ps(maxX, minX), sizeY = _mm_sub_ps(maxY, minY), sizeZ = _mm_sub_ps(maxZ, minZ);
+            __m128 visible = _mm_castsi128_ps(_mm_cmpgt_epi32(_mm_load_si128((const __m128i*)node.count), _mm_setzero_si128()));
+            for (int i = 0; i < Frustum::PlaneCount; ++i) {
+                if (!(planeMask & (1 << i))) {
+                    continue;
+                }
+                const __m128 distance = sse::MulAdd(_mm_load_ps(halfX[i]), sumX, sse::MulAdd(_mm_load_ps(halfY[i]), sumY, sse::MulAdd(_mm_load_ps(halfZ[i]), sumZ, _mm_load_ps(w[i]))));
+                const __m128 reach = sse::MulAdd(_mm_load_ps(absHalfX[i]), sizeX, sse::MulAdd(_mm_load_ps(absHalfY[i]), sizeY, _mm_mul_ps(_mm_load_ps(absHalfZ[i]), sizeZ)));
+                visible = _mm_and_ps(visible, _mm_cmpge_ps(distance, _mm_sub_ps(_mm_setzero_ps(), reach)));
+                const int inside = _mm_movemask_ps(_mm_cmpge_ps(distance, reach));
+                for (int slot = 0; slot < 4; ++slot) {
+                    outPlaneMasks[slot] &= ~(((inside >> slot) & 1u) << i);
+                }
+            }
+            return _mm_movemask_ps(visible);
+#else
+            int bits = 0;
+            for (int slot = 0; slot < 4; ++slot) {
+                if (!node.count[slot]) {
+                    continue;
+                }
+                const AABB box(Vector3(node.minX[slot], node.minY[slot], node.minZ[slot]), Vector3(node.maxX[slot], node.maxY[slot], node.maxZ[slot]));
+                const Vector3 sum = box.min + box.max, size = box.max - box.min;
+                bool visible = true;
+                for (int i = 0; i < Frustum::PlaneCount && visible; ++i) {
+                    if (!(planeMask & (1 << i))) {
+                        continue;
+                    }
+                    const float distance = halfX[i][slot] * sum.x + halfY[i][slot] * sum.y + halfZ[i][slot] * sum.z + w[i][slot];
+                    const float reach = absHalfX[i][slot] * size.x + absHalfY[i][slot] * size.y + absHalfZ[i][slot] * size.z;
+                    visible = distance >= -reach;
+                    if (distance >= reach) {
+                        outPlaneMasks[slot] &= ~(1u << i);
+                    }
+                }
+                bits |= visible << slot;
+            }
+            return bits;
+#endif
+        }
+
+        _XOSIMDALIGN float halfX[Frustum::PlaneCount][4];
+        _XOSIMDALIGN float halfY[Frustum::PlaneCount][4];
+        _XOSIMDALIGN float halfZ[Frustum::PlaneCount][4];
+        _XOSIMDALIGN float absHalfX[Frustum::PlaneCount][4];
+        _XOSIMDALIGN float absHalfY[Frustum::PlaneCount][4];
+        _XOSIMDALIGN float absHalfZ[Frustum::PlaneCount][4];
+        _XOSIMDALIGN float w[Frustum::PlaneCount][4];
+    };
+
+    struct BVHRayEntry {
+        uint32_t child;
+        uint32_t count;
+        float enter;
+    };
 }
 
-Matrix4x4 Matrix4x4::Transposed() const {
-    Matrix4x4 m(*this);
-    return m.Transpose();
+BVH::BVH() : nodes(nullptr), indices(nullptr), nodeCount(0), primitiveCount(0) {
 }
 
-const Matrix4x4& Matrix4x4::Transform(Vector3& v) const {
-    v = (*this) * Vector4(v);
-    return *this;
+BVH::BVH(const BVH& bvh) : nodes(nullptr), indices(nullptr), nodeCount(0), primitiveCount(0) {
+    *this = bvh;
 }
 
-const Matrix4x4& Matrix4x4::Transform(Vector4& v) const {
-    v = (*this) * v;
-    return *this;
+BVH::BVH(BVH&& bvh) : nodes(bvh.nodes), indices(bvh.indices), nodeCount(bvh.nodeCount), primitiveCount(bvh.primitiveCount) {
+    bvh.nodes = nullptr;
+    bvh.indices = nullptr;
+    bvh.nodeCount = bvh.primitiveCount = 0;
 }
 
-void Matrix4x4::Scale(float xyz, Matrix4x4& m) {
-    m[0].Set(xyz,  0.0f, 0.0f, 0.0f);
-    m[1].Set(0.0f, xyz,  0.0f, 0.0f);
-    m[2].Set(0.0f, 0.0f, xyz,  0.0f);
-    m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+BVH::~BVH() {
+    Release();
 }
- 
-void Matrix4x4::Scale(float x, float y, float z, Matrix4x4& m) {
-    m[0].Set(x,    0.0f, 0.0f, 0.0f);
-    m[1].Set(0.0f, y,    0.0f, 0.0f);
-    m[2].Set(0.0f, 0.0f, z,    0.0f);
-    m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+
+void BVH::Allocate(size_t nodes, size_t primitives) {
+    this->nodes = (Node*)XO_ALIGNED_MALLOC(nodes * sizeof(Node), 64);
+    indices = (uint32_t*)XO_ALIGNED_MALLOC(primitives * sizeof(uint32_t), 64);
+    nodeCount = nodes;
+    primitiveCount = primitives;
 }
 
-void Matrix4x4::Scale(const Vector3& v, Matrix4x4& m) {
-    m[0].Set(v.x,  0.0f, 0.0f, 0.0f);
-    m[1].Set(0.0f, v.y,  0.0f, 0.0f);
-    m[2].Set(0.0f, 0.0f, v.z,  0.0f);
-    m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
-}
- 
-void Matrix4x4::Translation(float x, float y, float z, Matrix4x4& m) {
-    m[0].Set(1.0f, 0.0f, 0.0f, 0.0f);
-    m[1].Set(0.0f, 1.0f, 0.0f, 0.0f);
-    m[2].Set(0.0f, 0.0f, 1.0f, 0.0f);
-    m[3].Set(x,    y,    z,    1.0f);
+void BVH::Release() {
+    if (nodes) {
+        XO_ALIGNED_FREE(nodes);
+    }
+    if (indices) {
+        XO_ALIGNED_FREE(indices);
+    }
+    nodes = nullptr;
+    indices = nullptr;
+    nodeCount = primitiveCount = 0;
+}
+
+BVH& BVH::operator = (const BVH& bvh) {
+    if (this != &bvh) {
+        Release();
+        if (bvh.nodeCount) {
+            Allocate(bvh.nodeCount, bvh.primitiveCount);
+            memcpy(nodes, bvh.nodes, nodeCount * sizeof(Node));
+            memcpy(indices, bvh.indices, primitiveCount * sizeof(uint32_t));
+        }
+    }
+    return *this;
 }
 
-void Matrix4x4::Translation(const Vector3& v, Matrix4x4& m) {
-    m[0].Set(1.0f, 0.0f, 0.0f, 0.0f);
-    m[1].Set(0.0f, 1.0f, 0.0f, 0.0f);
-    m[2].Set(0.0f, 0.0f, 1.0f, 0.0f);
-    m[3].Set(v,                1.0f);
+BVH& BVH::operator = (BVH&& bvh) {
+    if (this != &bvh) {
+        Release();
+        nodes = bvh.nodes;
+        indices = bvh.indices;
+        nodeCount = bvh.nodeCount;
+        primitiveCount = bvh.primitiveCount;
+        bvh.nodes = nullptr;
+        bvh.indices = nullptr;
+        bvh.nodeCount = bvh.primitiveCount = 0;
+    }
+    return *this;
 }
 
-void Matrix4x4::RotationXRadians(float radians, Matrix4x4& m) {
-    float sinr, cosr;
-
-    SinCos(radians, sinr, cosr);
-    m[0].Set(1.0f, 0.0f, 0.0f, 0.0f);
-    m[1].Set(0.0f, cosr,-sinr, 0.0f);
-    m[2].Set(0.0f, sinr, cosr, 0.0f);
-    m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
-}
- 
-void Matrix4x4::RotationYRadians(float radians, Matrix4x4& m) {
-    float sinr, cosr;
-    SinCos(radians, sinr, cosr);
-    m[0].Set(cosr, 0.0f,-sinr, 0.0f);
-    m[1].Set(0.0f, 1.0f, 0.0f, 0.0f);
-    m[2].Set(sinr, 0.0f, cosr, 0.0f);
-    m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+void BVH::Clear() {
+    Release();
 }
 
-void Matrix4x4::RotationZRadians(float radians, Matrix4x4& m) {
-    float sinr, cosr;
-    SinCos(radians, sinr, cosr);
-    m[0].Set(cosr,-sinr, 0.0f, 0.0f);
-    m[1].Set(sinr, cosr, 0.0f, 0.0f);
-    m[2].Set(0.0f, 0.0f, 1.0f, 0.0f);
-    m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
-}
+void BVH::Build(const AABB* bounds, size_t count, int leafSize, unsigned threadCount) {
+    XO_ASSERT(count < LeafBit, "xo-math BVH::Build has too many primitives.");
+    Release();
+    if (!count) {
+        return;
+    }
+    const unsigned threads = xo_internal::ThreadCount(threadCount, count, 0);
+    leafSize = _XO_MIN(_XO_MAX(leafSize, 1), MaxLeafSize);
+
+    // Every node but a lone root has at least two slots, so there are fewer nodes than primitives. The nodes are 
+    // built into an array that size and copied to one that fits once their number is known.
+    Allocate(count, count);
+    AABB* boxes = (AABB*)XO_ALIGNED_MALLOC(count * sizeof(AABB), 64);
+
+    // The builder sorts a copy of the bounds along with the indices, so every pass over a range reads memory in order.
+    const unsigned rootThreads = count >= BVHParallelBinning ? threads : 1;
+    BVHRange shares[xo_internal::MaxThreads];
+    const size_t share = (count + rootThreads - 1) / rootThreads;
+    xo_internal::Parallel(rootThreads, [&](unsigned t) {
+        BVHRange& range = shares[t];
+        range.begin = _XO_MIN(share * t, count);
+        range.end = _XO_MIN(range.begin + share, count);
+        for (size_t i = range.begin; i < range.end; ++i) {
+            boxes[i] = bounds[i];
+            indices[i] = (uint32_t)i;
+        }
+        BVHRangeBounds(boxes, range);
+    });
+    BVHRange root = shares[0];
+    root.end = count;
+    for (unsigned t = 1; t < rootThreads; ++t) {
+        root.bounds.Expand(shares[t].bounds);
+        root.centroids.Expand(shares[t].centroids);
+    }
 
-void Matrix4x4::RotationRadians(float x, float y, float z, Matrix4x4& m) {
-    _XOSIMDALIGN float c[4];
-    _XOSIMDALIGN float s[4];
-    Vector4 v(x, y, z, 0.0f);
-    SinCos_x4(v.f, s, c);
+    BVHBuilder builder(nodes, indices, boxes, leafSize);
+    builder.BuildNode(0, root, 0, threads);
+    XO_ALIGNED_FREE(boxes);
 
-    m[0].Set(c[1]*c[2],                     -c[1]*s[2],                 s[1],           0.0f);
-    m[1].Set(c[2]*s[0]*s[1]+c[0]*s[2],      c[0]*c[2]-s[0]*s[1]*s[2],   -c[1]*s[0],     0.0f);
-    m[2].Set(-c[0]*c[2]*s[1]+s[0]*s[2],     c[2]*s[0]+c[0]*s[1]*s[2],   c[0]*c[1],      0.0f);
-    m[3].Set(0.0f,                          0.0f,                       0.0f,           1.0f);
+    Node* built = nodes;
+    nodes = (Node*)XO_ALIGNED_MALLOC(builder.nodeCount * sizeof(Node), 64);
+    nodeCount = builder.nodeCount;
+    memcpy(nodes, built, nodeCount * sizeof(Node));
+    XO_ALIGNED_FREE(built);
 }
 
-void Matrix4x4::RotationRadians(const Vector3& v, Matrix4x4& m) {
-    _XOSIMDALIGN float c[4];
-    _XOSIMDALIGN float s[4];
-    SinCos_x4(v.f, s, c);
+void BVH::BuildTriangles(const Vector3* vertices, size_t count, int leafSize, unsigned threadCount) {
+    AABB* bounds = (AABB*)XO_ALIGNED_MALLOC(_XO_MAX(count, (size_t)1) * sizeof(AABB), 64);
+    for (size_t i = 0; i < count; ++i) {
+        bounds[i] = BVHTriangleBounds(vertices, (uint32_t)i);
+    }
+    Build(bounds, count, leafSize, threadCount);
+    XO_ALIGNED_FREE(bounds);
+}
 
-    m[0].Set(c[1]*c[2],                     -c[1]*s[2],                 s[1],           0.0f);
-    m[1].Set(c[2]*s[0]*s[1]+c[0]*s[2],      c[0]*c[2]-s[0]*s[1]*s[2],   -c[1]*s[0],     0.0f);
-    m[2].Set(-c[0]*c[2]*s[1]+s[0]*s[2],     c[2]*s[0]+c[0]*s[1]*s[2],   c[0]*c[1],      0.0f);
-    m[3].Set(0.0f,                          0.0f,                       0.0f,           1.0f);
+void BVH::Refit(const AABB* bounds) {
+    BVHRefit(nodes, nodeCount, indices, [bounds](uint32_t i) { return bounds[i]; });
 }
 
-void Matrix4x4::AxisAngleRadians(const Vector3& a, float radians, Matrix4x4& m) {
-    float s, c;
-    SinCos(radians, s, c);
-    float t = 1.0f - c;
-    const float& x = a.x;
-    const float& y = a.y;
-    const float& z = a.z;
-    m = Matrix4x4(
-             t*x*x+c  ,    t*x*y-z*s,  t*x*z+y*s,  0.0f,
-             t*x*y+z*s,    t*y*y+c  ,  t*y*z-x*s,  0.0f,
-             t*x*z-y*s,    t*y*z+x*s,  t*z*z+c  ,  0.0f,
-             0.0f,         0.0f,       0.0f,       1.0f
-        );
+void BVH::RefitTriangles(const Vector3* vertices) {
+    BVHRefit(nodes, nodeCount, indices, [vertices](uint32_t i) { return BVHTriangleBounds(vertices, i); });
 }
 
-void Matrix4x4::RotationXDegrees(float degrees, Matrix4x4& m) {
-    RotationXRadians(degrees * Deg2Rad, m);
+AABB BVH::Bounds() const {
+    return nodeCount ? BVHNodeBounds(nodes[0]) : AABB::Empty;
 }
 
-void Matrix4x4::RotationYDegrees(float degrees, Matrix4x4& m) {
-    RotationYRadians(degrees * Deg2Rad, m);
+bool BVH::IntersectTriangles(const Ray& ray, const Vector3* vertices, float& inOutT, float& outU, float& outV, uint32_t& outIndex) const {
+    if (!nodeCount) {
+        return false;
+    }
+    const BVHRay wideRay(ray);
+    BVHRayEntry stack[BVHStackSize];
+    int top = 0;
+    stack[top++] = { 0, 1, 0.0f };
+    bool found = false;
+    while (top) {
+        const BVHRayEntry entry = stack[--top];
+        // a triangle can't be closer than where the ray enters its box.
+        if (entry.enter >= inOutT) {
+            continue;
+        }
+        if (entry.child & LeafBit) {
+            const uint32_t first = entry.child & ~LeafBit;
+            for (uint32_t i = first; i < first + entry.count; ++i) {
+                const Vector3* v = vertices + indices[i] * 3;
+                if (ray.IntersectTriangle(v[0], v[1], v[2], inOutT, outU, outV)) {
+                    outIndex = indices[i];
+                    found = true;
+                }
+            }
+            continue;
+        }
+        const Node& node = nodes[entry.child];
+        float enter[4];
+        int bits = wideRay.Test(node, inOutT, enter);
+        // Pushes the slots hit farthest first, so the nearest is visited next.
+        BVHRayEntry hits[4];
+        int hitCount = 0;
+        for (; bits; bits &= bits - 1) {
+            const int slot = bits & 1 ? 0 : bits & 2 ? 1 : bits & 4 ? 2 : 3;
+            BVHRayEntry hit = { node.child[slot], node.count[slot], enter[slot] };
+            int h = hitCount++;
+            for (; h > 0 && hits[h - 1].enter < hit.enter; --h) {
+                hits[h] = hits[h - 1];
+            }
+            hits[h] = hit;
+        }
+        XO_ASSERT(top + hitCount <= BVHStackSize, "xo-math BVH traversal stack overflow.");
+        for (int h = 0; h < hitCount; ++h) {
+            stack[top++] = hits[h];
+        }
+    }
+    return found;
 }
 
-void Matrix4x4::RotationZDegrees(float degrees, Matrix4x4& m) {
-    RotationZRadians(degrees * Deg2Rad, m);
+size_t BVH::QueryRay(const Ray& ray, float maxT, uint32_t* outIndices) const {
+    if (!nodeCount) {
+        return 0;
+    }
+    const BVHRay wideRay(ray);
+    uint32_t stack[BVHStackSize];
+    int top = 0;
+    stack[top++] = 0;
+    size_t written = 0;
+    while (top) {
+        const Node& node = nodes[stack[--top]];
+        float enter[4];
+        const int bits = wideRay.Test(node, maxT, enter);
+        for (int slot = 0; slot < 4; ++slot) {
+            if (bits & (1 << slot)) {
+                if (node.child[slot] & LeafBit) {
+                    written = BVHEmit(indices, node.child[slot] & ~LeafBit, node.count[slot], outIndices, written);
+                }
+                else {
+                    XO_ASSERT(top < BVHStackSize, "xo-math BVH traversal stack overflow.");
+                    stack[top++] = node.child[slot];
+                }
+            }
+        }
+    }
+    return written;
 }
 
-void Matrix4x4::RotationDegrees(float x, float y, float z, Matrix4x4& m) {
-    Matrix4x4 m0, m1, m2;
-    RotationXDegrees(x, m0);
-    RotationYDegrees(y, m1);
-    RotationZDegrees(z, m2);
-    m = m0 * m1 * m2;
+size_t BVH::QueryAABB(const AABB& box, uint32_t* outIndices) const {
+    if (!nodeCount) {
+        return 0;
+    }
+    uint32_t stack[BVHStackSize];
+    int top = 0;
+    stack[top++] = 0;
+    size_t written = 0;
+    while (top) {
+        const Node& node = nodes[stack[--top]];
+        const int bits = BVHOverlaps(node, box);
+        for (int slot = 0; slot < 4; ++slot) {
+            if (bits & (1 << slot)) {
+                if (node.child[slot] & LeafBit) {
+                    written = BVHEmit(indices, node.child[slot] & ~LeafBit, node.count[slot], outIndices, written);
+                }
+                else {
+                    XO_ASSERT(top < BVHStackSize, "xo-math BVH traversal stack overflow.");
+                    stack[top++] = node.child[slot];
+                }
+            }
+        }
+    }
+    return written;
 }
 
-void Matrix4x4::RotationDegrees(const Vector3& v, Matrix4x4& m) {
-    Matrix4x4 m0, m1, m2;
-    RotationXDegrees(v.x, m0);
-    RotationYDegrees(v.y, m1);
-    RotationZDegrees(v.z, m2);
-    m = m0 * m1 * m2;
+size_t BVH::QueryFrustum(const Frustum& frustum, uint32_t* outIndices) const {
+    if (!nodeCount) {
+        return 0;
+    }
+    struct Entry {
+        uint32_t node;
+        uint32_t first;
+        uint32_t planeMask;
+    };
+    const BVHFrustum planes(frustum);
+    Entry stack[BVHStackSize];
+    int top = 0;
+    stack[top++] = { 0, 0, Frustum::AllPlanes };
+    size_t written = 0;
+    while (top) {
+        const Entry entry = stack[--top];
+        const Node& node = nodes[entry.node];
+        uint32_t planeMasks[4];
+        const int bits = planes.Test(node, entry.planeMask, planeMasks);
+        uint32_t first = entry.first;
+        for (int slot = 0; slot < 4; ++slot) {
+            if (bits & (1 << slot)) {
+                // a subtree inside every plane is reported whole, its primitives being one run of indices.
+                if ((node.child[slot] & LeafBit) || planeMasks[slot] == 0) {
+                    written = BVHEmit(indices, first, node.count[slot], outIndices, written);
+                }
+                else {
+                    XO_ASSERT(top < BVHStackSize, "xo-math BVH traversal stack overflow.");
+                    stack[top++] = { node.child[slot], first, planeMasks[slot] };
+                }
+            }
+            first += node.count[slot];
+        }
+    }
+    return written;
 }
 
 
-void Matrix4x4::AxisAngleDegrees(const Vector3& a, float degrees, Matrix4x4& m) {
-    AxisAngleRadians(a, degrees * Deg2Rad, m);
-}
+////////////////////////////////////////////////////////////////////////// DualQuaternion.cpp
 
-void Matrix4x4::OrthographicProjection(float w, float h, float n, float f, Matrix4x4& m) {
-    XO_ASSERT(w != 0.0f, _XO_ASSERT_MSG("::OrthographicProjection Width (w) should not be zero."));
-    XO_ASSERT(h != 0.0f, _XO_ASSERT_MSG("::OrthographicProjection Height (h) should not be zero."));
-    m = Matrix4x4(
-            1.0f/w,    0.0f,       0.0f,    0.0f,
-            0.0f,      1.0f/h,     0.0f,    0.0f,
-            0.0f,      0.0f,       f-n,     0.0f,
-            0.0f,      0.0f,       n*(f-n), 1.0f
-        );
-}
- 
-void Matrix4x4::PerspectiveProjectionRadians(float fovx, float fovy, float n, float f, Matrix4x4& m) {
-    XO_ASSERT(n != f, _XO_ASSERT_MSG("::PerspectiveProjectionRadians Near (n) and far (f) values should not be equal."));
-    m = Matrix4x4(
-            ATan(fovx/2.0f),   0.0f,               0.0f,               0.0f,
-            0.0f,              ATan(fovy/2.0f),    0.0f,               0.0f,
-            0.0f,              0.0f,               f/(f-n),            1.0f,
-            0.0f,              0.0f,               -n*(f/-n),          1.0f
-        );
+const DualQuaternion DualQuaternion::Identity(Quaternion(0.0f, 0.0f, 0.0f, 1.0f), Quaternion(0.0f, 0.0f, 0.0f, 0.0f));
+
+namespace
+{
+    _XOINL float DualQuaternionDot(const Quaternion& a, const Quaternion& b) {
+        return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+    }
+
+    // a * s
+    _XOINL Quaternion DualQuaternionScale(const Quaternion& a, float s) {
+        return Quaternion(a.x * s, a.y * s, a.z * s, a.w * s);
+    }
+
+    // a * s + b * t
+    _XOINL Quaternion DualQuaternionSum(const Quaternion& a, float s, const Quaternion& b, float t) {
+        return Quaternion(a.x * s + b.x * t, a.y * s + b.y * t, a.z * s + b.z * t, a.w * s + b.w * t);
+    }
 }
 
-void Matrix4x4::PerspectiveProjectionDegrees(float fovx, float fovy, float n, float f, Matrix4x4& outMatrix) {
-    Matrix4x4::PerspectiveProjectionRadians(fovx * Deg2Rad, fovy * Deg2Rad, n, f, outMatrix);
+DualQuaternion::DualQuaternion() {
 }
 
-void Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to, const Vector3& up, Matrix4x4& m) {
-    Vector3 zAxis = (to - from).Normalized();
-    Vector3 xAxis = Vector3::Cross(up, zAxis).Normalized();
-    Vector3 yAxis = Vector3::Cross(zAxis, xAxis);
-    m = Matrix4x4(
-            xAxis.x,           yAxis.x,            zAxis.x,            0.0f,
-            xAxis.y,           yAxis.y,            zAxis.y,            0.0f,
-            xAxis.z,           yAxis.z,            zAxis.z,            0.0f,
-            -xAxis.Dot(from),  -yAxis.Dot(from),   -zAxis.Dot(from),   1.0f
-        );
+DualQuaternion::DualQuaternion(const Quaternion& real, const Quaternion& dual) :
+    real(real),
+    dual(dual)
+{
 }
 
-void Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to, Matrix4x4& m) {
-    LookAtFromPosition(from, to, Vector3::Up, m);
+DualQuaternion::DualQuaternion(const Quaternion& rotation, const Vector3& translation) :
+    real(rotation),
+    dual(DualQuaternionScale(Quaternion(translation.x, translation.y, translation.z, 0.0f) * rotation, 0.5f))
+{
 }
 
-void Matrix4x4::LookAtFromDirection(const Vector3& direction, const Vector3& up, Matrix4x4& m) {
-    Vector3 zAxis = direction.Normalized();
-    Vector3 xAxis = Vector3::Cross(up, zAxis).Normalized();
-    Vector3 yAxis = Vector3::Cross(zAxis, xAxis);
-    m = Matrix4x4(
-            xAxis.x,           yAxis.x,            zAxis.x,            0.0f,
-            xAxis.y,           yAxis.y,            zAxis.y,            0.0f,
-            xAxis.z,           yAxis.z,            zAxis.z,            0.0f,
-            0.0f,              0.0f,               0.0f,               1.0f
-        );
+DualQuaternion::DualQuaternion(const Transform& t) :
+    DualQuaternion(t.rotation, t.translation)
+{
 }
 
-void Matrix4x4::LookAtFromDirection(const Vector3& direction, Matrix4x4& m) {
-    LookAtFromDirection(direction, Vector3::Up, m);
+DualQuaternion& DualQuaternion::Normalize() {
+    const float inverseMagnitude = 1.0f / Sqrt(DualQuaternionDot(real, real));
+    real = DualQuaternionScale(real, inverseMagnitude);
+    dual = DualQuaternionSum(dual, inverseMagnitude, real, -DualQuaternionDot(real, dual) * inverseMagnitude);
+    return *this;
 }
 
-Matrix4x4 Matrix4x4::Scale(float xyz) {
-    Matrix4x4 m;
-    Scale(xyz, m);
-    return m;
+DualQuaternion& DualQuaternion::MakeInverse() {
+    real.MakeConjugate();
+    dual.MakeConjugate();
+    return *this;
 }
 
-Matrix4x4 Matrix4x4::Scale(float x, float y, float z) {
-    Matrix4x4 m;
-    Scale(x, y, z, m);
-    return m;
+void DualQuaternion::ToMatrix(Matrix3x4& outMatrix) const {
+    ToTransform().ToMatrix(outMatrix);
 }
 
-Matrix4x4 Matrix4x4::Scale(const Vector3& v) {
-    Matrix4x4 m;
-    Scale(v, m);
-    return m;
+void DualQuaternion::Nlerp(const DualQuaternion& a, const DualQuaternion& b, float t, DualQuaternion& outQuat) {
+    const float s = 1.0f - t;
+    if (DualQuaternionDot(a.real, b.real) < 0.0f) {
+        t = -t;
+    }
+    outQuat.real = DualQuaternionSum(a.real, s, b.real, t);
+    outQuat.dual = DualQuaternionSum(a.dual, s, b.dual, t);
+    outQuat.Normalize();
 }
 
-Matrix4x4 Matrix4x4::Translation(float x, float y, float z) {
-    Matrix4x4 m;
-    Translation(x, y, z, m);
-    return m;
+
+////////////////////////////////////////////////////////////////////////// EPA.cpp
+
+const float EPA::Tolerance = 1e-5f;
+
+namespace
+{
+    // Each new point can see at most every face, whose edges around the visible region are each used once.
+    const int EPAMaxEdges = EPA::MaxFaces * 3 / 2;
+
+    struct EPAEdge {
+        int from, to;
+    };
+
+    // Sets the face's normal and distance from its corners. Returns false when the corners are in a line.
+    bool EPASetFace(const Vector3* points, int a, int b, int c, EPA::Polytope::Face& outFace) {
+        const Vector3 normal = (points[b] - points[a]).Cross(points[c] - points[a]);
+        const float lengthSquared = normal.MagnitudeSquared();
+        if (!(lengthSquared > 0.0f)) {
+            return false;
+        }
+        outFace.normal = normal * (1.0f / Sqrt(lengthSquared));
+        outFace.distance = outFace.normal.Dot(points[a]);
+        outFace.vertices[0] = a;
+        outFace.vertices[1] = b;
+        outFace.vertices[2] = c;
+        return true;
+    }
+
+    // The barycentric coordinates of the origin projected onto the face's plane.
+    void EPABarycentric(const Vector3* points, const EPA::Polytope::Face& face, float& outU, float& outV, float& outW) {
+        const Vector3& a = points[face.vertices[0]];
+        const Vector3 ab = points[face.vertices[1]] - a, ac = points[face.vertices[2]] - a, ap = face.normal * face.distance - a;
+        const float d00 = ab.Dot(ab), d01 = ab.Dot(ac), d11 = ac.Dot(ac), d20 = ap.Dot(ab), d21 = ap.Dot(ac);
+        const float denominator = d00 * d11 - d01 * d01;
+        outV = (d11 * d20 - d01 * d21) / denominator;
+        outW = (d00 * d21 - d01 * d20) / denominator;
+        outU = 1.0f - outV - outW;
+    }
 }
 
-Matrix4x4 Matrix4x4::Translation(const Vector3& v) {
-    Matrix4x4 m;
-    Translation(v, m);
-    return m;
+bool EPA::Polytope::Start(const GJK::Simplex& simplex) {
+    XO_ASSERT(simplex.count == 4, "xo-math EPA::Polytope::Start needs a tetrahedron.");
+    size = 0.0f;
+    for (int p = 0; p < 4; ++p) {
+        points[p] = simplex.points[p];
+        supportsA[p] = simplex.supportsA[p];
+        supportsB[p] = simplex.supportsB[p];
+        size = Max(size, points[p].Magnitude());
+    }
+    vertexCount = 4;
+    // each face is wound so its normal points away from the opposite corner.
+    static const int corners[4][4] = { { 0, 1, 2, 3 }, { 0, 3, 1, 2 }, { 0, 2, 3, 1 }, { 1, 3, 2, 0 } };
+    const bool flipped = (points[1] - points[0]).Cross(points[2] - points[0]).Dot(points[3] - points[0]) > 0.0f;
+    for (int f = 0; f < 4; ++f) {
+        const int a = corners[f][0], b = flipped ? corners[f][2] : corners[f][1], c = flipped ? corners[f][1] : corners[f][2];
+        if (!EPASetFace(points, a, b, c, faces[f]) || faces[f].normal.Dot(points[corners[f][3]] - points[a]) >= 0.0f) {
+            return false;
+        }
+    }
+    faceCount = 4;
+    return true;
 }
 
-Matrix4x4 Matrix4x4::RotationXRadians(float radians) {
-    Matrix4x4 m;
-    RotationXRadians(radians, m);
-    return m;
+bool EPA::Polytope::Expand(const Vector3& supportA, const Vector3& supportB) {
+    if (vertexCount == MaxVertices) {
+        return false;
+    }
+    const Vector3 point = supportA - supportB;
+
+    // The faces the point is in front of, and the edges around them, which are those only one of them has. A shared 
+    // edge appears once in each direction.
+    bool visible[MaxFaces];
+    EPAEdge edges[EPAMaxEdges];
+    int visibleCount = 0, edgeCount = 0;
+    for (int f = 0; f < faceCount; ++f) {
+        visible[f] = faces[f].normal.Dot(point - points[faces[f].vertices[0]]) > 0.0f;
+        if (!visible[f]) {
+            continue;
+        }
+        ++visibleCount;
+        for (int e = 0; e < 3; ++e) {
+            const EPAEdge edge = { faces[f].vertices[e], faces[f].vertices[(e + 1) % 3] };
+            int shared = 0;
+            while (shared < edgeCount && !(edges[shared].from == edge.to && edges[shared].to == edge.from)) {
+                ++shared;
+            }
+            if (shared < edgeCount) {
+                edges[shared] = edges[--edgeCount];
+            }
+            else if (edgeCount < EPAMaxEdges) {
+                edges[edgeCount++] = edge;
+            }
+            else {
+                return false;
+            }
+        }
+    }
+    if (visibleCount == 0 || faceCount - visibleCount + edgeCount > MaxFaces) {
+        return false;
+    }
+
+    // Builds the new faces before changing anything, so a point too close to an edge leaves the polytope whole.
+    points[vertexCount] = point;
+    Face added[EPAMaxEdges];
+    for (int e = 0; e < edgeCount; ++e) {
+        if (!EPASetFace(points, edges[e].from, edges[e].to, vertexCount, added[e])) {
+            return false;
+        }
+    }
+    supportsA[vertexCount] = supportA;
+    supportsB[vertexCount] = supportB;
+    ++vertexCount;
+    int kept = 0;
+    for (int f = 0; f < faceCount; ++f) {
+        if (!visible[f]) {
+            faces[kept++] = faces[f];
+        }
+    }
+    for (int e = 0; e < edgeCount; ++e) {
+        faces[kept++] = added[e];
+    }
+    faceCount = kept;
+    return true;
 }
 
-Matrix4x4 Matrix4x4::RotationYRadians(float radians) {
-    Matrix4x4 m;
-    RotationYRadians(radians, m);
-    return m;
+int EPA::Polytope::ClosestFace() const {
+    int closest = 0;
+    for (int f = 1; f < faceCount; ++f) {
+        if (faces[f].distance < faces[closest].distance) {
+            closest = f;
+        }
+    }
+    return closest;
+}
+
+void EPA::Polytope::Contact(int face, Vector3& outPointA, Vector3& outPointB) const {
+    // Flat parts of the difference, such as the sides of boxes, become several faces in one plane, and the origin 
+    // projected onto the plane can be in any of them. The one it's most inside of is used.
+    float u, v, w;
+    EPABarycentric(points, faces[face], u, v, w);
+    for (int f = 0; f < faceCount; ++f) {
+        if (f != face && faces[f].distance - faces[face].distance <= Tolerance * size && 
+            faces[f].normal.Dot(faces[face].normal) >= 1.0f - Tolerance) {
+            float fu, fv, fw;
+            EPABarycentric(points, faces[f], fu, fv, fw);
+            if (Min(fu, Min(fv, fw)) > Min(u, Min(v, w))) {
+                face = f;
+                u = fu;
+                v = fv;
+                w = fw;
+            }
+        }
+    }
+    // the point is inside the face, to within rounding.
+    u = Max(u, 0.0f);
+    v = Max(v, 0.0f);
+    w = Max(w, 0.0f);
+    const float scale = 1.0f / (u + v + w);
+    u *= scale;
+    v *= scale;
+    w *= scale;
+    const Face& f = faces[face];
+    outPointA = supportsA[f.vertices[0]] * u + supportsA[f.vertices[1]] * v + supportsA[f.vertices[2]] * w;
+    outPointB = supportsB[f.vertices[0]] * u + supportsB[f.vertices[1]] * v + supportsB[f.vertices[2]] * w;
+}
+
+
+////////////////////////////////////////////////////////////////////////// Frustum.cpp
+
+Frustum& Frustum::Set(const Matrix4x4& m, ClipDepth depth) {
+    // Clip space x, y and z are the dot products of rows 0, 1 and 2 with the point, and w of row 3. Each plane is one 
+    // of the clip conditions -w <= x <= w, -w <= y <= w, and 0 <= z <= w or -w <= z <= w, rearranged to row . p >= 0.
+    const Vector4 r0 = m[0], r1 = m[1], r2 = m[2], r3 = m[3];
+    planes[Left] = r3 + r0;
+    planes[Right] = r3 - r0;
+    planes[Bottom] = r3 + r1;
+    planes[Top] = r3 - r1;
+    planes[Near] = depth == ClipDepth::ZeroToOne ? r2 : r3 + r2;
+    planes[Far] = r3 - r2;
+    for (int i = 0; i < PlaneCount; ++i) {
+        Vector4& p = planes[i];
+        const float length = Sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
+        if (length > 0.0f) {
+            p /= length;
+        }
+    }
+    return *this;
 }
 
-Matrix4x4 Matrix4x4::RotationZRadians(float radians) {
-    Matrix4x4 m;
-    RotationZRadians(radians, m);
-    return m;
-}
+namespace
+{
+    _XOINL uint32_t FrustumBitCount(uint32_t bits) {
+        bits = bits - ((bits >> 1) & 0x55555555);
+        bits = (bits & 0x33333333) + ((bits >> 2) & 0x33333333);
+        return (((bits + (bits >> 4)) & 0x0f0f0f0f) * 0x01010101) >> 24;
+    }
+
+    // The planes selected by a plane mask, with each element broadcast to every lane. Boxes use the normals halved, and 
+    // the absolute value of those, so they can work from min + max and max - min instead of center and extents.
+    struct FrustumPlanes {
+        FrustumPlanes(const Frustum& frustum, uint32_t planeMask) : count(0) {
+            for (int i = 0; i < Frustum::PlaneCount; ++i) {
+                if (planeMask & (1 << i)) {
+                    const Vector4& p = frustum.planes[i];
+                    x[count] = wide::Set(p.x);
+                    y[count] = wide::Set(p.y);
+                    z[count] = wide::Set(p.z);
+                    w[count] = wide::Set(p.w);
+                    halfX[count] = wide::Set(p.x * 0.5f);
+                    halfY[count] = wide::Set(p.y * 0.5f);
+                    halfZ[count] = wide::Set(p.z * 0.5f);
+                    absHalfX[count] = wide::Set(Abs(p.x) * 0.5f);
+                    absHalfY[count] = wide::Set(Abs(p.y) * 0.5f);
+                    absHalfZ[count] = wide::Set(Abs(p.z) * 0.5f);
+                    ++count;
+                }
+            }
+        }
+
+        // Mask of the lanes whose spheres are not entirely behind any plane.
+        _XOINL wide::Float Spheres(wide::Float cx, wide::Float cy, wide::Float cz, wide::Float radius) const {
+            using namespace wide;
+            const Float reach = Negate(radius);
+            Float visible = True();
+            for (int i = 0; i < count; ++i) {
+                const Float distance = MulAdd(x[i], cx, MulAdd(y[i], cy, MulAdd(z[i], cz, w[i])));
+                visible = And(visible, CmpGe(distance, reach));
+            }
+            return visible;
+        }
+
+        // Mask of the lanes whose boxes are not entirely behind any plane. A box reaches |n| . extents toward a plane.
+        // sum is min + max (twice the center) and size is max - min (twice the extents).
+        _XOINL wide::Float Boxes(wide::Float sumX, wide::Float sumY, wide::Float sumZ, wide::Float sizeX, wide::Float sizeY, wide::Float sizeZ) const {
+            using namespace wide;
+            Float visible = True();
+            for (int i = 0; i < count; ++i) {
+                const Float distance = MulAdd(halfX[i], sumX, MulAdd(halfY[i], sumY, MulAdd(halfZ[i], sumZ, w[i])));
+                const Float reach = MulAdd(absHalfX[i], sizeX, MulAdd(absHalfY[i], sizeY, Mul(absHalfZ[i], sizeZ)));
+                visible = And(visible, CmpGe(distance, Negate(reach)));
+            }
+            return visible;
+        }
+
+        wide::Float x[Frustum::PlaneCount], y[Frustum::PlaneCount], z[Frustum::PlaneCount], w[Frustum::PlaneCount];
+        wide::Float halfX[Frustum::PlaneCount], halfY[Frustum::PlaneCount], halfZ[Frustum::PlaneCount];
+        wide::Float absHalfX[Frustum::PlaneCount], absHalfY[Frustum::PlaneCount], absHalfZ[Frustum::PlaneCount];
+        int count;
+    };
+
+    struct FrustumSphereTest {
+        typedef Vector4 Record;
+        _XOINL static int Visible(const FrustumPlanes& planes, const Vector4* spheres) {
+            wide::Float x, y, z, radius;
+            wide::LoadTransposed4(&spheres->x, sizeof(Vector4) / sizeof(float), x, y, z, radius);
+            return wide::MoveMask(planes.Spheres(x, y, z, radius));
+        }
+    };
+
+    struct FrustumAABBTest {
+        typedef AABB Record;
+        _XOINL static int Visible(const FrustumPlanes& planes, const AABB* boxes) {
+            using namespace wide;
+            Float minX, minY, minZ, maxX, maxY, maxZ;
+#if defined(XO_SSE)
+            // the padding lanes of each corner are loaded and ignored.
+            Float minW, maxW;
+            LoadTransposed4(&boxes->min.x, sizeof(AABB) / sizeof(float), minX, minY, minZ, minW);
+            LoadTransposed4(&boxes->max.x, sizeof(AABB) / sizeof(float), maxX, maxY, maxZ, maxW);
+#else
+            minX = boxes->min.x;
+            minY = boxes->min.y;
+            minZ = boxes->min.z;
+            maxX = boxes->max.x;
+            maxY = boxes->max.y;
+            maxZ = boxes->max.z;
+#endif
+            return MoveMask(planes.Boxes(Add(minX, maxX), Add(minY, maxY), Add(minZ, maxZ), Sub(maxX, minX), Sub(maxY, minY), Sub(maxZ, minZ)));
+        }
+    };
+
+    // The visibility bits of the last count (< Width) records, tested as a whole group with the last record repeated 
+    // in the unused lanes so that they go through exactly the same arithmetic as every other group.
+    template <class Test>
+    _XOINL int FrustumTailVisible(const FrustumPlanes& planes, const typename Test::Record* records, size_t count) {
+        typename Test::Record tail[wide::Width];
+        for (size_t i = 0; i < (size_t)wide::Width; ++i) {
+            tail[i] = records[i < count ? i : count - 1];
+        }
+        return Test::Visible(planes, tail) & wide::LaneBits((int)count);
+    }
+
+    template <class Test>
+    size_t FrustumCullBits(const FrustumPlanes& planes, const typename Test::Record* records, size_t count, uint32_t* outVisibleBits) {
+        // 32 is a multiple of every Width, so a group's bits never straddle two words.
+        memset(outVisibleBits, 0, ((count + 31) / 32) * sizeof(uint32_t));
+        size_t visible = 0;
+        size_t i = 0;
+        for (; i + wide::Width <= count; i += wide::Width) {
+            const uint32_t bits = (uint32_t)Test::Visible(planes, records + i);
+            outVisibleBits[i / 32] |= bits << (i % 32);
+            visible += FrustumBitCount(bits);
+        }
+        if (i < count) {
+            const uint32_t bits = (uint32_t)FrustumTailVisible<Test>(planes, records + i, count - i);
+            outVisibleBits[i / 32] |= bits << (i % 32);
+            visible += FrustumBitCount(bits);
+        }
+        return visible;
+    }
+
+    template <class Test>
+    size_t FrustumCullIndices(const FrustumPlanes& planes, const typename Test::Record* records, size_t count, uint32_t* outIndices) {
+        size_t visible = 0;
+        size_t i = 0;
+        // Every lane writes its index and only visible lanes advance the output, which compacts without branches. The 
+        // write is always in bounds, as visible can never pass i + lane.
+        for (; i + wide::Width <= count; i += wide::Width) {
+            const int bits = Test::Visible(planes, records + i);
+            for (int lane = 0; lane < wide::Width; ++lane) {
+                outIndices[visible] = (uint32_t)(i + lane);
+                visible += (bits >> lane) & 1;
+            }
+        }
+        if (i < count) {
+            const int bits = FrustumTailVisible<Test>(planes, records + i, count - i);
+            for (size_t lane = 0; i + lane < count; ++lane) {
+                outIndices[visible] = (uint32_t)(i + lane);
+                visible += (bits >> lane) & 1;
+            }
+        }
+        return visible;
+    }
+}
+
+size_t Frustum::CullSpheres(const Vector4* spheres, size_t count, uint32_t* outVisibleBits, uint32_t planeMask) const {
+    return FrustumCullBits<FrustumSphereTest>(FrustumPlanes(*this, planeMask), spheres, count, outVisibleBits);
+}
+
+size_t Frustum::CullSpheresIndices(const Vector4* spheres, size_t count, uint32_t* outIndices, uint32_t planeMask) const {
+    return FrustumCullIndices<FrustumSphereTest>(FrustumPlanes(*this, planeMask), spheres, count, outIndices);
+}
+
+size_t Frustum::CullAABBs(const AABB* boxes, size_t count, uint32_t* outVisibleBits, uint32_t planeMask) const {
+    return FrustumCullBits<FrustumAABBTest>(FrustumPlanes(*this, planeMask), boxes, count, outVisibleBits);
+}
+
+size_t Frustum::CullAABBsIndices(const AABB* boxes, size_t count, uint32_t* outIndices, uint32_t planeMask) const {
+    return FrustumCullIndices<FrustumAABBTest>(FrustumPlanes(*this, planeMask), boxes, count, outIndices);
+}
+
+
+////////////////////////////////////////////////////////////////////////// GJK.cpp
+
+const float GJK::Tolerance = 1e-5f;
+
+namespace
+{
+    // The closest point to the origin of part of a simplex: which of its points it needs, and their weights.
+    struct GJKClosest {
+        int indices[4];
+        float weights[4];
+        int count;
+        float distanceSquared;
+
+        void Set(const Vector3* points, int i) {
+            indices[0] = i;
+            weights[0] = 1.0f;
+            count = 1;
+            distanceSquared = points[i].MagnitudeSquared();
+        }
+        void Set(const Vector3* points, int i, int j, float t) {
+            indices[0] = i;
+            indices[1] = j;
+            weights[0] = 1.0f - t;
+            weights[1] = t;
+            count = 2;
+            distanceSquared = (points[i] + (points[j] - points[i]) * t).MagnitudeSquared();
+        }
+        void Set(const Vector3* points, int i, int j, int k, float v, float w) {
+            indices[0] = i;
+            indices[1] = j;
+            indices[2] = k;
+            weights[0] = 1.0f - v - w;
+            weights[1] = v;
+            weights[2] = w;
+            count = 3;
+            distanceSquared = (points[i] + (points[j] - points[i]) * v + (points[k] - points[i]) * w).MagnitudeSquared();
+        }
+    };
+
+    void GJKSegment(const Vector3* points, int i, int j, GJKClosest& out) {
+        const Vector3 ab = points[j] - points[i];
+        const float t = -points[i].Dot(ab), lengthSquared = ab.Dot(ab);
+        if (t <= 0.0f || lengthSquared <= 0.0f) {
+            out.Set(points, i);
+        }
+        else if (t >= lengthSquared) {
+            out.Set(points, j);
+        }
+        else {
+            out.Set(points, i, j, t / lengthSquared);
+        }
+    }
+
+    // Triangle::ClosestPoint for the origin, keeping the corners of the region it falls in.
+    void GJKTriangle(const Vector3* points, int i, int j, int k, GJKClosest& out) {
+        const Vector3& a = points[i];
+        const Vector3& b = points[j];
+        const Vector3& c = points[k];
+        const Vector3 ab = b - a, ac = c - a;
+        const float d1 = -ab.Dot(a), d2 = -ac.Dot(a);
+        if (d1 <= 0.0f && d2 <= 0.0f) {
+            return out.Set(points, i);
+        }
+        const float d3 = -ab.Dot(b), d4 = -ac.Dot(b);
+        if (d3 >= 0.0f && d4 <= d3) {
+            return out.Set(points, j);
+        }
+        const float vc = d1 * d4 - d3 * d2;
+        if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+            return out.Set(points, i, j, d1 / (d1 - d3));
+        }
+        const float d5 = -ab.Dot(c), d6 = -ac.Dot(c);
+        if (d6 >= 0.0f && d5 <= d6) {
+            return out.Set(points, k);
+        }
+        const float vb = d5 * d2 - d1 * d6;
+        if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+            return out.Set(points, i, k, d2 / (d2 - d6));
+        }
+        const float va = d3 * d6 - d5 * d4;
+        if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f) {
+            return out.Set(points, j, k, (d4 - d3) / ((d4 - d3) + (d5 - d6)));
+        }
+        const float sum = va + vb + vc;
+        if (sum <= 0.0f) {
+            // the corners are in a line, so the closest point is on one of the edges.
+            GJKClosest edge;
+            GJKSegment(points, i, j, out);
+            GJKSegment(points, i, k, edge);
+            if (edge.distanceSquared < out.distanceSquared) {
+                out = edge;
+            }
+            GJKSegment(points, j, k, edge);
+            if (edge.distanceSquared < out.distanceSquared) {
+                out = edge;
+            }
+            return;
+        }
+        out.Set(points, i, j, k, vb / sum, vc / sum);
+    }
+
+    // The origin is inside the tetrahedron when it's on the same side of each face as the opposite corner. Otherwise 
+    // the closest point is on one of the faces it's outside of.
+    void GJKTetrahedron(const Vector3* points, GJKClosest& out) {
+        static const int faces[4][4] = { { 0, 1, 2, 3 }, { 0, 1, 3, 2 }, { 0, 2, 3, 1 }, { 1, 2, 3, 0 } };
+        float volumes[4], originVolumes[4];
+        bool outside = false;
+        out.distanceSquared = std::numeric_limits<float>::infinity();
+        for (int f = 0; f < 4; ++f) {
+            const Vector3& a = points[faces[f][0]];
+            const Vector3 normal = (points[faces[f][1]] - a).Cross(points[faces[f][2]] - a);
+            const Vector3 toOpposite = points[faces[f][3]] - a;
+            volumes[f] = normal.Dot(toOpposite);
+            originVolumes[f] = -normal.Dot(a);
+            // a flat tetrahedron has no inside, so all of its faces are tried.
+            const bool flat = volumes[f] * volumes[f] <= 1e-12f * normal.MagnitudeSquared() * toOpposite.MagnitudeSquared();
+            if (flat || originVolumes[f] * volumes[f] < 0.0f) {
+                outside = true;
+                GJKClosest face;
+                GJKTriangle(points, faces[f][0], faces[f][1], faces[f][2], face);
+                if (face.distanceSquared < out.distanceSquared) {
+                    out = face;
+                }
+            }
+        }
+        if (!outside) {
+            // the weight of each corner is the share of the volume of the tetrahedron on its side of the opposite face.
+            for (int f = 0; f < 4; ++f) {
+                out.indices[f] = f;
+                out.weights[faces[f][3]] = originVolumes[f] / volumes[f];
+            }
+            out.count = 4;
+            out.distanceSquared = 0.0f;
+        }
+    }
+}
+
+Vector3 GJK::Simplex::Reduce() {
+    GJKClosest closest;
+    switch (count) {
+    case 1:
+        closest.Set(points, 0);
+        break;
+    case 2:
+        GJKSegment(points, 0, 1, closest);
+        break;
+    case 3:
+        GJKTriangle(points, 0, 1, 2, closest);
+        break;
+    default:
+        GJKTetrahedron(points, closest);
+        break;
+    }
+    // the kept indices are in increasing order, so moving each down doesn't overwrite one still to be moved.
+    for (int p = 0; p < closest.count; ++p) {
+        const int from = closest.indices[p];
+        points[p] = points[from];
+        supportsA[p] = supportsA[from];
+        supportsB[p] = supportsB[from];
+        weights[p] = closest.weights[p];
+    }
+    count = closest.count;
+    Vector3 v = points[0] * weights[0];
+    for (int p = 1; p < count; ++p) {
+        v += points[p] * weights[p];
+    }
+    return v;
+}
+
+bool GJK::Simplex::Contains(const Vector3& point) const {
+    for (int p = 0; p < count; ++p) {
+        if (points[p].x == point.x && points[p].y == point.y && points[p].z == point.z) {
+            return true;
+        }
+    }
+    return false;
+}
+
+Vector3 GJK::Simplex::PointA() const {
+    Vector3 point = supportsA[0] * weights[0];
+    for (int p = 1; p < count; ++p) {
+        point += supportsA[p] * weights[p];
+    }
+    return point;
+}
+
+Vector3 GJK::Simplex::PointB() const {
+    Vector3 point = supportsB[0] * weights[0];
+    for (int p = 1; p < count; ++p) {
+        point += supportsB[p] * weights[p];
+    }
+    return point;
+}
+
+Vector3 GJK::Hull::Support(const Vector3& direction) const {
+    XO_ASSERT(count > 0, "xo-math GJK::Hull::Support needs at least one point.");
+    size_t i = 0, best = 0;
+    float bestDot = -std::numeric_limits<float>::infinity();
+#if defined(XO_SSE)
+    // Each lane keeps the furthest of the points it has seen and its index, in a float which is exact up to 2^24.
+    XO_ASSERT(count <= (1u << 24), "xo-math GJK::Hull::Support too many points.");
+    using namespace wide;
+    const Float dx = wide::Set(direction.x), dy = wide::Set(direction.y), dz = wide::Set(direction.z);
+    _XOSIMDALIGN32 float firstIndices[Width];
+    for (int lane = 0; lane < Width; ++lane) {
+        firstIndices[lane] = (float)lane;
+    }
+    Float laneDots = wide::Set(bestDot), laneIndices = Zero(), indices = Load(firstIndices);
+    const Float step = wide::Set((float)Width);
+    for (; i + Width <= count; i += Width) {
+        Float x, y, z, w;
+        LoadTransposed4(&points[i].x, 4, x, y, z, w);
+        const Float dots = MulAdd(z, dz, MulAdd(y, dy, Mul(x, dx)));
+        const Float further = CmpGt(dots, laneDots);
+        laneDots = Select(further, dots, laneDots);
+        laneIndices = Select(further, indices, laneIndices);
+        indices = Add(indices, step);
+    }
+    _XOSIMDALIGN32 float dots[Width], lanes[Width];
+    Store(dots, laneDots);
+    Store(lanes, laneIndices);
+    for (int lane = 0; lane < Width; ++lane) {
+        if (dots[lane] > bestDot) {
+            bestDot = dots[lane];
+            best = (size_t)lanes[lane];
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        const float dot = points[i].x * direction.x + points[i].y * direction.y + points[i].z * direction.z;
+        if (dot > bestDot) {
+            bestDot = dot;
+            best = i;
+        }
+    }
+    return points[best];
+}
+
+
+////////////////////////////////////////////////////////////////////////// Hierarchy.cpp
+
+namespace
+{
+    // A level is split over threads only when each thread gets at least this many nodes.
+    const size_t HierarchyThreadShare = 1 << 11;
+
+    // Holds threads at the end of a level until all of them get there. Waiting threads yield rather than sleep, as a 
+    // level is over in microseconds.
+    class HierarchyBarrier {
+    public:
+        explicit HierarchyBarrier(unsigned count) : count(count), waiting(0), generation(0) {
+        }
+
+        void Wait() {
+            const unsigned current = generation.load(std::memory_order_acquire);
+            if (waiting.fetch_add(1, std::memory_order_acq_rel) + 1 == count) {
+                waiting.store(0, std::memory_order_relaxed);
+                generation.fetch_add(1, std::memory_order_release);
+            }
+            else {
+                while (generation.load(std::memory_order_acquire) == current) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+    private:
+        const unsigned count;
+        std::atomic<unsigned> waiting;
+        std::atomic<unsigned> generation;
+    };
+
+    // The world transform of a root, and of a node under parent.
+    template <class Matrix>
+    _XOINL void HierarchyRoot(const Matrix& local, Matrix& outWorld) {
+        outWorld = local;
+    }
+
+    template <class Matrix>
+    _XOINL void HierarchyRoot(const Transform& local, Matrix& outWorld) {
+        local.ToMatrix(outWorld);
+    }
+
+    template <class Matrix>
+    _XOINL void HierarchyChild(const Matrix& parent, const Matrix& local, Matrix& outWorld) {
+        Matrix::Multiply(parent, local, outWorld);
+    }
+
+    // The local transform is made a matrix in place of the world one, then multiplied in place.
+    template <class Matrix>
+    _XOINL void HierarchyChild(const Matrix& parent, const Transform& local, Matrix& outWorld) {
+        local.ToMatrix(outWorld);
+        Matrix::Multiply(parent, outWorld, outWorld);
+    }
+
+    // Computes the world transforms of nodes begin to end of level, in the order of Hierarchy::Nodes. When the nodes 
+    // are already in level order (Ordered) the i-th node is node i, and locals and worlds are read straight through.
+    template <bool Ordered, class Local, class World>
+    _XOINL void HierarchyLevel(const Hierarchy& hierarchy, size_t level, size_t begin, size_t end, 
+                               const Local* locals, World* outWorlds) {
+        const uint32_t* nodes = hierarchy.Nodes();
+        if (level == 0) {
+            for (size_t i = begin; i < end; ++i) {
+                const size_t node = Ordered ? i : nodes[i];
+                HierarchyRoot(locals[node], outWorlds[node]);
+            }
+        }
+        else {
+            const uint32_t* parents = hierarchy.Parents();
+            for (size_t i = begin; i < end; ++i) {
+                const size_t node = Ordered ? i : nodes[i];
+                HierarchyChild(outWorlds[parents[i]], locals[node], outWorlds[node]);
+            }
+        }
+    }
+
+    // Every thread walks every level. Levels wide enough give each thread a contiguous part and end on the barrier; 
+    // narrower ones are done by thread 0 alone, the others waiting for it before the next split level.
+    template <bool Ordered, class Local, class World>
+    void HierarchyUpdate(const Hierarchy& hierarchy, const Local* locals, World* outWorlds, unsigned threadCount) {
+        const uint32_t* offsets = hierarchy.LevelOffsets();
+        const size_t levels = hierarchy.LevelCount();
+        size_t widest = 0;
+        for (size_t level = 0; level < levels; ++level) {
+            widest = _XO_MAX(widest, (size_t)(offsets[level + 1] - offsets[level]));
+        }
+        const unsigned threads = xo_internal::ThreadCount(threadCount, widest, HierarchyThreadShare);
+        if (threads == 1) {
+            for (size_t level = 0; level < levels; ++level) {
+                HierarchyLevel<Ordered>(hierarchy, level, offsets[level], offsets[level + 1], locals, outWorlds);
+            }
+            return;
+        }
+
+        HierarchyBarrier barrier(threads);
+        xo_internal::Parallel(threads, [&](unsigned t) {
+            bool pending = false;
+            for (size_t level = 0; level < levels; ++level) {
+                const size_t begin = offsets[level], width = offsets[level + 1] - begin;
+                if (width < HierarchyThreadShare * threads) {
+                    if (t == 0) {
+                        HierarchyLevel<Ordered>(hierarchy, level, begin, begin + width, locals, outWorlds);
+                    }
+                    pending = true;
+                    continue;
+                }
+                if (pending) {
+                    barrier.Wait();
+                    pending = false;
+                }
+                HierarchyLevel<Ordered>(hierarchy, level, begin + width * t / threads, begin + width * (t + 1) / threads, locals, outWorlds);
+                barrier.Wait();
+            }
+        });
+    }
+
+    template <class Local, class World>
+    void HierarchyUpdate(const Hierarchy& hierarchy, const Local* locals, World* outWorlds, unsigned threadCount) {
+        if (hierarchy.IsLevelOrder()) {
+            HierarchyUpdate<true>(hierarchy, locals, outWorlds, threadCount);
+        }
+        else {
+            HierarchyUpdate<false>(hierarchy, locals, outWorlds, threadCount);
+        }
+    }
+}
+
+Hierarchy::Hierarchy() :
+    nodes(nullptr), parents(nullptr), levelOffsets(nullptr), size(0), capacity(0), levelCount(0), levelOrder(true)
+{
+}
+
+Hierarchy::Hierarchy(const uint32_t* parents, size_t count) :
+    nodes(nullptr), parents(nullptr), levelOffsets(nullptr), size(0), capacity(0), levelCount(0), levelOrder(true)
+{
+    Build(parents, count);
+}
+
+Hierarchy::Hierarchy(const Hierarchy& hierarchy) :
+    nodes(nullptr), parents(nullptr), levelOffsets(nullptr), size(0), capacity(0), levelCount(0), levelOrder(true)
+{
+    *this = hierarchy;
+}
+
+Hierarchy::Hierarchy(Hierarchy&& hierarchy) :
+    nodes(hierarchy.nodes), parents(hierarchy.parents), levelOffsets(hierarchy.levelOffsets), 
+    size(hierarchy.size), capacity(hierarchy.capacity), levelCount(hierarchy.levelCount), levelOrder(hierarchy.levelOrder)
+{
+    hierarchy.nodes = hierarchy.parents = hierarchy.levelOffsets = nullptr;
+    hierarchy.size = hierarchy.capacity = hierarchy.levelCount = 0;
+    hierarchy.levelOrder = true;
+}
+
+Hierarchy::~Hierarchy() {
+    Release();
+}
+
+void Hierarchy::Allocate(size_t count) {
+    // One block: the nodes, their parents, then room for as many levels as there are nodes.
+    nodes = (uint32_t*)XO_ALIGNED_MALLOC((count * 3 + 1) * sizeof(uint32_t), 64);
+    parents = nodes + count;
+    levelOffsets = parents + count;
+    capacity = count;
+}
+
+void Hierarchy::Release() {
+    if (nodes) {
+        XO_ALIGNED_FREE(nodes);
+    }
+    nodes = parents = levelOffsets = nullptr;
+    size = capacity = levelCount = 0;
+    levelOrder = true;
+}
+
+Hierarchy& Hierarchy::operator = (const Hierarchy& hierarchy) {
+    if (this != &hierarchy) {
+        Release();
+        if (hierarchy.nodes) {
+            Allocate(hierarchy.size);
+            size = hierarchy.size;
+            levelCount = hierarchy.levelCount;
+            levelOrder = hierarchy.levelOrder;
+            memcpy(nodes, hierarchy.nodes, size * sizeof(uint32_t));
+            memcpy(parents, hierarchy.parents, size * sizeof(uint32_t));
+            memcpy(levelOffsets, hierarchy.levelOffsets, (levelCount + 1) * sizeof(uint32_t));
+        }
+    }
+    return *this;
+}
+
+Hierarchy& Hierarchy::operator = (Hierarchy&& hierarchy) {
+    if (this != &hierarchy) {
+        Release();
+        nodes = hierarchy.nodes;
+        parents = hierarchy.parents;
+        levelOffsets = hierarchy.levelOffsets;
+        size = hierarchy.size;
+        capacity = hierarchy.capacity;
+        levelCount = hierarchy.levelCount;
+        levelOrder = hierarchy.levelOrder;
+        hierarchy.nodes = hierarchy.parents = hierarchy.levelOffsets = nullptr;
+        hierarchy.size = hierarchy.capacity = hierarchy.levelCount = 0;
+        hierarchy.levelOrder = true;
+    }
+    return *this;
+}
+
+void Hierarchy::Build(const uint32_t* parents, size_t count) {
+    XO_ASSERT(count < NoParent, "xo-math Hierarchy::Build has too many nodes.");
+    if (!nodes || count > capacity) {
+        Release();
+        Allocate(count);
+    }
+    size = count;
+    levelCount = 0;
+    levelOrder = true;
+    if (!count) {
+        levelOffsets[0] = 0;
+        return;
+    }
+
+    // The depth of each node, kept in this->parents until the nodes are sorted. Each walk up the tree stops at the 
+    // first node whose depth is known, then fills in the depths on the way, so every node is walked through once.
+    uint32_t* depths = this->parents;
+    for (size_t i = 0; i < count; ++i) {
+        depths[i] = NoParent;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t node = (uint32_t)i;
+        uint32_t steps = 0;
+        while (depths[node] == NoParent && parents[node] != NoParent) {
+            XO_ASSERT(parents[node] < count, "xo-math Hierarchy::Build parent index out of range.");
+            XO_ASSERT(steps < count, "xo-math Hierarchy::Build parents form a cycle.");
+            node = parents[node];
+            ++steps;
+        }
+        if (depths[node] == NoParent) {
+            depths[node] = 0;
+        }
+        uint32_t depth = depths[node] + steps;
+        for (uint32_t n = (uint32_t)i; n != node; n = parents[n]) {
+            depths[n] = depth--;
+        }
+        levelCount = _XO_MAX(levelCount, (size_t)depths[(uint32_t)i] + 1);
+    }
+
+    // A counting sort by depth, which keeps the nodes of a level in their order.
+    memset(levelOffsets, 0, (levelCount + 1) * sizeof(uint32_t));
+    for (size_t i = 0; i < count; ++i) {
+        ++levelOffsets[depths[i] + 1];
+    }
+    for (size_t level = 1; level <= levelCount; ++level) {
+        levelOffsets[level] += levelOffsets[level - 1];
+    }
+    for (size_t i = 0; i < count; ++i) {
+        nodes[levelOffsets[depths[i]]++] = (uint32_t)i;
+    }
+    for (size_t level = levelCount; level > 0; --level) {
+        levelOffsets[level] = levelOffsets[level - 1];
+    }
+    levelOffsets[0] = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        this->parents[i] = parents[nodes[i]];
+        levelOrder &= nodes[i] == i;
+    }
+}
+
+void Hierarchy::LevelOrderParents(uint32_t* outParents) const {
+    // The new index of each node, then its parent's.
+    uint32_t* indices = (uint32_t*)XO_ALIGNED_MALLOC(_XO_MAX(size, (size_t)1) * sizeof(uint32_t), 64);
+    for (size_t i = 0; i < size; ++i) {
+        indices[nodes[i]] = (uint32_t)i;
+    }
+    for (size_t i = 0; i < size; ++i) {
+        outParents[i] = parents[i] == NoParent ? NoParent : indices[parents[i]];
+    }
+    XO_ALIGNED_FREE(indices);
+}
+
+void Hierarchy::Update(const Matrix4x4* locals, Matrix4x4* outWorlds, unsigned threadCount) const {
+    HierarchyUpdate(*this, locals, outWorlds, threadCount);
+}
+
+void Hierarchy::Update(const Matrix3x4* locals, Matrix3x4* outWorlds, unsigned threadCount) const {
+    HierarchyUpdate(*this, locals, outWorlds, threadCount);
+}
+
+void Hierarchy::Update(const Transform* locals, Matrix3x4* outWorlds, unsigned threadCount) const {
+    HierarchyUpdate(*this, locals, outWorlds, threadCount);
+}
+
+void Hierarchy::Update(const Transform* locals, Matrix4x4* outWorlds, unsigned threadCount) const {
+    HierarchyUpdate(*this, locals, outWorlds, threadCount);
+}
+
+
+////////////////////////////////////////////////////////////////////////// Matrix3x4.cpp
+
+const Matrix3x4 Matrix3x4::Identity(Vector4(1.0f, 0.0f, 0.0f, 0.0f),
+                                    Vector4(0.0f, 1.0f, 0.0f, 0.0f),
+                                    Vector4(0.0f, 0.0f, 1.0f, 0.0f));
+
+namespace
+{
+#if defined(XO_SSE)
+    _XOINL __m128 Matrix3x4XYZ() {
+        return _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    }
+
+    // The cross product of the xyz of a and b, with a w of zero when theirs are.
+    _XOINL __m128 Matrix3x4Cross(__m128 a, __m128 b) {
+        const __m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+        const __m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+        const __m128 c = _mm_sub_ps(_mm_mul_ps(a, bYZX), _mm_mul_ps(aYZX, b));
+        return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+    }
+
+    // The sum of the four lanes of v, in every lane.
+    _XOINL __m128 Matrix3x4Sum(__m128 v) {
+        v = _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+    }
+
+    // The inverse of the rows a, b and c: the columns of the inverse of the 3x3 are the cross products of pairs of 
+    // rows over the determinant, and the translation is moved back through them. The result is transposed back into 
+    // rows. Returns false without writing anything when the determinant is zero and checkSingular is set.
+    _XOINL bool Matrix3x4Inverse(const Matrix3x4& m, Matrix3x4& outMatrix, bool checkSingular) {
+        const __m128 xyz = Matrix3x4XYZ();
+        const __m128 a = _mm_and_ps(m.r[0].xmm, xyz), b = _mm_and_ps(m.r[1].xmm, xyz), c = _mm_and_ps(m.r[2].xmm, xyz);
+        __m128 c0 = Matrix3x4Cross(b, c), c1 = Matrix3x4Cross(c, a), c2 = Matrix3x4Cross(a, b);
+        const __m128 determinant = Matrix3x4Sum(_mm_mul_ps(a, c0));
+        if (checkSingular && _mm_cvtss_f32(determinant) == 0.0f) {
+            return false;
+        }
+        const __m128 inverseDeterminant = _mm_div_ps(_mm_set1_ps(1.0f), determinant);
+        c0 = _mm_mul_ps(c0, inverseDeterminant);
+        c1 = _mm_mul_ps(c1, inverseDeterminant);
+        c2 = _mm_mul_ps(c2, inverseDeterminant);
+        const __m128 t0 = m.r[0].xmm, t1 = m.r[1].xmm, t2 = m.r[2].xmm;
+        __m128 t = _mm_mul_ps(c0, _mm_shuffle_ps(t0, t0, _MM_SHUFFLE(3, 3, 3, 3)));
+        t = sse::MulAdd(c1, _mm_shuffle_ps(t1, t1, _MM_SHUFFLE(3, 3, 3, 3)), t);
+        t = sse::MulAdd(c2, _mm_shuffle_ps(t2, t2, _MM_SHUFFLE(3, 3, 3, 3)), t);
+        t = _mm_sub_ps(_mm_setzero_ps(), t);
+        _MM_TRANSPOSE4_PS(c0, c1, c2, t);
+        outMatrix.r[0].xmm = c0;
+        outMatrix.r[1].xmm = c1;
+        outMatrix.r[2].xmm = c2;
+        return true;
+    }
+#else
+    bool Matrix3x4Inverse(const Matrix3x4& m, Matrix3x4& outMatrix, bool checkSingular) {
+        const Vector3 a(m.m00, m.m01, m.m02), b(m.m10, m.m11, m.m12), c(m.m20, m.m21, m.m22);
+        const Vector3 t(m.m03, m.m13, m.m23);
+        Vector3 c0 = b.Cross(c), c1 = c.Cross(a), c2 = a.Cross(b);
+        const float determinant = a.Dot(c0);
+        if (checkSingular && determinant == 0.0f) {
+            return false;
+        }
+        const float inverseDeterminant = 1.0f / determinant;
+        c0 *= inverseDeterminant;
+        c1 *= inverseDeterminant;
+        c2 *= inverseDeterminant;
+        const Vector3 translation = -(c0 * t.x + c1 * t.y + c2 * t.z);
+        outMatrix = Matrix3x4(c0.x, c1.x, c2.x, translation.x,
+                              c0.y, c1.y, c2.y, translation.y,
+                              c0.z, c1.z, c2.z, translation.z);
+        return true;
+    }
+#endif
+
+    // w is 1 for points and 0 for directions, so only points pick up the translation column.
+    template <bool IsPoint>
+    _XOINL void Matrix3x4TransformArray(const Matrix3x4& m, const Vector3* vecs, Vector3* outVecs, size_t count) {
+#if defined(XO_SSE)
+        // The missing bottom row transposes to a w of zero in every column, keeping the padding of the output at zero.
+        __m128 c0 = m.r[0].xmm, c1 = m.r[1].xmm, c2 = m.r[2].xmm, c3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        if (!IsPoint) {
+            c3 = _mm_setzero_ps();
+        }
+        for (size_t i = 0; i < count; ++i) {
+            __m128 v = vecs[i].xmm;
+            __m128 r = sse::MulAdd(_mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)), c0, c3);
+            r = sse::MulAdd(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), c1, r);
+            outVecs[i].xmm = sse::MulAdd(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), c2, r);
+        }
+#else
+        const float m00 = m.m00, m01 = m.m01, m02 = m.m02, m03 = IsPoint ? m.m03 : 0.0f;
+        const float m10 = m.m10, m11 = m.m11, m12 = m.m12, m13 = IsPoint ? m.m13 : 0.0f;
+        const float m20 = m.m20, m21 = m.m21, m22 = m.m22, m23 = IsPoint ? m.m23 : 0.0f;
+        for (size_t i = 0; i < count; ++i) {
+            const float x = vecs[i].x, y = vecs[i].y, z = vecs[i].z;
+            outVecs[i].x = m00 * x + m01 * y + m02 * z + m03;
+            outVecs[i].y = m10 * x + m11 * y + m12 * z + m13;
+            outVecs[i].z = m20 * x + m21 * y + m22 * z + m23;
+        }
+#endif
+    }
+}
+
+Matrix3x4::Matrix3x4() {
+}
+
+Matrix3x4::Matrix3x4(float m00, float m01, float m02, float m03, 
+                     float m10, float m11, float m12, float m13, 
+                     float m20, float m21, float m22, float m23) 
+{
+    r[0].Set(m00, m01, m02, m03);
+    r[1].Set(m10, m11, m12, m13);
+    r[2].Set(m20, m21, m22, m23);
+}
+
+Matrix3x4::Matrix3x4(const Matrix3x4& m) {
+    r[0].Set(m.r[0]);
+    r[1].Set(m.r[1]);
+    r[2].Set(m.r[2]);
+}
+
+Matrix3x4::Matrix3x4(const Vector4& r0, const Vector4& r1, const Vector4& r2) {
+    r[0].Set(r0);
+    r[1].Set(r1);
+    r[2].Set(r2);
+}
+
+Matrix3x4::Matrix3x4(const Vector3& r0, const Vector3& r1, const Vector3& r2, const Vector3& translation) {
+    r[0].Set(r0.x, r0.y, r0.z, translation.x);
+    r[1].Set(r1.x, r1.y, r1.z, translation.y);
+    r[2].Set(r2.x, r2.y, r2.z, translation.z);
+}
+
+Matrix3x4::Matrix3x4(const Matrix4x4& m) {
+    r[0].Set(m.r[0]);
+    r[1].Set(m.r[1]);
+    r[2].Set(m.r[2]);
+}
+
+float Matrix3x4::Determinant() const {
+    return m00 * (m11 * m22 - m12 * m21) - m01 * (m10 * m22 - m12 * m20) + m02 * (m10 * m21 - m11 * m20);
+}
+
+void Matrix3x4::MakeInverse() {
+    Matrix3x4Inverse(*this, *this, false);
+}
+
+bool Matrix3x4::TryMakeInverse() {
+    return Matrix3x4Inverse(*this, *this, true);
+}
+
+void Matrix3x4::MakeInverseRigid() {
+#if defined(XO_SSE)
+    const __m128 xyz = Matrix3x4XYZ();
+    const __m128 r0 = r[0].xmm, r1 = r[1].xmm, r2 = r[2].xmm;
+    __m128 a = _mm_and_ps(r0, xyz), b = _mm_and_ps(r1, xyz), c = _mm_and_ps(r2, xyz);
+    // The rows of the rotation are the columns of its inverse, the transpose.
+    __m128 t = _mm_mul_ps(a, _mm_shuffle_ps(r0, r0, _MM_SHUFFLE(3, 3, 3, 3)));
+    t = sse::MulAdd(b, _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(3, 3, 3, 3)), t);
+    t = sse::MulAdd(c, _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3, 3, 3, 3)), t);
+    t = _mm_sub_ps(_mm_setzero_ps(), t);
+    _MM_TRANSPOSE4_PS(a, b, c, t);
+    r[0].xmm = a;
+    r[1].xmm = b;
+    r[2].xmm = c;
+#else
+    const Vector3 t = GetTranslation();
+    *this = Matrix3x4(m00, m10, m20, -(m00 * t.x + m10 * t.y + m20 * t.z),
+                      m01, m11, m21, -(m01 * t.x + m11 * t.y + m21 * t.z),
+                      m02, m12, m22, -(m02 * t.x + m12 * t.y + m22 * t.z));
+#endif
+}
+
+const Matrix3x4& Matrix3x4::TransformPoints(const Vector3* vecs, Vector3* outVecs, size_t count) const {
+    Matrix3x4TransformArray<true>(*this, vecs, outVecs, count);
+    return *this;
+}
+
+const Matrix3x4& Matrix3x4::TransformDirections(const Vector3* vecs, Vector3* outVecs, size_t count) const {
+    Matrix3x4TransformArray<false>(*this, vecs, outVecs, count);
+    return *this;
+}
+
+void Matrix3x4::MultiplyArray(const Matrix3x4* a, const Matrix3x4* b, Matrix3x4* outMatrices, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        Multiply(a[i], b[i], outMatrices[i]);
+    }
+}
+
+void Matrix3x4::MultiplyArray(const Matrix3x4& a, const Matrix3x4* b, Matrix3x4* outMatrices, size_t count) {
+#if defined(XO_SSE)
+    // Each element of a is splat once, and its translation column masked once.
+    const __m128 translation = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+    const __m128 a0 = a.r[0].xmm, a1 = a.r[1].xmm, a2 = a.r[2].xmm;
+    const __m128 a0x = _mm_shuffle_ps(a0, a0, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m128 a0y = _mm_shuffle_ps(a0, a0, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 a0z = _mm_shuffle_ps(a0, a0, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m128 a1x = _mm_shuffle_ps(a1, a1, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m128 a1y = _mm_shuffle_ps(a1, a1, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 a1z = _mm_shuffle_ps(a1, a1, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m128 a2x = _mm_shuffle_ps(a2, a2, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m128 a2y = _mm_shuffle_ps(a2, a2, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 a2z = _mm_shuffle_ps(a2, a2, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m128 a0w = _mm_and_ps(a0, translation), a1w = _mm_and_ps(a1, translation), a2w = _mm_and_ps(a2, translation);
+    for (size_t i = 0; i < count; ++i) {
+        const __m128 b0 = b[i].r[0].xmm, b1 = b[i].r[1].xmm, b2 = b[i].r[2].xmm;
+        outMatrices[i].r[0].xmm = sse::MulAdd(a0z, b2, sse::MulAdd(a0y, b1, sse::MulAdd(a0x, b0, a0w)));
+        outMatrices[i].r[1].xmm = sse::MulAdd(a1z, b2, sse::MulAdd(a1y, b1, sse::MulAdd(a1x, b0, a1w)));
+        outMatrices[i].r[2].xmm = sse::MulAdd(a2z, b2, sse::MulAdd(a2y, b1, sse::MulAdd(a2x, b0, a2w)));
+    }
+#else
+    for (size_t i = 0; i < count; ++i) {
+        Multiply(a, b[i], outMatrices[i]);
+    }
+#endif
+}
+
+void Matrix3x4::InverseArray(const Matrix3x4* matrices, Matrix3x4* outMatrices, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        Matrix3x4Inverse(matrices[i], outMatrices[i], false);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////// Matrix4x4.cpp
+
+const Matrix4x4 Matrix4x4::Identity(Vector4(1.0f, 0.0f, 0.0f, 0.0f),
+                                    Vector4(0.0f, 1.0f, 0.0f, 0.0f),
+                                    Vector4(0.0f, 0.0f, 1.0f, 0.0f),
+                                    Vector4(0.0f, 0.0f, 0.0f, 1.0f));
+
+const Matrix4x4 Matrix4x4::One(Vector4(1.0f, 1.0f, 1.0f, 1.0f),
+                               Vector4(1.0f, 1.0f, 1.0f, 1.0f),
+                               Vector4(1.0f, 1.0f, 1.0f, 1.0f),
+                               Vector4(1.0f, 1.0f, 1.0f, 1.0f));
+
+const Matrix4x4 Matrix4x4::Zero(Vector4(0.0f, 0.0f, 0.0f, 0.0f),
+                                Vector4(0.0f, 0.0f, 0.0f, 0.0f),
+                                Vector4(0.0f, 0.0f, 0.0f, 0.0f),
+                                Vector4(0.0f, 0.0f, 0.0f, 0.0f));
+
+Matrix4x4::Matrix4x4() {
+}
+
+Matrix4x4::Matrix4x4(float m)
+#if defined(XO_SSE)
+{ 
+    r[0].xmm = r[1].xmm = r[2].xmm = r[3].xmm = _mm_set_ps1(m);
+}
+#else
+{
+	r[0].Set(m);
+	r[1].Set(m);
+	r[2].Set(m);
+	r[3].Set(m);
+}
+#endif
+
+Matrix4x4::Matrix4x4(float a0, float b0, float c0, float d0, float a1, float b1, float c1, float d1, float a2, float b2, float c2, float d2, float a3, float b3, float c3, float d3)
+{
+    r[0].Set(a0, b0, c0, d0);
+    r[1].Set(a1, b1, c1, d1);
+    r[2].Set(a2, b2, c2, d2);
+    r[3].Set(a3, b3, c3, d3);
+}
+
+// TODO: couldn't this be faster with just a single copy?
+Matrix4x4::Matrix4x4(const Matrix4x4& m)
+{
+	r[0].Set(m.r[0]);
+	r[1].Set(m.r[1]);
+	r[2].Set(m.r[2]);
+	r[3].Set(m.r[3]);
+}
+
+Matrix4x4::Matrix4x4(const Vector4& r0, const Vector4& r1, const Vector4& r2, const Vector4& r3)
+{
+	r[0].Set(r0);
+	r[1].Set(r1);
+	r[2].Set(r2);
+	r[3].Set(r3);
+}
+
+Matrix4x4::Matrix4x4(const Vector3& r0, const Vector3& r1, const Vector3& r2)
+{
+	r[0].Set(r0);
+	r[1].Set(r1);
+	r[2].Set(r2);
+	r[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+Matrix4x4::Matrix4x4(const Matrix3x4& m) {
+    r[0].Set(m.r[0]);
+    r[1].Set(m.r[1]);
+    r[2].Set(m.r[2]);
+    r[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+Matrix4x4::Matrix4x4(const class Quaternion& q) {
+    Vector4* v4 = (Vector4*)&q;
+    Vector4 q2 = *v4 + *v4;
+
+    Vector4 qq2 = (*v4) * q2;
+    Vector4 wq2 = q2 * q.w;
+
+    float xy2 = q.x * q2.y;
+    float xz2 = q.x * q2.z;
+    float yz2 = q.y * q2.z;
+
+    r[0].Set( 1.0f - qq2.y - qq2.z,  xy2 + wq2.z,            xz2 - wq2.y,          0.0f);
+    r[1].Set( xy2 - wq2.z,           1.0f - qq2.x - qq2.z,   yz2 + wq2.x,          0.0f);
+    r[2].Set( xz2 + wq2.y,           yz2 - wq2.x,            1.0f - qq2.x - qq2.y, 0.0f);
+    r[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+const Vector4& Matrix4x4::GetRow(int i) const {
+    return r[i];
+}
+
+Vector4 Matrix4x4::GetColumn(int i) const {
+    return Vector4(r[0][i], r[1][i], r[2][i], r[3][i]);
+}
+
+namespace
+{
+#if defined(XO_SSE)
+    _XOINL void EarlyInverse(__m128& minor0, __m128& minor1, __m128& minor2, __m128& minor3,
+                             __m128& row0, __m128& row1, __m128& row2, __m128& row3,
+                             __m128& det, __m128& tmp1, float m[16])
+    {
+        // http://download.intel.com/design/PentiumIII/sml/24504301.pdf
+        // http://stackoverflow.com/questions/18743531/sse-half-loads-mm-loadh-pi-mm-loadl-pi-issue-warnings
+#   define _fake_initialization() _mm_setzero_ps()
+
+        tmp1 = _mm_loadh_pi(_mm_loadl_pi(_fake_initialization(), (__m64*)(m)), (__m64*)(m + 4));
+        row1 = _mm_loadh_pi(_mm_loadl_pi(_fake_initialization(), (__m64*)(m + 8)), (__m64*)(m + 12));
+        row0 = _mm_shuffle_ps(tmp1, row1, 0x88);
+        row1 = _mm_shuffle_ps(row1, tmp1, 0xDD);
+        tmp1 = _mm_loadh_pi(_mm_loadl_pi(tmp1, (__m64*)(m + 2)), (__m64*)(m + 6));
+        row3 = _mm_loadh_pi(_mm_loadl_pi(_fake_initialization(), (__m64*)(m + 10)), (__m64*)(m + 14));
+        row2 = _mm_shuffle_ps(tmp1, row3, 0x88);
+        row3 = _mm_shuffle_ps(row3, tmp1, 0xDD);
+        // -----------------------------------------------
+        tmp1 = _mm_mul_ps(row2, row3);
+        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+        minor0 = _mm_mul_ps(row1, tmp1);
+        minor1 = _mm_mul_ps(row0, tmp1);
+        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+        minor0 = _mm_sub_ps(_mm_mul_ps(row1, tmp1), minor0);
+        minor1 = _mm_sub_ps(_mm_mul_ps(row0, tmp1), minor1);
+        minor1 = _mm_shuffle_ps(minor1, minor1, 0x4E);
+        // -----------------------------------------------
+        tmp1 = _mm_mul_ps(row1, row2);
+        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+        minor0 = _mm_add_ps(_mm_mul_ps(row3, tmp1), minor0);
+        minor3 = _mm_mul_ps(row0, tmp1);
+        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+        minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row3, tmp1));
+        minor3 = _mm_sub_ps(_mm_mul_ps(row0, tmp1), minor3);
+        minor3 = _mm_shuffle_ps(minor3, minor3, 0x4E);
+        // -----------------------------------------------
+        tmp1 = _mm_mul_ps(_mm_shuffle_ps(row1, row1, 0x4E), row3);
+        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+        row2 = _mm_shuffle_ps(row2, row2, 0x4E);
+        minor0 = _mm_add_ps(_mm_mul_ps(row2, tmp1), minor0);
+        minor2 = _mm_mul_ps(row0, tmp1);
+        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+        minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row2, tmp1));
+        minor2 = _mm_sub_ps(_mm_mul_ps(row0, tmp1), minor2);
+        minor2 = _mm_shuffle_ps(minor2, minor2, 0x4E);
+        // -----------------------------------------------
+        tmp1 = _mm_mul_ps(row0, row1);
+        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+        minor2 = _mm_add_ps(_mm_mul_ps(row3, tmp1), minor2);
+        minor3 = _mm_sub_ps(_mm_mul_ps(row2, tmp1), minor3);
+        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+        minor2 = _mm_sub_ps(_mm_mul_ps(row3, tmp1), minor2);
+        minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row2, tmp1));
+        // -----------------------------------------------
+        tmp1 = _mm_mul_ps(row0, row3);
+        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+        minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row2, tmp1));
+        minor2 = _mm_add_ps(_mm_mul_ps(row1, tmp1), minor2);
+        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+        minor1 = _mm_add_ps(_mm_mul_ps(row2, tmp1), minor1);
+        minor2 = _mm_sub_ps(minor2, _mm_mul_ps(row1, tmp1));
+        // -----------------------------------------------
+        tmp1 = _mm_mul_ps(row0, row2);
+        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+        minor1 = _mm_add_ps(_mm_mul_ps(row3, tmp1), minor1);
+        minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row1, tmp1));
+        tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+        minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row3, tmp1));
+        minor3 = _mm_add_ps(_mm_mul_ps(row1, tmp1), minor3);
+        // -----------------------------------------------
+        det = _mm_mul_ps(row0, minor0);
+        det = _mm_add_ps(_mm_shuffle_ps(det, det, 0x4E), det);
+        det = _mm_add_ss(_mm_shuffle_ps(det, det, 0xB1), det);
+#   undef _fake_initialization
+    }
+
+    _XOINL void LateInverse(__m128& minor0, __m128& minor1, __m128& minor2, __m128& minor3,
+                            __m128& det, __m128& tmp1, float m[16])
+    {
+        // http://download.intel.com/design/PentiumIII/sml/24504301.pdf
+        tmp1 = _mm_rcp_ss(det);
+        det = _mm_sub_ss(_mm_add_ss(tmp1, tmp1), _mm_mul_ss(det, _mm_mul_ss(tmp1, tmp1)));
+        det = _mm_shuffle_ps(det, det, 0x00);
+        minor0 = _mm_mul_ps(det, minor0);
+        _mm_storel_pi((__m64*)(m), minor0);
+        _mm_storeh_pi((__m64*)(m + 2), minor0);
+        minor1 = _mm_mul_ps(det, minor1);
+        _mm_storel_pi((__m64*)(m + 4), minor1);
+        _mm_storeh_pi((__m64*)(m + 6), minor1);
+        minor2 = _mm_mul_ps(det, minor2);
+        _mm_storel_pi((__m64*)(m + 8), minor2);
+        _mm_storeh_pi((__m64*)(m + 10), minor2);
+        minor3 = _mm_mul_ps(det, minor3);
+        _mm_storel_pi((__m64*)(m + 12), minor3);
+        _mm_storeh_pi((__m64*)(m + 14), minor3);
+    }
+#else
+    _XOINL void EarlyInverse(float tmp[12], float src[16], float& det, float m[16])
+    {
+        // http://download.intel.com/design/PentiumIII/sml/24504301.pdf
+        // transpose matrix
+        for (int i = 0; i < 4; i++)
+        {
+            src[i] = m[i * 4];
+            src[i + 4] = m[i * 4 + 1];
+            src[i + 8] = m[i * 4 + 2];
+            src[i + 12] = m[i * 4 + 3];
+        }
+        // calculate pairs for first 8 elements (cofactors)
+        tmp[0] = src[10] * src[15];
+        tmp[1] = src[11] * src[14];
+        tmp[2] = src[9] * src[15];
+        tmp[3] = src[11] * src[13];
+        tmp[4] = src[9] * src[14];
+        tmp[5] = src[10] * src[13];
+        tmp[6] = src[8] * src[15];
+        tmp[7] = src[11] * src[12];
+        tmp[8] = src[8] * src[14];
+        tmp[9] = src[10] * src[12];
+        tmp[10] = src[8] * src[13];
+        tmp[11] = src[9] * src[12];
+        // calculate first 8 elements (cofactors)
+        m[0] = tmp[0] * src[5] + tmp[3] * src[6] + tmp[4] * src[7];
+        m[0] -= tmp[1] * src[5] + tmp[2] * src[6] + tmp[5] * src[7];
+        m[1] = tmp[1] * src[4] + tmp[6] * src[6] + tmp[9] * src[7];
+        m[1] -= tmp[0] * src[4] + tmp[7] * src[6] + tmp[8] * src[7];
+        m[2] = tmp[2] * src[4] + tmp[7] * src[5] + tmp[10] * src[7];
+        m[2] -= tmp[3] * src[4] + tmp[6] * src[5] + tmp[11] * src[7];
+        m[3] = tmp[5] * src[4] + tmp[8] * src[5] + tmp[11] * src[6];
+        m[3] -= tmp[4] * src[4] + tmp[9] * src[5] + tmp[10] * src[6];
+        m[4] = tmp[1] * src[1] + tmp[2] * src[2] + tmp[5] * src[3];
+        m[4] -= tmp[0] * src[1] + tmp[3] * src[2] + tmp[4] * src[3];
+        m[5] = tmp[0] * src[0] + tmp[7] * src[2] + tmp[8] * src[3];
+        m[5] -= tmp[1] * src[0] + tmp[6] * src[2] + tmp[9] * src[3];
+        m[6] = tmp[3] * src[0] + tmp[6] * src[1] + tmp[11] * src[3];
+        m[6] -= tmp[2] * src[0] + tmp[7] * src[1] + tmp[10] * src[3];
+        m[7] = tmp[4] * src[0] + tmp[9] * src[1] + tmp[10] * src[2];
+        m[7] -= tmp[5] * src[0] + tmp[8] * src[1] + tmp[11] * src[2];
+        // calculate pairs for second 8 elements (cofactors)
+        tmp[0] = src[2] * src[7];
+        tmp[1] = src[3] * src[6];
+        tmp[2] = src[1] * src[7];
+        tmp[3] = src[3] * src[5];
+        tmp[4] = src[1] * src[6];
+        tmp[5] = src[2] * src[5];
+        tmp[6] = src[0] * src[7];
+        tmp[7] = src[3] * src[4];
+        tmp[8] = src[0] * src[6];
+        tmp[9] = src[2] * src[4];
+        tmp[10] = src[0] * src[5];
+        tmp[11] = src[1] * src[4];
+        // calculate second 8 elements (cofactors)
+        m[8] = tmp[0] * src[13] + tmp[3] * src[14] + tmp[4] * src[15];
+        m[8] -= tmp[1] * src[13] + tmp[2] * src[14] + tmp[5] * src[15];
+        m[9] = tmp[1] * src[12] + tmp[6] * src[14] + tmp[9] * src[15];
+        m[9] -= tmp[0] * src[12] + tmp[7] * src[14] + tmp[8] * src[15];
+        m[10] = tmp[2] * src[12] + tmp[7] * src[13] + tmp[10] * src[15];
+        m[10] -= tmp[3] * src[12] + tmp[6] * src[13] + tmp[11] * src[15];
+        m[11] = tmp[5] * src[12] + tmp[8] * src[13] + tmp[11] * src[14];
+        m[11] -= tmp[4] * src[12] + tmp[9] * src[13] + tmp[10] * src[14];
+        m[12] = tmp[2] * src[10] + tmp[5] * src[11] + tmp[1] * src[9];
+        m[12] -= tmp[4] * src[11] + tmp[0] * src[9] + tmp[3] * src[10];
+        m[13] = tmp[8] * src[11] + tmp[0] * src[8] + tmp[7] * src[10];
+        m[13] -= tmp[6] * src[10] + tmp[9] * src[11] + tmp[1] * src[8];
+        m[14] = tmp[6] * src[9] + tmp[11] * src[11] + tmp[3] * src[8];
+        m[14] -= tmp[10] * src[11] + tmp[2] * src[8] + tmp[7] * src[9];
+        m[15] = tmp[10] * src[10] + tmp[4] * src[8] + tmp[9] * src[9];
+        m[15] -= tmp[8] * src[9] + tmp[11] * src[10] + tmp[5] * src[8];
+        // calculate determinant
+        det = src[0] * m[0] + src[1] * m[1] + src[2] * m[2] + src[3] * m[3];
+    }
+
+    _XOINL void LateInverse(float &det, float m[16])
+    {
+        // http://download.intel.com/design/PentiumIII/sml/24504301.pdf
+        // calculate matrix inverse 
+        det = 1 / det;
+        for (int j = 0; j < 16; j++)
+            m[j] *= det;
+    }
+#endif
+}
+
+void Matrix4x4::MakeInverse() {
+#if defined(XO_SSE)
+    __m128 minor0, minor1, minor2, minor3;
+    __m128 row0, row1, row2, row3;
+    __m128 det, tmp1;
+    EarlyInverse(minor0, minor1, minor2, minor3, row0, row1, row2, row3, det, tmp1, m);
+    LateInverse(minor0, minor1, minor2, minor3, det, tmp1, m);
+#else
+    float tmp[12]; // temp array for pairs
+    float src[16]; // array of transpose source matrix
+    float det; // determinant
+    EarlyInverse(tmp, src, det, m);
+    LateInverse(det, m);
+#endif
+}
+
+bool Matrix4x4::TryMakeInverse()
+{
+#if defined(XO_SSE)
+    __m128 minor0, minor1, minor2, minor3;
+    __m128 row0, row1, row2, row3;
+    __m128 det, tmp1;
+    EarlyInverse(minor0, minor1, minor2, minor3, row0, row1, row2, row3, det, tmp1, m);
+    if (_mm_cvtss_f32(det) == 0.0f)
+        return false;
+    LateInverse(minor0, minor1, minor2, minor3, det, tmp1, m);
+    return true;
+#else
+    float tmp[12]; // temp array for pairs
+    float src[16]; // array of transpose source matrix
+    float det; // determinant
+    EarlyInverse(tmp, src, det, m);
+    if (det == 0.0f)
+        return false;
+    LateInverse(det, m);
+    return true;
+#endif
+}
+
+Matrix4x4& Matrix4x4::Transpose() {
+#if defined(XO_SSE)
+    _MM_TRANSPOSE4_PS(r[0].xmm, r[1].xmm, r[2].xmm, r[3].xmm);
+#else
+    float t;
+#   define _XO_TRANSPOSE_SWAP(i,j) t = r[i][j]; r[i][j] = r[j][i]; r[j][i] = t;
+    // The number of swaps should be:
+    //      (((n*n)-n)/2) = 6
+    //      (((4*4)-4)/2) = 6
+    //      (((all elements)-identity)/(two elements processed per swap)) = 6
+    _XO_TRANSPOSE_SWAP(0, 1);
+    _XO_TRANSPOSE_SWAP(0, 2);
+    _XO_TRANSPOSE_SWAP(0, 3);
+    _XO_TRANSPOSE_SWAP(1, 2);
+    _XO_TRANSPOSE_SWAP(1, 3);
+    _XO_TRANSPOSE_SWAP(2, 3);
+#   undef _XO_TRANSPOSE_SWAP
+#endif
+    return *this;
+}
+
+Matrix4x4 Matrix4x4::Transposed() const {
+    Matrix4x4 m(*this);
+    return m.Transpose();
+}
+
+const Matrix4x4& Matrix4x4::Transform(Vector3& v) const {
+    v = (*this) * Vector4(v);
+    return *this;
+}
+
+const Matrix4x4& Matrix4x4::Transform(Vector4& v) const {
+    v = (*this) * v;
+    return *this;
+}
+
+namespace
+{
+    // w is 1 for points and 0 for directions, so only points pick up the translation column.
+    template <bool IsPoint>
+    _XOINL void TransformVector3Array(const Matrix4x4& m, const Vector3* vecs, Vector3* outVecs, size_t count) {
+#if defined(XO_SSE)
+        __m128 c0 = m[0].xmm, c1 = m[1].xmm, c2 = m[2].xmm, c3 = m[3].xmm;
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        // Dropping the bottom row keeps the padding of every output vector at zero.
+        const __m128 mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+        c0 = _mm_and_ps(c0, mask);
+        c1 = _mm_and_ps(c1, mask);
+        c2 = _mm_and_ps(c2, mask);
+        c3 = IsPoint ? _mm_and_ps(c3, mask) : _mm_setzero_ps();
+        for (size_t i = 0; i < count; ++i) {
+            __m128 v = vecs[i].xmm;
+            __m128 r = sse::MulAdd(_mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)), c0, c3);
+            r = sse::MulAdd(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), c1, r);
+            outVecs[i].xmm = sse::MulAdd(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), c2, r);
+        }
+#else
+        const float m00 = m(0, 0), m01 = m(0, 1), m02 = m(0, 2), m03 = IsPoint ? m(0, 3) : 0.0f;
+        const float m10 = m(1, 0), m11 = m(1, 1), m12 = m(1, 2), m13 = IsPoint ? m(1, 3) : 0.0f;
+        const float m20 = m(2, 0), m21 = m(2, 1), m22 = m(2, 2), m23 = IsPoint ? m(2, 3) : 0.0f;
+        for (size_t i = 0; i < count; ++i) {
+            const float x = vecs[i].x, y = vecs[i].y, z = vecs[i].z;
+            outVecs[i].x = m00 * x + m01 * y + m02 * z + m03;
+            outVecs[i].y = m10 * x + m11 * y + m12 * z + m13;
+            outVecs[i].z = m20 * x + m21 * y + m22 * z + m23;
+        }
+#endif
+    }
+
+    template <bool IsPoint>
+    _XOINL void TransformPackedArray(const Matrix4x4& m, const float* xyz, float* outXyz, size_t count) {
+        const float m00 = m(0, 0), m01 = m(0, 1), m02 = m(0, 2), m03 = IsPoint ? m(0, 3) : 0.0f;
+        const float m10 = m(1, 0), m11 = m(1, 1), m12 = m(1, 2), m13 = IsPoint ? m(1, 3) : 0.0f;
+        const float m20 = m(2, 0), m21 = m(2, 1), m22 = m(2, 2), m23 = IsPoint ? m(2, 3) : 0.0f;
+        size_t i = 0;
+#if defined(XO_SSE)
+        // Four points are three registers: x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+        // They are shuffled into x, y and z registers, transformed with broadcast matrix elements, then shuffled back.
+        const __m128 s00 = _mm_set1_ps(m00), s01 = _mm_set1_ps(m01), s02 = _mm_set1_ps(m02), s03 = _mm_set1_ps(m03);
+        const __m128 s10 = _mm_set1_ps(m10), s11 = _mm_set1_ps(m11), s12 = _mm_set1_ps(m12), s13 = _mm_set1_ps(m13);
+        const __m128 s20 = _mm_set1_ps(m20), s21 = _mm_set1_ps(m21), s22 = _mm_set1_ps(m22), s23 = _mm_set1_ps(m23);
+        for (; i + 4 <= count; i += 4) {
+            const float* in = xyz + i * 3;
+            float* out = outXyz + i * 3;
+            __m128 a = _mm_loadu_ps(in);
+            __m128 b = _mm_loadu_ps(in + 4);
+            __m128 c = _mm_loadu_ps(in + 8);
+
+            __m128 t = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+            __m128 x = _mm_shuffle_ps(a, t, _MM_SHUFFLE(2, 0, 3, 0));
+            t = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+            __m128 u = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+            __m128 y = _mm_shuffle_ps(t, u, _MM_SHUFFLE(2, 0, 2, 0));
+            t = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+            u = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0));
+            __m128 z = _mm_shuffle_ps(t, u, _MM_SHUFFLE(2, 0, 2, 0));
+
+            __m128 rx = sse::MulAdd(s02, z, sse::MulAdd(s01, y, sse::MulAdd(s00, x, s03)));
+            __m128 ry = sse::MulAdd(s12, z, sse::MulAdd(s11, y, sse::MulAdd(s10, x, s13)));
+            __m128 rz = sse::MulAdd(s22, z, sse::MulAdd(s21, y, sse::MulAdd(s20, x, s23)));
+
+            t = _mm_shuffle_ps(rx, ry, _MM_SHUFFLE(0, 0, 0, 0));
+            u = _mm_shuffle_ps(rz, rx, _MM_SHUFFLE(1, 1, 0, 0));
+            a = _mm_shuffle_ps(t, u, _MM_SHUFFLE(2, 0, 2, 0));
+            t = _mm_shuffle_ps(ry, rz, _MM_SHUFFLE(1, 1, 1, 1));
+            u = _mm_shuffle_ps(rx, ry, _MM_SHUFFLE(2, 2, 2, 2));
+            b = _mm_shuffle_ps(t, u, _MM_SHUFFLE(2, 0, 2, 0));
+            t = _mm_shuffle_ps(rz, rx, _MM_SHUFFLE(3, 3, 2, 2));
+            u = _mm_shuffle_ps(ry, rz, _MM_SHUFFLE(3, 3, 3, 3));
+            c = _mm_shuffle_ps(t, u, _MM_SHUFFLE(2, 0, 2, 0));
+
+            _mm_storeu_ps(out, a);
+            _mm_storeu_ps(out + 4, b);
+            _mm_storeu_ps(out + 8, c);
+        }
+#endif
+        for (; i < count; ++i) {
+            const float x = xyz[i * 3], y = xyz[i * 3 + 1], z = xyz[i * 3 + 2];
+            outXyz[i * 3]     = m00 * x + m01 * y + m02 * z + m03;
+            outXyz[i * 3 + 1] = m10 * x + m11 * y + m12 * z + m13;
+            outXyz[i * 3 + 2] = m20 * x + m21 * y + m22 * z + m23;
+        }
+    }
+}
+
+const Matrix4x4& Matrix4x4::TransformPoints(const Vector3* vecs, Vector3* outVecs, size_t count) const {
+    TransformVector3Array<true>(*this, vecs, outVecs, count);
+    return *this;
+}
+
+const Matrix4x4& Matrix4x4::TransformPoints(const float* xyz, float* outXyz, size_t count) const {
+    TransformPackedArray<true>(*this, xyz, outXyz, count);
+    return *this;
+}
+
+const Matrix4x4& Matrix4x4::TransformDirections(const Vector3* vecs, Vector3* outVecs, size_t count) const {
+    TransformVector3Array<false>(*this, vecs, outVecs, count);
+    return *this;
+}
+
+const Matrix4x4& Matrix4x4::TransformDirections(const float* xyz, float* outXyz, size_t count) const {
+    TransformPackedArray<false>(*this, xyz, outXyz, count);
+    return *this;
+}
+
+void Matrix4x4::MultiplyArray(const Matrix4x4* a, const Matrix4x4* b, Matrix4x4* outMatrices, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        Multiply(a[i], b[i], outMatrices[i]);
+    }
+}
+
+void Matrix4x4::MultiplyArray(const Matrix4x4& a, const Matrix4x4* b, Matrix4x4* outMatrices, size_t count) {
+#if defined(XO_AVX)
+    // Each element of a is splat once, two rows to a register.
+    const __m256 a01 = _mm256_loadu_ps(a.r[0].f);
+    const __m256 a23 = _mm256_loadu_ps(a.r[2].f);
+    const __m256 a01x = _mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m256 a01y = _mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m256 a01z = _mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m256 a01w = _mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(3, 3, 3, 3));
+    const __m256 a23x = _mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m256 a23y = _mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m256 a23z = _mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m256 a23w = _mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(3, 3, 3, 3));
+    for (size_t i = 0; i < count; ++i) {
+        const __m256 b0 = _mm256_broadcast_ps(&b[i].r[0].xmm);
+        const __m256 b1 = _mm256_broadcast_ps(&b[i].r[1].xmm);
+        const __m256 b2 = _mm256_broadcast_ps(&b[i].r[2].xmm);
+        const __m256 b3 = _mm256_broadcast_ps(&b[i].r[3].xmm);
+        __m256 r01 = _mm256_mul_ps(a01x, b0);
+        __m256 r23 = _mm256_mul_ps(a23x, b0);
+        r01 = wide::MulAdd(a01y, b1, r01);
+        r23 = wide::MulAdd(a23y, b1, r23);
+        r01 = wide::MulAdd(a01z, b2, r01);
+        r23 = wide::MulAdd(a23z, b2, r23);
+        r01 = wide::MulAdd(a01w, b3, r01);
+        r23 = wide::MulAdd(a23w, b3, r23);
+        _mm256_storeu_ps(outMatrices[i].r[0].f, r01);
+        _mm256_storeu_ps(outMatrices[i].r[2].f, r23);
+    }
+#else
+    // a is copied so that writing outMatrices can never change it.
+    const Matrix4x4 parent(a);
+    for (size_t i = 0; i < count; ++i) {
+        Multiply(parent, b[i], outMatrices[i]);
+    }
+#endif
+}
+
+void Matrix4x4::MultiplyArray(const Matrix4x4* a, const Matrix4x4& b, Matrix4x4* outMatrices, size_t count) {
+    const Matrix4x4 right(b);
+    for (size_t i = 0; i < count; ++i) {
+        Multiply(a[i], right, outMatrices[i]);
+    }
+}
+
+namespace
+{
+    // Element k of every matrix in a group of wide::Width matrices is held in lanes[k], one matrix per lane.
+    _XOINL void LoadMatrixLanes(const Matrix4x4* m, wide::Float lanes[16]) {
+        for (int r = 0; r < 4; ++r) {
+            wide::LoadTransposed4(m->r[r].f, 16, lanes[r * 4], lanes[r * 4 + 1], lanes[r * 4 + 2], lanes[r * 4 + 3]);
+        }
+    }
+
+    _XOINL void StoreMatrixLanes(const wide::Float lanes[16], Matrix4x4* m) {
+        for (int r = 0; r < 4; ++r) {
+            wide::StoreTransposed4(m->r[r].f, 16, lanes[r * 4], lanes[r * 4 + 1], lanes[r * 4 + 2], lanes[r * 4 + 3]);
+        }
+    }
+
+    // (a * b) - (c * d)
+    _XOINL wide::Float MulSubMul(wide::Float a, wide::Float b, wide::Float c, wide::Float d) {
+        return wide::NegMulAdd(c, d, wide::Mul(a, b));
+    }
+
+    // Full inverse by cofactor expansion, where each cofactor is built from the 2x2 determinants of the top two and 
+    // bottom two rows. Returns the determinants.
+    _XOINL wide::Float InverseGeneralLanes(const wide::Float a[16], wide::Float o[16]) {
+        using namespace wide;
+        const Float s0 = MulSubMul(a[0], a[5], a[4], a[1]);
+        const Float s1 = MulSubMul(a[0], a[6], a[4], a[2]);
+        const Float s2 = MulSubMul(a[0], a[7], a[4], a[3]);
+        const Float s3 = MulSubMul(a[1], a[6], a[5], a[2]);
+        const Float s4 = MulSubMul(a[1], a[7], a[5], a[3]);
+        const Float s5 = MulSubMul(a[2], a[7], a[6], a[3]);
+        const Float c5 = MulSubMul(a[10], a[15], a[14], a[11]);
+        const Float c4 = MulSubMul(a[9], a[15], a[13], a[11]);
+        const Float c3 = MulSubMul(a[9], a[14], a[13], a[10]);
+        const Float c2 = MulSubMul(a[8], a[15], a[12], a[11]);
+        const Float c1 = MulSubMul(a[8], a[14], a[12], a[10]);
+        const Float c0 = MulSubMul(a[8], a[13], a[12], a[9]);
+
+        const Float det = Add(Add(MulSubMul(s0, c5, s1, c4), MulSubMul(s2, c3, Negate(s3), c2)), MulSubMul(s5, c0, s4, c1));
+        const Float inv = Div(Set(1.0f), det);
+
+        o[0]  = Mul(MulAdd(a[7], c3, MulSubMul(a[5], c5, a[6], c4)), inv);
+        o[1]  = Mul(NegMulAdd(a[3], c3, MulSubMul(a[2], c4, a[1], c5)), inv);
+        o[2]  = Mul(MulAdd(a[15], s3, MulSubMul(a[13], s5, a[14], s4)), inv);
+        o[3]  = Mul(NegMulAdd(a[11], s3, MulSubMul(a[10], s4, a[9], s5)), inv);
+        o[4]  = Mul(NegMulAdd(a[7], c1, MulSubMul(a[6], c2, a[4], c5)), inv);
+        o[5]  = Mul(MulAdd(a[3], c1, MulSubMul(a[0], c5, a[2], c2)), inv);
+        o[6]  = Mul(NegMulAdd(a[15], s1, MulSubMul(a[14], s2, a[12], s5)), inv);
+        o[7]  = Mul(MulAdd(a[11], s1, MulSubMul(a[8], s5, a[10], s2)), inv);
+        o[8]  = Mul(MulAdd(a[7], c0, MulSubMul(a[4], c4, a[5], c2)), inv);
+        o[9]  = Mul(NegMulAdd(a[3], c0, MulSubMul(a[1], c2, a[0], c4)), inv);
+        o[10] = Mul(MulAdd(a[15], s0, MulSubMul(a[12], s4, a[13], s2)), inv);
+        o[11] = Mul(NegMulAdd(a[11], s0, MulSubMul(a[9], s2, a[8], s4)), inv);
+        o[12] = Mul(NegMulAdd(a[6], c0, MulSubMul(a[5], c1, a[4], c3)), inv);
+        o[13] = Mul(MulAdd(a[2], c0, MulSubMul(a[0], c3, a[1], c1)), inv);
+        o[14] = Mul(NegMulAdd(a[14], s0, MulSubMul(a[13], s1, a[12], s3)), inv);
+        o[15] = Mul(MulAdd(a[10], s0, MulSubMul(a[8], s3, a[9], s1)), inv);
+        return det;
+    }
+
+    // Inverse of an affine matrix: the upper 3x3 by cofactors, then the translation moved back through it.
+    // The determinant of the 3x3 is the determinant of the whole matrix.
+    _XOINL wide::Float InverseAffineLanes(const wide::Float a[16], wide::Float o[16]) {
+        using namespace wide;
+        const Float c00 = MulSubMul(a[5], a[10], a[6], a[9]);
+        const Float c01 = MulSubMul(a[6], a[8], a[4], a[10]);
+        const Float c02 = MulSubMul(a[4], a[9], a[5], a[8]);
+        const Float det = MulAdd(a[2], c02, MulAdd(a[1], c01, Mul(a[0], c00)));
+        const Float inv = Div(Set(1.0f), det);
+
+        o[0]  = Mul(c00, inv);
+        o[1]  = Mul(MulSubMul(a[2], a[9], a[1], a[10]), inv);
+        o[2]  = Mul(MulSubMul(a[1], a[6], a[2], a[5]), inv);
+        o[4]  = Mul(c01, inv);
+        o[5]  = Mul(MulSubMul(a[0], a[10], a[2], a[8]), inv);
+        o[6]  = Mul(MulSubMul(a[2], a[4], a[0], a[6]), inv);
+        o[8]  = Mul(c02, inv);
+        o[9]  = Mul(MulSubMul(a[1], a[8], a[0], a[9]), inv);
+        o[10] = Mul(MulSubMul(a[0], a[5], a[1], a[4]), inv);
+        o[3]  = Negate(MulAdd(o[2], a[11], MulAdd(o[1], a[7], Mul(o[0], a[3]))));
+        o[7]  = Negate(MulAdd(o[6], a[11], MulAdd(o[5], a[7], Mul(o[4], a[3]))));
+        o[11] = Negate(MulAdd(o[10], a[11], MulAdd(o[9], a[7], Mul(o[8], a[3]))));
+        o[12] = o[13] = o[14] = Zero();
+        o[15] = Set(1.0f);
+        return det;
+    }
+
+    _XOINL void InverseRigidLanes(const wide::Float a[16], wide::Float o[16]) {
+        using namespace wide;
+        o[0] = a[0]; o[1] = a[4]; o[2]  = a[8];
+        o[4] = a[1]; o[5] = a[5]; o[6]  = a[9];
+        o[8] = a[2]; o[9] = a[6]; o[10] = a[10];
+        o[3]  = Negate(MulAdd(a[8], a[11], MulAdd(a[4], a[7], Mul(a[0], a[3]))));
+        o[7]  = Negate(MulAdd(a[9], a[11], MulAdd(a[5], a[7], Mul(a[1], a[3]))));
+        o[11] = Negate(MulAdd(a[10], a[11], MulAdd(a[6], a[7], Mul(a[2], a[3]))));
+        o[12] = o[13] = o[14] = Zero();
+        o[15] = Set(1.0f);
+    }
+
+    enum InverseKind { InverseGeneral, InverseTry, InverseRigid };
+
+    // Inverts exactly wide::Width matrices, returning one bit per singular matrix when kind is InverseTry.
+    template <InverseKind Kind>
+    _XOINL int InverseMatrixGroup(const Matrix4x4* matrices, Matrix4x4* outMatrices) {
+        using namespace wide;
+        Float a[16], o[16];
+        LoadMatrixLanes(matrices, a);
+        int singular = 0;
+        if (Kind == InverseRigid) {
+            InverseRigidLanes(a, o);
+        }
+        else {
+            const Float affine = And(And(CmpEq(a[12], Zero()), CmpEq(a[13], Zero())), 
+                                     And(CmpEq(a[14], Zero()), CmpEq(a[15], Set(1.0f))));
+            const Float det = MoveMask(affine) == MoveMask(True()) ? InverseAffineLanes(a, o) : InverseGeneralLanes(a, o);
+            if (Kind == InverseTry) {
+                const Float isSingular = CmpEq(det, Zero());
+                singular = MoveMask(isSingular);
+                if (singular) {
+                    for (int k = 0; k < 16; ++k) {
+                        o[k] = Select(isSingular, a[k], o[k]);
+                    }
+                }
+            }
+        }
+        StoreMatrixLanes(o, outMatrices);
+        return singular;
+    }
+
+    template <InverseKind Kind>
+    _XOINL bool InverseMatrixArray(const Matrix4x4* matrices, Matrix4x4* outMatrices, size_t count, uint32_t* outSingularMask) {
+        if (outSingularMask) {
+            memset(outSingularMask, 0, ((count + 31) / 32) * sizeof(uint32_t));
+        }
+        bool allInverted = true;
+        for (size_t i = 0; i < count; i += wide::Width) {
+            int singular;
+            if (i + wide::Width <= count) {
+                singular = InverseMatrixGroup<Kind>(matrices + i, outMatrices + i);
+            }
+            else {
+                // The last partial group is padded out with identity matrices.
+                Matrix4x4 in[wide::Width], out[wide::Width];
+                for (size_t j = 0; j < wide::Width; ++j) {
+                    in[j] = i + j < count ? matrices[i + j] : Matrix4x4::Identity;
+                }
+                singular = InverseMatrixGroup<Kind>(in, out);
+                for (size_t j = 0; i + j < count; ++j) {
+                    outMatrices[i + j] = out[j];
+                }
+            }
+            if (singular) {
+                allInverted = false;
+                if (outSingularMask) {
+                    // wide::Width divides 32, so a group never straddles two mask values.
+                    outSingularMask[i / 32] |= (uint32_t)singular << (i % 32);
+                }
+            }
+        }
+        return allInverted;
+    }
+}
+
+void Matrix4x4::InverseArray(const Matrix4x4* matrices, Matrix4x4* outMatrices, size_t count) {
+    InverseMatrixArray<InverseGeneral>(matrices, outMatrices, count, nullptr);
+}
+
+bool Matrix4x4::TryInverseArray(const Matrix4x4* matrices, Matrix4x4* outMatrices, size_t count, uint32_t* outSingularMask) {
+    return InverseMatrixArray<InverseTry>(matrices, outMatrices, count, outSingularMask);
+}
+
+void Matrix4x4::InverseRigidArray(const Matrix4x4* matrices, Matrix4x4* outMatrices, size_t count) {
+    InverseMatrixArray<InverseRigid>(matrices, outMatrices, count, nullptr);
+}
+
+void Matrix4x4::Scale(float xyz, Matrix4x4& m) {
+    m[0].Set(xyz,  0.0f, 0.0f, 0.0f);
+    m[1].Set(0.0f, xyz,  0.0f, 0.0f);
+    m[2].Set(0.0f, 0.0f, xyz,  0.0f);
+    m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+}
+ 
+void Matrix4x4::Scale(float x, float y, float z, Matrix4x4& m) {
+    m[0].Set(x,    0.0f, 0.0f, 0.0f);
+    m[1].Set(0.0f, y,    0.0f, 0.0f);
+    m[2].Set(0.0f, 0.0f, z,    0.0f);
+    m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+void Matrix4x4::Scale(const Vector3& v, Matrix4x4& m) {
+    m[0].Set(v.x,  0.0f, 0.0f, 0.0f);
+    m[1].Set(0.0f, v.y,  0.0f, 0.0f);
+    m[2].Set(0.0f, 0.0f, v.z,  0.0f);
+    m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+}
+ 
+void Matrix4x4::Translation(float x, float y, float z, Matrix4x4& m) {
+    m[0].Set(1.0f, 0.0f, 0.0f, 0.0f);
+    m[1].Set(0.0f, 1.0f, 0.0f, 0.0f);
+    m[2].Set(0.0f, 0.0f, 1.0f, 0.0f);
+    m[3].Set(x,    y,    z,    1.0f);
+}
+
+void Matrix4x4::Translation(const Vector3& v, Matrix4x4& m) {
+    m[0].Set(1.0f, 0.0f, 0.0f, 0.0f);
+    m[1].Set(0.0f, 1.0f, 0.0f, 0.0f);
+    m[2].Set(0.0f, 0.0f, 1.0f, 0.0f);
+    m[3].Set(v,                1.0f);
+}
+
+void Matrix4x4::RotationXRadians(float radians, Matrix4x4& m) {
+    float sinr, cosr;
+
+    SinCos(radians, sinr, cosr);
+    m[0].Set(1.0f, 0.0f, 0.0f, 0.0f);
+    m[1].Set(0.0f, cosr,-sinr, 0.0f);
+    m[2].Set(0.0f, sinr, cosr, 0.0f);
+    m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+}
+ 
+void Matrix4x4::RotationYRadians(float radians, Matrix4x4& m) {
+    float sinr, cosr;
+    SinCos(radians, sinr, cosr);
+    m[0].Set(cosr, 0.0f,-sinr, 0.0f);
+    m[1].Set(0.0f, 1.0f, 0.0f, 0.0f);
+    m[2].Set(sinr, 0.0f, cosr, 0.0f);
+    m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+void Matrix4x4::RotationZRadians(float radians, Matrix4x4& m) {
+    float sinr, cosr;
+    SinCos(radians, sinr, cosr);
+    m[0].Set(cosr,-sinr, 0.0f, 0.0f);
+    m[1].Set(sinr, cosr, 0.0f, 0.0f);
+    m[2].Set(0.0f, 0.0f, 1.0f, 0.0f);
+    m[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+void Matrix4x4::RotationRadians(float x, float y, float z, Matrix4x4& m) {
+    _XOSIMDALIGN float c[4];
+    _XOSIMDALIGN float s[4];
+    Vector4 v(x, y, z, 0.0f);
+    SinCos_x4(v.f, s, c);
+
+    m[0].Set(c[1]*c[2],                     -c[1]*s[2],                 s[1],           0.0f);
+    m[1].Set(c[2]*s[0]*s[1]+c[0]*s[2],      c[0]*c[2]-s[0]*s[1]*s[2],   -c[1]*s[0],     0.0f);
+    m[2].Set(-c[0]*c[2]*s[1]+s[0]*s[2],     c[2]*s[0]+c[0]*s[1]*s[2],   c[0]*c[1],      0.0f);
+    m[3].Set(0.0f,                          0.0f,                       0.0f,           1.0f);
+}
+
+void Matrix4x4::RotationRadians(const Vector3& v, Matrix4x4& m) {
+    _XOSIMDALIGN float c[4];
+    _XOSIMDALIGN float s[4];
+    SinCos_x4(v.f, s, c);
+
+    m[0].Set(c[1]*c[2],                     -c[1]*s[2],                 s[1],           0.0f);
+    m[1].Set(c[2]*s[0]*s[1]+c[0]*s[2],      c[0]*c[2]-s[0]*s[1]*s[2],   -c[1]*s[0],     0.0f);
+    m[2].Set(-c[0]*c[2]*s[1]+s[0]*s[2],     c[2]*s[0]+c[0]*s[1]*s[2],   c[0]*c[1],      0.0f);
+    m[3].Set(0.0f,                          0.0f,                       0.0f,           1.0f);
+}
+
+void Matrix4x4::AxisAngleRadians(const Vector3& a, float radians, Matrix4x4& m) {
+    float s, c;
+    SinCos(radians, s, c);
+    float t = 1.0f - c;
+    const float& x = a.x;
+    const float& y = a.y;
+    const float& z = a.z;
+    m = Matrix4x4(
+             t*x*x+c  ,    t*x*y-z*s,  t*x*z+y*s,  0.0f,
+             t*x*y+z*s,    t*y*y+c  ,  t*y*z-x*s,  0.0f,
+             t*x*z-y*s,    t*y*z+x*s,  t*z*z+c  ,  0.0f,
+             0.0f,         0.0f,       0.0f,       1.0f
+        );
+}
+
+void Matrix4x4::RotationXDegrees(float degrees, Matrix4x4& m) {
+    RotationXRadians(degrees * Deg2Rad, m);
+}
+
+void Matrix4x4::RotationYDegrees(float degrees, Matrix4x4& m) {
+    RotationYRadians(degrees * Deg2Rad, m);
+}
+
+void Matrix4x4::RotationZDegrees(float degrees, Matrix4x4& m) {
+    RotationZRadians(degrees * Deg2Rad, m);
+}
+
+void Matrix4x4::RotationDegrees(float x, float y, float z, Matrix4x4& m) {
+    Matrix4x4 m0, m1, m2;
+    RotationXDegrees(x, m0);
+    RotationYDegrees(y, m1);
+    RotationZDegrees(z, m2);
+    m = m0 * m1 * m2;
+}
+
+void Matrix4x4::RotationDegrees(const Vector3& v, Matrix4x4& m) {
+    Matrix4x4 m0, m1, m2;
+    RotationXDegrees(v.x, m0);
+    RotationYDegrees(v.y, m1);
+    RotationZDegrees(v.z, m2);
+    m = m0 * m1 * m2;
+}
+
+
+void Matrix4x4::AxisAngleDegrees(const Vector3& a, float degrees, Matrix4x4& m) {
+    AxisAngleRadians(a, degrees * Deg2Rad, m);
+}
+
+void Matrix4x4::OrthographicProjection(float w, float h, float n, float f, Matrix4x4& m) {
+    XO_ASSERT(w != 0.0f, _XO_ASSERT_MSG("::OrthographicProjection Width (w) should not be zero."));
+    XO_ASSERT(h != 0.0f, _XO_ASSERT_MSG("::OrthographicProjection Height (h) should not be zero."));
+    m = Matrix4x4(
+            1.0f/w,    0.0f,       0.0f,    0.0f,
+            0.0f,      1.0f/h,     0.0f,    0.0f,
+            0.0f,      0.0f,       f-n,     0.0f,
+            0.0f,      0.0f,       n*(f-n), 1.0f
+        );
+}
+ 
+void Matrix4x4::PerspectiveProjectionRadians(float fovx, float fovy, float n, float f, Matrix4x4& m) {
+    XO_ASSERT(n != f, _XO_ASSERT_MSG("::PerspectiveProjectionRadians Near (n) and far (f) values should not be equal."));
+    m = Matrix4x4(
+            ATan(fovx/2.0f),   0.0f,               0.0f,               0.0f,
+            0.0f,              ATan(fovy/2.0f),    0.0f,               0.0f,
+            0.0f,              0.0f,               f/(f-n),            1.0f,
+            0.0f,              0.0f,               -n*(f/-n),          1.0f
+        );
+}
+
+void Matrix4x4::PerspectiveProjectionDegrees(float fovx, float fovy, float n, float f, Matrix4x4& outMatrix) {
+    Matrix4x4::PerspectiveProjectionRadians(fovx * Deg2Rad, fovy * Deg2Rad, n, f, outMatrix);
+}
+
+void Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to, const Vector3& up, Matrix4x4& m) {
+    Vector3 zAxis = (to - from).Normalized();
+    Vector3 xAxis = Vector3::Cross(up, zAxis).Normalized();
+    Vector3 yAxis = Vector3::Cross(zAxis, xAxis);
+    m = Matrix4x4(
+            xAxis.x,           yAxis.x,            zAxis.x,            0.0f,
+            xAxis.y,           yAxis.y,            zAxis.y,            0.0f,
+            xAxis.z,           yAxis.z,            zAxis.z,            0.0f,
+            -xAxis.Dot(from),  -yAxis.Dot(from),   -zAxis.Dot(from),   1.0f
+        );
+}
+
+void Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to, Matrix4x4& m) {
+    LookAtFromPosition(from, to, Vector3::Up, m);
+}
+
+void Matrix4x4::LookAtFromDirection(const Vector3& direction, const Vector3& up, Matrix4x4& m) {
+    Vector3 zAxis = direction.Normalized();
+    Vector3 xAxis = Vector3::Cross(up, zAxis).Normalized();
+    Vector3 yAxis = Vector3::Cross(zAxis, xAxis);
+    m = Matrix4x4(
+            xAxis.x,           yAxis.x,            zAxis.x,            0.0f,
+            xAxis.y,           yAxis.y,            zAxis.y,            0.0f,
+            xAxis.z,           yAxis.z,            zAxis.z,            0.0f,
+            0.0f,              0.0f,               0.0f,               1.0f
+        );
+}
+
+void Matrix4x4::LookAtFromDirection(const Vector3& direction, Matrix4x4& m) {
+    LookAtFromDirection(direction, Vector3::Up, m);
+}
+
+Matrix4x4 Matrix4x4::Scale(float xyz) {
+    Matrix4x4 m;
+    Scale(xyz, m);
+    return m;
+}
+
+Matrix4x4 Matrix4x4::Scale(float x, float y, float z) {
+    Matrix4x4 m;
+    Scale(x, y, z, m);
+    return m;
+}
+
+Matrix4x4 Matrix4x4::Scale(const Vector3& v) {
+    Matrix4x4 m;
+    Scale(v, m);
+    return m;
+}
+
+Matrix4x4 Matrix4x4::Translation(float x, float y, float z) {
+    Matrix4x4 m;
+    Translation(x, y, z, m);
+    return m;
+}
+
+Matrix4x4 Matrix4x4::Translation(const Vector3& v) {
+    Matrix4x4 m;
+    Translation(v, m);
+    return m;
+}
+
+Matrix4x4 Matrix4x4::RotationXRadians(float radians) {
+    Matrix4x4 m;
+    RotationXRadians(radians, m);
+    return m;
+}
+
+Matrix4x4 Matrix4x4::RotationYRadians(float radians) {
+    Matrix4x4 m;
+    RotationYRadians(radians, m);
+    return m;
+}
+
+Matrix4x4 Matrix4x4::RotationZRadians(float radians) {
+    Matrix4x4 m;
+    RotationZRadians(radians, m);
+    return m;
+}
+
+Matrix4x4 Matrix4x4::RotationRadians(float x, float y, float z) {
+    Matrix4x4 m;
+    RotationRadians(x, y, z, m);
+    return m;
+}
+
+Matrix4x4 Matrix4x4::RotationRadians(const Vector3& v) {
+    Matrix4x4 m;
+    RotationRadians(v, m);
+    return m;
+}
+
+Matrix4x4 Matrix4x4::AxisAngleRadians(const Vector3& axis, float radians) {
+    Matrix4x4 m;
+    AxisAngleRadians(axis, radians, m);
+    return m;
+}
+
+Matrix4x4 Matrix4x4::RotationXDegrees(float degrees) {
+    Matrix4x4 m;
+    RotationXDegrees(degrees, m);
+    return m;
+}
+
+Matrix4x4 Matrix4x4::RotationYDegrees(float degrees) {
+    Matrix4x4 m;
+    RotationYDegrees(degrees, m);
+    return m;
+}
+
+Matrix4x4 Matrix4x4::RotationZDegrees(float degrees) {
+    Matrix4x4 m;
+    RotationZDegrees(degrees, m);
+    return m;
+}
+
+Matrix4x4 Matrix4x4::RotationDegrees(float x, float y, float z) {
+    Matrix4x4 m;
+    RotationDegrees(x, y, z, m);
+    return m;
+}
+
+Matrix4x4 Matrix4x4::RotationDegrees(const Vector3& v) {
+    Matrix4x4 m;
+    RotationDegrees(v, m);
+    return m;
+}
+
+Matrix4x4 Matrix4x4::AxisAngleDegrees(const Vector3& axis, float degrees) {
+    Matrix4x4 m;
+    AxisAngleDegrees(axis, degrees, m);
+    return m;
+}
+
+Matrix4x4 Matrix4x4::OrthographicProjection(float w, float h, float n, float f) {
+    Matrix4x4 m;
+    OrthographicProjection(w, h, n, f, m);
+    return m;
+}
+
+Matrix4x4 Matrix4x4::PerspectiveProjectionRadians(float fovx, float fovy, float n, float f) {
+    Matrix4x4 m;
+    PerspectiveProjectionRadians(fovx, fovy, n, f, m);
+    return m;
+}
+
+Matrix4x4 Matrix4x4::PerspectiveProjectionDegrees(float fovx, float fovy, float n, float f) {
+    Matrix4x4 m;
+    PerspectiveProjectionDegrees(fovx, fovy, n, f, m);
+    return m;
+}
+
+Matrix4x4 Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to, const Vector3& up) {
+    Matrix4x4 m;
+    LookAtFromPosition(from, to, up, m);
+    return m;
+}
+Matrix4x4 Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to) {
+    Matrix4x4 m;
+    LookAtFromPosition(from, to, m);
+    return m;
+}
+Matrix4x4 Matrix4x4::LookAtFromDirection(const Vector3& direction, const Vector3& up) {
+    Matrix4x4 m;
+    LookAtFromDirection(direction, up, m);
+    return m;
+}
+Matrix4x4 Matrix4x4::LookAtFromDirection(const Vector3& direction) {
+    Matrix4x4 m;
+    LookAtFromDirection(direction, m);
+    return m;
+}
+
+
+////////////////////////////////////////////////////////////////////////// Morton.cpp
+
+namespace
+{
+    // Each thread sorts at least this many keys.
+    const size_t MortonThreadShare = 1 << 16;
+    // The sort takes this many bits of the keys per pass: 3 passes for 32 bit keys and 6 for 64 bit keys, with the 
+    // counts of a pass small enough to stay in the L1 cache.
+    const int MortonDigitBits = 11;
+    const size_t MortonBuckets = (size_t)1 << MortonDigitBits;
+
+    // Moves bit i of the low 10 bits of x to bit 3i, a shift and a mask at a time.
+    _XOINL uint32_t MortonSpread10(uint32_t x) {
+        x &= 0x3ff;
+        x = (x | (x << 16)) & 0x030000ff;
+        x = (x | (x << 8)) & 0x0300f00f;
+        x = (x | (x << 4)) & 0x030c30c3;
+        x = (x | (x << 2)) & 0x09249249;
+        return x;
+    }
+
+    // The reverse of MortonSpread10, ignoring the bits in between.
+    _XOINL uint32_t MortonCompact10(uint32_t x) {
+        x &= 0x09249249;
+        x = (x | (x >> 2)) & 0x030c30c3;
+        x = (x | (x >> 4)) & 0x0300f00f;
+        x = (x | (x >> 8)) & 0x030000ff;
+        x = (x | (x >> 16)) & 0x3ff;
+        return x;
+    }
+
+    // Moves bit i of the low 21 bits of x to bit 3i.
+    _XOINL uint64_t MortonSpread21(uint64_t x) {
+#if defined(XO_BMI2)
+        return _pdep_u64(x, 0x1249249249249249ull);
+#else
+        x &= 0x1fffff;
+        x = (x | (x << 32)) & 0x001f00000000ffffull;
+        x = (x | (x << 16)) & 0x001f0000ff0000ffull;
+        x = (x | (x << 8)) & 0x100f00f00f00f00full;
+        x = (x | (x << 4)) & 0x10c30c30c30c30c3ull;
+        x = (x | (x << 2)) & 0x1249249249249249ull;
+        return x;
+#endif
+    }
+
+    // The reverse of MortonSpread21, ignoring the bits in between.
+    _XOINL uint32_t MortonCompact21(uint64_t x) {
+#if defined(XO_BMI2)
+        return (uint32_t)_pext_u64(x, 0x1249249249249249ull);
+#else
+        x &= 0x1249249249249249ull;
+        x = (x | (x >> 2)) & 0x10c30c30c30c30c3ull;
+        x = (x | (x >> 4)) & 0x100f00f00f00f00full;
+        x = (x | (x >> 8)) & 0x001f0000ff0000ffull;
+        x = (x | (x >> 16)) & 0x001f00000000ffffull;
+        x = (x | (x >> 32)) & 0x1fffff;
+        return (uint32_t)x;
+#endif
+    }
+
+    // Maps positions in bounds to the cells of a grid of max + 1 cells a side. The scalar and wide versions do the same 
+    // operations, so a point gets the same cell either way.
+    struct MortonGrid {
+        MortonGrid(const AABB& bounds, uint32_t max) : min(bounds.min), max((float)max) {
+            const Vector3 extent = bounds.max - bounds.min;
+            const float cells = (float)max + 1.0f;
+            for (int axis = 0; axis < 3; ++axis) {
+                scale[axis] = extent[axis] > 0.0f ? cells / extent[axis] : 0.0f;
+                wideMin[axis] = wide::Set(min[axis]);
+                wideScale[axis] = wide::Set(scale[axis]);
+            }
+            wideMax = wide::Set(this->max);
+        }
+        // NaN positions land in cell 0.
+        uint32_t Cell(float f, int axis) const {
+            const float cell = (f - min[axis]) * scale[axis];
+            return (uint32_t)(cell > 0.0f ? (cell < max ? cell : max) : 0.0f);
+        }
+        wide::Float WideCell(wide::Float f, int axis) const {
+            return wide::Min(wide::Max(wide::Mul(wide::Sub(f, wideMin[axis]), wideScale[axis]), wide::Zero()), wideMax);
+        }
+        Vector3 min, scale;
+        float max;
+        wide::Float wideMin[3], wideScale[3], wideMax;
+    };
+
+    _XOINL void MortonCode(uint32_t x, uint32_t y, uint32_t z, uint32_t* outCode) { *outCode = Morton::Encode30(x, y, z); }
+    _XOINL void MortonCode(uint32_t x, uint32_t y, uint32_t z, uint64_t* outCode) { *outCode = Morton::Encode63(x, y, z); }
+
+    // MortonStore writes the codes of wide::Width cells, given as whole floats, picking 30 or 63 bit codes by the type 
+    // of outCodes.
+#if defined(XO_SSE2)
+    _XOINL __m128i MortonSpread10(__m128i x) {
+        x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi32(x, 16)), _mm_set1_epi32(0x030000ff));
+        x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi32(x, 8)), _mm_set1_epi32(0x0300f00f));
+        x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi32(x, 4)), _mm_set1_epi32(0x030c30c3));
+        x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi32(x, 2)), _mm_set1_epi32(0x09249249));
+        return x;
+    }
+
+    _XOINL void MortonStore(__m128 x, __m128 y, __m128 z, uint32_t* outCodes) {
+        const __m128i code = _mm_or_si128(MortonSpread10(_mm_cvttps_epi32(x)), 
+                             _mm_or_si128(_mm_slli_epi32(MortonSpread10(_mm_cvttps_epi32(y)), 1), 
+                                          _mm_slli_epi32(MortonSpread10(_mm_cvttps_epi32(z)), 2)));
+        _mm_storeu_si128((__m128i*)outCodes, code);
+    }
+#endif
+
+#if defined(XO_SSE2) && !defined(XO_BMI2)
+    // Two cells per register, one in each 64 bit lane.
+    _XOINL __m128i MortonSpread21(__m128i x) {
+        x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi64(x, 32)), _mm_set1_epi64x(0x001f00000000ffffll));
+        x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi64(x, 16)), _mm_set1_epi64x(0x001f0000ff0000ffll));
+        x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi64(x, 8)), _mm_set1_epi64x(0x100f00f00f00f00fll));
+        x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi64(x, 4)), _mm_set1_epi64x(0x10c30c30c30c30c3ll));
+        x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi64(x, 2)), _mm_set1_epi64x(0x1249249249249249ll));
+        return x;
+    }
+
+    _XOINL __m128i MortonCombine21(__m128i x, __m128i y, __m128i z) {
+        return _mm_or_si128(MortonSpread21(x), _mm_or_si128(_mm_slli_epi64(MortonSpread21(y), 1), _mm_slli_epi64(MortonSpread21(z), 2)));
+    }
+
+    _XOINL void MortonStore(__m128 x, __m128 y, __m128 z, uint64_t* outCodes) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i cellX = _mm_cvttps_epi32(x), cellY = _mm_cvttps_epi32(y), cellZ = _mm_cvttps_epi32(z);
+        _mm_storeu_si128((__m128i*)outCodes, 
+            MortonCombine21(_mm_unpacklo_epi32(cellX, zero), _mm_unpacklo_epi32(cellY, zero), _mm_unpacklo_epi32(cellZ, zero)));
+        _mm_storeu_si128((__m128i*)(outCodes + 2), 
+            MortonCombine21(_mm_unpackhi_epi32(cellX, zero), _mm_unpackhi_epi32(cellY, zero), _mm_unpackhi_epi32(cellZ, zero)));
+    }
+#endif
+
+#if defined(XO_AVX2)
+    _XOINL __m256i MortonSpread10(__m256i x) {
+        x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi32(x, 16)), _mm256_set1_epi32(0x030000ff));
+        x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi32(x, 8)), _mm256_set1_epi32(0x0300f00f));
+        x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi32(x, 4)), _mm256_set1_epi32(0x030c30c3));
+        x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi32(x, 2)), _mm256_set1_epi32(0x09249249));
+        return x;
+    }
+
+    _XOINL void MortonStore(__m256 x, __m256 y, __m256 z, uint32_t* outCodes) {
+        const __m256i code = _mm256_or_si256(MortonSpread10(_mm256_cvttps_epi32(x)), 
+                             _mm256_or_si256(_mm256_slli_epi32(MortonSpread10(_mm256_cvttps_epi32(y)), 1), 
+                                             _mm256_slli_epi32(MortonSpread10(_mm256_cvttps_epi32(z)), 2)));
+        _mm256_storeu_si256((__m256i*)outCodes, code);
+    }
+#elif defined(XO_AVX)
+    // No 256 bit integer operations before AVX2, so each half is done with SSE2.
+    _XOINL void MortonStore(__m256 x, __m256 y, __m256 z, uint32_t* outCodes) {
+        MortonStore(_mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z), outCodes);
+        MortonStore(_mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(z, 1), outCodes + 4);
+    }
+#endif
+
+#if defined(XO_AVX2)
+    // Four cells per register, one in each 64 bit lane.
+    _XOINL __m256i MortonSpread21(__m256i x) {
+        x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi64(x, 32)), _mm256_set1_epi64x(0x001f00000000ffffll));
+        x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi64(x, 16)), _mm256_set1_epi64x(0x001f0000ff0000ffll));
+        x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi64(x, 8)), _mm256_set1_epi64x(0x100f00f00f00f00fll));
+        x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi64(x, 4)), _mm256_set1_epi64x(0x10c30c30c30c30c3ll));
+        x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi64(x, 2)), _mm256_set1_epi64x(0x1249249249249249ll));
+        return x;
+    }
+
+    _XOINL __m256i MortonCombine21x4(__m128i x, __m128i y, __m128i z) {
+        return _mm256_or_si256(MortonSpread21(_mm256_cvtepu32_epi64(x)), 
+               _mm256_or_si256(_mm256_slli_epi64(MortonSpread21(_mm256_cvtepu32_epi64(y)), 1), 
+                               _mm256_slli_epi64(MortonSpread21(_mm256_cvtepu32_epi64(z)), 2)));
+    }
+
+    _XOINL void MortonStore(__m256 x, __m256 y, __m256 z, uint64_t* outCodes) {
+        const __m256i cellX = _mm256_cvttps_epi32(x), cellY = _mm256_cvttps_epi32(y), cellZ = _mm256_cvttps_epi32(z);
+        _mm256_storeu_si256((__m256i*)outCodes, MortonCombine21x4(_mm256_castsi256_si128(cellX), 
+            _mm256_castsi256_si128(cellY), _mm256_castsi256_si128(cellZ)));
+        _mm256_storeu_si256((__m256i*)(outCodes + 4), MortonCombine21x4(_mm256_extracti128_si256(cellX, 1), 
+            _mm256_extracti128_si256(cellY, 1), _mm256_extracti128_si256(cellZ, 1)));
+    }
+#elif defined(XO_AVX) && !defined(XO_BMI2)
+    _XOINL void MortonStore(__m256 x, __m256 y, __m256 z, uint64_t* outCodes) {
+        MortonStore(_mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z), outCodes);
+        MortonStore(_mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(z, 1), outCodes + 4);
+    }
+#endif
+
+#if !defined(XO_SSE2) || (defined(XO_BMI2) && !defined(XO_AVX2))
+    // A lane at a time. With BMI2 this is how 63 bit codes are made without AVX2, PDEP spreading a coordinate in one 
+    // instruction; with AVX2 shifting four at a time is quicker.
+    template <class Code>
+    _XOINL void MortonStore(wide::Float x, wide::Float y, wide::Float z, Code* outCodes) {
+        _XOSIMDALIGN32 float cellX[wide::Width], cellY[wide::Width], cellZ[wide::Width];
+        wide::Store(cellX, x);
+        wide::Store(cellY, y);
+        wide::Store(cellZ, z);
+        for (int lane = 0; lane < wide::Width; ++lane) {
+            MortonCode((uint32_t)cellX[lane], (uint32_t)cellY[lane], (uint32_t)cellZ[lane], outCodes + lane);
+        }
+    }
+#endif
+
+    template <class Code>
+    void MortonEncodeArray(const Vector3* points, size_t count, const AABB& bounds, uint32_t max, Code* outCodes) {
+        const MortonGrid grid(bounds, max);
+        size_t i = 0;
+#if defined(XO_SSE)
+        // Vector3 is four floats wide with SSE, so wide::Width points load as one register per axis.
+        for (; i + wide::Width <= count; i += wide::Width) {
+            wide::Float x, y, z, w;
+            wide::LoadTransposed4(&points[i].x, 4, x, y, z, w);
+            MortonStore(grid.WideCell(x, 0), grid.WideCell(y, 1), grid.WideCell(z, 2), outCodes + i);
+        }
+#endif
+        for (; i < count; ++i) {
+            MortonCode(grid.Cell(points[i].x, 0), grid.Cell(points[i].y, 1), grid.Cell(points[i].z, 2), outCodes + i);
+        }
+    }
+
+    template <class Code>
+    void MortonEncodeStream(const Vector3Stream& points, const AABB& bounds, uint32_t max, Code* outCodes) {
+        const MortonGrid grid(bounds, max);
+        const float* x = points.X();
+        const float* y = points.Y();
+        const float* z = points.Z();
+        const size_t count = points.Size();
+        size_t i = 0;
+        for (; i + wide::Width <= count; i += wide::Width) {
+            MortonStore(grid.WideCell(wide::Load(x + i), 0), grid.WideCell(wide::Load(y + i), 1), grid.WideCell(wide::Load(z + i), 2), outCodes + i);
+        }
+        for (; i < count; ++i) {
+            MortonCode(grid.Cell(x[i], 0), grid.Cell(y[i], 1), grid.Cell(z[i], 2), outCodes + i);
+        }
+    }
+
+    // A least significant digit radix sort: each pass is a stable counting sort of the keys by the next 
+    // MortonDigitBits of them, from the lowest bits up, moving keys and indices to the other pair of arrays. The 
+    // counts of every pass are taken in one read of the keys up front, and passes where all keys have the same digit, 
+    // such as the top bits of Morton codes of few bits, are skipped. With more than one thread, each thread counts and 
+    // moves its own share of the keys; the keys of a bucket are placed by thread, then by position, so the order is 
+    // the same for any number of threads.
+    template <class Key>
+    void MortonRadixSort(Key* keys, uint32_t* indices, size_t count, unsigned threadCount, Key* scratchKeys, uint32_t* scratchIndices) {
+        const int passes = (int)((sizeof(Key) * 8 + MortonDigitBits - 1) / MortonDigitBits);
+        const Key digitMask = (Key)(MortonBuckets - 1);
+        XO_ASSERT(count < 0xffffffffu, "xo-math Morton::Sort too many keys for 32 bit counts.");
+        if (count < 2) {
+            return;
+        }
+        const unsigned threads = xo_internal::ThreadCount(threadCount, count, MortonThreadShare);
+
+        void* allocated = nullptr;
+        if (!scratchKeys || !scratchIndices) {
+            allocated = XO_ALIGNED_MALLOC(count * (sizeof(Key) + sizeof(uint32_t)), 64);
+            scratchKeys = (Key*)allocated;
+            scratchIndices = (uint32_t*)(scratchKeys + count);
+        }
+        const size_t threadBuckets = passes * MortonBuckets;
+        uint32_t* counts = (uint32_t*)XO_ALIGNED_MALLOC(threads * threadBuckets * sizeof(uint32_t), 64);
+        const size_t share = (count + threads - 1) / threads;
+
+        xo_internal::Parallel(threads, [&](unsigned t) {
+            uint32_t* threadCounts = counts + t * threadBuckets;
+            memset(threadCounts, 0, threadBuckets * sizeof(uint32_t));
+            const size_t end = _XO_MIN(count, (t + 1) * share);
+            for (size_t i = t * share; i < end; ++i) {
+                const Key key = keys[i];
+                for (int pass = 0; pass < passes; ++pass) {
+                    ++threadCounts[pass * MortonBuckets + (size_t)((key >> (pass * MortonDigitBits)) & digitMask)];
+                }
+            }
+        });
+
+        Key* fromKeys = keys;
+        Key* toKeys = scratchKeys;
+        uint32_t* fromIndices = indices;
+        uint32_t* toIndices = scratchIndices;
+        bool moved = false;
+        for (int pass = 0; pass < passes; ++pass) {
+            const int shift = pass * MortonDigitBits;
+            const size_t firstDigit = (size_t)((fromKeys[0] >> shift) & digitMask);
+            size_t firstCount = 0;
+            for (unsigned t = 0; t < threads; ++t) {
+                firstCount += counts[t * threadBuckets + pass * MortonBuckets + firstDigit];
+            }
+            if (firstCount == count) {
+                continue;
+            }
+            // The up front counts are of each thread's share of the keys in their first order, later passes recount 
+            // the shares as the last pass left them.
+            if (threads > 1 && moved) {
+                xo_internal::Parallel(threads, [&](unsigned t) {
+                    uint32_t* passCounts = counts + t * threadBuckets + pass * MortonBuckets;
+                    memset(passCounts, 0, MortonBuckets * sizeof(uint32_t));
+                    const size_t end = _XO_MIN(count, (t + 1) * share);
+                    for (size_t i = t * share; i < end; ++i) {
+                        ++passCounts[(size_t)((fromKeys[i] >> shift) & digitMask)];
+                    }
+                });
+            }
+            uint32_t start = 0;
+            for (size_t b = 0; b < MortonBuckets; ++b) {
+                for (unsigned t = 0; t < threads; ++t) {
+                    uint32_t& bucket = counts[t * threadBuckets + pass * MortonBuckets + b];
+                    const uint32_t counted = bucket;
+                    bucket = start;
+                    start += counted;
+                }
+            }
+            xo_internal::Parallel(threads, [&](unsigned t) {
+                uint32_t* starts = counts + t * threadBuckets + pass * MortonBuckets;
+                const size_t end = _XO_MIN(count, (t + 1) * share);
+                for (size_t i = t * share; i < end; ++i) {
+                    const Key key = fromKeys[i];
+                    const uint32_t to = starts[(size_t)((key >> shift) & digitMask)]++;
+                    toKeys[to] = key;
+                    toIndices[to] = fromIndices[i];
+                }
+            });
+            std::swap(fromKeys, toKeys);
+            std::swap(fromIndices, toIndices);
+            moved = true;
+        }
+        if (fromKeys != keys) {
+            memcpy(keys, fromKeys, count * sizeof(Key));
+            memcpy(indices, fromIndices, count * sizeof(uint32_t));
+        }
+        XO_ALIGNED_FREE(counts);
+        if (allocated) {
+            XO_ALIGNED_FREE(allocated);
+        }
+    }
+
+    // Sorts the indices of count points by the 30 bit codes encode writes.
+    template <class Encode>
+    void MortonOrder(size_t count, uint32_t* outOrder, unsigned threadCount, const Encode& encode) {
+        if (count == 0) {
+            return;
+        }
+        // The codes and the sort's scratch arrays in one allocation.
+        uint32_t* codes = (uint32_t*)XO_ALIGNED_MALLOC(count * 3 * sizeof(uint32_t), 64);
+        encode(codes);
+        for (size_t i = 0; i < count; ++i) {
+            outOrder[i] = (uint32_t)i;
+        }
+        Morton::Sort(codes, outOrder, count, threadCount, codes + count, codes + count * 2);
+        XO_ALIGNED_FREE(codes);
+    }
+}
+
+uint32_t Morton::Encode30(uint32_t x, uint32_t y, uint32_t z) {
+    return MortonSpread10(x) | (MortonSpread10(y) << 1) | (MortonSpread10(z) << 2);
+}
+
+uint64_t Morton::Encode63(uint32_t x, uint32_t y, uint32_t z) {
+    return MortonSpread21(x) | (MortonSpread21(y) << 1) | (MortonSpread21(z) << 2);
+}
+
+void Morton::Decode30(uint32_t code, uint32_t& outX, uint32_t& outY, uint32_t& outZ) {
+    outX = MortonCompact10(code);
+    outY = MortonCompact10(code >> 1);
+    outZ = MortonCompact10(code >> 2);
+}
+
+void Morton::Decode63(uint64_t code, uint32_t& outX, uint32_t& outY, uint32_t& outZ) {
+    outX = MortonCompact21(code);
+    outY = MortonCompact21(code >> 1);
+    outZ = MortonCompact21(code >> 2);
+}
+
+uint32_t Morton::Encode30(const Vector3& point, const AABB& bounds) {
+    const MortonGrid grid(bounds, Max30);
+    return Encode30(grid.Cell(point.x, 0), grid.Cell(point.y, 1), grid.Cell(point.z, 2));
+}
+
+uint64_t Morton::Encode63(const Vector3& point, const AABB& bounds) {
+    const MortonGrid grid(bounds, Max63);
+    return Encode63(grid.Cell(point.x, 0), grid.Cell(point.y, 1), grid.Cell(point.z, 2));
+}
+
+void Morton::Encode30(const Vector3* points, size_t count, const AABB& bounds, uint32_t* outCodes) {
+    MortonEncodeArray(points, count, bounds, Max30, outCodes);
+}
+
+void Morton::Encode30(const Vector3Stream& points, const AABB& bounds, uint32_t* outCodes) {
+    MortonEncodeStream(points, bounds, Max30, outCodes);
+}
+
+void Morton::Encode63(const Vector3* points, size_t count, const AABB& bounds, uint64_t* outCodes) {
+    MortonEncodeArray(points, count, bounds, Max63, outCodes);
+}
+
+void Morton::Encode63(const Vector3Stream& points, const AABB& bounds, uint64_t* outCodes) {
+    MortonEncodeStream(points, bounds, Max63, outCodes);
+}
+
+void Morton::Sort(uint32_t* keys, uint32_t* indices, size_t count, unsigned threadCount, uint32_t* scratchKeys, uint32_t* scratchIndices) {
+    MortonRadixSort(keys, indices, count, threadCount, scratchKeys, scratchIndices);
+}
+
+void Morton::Sort(uint64_t* keys, uint32_t* indices, size_t count, unsigned threadCount, uint64_t* scratchKeys, uint32_t* scratchIndices) {
+    MortonRadixSort(keys, indices, count, threadCount, scratchKeys, scratchIndices);
+}
+
+void Morton::Order(const Vector3* points, size_t count, const AABB& bounds, uint32_t* outOrder, unsigned threadCount) {
+    MortonOrder(count, outOrder, threadCount, [&](uint32_t* codes) { Encode30(points, count, bounds, codes); });
+}
+
+void Morton::Order(const Vector3Stream& points, const AABB& bounds, uint32_t* outOrder, unsigned threadCount) {
+    MortonOrder(points.Size(), outOrder, threadCount, [&](uint32_t* codes) { Encode30(points, bounds, codes); });
+}
+
+void Morton::Permute(const Vector3Stream& points, const uint32_t* order, Vector3Stream& outPoints) {
+    XO_ASSERT(&points != &outPoints, "xo-math Morton::Permute points and outPoints are the same stream.");
+    const size_t count = points.Size();
+    outPoints.Resize(count);
+    const float* x = points.X();
+    const float* y = points.Y();
+    const float* z = points.Z();
+    float* outX = outPoints.X();
+    float* outY = outPoints.Y();
+    float* outZ = outPoints.Z();
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t from = order[i];
+        outX[i] = x[from];
+        outY[i] = y[from];
+        outZ[i] = z[from];
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////// OBB.cpp
+
+Vector3 OBB::ClosestPoint(const Vector3& point) const {
+    const Vector3 offset = point - center;
+    Vector3 closest = center;
+    for (int axis = 0; axis < 3; ++axis) {
+        closest += axes[axis] * Clamp(offset.Dot(axes[axis]), -extents[axis], extents[axis]);
+    }
+    return closest;
+}
+
+float OBB::DistanceSquared(const Vector3& point) const {
+    const Vector3 offset = point - center;
+    float distanceSquared = 0.0f;
+    for (int axis = 0; axis < 3; ++axis) {
+        const float outside = Max(Abs(offset.Dot(axes[axis])) - extents[axis], 0.0f);
+        distanceSquared += outside * outside;
+    }
+    return distanceSquared;
+}
+
+void OBB::ClosestPoints(const Vector3Stream& points, Vector3Stream& outPoints, float* outDistancesSquared) const {
+    using namespace wide;
+    const size_t count = points.Size();
+    outPoints.Resize(count);
+    const Float3 c = wide::Set(center.x, center.y, center.z);
+    Float3 axis[3];
+    Float extent[3];
+    for (int a = 0; a < 3; ++a) {
+        axis[a] = wide::Set(axes[a].x, axes[a].y, axes[a].z);
+        extent[a] = wide::Set(extents[a]);
+    }
+    for (size_t i = 0; i < count; i += Width) {
+        const Float3 offset = Sub(Load(points.X() + i, points.Y() + i, points.Z() + i), c);
+        Float3 closest = c;
+        Float distanceSquared = Zero();
+        for (int a = 0; a < 3; ++a) {
+            const Float along = Dot(offset, axis[a]);
+            const Float clamped = wide::Min(wide::Max(along, Negate(extent[a])), extent[a]);
+            const Float outside = Sub(along, clamped);
+            closest = MulAdd(axis[a], clamped, closest);
+            distanceSquared = MulAdd(outside, outside, distanceSquared);
+        }
+        Store(outPoints.X() + i, outPoints.Y() + i, outPoints.Z() + i, closest);
+        if (outDistancesSquared) {
+            if (i + Width <= count) {
+                StoreUnaligned(outDistancesSquared + i, distanceSquared);
+            }
+            else {
+                StorePartial(outDistancesSquared + i, distanceSquared, count - i);
+            }
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////// Plane.cpp
+
+namespace
+{
+    // The plane and classification thresholds broadcast to every lane.
+    struct PlaneTerms {
+        PlaneTerms(const Plane& plane, float epsilon) :
+            x(wide::Set(plane.normal.x)), y(wide::Set(plane.normal.y)), z(wide::Set(plane.normal.z)), d(wide::Set(plane.d)),
+            front(wide::Set(epsilon)), back(wide::Set(-epsilon)) {
+        }
+
+        _XOINL wide::Float Distances(wide::Float px, wide::Float py, wide::Float pz) const {
+            return wide::MulAdd(px, x, wide::MulAdd(py, y, wide::MulAdd(pz, z, d)));
+        }
+
+        wide::Float x, y, z, d;
+        wide::Float front, back;
+    };
+
+    // Calls visit(i, x, y, z, lanes) on the points of a Vector3 array, wide::Width at a time starting from point i, 
+    // where lanes is the number of them that are real points. Stops early if visit returns false.
+    template <class Visit>
+    void PlaneVisitArray(const Vector3* points, size_t count, Visit& visit) {
+        using namespace wide;
+        size_t i = 0;
+        for (; i + Width <= count; i += Width) {
+            Float x, y, z;
+#if defined(XO_SSE)
+            Float w;
+            LoadTransposed4(&points[i].x, 4, x, y, z, w);
+#else
+            x = points[i].x;
+            y = points[i].y;
+            z = points[i].z;
+#endif
+            if (!visit(i, x, y, z, Width)) {
+                return;
+            }
+        }
+#if defined(XO_SSE)
+        if (i < count) {
+            // the last points are copied into a whole group, so they take the same path as the rest.
+            _XOSIMDALIGN32 float tail[Width * 4] = { };
+            for (size_t j = i; j < count; ++j) {
+                memcpy(tail + (j - i) * 4, &points[j].x, sizeof(float) * 3);
+            }
+            Float x, y, z, w;
+            LoadTransposed4(tail, 4, x, y, z, w);
+            visit(i, x, y, z, (int)(count - i));
+        }
+#endif
+    }
+
+    // As PlaneVisitArray, for a stream. Streams are padded to whole groups, so the last one is loaded directly.
+    template <class Visit>
+    void PlaneVisitStream(const Vector3Stream& points, Visit& visit) {
+        using namespace wide;
+        const size_t count = points.Size();
+        for (size_t i = 0; i < count; i += Width) {
+            const int lanes = (int)_XO_MIN(count - i, (size_t)Width);
+            if (!visit(i, Load(points.X() + i), Load(points.Y() + i), Load(points.Z() + i), lanes)) {
+                return;
+            }
+        }
+    }
+
+    // Visits groups, writing their distances to outDistances.
+    struct PlaneDistanceVisitor {
+        bool operator ()(size_t i, wide::Float x, wide::Float y, wide::Float z, int lanes) const {
+            const wide::Float distances = terms.Distances(x, y, z);
+            if (lanes == wide::Width) {
+                wide::StoreUnaligned(outDistances + i, distances);
+            }
+            else {
+                wide::StorePartial(outDistances + i, distances, lanes);
+            }
+            return true;
+        }
+
+        const PlaneTerms& terms;
+        float* outDistances;
+    };
+
+    // Writes the side of each point of a group, one byte per lane, from masks of the points in front and behind.
+    _XOINL void PlaneStoreSides(PlaneSide* outSides, wide::Float front, wide::Float back) {
+        const wide::Float sides = wide::Or(wide::And(front, wide::Set(HexFloat((unsigned)PlaneSide::Front))), 
+                                           wide::And(back, wide::Set(HexFloat((unsigned)PlaneSide::Back))));
+#if defined(XO_AVX)
+        const __m128i low = _mm_castps_si128(_mm256_castps256_ps128(sides)), high = _mm_castps_si128(_mm256_extractf128_ps(sides, 1));
+        _mm_storel_epi64((__m128i*)outSides, _mm_packus_epi16(_mm_packs_epi32(low, high), _mm_setzero_si128()));
+#elif defined(XO_SSE)
+        const __m128i words = _mm_packs_epi32(_mm_castps_si128(sides), _mm_setzero_si128());
+        const int bytes = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+        memcpy(outSides, &bytes, sizeof(bytes));
+#else
+        *outSides = (PlaneSide)wide::Bits(sides);
+#endif
+    }
+
+    // Visits groups, gathering the sides of the set and writing each point's side to outSides if it isn't null.
+    struct PlaneClassifyVisitor {
+        bool operator ()(size_t i, wide::Float x, wide::Float y, wide::Float z, int lanes) {
+            const wide::Float distances = terms.Distances(x, y, z);
+            const wide::Float front = wide::CmpGt(distances, terms.front), back = wide::CmpLt(distances, terms.back);
+            const int valid = wide::LaneBits(lanes);
+            sides |= (wide::MoveMask(front) & valid ? (int)PlaneSide::Front : 0) | (wide::MoveMask(back) & valid ? (int)PlaneSide::Back : 0);
+            if (outSides) {
+                if (lanes == wide::Width) {
+                    PlaneStoreSides(outSides + i, front, back);
+                }
+                else {
+                    PlaneSide group[wide::Width];
+                    PlaneStoreSides(group, front, back);
+                    memcpy(outSides + i, group, lanes);
+                }
+                return true;
+            }
+            return sides != (int)PlaneSide::Straddling;
+        }
+
+        const PlaneTerms& terms;
+        PlaneSide* outSides;
+        int sides;
+    };
+}
+
+Plane& Plane::Normalize() {
+    const float inverseLength = 1.0f / normal.Magnitude();
+    normal *= inverseLength;
+    d *= inverseLength;
+    return *this;
+}
+
+Plane& Plane::Transform(const Matrix4x4& m) {
+    Matrix4x4 inverse;
+    m.GetInverse(inverse);
+    return TransformByInverse(inverse);
+}
+
+Plane& Plane::TransformByInverse(const Matrix4x4& inverse) {
+    // The plane as a row vector times the inverse, which is the inverse transpose times it as a column.
+    const Vector4 v = inverse[0] * normal.x + inverse[1] * normal.y + inverse[2] * normal.z + inverse[3] * d;
+    normal.Set(v.x, v.y, v.z);
+    d = v.w;
+    return Normalize();
+}
+
+void Plane::SignedDistances(const Vector3* points, size_t count, float* outDistances) const {
+    const PlaneTerms terms(*this, 0.0f);
+    PlaneDistanceVisitor visitor{ terms, outDistances };
+    PlaneVisitArray(points, count, visitor);
+}
+
+void Plane::SignedDistances(const Vector3Stream& points, float* outDistances) const {
+    const PlaneTerms terms(*this, 0.0f);
+    PlaneDistanceVisitor visitor{ terms, outDistances };
+    PlaneVisitStream(points, visitor);
+}
+
+PlaneSide Plane::ClassifyPoints(const Vector3* points, size_t count, PlaneSide* outSides, float epsilon) const {
+    const PlaneTerms terms(*this, epsilon);
+    PlaneClassifyVisitor visitor{ terms, outSides, 0 };
+    PlaneVisitArray(points, count, visitor);
+    return (PlaneSide)visitor.sides;
+}
+
+PlaneSide Plane::ClassifyPoints(const Vector3Stream& points, PlaneSide* outSides, float epsilon) const {
+    const PlaneTerms terms(*this, epsilon);
+    PlaneClassifyVisitor visitor{ terms, outSides, 0 };
+    PlaneVisitStream(points, visitor);
+    return (PlaneSide)visitor.sides;
+}
+
+Plane Plane::FromPoints(const Vector3& a, const Vector3& b, const Vector3& c) {
+    return FromPointNormal(a, Vector3::Cross(b - a, c - a).Normalized());
+}
+
+
+////////////////////////////////////////////////////////////////////////// Quaternion.cpp
+
+#if defined(_XONOCONSTEXPR)
+#   if defined(XO_SSE)
+const float Quaternion::Epsilon = sse::SSEFloatEpsilon * 4.0f;
+#   else
+const float Quaternion::Epsilon = FloatEpsilon * 4.0f;
+#   endif
+#endif
+
+const Quaternion Quaternion::Identity(0.0f, 0.0f, 0.0f, 1.0f);
+const Quaternion Quaternion::Zero(0.0f, 0.0f, 0.0f, 0.0f);
+
+namespace xo_internal
+{
+    _XOINL float QuaternionSquareSum(const Quaternion& q)
+    {
+#if defined(XO_SSE3)
+        __m128 square = _mm_mul_ps(q.xmm, q.xmm);
+        square = _mm_hadd_ps(square, square);
+        square = _mm_hadd_ps(square, square);
+        return _mm_cvtss_f32(square);
+#elif defined(XO_SSE)
+        __m128 square = _mm_mul_ps(q.xmm, q.xmm);
+        square = _mm_add_ps(square, _mm_movehl_ps(square, square));
+        square = _mm_add_ss(square, _mm_shuffle_ps(square, square, _MM_SHUFFLE(1, 1, 1, 1)));
+        return _mm_cvtss_f32(square);
+#else
+        return q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w;
+#endif
+    }
+}
+
+Quaternion::Quaternion()
+{
+}
+
+Quaternion::Quaternion(const Matrix4x4& mat)
+{
+    Vector3 xAxis(mat[0]);
+    Vector3 yAxis(mat[1]);
+    Vector3 zAxis(mat[2]);
+
+    Vector3 scale(xAxis.Magnitude(), yAxis.Magnitude(), zAxis.Magnitude());
+
+    // don't use close enough, skip the abs since we're all positive value.
+    // todo: do we actually care about near-zero?
+    if (scale.x <= FloatEpsilon || scale.y <= FloatEpsilon || scale.z <= FloatEpsilon)
+    {
+#if defined(XO_SSE)
+
+#else
+        w = 1.0f;
+        x = y = z = 0.0f;
+#endif
+        return; // too close.
+    }
+
+#if defined(XO_NO_INVERSE_DIVISION)
+    Vector3 recipScale = scale.Reciprocal<Precision::Exact>();
+#else
+    Vector3 recipScale = scale.Reciprocal<Precision::Approximate>();
+#endif
+    xAxis *= recipScale.x;
+    yAxis *= recipScale.y;
+    zAxis *= recipScale.z;
+
+    // Now calculate the rotation from the resulting matrix (axes).
+    float trace = xAxis.x + yAxis.y + zAxis.z + 1.0f;
+
+    if (trace > 1.0f)
+    {
+        float s = 0.5f / Sqrt(trace);
+        _XO_ASSIGN_QUAT(
+            0.25f / s,
+            (yAxis.z - zAxis.y) * s,
+            (xAxis.y - yAxis.x) * s,
+            (zAxis.x - xAxis.z) * s);
+    }
+    else
+    {
+        if (xAxis.x > yAxis.y && xAxis.x > zAxis.z)
+        {
+            float s = 0.5f / Sqrt(1.0f + xAxis.x - yAxis.y - zAxis.z);
+            _XO_ASSIGN_QUAT(
+                (yAxis.z - zAxis.y) * s,
+                0.25f / s,
+                (zAxis.x + xAxis.z) * s,
+                (yAxis.x + xAxis.y) * s);
+        }
+        else if (yAxis.y > zAxis.z)
+        {
+            float s = 0.5f / Sqrt(1.0f + yAxis.y - xAxis.x - zAxis.z);
+            _XO_ASSIGN_QUAT(
+                (zAxis.x - xAxis.z) * s,
+                (yAxis.x + xAxis.y) * s,
+                (zAxis.y + yAxis.z) * s,
+                0.25f / s);
+        }
+        else
+        {
+            float s = 0.5f / Sqrt(1.0f + zAxis.z - xAxis.x - yAxis.y);
+            _XO_ASSIGN_QUAT(
+                (xAxis.y - yAxis.x) * s,
+                (zAxis.x + xAxis.z) * s,
+                0.25f / s,
+                (zAxis.y + yAxis.z) * s);
+        }
+    }
+}
+
+Quaternion::Quaternion(float x, float y, float z, float w) :
+#if defined(XO_SSE)
+    xmm(_mm_set_ps(w, z, y, x))
+#else
+    x(x), y(y), z(z), w(w)
+#endif
+{
+}
+
+Quaternion Quaternion::Inverse() const
+{
+    return Quaternion(*this).MakeInverse();
+}
+
+Quaternion& Quaternion::MakeInverse()
+{
+    float magnitude = xo_internal::QuaternionSquareSum(*this);
+
+    if (CloseEnough(magnitude, 1.0f, Epsilon))
+    {
+        return MakeConjugate();
+    }
+    if (CloseEnough(magnitude, 0.0f, Epsilon))
+    {
+        return *this;
+    }
+
+    MakeConjugate();
+    (*(Vector4*)this) /= magnitude;
+    return *this;
+}
+
+Quaternion Quaternion::Normalized() const
+{
+    return Quaternion(*this).Normalize();
+}
+
+Quaternion& Quaternion::Normalize()
+{
+    float magnitude = xo_internal::QuaternionSquareSum(*this);
+    if (CloseEnough(magnitude, 1.0f, Epsilon))
+    {
+        return *this;
+    }
+
+    magnitude = Sqrt(magnitude);
+    if (CloseEnough(magnitude, 0.0f, Epsilon))
+    {
+        return *this;
+    }
+
+    (*(Vector4*)this) /= magnitude;
+    return *this;
+}
+
+Quaternion Quaternion::Conjugate() const
+{
+    return Quaternion(*this).MakeConjugate();
+}
+
+Quaternion& Quaternion::MakeConjugate()
+{
+    _XO_ASSIGN_QUAT(w, -x, -y, -z);
+    return *this;
+}
+
+void Quaternion::GetAxisAngleRadians(Vector3& axis, float& radians) const
+{
+    Quaternion q = Normalized();
+
+#if defined(XO_SSE)
+    // todo: don't we need to normalize axis in sse too?
+    axis.xmm = q.xmm;
+#else
+    axis.x = q.x;
+    axis.y = q.y;
+    axis.z = q.z;
+    axis.Normalize();
+#endif
+    radians = (2.0f * ACos(q.w));
+}
+
+void Quaternion::RotationRadians(float x, float y, float z, Quaternion& outQuat)
+{
+    RotationRadians(Vector3(x, y, z), outQuat);
+}
+
+void Quaternion::RotationRadians(const Vector3& v, Quaternion& outQuat)
+{
+    Vector3 hv = v * 0.5f;
+    _XOSIMDALIGN float s[3];
+    _XOSIMDALIGN float c[3];
+    SinCos_x3(hv.f, s, c);
+
+    _XO_ASSIGN_QUAT_Q(outQuat,
+                      c[0] * c[1] * c[2] + s[0] * s[1] * s[2],
+                      s[0] * c[1] * c[2] - c[0] * s[1] * s[2],
+                      c[0] * s[1] * c[2] + s[0] * c[1] * s[2],
+                      c[0] * c[1] * s[2] - s[0] * s[1] * c[2]);
+}
+
+void Quaternion::AxisAngleRadians(const Vector3& axis, float radians, Quaternion& outQuat)
+{
+    float hr = radians * 0.5f;
+    float sr = Sin(hr);
+
+    Vector3 n = axis.Normalized();
+    n *= sr;
+    _XO_ASSIGN_QUAT_Q(outQuat, Cos(hr), n.x, n.y, n.z);
+}
+
+void Quaternion::LookAtFromPosition(const Vector3& from, const Vector3& to, const Vector3& up, Quaternion& outQuat)
+{
+    LookAtFromDirection(to - from, up, outQuat);
+}
+
+void Quaternion::LookAtFromPosition(const Vector3& from, const Vector3& to, Quaternion& outQuat)
+{
+    LookAtFromPosition(from, to, Vector3::Up, outQuat);
+}
+
+void Quaternion::LookAtFromDirection(const Vector3&, const Vector3&, Quaternion&)
+{
+    // Todo
+}
+
+void Quaternion::LookAtFromDirection(const Vector3& direction, Quaternion& outQuat)
+{
+    LookAtFromDirection(direction, Vector3::Up, outQuat);
+}
+
+void Quaternion::Slerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat)
+{
+    //      The folowing copyright and licence applies to the contents of this Quaternion::Slerp method
+
+    //      Copyright 2013 BlackBerry Inc.
+    //      Licensed under the Apache License, Version 2.0 (the "License");
+    //      you may not use this file except in compliance with the License.
+    //      You may obtain a copy of the License at
+    //      http://www.apache.org/licenses/LICENSE-2.0
+    //      Unless required by applicable law or agreed to in writing, software
+    //      distributed under the License is distributed on an "AS IS" BASIS,
+    //      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    //      See the License for the specific language governing permissions and
+    //      limitations under the License.
+
+    //      Original file from GamePlay3D: http://gameplay3d.org
+
+    //      Modified by Jared Thomson in 2016:
+    //        - removed assertions
+    //        - made compatable with xo-math
+
+    // Fast slerp implementation by kwhatmough:
+    // It contains no division operations, no trig, no inverse trig
+    // and no sqrt. Not only does this code tolerate small constraint
+    // errors in the input quaternions, it actually corrects for them.
+    if (CloseEnough(t, 0.0f))
+    {
+        outQuat = a;
+        return;
+    }
+    else if (CloseEnough(t, 1.0f))
+    {
+        outQuat = b;
+        return;
+    }
+    else if (a == b)
+    {
+        outQuat = a;
+    }
+    else
+    {
+        float halfY, alpha, beta;
+        float u, f1, f2a, f2b;
+        float ratio1, ratio2;
+        float halfSecHalfTheta, versHalfTheta;
+        float sqNotU, sqU;
+
+        Vector4 * va = (Vector4*)&a;
+        Vector4 * vb = (Vector4*)&b;
+
+        float cosTheta = ((*va) * (*vb)).Sum();
+
+        // As usual in all slerp implementations, we fold theta.
+        alpha = cosTheta >= 0 ? 1.0f : -1.0f;
+        halfY = 1.0f + alpha * cosTheta;
+
+        // Here we bisect the interval, so we need to fold t as well.
+        f2b = t - 0.5f;
+        u = f2b >= 0 ? f2b : -f2b;
+        f2a = u - f2b;
+        f2b += u;
+        u += u;
+        f1 = 1.0f - u;
+
+        // One iteration of Newton to get 1-cos(theta / 2) to good accuracy.
+        halfSecHalfTheta = 1.09f - (0.476537f - 0.0903321f * halfY) * halfY;
+        halfSecHalfTheta *= 1.5f - halfY * halfSecHalfTheta * halfSecHalfTheta;
+        versHalfTheta = 1.0f - halfY * halfSecHalfTheta;
+
+        // Evaluate series expansions of the coefficients.
+        sqNotU = f1 * f1;
+        ratio2 = 0.0000440917108f * versHalfTheta;
+        ratio1 = -0.00158730159f + (sqNotU - 16.0f) * ratio2;
+        ratio1 = 0.0333333333f + ratio1 * (sqNotU - 9.0f) * versHalfTheta;
+        ratio1 = -0.333333333f + ratio1 * (sqNotU - 4.0f) * versHalfTheta;
+        ratio1 = 1.0f + ratio1 * (sqNotU - 1.0f) * versHalfTheta;
+
+        sqU = u * u;
+        ratio2 = -0.00158730159f + (sqU - 16.0f) * ratio2;
+        ratio2 = 0.0333333333f + ratio2 * (sqU - 9.0f) * versHalfTheta;
+        ratio2 = -0.333333333f + ratio2 * (sqU - 4.0f) * versHalfTheta;
+        ratio2 = 1.0f + ratio2 * (sqU - 1.0f) * versHalfTheta;
+
+        // Perform the bisection and resolve the folding done earlier.
+        f1 *= ratio1 * halfSecHalfTheta;
+        f2a *= ratio2;
+        f2b *= ratio2;
+        alpha *= f1 + f2a;
+        beta = f1 + f2b;
+
+        // Apply final coefficients to a and b as usual.
+        float w = alpha * a.w + beta * b.w;
+        float x = alpha * a.x + beta * b.x;
+        float y = alpha * a.y + beta * b.y;
+        float z = alpha * a.z + beta * b.z;
+
+        // This final adjustment to the quaternion's length corrects for
+        // any small constraint error in the inputs q1 and q2 But as you
+        // can see, it comes at the cost of 9 additional multiplication
+        // operations. If this error-correcting feature is not required,
+        // the following code may be removed.
+        f1 = 1.5f - 0.5f * (w * w + x * x + y * y + z * z);
+        _XO_ASSIGN_QUAT_Q(outQuat, w * f1, x * f1, y * f1, z * f1);
+    }
+}
+
+void Quaternion::Nlerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat)
+{
+    float cosTheta = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+    float sign = cosTheta < 0.0f ? -1.0f : 1.0f;
+    outQuat = Quaternion(
+        a.x + (b.x * sign - a.x) * t,
+        a.y + (b.y * sign - a.y) * t,
+        a.z + (b.z * sign - a.z) * t,
+        a.w + (b.w * sign - a.w) * t);
+    outQuat.Normalize();
+}
+
+namespace xo_internal
+{
+    // Quaternion::operator == for wide::Width pairs of quaternions at once.
+    _XOINL wide::Float QuaternionLanesEqual(const wide::Float a[4], const wide::Float b[4])
+    {
+        using namespace wide;
+        Float equal = True();
+        for (int i = 0; i < 4; ++i)
+        {
+#if defined(XO_SSE)
+            equal = And(equal, CmpLt(wide::Abs(Sub(a[i], b[i])), Set(sse::SSEFloatEpsilon)));
+#else
+            equal = And(equal, CmpLe(Mul(wide::Abs(Sub(a[i], b[i])), Set(1.0f / Quaternion::Epsilon)), wide::Min(wide::Abs(a[i]), wide::Abs(b[i]))));
+#endif
+        }
+        return equal;
+    }
+
+    // Quaternion::Slerp for wide::Width quaternions at once, see it for details of the polynomial.
+    _XOINL void SlerpLanes(const wide::Float a[4], const wide::Float b[4], wide::Float t, wide::Float o[4])
+    {
+        using namespace wide;
+        const Float one = Set(1.0f);
+        Float cosTheta = MulAdd(a[0], b[0], MulAdd(a[1], b[1], MulAdd(a[2], b[2], Mul(a[3], b[3]))));
+
+        Float alpha = Select(CmpGe(cosTheta, Zero()), one, Set(-1.0f));
+        Float halfY = MulAdd(alpha, cosTheta, one);
+
+        Float f2b = Sub(t, Set(0.5f));
+        Float u = wide::Abs(f2b);
+        Float f2a = Sub(u, f2b);
+        f2b = Add(f2b, u);
+        u = Add(u, u);
+        Float f1 = Sub(one, u);
+
+        Float halfSecHalfTheta = NegMulAdd(NegMulAdd(Set(0.0903321f), halfY, Set(0.476537f)), halfY, Set(1.09f));
+        halfSecHalfTheta = Mul(halfSecHalfTheta, NegMulAdd(Mul(halfY, halfSecHalfTheta), halfSecHalfTheta, Set(1.5f)));
+        Float versHalfTheta = NegMulAdd(halfY, halfSecHalfTheta, one);
+
+        Float sqNotU = Mul(f1, f1);
+        Float ratio2 = Mul(Set(0.0000440917108f), versHalfTheta);
+        Float ratio1 = MulAdd(Sub(sqNotU, Set(16.0f)), ratio2, Set(-0.00158730159f));
+        ratio1 = MulAdd(Mul(ratio1, Sub(sqNotU, Set(9.0f))), versHalfTheta, Set(0.0333333333f));
+        ratio1 = MulAdd(Mul(ratio1, Sub(sqNotU, Set(4.0f))), versHalfTheta, Set(-0.333333333f));
+        ratio1 = MulAdd(Mul(ratio1, Sub(sqNotU, one)), versHalfTheta, one);
+
+        Float sqU = Mul(u, u);
+        ratio2 = MulAdd(Sub(sqU, Set(16.0f)), ratio2, Set(-0.00158730159f));
+        ratio2 = MulAdd(Mul(ratio2, Sub(sqU, Set(9.0f))), versHalfTheta, Set(0.0333333333f));
+        ratio2 = MulAdd(Mul(ratio2, Sub(sqU, Set(4.0f))), versHalfTheta, Set(-0.333333333f));
+        ratio2 = MulAdd(Mul(ratio2, Sub(sqU, one)), versHalfTheta, one);
+
+        f1 = Mul(f1, Mul(ratio1, halfSecHalfTheta));
+        f2a = Mul(f2a, ratio2);
+        f2b = Mul(f2b, ratio2);
+        alpha = Mul(alpha, Add(f1, f2a));
+        Float beta = Add(f1, f2b);
+
+        Float q[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            q[i] = MulAdd(alpha, a[i], Mul(beta, b[i]));
+        }
+        Float correction = NegMulAdd(Set(0.5f), MulAdd(q[0], q[0], MulAdd(q[1], q[1], MulAdd(q[2], q[2], Mul(q[3], q[3])))), Set(1.5f));
+
+        // The early outs of Quaternion::Slerp, in reverse order so the first of them to apply wins.
+        Float useA = QuaternionLanesEqual(a, b);
+        Float useB = CmpLe(Mul(wide::Abs(Sub(t, one)), Set(1.0f / FloatEpsilon)), wide::Min(wide::Abs(t), one));
+        Float useAFirst = CmpEq(t, Zero());
+        for (int i = 0; i < 4; ++i)
+        {
+            Float r = Select(useA, a[i], Mul(q[i], correction));
+            r = Select(useB, b[i], r);
+            o[i] = Select(useAFirst, a[i], r);
+        }
+    }
+
+    // Quaternion::Nlerp for wide::Width quaternions at once.
+    _XOINL void NlerpLanes(const wide::Float a[4], const wide::Float b[4], wide::Float t, wide::Float o[4])
+    {
+        using namespace wide;
+        Float cosTheta = MulAdd(a[0], b[0], MulAdd(a[1], b[1], MulAdd(a[2], b[2], Mul(a[3], b[3]))));
+        Float flip = CmpLt(cosTheta, Zero());
+        for (int i = 0; i < 4; ++i)
+        {
+            Float bi = Select(flip, Negate(b[i]), b[i]);
+            o[i] = MulAdd(Sub(bi, a[i]), t, a[i]);
+        }
+        Float magSq = MulAdd(o[0], o[0], MulAdd(o[1], o[1], MulAdd(o[2], o[2], Mul(o[3], o[3]))));
+#if defined(XO_NO_INVERSE_DIVISION)
+        Float inv = Div(Set(1.0f), wide::Sqrt(magSq));
+#else
+        Float inv = Rsqrt(magSq);
+#endif
+        inv = And(CmpGt(magSq, Zero()), inv);
+        for (int i = 0; i < 4; ++i)
+        {
+            o[i] = Mul(o[i], inv);
+        }
+    }
+
+    typedef void(*QuaternionLanesBlend)(const wide::Float a[4], const wide::Float b[4], wide::Float t, wide::Float o[4]);
 
-Matrix4x4 Matrix4x4::RotationRadians(float x, float y, float z) {
-    Matrix4x4 m;
-    RotationRadians(x, y, z, m);
-    return m;
+    template <QuaternionLanesBlend Blend>
+    _XOINL void QuaternionBlendArray(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* outQuats, size_t count)
+    {
+        wide::Float la[4], lb[4], lo[4];
+        size_t i = 0;
+        for (; i + wide::Width <= count; i += wide::Width)
+        {
+            wide::LoadTransposed4(a[i].f, 4, la[0], la[1], la[2], la[3]);
+            wide::LoadTransposed4(b[i].f, 4, lb[0], lb[1], lb[2], lb[3]);
+            Blend(la, lb, wide::LoadUnaligned(t + i), lo);
+            wide::StoreTransposed4(outQuats[i].f, 4, lo[0], lo[1], lo[2], lo[3]);
+        }
+        if (i < count)
+        {
+            // The last partial group is padded out with identity quaternions.
+            Quaternion pa[wide::Width], pb[wide::Width];
+            for (size_t j = 0; j < wide::Width; ++j)
+            {
+                pa[j] = i + j < count ? a[i + j] : Quaternion::Identity;
+                pb[j] = i + j < count ? b[i + j] : Quaternion::Identity;
+            }
+            wide::LoadTransposed4(pa[0].f, 4, la[0], la[1], la[2], la[3]);
+            wide::LoadTransposed4(pb[0].f, 4, lb[0], lb[1], lb[2], lb[3]);
+            Blend(la, lb, wide::LoadPartial(t + i, count - i), lo);
+            wide::StoreTransposed4(pa[0].f, 4, lo[0], lo[1], lo[2], lo[3]);
+            for (size_t j = 0; i + j < count; ++j)
+            {
+                outQuats[i + j] = pa[j];
+            }
+        }
+    }
 }
 
-Matrix4x4 Matrix4x4::RotationRadians(const Vector3& v) {
-    Matrix4x4 m;
-    RotationRadians(v, m);
-    return m;
+void Quaternion::SlerpArray(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* outQuats, size_t count)
+{
+    xo_internal::QuaternionBlendArray<xo_internal::SlerpLanes>(a, b, t, outQuats, count);
 }
 
-Matrix4x4 Matrix4x4::AxisAngleRadians(const Vector3& axis, float radians) {
-    Matrix4x4 m;
-    AxisAngleRadians(axis, radians, m);
-    return m;
+void Quaternion::NlerpArray(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* outQuats, size_t count)
+{
+    xo_internal::QuaternionBlendArray<xo_internal::NlerpLanes>(a, b, t, outQuats, count);
 }
 
-Matrix4x4 Matrix4x4::RotationXDegrees(float degrees) {
-    Matrix4x4 m;
-    RotationXDegrees(degrees, m);
-    return m;
+void Quaternion::Lerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat)
+{
+    Vector4& vq = (Vector4&)outQuat;
+    const Vector4& va = a;
+    const Vector4& vb = b;
+    // Todo: give the vectors the same static 'outQuat' type interface, then just use the Vector4::Lerp for this lerp
+    vq = va + (vb - va) * t;
 }
 
-Matrix4x4 Matrix4x4::RotationYDegrees(float degrees) {
-    Matrix4x4 m;
-    RotationYDegrees(degrees, m);
-    return m;
-}
 
-Matrix4x4 Matrix4x4::RotationZDegrees(float degrees) {
-    Matrix4x4 m;
-    RotationZDegrees(degrees, m);
-    return m;
-}
+////////////////////////////////////////////////////////////////////////// Random.cpp
 
-Matrix4x4 Matrix4x4::RotationDegrees(float x, float y, float z) {
-    Matrix4x4 m;
-    RotationDegrees(x, y, z, m);
-    return m;
+namespace {
+    // http://prng.di.unimi.it/splitmix64.c
+    _XOINL uint64_t SplitMix64(uint64_t& state) {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
 }
 
-Matrix4x4 Matrix4x4::RotationDegrees(const Vector3& v) {
-    Matrix4x4 m;
-    RotationDegrees(v, m);
-    return m;
+RandomGenerator::RandomGenerator() {
+    Seed((uint64_t)clock() ^ ((uint64_t)(uintptr_t)this << 16));
 }
 
-Matrix4x4 Matrix4x4::AxisAngleDegrees(const Vector3& axis, float degrees) {
-    Matrix4x4 m;
-    AxisAngleDegrees(axis, degrees, m);
-    return m;
+RandomGenerator::RandomGenerator(uint64_t seed) {
+    Seed(seed);
 }
 
-Matrix4x4 Matrix4x4::OrthographicProjection(float w, float h, float n, float f) {
-    Matrix4x4 m;
-    OrthographicProjection(w, h, n, f, m);
-    return m;
+void RandomGenerator::Seed(uint64_t seed) {
+    uint32_t* words = &s[0][0];
+    for (int i = 0; i < 16; i += 2) {
+        const uint64_t z = SplitMix64(seed);
+        words[i] = (uint32_t)z;
+        words[i + 1] = (uint32_t)(z >> 32);
+    }
 }
 
-Matrix4x4 Matrix4x4::PerspectiveProjectionRadians(float fovx, float fovy, float n, float f) {
-    Matrix4x4 m;
-    PerspectiveProjectionRadians(fovx, fovy, n, f, m);
-    return m;
+void RandomGenerator::RangeArray(float low, float high, float* outFloats, size_t count) {
+    const float scale = (high - low) * (1.0f / 16777216.0f);
+    size_t i = 0;
+#if defined(XO_SSE)
+    __m128i w0 = _mm_load_si128((const __m128i*)s[0]);
+    __m128i w1 = _mm_load_si128((const __m128i*)s[1]);
+    __m128i w2 = _mm_load_si128((const __m128i*)s[2]);
+    __m128i w3 = _mm_load_si128((const __m128i*)s[3]);
+    const __m128 scaleV = _mm_set1_ps(scale);
+    const __m128 lowV = _mm_set1_ps(low);
+    for (; i < count; i += 4) {
+        // Next() for all four generators at once.
+        const __m128i result = _mm_add_epi32(w0, w3);
+        const __m128i t = _mm_slli_epi32(w1, 9);
+        w2 = _mm_xor_si128(w2, w0);
+        w3 = _mm_xor_si128(w3, w1);
+        w1 = _mm_xor_si128(w1, w2);
+        w0 = _mm_xor_si128(w0, w3);
+        w2 = _mm_xor_si128(w2, t);
+        w3 = _mm_or_si128(_mm_slli_epi32(w3, 11), _mm_srli_epi32(w3, 21));
+
+        const __m128 f = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(result, 8)), scaleV), lowV);
+        if (i + 4 <= count) {
+            _mm_storeu_ps(outFloats + i, f);
+        }
+        else {
+            _XOSIMDALIGN float tail[4];
+            _mm_store_ps(tail, f);
+            for (size_t j = 0; i + j < count; ++j) {
+                outFloats[i + j] = tail[j];
+            }
+        }
+    }
+    _mm_store_si128((__m128i*)s[0], w0);
+    _mm_store_si128((__m128i*)s[1], w1);
+    _mm_store_si128((__m128i*)s[2], w2);
+    _mm_store_si128((__m128i*)s[3], w3);
+#else
+    for (; i < count; i += 4) {
+        for (int g = 0; g < 4; ++g) {
+            const uint32_t result = s[0][g] + s[3][g];
+            const uint32_t t = s[1][g] << 9;
+            s[2][g] ^= s[0][g];
+            s[3][g] ^= s[1][g];
+            s[1][g] ^= s[2][g];
+            s[0][g] ^= s[3][g];
+            s[2][g] ^= t;
+            s[3][g] = (s[3][g] << 11) | (s[3][g] >> 21);
+            if (i + g < count) {
+                outFloats[i + g] = (float)(result >> 8) * scale + low;
+            }
+        }
+    }
+#endif
 }
 
-Matrix4x4 Matrix4x4::PerspectiveProjectionDegrees(float fovx, float fovy, float n, float f) {
-    Matrix4x4 m;
-    PerspectiveProjectionDegrees(fovx, fovy, n, f, m);
-    return m;
-}
 
-Matrix4x4 Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to, const Vector3& up) {
-    Matrix4x4 m;
-    LookAtFromPosition(from, to, up, m);
-    return m;
-}
-Matrix4x4 Matrix4x4::LookAtFromPosition(const Vector3& from, const Vector3& to) {
-    Matrix4x4 m;
-    LookAtFromPosition(from, to, m);
-    return m;
-}
-Matrix4x4 Matrix4x4::LookAtFromDirection(const Vector3& direction, const Vector3& up) {
-    Matrix4x4 m;
-    LookAtFromDirection(direction, up, m);
-    return m;
-}
-Matrix4x4 Matrix4x4::LookAtFromDirection(const Vector3& direction) {
-    Matrix4x4 m;
-    LookAtFromDirection(direction, m);
-    return m;
-}
+////////////////////////////////////////////////////////////////////////// Ray.cpp
 
+namespace
+{
+    // Möller-Trumbore over wide::Width ray/triangle pairs, the same arithmetic as Ray::IntersectTriangle. The 
+    // triangle is v0 and its edges e1 = v1 - v0, e2 = v2 - v0. Returns the mask of hits with 0 <= t < tMax.
+    _XOINL wide::Float RayTriangle(
+        wide::Float ox, wide::Float oy, wide::Float oz, wide::Float dx, wide::Float dy, wide::Float dz,
+        wide::Float v0x, wide::Float v0y, wide::Float v0z,
+        wide::Float e1x, wide::Float e1y, wide::Float e1z, wide::Float e2x, wide::Float e2y, wide::Float e2z,
+        wide::Float tMax, wide::Float& outT, wide::Float& outU, wide::Float& outV) {
+        using namespace wide;
+        const Float px = Sub(Mul(dy, e2z), Mul(dz, e2y));
+        const Float py = Sub(Mul(dz, e2x), Mul(dx, e2z));
+        const Float pz = Sub(Mul(dx, e2y), Mul(dy, e2x));
+        const Float det = Add(Add(Mul(e1x, px), Mul(e1y, py)), Mul(e1z, pz));
+        const Float inverseDet = Div(wide::Set(1.0f), det);
+        const Float sx = Sub(ox, v0x), sy = Sub(oy, v0y), sz = Sub(oz, v0z);
+        const Float u = Mul(Add(Add(Mul(sx, px), Mul(sy, py)), Mul(sz, pz)), inverseDet);
+        const Float qx = Sub(Mul(sy, e1z), Mul(sz, e1y));
+        const Float qy = Sub(Mul(sz, e1x), Mul(sx, e1z));
+        const Float qz = Sub(Mul(sx, e1y), Mul(sy, e1x));
+        const Float v = Mul(Add(Add(Mul(dx, qx), Mul(dy, qy)), Mul(dz, qz)), inverseDet);
+        const Float t = Mul(Add(Add(Mul(e2x, qx), Mul(e2y, qy)), Mul(e2z, qz)), inverseDet);
+        const Float zero = Zero();
+        Float hit = And(CmpNeq(det, zero), And(CmpGe(u, zero), CmpGe(v, zero)));
+        hit = And(hit, And(CmpLe(Add(u, v), wide::Set(1.0f)), And(CmpGe(t, zero), CmpLt(t, tMax))));
+        outT = t;
+        outU = u;
+        outV = v;
+        return hit;
+    }
 
-////////////////////////////////////////////////////////////////////////// Quaternion.cpp
+    // A RayPacket is worked through Step rays at a time. A packet narrower than a register (RayPacket4 under AVX) is 
+    // loaded into both halves, and only the low half is stored back.
+    template <int N>
+    struct RayLanes {
+        static const int Step = N < wide::Width ? N : wide::Width;
 
-#if defined(_XONOCONSTEXPR)
-#   if defined(XO_SSE)
-const float Quaternion::Epsilon = sse::SSEFloatEpsilon * 4.0f;
-#   else
-const float Quaternion::Epsilon = FloatEpsilon * 4.0f;
-#   endif
+        _XOINL static wide::Float Load(const float* f) {
+#if defined(XO_AVX)
+            if (N < wide::Width) {
+                return _mm256_broadcast_ps((const __m128*)f);
+            }
 #endif
+            return wide::LoadUnaligned(f);
+        }
 
-const Quaternion Quaternion::Identity(0.0f, 0.0f, 0.0f, 1.0f);
-const Quaternion Quaternion::Zero(0.0f, 0.0f, 0.0f, 0.0f);
+        _XOINL static void Store(float* f, wide::Float v) {
+#if defined(XO_AVX)
+            if (N < wide::Width) {
+                _mm_storeu_ps(f, _mm256_castps256_ps128(v));
+                return;
+            }
+#endif
+            wide::StoreUnaligned(f, v);
+        }
 
-namespace xo_internal
-{
-    _XOINL float QuaternionSquareSum(const Quaternion& q)
-    {
+        _XOINL static int Bits(wide::Float hit) {
+            return wide::MoveMask(hit) & wide::LaneBits(Step);
+        }
+    };
+
+    // Loads Width triangles, three vertices each, as v0 and the two edges.
+    _XOINL void RayLoadTriangles(const Vector3* vertices, 
+        wide::Float& v0x, wide::Float& v0y, wide::Float& v0z,
+        wide::Float& e1x, wide::Float& e1y, wide::Float& e1z, wide::Float& e2x, wide::Float& e2y, wide::Float& e2z) {
+        using namespace wide;
+        Float v1x, v1y, v1z, v2x, v2y, v2z;
 #if defined(XO_SSE)
-        __m128 square = _mm_mul_ps(q.xmm, q.xmm);
-        square = _mm_hadd_ps(square, square);
-        square = _mm_hadd_ps(square, square);
-        return _mm_cvtss_f32(square);
+        // the padding lane of each vertex is loaded and ignored.
+        const size_t stride = sizeof(Vector3) * 3 / sizeof(float);
+        Float w;
+        LoadTransposed4(&vertices[0].x, stride, v0x, v0y, v0z, w);
+        LoadTransposed4(&vertices[1].x, stride, v1x, v1y, v1z, w);
+        LoadTransposed4(&vertices[2].x, stride, v2x, v2y, v2z, w);
 #else
-        return q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w;
+        v0x = vertices[0].x;
+        v0y = vertices[0].y;
+        v0z = vertices[0].z;
+        v1x = vertices[1].x;
+        v1y = vertices[1].y;
+        v1z = vertices[1].z;
+        v2x = vertices[2].x;
+        v2y = vertices[2].y;
+        v2z = vertices[2].z;
 #endif
+        e1x = Sub(v1x, v0x);
+        e1y = Sub(v1y, v0y);
+        e1z = Sub(v1z, v0z);
+        e2x = Sub(v2x, v0x);
+        e2y = Sub(v2y, v0y);
+        e2z = Sub(v2z, v0z);
     }
 }
 
-Quaternion::Quaternion()
-{
+bool Ray::IntersectTriangles(const Vector3* vertices, size_t count, float& inOutT, float& outU, float& outV, size_t& outIndex) const {
+    using namespace wide;
+    const Float ox = wide::Set(origin.x), oy = wide::Set(origin.y), oz = wide::Set(origin.z);
+    const Float dx = wide::Set(direction.x), dy = wide::Set(direction.y), dz = wide::Set(direction.z);
+    Float closest = wide::Set(inOutT);
+    bool found = false;
+    // The last partial group is tested with its last triangle repeated in the unused lanes.
+    Vector3 tail[Width * 3];
+    for (size_t i = 0; i < count; i += Width) {
+        const Vector3* group = vertices + i * 3;
+        if (i + Width > count) {
+            for (size_t j = 0; j < (size_t)Width; ++j) {
+                const size_t k = (i + j < count ? j : count - 1 - i) * 3;
+                tail[j * 3] = group[k];
+                tail[j * 3 + 1] = group[k + 1];
+                tail[j * 3 + 2] = group[k + 2];
+            }
+            group = tail;
+        }
+        Float v0x, v0y, v0z, e1x, e1y, e1z, e2x, e2y, e2z, t, u, v;
+        RayLoadTriangles(group, v0x, v0y, v0z, e1x, e1y, e1z, e2x, e2y, e2z);
+        const int bits = MoveMask(RayTriangle(ox, oy, oz, dx, dy, dz, v0x, v0y, v0z, e1x, e1y, e1z, e2x, e2y, e2z, closest, t, u, v));
+        if (bits) {
+            // Hits are rare next to misses, so the closest lane is picked in scalar code and the bound tightened for 
+            // the groups that follow.
+            _XOSIMDALIGN32 float ts[Width], us[Width], vs[Width];
+            Store(ts, t);
+            Store(us, u);
+            Store(vs, v);
+            for (int lane = 0; lane < Width; ++lane) {
+                if (((bits >> lane) & 1) && ts[lane] < inOutT) {
+                    inOutT = ts[lane];
+                    outU = us[lane];
+                    outV = vs[lane];
+                    outIndex = i + lane < count ? i + lane : count - 1;
+                }
+            }
+            closest = wide::Set(inOutT);
+            found = true;
+        }
+    }
+    return found;
+}
+
+template <int N>
+int RayPacket<N>::IntersectTriangle(const Vector3& v0, const Vector3& v1, const Vector3& v2, float* inOutT, float* outU, float* outV) const {
+    using namespace wide;
+    typedef RayLanes<N> Lanes;
+    const Float v0x = wide::Set(v0.x), v0y = wide::Set(v0.y), v0z = wide::Set(v0.z);
+    const Float e1x = wide::Set(v1.x - v0.x), e1y = wide::Set(v1.y - v0.y), e1z = wide::Set(v1.z - v0.z);
+    const Float e2x = wide::Set(v2.x - v0.x), e2y = wide::Set(v2.y - v0.y), e2z = wide::Set(v2.z - v0.z);
+    int bits = 0;
+    for (int i = 0; i < N; i += Lanes::Step) {
+        const Float ox = Lanes::Load(originX + i), oy = Lanes::Load(originY + i), oz = Lanes::Load(originZ + i);
+        const Float dx = Lanes::Load(directionX + i), dy = Lanes::Load(directionY + i), dz = Lanes::Load(directionZ + i);
+        const Float closest = Lanes::Load(inOutT + i);
+        Float t, u, v;
+        const Float hit = RayTriangle(ox, oy, oz, dx, dy, dz, v0x, v0y, v0z, e1x, e1y, e1z, e2x, e2y, e2z, closest, t, u, v);
+        Lanes::Store(inOutT + i, Select(hit, t, closest));
+        Lanes::Store(outU + i, Select(hit, u, Lanes::Load(outU + i)));
+        Lanes::Store(outV + i, Select(hit, v, Lanes::Load(outV + i)));
+        bits |= Lanes::Bits(hit) << i;
+    }
+    return bits;
+}
+
+template <int N>
+int RayPacket<N>::IntersectAABB(const AABB& box, float* inOutT) const {
+    using namespace wide;
+    typedef RayLanes<N> Lanes;
+    const Float minX = wide::Set(box.min.x), minY = wide::Set(box.min.y), minZ = wide::Set(box.min.z);
+    const Float maxX = wide::Set(box.max.x), maxY = wide::Set(box.max.y), maxZ = wide::Set(box.max.z);
+    int bits = 0;
+    for (int i = 0; i < N; i += Lanes::Step) {
+        const Float ox = Lanes::Load(originX + i), oy = Lanes::Load(originY + i), oz = Lanes::Load(originZ + i);
+        const Float ix = Lanes::Load(inverseDirectionX + i), iy = Lanes::Load(inverseDirectionY + i), iz = Lanes::Load(inverseDirectionZ + i);
+        const Float closest = Lanes::Load(inOutT + i);
+        const Float x0 = Mul(Sub(minX, ox), ix), x1 = Mul(Sub(maxX, ox), ix);
+        const Float y0 = Mul(Sub(minY, oy), iy), y1 = Mul(Sub(maxY, oy), iy);
+        const Float z0 = Mul(Sub(minZ, oz), iz), z1 = Mul(Sub(maxZ, oz), iz);
+        const Float enter = wide::Max(wide::Max(wide::Min(x0, x1), wide::Min(y0, y1)), wide::Max(wide::Min(z0, z1), Zero()));
+        const Float exit = wide::Min(wide::Min(wide::Max(x0, x1), wide::Max(y0, y1)), wide::Min(wide::Max(z0, z1), closest));
+        const Float hit = And(CmpLe(enter, exit), CmpLt(enter, closest));
+        Lanes::Store(inOutT + i, Select(hit, enter, closest));
+        bits |= Lanes::Bits(hit) << i;
+    }
+    return bits;
+}
+
+template <int N>
+int RayPacket<N>::IntersectSphere(const Vector3& center, float radius, float* inOutT) const {
+    using namespace wide;
+    typedef RayLanes<N> Lanes;
+    const Float cx = wide::Set(center.x), cy = wide::Set(center.y), cz = wide::Set(center.z);
+    const Float radiusSquared = wide::Set(radius * radius);
+    const Float zero = Zero();
+    int bits = 0;
+    for (int i = 0; i < N; i += Lanes::Step) {
+        const Float ox = Sub(Lanes::Load(originX + i), cx), oy = Sub(Lanes::Load(originY + i), cy), oz = Sub(Lanes::Load(originZ + i), cz);
+        const Float dx = Lanes::Load(directionX + i), dy = Lanes::Load(directionY + i), dz = Lanes::Load(directionZ + i);
+        const Float closest = Lanes::Load(inOutT + i);
+        const Float a = Add(Add(Mul(dx, dx), Mul(dy, dy)), Mul(dz, dz));
+        const Float b = Add(Add(Mul(ox, dx), Mul(oy, dy)), Mul(oz, dz));
+        const Float c = Sub(Add(Add(Mul(ox, ox), Mul(oy, oy)), Mul(oz, oz)), radiusSquared);
+        const Float discriminant = Sub(Mul(b, b), Mul(a, c));
+        const Float root = wide::Sqrt(wide::Max(discriminant, zero));
+        const Float inverseA = Div(wide::Set(1.0f), a);
+        const Float tNear = Mul(Sub(Negate(b), root), inverseA);
+        const Float tFar = Mul(Sub(root, b), inverseA);
+        const Float t = Select(CmpGe(tNear, zero), tNear, tFar);
+        const Float hit = And(CmpGe(discriminant, zero), And(CmpGe(t, zero), CmpLt(t, closest)));
+        Lanes::Store(inOutT + i, Select(hit, t, closest));
+        bits |= Lanes::Bits(hit) << i;
+    }
+    return bits;
 }
 
-Quaternion::Quaternion(const Matrix4x4& mat)
-{
-    Vector3 xAxis(mat[0]);
-    Vector3 yAxis(mat[1]);
-    Vector3 zAxis(mat[2]);
+template class RayPacket<4>;
+template class RayPacket<8>;
 
-    Vector3 scale(xAxis.Magnitude(), yAxis.Magnitude(), zAxis.Magnitude());
 
-    // don't use close enough, skip the abs since we're all positive value.
-    // todo: do we actually care about near-zero?
-    if (scale.x <= FloatEpsilon || scale.y <= FloatEpsilon || scale.z <= FloatEpsilon)
-    {
-#if defined(XO_SSE)
+////////////////////////////////////////////////////////////////////////// Segment.cpp
 
-#else
-        w = 1.0f;
-        x = y = z = 0.0f;
-#endif
-        return; // too close.
+Vector3 Segment::ClosestPoint(const Vector3& point) const {
+    const Vector3 direction = end - start;
+    const float lengthSquared = direction.MagnitudeSquared();
+    if (lengthSquared <= 0.0f) {
+        return start;
+    }
+    return start + direction * Clamp((point - start).Dot(direction) / lengthSquared, 0.0f, 1.0f);
+}
+
+float Segment::ClosestPoints(const Segment& segment, Vector3& outPoint, Vector3& outSegmentPoint) const {
+    // s and t are how far along this segment and segment the closest points are.
+    const Vector3 d1 = end - start, d2 = segment.end - segment.start, r = start - segment.start;
+    const float a = d1.MagnitudeSquared(), e = d2.MagnitudeSquared(), f = d2.Dot(r);
+    float s, t;
+    if (a <= 0.0f && e <= 0.0f) {
+        s = t = 0.0f;
+    }
+    else if (a <= 0.0f) {
+        s = 0.0f;
+        t = Clamp(f / e, 0.0f, 1.0f);
+    }
+    else {
+        const float c = d1.Dot(r);
+        if (e <= 0.0f) {
+            t = 0.0f;
+            s = Clamp(-c / a, 0.0f, 1.0f);
+        }
+        else {
+            // the closest points of the infinite lines, with s clamped to this segment and t following it. If that 
+            // takes t off the other segment, t is clamped and s found again from it.
+            const float b = d1.Dot(d2);
+            const float denominator = a * e - b * b;
+            s = denominator != 0.0f ? Clamp((b * f - c * e) / denominator, 0.0f, 1.0f) : 0.0f;
+            t = (b * s + f) / e;
+            if (t < 0.0f) {
+                t = 0.0f;
+                s = Clamp(-c / a, 0.0f, 1.0f);
+            }
+            else if (t > 1.0f) {
+                t = 1.0f;
+                s = Clamp((b - c) / a, 0.0f, 1.0f);
+            }
+        }
+    }
+    outPoint = start + d1 * s;
+    outSegmentPoint = segment.start + d2 * t;
+    return (outPoint - outSegmentPoint).MagnitudeSquared();
+}
+
+void Segment::ClosestPoints(const Vector3Stream& points, const Vector3Stream& starts, const Vector3Stream& ends, Vector3Stream& outPoints, float* outDistancesSquared) {
+    XO_ASSERT(points.Size() == starts.Size() && points.Size() == ends.Size(), "xo-math Segment::ClosestPoints streams must be the same size.");
+    using namespace wide;
+    const size_t count = points.Size();
+    outPoints.Resize(count);
+    for (size_t i = 0; i < count; i += Width) {
+        const Float3 p = Load(points.X() + i, points.Y() + i, points.Z() + i);
+        const Float3 start = Load(starts.X() + i, starts.Y() + i, starts.Z() + i);
+        const Float3 direction = Sub(Load(ends.X() + i, ends.Y() + i, ends.Z() + i), start);
+        // a segment with its ends together divides zero by zero, which Saturate takes to its start.
+        const Float t = Saturate(Div(Dot(Sub(p, start), direction), Dot(direction, direction)));
+        const Float3 closest = MulAdd(direction, t, start);
+        Store(outPoints.X() + i, outPoints.Y() + i, outPoints.Z() + i, closest);
+        if (outDistancesSquared) {
+            const Float3 offset = Sub(p, closest);
+            if (i + Width <= count) {
+                StoreUnaligned(outDistancesSquared + i, Dot(offset, offset));
+            }
+            else {
+                StorePartial(outDistancesSquared + i, Dot(offset, offset), count - i);
+            }
+        }
+    }
+}
+
+void Segment::ClosestPoints(const Vector3Stream& starts1, const Vector3Stream& ends1, const Vector3Stream& starts2, const Vector3Stream& ends2, 
+                            Vector3Stream& outPoints1, Vector3Stream& outPoints2, float* outDistancesSquared) {
+    XO_ASSERT(starts1.Size() == ends1.Size() && starts1.Size() == starts2.Size() && starts1.Size() == ends2.Size(), 
+              "xo-math Segment::ClosestPoints streams must be the same size.");
+    using namespace wide;
+    const size_t count = starts1.Size();
+    outPoints1.Resize(count);
+    outPoints2.Resize(count);
+    const Float one = wide::Set(1.0f);
+    for (size_t i = 0; i < count; i += Width) {
+        const Float3 p1 = Load(starts1.X() + i, starts1.Y() + i, starts1.Z() + i);
+        const Float3 p2 = Load(starts2.X() + i, starts2.Y() + i, starts2.Z() + i);
+        const Float3 d1 = Sub(Load(ends1.X() + i, ends1.Y() + i, ends1.Z() + i), p1);
+        const Float3 d2 = Sub(Load(ends2.X() + i, ends2.Y() + i, ends2.Z() + i), p2);
+        const Float3 r = Sub(p1, p2);
+        const Float a = Dot(d1, d1), b = Dot(d1, d2), c = Dot(d1, r), e = Dot(d2, d2), f = Dot(d2, r);
+
+        // Every case of Segment::ClosestPoints is computed and the right one selected per lane. Where a case divides 
+        // zero by zero the NaN is clamped to 0 by Saturate, which is the value the scalar code picks for it.
+        Float s = Saturate(Div(NegMulAdd(c, e, Mul(b, f)), NegMulAdd(b, b, Mul(a, e))));
+        Float t = Div(MulAdd(b, s, f), e);
+        const Float sAtStart = Saturate(Div(Negate(c), a)), sAtEnd = Saturate(Div(Sub(b, c), a));
+        s = Select(CmpLt(t, Zero()), sAtStart, Select(CmpGt(t, one), sAtEnd, s));
+        // the second segment is a point: t is NaN, so neither compare above held.
+        s = Select(CmpLe(e, Zero()), sAtStart, s);
+        t = Saturate(t);
+
+        const Float3 closest1 = MulAdd(d1, s, p1), closest2 = MulAdd(d2, t, p2);
+        Store(outPoints1.X() + i, outPoints1.Y() + i, outPoints1.Z() + i, closest1);
+        Store(outPoints2.X() + i, outPoints2.Y() + i, outPoints2.Z() + i, closest2);
+        if (outDistancesSquared) {
+            const Float3 offset = Sub(closest1, closest2);
+            if (i + Width <= count) {
+                StoreUnaligned(outDistancesSquared + i, Dot(offset, offset));
+            }
+            else {
+                StorePartial(outDistancesSquared + i, Dot(offset, offset), count - i);
+            }
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////// Skinning.cpp
+
+namespace
+{
+    // Each thread skins at least this many vertices.
+    const size_t SkinningThreadShare = 1 << 14;
+
+    // Calls kernel(begin, end) over count vertices, split into ranges that start on a multiple of wide::Width so that 
+    // threads never share a block of a stream.
+    template <class Kernel>
+    void SkinningRun(size_t count, unsigned threadCount, const Kernel& kernel) {
+        const unsigned threads = xo_internal::ThreadCount(threadCount, count, SkinningThreadShare);
+        const size_t blocks = (count + wide::Width - 1) / wide::Width;
+        xo_internal::Parallel(threads, [&](unsigned t) {
+            const size_t begin = blocks * t / threads * wide::Width;
+            const size_t end = _XO_MIN(blocks * (t + 1) / threads * wide::Width, count);
+            kernel(begin, end);
+        });
     }
 
+    // v rotated by the unit quaternion q, for wide::Width vectors: t = 2 * cross(q, v), v' = v + q.w * t + cross(q, t)
+    _XOINL wide::Float3 SkinningRotate(wide::Float qx, wide::Float qy, wide::Float qz, wide::Float qw, const wide::Float3& v) {
+        using namespace wide;
+        Float tx = Sub(Mul(qy, v.z), Mul(qz, v.y));
+        Float ty = Sub(Mul(qz, v.x), Mul(qx, v.z));
+        Float tz = Sub(Mul(qx, v.y), Mul(qy, v.x));
+        tx = Add(tx, tx);
+        ty = Add(ty, ty);
+        tz = Add(tz, tz);
+        Float3 r;
+        r.x = Add(MulAdd(qw, tx, v.x), Sub(Mul(qy, tz), Mul(qz, ty)));
+        r.y = Add(MulAdd(qw, ty, v.y), Sub(Mul(qz, tx), Mul(qx, tz)));
+        r.z = Add(MulAdd(qw, tz, v.z), Sub(Mul(qx, ty), Mul(qy, tx)));
+        return r;
+    }
+
+    // Blends dual quaternions. Each vertex's blend is 8 floats, real then dual.
+    struct SkinningDualQuaternions {
+        static const int Floats = 8;
+
+        // The weighted sum of the dual quaternions of one vertex's bones. Bones whose real part is more than 90 degrees 
+        // from the first bone's are negated, so every bone rotates the short way.
+        _XOINL void Blend(const uint16_t* indices, const float* weights, float* out) const {
+            const DualQuaternion& first = palette[indices[0]];
 #if defined(XO_SSE)
-#   if defined(XO_NO_INVERSE_DIVISION)
-    Vector3 recipScale = Vector3(_mm_div_ps(Vector4::One.xmm, scale.xmm));
-#   else
-    Vector3 recipScale = Vector3(_mm_rcp_ps(scale.xmm));
-#   endif
+            // The sign of each dot product is moved onto the weight without leaving the registers.
+            const __m128 w = _mm_set1_ps(weights[0]), sign = _mm_set1_ps(-0.0f);
+            __m128 real = _mm_mul_ps(w, first.real.xmm), dual = _mm_mul_ps(w, first.dual.xmm);
+            for (int i = 1; i < Skinning::Influences; ++i) {
+                const DualQuaternion& q = palette[indices[i]];
+                __m128 dot = _mm_mul_ps(first.real.xmm, q.real.xmm);
+                dot = _mm_add_ps(dot, _mm_shuffle_ps(dot, dot, _MM_SHUFFLE(2, 3, 0, 1)));
+                dot = _mm_add_ps(dot, _mm_shuffle_ps(dot, dot, _MM_SHUFFLE(1, 0, 3, 2)));
+                const __m128 wi = _mm_xor_ps(_mm_set1_ps(weights[i]), _mm_and_ps(dot, sign));
+                real = sse::MulAdd(wi, q.real.xmm, real);
+                dual = sse::MulAdd(wi, q.dual.xmm, dual);
+            }
+            _mm_store_ps(out, real);
+            _mm_store_ps(out + 4, dual);
 #else
-    Vector3 recipScale = Vector3(1.0f / scale.x, 1.0f / scale.y, 1.0f / scale.z);
+            for (int c = 0; c < 4; ++c) {
+                out[c] = first.real.f[c] * weights[0];
+                out[c + 4] = first.dual.f[c] * weights[0];
+            }
+            for (int i = 1; i < Skinning::Influences; ++i) {
+                const DualQuaternion& q = palette[indices[i]];
+                const float dot = first.real.x * q.real.x + first.real.y * q.real.y + first.real.z * q.real.z + first.real.w * q.real.w;
+                const float wi = dot < 0.0f ? -weights[i] : weights[i];
+                for (int c = 0; c < 4; ++c) {
+                    out[c] += q.real.f[c] * wi;
+                    out[c + 4] += q.dual.f[c] * wi;
+                }
+            }
 #endif
-    xAxis *= recipScale.x;
-    yAxis *= recipScale.y;
-    zAxis *= recipScale.z;
+        }
 
-    // Now calculate the rotation from the resulting matrix (axes).
-    float trace = xAxis.x + yAxis.y + zAxis.z + 1.0f;
+        // The blend of the lanes past the last vertex, which must normalize.
+        _XOINL void Padding(float* out) const {
+            memcpy(out, &DualQuaternion::Identity, sizeof(float) * Floats);
+        }
 
-    if (trace > 1.0f)
-    {
-        float s = 0.5f / Sqrt(trace);
-        _XO_ASSIGN_QUAT(
-            0.25f / s,
-            (yAxis.z - zAxis.y) * s,
-            (xAxis.y - yAxis.x) * s,
-            (zAxis.x - xAxis.z) * s);
-    }
-    else
-    {
-        if (xAxis.x > yAxis.y && xAxis.x > zAxis.z)
-        {
-            float s = 0.5f / Sqrt(1.0f + xAxis.x - yAxis.y - zAxis.z);
-            _XO_ASSIGN_QUAT(
-                (yAxis.z - zAxis.y) * s,
-                0.25f / s,
-                (zAxis.x + xAxis.z) * s,
-                (yAxis.x + xAxis.y) * s);
+        // The rotation and translation of wide::Width blends.
+        struct Lanes {
+            wide::Float rx, ry, rz, rw, tx, ty, tz;
+        };
+
+        // Normalizes by the magnitude of the real part, then takes the translation as 
+        // 2 * (real.w * dual.xyz - dual.w * real.xyz + real.xyz x dual.xyz).
+        _XOINL void Load(const float* blended, Lanes& l) const {
+            using namespace wide;
+            Float dx, dy, dz, dw;
+            LoadTransposed4(blended, Floats, l.rx, l.ry, l.rz, l.rw);
+            LoadTransposed4(blended + 4, Floats, dx, dy, dz, dw);
+            const Float inverseMagnitude = Rsqrt(MulAdd(l.rw, l.rw, MulAdd(l.rz, l.rz, MulAdd(l.ry, l.ry, Mul(l.rx, l.rx)))));
+            l.rx = Mul(l.rx, inverseMagnitude);
+            l.ry = Mul(l.ry, inverseMagnitude);
+            l.rz = Mul(l.rz, inverseMagnitude);
+            l.rw = Mul(l.rw, inverseMagnitude);
+            const Float twice = Add(inverseMagnitude, inverseMagnitude);
+            dx = Mul(dx, twice);
+            dy = Mul(dy, twice);
+            dz = Mul(dz, twice);
+            dw = Mul(dw, twice);
+            l.tx = Add(Sub(Mul(l.rw, dx), Mul(dw, l.rx)), Sub(Mul(l.ry, dz), Mul(l.rz, dy)));
+            l.ty = Add(Sub(Mul(l.rw, dy), Mul(dw, l.ry)), Sub(Mul(l.rz, dx), Mul(l.rx, dz)));
+            l.tz = Add(Sub(Mul(l.rw, dz), Mul(dw, l.rz)), Sub(Mul(l.rx, dy), Mul(l.ry, dx)));
         }
-        else if (yAxis.y > zAxis.z)
-        {
-            float s = 0.5f / Sqrt(1.0f + yAxis.y - xAxis.x - zAxis.z);
-            _XO_ASSIGN_QUAT(
-                (zAxis.x - xAxis.z) * s,
-                (yAxis.x + xAxis.y) * s,
-                (zAxis.y + yAxis.z) * s,
-                0.25f / s);
+
+        _XOINL wide::Float3 Point(const Lanes& l, const wide::Float3& v) const {
+            wide::Float3 r = SkinningRotate(l.rx, l.ry, l.rz, l.rw, v);
+            r.x = wide::Add(r.x, l.tx);
+            r.y = wide::Add(r.y, l.ty);
+            r.z = wide::Add(r.z, l.tz);
+            return r;
         }
-        else
-        {
-            float s = 0.5f / Sqrt(1.0f + zAxis.z - xAxis.x - yAxis.y);
-            _XO_ASSIGN_QUAT(
-                (xAxis.y - yAxis.x) * s,
-                (zAxis.x + xAxis.z) * s,
-                0.25f / s,
-                (zAxis.y + yAxis.z) * s);
+
+        _XOINL wide::Float3 Direction(const Lanes& l, const wide::Float3& v) const {
+            return SkinningRotate(l.rx, l.ry, l.rz, l.rw, v);
         }
-    }
-}
 
-Quaternion::Quaternion(float x, float y, float z, float w) :
+        const DualQuaternion* palette;
+    };
+
+    // Blends the top three rows of Matrix3x4 or Matrix4x4 palettes. Each vertex's blend is 12 floats, row by row.
+    template <class Matrix>
+    struct SkinningMatrices {
+        static const int Floats = 12;
+
+        // The weighted sum of the matrices of one vertex's bones, a row at a time.
+        _XOINL void Blend(const uint16_t* indices, const float* weights, float* out) const {
 #if defined(XO_SSE)
-    xmm(_mm_set_ps(w, z, y, x))
+            const Matrix& first = palette[indices[0]];
+            const __m128 w = _mm_set1_ps(weights[0]);
+            __m128 r0 = _mm_mul_ps(w, first.r[0].xmm), r1 = _mm_mul_ps(w, first.r[1].xmm), r2 = _mm_mul_ps(w, first.r[2].xmm);
+            for (int i = 1; i < Skinning::Influences; ++i) {
+                const Matrix& m = palette[indices[i]];
+                const __m128 wi = _mm_set1_ps(weights[i]);
+                r0 = sse::MulAdd(wi, m.r[0].xmm, r0);
+                r1 = sse::MulAdd(wi, m.r[1].xmm, r1);
+                r2 = sse::MulAdd(wi, m.r[2].xmm, r2);
+            }
+            _mm_store_ps(out, r0);
+            _mm_store_ps(out + 4, r1);
+            _mm_store_ps(out + 8, r2);
 #else
-    x(x), y(y), z(z), w(w)
+            for (int c = 0; c < Floats; ++c) {
+                out[c] = palette[indices[0]].m[c] * weights[0];
+            }
+            for (int i = 1; i < Skinning::Influences; ++i) {
+                const Matrix& m = palette[indices[i]];
+                for (int c = 0; c < Floats; ++c) {
+                    out[c] += m.m[c] * weights[i];
+                }
+            }
 #endif
-{
-}
+        }
 
-Quaternion Quaternion::Inverse() const
-{
-    return Quaternion(*this).MakeInverse();
-}
+        _XOINL void Padding(float* out) const {
+            memset(out, 0, sizeof(float) * Floats);
+        }
 
-Quaternion& Quaternion::MakeInverse()
-{
-    float magnitude = xo_internal::QuaternionSquareSum(*this);
+        struct Lanes {
+            wide::Float m[12];
+        };
 
-    if (CloseEnough(magnitude, 1.0f, Epsilon))
-    {
-        return MakeConjugate();
-    }
-    if (CloseEnough(magnitude, 0.0f, Epsilon))
-    {
-        return *this;
-    }
+        _XOINL void Load(const float* blended, Lanes& l) const {
+            wide::LoadTransposed4(blended, Floats, l.m[0], l.m[1], l.m[2], l.m[3]);
+            wide::LoadTransposed4(blended + 4, Floats, l.m[4], l.m[5], l.m[6], l.m[7]);
+            wide::LoadTransposed4(blended + 8, Floats, l.m[8], l.m[9], l.m[10], l.m[11]);
+        }
 
-    MakeConjugate();
-    (*(Vector4*)this) /= magnitude;
-    return *this;
-}
+        _XOINL wide::Float3 Point(const Lanes& l, const wide::Float3& v) const {
+            using namespace wide;
+            Float3 r;
+            r.x = MulAdd(l.m[2], v.z, MulAdd(l.m[1], v.y, MulAdd(l.m[0], v.x, l.m[3])));
+            r.y = MulAdd(l.m[6], v.z, MulAdd(l.m[5], v.y, MulAdd(l.m[4], v.x, l.m[7])));
+            r.z = MulAdd(l.m[10], v.z, MulAdd(l.m[9], v.y, MulAdd(l.m[8], v.x, l.m[11])));
+            return r;
+        }
 
-Quaternion Quaternion::Normalized() const
-{
-    return Quaternion(*this).Normalize();
-}
+        _XOINL wide::Float3 Direction(const Lanes& l, const wide::Float3& v) const {
+            using namespace wide;
+            Float3 r;
+            r.x = MulAdd(l.m[2], v.z, MulAdd(l.m[1], v.y, Mul(l.m[0], v.x)));
+            r.y = MulAdd(l.m[6], v.z, MulAdd(l.m[5], v.y, Mul(l.m[4], v.x)));
+            r.z = MulAdd(l.m[10], v.z, MulAdd(l.m[9], v.y, Mul(l.m[8], v.x)));
+            return r;
+        }
 
-Quaternion& Quaternion::Normalize()
-{
-    float magnitude = xo_internal::QuaternionSquareSum(*this);
-    if (CloseEnough(magnitude, 1.0f, Epsilon))
-    {
-        return *this;
+        const Matrix* palette;
+    };
+
+    // Reads and writes wide::Width vertices of Vector3Streams. Streams are padded to whole blocks, so the last block is 
+    // read and written whole whatever the count.
+    struct SkinningStreams {
+        _XOINL wide::Float3 Load(size_t i, size_t /*lanes*/) const {
+            return wide::Load(in->X() + i, in->Y() + i, in->Z() + i);
+        }
+        _XOINL void Store(size_t i, size_t /*lanes*/, const wide::Float3& v) const {
+            wide::Store(out->X() + i, out->Y() + i, out->Z() + i, v);
+        }
+        const Vector3Stream* in;
+        Vector3Stream* out;
+    };
+
+    // Reads and writes wide::Width vertices of interleaved Vector3 arrays, transposing them on the way. A partial last 
+    // block goes through a copy rather than past the end of the arrays.
+    struct SkinningArrays {
+        _XOINL wide::Float3 Load(size_t i, size_t lanes) const {
+#if defined(XO_SSE)
+            if (lanes == (size_t)wide::Width) {
+                wide::Float3 v;
+                wide::Float w;
+                wide::LoadTransposed4(&in[i].x, 4, v.x, v.y, v.z, w);
+                return v;
+            }
+#endif
+            _XOSIMDALIGN32 float x[wide::Width] = { }, y[wide::Width] = { }, z[wide::Width] = { };
+            for (size_t lane = 0; lane < lanes; ++lane) {
+                x[lane] = in[i + lane].x;
+                y[lane] = in[i + lane].y;
+                z[lane] = in[i + lane].z;
+            }
+            return wide::Load(x, y, z);
+        }
+        _XOINL void Store(size_t i, size_t lanes, const wide::Float3& v) const {
+#if defined(XO_SSE)
+            if (lanes == (size_t)wide::Width) {
+                wide::StoreTransposed4(&out[i].x, 4, v.x, v.y, v.z, wide::Zero());
+                return;
+            }
+#endif
+            _XOSIMDALIGN32 float x[wide::Width], y[wide::Width], z[wide::Width];
+            wide::Store(x, y, z, v);
+            for (size_t lane = 0; lane < lanes; ++lane) {
+                out[i + lane].x = x[lane];
+                out[i + lane].y = y[lane];
+                out[i + lane].z = z[lane];
+            }
+        }
+        const Vector3* in;
+        Vector3* out;
+    };
+
+    // Skins vertices begin to end: the bones of each vertex are blended in place, the blends of wide::Width vertices 
+    // transposed into one register per component, then applied to the positions and, when given, the normals.
+    template <class Skin, class IO>
+    void SkinningKernel(const Skin& skin, const uint16_t* boneIndices, const float* boneWeights, 
+                        const IO& positions, const IO* normals, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i += wide::Width) {
+            const size_t lanes = _XO_MIN(end - i, (size_t)wide::Width);
+            _XOSIMDALIGN32 float blended[wide::Width * Skin::Floats];
+            for (size_t lane = 0; lane < (size_t)wide::Width; ++lane) {
+                if (lane < lanes) {
+                    const size_t v = (i + lane) * Skinning::Influences;
+                    skin.Blend(boneIndices + v, boneWeights + v, blended + lane * Skin::Floats);
+                }
+                else {
+                    skin.Padding(blended + lane * Skin::Floats);
+                }
+            }
+            typename Skin::Lanes l;
+            skin.Load(blended, l);
+            positions.Store(i, lanes, skin.Point(l, positions.Load(i, lanes)));
+            if (normals) {
+                normals->Store(i, lanes, skin.Direction(l, normals->Load(i, lanes)));
+            }
+        }
     }
 
-    magnitude = Sqrt(magnitude);
-    if (CloseEnough(magnitude, 0.0f, Epsilon))
-    {
-        return *this;
+    template <class Skin>
+    void SkinningStreamsRun(const Skin& skin, const uint16_t* boneIndices, const float* boneWeights, 
+                            const Vector3Stream& positions, const Vector3Stream* normals, 
+                            Vector3Stream& outPositions, Vector3Stream* outNormals, unsigned threadCount) {
+        XO_ASSERT(!normals || normals->Size() == positions.Size(), "xo-math Skinning normals and positions differ in size.");
+        const size_t count = positions.Size();
+        outPositions.Resize(count);
+        if (outNormals) {
+            outNormals->Resize(count);
+        }
+        const SkinningStreams p = { &positions, &outPositions }, n = { normals, outNormals };
+        SkinningRun(count, threadCount, [&](size_t begin, size_t end) {
+            SkinningKernel(skin, boneIndices, boneWeights, p, normals ? &n : nullptr, begin, end);
+        });
     }
 
-    (*(Vector4*)this) /= magnitude;
-    return *this;
+    template <class Skin>
+    void SkinningArraysRun(const Skin& skin, const uint16_t* boneIndices, const float* boneWeights, 
+                           const Vector3* positions, const Vector3* normals, 
+                           Vector3* outPositions, Vector3* outNormals, size_t count, unsigned threadCount) {
+        XO_ASSERT(!normals == !outNormals, "xo-math Skinning normals and outNormals must both be given or both be null.");
+        const SkinningArrays p = { positions, outPositions }, n = { normals, outNormals };
+        SkinningRun(count, threadCount, [&](size_t begin, size_t end) {
+            SkinningKernel(skin, boneIndices, boneWeights, p, normals ? &n : nullptr, begin, end);
+        });
+    }
 }
 
-Quaternion Quaternion::Conjugate() const
-{
-    return Quaternion(*this).MakeConjugate();
+void Skinning::DualQuaternionBlend(const DualQuaternion* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                                   const Vector3Stream& positions, const Vector3Stream& normals, 
+                                   Vector3Stream& outPositions, Vector3Stream& outNormals, unsigned threadCount) {
+    const SkinningDualQuaternions skin = { palette };
+    SkinningStreamsRun(skin, boneIndices, boneWeights, positions, &normals, outPositions, &outNormals, threadCount);
 }
 
-Quaternion& Quaternion::MakeConjugate()
-{
-    _XO_ASSIGN_QUAT(w, -x, -y, -z);
-    return *this;
+void Skinning::DualQuaternionBlend(const DualQuaternion* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                                   const Vector3Stream& positions, Vector3Stream& outPositions, unsigned threadCount) {
+    const SkinningDualQuaternions skin = { palette };
+    SkinningStreamsRun(skin, boneIndices, boneWeights, positions, nullptr, outPositions, nullptr, threadCount);
 }
 
-void Quaternion::GetAxisAngleRadians(Vector3& axis, float& radians) const
-{
-    Quaternion q = Normalized();
-
-#if defined(XO_SSE)
-    // todo: don't we need to normalize axis in sse too?
-    axis.xmm = q.xmm;
-#else
-    axis.x = q.x;
-    axis.y = q.y;
-    axis.z = q.z;
-    axis.Normalize();
-#endif
-    radians = (2.0f * ACos(q.w));
+void Skinning::DualQuaternionBlend(const DualQuaternion* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                                   const Vector3* positions, const Vector3* normals, Vector3* outPositions, Vector3* outNormals, 
+                                   size_t count, unsigned threadCount) {
+    const SkinningDualQuaternions skin = { palette };
+    SkinningArraysRun(skin, boneIndices, boneWeights, positions, normals, outPositions, outNormals, count, threadCount);
 }
 
-void Quaternion::RotationRadians(float x, float y, float z, Quaternion& outQuat)
-{
-    RotationRadians(Vector3(x, y, z), outQuat);
+void Skinning::LinearBlend(const Matrix3x4* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                           const Vector3Stream& positions, const Vector3Stream& normals, 
+                           Vector3Stream& outPositions, Vector3Stream& outNormals, unsigned threadCount) {
+    const SkinningMatrices<Matrix3x4> skin = { palette };
+    SkinningStreamsRun(skin, boneIndices, boneWeights, positions, &normals, outPositions, &outNormals, threadCount);
 }
 
-void Quaternion::RotationRadians(const Vector3& v, Quaternion& outQuat)
-{
-    Vector3 hv = v * 0.5f;
-    _XOSIMDALIGN float s[3];
-    _XOSIMDALIGN float c[3];
-    SinCos_x3(hv.f, s, c);
+void Skinning::LinearBlend(const Matrix3x4* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                           const Vector3Stream& positions, Vector3Stream& outPositions, unsigned threadCount) {
+    const SkinningMatrices<Matrix3x4> skin = { palette };
+    SkinningStreamsRun(skin, boneIndices, boneWeights, positions, nullptr, outPositions, nullptr, threadCount);
+}
 
-    _XO_ASSIGN_QUAT_Q(outQuat,
-                      c[0] * c[1] * c[2] + s[0] * s[1] * s[2],
-                      s[0] * c[1] * c[2] - c[0] * s[1] * s[2],
-                      c[0] * s[1] * c[2] + s[0] * c[1] * s[2],
-                      c[0] * c[1] * s[2] - s[0] * s[1] * c[2]);
+void Skinning::LinearBlend(const Matrix3x4* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                           const Vector3* positions, const Vector3* normals, Vector3* outPositions, Vector3* outNormals, 
+                           size_t count, unsigned threadCount) {
+    const SkinningMatrices<Matrix3x4> skin = { palette };
+    SkinningArraysRun(skin, boneIndices, boneWeights, positions, normals, outPositions, outNormals, count, threadCount);
 }
 
-void Quaternion::AxisAngleRadians(const Vector3& axis, float radians, Quaternion& outQuat)
-{
-    float hr = radians * 0.5f;
-    float sr = Sin(hr);
+void Skinning::LinearBlend(const Matrix4x4* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                           const Vector3Stream& positions, const Vector3Stream& normals, 
+                           Vector3Stream& outPositions, Vector3Stream& outNormals, unsigned threadCount) {
+    const SkinningMatrices<Matrix4x4> skin = { palette };
+    SkinningStreamsRun(skin, boneIndices, boneWeights, positions, &normals, outPositions, &outNormals, threadCount);
+}
 
-    Vector3 n = axis.Normalized();
-    n *= sr;
-    _XO_ASSIGN_QUAT_Q(outQuat, Cos(radians), n.x, n.y, n.z);
+void Skinning::LinearBlend(const Matrix4x4* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                           const Vector3Stream& positions, Vector3Stream& outPositions, unsigned threadCount) {
+    const SkinningMatrices<Matrix4x4> skin = { palette };
+    SkinningStreamsRun(skin, boneIndices, boneWeights, positions, nullptr, outPositions, nullptr, threadCount);
 }
 
-void Quaternion::LookAtFromPosition(const Vector3& from, const Vector3& to, const Vector3& up, Quaternion& outQuat)
-{
-    LookAtFromDirection(to - from, up, outQuat);
+void Skinning::LinearBlend(const Matrix4x4* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                           const Vector3* positions, const Vector3* normals, Vector3* outPositions, Vector3* outNormals, 
+                           size_t count, unsigned threadCount) {
+    const SkinningMatrices<Matrix4x4> skin = { palette };
+    SkinningArraysRun(skin, boneIndices, boneWeights, positions, normals, outPositions, outNormals, count, threadCount);
 }
 
-void Quaternion::LookAtFromPosition(const Vector3& from, const Vector3& to, Quaternion& outQuat)
+
+////////////////////////////////////////////////////////////////////////// SpatialHashGrid.cpp
+
+namespace
 {
-    LookAtFromPosition(from, to, Vector3::Up, outQuat);
+    // Each thread gets at least this many points.
+    const size_t GridThreadShare = 1 << 14;
+    // The table has a bucket per point, rounded up to a power of two, and never fewer than this.
+    const size_t GridMinBuckets = 16;
+    // Queries over up to this many cells track the buckets they've seen on the stack.
+    const size_t GridStackCells = 64;
+    // Cell coordinates are clamped to this, so far away points don't overflow an int.
+    const float GridMaxCell = 1073741824.0f;
+
+    // The cell coordinate of f, already divided by the cell size: floor(f).
+    _XOINL int GridCell(float f) {
+        f = _XO_MIN(_XO_MAX(f, -GridMaxCell), GridMaxCell);
+        const int i = (int)f;
+        return i - (f < (float)i ? 1 : 0);
+    }
+
+    struct GridArrayPoints {
+        const Vector3* points;
+        float X(size_t i) const { return points[i].x; }
+        float Y(size_t i) const { return points[i].y; }
+        float Z(size_t i) const { return points[i].z; }
+    };
+
+    struct GridStreamPoints {
+        const float* x;
+        const float* y;
+        const float* z;
+        float X(size_t i) const { return x[i]; }
+        float Y(size_t i) const { return y[i]; }
+        float Z(size_t i) const { return z[i]; }
+    };
+
+    // Writes the points from begin to end that are within the radius of the center, wide::Width at a time. The arrays 
+    // are padded, so the last group is loaded whole and its lanes past end are dropped.
+    size_t GridTestRange(const float* x, const float* y, const float* z, const uint32_t* indices, size_t begin, size_t end, 
+                         wide::Float centerX, wide::Float centerY, wide::Float centerZ, wide::Float radiusSquared, uint32_t* outIndices) {
+        using namespace wide;
+        size_t found = 0;
+        for (size_t i = begin; i < end; i += Width) {
+            const Float dx = Sub(LoadUnaligned(x + i), centerX);
+            const Float dy = Sub(LoadUnaligned(y + i), centerY);
+            const Float dz = Sub(LoadUnaligned(z + i), centerZ);
+            int bits = MoveMask(CmpLe(MulAdd(dz, dz, MulAdd(dy, dy, Mul(dx, dx))), radiusSquared));
+            if (end - i < (size_t)Width) {
+                bits &= LaneBits((int)(end - i));
+            }
+            // Every lane up to the last one found is written without a branch, and only kept when it's inside. Which 
+            // lanes are inside is random, so branching on each costs more than the extra writes. None of the writes 
+            // pass the last point found.
+            for (int lane = 0; bits; ++lane, bits >>= 1) {
+                outIndices[found] = indices[i + lane];
+                found += bits & 1;
+            }
+        }
+        return found;
+    }
 }
 
-void Quaternion::LookAtFromDirection(const Vector3&, const Vector3&, Quaternion&)
+SpatialHashGrid::SpatialHashGrid() : 
+    x(nullptr), y(nullptr), z(nullptr), indices(nullptr), pointBuckets(nullptr), bucketStarts(nullptr), threadCounts(nullptr), 
+    pointCapacity(0), bucketCapacity(0), threadCountsCapacity(0), pointCount(0), bucketCount(0), cellSize(1.0f), inverseCellSize(1.0f)
 {
-    // Todo
 }
 
-void Quaternion::LookAtFromDirection(const Vector3& direction, Quaternion& outQuat)
-{
-    LookAtFromDirection(direction, Vector3::Up, outQuat);
+SpatialHashGrid::SpatialHashGrid(const SpatialHashGrid& grid) : SpatialHashGrid() {
+    *this = grid;
 }
 
-void Quaternion::Slerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat)
-{
-    //      The folowing copyright and licence applies to the contents of this Quaternion::Slerp method
+SpatialHashGrid::SpatialHashGrid(SpatialHashGrid&& grid) : SpatialHashGrid() {
+    *this = std::move(grid);
+}
 
-    //      Copyright 2013 BlackBerry Inc.
-    //      Licensed under the Apache License, Version 2.0 (the "License");
-    //      you may not use this file except in compliance with the License.
-    //      You may obtain a copy of the License at
-    //      http://www.apache.org/licenses/LICENSE-2.0
-    //      Unless required by applicable law or agreed to in writing, software
-    //      distributed under the License is distributed on an "AS IS" BASIS,
-    //      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
-    //      See the License for the specific language governing permissions and
-    //      limitations under the License.
+SpatialHashGrid::~SpatialHashGrid() {
+    Release();
+}
 
-    //      Original file from GamePlay3D: http://gameplay3d.org
+SpatialHashGrid& SpatialHashGrid::operator = (const SpatialHashGrid& grid) {
+    if (this != &grid) {
+        Reserve(grid.pointCount, grid.bucketCount, 0);
+        pointCount = grid.pointCount;
+        bucketCount = grid.bucketCount;
+        cellSize = grid.cellSize;
+        inverseCellSize = grid.inverseCellSize;
+        if (pointCount) {
+            memcpy(x, grid.x, pointCount * sizeof(float));
+            memcpy(y, grid.y, pointCount * sizeof(float));
+            memcpy(z, grid.z, pointCount * sizeof(float));
+            memcpy(indices, grid.indices, pointCount * sizeof(uint32_t));
+        }
+        if (bucketCount) {
+            memcpy(bucketStarts, grid.bucketStarts, (bucketCount + 1) * sizeof(uint32_t));
+        }
+    }
+    return *this;
+}
 
-    //      Modified by Jared Thomson in 2016:
-    //        - removed assertions
-    //        - made compatable with xo-math
+SpatialHashGrid& SpatialHashGrid::operator = (SpatialHashGrid&& grid) {
+    if (this != &grid) {
+        Release();
+        x = grid.x;
+        y = grid.y;
+        z = grid.z;
+        indices = grid.indices;
+        pointBuckets = grid.pointBuckets;
+        bucketStarts = grid.bucketStarts;
+        threadCounts = grid.threadCounts;
+        pointCapacity = grid.pointCapacity;
+        bucketCapacity = grid.bucketCapacity;
+        threadCountsCapacity = grid.threadCountsCapacity;
+        pointCount = grid.pointCount;
+        bucketCount = grid.bucketCount;
+        cellSize = grid.cellSize;
+        inverseCellSize = grid.inverseCellSize;
+        grid.x = grid.y = grid.z = nullptr;
+        grid.indices = grid.pointBuckets = grid.bucketStarts = grid.threadCounts = nullptr;
+        grid.pointCapacity = grid.bucketCapacity = grid.threadCountsCapacity = grid.pointCount = grid.bucketCount = 0;
+    }
+    return *this;
+}
 
-    // Fast slerp implementation by kwhatmough:
-    // It contains no division operations, no trig, no inverse trig
-    // and no sqrt. Not only does this code tolerate small constraint
-    // errors in the input quaternions, it actually corrects for them.
-    if (CloseEnough(t, 0.0f))
-    {
-        outQuat = a;
-        return;
+uint32_t SpatialHashGrid::Bucket(int x, int y, int z) const {
+    // Each coordinate times a large odd constant, then the finishing mix of MurmurHash3 so the low bits the table uses 
+    // depend on every bit. The well known xor of three primes puts whole runs of nearby cells in one bucket.
+    uint32_t hash = (uint32_t)x * 0x8da6b343u + (uint32_t)y * 0xd8163841u + (uint32_t)z * 0xcb1ab31fu;
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+    return hash & (uint32_t)(bucketCount - 1);
+}
+
+void SpatialHashGrid::Reserve(size_t points, size_t buckets, unsigned threads) {
+    // room for a whole group past the last point, rounded up to keep each array aligned.
+    const size_t paddedPoints = (points + wide::Width + 15) & ~(size_t)15;
+    if (paddedPoints > pointCapacity) {
+        if (x) {
+            XO_ALIGNED_FREE(x);
+        }
+        x = (float*)XO_ALIGNED_MALLOC(paddedPoints * 5 * sizeof(float), 64);
+        y = x + paddedPoints;
+        z = y + paddedPoints;
+        indices = (uint32_t*)(z + paddedPoints);
+        pointBuckets = indices + paddedPoints;
+        pointCapacity = paddedPoints;
     }
-    else if (CloseEnough(t, 1.0f))
-    {
-        outQuat = b;
-        return;
+    if (buckets + 1 > bucketCapacity) {
+        if (bucketStarts) {
+            XO_ALIGNED_FREE(bucketStarts);
+        }
+        bucketStarts = (uint32_t*)XO_ALIGNED_MALLOC((buckets + 1) * sizeof(uint32_t), 64);
+        bucketCapacity = buckets + 1;
     }
-    else if (a == b)
-    {
-        outQuat = a;
+    if (buckets * threads > threadCountsCapacity) {
+        if (threadCounts) {
+            XO_ALIGNED_FREE(threadCounts);
+        }
+        threadCounts = (uint32_t*)XO_ALIGNED_MALLOC(buckets * threads * sizeof(uint32_t), 64);
+        threadCountsCapacity = buckets * threads;
     }
-    else
-    {
-        float halfY, alpha, beta;
-        float u, f1, f2a, f2b;
-        float ratio1, ratio2;
-        float halfSecHalfTheta, versHalfTheta;
-        float sqNotU, sqU;
-
-        Vector4 * va = (Vector4*)&a;
-        Vector4 * vb = (Vector4*)&b;
-
-        float cosTheta = ((*va) * (*vb)).Sum();
-
-        // As usual in all slerp implementations, we fold theta.
-        alpha = cosTheta >= 0 ? 1.0f : -1.0f;
-        halfY = 1.0f + alpha * cosTheta;
-
-        // Here we bisect the interval, so we need to fold t as well.
-        f2b = t - 0.5f;
-        u = f2b >= 0 ? f2b : -f2b;
-        f2a = u - f2b;
-        f2b += u;
-        u += u;
-        f1 = 1.0f - u;
+}
 
-        // One iteration of Newton to get 1-cos(theta / 2) to good accuracy.
-        halfSecHalfTheta = 1.09f - (0.476537f - 0.0903321f * halfY) * halfY;
-        halfSecHalfTheta *= 1.5f - halfY * halfSecHalfTheta * halfSecHalfTheta;
-        versHalfTheta = 1.0f - halfY * halfSecHalfTheta;
+void SpatialHashGrid::Release() {
+    if (x) {
+        XO_ALIGNED_FREE(x);
+    }
+    if (bucketStarts) {
+        XO_ALIGNED_FREE(bucketStarts);
+    }
+    if (threadCounts) {
+        XO_ALIGNED_FREE(threadCounts);
+    }
+    x = y = z = nullptr;
+    indices = pointBuckets = bucketStarts = threadCounts = nullptr;
+    pointCapacity = bucketCapacity = threadCountsCapacity = pointCount = bucketCount = 0;
+}
 
-        // Evaluate series expansions of the coefficients.
-        sqNotU = f1 * f1;
-        ratio2 = 0.0000440917108f * versHalfTheta;
-        ratio1 = -0.00158730159f + (sqNotU - 16.0f) * ratio2;
-        ratio1 = 0.0333333333f + ratio1 * (sqNotU - 9.0f) * versHalfTheta;
-        ratio1 = -0.333333333f + ratio1 * (sqNotU - 4.0f) * versHalfTheta;
-        ratio1 = 1.0f + ratio1 * (sqNotU - 1.0f) * versHalfTheta;
+void SpatialHashGrid::Clear() {
+    pointCount = bucketCount = 0;
+}
 
-        sqU = u * u;
-        ratio2 = -0.00158730159f + (sqU - 16.0f) * ratio2;
-        ratio2 = 0.0333333333f + ratio2 * (sqU - 9.0f) * versHalfTheta;
-        ratio2 = -0.333333333f + ratio2 * (sqU - 4.0f) * versHalfTheta;
-        ratio2 = 1.0f + ratio2 * (sqU - 1.0f) * versHalfTheta;
+template <class Points>
+void SpatialHashGrid::BuildPoints(const Points& points, size_t count, float cellSize, unsigned threadCount) {
+    XO_ASSERT(cellSize > 0.0f, "xo-math SpatialHashGrid::Build cell size must be positive.");
+    XO_ASSERT(count < 0xffffffffu, "xo-math SpatialHashGrid::Build too many points for 32 bit indices.");
+    size_t buckets = GridMinBuckets;
+    while (buckets < count) {
+        buckets <<= 1;
+    }
+    const unsigned threads = xo_internal::ThreadCount(threadCount, count, GridThreadShare);
+    Reserve(count, buckets, threads);
+    pointCount = count;
+    bucketCount = buckets;
+    this->cellSize = cellSize;
+    inverseCellSize = 1.0f / cellSize;
+
+    // A counting sort split between the threads. Each thread counts the points of its share per bucket, then the 
+    // buckets are split between the threads to find where each thread's points of each bucket go. The points of a 
+    // bucket end up in input order, whatever the number of threads.
+    const size_t share = (count + threads - 1) / threads;
+    const size_t bucketShare = (buckets + threads - 1) / threads;
+    size_t rangeStarts[xo_internal::MaxThreads];
+    xo_internal::Parallel(threads, [&](unsigned t) {
+        uint32_t* counts = threadCounts + t * buckets;
+        memset(counts, 0, buckets * sizeof(uint32_t));
+        const size_t end = _XO_MIN(share * (t + 1), count);
+        for (size_t i = share * t; i < end; ++i) {
+            const uint32_t bucket = Bucket(GridCell(points.X(i) * inverseCellSize), GridCell(points.Y(i) * inverseCellSize), 
+                                           GridCell(points.Z(i) * inverseCellSize));
+            pointBuckets[i] = bucket;
+            ++counts[bucket];
+        }
+    });
+    xo_internal::Parallel(threads, [&](unsigned t) {
+        size_t total = 0;
+        const size_t end = _XO_MIN(bucketShare * (t + 1), buckets);
+        for (size_t b = bucketShare * t; b < end; ++b) {
+            for (unsigned u = 0; u < threads; ++u) {
+                total += threadCounts[u * buckets + b];
+            }
+        }
+        rangeStarts[t] = total;
+    });
+    size_t start = 0;
+    for (unsigned t = 0; t < threads; ++t) {
+        const size_t total = rangeStarts[t];
+        rangeStarts[t] = start;
+        start += total;
+    }
+    xo_internal::Parallel(threads, [&](unsigned t) {
+        uint32_t next = (uint32_t)rangeStarts[t];
+        const size_t end = _XO_MIN(bucketShare * (t + 1), buckets);
+        for (size_t b = bucketShare * t; b < end; ++b) {
+            bucketStarts[b] = next;
+            for (unsigned u = 0; u < threads; ++u) {
+                const uint32_t counted = threadCounts[u * buckets + b];
+                threadCounts[u * buckets + b] = next;
+                next += counted;
+            }
+        }
+    });
+    bucketStarts[buckets] = (uint32_t)count;
+    xo_internal::Parallel(threads, [&](unsigned t) {
+        uint32_t* next = threadCounts + t * buckets;
+        const size_t end = _XO_MIN(share * (t + 1), count);
+        for (size_t i = share * t; i < end; ++i) {
+            const uint32_t to = next[pointBuckets[i]]++;
+            x[to] = points.X(i);
+            y[to] = points.Y(i);
+            z[to] = points.Z(i);
+            indices[to] = (uint32_t)i;
+        }
+    });
+}
 
-        // Perform the bisection and resolve the folding done earlier.
-        f1 *= ratio1 * halfSecHalfTheta;
-        f2a *= ratio2;
-        f2b *= ratio2;
-        alpha *= f1 + f2a;
-        beta = f1 + f2b;
+void SpatialHashGrid::Build(const Vector3* points, size_t count, float cellSize, unsigned threadCount) {
+    const GridArrayPoints array = { points };
+    BuildPoints(array, count, cellSize, threadCount);
+}
 
-        // Apply final coefficients to a and b as usual.
-        float w = alpha * a.w + beta * b.w;
-        float x = alpha * a.x + beta * b.x;
-        float y = alpha * a.y + beta * b.y;
-        float z = alpha * a.z + beta * b.z;
+void SpatialHashGrid::Build(const Vector3Stream& points, float cellSize, unsigned threadCount) {
+    const GridStreamPoints stream = { points.X(), points.Y(), points.Z() };
+    BuildPoints(stream, points.Size(), cellSize, threadCount);
+}
 
-        // This final adjustment to the quaternion's length corrects for
-        // any small constraint error in the inputs q1 and q2 But as you
-        // can see, it comes at the cost of 9 additional multiplication
-        // operations. If this error-correcting feature is not required,
-        // the following code may be removed.
-        f1 = 1.5f - 0.5f * (w * w + x * x + y * y + z * z);
-        _XO_ASSIGN_QUAT_Q(outQuat, w * f1, x * f1, y * f1, z * f1);
+size_t SpatialHashGrid::QueryRadius(const Vector3& center, float radius, uint32_t* outIndices, uint32_t* scratch) const {
+    if (pointCount == 0 || !(radius >= 0.0f)) {
+        return 0;
+    }
+    const wide::Float centerX = wide::Set(center.x), centerY = wide::Set(center.y), centerZ = wide::Set(center.z);
+    const wide::Float radiusSquared = wide::Set(radius * radius);
+    const int lowX = GridCell((center.x - radius) * inverseCellSize), highX = GridCell((center.x + radius) * inverseCellSize);
+    const int lowY = GridCell((center.y - radius) * inverseCellSize), highY = GridCell((center.y + radius) * inverseCellSize);
+    const int lowZ = GridCell((center.z - radius) * inverseCellSize), highZ = GridCell((center.z + radius) * inverseCellSize);
+    const double cells = ((double)highX - lowX + 1.0) * ((double)highY - lowY + 1.0) * ((double)highZ - lowZ + 1.0);
+    // once the cells outnumber the buckets by this much, testing every point is quicker than finding the buckets.
+    if (cells * 8.0 >= (double)bucketCount) {
+        return GridTestRange(x, y, z, indices, 0, pointCount, centerX, centerY, centerZ, radiusSquared, outIndices);
     }
-}
 
-void Quaternion::Lerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat)
-{
-    Vector4& vq = (Vector4&)outQuat;
-    const Vector4& va = a;
-    const Vector4& vb = b;
-    // Todo: give the vectors the same static 'outQuat' type interface, then just use the Vector4::Lerp for this lerp
-    vq = va + (vb - va) * t;
+    // Cells that hash to the same bucket must only have it tested once. Few cells are checked against each other, 
+    // many against a bit per bucket. The caller's scratch is cleared again once the query is done.
+    uint32_t seenBuckets[GridStackCells];
+    size_t seenCount = 0;
+    uint32_t* seen = nullptr;
+    if (cells > GridStackCells) {
+        if (scratch) {
+            seen = scratch;
+        }
+        else {
+            const size_t bytes = QueryScratchSize() * sizeof(uint32_t);
+            seen = (uint32_t*)XO_ALIGNED_MALLOC(bytes, 64);
+            memset(seen, 0, bytes);
+        }
+    }
+    size_t found = 0;
+    for (int cz = lowZ; cz <= highZ; ++cz) {
+        for (int cy = lowY; cy <= highY; ++cy) {
+            for (int cx = lowX; cx <= highX; ++cx) {
+                const uint32_t bucket = Bucket(cx, cy, cz);
+                const uint32_t begin = bucketStarts[bucket], end = bucketStarts[bucket + 1];
+                if (begin == end) {
+                    continue;
+                }
+                if (seen) {
+                    if (seen[bucket >> 5] & (1u << (bucket & 31))) {
+                        continue;
+                    }
+                    seen[bucket >> 5] |= 1u << (bucket & 31);
+                }
+                else {
+                    size_t s = 0;
+                    while (s < seenCount && seenBuckets[s] != bucket) {
+                        ++s;
+                    }
+                    if (s < seenCount) {
+                        continue;
+                    }
+                    seenBuckets[seenCount++] = bucket;
+                }
+                found += GridTestRange(x, y, z, indices, begin, end, centerX, centerY, centerZ, radiusSquared, outIndices + found);
+            }
+        }
+    }
+    if (seen && !scratch) {
+        XO_ALIGNED_FREE(seen);
+    }
+    else if (seen) {
+        for (int cz = lowZ; cz <= highZ; ++cz) {
+            for (int cy = lowY; cy <= highY; ++cy) {
+                for (int cx = lowX; cx <= highX; ++cx) {
+                    const uint32_t bucket = Bucket(cx, cy, cz);
+                    seen[bucket >> 5] &= ~(1u << (bucket & 31));
+                }
+            }
+        }
+    }
+    return found;
 }
 
 
@@ -1329,6 +6180,332 @@ namespace sse {
 #endif
 
 
+////////////////////////////////////////////////////////////////////////// Transform.cpp
+
+const Transform Transform::Identity(Vector3(0.0f, 0.0f, 0.0f), Quaternion(0.0f, 0.0f, 0.0f, 1.0f), Vector3(1.0f, 1.0f, 1.0f));
+
+namespace
+{
+    // wide::Width transforms, one register per component. The w lanes of the translation and scale are loaded along 
+    // with everything else when compiled for SSE and are otherwise unused.
+    struct TransformLanes {
+        wide::Float tx, ty, tz, tw;
+        wide::Float qx, qy, qz, qw;
+        wide::Float sx, sy, sz, sw;
+    };
+
+    _XOCONSTEXPR const size_t TransformStride = sizeof(Transform) / sizeof(float);
+
+    _XOINL void TransformLoad(const Transform* t, TransformLanes& l) {
+#if defined(XO_SSE)
+        wide::LoadTransposed4(&t->translation.x, TransformStride, l.tx, l.ty, l.tz, l.tw);
+        wide::LoadTransposed4(&t->rotation.x, TransformStride, l.qx, l.qy, l.qz, l.qw);
+        wide::LoadTransposed4(&t->scale.x, TransformStride, l.sx, l.sy, l.sz, l.sw);
+#else
+        // Without SSE a Vector3 is three floats, so there's no fourth to load through.
+        l.tx = t->translation.x; l.ty = t->translation.y; l.tz = t->translation.z;
+        l.qx = t->rotation.x; l.qy = t->rotation.y; l.qz = t->rotation.z; l.qw = t->rotation.w;
+        l.sx = t->scale.x; l.sy = t->scale.y; l.sz = t->scale.z;
+#endif
+    }
+
+    // The three rows of the matrix of wide::Width transforms: the rotation matrix with each column multiplied by its 
+    // scale, and the translation in the fourth column.
+    _XOINL void TransformRows(const TransformLanes& l, wide::Float r[12]) {
+        using namespace wide;
+        const Float two = Set(2.0f), one = Set(1.0f);
+        const Float x2 = Mul(l.qx, two), y2 = Mul(l.qy, two), z2 = Mul(l.qz, two);
+        const Float xx = Mul(l.qx, x2), yy = Mul(l.qy, y2), zz = Mul(l.qz, z2);
+        const Float xy = Mul(l.qx, y2), xz = Mul(l.qx, z2), yz = Mul(l.qy, z2);
+        const Float wx = Mul(l.qw, x2), wy = Mul(l.qw, y2), wz = Mul(l.qw, z2);
+        r[0] = Mul(Sub(one, Add(yy, zz)), l.sx);
+        r[1] = Mul(Sub(xy, wz), l.sy);
+        r[2] = Mul(Add(xz, wy), l.sz);
+        r[3] = l.tx;
+        r[4] = Mul(Add(xy, wz), l.sx);
+        r[5] = Mul(Sub(one, Add(xx, zz)), l.sy);
+        r[6] = Mul(Sub(yz, wx), l.sz);
+        r[7] = l.ty;
+        r[8] = Mul(Sub(xz, wy), l.sx);
+        r[9] = Mul(Add(yz, wx), l.sy);
+        r[10] = Mul(Sub(one, Add(xx, yy)), l.sz);
+        r[11] = l.tz;
+    }
+
+    // Stores wide::Width matrices of rowCount rows each, stride floats apart, writing rows 0 to 2 from r and 
+    // 0, 0, 0, 1 to the fourth when there is one.
+    _XOINL void TransformStoreRows(float* f, size_t stride, int rowCount, const wide::Float r[12]) {
+        wide::StoreTransposed4(f, stride, r[0], r[1], r[2], r[3]);
+        wide::StoreTransposed4(f + 4, stride, r[4], r[5], r[6], r[7]);
+        wide::StoreTransposed4(f + 8, stride, r[8], r[9], r[10], r[11]);
+        if (rowCount == 4) {
+            wide::StoreTransposed4(f + 12, stride, wide::Zero(), wide::Zero(), wide::Zero(), wide::Set(1.0f));
+        }
+    }
+
+    // The top three rows of the matrix of t into m, four floats per row. As TransformRows for a single transform.
+    _XOINL void TransformToRows(const Transform& t, float* m) {
+        const Quaternion& q = t.rotation;
+        const float x2 = q.x * 2.0f, y2 = q.y * 2.0f, z2 = q.z * 2.0f;
+        const float xx = q.x * x2, yy = q.y * y2, zz = q.z * z2;
+        const float xy = q.x * y2, xz = q.x * z2, yz = q.y * z2;
+        const float wx = q.w * x2, wy = q.w * y2, wz = q.w * z2;
+        m[0] = (1.0f - (yy + zz)) * t.scale.x;
+        m[1] = (xy - wz) * t.scale.y;
+        m[2] = (xz + wy) * t.scale.z;
+        m[3] = t.translation.x;
+        m[4] = (xy + wz) * t.scale.x;
+        m[5] = (1.0f - (xx + zz)) * t.scale.y;
+        m[6] = (yz - wx) * t.scale.z;
+        m[7] = t.translation.y;
+        m[8] = (xz - wy) * t.scale.x;
+        m[9] = (yz + wx) * t.scale.y;
+        m[10] = (1.0f - (xx + yy)) * t.scale.z;
+        m[11] = t.translation.z;
+    }
+
+    template <class M>
+    _XOINL void TransformToMatrixArray(const Transform* transforms, M* outMatrices, size_t count) {
+        _XOCONSTEXPR const size_t stride = sizeof(M) / sizeof(float);
+        size_t i = 0;
+        for (; i + wide::Width <= count; i += wide::Width) {
+            TransformLanes l;
+            wide::Float r[12];
+            TransformLoad(transforms + i, l);
+            TransformRows(l, r);
+            TransformStoreRows(outMatrices[i].r[0].f, stride, (int)(stride / 4), r);
+        }
+        for (; i < count; ++i) {
+            transforms[i].ToMatrix(outMatrices[i]);
+        }
+    }
+}
+
+Transform::Transform() {
+}
+
+Transform::Transform(const Vector3& translation, const Quaternion& rotation, const Vector3& scale) :
+    translation(translation),
+    rotation(rotation),
+    scale(scale)
+{
+}
+
+Transform::Transform(const Vector3& translation, const Quaternion& rotation) :
+    translation(translation),
+    rotation(rotation),
+    scale(1.0f, 1.0f, 1.0f)
+{
+}
+
+Transform& Transform::MakeInverse() {
+#if defined(XO_SSE)
+    // The conjugate negates x, y and z. The scale is divided exactly rather than by the estimate Vector3 uses, with 
+    // its w lane kept finite.
+    const __m128 q = _mm_xor_ps(rotation.xmm, _mm_set_ps(0.0f, -0.0f, -0.0f, -0.0f));
+    const __m128 s = _mm_div_ps(_mm_set1_ps(1.0f), _mm_or_ps(_mm_and_ps(scale.xmm, _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1))), _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f)));
+    translation.xmm = _mm_mul_ps(s, xo_internal::TransformRotate(q, _mm_xor_ps(translation.xmm, _mm_set1_ps(-0.0f))));
+    rotation.xmm = q;
+    scale.xmm = s;
+#else
+    rotation.MakeConjugate();
+    scale = Vector3(1.0f / scale.x, 1.0f / scale.y, 1.0f / scale.z);
+    translation = scale * Rotate(rotation, -translation);
+#endif
+    return *this;
+}
+
+void Transform::ToMatrix(Matrix4x4& outMatrix) const {
+    TransformToRows(*this, outMatrix.m);
+    outMatrix.m30 = outMatrix.m31 = outMatrix.m32 = 0.0f;
+    outMatrix.m33 = 1.0f;
+}
+
+void Transform::ToMatrix(Matrix3x4& outMatrix) const {
+    TransformToRows(*this, outMatrix.m);
+}
+
+const Transform& Transform::TransformPoints(const Vector3* vecs, Vector3* outVecs, size_t count) const {
+    ToMatrix3x4().TransformPoints(vecs, outVecs, count);
+    return *this;
+}
+
+void Transform::MultiplyArray(const Transform* a, const Transform* b, Transform* outTransforms, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        Multiply(a[i], b[i], outTransforms[i]);
+    }
+}
+
+void Transform::MultiplyArray(const Transform& a, const Transform* b, Transform* outTransforms, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        Multiply(a, b[i], outTransforms[i]);
+    }
+}
+
+void Transform::ToMatrixArray(const Transform* transforms, Matrix4x4* outMatrices, size_t count) {
+    TransformToMatrixArray(transforms, outMatrices, count);
+}
+
+void Transform::ToMatrixArray(const Transform* transforms, Matrix3x4* outMatrices, size_t count) {
+    TransformToMatrixArray(transforms, outMatrices, count);
+}
+
+void Transform::Lerp(const Transform& a, const Transform& b, float t, Transform& outTransform) {
+    Quaternion rotation;
+    Quaternion::Nlerp(a.rotation, b.rotation, t, rotation);
+    outTransform.translation = a.translation + (b.translation - a.translation) * t;
+    outTransform.scale = a.scale + (b.scale - a.scale) * t;
+    outTransform.rotation = rotation;
+}
+
+void Transform::Slerp(const Transform& a, const Transform& b, float t, Transform& outTransform) {
+    Quaternion rotation;
+    Quaternion::Slerp(a.rotation, b.rotation, t, rotation);
+    outTransform.translation = a.translation + (b.translation - a.translation) * t;
+    outTransform.scale = a.scale + (b.scale - a.scale) * t;
+    outTransform.rotation = rotation;
+}
+
+
+////////////////////////////////////////////////////////////////////////// Triangle.cpp
+
+Vector3 Triangle::ClosestPoint(const Vector3& point) const {
+    // Tests the regions in turn from the corners outward, by the signs of dot products with the edges from v0 and the 
+    // barycentric areas they give.
+    const Vector3 ab = v1 - v0, ac = v2 - v0, ap = point - v0;
+    const float d1 = ab.Dot(ap), d2 = ac.Dot(ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) {
+        return v0;
+    }
+    const Vector3 bp = point - v1;
+    const float d3 = ab.Dot(bp), d4 = ac.Dot(bp);
+    if (d3 >= 0.0f && d4 <= d3) {
+        return v1;
+    }
+    const float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+        return v0 + ab * (d1 / (d1 - d3));
+    }
+    const Vector3 cp = point - v2;
+    const float d5 = ab.Dot(cp), d6 = ac.Dot(cp);
+    if (d6 >= 0.0f && d5 <= d6) {
+        return v2;
+    }
+    const float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+        return v0 + ac * (d2 / (d2 - d6));
+    }
+    const float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f) {
+        return v1 + (v2 - v1) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+    const float inverseArea = 1.0f / (va + vb + vc);
+    return v0 + ab * (vb * inverseArea) + ac * (vc * inverseArea);
+}
+
+void Triangle::ClosestPoints(const Vector3Stream& points, const Vector3Stream& v0, const Vector3Stream& v1, const Vector3Stream& v2, 
+                             Vector3Stream& outPoints, float* outDistancesSquared) {
+    XO_ASSERT(points.Size() == v0.Size() && points.Size() == v1.Size() && points.Size() == v2.Size(), 
+              "xo-math Triangle::ClosestPoints streams must be the same size.");
+    using namespace wide;
+    const size_t count = points.Size();
+    outPoints.Resize(count);
+    const Float zero = Zero(), one = wide::Set(1.0f);
+    for (size_t i = 0; i < count; i += Width) {
+        const Float3 p = Load(points.X() + i, points.Y() + i, points.Z() + i);
+        const Float3 a = Load(v0.X() + i, v0.Y() + i, v0.Z() + i);
+        const Float3 ab = Sub(Load(v1.X() + i, v1.Y() + i, v1.Z() + i), a);
+        const Float3 ac = Sub(Load(v2.X() + i, v2.Y() + i, v2.Z() + i), a);
+        const Float3 ap = Sub(p, a), bp = Sub(ap, ab), cp = Sub(ap, ac);
+        const Float d1 = Dot(ab, ap), d2 = Dot(ac, ap);
+        const Float d3 = Dot(ab, bp), d4 = Dot(ac, bp);
+        const Float d5 = Dot(ab, cp), d6 = Dot(ac, cp);
+        const Float va = NegMulAdd(d5, d4, Mul(d3, d6)), vb = NegMulAdd(d1, d6, Mul(d5, d2)), vc = NegMulAdd(d3, d2, Mul(d1, d4));
+        const Float d43 = Sub(d4, d3), d56 = Sub(d5, d6);
+
+        // The closest point is v0 + ab * v + ac * w in every region. Starting from the face, each region's weights 
+        // replace the last where its test holds, in reverse of the order Triangle::ClosestPoint tests them so the 
+        // same region wins. Weights of regions that don't apply may divide by zero, and are never selected.
+        const Float inverseArea = Div(one, Add(va, Add(vb, vc)));
+        Float v = Mul(vb, inverseArea), w = Mul(vc, inverseArea);
+        const Float onBC = And(CmpLe(va, zero), And(CmpGe(d43, zero), CmpGe(d56, zero)));
+        const Float tBC = Div(d43, Add(d43, d56));
+        v = Select(onBC, Sub(one, tBC), v);
+        w = Select(onBC, tBC, w);
+        const Float onAC = And(CmpLe(vb, zero), And(CmpGe(d2, zero), CmpLe(d6, zero)));
+        v = Select(onAC, zero, v);
+        w = Select(onAC, Div(d2, Sub(d2, d6)), w);
+        const Float atC = And(CmpGe(d6, zero), CmpLe(d5, d6));
+        v = Select(atC, zero, v);
+        w = Select(atC, one, w);
+        const Float onAB = And(CmpLe(vc, zero), And(CmpGe(d1, zero), CmpLe(d3, zero)));
+        v = Select(onAB, Div(d1, Sub(d1, d3)), v);
+        w = Select(onAB, zero, w);
+        const Float atB = And(CmpGe(d3, zero), CmpLe(d4, d3));
+        v = Select(atB, one, v);
+        w = Select(atB, zero, w);
+        const Float atA = And(CmpLe(d1, zero), CmpLe(d2, zero));
+        v = Select(atA, zero, v);
+        w = Select(atA, zero, w);
+
+        const Float3 closest = MulAdd(ac, w, MulAdd(ab, v, a));
+        Store(outPoints.X() + i, outPoints.Y() + i, outPoints.Z() + i, closest);
+        if (outDistancesSquared) {
+            const Float3 offset = Sub(p, closest);
+            if (i + Width <= count) {
+                StoreUnaligned(outDistancesSquared + i, Dot(offset, offset));
+            }
+            else {
+                StorePartial(outDistancesSquared + i, Dot(offset, offset), count - i);
+            }
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////// Trig.cpp
+
+namespace {
+    template <bool WantSin, bool WantCos>
+    _XOINL void SinCosFloats(const float* f, float* outSin, float* outCos, size_t count) {
+        using namespace wide;
+        Float s, c;
+        size_t i = 0;
+        const Float limit = Set(SinCosLimit);
+        for (; i + Width <= count; i += Width) {
+            const Float a = LoadUnaligned(f + i);
+            wide::SinCos(a, s, c);
+            if (WantSin) StoreUnaligned(outSin + i, s);
+            if (WantCos) StoreUnaligned(outCos + i, c);
+            if (const int large = MoveMask(CmpGt(wide::Abs(a), limit))) {
+                xo_internal::SinCosLargeLanes(f + i, WantSin ? outSin + i : nullptr, WantCos ? outCos + i : nullptr, large);
+            }
+        }
+        if (i < count) {
+            const Float a = LoadPartial(f + i, count - i);
+            wide::SinCos(a, s, c);
+            if (WantSin) StorePartial(outSin + i, s, count - i);
+            if (WantCos) StorePartial(outCos + i, c, count - i);
+            if (const int large = MoveMask(CmpGt(wide::Abs(a), limit))) {
+                xo_internal::SinCosLargeLanes(f + i, WantSin ? outSin + i : nullptr, WantCos ? outCos + i : nullptr, large);
+            }
+        }
+    }
+}
+
+void SinArray(const float* f, float* outSin, size_t count) {
+    SinCosFloats<true, false>(f, outSin, nullptr, count);
+}
+
+void CosArray(const float* f, float* outCos, size_t count) {
+    SinCosFloats<false, true>(f, nullptr, outCos, count);
+}
+
+void SinCosArray(const float* f, float* outSin, float* outCos, size_t count) {
+    SinCosFloats<true, true>(f, outSin, outCos, count);
+}
+
+
 ////////////////////////////////////////////////////////////////////////// Vector2.cpp
 
 #if defined(_XONOCONSTEXPR)
@@ -1633,8 +6810,8 @@ void Vector3::RotateRadians(const Vector3& v, const Vector3& axis, float angle,
     // Rodrigues' rotation formula
     // https://en.wikipedia.org/wiki/Rodrigues%27_rotation_formula
     Vector3 axv;
-    float sinAng = Sin(angle);
-    float cosAng = Cos(angle);
+    float sinAng, cosAng;
+    SinCos(angle, sinAng, cosAng);
     Vector3::Cross(axis, v, axv);
     float adv = Vector3::Dot(axis, v);
     outVec.Set(v * cosAng + axv * sinAng + axis * adv * (1.0f - cosAng));
@@ -1647,27 +6824,40 @@ float Vector3::AngleRadians(const Vector3& a, const Vector3& b) {
     return ATan2(Sqrt(cross.Sum()), Vector3::Dot(a, b));
 }
 
+namespace {
+    // The unit axis most nearly perpendicular to v, to cross with it. A fixed axis would be parallel to some v (either 
+    // way along it), leaving a zero cross product.
+    const Vector3& RandomHelperAxis(const Vector3& v) {
+        const float x = Abs(v.x), y = Abs(v.y), z = Abs(v.z);
+        return x <= y && x <= z ? Vector3::UnitX : (y <= z ? Vector3::UnitY : Vector3::UnitZ);
+    }
+}
+
 void Vector3::RandomInConeRadians(const Vector3& forward, float angle, Vector3& outVec) {
     Vector3 cross;
-    Vector3::Cross(forward, forward == Vector3::Up ? Vector3::Left : Vector3::Up, cross);
-    Vector3::RotateRadians(forward, cross, RandomRange(0.0f, angle*0.5f), outVec);
-    Vector3::RotateRadians(outVec, forward.Normalized(), RandomRange(0.0f, TAU), outVec);
+    RandomGenerator& rng = RandomGenerator::ThreadLocal();
+    Vector3::Cross(forward, RandomHelperAxis(forward), cross);
+    Vector3::RotateRadians(forward, cross, rng.Range(0.0f, angle*0.5f), outVec);
+    Vector3::RotateRadians(outVec, forward.Normalized(), rng.Range(0.0f, TAU), outVec);
 }
 
 void Vector3::RandomOnConeRadians(const Vector3& forward, float angle, Vector3& outVec) {
     Vector3 cross;
-    Vector3::Cross(forward, forward == Vector3::Up ? Vector3::Left : Vector3::Up, cross);
+    Vector3::Cross(forward, RandomHelperAxis(forward), cross);
     Vector3::RotateRadians(forward, cross, angle*0.5f, outVec);
-    Vector3::RotateRadians(outVec, forward.Normalized(), RandomRange(0.0f, TAU), outVec);
+    Vector3::RotateRadians(outVec, forward.Normalized(), RandomGenerator::ThreadLocal().Range(0.0f, TAU), outVec);
 }
 
 void Vector3::RandomOnSphere(float radius, Vector3& outVec) {
     // Marsaglia's method: https://projecteuclid.org/download/pdf_1/euclid.aoms/1177692644
+    RandomGenerator& rng = RandomGenerator::ThreadLocal();
     float x1, x2, x12, x22;
-    x1 = RandomRange(-1.0f, 1.0f);
-    x2 = RandomRange(-1.0f, 1.0f);
-    x12 = Square(x1);
-    x22 = Square(x1);
+    do {
+        x1 = rng.Range(-1.0f, 1.0f);
+        x2 = rng.Range(-1.0f, 1.0f);
+        x12 = Square(x1);
+        x22 = Square(x2);
+    } while (x12 + x22 >= 1.0f);
     outVec.Set(
         2.0f * x1 * Sqrt(1.0f - x12 - x22),
         2.0f * x2 * Sqrt(1.0f - x12 - x22),
@@ -1677,31 +6867,273 @@ void Vector3::RandomOnSphere(float radius, Vector3& outVec) {
 }
 
 void Vector3::RandomOnCube(float size, Vector3& outVec) {
-    switch (RandomRange(0, 5)) {
-        case 0: outVec.Set(RandomRange(-size, size),    RandomRange(-size, size),                size);         break;
-        case 1: outVec.Set(RandomRange(-size, size),    RandomRange(-size, size),               -size);         break;
-        case 2: outVec.Set(RandomRange(-size, size),                 size,          RandomRange(-size, size));  break;
-        case 3: outVec.Set(RandomRange(-size, size),                -size,          RandomRange(-size, size));  break;
-        case 4: outVec.Set(             size,           RandomRange(-size, size),   RandomRange(-size, size));  break;
-        case 5: outVec.Set(            -size,           RandomRange(-size, size),   RandomRange(-size, size));  break;
-    }
+    // Pick one of the 6 faces: face/2 is the axis held at +size or -size, the other two are random. Indexing rather 
+    // than switching on the face avoids a mispredicted branch per sample.
+    RandomGenerator& rng = RandomGenerator::ThreadLocal();
+    const int face = rng.Range(0, 5);
+    const int axis = face >> 1;
+    float f[3];
+    f[axis] = (face & 1) ? -size : size;
+    f[axis == 2 ? 0 : axis + 1] = rng.Range(-size, size);
+    f[axis == 0 ? 2 : axis - 1] = rng.Range(-size, size);
+    outVec.Set(f[0], f[1], f[2]);
 }
 
 void Vector3::RandomInCircle(const Vector3& up, float radius, Vector3& outVec) {
     Vector3 cross;
-    Vector3::Cross(up, up == Right ? Forward : Right, cross);
-    Vector3::RotateRadians(cross, up.Normalized(), RandomRange(0.0f, TAU), outVec);
-    outVec *= Sqrt(RandomRange(0.0f, 1.0f)) * radius;
+    Vector3::Cross(up, RandomHelperAxis(up), cross);
+    RandomGenerator& rng = RandomGenerator::ThreadLocal();
+    Vector3::RotateRadians(cross, up.Normalized(), rng.Range(0.0f, TAU), outVec);
+    outVec *= Sqrt(rng.NextFloat()) * radius;
 }
 
 void Vector3::RandomOnCircle(const Vector3& up, float radius, Vector3& outVec) {
     Vector3 cross;
-    Vector3::Cross(up, up == Right ? Forward : Right, cross);
-    Vector3::RotateRadians(cross, up.Normalized(), RandomRange(0.0f, TAU), outVec);
+    Vector3::Cross(up, RandomHelperAxis(up), cross);
+    Vector3::RotateRadians(cross, up.Normalized(), RandomGenerator::ThreadLocal().Range(0.0f, TAU), outVec);
     outVec *= radius;
 }
 
 
+namespace {
+    // Samples are made RandomBatch at a time from one fill of random floats per input, then stored wide::Width at a 
+    // time. A multiple of every wide::Width.
+    _XOCONSTEXPR const size_t RandomBatch = 256;
+
+    // An orthonormal frame around a direction: axis is the direction normalized, u and v are perpendicular to it and 
+    // to each other. u is perpendicular to the same helper vector the single sample methods rotate about.
+    struct RandomFrame {
+        RandomFrame(const Vector3& direction, const Vector3& helper) {
+            axis = direction.Normalized();
+            Vector3::Cross(axis, helper, u);
+            u.Normalize();
+            Vector3::Cross(axis, u, v);
+        }
+        Vector3 axis, u, v;
+    };
+
+    // Writes Width samples (count of them when fewer remain) to either a Vector3 array or three float arrays.
+    struct RandomOutput {
+        void Write(size_t i, wide::Float x, wide::Float y, wide::Float z, size_t count) const {
+            using namespace wide;
+            if (vecs) {
+#if defined(XO_SSE)
+                if (count == (size_t)Width) {
+                    StoreTransposed4(vecs[i].f, 4, x, y, z, Zero());
+                    return;
+                }
+#endif
+                _XOSIMDALIGN32 float tx[Width], ty[Width], tz[Width];
+                Store(tx, x);
+                Store(ty, y);
+                Store(tz, z);
+                for (size_t j = 0; j < count; ++j) {
+                    vecs[i + j].Set(tx[j], ty[j], tz[j]);
+                }
+            }
+            else if (count == (size_t)Width) {
+                StoreUnaligned(outX + i, x);
+                StoreUnaligned(outY + i, y);
+                StoreUnaligned(outZ + i, z);
+            }
+            else {
+                StorePartial(outX + i, x, count);
+                StorePartial(outY + i, y, count);
+                StorePartial(outZ + i, z, count);
+            }
+        }
+        Vector3* vecs;
+        float* outX;
+        float* outY;
+        float* outZ;
+    };
+
+    // Shape::Randoms uniform floats in [0, 1) are drawn per sample, Shape::Sample turns Width of them into Width points.
+    template <class Shape>
+    void SampleRandomShape(const Shape& shape, const RandomOutput& output, size_t count) {
+        using namespace wide;
+        RandomGenerator& rng = RandomGenerator::ThreadLocal();
+        _XOSIMDALIGN32 float randoms[Shape::Randoms][RandomBatch];
+        for (size_t batch = 0; batch < count; batch += RandomBatch) {
+            const size_t batchCount = _XO_MIN(RandomBatch, count - batch);
+            const size_t filled = (batchCount + Width - 1) & ~(size_t)(Width - 1);
+            for (int r = 0; r < Shape::Randoms; ++r) {
+                rng.Floats(randoms[r], filled);
+            }
+            for (size_t i = 0; i < batchCount; i += Width) {
+                Float u[Shape::Randoms];
+                for (int r = 0; r < Shape::Randoms; ++r) {
+                    u[r] = Load(randoms[r] + i);
+                }
+                Float x, y, z;
+                shape.Sample(u, x, y, z);
+                output.Write(batch + i, x, y, z, _XO_MIN((size_t)Width, batchCount - i));
+            }
+        }
+    }
+
+    // center + (u * cos(phi) + v * sin(phi)) * radius, for cones and circles alike.
+    _XOINL void RandomRing(const RandomFrame& frame, wide::Float center, wide::Float radius, wide::Float phi, wide::Float& x, wide::Float& y, wide::Float& z) {
+        using namespace wide;
+        Float s, c;
+        wide::SinCos(phi, s, c);
+        s = Mul(s, radius);
+        c = Mul(c, radius);
+        x = MulAdd(Set(frame.u.x), c, MulAdd(Set(frame.v.x), s, Mul(Set(frame.axis.x), center)));
+        y = MulAdd(Set(frame.u.y), c, MulAdd(Set(frame.v.y), s, Mul(Set(frame.axis.y), center)));
+        z = MulAdd(Set(frame.u.z), c, MulAdd(Set(frame.v.z), s, Mul(Set(frame.axis.z), center)));
+    }
+
+    // Tilted from forward by a random angle up to halfAngle (In) or by exactly halfAngle (On), then spun about it.
+    template <bool In>
+    struct RandomConeShape {
+        static const int Randoms = 2;
+        RandomConeShape(const Vector3& forward, float angle) :
+            frame(forward, RandomHelperAxis(forward)),
+            length(forward.Magnitude()),
+            halfAngle(angle * 0.5f) {
+        }
+        void Sample(const wide::Float* u, wide::Float& x, wide::Float& y, wide::Float& z) const {
+            using namespace wide;
+            Float s, c;
+            wide::SinCos(In ? Mul(u[1], Set(halfAngle)) : Set(halfAngle), s, c);
+            RandomRing(frame, Mul(c, Set(length)), Mul(s, Set(length)), Mul(u[0], Set(TAU)), x, y, z);
+        }
+        RandomFrame frame;
+        float length;
+        float halfAngle;
+    };
+
+    // A circle about up, uniform over its area (In) or on its edge (On).
+    template <bool In>
+    struct RandomCircleShape {
+        static const int Randoms = In ? 2 : 1;
+        RandomCircleShape(const Vector3& up, float radius) :
+            frame(up, RandomHelperAxis(up)),
+            radius(radius) {
+        }
+        void Sample(const wide::Float* u, wide::Float& x, wide::Float& y, wide::Float& z) const {
+            using namespace wide;
+            const Float r = In ? Mul(wide::Sqrt(u[Randoms - 1]), Set(radius)) : Set(radius);
+            RandomRing(frame, Zero(), r, Mul(u[0], Set(TAU)), x, y, z);
+        }
+        RandomFrame frame;
+        float radius;
+    };
+
+    // Archimedes: z is uniform in [-1, 1] on a sphere's surface, the angle about z is uniform too. No rejection needed.
+    struct RandomSphereShape {
+        static const int Randoms = 2;
+        explicit RandomSphereShape(float radius) : radius(radius) { }
+        void Sample(const wide::Float* u, wide::Float& x, wide::Float& y, wide::Float& z) const {
+            using namespace wide;
+            const Float h = MulAdd(u[1], Set(2.0f), Set(-1.0f));
+            const Float r = Mul(wide::Sqrt(wide::Max(NegMulAdd(h, h, Set(1.0f)), Zero())), Set(radius));
+            Float s, c;
+            wide::SinCos(Mul(u[0], Set(TAU)), s, c);
+            x = Mul(c, r);
+            y = Mul(s, r);
+            z = Mul(h, Set(radius));
+        }
+        float radius;
+    };
+
+    // Uniform in the cube (In), or on one of its 6 faces picked at random with the other two axes uniform (On).
+    template <bool In>
+    struct RandomCubeShape {
+        static const int Randoms = 3;
+        explicit RandomCubeShape(float size) : size(size) { }
+        void Sample(const wide::Float* u, wide::Float& x, wide::Float& y, wide::Float& z) const {
+            using namespace wide;
+            const Float a = MulAdd(u[0], Set(2.0f * size), Set(-size));
+            const Float b = MulAdd(u[1], Set(2.0f * size), Set(-size));
+            if (In) {
+                x = a;
+                y = b;
+                z = MulAdd(u[2], Set(2.0f * size), Set(-size));
+                return;
+            }
+            // face in 0..5: face/2 is the axis held at the surface, odd faces are on the negative side.
+            const Float face = Floor(Mul(u[2], Set(6.0f)));
+            const Float half = Floor(Mul(face, Set(0.5f)));
+            const Float surface = Select(CmpNeq(Add(half, half), face), Set(-size), Set(size));
+            const Float axis0 = CmpLt(face, Set(2.0f));
+            const Float axis2 = CmpGe(face, Set(4.0f));
+            x = Select(axis0, surface, a);
+            y = Select(axis0, a, Select(axis2, b, surface));
+            z = Select(axis2, surface, b);
+        }
+        float size;
+    };
+
+    _XOINL RandomOutput RandomVectors(Vector3* outVecs) {
+        RandomOutput output = { outVecs, nullptr, nullptr, nullptr };
+        return output;
+    }
+
+    _XOINL RandomOutput RandomStreams(float* outX, float* outY, float* outZ) {
+        RandomOutput output = { nullptr, outX, outY, outZ };
+        return output;
+    }
+}
+
+void Vector3::RandomInCircleArray(const Vector3& up, float radius, Vector3* outVecs, size_t count) {
+    SampleRandomShape(RandomCircleShape<true>(up, radius), RandomVectors(outVecs), count);
+}
+
+void Vector3::RandomInCircleArray(const Vector3& up, float radius, float* outX, float* outY, float* outZ, size_t count) {
+    SampleRandomShape(RandomCircleShape<true>(up, radius), RandomStreams(outX, outY, outZ), count);
+}
+
+void Vector3::RandomOnCircleArray(const Vector3& up, float radius, Vector3* outVecs, size_t count) {
+    SampleRandomShape(RandomCircleShape<false>(up, radius), RandomVectors(outVecs), count);
+}
+
+void Vector3::RandomOnCircleArray(const Vector3& up, float radius, float* outX, float* outY, float* outZ, size_t count) {
+    SampleRandomShape(RandomCircleShape<false>(up, radius), RandomStreams(outX, outY, outZ), count);
+}
+
+void Vector3::RandomInConeRadiansArray(const Vector3& forward, float angle, Vector3* outVecs, size_t count) {
+    SampleRandomShape(RandomConeShape<true>(forward, angle), RandomVectors(outVecs), count);
+}
+
+void Vector3::RandomInConeRadiansArray(const Vector3& forward, float angle, float* outX, float* outY, float* outZ, size_t count) {
+    SampleRandomShape(RandomConeShape<true>(forward, angle), RandomStreams(outX, outY, outZ), count);
+}
+
+void Vector3::RandomOnConeRadiansArray(const Vector3& forward, float angle, Vector3* outVecs, size_t count) {
+    SampleRandomShape(RandomConeShape<false>(forward, angle), RandomVectors(outVecs), count);
+}
+
+void Vector3::RandomOnConeRadiansArray(const Vector3& forward, float angle, float* outX, float* outY, float* outZ, size_t count) {
+    SampleRandomShape(RandomConeShape<false>(forward, angle), RandomStreams(outX, outY, outZ), count);
+}
+
+void Vector3::RandomInCubeArray(float size, Vector3* outVecs, size_t count) {
+    SampleRandomShape(RandomCubeShape<true>(size), RandomVectors(outVecs), count);
+}
+
+void Vector3::RandomInCubeArray(float size, float* outX, float* outY, float* outZ, size_t count) {
+    SampleRandomShape(RandomCubeShape<true>(size), RandomStreams(outX, outY, outZ), count);
+}
+
+void Vector3::RandomOnCubeArray(float size, Vector3* outVecs, size_t count) {
+    SampleRandomShape(RandomCubeShape<false>(size), RandomVectors(outVecs), count);
+}
+
+void Vector3::RandomOnCubeArray(float size, float* outX, float* outY, float* outZ, size_t count) {
+    SampleRandomShape(RandomCubeShape<false>(size), RandomStreams(outX, outY, outZ), count);
+}
+
+void Vector3::RandomOnSphereArray(float radius, Vector3* outVecs, size_t count) {
+    SampleRandomShape(RandomSphereShape(radius), RandomVectors(outVecs), count);
+}
+
+void Vector3::RandomOnSphereArray(float radius, float* outX, float* outY, float* outZ, size_t count) {
+    SampleRandomShape(RandomSphereShape(radius), RandomStreams(outX, outY, outZ), count);
+}
+
+
 
 #undef IDX_X
 #undef IDX_Y
@@ -1709,6 +7141,292 @@ void Vector3::RandomOnCircle(const Vector3& up, float radius, Vector3& outVec) {
 #undef IDX_W
 
 
+////////////////////////////////////////////////////////////////////////// Vector3Stream.cpp
+
+static_assert(XO_STREAM_ALIGNMENT % 32 == 0, "xo-math XO_STREAM_ALIGNMENT must be a multiple of 32.");
+
+namespace xo_internal {
+    _XOINL size_t StreamCapacity(size_t count) {
+        const size_t floatsPerBlock = XO_STREAM_ALIGNMENT / sizeof(float);
+        return ((count + floatsPerBlock - 1) / floatsPerBlock) * floatsPerBlock;
+    }
+
+    // The number of floats a kernel walks: count rounded up to whole wide::Float steps. Never more than the capacity.
+    _XOINL size_t StreamSteps(size_t count) {
+        return ((count + wide::Width - 1) / wide::Width) * wide::Width;
+    }
+}
+
+Vector3Stream::Vector3Stream() :
+    x(nullptr), y(nullptr), z(nullptr), size(0), capacity(0)
+{
+}
+
+Vector3Stream::Vector3Stream(size_t count) :
+    x(nullptr), y(nullptr), z(nullptr), size(0), capacity(0)
+{
+    Resize(count);
+}
+
+Vector3Stream::Vector3Stream(const Vector3* vecs, size_t count) :
+    x(nullptr), y(nullptr), z(nullptr), size(0), capacity(0)
+{
+    Set(vecs, count);
+}
+
+Vector3Stream::Vector3Stream(const Vector3Stream& stream) :
+    x(nullptr), y(nullptr), z(nullptr), size(0), capacity(0)
+{
+    *this = stream;
+}
+
+Vector3Stream::Vector3Stream(Vector3Stream&& stream) :
+    x(stream.x), y(stream.y), z(stream.z), size(stream.size), capacity(stream.capacity)
+{
+    stream.x = stream.y = stream.z = nullptr;
+    stream.size = stream.capacity = 0;
+}
+
+Vector3Stream::~Vector3Stream() {
+    Release();
+}
+
+void Vector3Stream::Allocate(size_t count) {
+    capacity = xo_internal::StreamCapacity(count);
+    size = count;
+    if (capacity) {
+        x = (float*)XO_ALIGNED_MALLOC(capacity * 3 * sizeof(float), XO_STREAM_ALIGNMENT);
+        y = x + capacity;
+        z = y + capacity;
+    }
+}
+
+void Vector3Stream::Release() {
+    if (x) {
+        XO_ALIGNED_FREE(x);
+    }
+    x = y = z = nullptr;
+    size = capacity = 0;
+}
+
+Vector3Stream& Vector3Stream::operator = (const Vector3Stream& stream) {
+    if (this != &stream) {
+        if (capacity != stream.capacity) {
+            Release();
+            Allocate(stream.size);
+        }
+        size = stream.size;
+        if (capacity) {
+            memcpy(x, stream.x, capacity * 3 * sizeof(float));
+        }
+    }
+    return *this;
+}
+
+Vector3Stream& Vector3Stream::operator = (Vector3Stream&& stream) {
+    if (this != &stream) {
+        Release();
+        x = stream.x;
+        y = stream.y;
+        z = stream.z;
+        size = stream.size;
+        capacity = stream.capacity;
+        stream.x = stream.y = stream.z = nullptr;
+        stream.size = stream.capacity = 0;
+    }
+    return *this;
+}
+
+void Vector3Stream::Resize(size_t count) {
+    size_t keep = _XO_MIN(count, size);
+    if (xo_internal::StreamCapacity(count) != capacity) {
+        Vector3Stream old(std::move(*this));
+        Allocate(count);
+        if (keep) {
+            memcpy(x, old.x, keep * sizeof(float));
+            memcpy(y, old.y, keep * sizeof(float));
+            memcpy(z, old.z, keep * sizeof(float));
+        }
+    }
+    // new vectors and the padding past them start as zero.
+    for (size_t i = keep; i < capacity; ++i) {
+        x[i] = y[i] = z[i] = 0.0f;
+    }
+    size = count;
+}
+
+void Vector3Stream::Set(const Vector3* vecs, size_t count) {
+    Resize(count);
+    size_t i = 0;
+#if defined(XO_SSE)
+    // Four AoS vectors transpose into four SoA registers, the fourth (w) is dropped.
+    for (; i + 4 <= count; i += 4) {
+        __m128 r0 = vecs[i].xmm, r1 = vecs[i+1].xmm, r2 = vecs[i+2].xmm, r3 = vecs[i+3].xmm;
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_store_ps(x + i, r0);
+        _mm_store_ps(y + i, r1);
+        _mm_store_ps(z + i, r2);
+    }
+#endif
+    for (; i < count; ++i) {
+        x[i] = vecs[i].x;
+        y[i] = vecs[i].y;
+        z[i] = vecs[i].z;
+    }
+}
+
+void Vector3Stream::Get(Vector3* vecs) const {
+    size_t i = 0;
+#if defined(XO_SSE)
+    for (; i + 4 <= size; i += 4) {
+        __m128 r0 = _mm_load_ps(x + i), r1 = _mm_load_ps(y + i), r2 = _mm_load_ps(z + i), r3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        vecs[i].xmm = r0;
+        vecs[i+1].xmm = r1;
+        vecs[i+2].xmm = r2;
+        vecs[i+3].xmm = r3;
+    }
+#endif
+    for (; i < size; ++i) {
+        vecs[i].Set(x[i], y[i], z[i]);
+    }
+}
+
+void Vector3Stream::Add(const Vector3Stream& a, const Vector3Stream& b, Vector3Stream& o) {
+    XO_ASSERT(a.size == b.size, "xo-math Vector3Stream::Add streams must be the same size.");
+    o.Resize(a.size);
+    const size_t n = xo_internal::StreamSteps(a.size);
+    for (size_t i = 0; i < n; i += wide::Width) {
+        wide::Store(o.x + i, wide::Add(wide::Load(a.x + i), wide::Load(b.x + i)));
+        wide::Store(o.y + i, wide::Add(wide::Load(a.y + i), wide::Load(b.y + i)));
+        wide::Store(o.z + i, wide::Add(wide::Load(a.z + i), wide::Load(b.z + i)));
+    }
+}
+
+void Vector3Stream::Add(const Vector3Stream& a, const Vector3& v, Vector3Stream& o) {
+    o.Resize(a.size);
+    const wide::Float vx = wide::Set(v.x), vy = wide::Set(v.y), vz = wide::Set(v.z);
+    const size_t n = xo_internal::StreamSteps(a.size);
+    for (size_t i = 0; i < n; i += wide::Width) {
+        wide::Store(o.x + i, wide::Add(wide::Load(a.x + i), vx));
+        wide::Store(o.y + i, wide::Add(wide::Load(a.y + i), vy));
+        wide::Store(o.z + i, wide::Add(wide::Load(a.z + i), vz));
+    }
+}
+
+void Vector3Stream::Subtract(const Vector3Stream& a, const Vector3Stream& b, Vector3Stream& o) {
+    XO_ASSERT(a.size == b.size, "xo-math Vector3Stream::Subtract streams must be the same size.");
+    o.Resize(a.size);
+    const size_t n = xo_internal::StreamSteps(a.size);
+    for (size_t i = 0; i < n; i += wide::Width) {
+        wide::Store(o.x + i, wide::Sub(wide::Load(a.x + i), wide::Load(b.x + i)));
+        wide::Store(o.y + i, wide::Sub(wide::Load(a.y + i), wide::Load(b.y + i)));
+        wide::Store(o.z + i, wide::Sub(wide::Load(a.z + i), wide::Load(b.z + i)));
+    }
+}
+
+void Vector3Stream::Multiply(const Vector3Stream& a, const Vector3Stream& b, Vector3Stream& o) {
+    XO_ASSERT(a.size == b.size, "xo-math Vector3Stream::Multiply streams must be the same size.");
+    o.Resize(a.size);
+    const size_t n = xo_internal::StreamSteps(a.size);
+    for (size_t i = 0; i < n; i += wide::Width) {
+        wide::Store(o.x + i, wide::Mul(wide::Load(a.x + i), wide::Load(b.x + i)));
+        wide::Store(o.y + i, wide::Mul(wide::Load(a.y + i), wide::Load(b.y + i)));
+        wide::Store(o.z + i, wide::Mul(wide::Load(a.z + i), wide::Load(b.z + i)));
+    }
+}
+
+void Vector3Stream::Scale(const Vector3Stream& a, float f, Vector3Stream& o) {
+    o.Resize(a.size);
+    const wide::Float s = wide::Set(f);
+    const size_t n = xo_internal::StreamSteps(a.size);
+    for (size_t i = 0; i < n; i += wide::Width) {
+        wide::Store(o.x + i, wide::Mul(wide::Load(a.x + i), s));
+        wide::Store(o.y + i, wide::Mul(wide::Load(a.y + i), s));
+        wide::Store(o.z + i, wide::Mul(wide::Load(a.z + i), s));
+    }
+}
+
+void Vector3Stream::Lerp(const Vector3Stream& a, const Vector3Stream& b, float t, Vector3Stream& o) {
+    XO_ASSERT(a.size == b.size, "xo-math Vector3Stream::Lerp streams must be the same size.");
+    o.Resize(a.size);
+    const wide::Float wt = wide::Set(t);
+    const size_t n = xo_internal::StreamSteps(a.size);
+    for (size_t i = 0; i < n; i += wide::Width) {
+        wide::Float ax = wide::Load(a.x + i), ay = wide::Load(a.y + i), az = wide::Load(a.z + i);
+        wide::Store(o.x + i, wide::MulAdd(wide::Sub(wide::Load(b.x + i), ax), wt, ax));
+        wide::Store(o.y + i, wide::MulAdd(wide::Sub(wide::Load(b.y + i), ay), wt, ay));
+        wide::Store(o.z + i, wide::MulAdd(wide::Sub(wide::Load(b.z + i), az), wt, az));
+    }
+}
+
+void Vector3Stream::Cross(const Vector3Stream& a, const Vector3Stream& b, Vector3Stream& o) {
+    XO_ASSERT(a.size == b.size, "xo-math Vector3Stream::Cross streams must be the same size.");
+    o.Resize(a.size);
+    const size_t n = xo_internal::StreamSteps(a.size);
+    for (size_t i = 0; i < n; i += wide::Width) {
+        wide::Float ax = wide::Load(a.x + i), ay = wide::Load(a.y + i), az = wide::Load(a.z + i);
+        wide::Float bx = wide::Load(b.x + i), by = wide::Load(b.y + i), bz = wide::Load(b.z + i);
+        wide::Store(o.x + i, wide::NegMulAdd(az, by, wide::Mul(ay, bz)));
+        wide::Store(o.y + i, wide::NegMulAdd(ax, bz, wide::Mul(az, bx)));
+        wide::Store(o.z + i, wide::NegMulAdd(ay, bx, wide::Mul(ax, by)));
+    }
+}
+
+void Vector3Stream::Normalize(const Vector3Stream& a, Vector3Stream& o) {
+    o.Resize(a.size);
+    const size_t n = xo_internal::StreamSteps(a.size);
+    for (size_t i = 0; i < n; i += wide::Width) {
+        wide::Float ax = wide::Load(a.x + i), ay = wide::Load(a.y + i), az = wide::Load(a.z + i);
+        wide::Float magSq = wide::MulAdd(ax, ax, wide::MulAdd(ay, ay, wide::Mul(az, az)));
+        wide::Float nonZero = wide::CmpGt(magSq, wide::Zero());
+#if defined(XO_NO_INVERSE_DIVISION)
+        wide::Float inv = wide::Div(wide::Set(1.0f), wide::Sqrt(magSq));
+#else
+        wide::Float inv = wide::Rsqrt(magSq);
+#endif
+        inv = wide::And(nonZero, inv);
+        wide::Store(o.x + i, wide::Mul(ax, inv));
+        wide::Store(o.y + i, wide::Mul(ay, inv));
+        wide::Store(o.z + i, wide::Mul(az, inv));
+    }
+}
+
+void Vector3Stream::Dot(const Vector3Stream& a, const Vector3Stream& b, float* outFloats) {
+    XO_ASSERT(a.size == b.size, "xo-math Vector3Stream::Dot streams must be the same size.");
+    const size_t n = xo_internal::StreamSteps(a.size);
+    for (size_t i = 0; i < n; i += wide::Width) {
+        wide::Float d = wide::MulAdd(wide::Load(a.x + i), wide::Load(b.x + i),
+                        wide::MulAdd(wide::Load(a.y + i), wide::Load(b.y + i),
+                        wide::Mul(wide::Load(a.z + i), wide::Load(b.z + i))));
+        if (i + wide::Width <= a.size) {
+            wide::StoreUnaligned(outFloats + i, d);
+        }
+        else {
+            wide::StorePartial(outFloats + i, d, a.size - i);
+        }
+    }
+}
+
+void Vector3Stream::MagnitudeSquared(const Vector3Stream& a, float* outFloats) {
+    Dot(a, a, outFloats);
+}
+
+void Vector3Stream::Magnitude(const Vector3Stream& a, float* outFloats) {
+    const size_t n = xo_internal::StreamSteps(a.size);
+    for (size_t i = 0; i < n; i += wide::Width) {
+        wide::Float ax = wide::Load(a.x + i), ay = wide::Load(a.y + i), az = wide::Load(a.z + i);
+        wide::Float m = wide::Sqrt(wide::MulAdd(ax, ax, wide::MulAdd(ay, ay, wide::Mul(az, az))));
+        if (i + wide::Width <= a.size) {
+            wide::StoreUnaligned(outFloats + i, m);
+        }
+        else {
+            wide::StorePartial(outFloats + i, m, a.size - i);
+        }
+    }
+}
+
+
 ////////////////////////////////////////////////////////////////////////// Vector4.cpp
 
 #if defined(_XONOCONSTEXPR)
@@ -1813,7 +7531,7 @@ Vector4::Vector4(const class Vector3& vec, float w) :
     xmm(vec.xmm)
 {
     //! @todo there's likely an sse way to do this.
-    w = w;
+    this->w = w;
 }
 #else
     x(vec.x), y(vec.y), z(vec.z), w(w)
@@ -1849,7 +7567,7 @@ Vector4& Vector4::Set(float f) {
     this->x = f;
     this->y = f;
     this->z = f;
-    this->w = w;
+    this->w = f;
 #endif
     return *this;
 }
@@ -1944,9 +7662,12 @@ void Vector4::Get(float* f) const {
 }
  
 float Vector4::Sum() const {
-#if defined(XO_SSE)
+#if defined(XO_SSE3)
     __m128 s = _mm_hadd_ps(xmm, xmm);
     return _mm_cvtss_f32(_mm_hadd_ps(s, s));
+#elif defined(XO_SSE)
+    __m128 s = _mm_add_ps(xmm, _mm_movehl_ps(xmm, xmm));
+    return _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1))));
 #else
     return x+y+z+w;
 #endif
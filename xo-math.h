@@ -24,19 +24,15 @@
 // TODO:
 //  * Ensure macros are consistently named.
 //  * Support NEON (investigate http://projectne10.github.io/Ne10/ license)
-//  * Add transformation object.
 //  * Move trivial methods to headers, keep only "meaningful" code in *.cpp/*inline.h files
 //  * Use macros to generate variant functions for other classes, like in Vector3.h
 //  * Consider other simpler documentation solution. github pages?
 //  * Consider something like premake or similar for dev project files. Check out https://github.com/bkaradzic/GENie
 //  * Move CI back to travis, include more compiler versions.
 //  * Matrix: finish filling out stubs
-//  * fast sin/cos, sincos, _x2 _x2 _x3
-//  * RNG: https://blogs.unity3d.com/2015/01/07/a-primer-on-repeatable-random-numbers/
 //  * Noise:
 //  * Consider moving all randoms out of types themselves and into a separate file.
 //  * Make a very simple graphics demo using many features of xo-math.
-//  * Add recip methods to vectors (and use inside Matrix -> Quaternion conversion)
 
 #ifndef XO_MATH_H
 #define XO_MATH_H
@@ -72,11 +68,15 @@
 #endif 
 
 #include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 #ifndef XO_NO_OSTREAM
 #   include <ostream>
 #endif
 #include <random>
 #include <thread>
+#include <atomic>
 #include <limits>
 #if defined(__arm__)
 #   if defined(__ARM_NEON__)
@@ -89,7 +89,7 @@
             // so we're assuming under msvc that it's all that's required to determine neon support...
 #           include <arm_neon.h>
 #       else
-#           include <xmmintrin.h>
+#           include <immintrin.h>
 #       endif
 #   else
 #       include <x86intrin.h>
@@ -107,12 +107,16 @@
 #   else
 #       define _XOSIMDALIGN __declspec(align(16))
 #   endif
+    // wide enough for any wide::Float
+#   define _XOSIMDALIGN32 __declspec(align(32))
 #else
 #   if defined(__arm__)
 #       define _XOSIMDALIGN __attribute__((aligned(8)))
 #   else
 #       define _XOSIMDALIGN __attribute__((aligned(16)))
 #   endif
+    // wide enough for any wide::Float
+#   define _XOSIMDALIGN32 __attribute__((aligned(32)))
 #endif
 
 #define XOMATH_INTERNAL 1
@@ -157,20 +161,6 @@
 
 # define _XO_NO_TLS (defined(__clang__) && defined(__APPLE__)) || (defined(_MSC_VER) && _MSC_VER < 1800)
 
-// apple clang doesn't give us thread_local until xcode 8.
-#if _XO_NO_TLS
-#   define _XO_TLS_ENGINE \
-        static _XOTLS std::mt19937* tls_engline; \
-        static _XOTLS char mem[sizeof(std::mt19937)];\
-        if(!tls_engline) { \
-            tls_engline = new(mem) std::mt19937((unsigned)clock()); \
-        }
-#    define _XO_TLS_DISTRIBUTION dist(*tls_engline)
-#else
-#   define _XO_TLS_ENGINE \
-        static _XOTLS std::mt19937 tls_engline((unsigned)clock());
-#    define _XO_TLS_DISTRIBUTION dist(tls_engline)
-#endif
 
 XOMATH_BEGIN_XO_NS();
 
@@ -209,6 +199,20 @@ _XOINL float HexFloat(unsigned u) {
     return Converter.f;
 }
 
+//! Precision policies for reciprocals, inverse square roots and the methods built on them, picked per call site as a 
+//! template argument, such as v.Normalize<Precision::Fast>().
+//!
+//! Exact uses IEEE division and square root, max relative error 1.2e-7 for a reciprocal and 1.8e-7 for an inverse 
+//! square root (which rounds twice). Fast starts from the hardware estimate and refines it with one Newton-Raphson 
+//! step, max relative error 2.8e-7. Approximate uses the hardware estimate as is, max relative error 1.5*2^-12 
+//! (about 3.7e-4). Without SSE there is no estimate to start from and every policy is Exact.
+//! @sa XO_NO_INVERSE_DIVISION, which picks the precision of the division operators for the whole build.
+enum class Precision {
+    Exact,
+    Fast,
+    Approximate
+};
+
 #if defined(XO_SSE)
 namespace sse {
     static const __m128 AbsMask = _mm_set1_ps(HexFloat(0x7fffffff));
@@ -225,6 +229,42 @@ namespace sse {
     static const __m128 One = _mm_set1_ps(1.0f);
     static const __m128 NegativeOne = _mm_set1_ps(-1.0f);
     static const __m128 Epsilon = _mm_set_ps1(SSEFloatEpsilon);
+
+    // a*b+c, fused when the target has FMA.
+    _XOINL __m128 MulAdd(__m128 a, __m128 b, __m128 c) {
+#   if defined(XO_FMA)
+        return _mm_fmadd_ps(a, b, c);
+#   else
+        return _mm_add_ps(_mm_mul_ps(a, b), c);
+#   endif
+    }
+
+    // 1/v per lane, see Precision.
+    template <Precision P>
+    _XOINL __m128 Reciprocal(__m128 v) {
+        if (P == Precision::Exact) {
+            return _mm_div_ps(One, v);
+        }
+        __m128 r = _mm_rcp_ps(v);
+        if (P == Precision::Fast) {
+            r = _mm_sub_ps(_mm_add_ps(r, r), _mm_mul_ps(_mm_mul_ps(v, r), r));
+        }
+        return r;
+    }
+
+    // 1/sqrt(v) per lane, see Precision.
+    template <Precision P>
+    _XOINL __m128 InvSqrt(__m128 v) {
+        if (P == Precision::Exact) {
+            return _mm_div_ps(One, _mm_sqrt_ps(v));
+        }
+        __m128 r = _mm_rsqrt_ps(v);
+        if (P == Precision::Fast) {
+            const __m128 halfV = _mm_mul_ps(v, _mm_set1_ps(0.5f));
+            r = _mm_mul_ps(r, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(halfV, r), r)));
+        }
+        return r;
+    }
 }
 
 // We wont warn about pre-defining XO_16ALIGNED_MALLOC or XO_16ALIGNED_FREE.
@@ -247,12 +287,33 @@ namespace sse {
 #   define _XO_OVERLOAD_NEW_DELETE()
 #endif
 
+// Stream types (such as Vector3Stream) keep their arrays on cache line boundaries so the widest simd loads never split one.
+// As with XO_16ALIGNED_MALLOC, a user provided allocator wins.
+#if !defined(XO_STREAM_ALIGNMENT)
+#   define XO_STREAM_ALIGNMENT 64
+#endif
+#if !defined(XO_ALIGNED_MALLOC)
+#   if defined(XO_SSE)
+#       define XO_ALIGNED_MALLOC(size, alignment) _mm_malloc(size, alignment)
+#   else
+#       define XO_ALIGNED_MALLOC(size, alignment) malloc(size)
+#   endif
+#endif
+#if !defined(XO_ALIGNED_FREE)
+#   if defined(XO_SSE)
+#       define XO_ALIGNED_FREE(ptr) _mm_free(ptr)
+#   else
+#       define XO_ALIGNED_FREE(ptr) free(ptr)
+#   endif
+#endif
+
 #define _XO_MIN(a, b) (a < b ? a : b)
 #define _XO_MAX(a, b) (a > b ? a : b)
 
 // wrap for now, so we have the option to make a faster version later.
 _XOINL float Min(float x, float y)      { return _XO_MIN(x, y); }
 _XOINL float Max(float x, float y)      { return _XO_MAX(x, y); }
+_XOINL float Clamp(float f, float min, float max) { return Min(Max(f, min), max); }
 _XOINL float Abs(float f)               { return f > 0.0f ? f : -f; }
 _XOINL float Sqrt(float f)              { return sqrtf(f); } 
 _XOINL float Cbrt(float f)              { return cbrtf(f); }
@@ -265,122 +326,657 @@ _XOINL float ATan(float f)              { return atanf(f); }
 _XOINL float ATan2(float y, float x)    { return atan2f(y, x); } 
 _XOINL float Difference(float x, float y) { return Abs(x-y); }
 
+//! 1/f with the precision policy P. Approximate and Fast return NaN rather than infinity for 0.
+template <Precision P = Precision::Exact>
+_XOINL float Reciprocal(float f) {
+#if defined(XO_SSE)
+    if (P != Precision::Exact) {
+        return _mm_cvtss_f32(sse::Reciprocal<P>(_mm_set_ss(f)));
+    }
+#endif
+    return 1.0f / f;
+}
+
+//! 1/Sqrt(f) with the precision policy P. Approximate and Fast return NaN rather than infinity for 0.
+template <Precision P = Precision::Exact>
+_XOINL float InvSqrt(float f) {
+#if defined(XO_SSE)
+    if (P != Precision::Exact) {
+        return _mm_cvtss_f32(sse::InvSqrt<P>(_mm_set_ss(f)));
+    }
+#endif
+    return 1.0f / Sqrt(f);
+}
+
+_XOINL
+bool CloseEnough(float x, float y, float tolerance = FloatEpsilon) {
+    return Difference(x, y) * (1.0f/tolerance) <= Min(Abs(x), Abs(y));
+}
+
+_XOCONSTEXPR _XOINL float Square(float t)      { return t*t; }
+_XOCONSTEXPR _XOINL double Square(double t)    { return t*t; }
+_XOCONSTEXPR _XOINL int Square(int t)          { return t*t; }
+
+XOMATH_END_XO_NS();
+
+#if defined(XO_SSE)
+#define _XO_ASSIGN_QUAT(W, X, Y, Z) xmm = _mm_set_ps(W, Z, Y, X);
+#define _XO_ASSIGN_QUAT_Q(Q, W, X, Y, Z) Q.xmm = _mm_set_ps(W, Z, Y, X);
+#else
+#define _XO_ASSIGN_QUAT(W, X, Y, Z) this->w = W; this->x = X; this->y = Y; this->z = Z;
+#define _XO_ASSIGN_QUAT_Q(Q, W, X, Y, Z) Q.w = W; Q.x = X; Q.y = Y; Q.z = Z;
+#endif
+
+////////////////////////////////////////////////////////////////////////// Module Includes
+XOMATH_BEGIN_XO_NS();
+
+namespace wide {
+#if defined(XO_AVX)
+    typedef __m256 Float;
+    _XOCONSTEXPR const int Width = 8;
+
+    _XOINL Float Load(const float* f)                   { return _mm256_load_ps(f); }
+    _XOINL Float LoadUnaligned(const float* f)          { return _mm256_loadu_ps(f); }
+    _XOINL void Store(float* f, Float v)                { _mm256_store_ps(f, v); }
+    _XOINL void StoreUnaligned(float* f, Float v)       { _mm256_storeu_ps(f, v); }
+    _XOINL Float Set(float f)                           { return _mm256_set1_ps(f); }
+    _XOINL Float Zero()                                 { return _mm256_setzero_ps(); }
+
+    _XOINL Float Add(Float a, Float b)                  { return _mm256_add_ps(a, b); }
+    _XOINL Float Sub(Float a, Float b)                  { return _mm256_sub_ps(a, b); }
+    _XOINL Float Mul(Float a, Float b)                  { return _mm256_mul_ps(a, b); }
+    _XOINL Float Div(Float a, Float b)                  { return _mm256_div_ps(a, b); }
+    _XOINL Float Min(Float a, Float b)                  { return _mm256_min_ps(a, b); }
+    _XOINL Float Max(Float a, Float b)                  { return _mm256_max_ps(a, b); }
+    _XOINL Float Sqrt(Float a)                          { return _mm256_sqrt_ps(a); }
+    _XOINL Float RcpEstimate(Float a)                   { return _mm256_rcp_ps(a); }
+    _XOINL Float RsqrtEstimate(Float a)                 { return _mm256_rsqrt_ps(a); }
+    _XOINL Float Round(Float a)                         { return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+    _XOINL Float Floor(Float a)                         { return _mm256_floor_ps(a); }
+
+    _XOINL Float And(Float a, Float b)                  { return _mm256_and_ps(a, b); }
+    _XOINL Float AndNot(Float a, Float b)               { return _mm256_andnot_ps(a, b); } 
+    _XOINL Float Or(Float a, Float b)                   { return _mm256_or_ps(a, b); }
+    _XOINL Float Xor(Float a, Float b)                  { return _mm256_xor_ps(a, b); }
+
+    _XOINL Float CmpEq(Float a, Float b)                { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+    _XOINL Float CmpNeq(Float a, Float b)               { return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ); }
+    _XOINL Float CmpLt(Float a, Float b)                { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    _XOINL Float CmpLe(Float a, Float b)                { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    _XOINL Float CmpGt(Float a, Float b)                { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    _XOINL Float CmpGe(Float a, Float b)                { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    _XOINL Float Select(Float mask, Float a, Float b)   { return _mm256_blendv_ps(b, a, mask); }
+    _XOINL int MoveMask(Float mask)                     { return _mm256_movemask_ps(mask); }
+#elif defined(XO_SSE)
+    typedef __m128 Float;
+    _XOCONSTEXPR const int Width = 4;
+
+    _XOINL Float Load(const float* f)                   { return _mm_load_ps(f); }
+    _XOINL Float LoadUnaligned(const float* f)          { return _mm_loadu_ps(f); }
+    _XOINL void Store(float* f, Float v)                { _mm_store_ps(f, v); }
+    _XOINL void StoreUnaligned(float* f, Float v)       { _mm_storeu_ps(f, v); }
+    _XOINL Float Set(float f)                           { return _mm_set1_ps(f); }
+    _XOINL Float Zero()                                 { return _mm_setzero_ps(); }
+
+    _XOINL Float Add(Float a, Float b)                  { return _mm_add_ps(a, b); }
+    _XOINL Float Sub(Float a, Float b)                  { return _mm_sub_ps(a, b); }
+    _XOINL Float Mul(Float a, Float b)                  { return _mm_mul_ps(a, b); }
+    _XOINL Float Div(Float a, Float b)                  { return _mm_div_ps(a, b); }
+    _XOINL Float Min(Float a, Float b)                  { return _mm_min_ps(a, b); }
+    _XOINL Float Max(Float a, Float b)                  { return _mm_max_ps(a, b); }
+    _XOINL Float Sqrt(Float a)                          { return _mm_sqrt_ps(a); }
+    _XOINL Float RcpEstimate(Float a)                   { return _mm_rcp_ps(a); }
+    _XOINL Float RsqrtEstimate(Float a)                 { return _mm_rsqrt_ps(a); }
+
+    _XOINL Float And(Float a, Float b)                  { return _mm_and_ps(a, b); }
+    _XOINL Float AndNot(Float a, Float b)               { return _mm_andnot_ps(a, b); } 
+    _XOINL Float Or(Float a, Float b)                   { return _mm_or_ps(a, b); }
+    _XOINL Float Xor(Float a, Float b)                  { return _mm_xor_ps(a, b); }
+
+    _XOINL Float CmpEq(Float a, Float b)                { return _mm_cmpeq_ps(a, b); }
+    _XOINL Float CmpNeq(Float a, Float b)               { return _mm_cmpneq_ps(a, b); }
+    _XOINL Float CmpLt(Float a, Float b)                { return _mm_cmplt_ps(a, b); }
+    _XOINL Float CmpLe(Float a, Float b)                { return _mm_cmple_ps(a, b); }
+    _XOINL Float CmpGt(Float a, Float b)                { return _mm_cmpgt_ps(a, b); }
+    _XOINL Float CmpGe(Float a, Float b)                { return _mm_cmpge_ps(a, b); }
+    _XOINL Float Select(Float mask, Float a, Float b) {
+#   if defined(XO_SSE4_1)
+        return _mm_blendv_ps(b, a, mask);
+#   else
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+#   endif
+    }
+    _XOINL int MoveMask(Float mask)                     { return _mm_movemask_ps(mask); }
+
+#   if defined(XO_SSE4_1)
+    _XOINL Float Round(Float a)                         { return _mm_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+    _XOINL Float Floor(Float a)                         { return _mm_floor_ps(a); }
+#   else
+    _XOINL Float Round(Float a) {
+        const Float magic = _mm_set1_ps(12582912.0f);
+        return _mm_sub_ps(_mm_add_ps(a, magic), magic);
+    }
+    _XOINL Float Floor(Float a) {
+        Float r = Round(a);
+        return _mm_sub_ps(r, _mm_and_ps(_mm_cmpgt_ps(r, a), _mm_set1_ps(1.0f)));
+    }
+#   endif
+#else
+    typedef float Float;
+    _XOCONSTEXPR const int Width = 1;
+
+    _XOINL unsigned Bits(float f) {
+        union {
+            float f;
+            unsigned u;
+        } Converter;
+        Converter.f = f;
+        return Converter.u;
+    }
+    _XOINL float Mask(bool b)                           { return HexFloat(b ? 0xffffffff : 0u); }
+
+    _XOINL Float Load(const float* f)                   { return *f; }
+    _XOINL Float LoadUnaligned(const float* f)          { return *f; }
+    _XOINL void Store(float* f, Float v)                { *f = v; }
+    _XOINL void StoreUnaligned(float* f, Float v)       { *f = v; }
+    _XOINL Float Set(float f)                           { return f; }
+    _XOINL Float Zero()                                 { return 0.0f; }
+
+    _XOINL Float Add(Float a, Float b)                  { return a + b; }
+    _XOINL Float Sub(Float a, Float b)                  { return a - b; }
+    _XOINL Float Mul(Float a, Float b)                  { return a * b; }
+    _XOINL Float Div(Float a, Float b)                  { return a / b; }
+    _XOINL Float Min(Float a, Float b)                  { return a < b ? a : b; }
+    _XOINL Float Max(Float a, Float b)                  { return a > b ? a : b; }
+    _XOINL Float Sqrt(Float a)                          { return sqrtf(a); }
+    _XOINL Float RcpEstimate(Float a)                   { return 1.0f / a; }
+    _XOINL Float RsqrtEstimate(Float a)                 { return 1.0f / sqrtf(a); }
+    _XOINL Float Round(Float a)                         { return nearbyintf(a); }
+    _XOINL Float Floor(Float a)                         { return floorf(a); }
+
+    _XOINL Float And(Float a, Float b)                  { return HexFloat(Bits(a) & Bits(b)); }
+    _XOINL Float AndNot(Float a, Float b)               { return HexFloat(~Bits(a) & Bits(b)); } 
+    _XOINL Float Or(Float a, Float b)                   { return HexFloat(Bits(a) | Bits(b)); }
+    _XOINL Float Xor(Float a, Float b)                  { return HexFloat(Bits(a) ^ Bits(b)); }
+
+    _XOINL Float CmpEq(Float a, Float b)                { return Mask(a == b); }
+    _XOINL Float CmpNeq(Float a, Float b)               { return Mask(a != b); }
+    _XOINL Float CmpLt(Float a, Float b)                { return Mask(a < b); }
+    _XOINL Float CmpLe(Float a, Float b)                { return Mask(a <= b); }
+    _XOINL Float CmpGt(Float a, Float b)                { return Mask(a > b); }
+    _XOINL Float CmpGe(Float a, Float b)                { return Mask(a >= b); }
+    _XOINL Float Select(Float mask, Float a, Float b)   { return Bits(mask) ? a : b; }
+    _XOINL int MoveMask(Float mask)                     { return (int)(Bits(mask) >> 31); }
+#endif
+
+    _XOINL Float MulAdd(Float a, Float b, Float c) {
+#if defined(XO_FMA) && defined(XO_AVX)
+        return _mm256_fmadd_ps(a, b, c);
+#elif defined(XO_FMA) && defined(XO_SSE)
+        return _mm_fmadd_ps(a, b, c);
+#else
+        return Add(Mul(a, b), c);
+#endif
+    }
+    _XOINL Float NegMulAdd(Float a, Float b, Float c) {
+#if defined(XO_FMA) && defined(XO_AVX)
+        return _mm256_fnmadd_ps(a, b, c);
+#elif defined(XO_FMA) && defined(XO_SSE)
+        return _mm_fnmadd_ps(a, b, c);
+#else
+        return Sub(c, Mul(a, b));
+#endif
+    }
+
+    _XOINL Float SignBit()                              { return Set(HexFloat(0x80000000)); }
+    _XOINL Float Abs(Float a)                           { return AndNot(SignBit(), a); }
+    _XOINL Float Negate(Float a)                        { return Xor(SignBit(), a); }
+    _XOINL Float True()                                 { return CmpEq(Zero(), Zero()); }
+    _XOINL int LaneBits(int count)                      { return (1 << count) - 1; }
+
+    _XOINL Float Rcp(Float a) {
+        Float r = RcpEstimate(a);
+        return Mul(r, NegMulAdd(a, r, Set(2.0f)));
+    }
+    _XOINL Float Rsqrt(Float a) {
+        Float r = RsqrtEstimate(a);
+        Float halfA = Mul(a, Set(0.5f));
+        return Mul(r, NegMulAdd(Mul(halfA, r), r, Set(1.5f)));
+    }
+
+    _XOINL Float LoadPartial(const float* f, size_t count) {
+        _XOSIMDALIGN32 float t[Width] = { };
+        for (size_t i = 0; i < count; ++i) {
+            t[i] = f[i];
+        }
+        return Load(t);
+    }
+    _XOINL void StorePartial(float* f, Float v, size_t count) {
+        _XOSIMDALIGN32 float t[Width];
+        Store(t, v);
+        for (size_t i = 0; i < count; ++i) {
+            f[i] = t[i];
+        }
+    }
+
+    _XOINL void LoadTransposed4(const float* f, size_t stride, Float& a, Float& b, Float& c, Float& d) {
+#if defined(XO_AVX)
+        __m128 l0 = _mm_load_ps(f), l1 = _mm_load_ps(f + stride), l2 = _mm_load_ps(f + stride * 2), l3 = _mm_load_ps(f + stride * 3);
+        __m128 h0 = _mm_load_ps(f + stride * 4), h1 = _mm_load_ps(f + stride * 5), h2 = _mm_load_ps(f + stride * 6), h3 = _mm_load_ps(f + stride * 7);
+        _MM_TRANSPOSE4_PS(l0, l1, l2, l3);
+        _MM_TRANSPOSE4_PS(h0, h1, h2, h3);
+        a = _mm256_insertf128_ps(_mm256_castps128_ps256(l0), h0, 1);
+        b = _mm256_insertf128_ps(_mm256_castps128_ps256(l1), h1, 1);
+        c = _mm256_insertf128_ps(_mm256_castps128_ps256(l2), h2, 1);
+        d = _mm256_insertf128_ps(_mm256_castps128_ps256(l3), h3, 1);
+#elif defined(XO_SSE)
+        a = _mm_load_ps(f);
+        b = _mm_load_ps(f + stride);
+        c = _mm_load_ps(f + stride * 2);
+        d = _mm_load_ps(f + stride * 3);
+        _MM_TRANSPOSE4_PS(a, b, c, d);
+#else
+        (void)stride;
+        a = f[0];
+        b = f[1];
+        c = f[2];
+        d = f[3];
+#endif
+    }
+    _XOINL void StoreTransposed4(float* f, size_t stride, Float a, Float b, Float c, Float d) {
+#if defined(XO_AVX)
+        __m128 l0 = _mm256_castps256_ps128(a), l1 = _mm256_castps256_ps128(b), l2 = _mm256_castps256_ps128(c), l3 = _mm256_castps256_ps128(d);
+        __m128 h0 = _mm256_extractf128_ps(a, 1), h1 = _mm256_extractf128_ps(b, 1), h2 = _mm256_extractf128_ps(c, 1), h3 = _mm256_extractf128_ps(d, 1);
+        _MM_TRANSPOSE4_PS(l0, l1, l2, l3);
+        _MM_TRANSPOSE4_PS(h0, h1, h2, h3);
+        _mm_store_ps(f, l0); _mm_store_ps(f + stride, l1); _mm_store_ps(f + stride * 2, l2); _mm_store_ps(f + stride * 3, l3);
+        _mm_store_ps(f + stride * 4, h0); _mm_store_ps(f + stride * 5, h1); _mm_store_ps(f + stride * 6, h2); _mm_store_ps(f + stride * 7, h3);
+#elif defined(XO_SSE)
+        _MM_TRANSPOSE4_PS(a, b, c, d);
+        _mm_store_ps(f, a);
+        _mm_store_ps(f + stride, b);
+        _mm_store_ps(f + stride * 2, c);
+        _mm_store_ps(f + stride * 3, d);
+#else
+        (void)stride;
+        f[0] = a;
+        f[1] = b;
+        f[2] = c;
+        f[3] = d;
+#endif
+    }
+
+    struct Float3 {
+        Float x, y, z;
+    };
+
+    _XOINL Float3 Load(const float* x, const float* y, const float* z) {
+        Float3 v = { Load(x), Load(y), Load(z) };
+        return v;
+    }
+    _XOINL void Store(float* x, float* y, float* z, const Float3& v) {
+        Store(x, v.x);
+        Store(y, v.y);
+        Store(z, v.z);
+    }
+    _XOINL Float3 Set(float x, float y, float z) {
+        Float3 v = { Set(x), Set(y), Set(z) };
+        return v;
+    }
+    _XOINL Float3 Add(const Float3& a, const Float3& b) {
+        Float3 v = { Add(a.x, b.x), Add(a.y, b.y), Add(a.z, b.z) };
+        return v;
+    }
+    _XOINL Float3 Sub(const Float3& a, const Float3& b) {
+        Float3 v = { Sub(a.x, b.x), Sub(a.y, b.y), Sub(a.z, b.z) };
+        return v;
+    }
+    _XOINL Float3 Mul(const Float3& a, Float s) {
+        Float3 v = { Mul(a.x, s), Mul(a.y, s), Mul(a.z, s) };
+        return v;
+    }
+    _XOINL Float3 MulAdd(const Float3& a, Float s, const Float3& c) {
+        Float3 v = { MulAdd(a.x, s, c.x), MulAdd(a.y, s, c.y), MulAdd(a.z, s, c.z) };
+        return v;
+    }
+    _XOINL Float Dot(const Float3& a, const Float3& b) {
+        return MulAdd(a.x, b.x, MulAdd(a.y, b.y, Mul(a.z, b.z)));
+    }
+    _XOINL Float3 Select(Float mask, const Float3& a, const Float3& b) {
+        Float3 v = { Select(mask, a.x, b.x), Select(mask, a.y, b.y), Select(mask, a.z, b.z) };
+        return v;
+    }
+    _XOINL Float Saturate(Float a) {
+        return Min(Max(a, Zero()), Set(1.0f));
+    }
+}
+
+XOMATH_END_XO_NS();
+
+
+XOMATH_BEGIN_XO_NS();
+
+// Thread fan-out shared by the bulk builds and kernels (BVH, BoundingSphere, SpatialHashGrid, Morton, Skinning and 
+// Hierarchy).
+namespace xo_internal {
+    // The most threads one operation splits its work over.
+    _XOCONSTEXPR const unsigned MaxThreads = 64;
+
+    // The threads to split count items over: threadCount, or one per hardware thread when it's zero, at most 
+    // MaxThreads, and few enough that each gets at least share items. A share of zero doesn't limit them.
+    _XOINL unsigned ThreadCount(unsigned threadCount, size_t count, size_t share) {
+        unsigned threads = threadCount ? threadCount : std::thread::hardware_concurrency();
+        threads = _XO_MIN(_XO_MAX(threads, 1u), MaxThreads);
+        if (share) {
+            threads = (unsigned)_XO_MIN((size_t)threads, _XO_MAX(count / share, (size_t)1));
+        }
+        return threads;
+    }
+
+    // Runs task(i) for each i below count, each on its own thread. task(0) runs on the calling thread.
+    template <class Task>
+    void Parallel(unsigned count, const Task& task) {
+        std::thread threads[MaxThreads];
+        for (unsigned i = 1; i < count; ++i) {
+            threads[i] = std::thread(task, i);
+        }
+        task(0u);
+        for (unsigned i = 1; i < count; ++i) {
+            threads[i].join();
+        }
+    }
+}
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+namespace wide {
+#if defined(XO_FMA) && defined(XO_SSE)
+    _XOCONSTEXPR const float SinCosLimit = 1e6f;
+#else
+    _XOCONSTEXPR const float SinCosLimit = 8192.0f;
+#endif
+
+    _XOINL void SinCos(Float a, Float& outSin, Float& outCos) {
+        const Float k = Round(Mul(a, Set(0.636619772f)));
+        Float r = NegMulAdd(k, Set(1.5703125f), a);
+        r = NegMulAdd(k, Set(4.837512969970703125e-4f), r);
+        r = NegMulAdd(k, Set(7.549533620476723e-8f), r);
+        r = NegMulAdd(k, Set(2.5633440682570896e-12f), r);
+        const Float r2 = Mul(r, r);
+
+        Float s = MulAdd(r2, Set(-1.9515295891e-4f), Set(8.3321608736e-3f));
+        s = MulAdd(s, r2, Set(-1.6666654611e-1f));
+        s = MulAdd(Mul(s, r2), r, r);
+        Float c = MulAdd(r2, Set(2.443315711809948e-5f), Set(-1.388731625493765e-3f));
+        c = MulAdd(c, r2, Set(4.166664568298827e-2f));
+        c = MulAdd(c, Mul(r2, r2), NegMulAdd(r2, Set(0.5f), Set(1.0f)));
+
+        // The quadrant bits are found with float math, AVX (without AVX2) has no 256 bit integer operations.
+        const Float half = Floor(Mul(k, Set(0.5f)));
+        const Float bit0 = Sub(k, Add(half, half));
+        const Float bit1 = Sub(half, Mul(Floor(Mul(k, Set(0.25f))), Set(2.0f)));
+        const Float swap = CmpNeq(bit0, Zero());
+        outSin = Xor(Select(swap, c, s), And(CmpNeq(bit1, Zero()), SignBit()));
+        outCos = Xor(Select(swap, s, c), And(CmpNeq(bit0, bit1), SignBit()));
+    }
+    _XOINL Float Sin(Float a) {
+        Float s, c;
+        SinCos(a, s, c);
+        return s;
+    }
+    _XOINL Float Cos(Float a) {
+        Float s, c;
+        SinCos(a, s, c);
+        return c;
+    }
+}
+
+namespace xo_internal {
+    // Overwrites the results of the lanes set in large, those past wide::SinCosLimit, with the C library's. Either 
+    // output may be null.
+    _XOINL void SinCosLargeLanes(const float* f, float* s, float* c, int large) {
+        for (int i = 0; large; ++i, large >>= 1) {
+            if (large & 1) {
+                if (s) s[i] = sinf(f[i]);
+                if (c) c[i] = cosf(f[i]);
+            }
+        }
+    }
+
+    // wide::SinCos over Count (2 to 4) floats in 16 byte aligned memory. Lanes past Count are neither read nor 
+    // written. Either output may be null when it isn't wanted.
+    template <int Count>
+    _XOINL void SinCosQuad(const float* f, float* s, float* c) {
+#if defined(XO_SSE)
+        __m128 v = Count == 4 ? _mm_load_ps(f) : _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)f);
+        if (Count == 3) {
+            v = _mm_movelh_ps(v, _mm_load_ss(f + 2));
+        }
+        const int large = _mm_movemask_ps(_mm_cmpgt_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), v), _mm_set1_ps(wide::SinCosLimit)));
+#   if defined(XO_AVX)
+        __m256 sw, cw;
+        wide::SinCos(_mm256_insertf128_ps(_mm256_setzero_ps(), v, 0), sw, cw);
+        const __m128 sv = _mm256_castps256_ps128(sw), cv = _mm256_castps256_ps128(cw);
+#   else
+        __m128 sv, cv;
+        wide::SinCos(v, sv, cv);
+#   endif
+        float* outs[2] = { s, c };
+        const __m128 results[2] = { sv, cv };
+        for (int i = 0; i < 2; ++i) {
+            if (!outs[i]) {
+                continue;
+            }
+            if (Count == 4) {
+                _mm_store_ps(outs[i], results[i]);
+            }
+            else {
+                _mm_storel_pi((__m64*)outs[i], results[i]);
+                if (Count == 3) {
+                    _mm_store_ss(outs[i] + 2, _mm_movehl_ps(results[i], results[i]));
+                }
+            }
+        }
+        if (large) {
+            SinCosLargeLanes(f, s, c, large);
+        }
+#else
+        for (int i = 0; i < Count; ++i) {
+            float sv, cv;
+            if (Abs(f[i]) > wide::SinCosLimit) {
+                sv = sinf(f[i]);
+                cv = cosf(f[i]);
+            }
+            else {
+                wide::SinCos(f[i], sv, cv);
+            }
+            if (s) s[i] = sv;
+            if (c) c[i] = cv;
+        }
+#endif
+    }
+}
+
+_XOINL
+void SinCos(float f, float& s, float& c) {
+    if (Abs(f) > wide::SinCosLimit) {
+        s = sinf(f);
+        c = cosf(f);
+        return;
+    }
+#if defined(XO_AVX)
+    __m256 sw, cw;
+    wide::SinCos(_mm256_set1_ps(f), sw, cw);
+    s = _mm_cvtss_f32(_mm256_castps256_ps128(sw));
+    c = _mm_cvtss_f32(_mm256_castps256_ps128(cw));
+#elif defined(XO_SSE)
+    __m128 sv, cv;
+    wide::SinCos(_mm_set_ss(f), sv, cv);
+    s = _mm_cvtss_f32(sv);
+    c = _mm_cvtss_f32(cv);
+#else
+    wide::SinCos(f, s, c);
+#endif
+}
+
 _XOINL
 void Sin_x2(const float* f, float* s) {
     XO_ASSERT(IsAligned16(f) && IsAligned16(s), "xo-math Sin_x2 requires aligned params.");
-    s[0] = Sin(f[0]);
-    s[1] = Sin(f[1]);
+    xo_internal::SinCosQuad<2>(f, s, nullptr);
 }
 
 _XOINL
 void Sin_x3(const float* f, float* s) {
     XO_ASSERT(IsAligned16(f) && IsAligned16(s), "xo-math Sin_x3 requires aligned params.");
-    s[0] = Sin(f[0]);
-    s[1] = Sin(f[1]);
-    s[2] = Sin(f[2]);
+    xo_internal::SinCosQuad<3>(f, s, nullptr);
 }
 
 _XOINL
 void Sin_x4(const float* f, float* s) {
     XO_ASSERT(IsAligned16(f) && IsAligned16(s), "xo-math Sin_x4 requires aligned params.");
-    s[0] = Sin(f[0]);
-    s[1] = Sin(f[1]);
-    s[2] = Sin(f[2]);
-    s[3] = Sin(f[3]);
+    xo_internal::SinCosQuad<4>(f, s, nullptr);
 }
 
 _XOINL
 void Cos_x2(const float* f, float* c) {
     XO_ASSERT(IsAligned16(f) && IsAligned16(c), "xo-math Cos_x2 requires aligned params.");
-    c[0] = Cos(f[0]);
-    c[1] = Cos(f[1]);
+    xo_internal::SinCosQuad<2>(f, nullptr, c);
 }
 
 _XOINL
 void Cos_x3(const float* f, float* c) {
     XO_ASSERT(IsAligned16(f) && IsAligned16(c), "xo-math Cos_x3 requires aligned params.");
-    c[0] = Cos(f[0]);
-    c[1] = Cos(f[1]);
-    c[2] = Cos(f[2]);
+    xo_internal::SinCosQuad<3>(f, nullptr, c);
 }
 
 _XOINL
 void Cos_x4(const float* f, float* c) {
     XO_ASSERT(IsAligned16(f) && IsAligned16(c), "xo-math Cos_x4 requires aligned params.");
-    c[0] = Cos(f[0]);
-    c[1] = Cos(f[1]);
-    c[2] = Cos(f[2]);
-    c[3] = Cos(f[3]);
-}
-
-_XOINL
-void SinCos(float f, float& s, float& c) { 
-    s = Sin(f);
-    c = Cos(f);
+    xo_internal::SinCosQuad<4>(f, nullptr, c);
 }
 
 _XOINL
 void SinCos_x2(const float* f, float* s, float* c) {
     XO_ASSERT(IsAligned16(f) && IsAligned16(s) && IsAligned16(c), "xo-math SinCos_x2 requires aligned params.");
-    Sin_x2(f, s);
-    Cos_x2(f, c);
+    xo_internal::SinCosQuad<2>(f, s, c);
 }
 
 _XOINL
 void SinCos_x3(const float* f, float* s, float* c) {
     XO_ASSERT(IsAligned16(f) && IsAligned16(s) && IsAligned16(c), "xo-math SinCos_x3 requires aligned params.");
-    Sin_x3(f, s);
-    Cos_x3(f, c);
+    xo_internal::SinCosQuad<3>(f, s, c);
 }
 
 _XOINL
 void SinCos_x4(const float* f, float* s, float* c) {
     XO_ASSERT(IsAligned16(f) && IsAligned16(s) && IsAligned16(c), "xo-math SinCos_x4 requires aligned params.");
-    Sin_x4(f, s);
-    Cos_x4(f, c);
+    xo_internal::SinCosQuad<4>(f, s, c);
 }
 
-_XOINL
-bool CloseEnough(float x, float y, float tolerance = FloatEpsilon) {
-    return Difference(x, y) * (1.0f/tolerance) <= Min(Abs(x), Abs(y));
-}
+void SinArray(const float* f, float* outSin, size_t count);
+void CosArray(const float* f, float* outCos, size_t count);
+void SinCosArray(const float* f, float* outSin, float* outCos, size_t count);
 
-_XOCONSTEXPR _XOINL float Square(float t)      { return t*t; }
-_XOCONSTEXPR _XOINL double Square(double t)    { return t*t; }
-_XOCONSTEXPR _XOINL int Square(int t)          { return t*t; }
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+class _XOSIMDALIGN RandomGenerator {
+public:
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/random.html#constructors
+    RandomGenerator(); 
+    explicit RandomGenerator(uint64_t seed); 
+    ////////////////////////////////////////////////////////////////////////// Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/random.html#methods
+    void Seed(uint64_t seed);
+
+    uint32_t Next() {
+        uint32_t* w0 = s[0];
+        uint32_t* w1 = s[1];
+        uint32_t* w2 = s[2];
+        uint32_t* w3 = s[3];
+        const uint32_t result = w0[0] + w3[0];
+        const uint32_t t = w1[0] << 9;
+        w2[0] ^= w0[0];
+        w3[0] ^= w1[0];
+        w1[0] ^= w2[0];
+        w0[0] ^= w3[0];
+        w2[0] ^= t;
+        w3[0] = (w3[0] << 11) | (w3[0] >> 21);
+        return result;
+    }
+    float NextFloat() {
+        return (Next() >> 8) * (1.0f / 16777216.0f);
+    }
+    float Range(float low, float high) {
+        return low + (Next() >> 8) * ((high - low) * (1.0f / 16777216.0f));
+    }
+    int Range(int low, int high) {
+        XO_ASSERT(low <= high, "xo-math RandomGenerator::Range requires low <= high.");
+        const uint64_t span = (uint64_t)((int64_t)high - low) + 1;
+        return (int)(low + (int64_t)((Next() * span) >> 32));
+    }
+    bool Bool() {
+        return (Next() >> 31) != 0;
+    }
+
+    void Floats(float* outFloats, size_t count) {
+        RangeArray(0.0f, 1.0f, outFloats, count);
+    }
+    void RangeArray(float low, float high, float* outFloats, size_t count);
+
+    ////////////////////////////////////////////////////////////////////////// Static Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/random.html#static_methods
+    static RandomGenerator& ThreadLocal() {
+#if _XO_NO_TLS
+        static _XOTLS RandomGenerator* generator;
+        static _XOTLS _XOSIMDALIGN char mem[sizeof(RandomGenerator)];
+        if (!generator) {
+            generator = new(mem) RandomGenerator();
+        }
+        return *generator;
+#else
+        static _XOTLS RandomGenerator generator;
+        return generator;
+#endif
+    }
+
+private:
+    // s[word][generator]: the four state words of each generator, stored so each word of all four is one __m128i.
+    uint32_t s[4][4];
+};
 
 _XOINL 
 bool RandomBool() {
-    _XO_TLS_ENGINE
-    std::uniform_int_distribution<int> dist(0, 1);
-    return _XO_TLS_DISTRIBUTION == 1;
+    return RandomGenerator::ThreadLocal().Bool();
 }
 
 _XOINL 
 int RandomRange(int low, int high) {
-    _XO_TLS_ENGINE
-    std::uniform_int_distribution<int> dist(low, high);
-    return _XO_TLS_DISTRIBUTION;
+    return RandomGenerator::ThreadLocal().Range(low, high);
 }
 
 _XOINL 
 float RandomRange(float low, float high) {
-    _XO_TLS_ENGINE
-    std::uniform_real_distribution<float> dist(low, high);
-    return _XO_TLS_DISTRIBUTION;
+    return RandomGenerator::ThreadLocal().Range(low, high);
+}
+
+_XOINL
+void RandomRangeArray(float low, float high, float* outFloats, size_t count) {
+    RandomGenerator::ThreadLocal().RangeArray(low, high, outFloats, count);
+}
+
+_XOINL
+void RandomFloats(float* outFloats, size_t count) {
+    RandomGenerator::ThreadLocal().Floats(outFloats, count);
 }
 
 XOMATH_END_XO_NS();
 
-#if defined(XO_SSE)
-#define _XO_ASSIGN_QUAT(W, X, Y, Z) xmm = _mm_set_ps(W, Z, Y, X);
-#define _XO_ASSIGN_QUAT_Q(Q, W, X, Y, Z) Q.xmm = _mm_set_ps(W, Z, Y, X);
-#else
-#define _XO_ASSIGN_QUAT(W, X, Y, Z) this->w = W; this->x = X; this->y = Y; this->z = Z;
-#define _XO_ASSIGN_QUAT_Q(Q, W, X, Y, Z) Q.w = W; Q.x = X; Q.y = Y; Q.z = Z;
-#endif
 
-////////////////////////////////////////////////////////////////////////// Module Includes
 XOMATH_BEGIN_XO_NS();
 
 class _XOSIMDALIGN Vector2 {
@@ -528,6 +1124,21 @@ public:
         return Vector2(*this).Normalize();
     }
 
+    template <Precision P>
+    Vector2& Normalize() {
+        return (*this) *= InvSqrt<P>(MagnitudeSquared());
+    }
+    template <Precision P>
+    Vector2 Normalized() const {
+        return Vector2(*this).Normalize<P>();
+    }
+    template <Precision P = Precision::Exact>
+    float InverseMagnitude() const {
+        return InvSqrt<P>(MagnitudeSquared());
+    }
+    template <Precision P = Precision::Exact>
+    _XOINL Vector2 Reciprocal() const;
+
     ////////////////////////////////////////////////////////////////////////// Static Methods
     // See: http://xo-math.rtfd.io/en/latest/classes/vector2.html#static_methods
     static void Lerp(const Vector2& a, const Vector2& b, float t, Vector2& outVec) {
@@ -796,6 +1407,19 @@ public:
         return Vector3(*this).Normalize();
     }
 
+    template <Precision P>
+    _XOINL Vector3& Normalize();
+    template <Precision P>
+    Vector3 Normalized() const {
+        return Vector3(*this).Normalize<P>();
+    }
+    template <Precision P = Precision::Exact>
+    float InverseMagnitude() const {
+        return InvSqrt<P>(MagnitudeSquared());
+    }
+    template <Precision P = Precision::Exact>
+    _XOINL Vector3 Reciprocal() const;
+
     Vector3 NormalizedSafe() const {
         return Vector3(*this).NormalizeSafe();
     }
@@ -809,10 +1433,18 @@ public:
         outVec = a + ((b - a) * t);
     }
     static void Max(const Vector3& a, const Vector3& b, Vector3& outVec) {
+#if defined(XO_SSE)
+        outVec.xmm = _mm_max_ps(a.xmm, b.xmm);
+#else
         outVec.Set(_XO_MAX(a.x, b.x), _XO_MAX(a.y, b.y), _XO_MAX(a.z, b.z));
+#endif
     }
     static void Min(const Vector3& a, const Vector3& b, Vector3& outVec) {
+#if defined(XO_SSE)
+        outVec.xmm = _mm_min_ps(a.xmm, b.xmm);
+#else
         outVec.Set(_XO_MIN(a.x, b.x), _XO_MIN(a.y, b.y), _XO_MIN(a.z, b.z));
+#endif
     }
     static void RotateDegrees(const Vector3& v, const Vector3& axis, float angle, Vector3& outVec) {
         RotateRadians(v, axis, angle * Deg2Rad, outVec);
@@ -848,7 +1480,8 @@ public:
         Vector3::RotateRadians(forward, up, RandomRange(-angle*0.5f, angle*0.5f), outVec);
     }
     static void RandomInCube(float size, Vector3& outVec) {
-        outVec.Set(RandomRange(-size, size), RandomRange(-size, size), RandomRange(-size, size));
+        RandomGenerator& rng = RandomGenerator::ThreadLocal();
+        outVec.Set(rng.Range(-size, size), rng.Range(-size, size), rng.Range(-size, size));
     }
     static void RandomInSphere(float minRadius, float maxRadius, Vector3& outVec) {
         RandomOnSphere(Sqrt(RandomRange(minRadius, maxRadius)), outVec);
@@ -882,6 +1515,23 @@ public:
     }
 
 
+    ////////////////////////////////////////////////////////////////////////// Random Array Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3.html#random_array_methods
+    static void RandomInCircleArray(const Vector3& up, float radius, Vector3* outVecs, size_t count);
+    static void RandomInCircleArray(const Vector3& up, float radius, float* outX, float* outY, float* outZ, size_t count);
+    static void RandomOnCircleArray(const Vector3& up, float radius, Vector3* outVecs, size_t count);
+    static void RandomOnCircleArray(const Vector3& up, float radius, float* outX, float* outY, float* outZ, size_t count);
+    static void RandomInConeRadiansArray(const Vector3& forward, float angle, Vector3* outVecs, size_t count);
+    static void RandomInConeRadiansArray(const Vector3& forward, float angle, float* outX, float* outY, float* outZ, size_t count);
+    static void RandomOnConeRadiansArray(const Vector3& forward, float angle, Vector3* outVecs, size_t count);
+    static void RandomOnConeRadiansArray(const Vector3& forward, float angle, float* outX, float* outY, float* outZ, size_t count);
+    static void RandomInCubeArray(float size, Vector3* outVecs, size_t count);
+    static void RandomInCubeArray(float size, float* outX, float* outY, float* outZ, size_t count);
+    static void RandomOnCubeArray(float size, Vector3* outVecs, size_t count);
+    static void RandomOnCubeArray(float size, float* outX, float* outY, float* outZ, size_t count);
+    static void RandomOnSphereArray(float radius, Vector3* outVecs, size_t count);
+    static void RandomOnSphereArray(float radius, float* outX, float* outY, float* outZ, size_t count);
+
 #define _RET_VARIANT(name) { Vector3 tempV; name(
 #define _RET_VARIANT_END() tempV); return tempV; }
 #define _RET_VARIANT_0(name)                                 _RET_VARIANT(name)                               _RET_VARIANT_END()
@@ -1179,6 +1829,19 @@ public:
         return Vector4(*this).Normalize();
     }
 
+    template <Precision P>
+    _XOINL Vector4& Normalize();
+    template <Precision P>
+    Vector4 Normalized() const {
+        return Vector4(*this).Normalize<P>();
+    }
+    template <Precision P = Precision::Exact>
+    float InverseMagnitude() const {
+        return InvSqrt<P>(MagnitudeSquared());
+    }
+    template <Precision P = Precision::Exact>
+    _XOINL Vector4 Reciprocal() const;
+
     Vector3 NormalizedSafe() const {
         return Vector3(*this).NormalizeSafe();
     }
@@ -1189,10 +1852,18 @@ public:
         outVec = a + ((b - a) * t);
     }
     static void Max(const Vector4& a, const Vector4& b, Vector4& outVec) {
+#if defined(XO_SSE)
+        outVec.xmm = _mm_max_ps(a.xmm, b.xmm);
+#else
         outVec.Set(_XO_MAX(a.x, b.x), _XO_MAX(a.y, b.y), _XO_MAX(a.z, b.z), _XO_MAX(a.w, b.w));
+#endif
     }
     static void Min(const Vector4& a, const Vector4& b, Vector4& outVec) {
+#if defined(XO_SSE)
+        outVec.xmm = _mm_min_ps(a.xmm, b.xmm);
+#else
         outVec.Set(_XO_MIN(a.x, b.x), _XO_MIN(a.y, b.y), _XO_MIN(a.z, b.z), _XO_MIN(a.w, b.w));
+#endif
     }
     static float Distance(const Vector4&a, const Vector4&b) {
         return (b - a).Magnitude();
@@ -1295,6 +1966,7 @@ public:
     Matrix4x4(const Vector4& r0, const Vector4& r1, const Vector4& r2, const Vector4& r3);
     Matrix4x4(const Vector3& r0, const Vector3& r1, const Vector3& r2);
     Matrix4x4(const class Quaternion& q);
+    explicit Matrix4x4(const class Matrix3x4& m);
 
 
     Matrix4x4& SetRow(int i, const Vector4& r);
@@ -1341,10 +2013,26 @@ public:
     const Matrix4x4& Transform(Vector3& v) const;
     const Matrix4x4& Transform(Vector4& v) const;
 
+    const Matrix4x4& TransformPoints(const Vector3* vecs, Vector3* outVecs, size_t count) const;
+    const Matrix4x4& TransformPoints(Vector3* vecs, size_t count) const { return TransformPoints(vecs, vecs, count); }
+    const Matrix4x4& TransformPoints(const float* xyz, float* outXyz, size_t count) const;
+    const Matrix4x4& TransformPoints(float* xyz, size_t count) const { return TransformPoints(xyz, xyz, count); }
+    const Matrix4x4& TransformDirections(const Vector3* vecs, Vector3* outVecs, size_t count) const;
+    const Matrix4x4& TransformDirections(Vector3* vecs, size_t count) const { return TransformDirections(vecs, vecs, count); }
+    const Matrix4x4& TransformDirections(const float* xyz, float* outXyz, size_t count) const;
+    const Matrix4x4& TransformDirections(float* xyz, size_t count) const { return TransformDirections(xyz, xyz, count); }
+
     Matrix4x4 Transposed() const;
 
     ////////////////////////////////////////////////////////////////////////// Static Methods
     // See: http://xo-math.rtfd.io/en/latest/classes/matrix4x4.html#static_methods
+    _XOINL static void Multiply(const Matrix4x4& a, const Matrix4x4& b, Matrix4x4& outMatrix);
+    static void MultiplyArray(const Matrix4x4* a, const Matrix4x4* b, Matrix4x4* outMatrices, size_t count);
+    static void MultiplyArray(const Matrix4x4& a, const Matrix4x4* b, Matrix4x4* outMatrices, size_t count);
+    static void MultiplyArray(const Matrix4x4* a, const Matrix4x4& b, Matrix4x4* outMatrices, size_t count);
+    static void InverseArray(const Matrix4x4* matrices, Matrix4x4* outMatrices, size_t count);
+    static bool TryInverseArray(const Matrix4x4* matrices, Matrix4x4* outMatrices, size_t count, uint32_t* outSingularMask = nullptr);
+    static void InverseRigidArray(const Matrix4x4* matrices, Matrix4x4* outMatrices, size_t count);
     static void Scale(float xyz, Matrix4x4& outMatrix);
     static void Scale(float x, float y, float z, Matrix4x4& outMatrix);
     static void Scale(const Vector3& v, Matrix4x4& outMatrix);
@@ -1431,30 +2119,113 @@ XOMATH_END_XO_NS();
 
 XOMATH_BEGIN_XO_NS();
 
-class _XOSIMDALIGN Quaternion {
+class _XOSIMDALIGN Matrix3x4 {
 public:
-    Quaternion();
-    Quaternion(const Matrix4x4& m);
-    Quaternion(float x, float y, float z, float w);
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/matrix3x4.html#constructors
+    Matrix3x4(); 
+    Matrix3x4(float m00, float m01, float m02, float m03,
+              float m10, float m11, float m12, float m13,
+              float m20, float m21, float m22, float m23);
+    Matrix3x4(const Matrix3x4& m);
+    Matrix3x4(const Vector4& r0, const Vector4& r1, const Vector4& r2);
+    Matrix3x4(const Vector3& r0, const Vector3& r1, const Vector3& r2, const Vector3& translation);
+    explicit Matrix3x4(const Matrix4x4& m);
 
+    ////////////////////////////////////////////////////////////////////////// Special Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/matrix3x4.html#special_operators
     _XO_OVERLOAD_NEW_DELETE();
+    const Vector4& operator [](int i) const { return r[i]; }
+    Vector4& operator [](int i) { return r[i]; }
+    const float& operator ()(int r, int c) const { return this->r[r][c]; }
+    float& operator ()(int r, int c) { return this->r[r][c]; }
+
+    ////////////////////////////////////////////////////////////////////////// Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/matrix3x4.html#operators
+    _XOINL Matrix3x4& operator *= (const Matrix3x4& m);
+    _XOINL Matrix3x4 operator * (const Matrix3x4& m) const;
+    _XOINL Vector3 operator * (const Vector3& v) const;
 
-    _XOINL float& operator [](int i);
-    _XOINL const float& operator [](int i) const;
+    ////////////////////////////////////////////////////////////////////////// Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/matrix3x4.html#methods
+    Vector3 GetTranslation() const { return Vector3(r[0].w, r[1].w, r[2].w); }
+    Matrix3x4& SetTranslation(const Vector3& t) { r[0].w = t.x; r[1].w = t.y; r[2].w = t.z; return *this; }
+    _XOINL Vector3 TransformPoint(const Vector3& v) const;
+    _XOINL Vector3 TransformDirection(const Vector3& v) const;
+    float Determinant() const;
+    void MakeInverse();
+    void GetInverse(Matrix3x4& o) const { o = *this; o.MakeInverse(); }
+    bool TryMakeInverse();
+    bool TryGetInverse(Matrix3x4& o) const { o = *this; return o.TryMakeInverse(); }
+    void MakeInverseRigid();
 
-    _XOINL Quaternion& operator *= (const Quaternion& q);
-    _XOINL Quaternion operator * (const Quaternion& q) const;
+    const Matrix3x4& TransformPoints(const Vector3* vecs, Vector3* outVecs, size_t count) const;
+    const Matrix3x4& TransformDirections(const Vector3* vecs, Vector3* outVecs, size_t count) const;
 
-    _XOINL bool operator == (const Quaternion& q) const;
-    _XOINL bool operator != (const Quaternion& q) const;
+    ////////////////////////////////////////////////////////////////////////// Static Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/matrix3x4.html#static_methods
+    _XOINL static void Multiply(const Matrix3x4& a, const Matrix3x4& b, Matrix3x4& outMatrix);
+    static void MultiplyArray(const Matrix3x4* a, const Matrix3x4* b, Matrix3x4* outMatrices, size_t count);
+    static void MultiplyArray(const Matrix3x4& a, const Matrix3x4* b, Matrix3x4* outMatrices, size_t count);
+    static void InverseArray(const Matrix3x4* matrices, Matrix3x4* outMatrices, size_t count);
 
-    Quaternion& MakeConjugate();
-    Quaternion& MakeInverse();
-    Quaternion& Normalize();
-    Quaternion Conjugate() const;
-    Quaternion Inverse() const;
-    Quaternion Normalized() const;
-    void GetAxisAngleRadians(Vector3& axis, float& radians) const;
+    ////////////////////////////////////////////////////////////////////////// Extras
+    // See: http://xo-math.rtfd.io/en/latest/classes/matrix3x4.html#extras
+#ifndef XO_NO_OSTREAM
+    friend std::ostream& operator <<(std::ostream& os, const Matrix3x4& m) {
+        os << "\nrow 0: " << m.r[0] << "\nrow 1: " << m.r[1] << "\nrow 2: " << m.r[2] << "\n";
+        return os;
+    }
+#endif
+
+    union {
+        Vector4 r[3];
+        float m[12];
+        struct {
+            float   m00, m01, m02, m03,
+                    m10, m11, m12, m13,
+                    m20, m21, m22, m23;
+        };
+    };
+
+    static const Matrix3x4
+        Identity;
+};
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+class _XOSIMDALIGN Quaternion {
+public:
+    Quaternion();
+    Quaternion(const Matrix4x4& m);
+    Quaternion(float x, float y, float z, float w);
+
+    _XO_OVERLOAD_NEW_DELETE();
+
+    _XOINL float& operator [](int i);
+    _XOINL const float& operator [](int i) const;
+
+    _XOINL Quaternion& operator *= (const Quaternion& q);
+    _XOINL Quaternion operator * (const Quaternion& q) const;
+
+    _XOINL bool operator == (const Quaternion& q) const;
+    _XOINL bool operator != (const Quaternion& q) const;
+
+    Quaternion& MakeConjugate();
+    Quaternion& MakeInverse();
+    Quaternion& Normalize();
+    Quaternion Conjugate() const;
+    Quaternion Inverse() const;
+    Quaternion Normalized() const;
+    template <Precision P>
+    _XOINL Quaternion& Normalize();
+    template <Precision P>
+    Quaternion Normalized() const {
+        return Quaternion(*this).Normalize<P>();
+    }
+    void GetAxisAngleRadians(Vector3& axis, float& radians) const;
 
     static void AxisAngleRadians(const Vector3& axis, float radians, Quaternion& outQuat);
     static void Lerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat);
@@ -1465,6 +2236,9 @@ public:
     static void RotationRadians(const Vector3& v, Quaternion& outQuat);
     static void RotationRadians(float x, float y, float z, Quaternion& outQuat);
     static void Slerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat);
+    static void Nlerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat);
+    static void SlerpArray(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* outQuats, size_t count);
+    static void NlerpArray(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* outQuats, size_t count);
 
 #define _RET_VARIANT(name) { Quaternion tempV; name(
 #define _RET_VARIANT_END() tempV); return tempV; }
@@ -1478,6 +2252,7 @@ public:
 
     static Quaternion AxisAngleRadians(const Vector3& axis, float radians)                          _RET_VARIANT_2(AxisAngleRadians, axis, radians)
     static Quaternion Lerp(const Quaternion& a, const Quaternion& b, float t)                       _RET_VARIANT_3(Lerp, a, b, t)
+    static Quaternion Nlerp(const Quaternion& a, const Quaternion& b, float t)                      _RET_VARIANT_3(Nlerp, a, b, t)
     static Quaternion LookAtFromDirection(const Vector3& direction)                                 _RET_VARIANT_1(LookAtFromDirection, direction)
     static Quaternion LookAtFromDirection(const Vector3& direction, const Vector3& up)              _RET_VARIANT_2(LookAtFromDirection, direction, up)
     static Quaternion LookAtFromPosition(const Vector3& from, const Vector3& to)                    _RET_VARIANT_2(LookAtFromPosition, from, to)
@@ -1531,920 +2306,2856 @@ private:
 
 XOMATH_END_XO_NS();
 
-
 XOMATH_BEGIN_XO_NS();
 
-float& Vector2::operator [](int i) { return f[i]; }
-const float& Vector2::operator [](int i) const { return f[i]; }
+class Vector3Stream {
+public:
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3stream.html#constructors
+    Vector3Stream(); 
+    explicit Vector3Stream(size_t count); 
+    Vector3Stream(const Vector3* vecs, size_t count); 
+    Vector3Stream(const Vector3Stream& stream); 
+    Vector3Stream(Vector3Stream&& stream); 
+    ~Vector3Stream();
 
-Vector2 Vector2::operator - () const { return Vector2(-x, -y); }
-Vector2 Vector2::operator ~ () const { return Vector2(y, x); }
+    ////////////////////////////////////////////////////////////////////////// Set / Get Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3stream.html#set_get_methods
+    void Resize(size_t count);
+    void Set(const Vector3* vecs, size_t count);
+    void Set(size_t i, const Vector3& v) {
+        XO_ASSERT(i < size, "xo-math Vector3Stream::Set index out of range.");
+        x[i] = v.x;
+        y[i] = v.y;
+        z[i] = v.z;
+    }
+    void Get(Vector3* vecs) const;
+    Vector3 Get(size_t i) const {
+        XO_ASSERT(i < size, "xo-math Vector3Stream::Get index out of range.");
+        return Vector3(x[i], y[i], z[i]);
+    }
+    size_t Size() const { return size; }
+    size_t Capacity() const { return capacity; }
+
+    float* X() { return x; } 
+    float* Y() { return y; } 
+    float* Z() { return z; } 
+    const float* X() const { return x; } 
+    const float* Y() const { return y; } 
+    const float* Z() const { return z; } 
+
+    ////////////////////////////////////////////////////////////////////////// Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3stream.html#operators
+    Vector3Stream& operator = (const Vector3Stream& stream);
+    Vector3Stream& operator = (Vector3Stream&& stream);
+    Vector3Stream& operator += (const Vector3Stream& stream) { Add(*this, stream, *this); return *this; }
+    Vector3Stream& operator -= (const Vector3Stream& stream) { Subtract(*this, stream, *this); return *this; }
+    Vector3Stream& operator *= (const Vector3Stream& stream) { Multiply(*this, stream, *this); return *this; }
+    Vector3Stream& operator *= (float f) { Scale(*this, f, *this); return *this; }
 
-Vector2& Vector2::operator += (const Vector2& v) {
-    x += v.x;
-    y += v.y;
-    return *this; 
-}
-Vector2& Vector2::operator += (float v) {
-    x += v;
-    y += v;
-    return *this; 
-}
-Vector2& Vector2::operator += (double v)                  { return *this += (float)v; }
-Vector2& Vector2::operator += (int v)                     { return *this += (float)v; }
-Vector2& Vector2::operator += (const class Vector3& v)    { return *this += Vector2(v); }
-Vector2& Vector2::operator += (const class Vector4& v)    { return *this += Vector2(v); }
+    ////////////////////////////////////////////////////////////////////////// Static Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/vector3stream.html#static_methods
+    static void Add(const Vector3Stream& a, const Vector3Stream& b, Vector3Stream& outStream);
+    static void Add(const Vector3Stream& a, const Vector3& v, Vector3Stream& outStream);
+    static void Subtract(const Vector3Stream& a, const Vector3Stream& b, Vector3Stream& outStream);
+    static void Multiply(const Vector3Stream& a, const Vector3Stream& b, Vector3Stream& outStream);
+    static void Scale(const Vector3Stream& a, float f, Vector3Stream& outStream);
+    static void Lerp(const Vector3Stream& a, const Vector3Stream& b, float t, Vector3Stream& outStream);
+    static void Cross(const Vector3Stream& a, const Vector3Stream& b, Vector3Stream& outStream);
+    static void Normalize(const Vector3Stream& a, Vector3Stream& outStream);
+    static void Dot(const Vector3Stream& a, const Vector3Stream& b, float* outFloats);
+    static void Magnitude(const Vector3Stream& a, float* outFloats);
+    static void MagnitudeSquared(const Vector3Stream& a, float* outFloats);
 
-Vector2& Vector2::operator -= (const Vector2& v) {
-    x -= v.x;
-    y -= v.y;
-    return *this; 
-}
-Vector2& Vector2::operator -= (float v) {
-    x -= v;
-    y -= v;
-    return *this; 
-}
-Vector2& Vector2::operator -= (double v)                  { return *this -= (float)v; }
-Vector2& Vector2::operator -= (int v)                     { return *this -= (float)v; }
-Vector2& Vector2::operator -= (const class Vector3& v)    { return *this -= Vector2(v); }
-Vector2& Vector2::operator -= (const class Vector4& v)    { return *this -= Vector2(v); }
+private:
+    void Allocate(size_t count);
+    void Release();
+
+    float* x;
+    float* y;
+    float* z;
+    size_t size;
+    size_t capacity;
+};
 
-Vector2& Vector2::operator *= (const Vector2& v) {
-    x *= v.x;
-    y *= v.y;
-    return *this; 
-}
-Vector2& Vector2::operator *= (float v) {
-    x *= v;
-    y *= v;
-    return *this;
-}
-Vector2& Vector2::operator *= (double v)                  { return *this *= (float)v; }
-Vector2& Vector2::operator *= (int v)                     { return *this *= (float)v; }
-Vector2& Vector2::operator *= (const class Vector3& v)    { return *this *= Vector2(v); }
-Vector2& Vector2::operator *= (const class Vector4& v)    { return *this *= Vector2(v); }
+XOMATH_END_XO_NS();
 
-Vector2& Vector2::operator /= (const Vector2& v) {
-    x /= v.x;
-    y /= v.y;
-    return *this;
-}
-Vector2& Vector2::operator /= (float v) {
-#if defined(XO_NO_INVERSE_DIVISION)
-    x /= v;
-    y /= v;
-    return *this;
-#else
-    return (*this) *= (1.0f/v);
+
+XOMATH_BEGIN_XO_NS();
+
+class _XOSIMDALIGN AABB {
+public:
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/aabb.html#constructors
+    AABB() { } 
+    AABB(const Vector3& min, const Vector3& max) : min(min), max(max) { } 
+    ////////////////////////////////////////////////////////////////////////// Set / Get Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/aabb.html#set_get_methods
+    AABB& Set(const Vector3& min, const Vector3& max) {
+        this->min = min;
+        this->max = max;
+        return *this;
+    }
+    _XOINL Vector3 Center() const;
+    _XOINL Vector3 Extents() const;
+    _XOINL Vector3 Size() const;
+    float SurfaceArea() const;
+    float Volume() const;
+    _XOINL bool IsEmpty() const;
+
+    ////////////////////////////////////////////////////////////////////////// Special Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/aabb.html#special_operators
+    _XO_OVERLOAD_NEW_DELETE();
+
+    ////////////////////////////////////////////////////////////////////////// Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/aabb.html#methods
+    _XOINL AABB& Expand(const Vector3& point);
+    _XOINL AABB& Expand(const AABB& box);
+    _XOINL AABB& Expand(float amount);
+    _XOINL bool Contains(const Vector3& point) const;
+    _XOINL bool Contains(const AABB& box) const;
+    _XOINL bool Overlaps(const AABB& box) const;
+    _XOINL Vector3 ClosestPoint(const Vector3& point) const;
+    _XOINL float DistanceSquared(const Vector3& point) const;
+    void ClosestPoints(const Vector3Stream& points, Vector3Stream& outPoints, float* outDistancesSquared = nullptr) const;
+    _XOINL Vector3 Support(const Vector3& direction) const;
+    AABB Transformed(const Matrix4x4& m) const {
+        AABB box;
+        Transform(*this, m, box);
+        return box;
+    }
+
+    ////////////////////////////////////////////////////////////////////////// Static Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/aabb.html#static_methods
+    static AABB FromCenterExtents(const Vector3& center, const Vector3& extents) {
+        return AABB(center - extents, center + extents);
+    }
+    static AABB FromPoints(const Vector3* points, size_t count);
+    _XOINL static void Union(const AABB& a, const AABB& b, AABB& outBox);
+    _XOINL static bool Intersection(const AABB& a, const AABB& b, AABB& outBox);
+    static void Transform(const AABB& box, const Matrix4x4& m, AABB& outBox);
+    static void TransformArray(const Matrix4x4& m, const AABB* boxes, AABB* outBoxes, size_t count);
+
+    static AABB Union(const AABB& a, const AABB& b) {
+        AABB box;
+        Union(a, b, box);
+        return box;
+    }
+
+#ifndef XO_NO_OSTREAM
+    ////////////////////////////////////////////////////////////////////////// Extras
+    // See: http://xo-math.rtfd.io/en/latest/classes/aabb.html#extras
+    friend std::ostream& operator <<(std::ostream& os, const AABB& box) {
+        os << "(min:" << box.min << ", max:" << box.max << ")";
+        return os;
+    }
 #endif
-    
-}
-Vector2& Vector2::operator /= (double v)                  { return *this /= (float)v; }
-Vector2& Vector2::operator /= (int v)                     { return *this /= (float)v; }
-Vector2& Vector2::operator /= (const class Vector3& v)    { return *this /= Vector2(v); }
-Vector2& Vector2::operator /= (const class Vector4& v)    { return *this /= Vector2(v); }
 
-Vector2 Vector2::operator + (const Vector2& v) const        { return Vector2(*this) += v; }
-Vector2 Vector2::operator + (float v) const                 { return Vector2(*this) += v; }
-Vector2 Vector2::operator + (double v) const                { return Vector2(*this) += v; }
-Vector2 Vector2::operator + (int v) const                   { return Vector2(*this) += v; }
-Vector2 Vector2::operator + (const class Vector3& v) const  { return Vector2(*this) += v; }
-Vector2 Vector2::operator + (const class Vector4& v) const  { return Vector2(*this) += v; }
+    ////////////////////////////////////////////////////////////////////////// Static Attributes
+    // See: http://xo-math.rtfd.io/en/latest/classes/aabb.html#public_static_attributes
+    static const AABB Empty;
 
-Vector2 Vector2::operator - (const Vector2& v) const        { return Vector2(*this) -= v; }
-Vector2 Vector2::operator - (float v) const                 { return Vector2(*this) -= v; }
-Vector2 Vector2::operator - (double v) const                { return Vector2(*this) -= v; }
-Vector2 Vector2::operator - (int v) const                   { return Vector2(*this) -= v; }
-Vector2 Vector2::operator - (const class Vector3& v) const  { return Vector2(*this) -= v; }
-Vector2 Vector2::operator - (const class Vector4& v) const  { return Vector2(*this) -= v; }
+    ////////////////////////////////////////////////////////////////////////// Members
+    // See: http://xo-math.rtfd.io/en/latest/classes/aabb.html#public_members
+    Vector3 min; 
+    Vector3 max; 
+};
 
-Vector2 Vector2::operator * (const Vector2& v) const        { return Vector2(*this) *= v; }
-Vector2 Vector2::operator * (float v) const                 { return Vector2(*this) *= v; }
-Vector2 Vector2::operator * (double v) const                { return Vector2(*this) *= v; }
-Vector2 Vector2::operator * (int v) const                   { return Vector2(*this) *= v; }
-Vector2 Vector2::operator * (const class Vector3& v) const  { return Vector2(*this) *= v; }
-Vector2 Vector2::operator * (const class Vector4& v) const  { return Vector2(*this) *= v; }
+XOMATH_END_XO_NS();
 
-Vector2 Vector2::operator / (const Vector2& v) const        { return Vector2(*this) /= v; }
-Vector2 Vector2::operator / (float v) const                 { return Vector2(*this) /= v; }
-Vector2 Vector2::operator / (double v) const                { return Vector2(*this) /= v; }
-Vector2 Vector2::operator / (int v) const                   { return Vector2(*this) /= v; }
-Vector2 Vector2::operator / (const class Vector3& v) const  { return Vector2(*this) /= v; }
-Vector2 Vector2::operator / (const class Vector4& v) const  { return Vector2(*this) /= v; }
+XOMATH_BEGIN_XO_NS();
 
-bool Vector2::operator < (const Vector2& v) const           { return MagnitudeSquared() < v.MagnitudeSquared(); }
-bool Vector2::operator < (float v) const                    { return MagnitudeSquared() < (v * v); }
-bool Vector2::operator < (double v) const                   { return MagnitudeSquared() < (float)(v * v); }
-bool Vector2::operator < (int v) const                      { return MagnitudeSquared() < (float)(v * v); }
-bool Vector2::operator < (const class Vector3& v) const     { return MagnitudeSquared() < v.MagnitudeSquared(); }
-bool Vector2::operator < (const class Vector4& v) const     { return MagnitudeSquared() < v.MagnitudeSquared(); }
+enum class ClipDepth {
+    ZeroToOne,          
+    NegativeOneToOne    
+};
 
-bool Vector2::operator <= (const Vector2& v) const          { return MagnitudeSquared() <= v.MagnitudeSquared(); }
-bool Vector2::operator <= (float v) const                   { return MagnitudeSquared() <= (v * v); }
-bool Vector2::operator <= (double v) const                  { return MagnitudeSquared() <= (float)(v * v); }
-bool Vector2::operator <= (int v) const                     { return MagnitudeSquared() <= (float)(v * v); }
-bool Vector2::operator <= (const class Vector3& v) const    { return MagnitudeSquared() <= v.MagnitudeSquared(); }
-bool Vector2::operator <= (const class Vector4& v) const    { return MagnitudeSquared() <= v.MagnitudeSquared(); }
+class _XOSIMDALIGN Frustum {
+public:
+    enum PlaneIndex {
+        Left,
+        Right,
+        Bottom,
+        Top,
+        Near,
+        Far,
+        PlaneCount
+    };
+    static const uint32_t AllPlanes = (1 << PlaneCount) - 1;
 
-bool Vector2::operator > (const Vector2& v) const           { return MagnitudeSquared() > v.MagnitudeSquared(); }
-bool Vector2::operator > (float v) const                    { return MagnitudeSquared() > (v * v); }
-bool Vector2::operator > (double v) const                   { return MagnitudeSquared() > (float)(v * v); }
-bool Vector2::operator > (int v) const                      { return MagnitudeSquared() > (float)(v * v); }
-bool Vector2::operator > (const class Vector3& v) const     { return MagnitudeSquared() > v.MagnitudeSquared(); }
-bool Vector2::operator > (const class Vector4& v) const     { return MagnitudeSquared() > v.MagnitudeSquared(); }
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/frustum.html#constructors
+    Frustum() { } 
+    Frustum(const Matrix4x4& viewProjection, ClipDepth depth = ClipDepth::ZeroToOne) {
+        Set(viewProjection, depth);
+    }
 
-bool Vector2::operator >= (const Vector2& v) const          { return MagnitudeSquared() >= v.MagnitudeSquared(); }
-bool Vector2::operator >= (float v) const                   { return MagnitudeSquared() >= (v * v); }
-bool Vector2::operator >= (double v) const                  { return MagnitudeSquared() >= (float)(v * v); }
-bool Vector2::operator >= (int v) const                     { return MagnitudeSquared() >= (float)(v * v); }
-bool Vector2::operator >= (const class Vector3& v) const    { return MagnitudeSquared() >= v.MagnitudeSquared(); }
-bool Vector2::operator >= (const class Vector4& v) const    { return MagnitudeSquared() >= v.MagnitudeSquared(); }
+    ////////////////////////////////////////////////////////////////////////// Set / Get Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/frustum.html#set_get_methods
+    Frustum& Set(const Matrix4x4& viewProjection, ClipDepth depth = ClipDepth::ZeroToOne);
 
-bool Vector2::operator == (const Vector2& v) const {
-    return CloseEnough(x, v.x, Epsilon) && CloseEnough(x, v.x, Epsilon);
-}
-bool Vector2::operator == (float v) const                   { return CloseEnough(MagnitudeSquared(), v*v, Epsilon); }
-bool Vector2::operator == (double v) const                  { return *this == (float)(v*v); }
-bool Vector2::operator == (int v) const                     { return *this == (float)(v*v); }
-bool Vector2::operator == (const class Vector3& v) const {
-#   if defined(XO_SSE2)
-    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(_mm_set_ps(0.0f, 0.0f, y, x), v.xmm)), sse::Epsilon)) & 3) == 3;
-#   else
-    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon);
-#   endif
-}
-bool Vector2::operator == (const class Vector4& v) const {
-#   if defined(XO_SSE)
-    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(_mm_set_ps(0.0f, 0.0f, y, x), v.xmm)), sse::Epsilon)) & 3) == 3;
-#   else
-    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon);
-#   endif
-}
+    ////////////////////////////////////////////////////////////////////////// Special Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/frustum.html#special_operators
+    _XO_OVERLOAD_NEW_DELETE();
 
-bool Vector2::operator != (const Vector2& v) const          { return !((*this) == v); }
-bool Vector2::operator != (float v) const                   { return !((*this) == v); }
-bool Vector2::operator != (double v) const                  { return !((*this) == v); }
-bool Vector2::operator != (int v) const                     { return !((*this) == v); }
-bool Vector2::operator != (const class Vector3& v) const    { return !((*this) == v); }
-bool Vector2::operator != (const class Vector4& v) const    { return !((*this) == v); }
+    ////////////////////////////////////////////////////////////////////////// Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/frustum.html#methods
+    _XOINL bool Contains(const Vector3& point) const;
+    _XOINL bool IntersectsSphere(const Vector3& center, float radius) const;
+    _XOINL bool IntersectsSphere(const Vector3& center, float radius, uint32_t& inOutPlaneMask) const;
+    _XOINL bool IntersectsAABB(const AABB& box) const;
+    _XOINL bool IntersectsAABB(const AABB& box, uint32_t& inOutPlaneMask) const;
+
+    ////////////////////////////////////////////////////////////////////////// Batch Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/frustum.html#batch_methods
+    size_t CullSpheres(const Vector4* spheres, size_t count, uint32_t* outVisibleBits, uint32_t planeMask = AllPlanes) const;
+    size_t CullSpheresIndices(const Vector4* spheres, size_t count, uint32_t* outIndices, uint32_t planeMask = AllPlanes) const;
+    size_t CullAABBs(const AABB* boxes, size_t count, uint32_t* outVisibleBits, uint32_t planeMask = AllPlanes) const;
+    size_t CullAABBsIndices(const AABB* boxes, size_t count, uint32_t* outIndices, uint32_t planeMask = AllPlanes) const;
 
-_XOINL 
-Vector2 Abs(const Vector2& v)
-{
-    return Vector2(Abs(v.x), Abs(v.y));
-}
+    ////////////////////////////////////////////////////////////////////////// Members
+    // See: http://xo-math.rtfd.io/en/latest/classes/frustum.html#public_members
+    Vector4 planes[PlaneCount];
+};
 
 XOMATH_END_XO_NS();
 
 XOMATH_BEGIN_XO_NS();
 
-#if defined(XO_SSE)
-Vector3::operator __m128() const {
-    return xmm;
-}
-#endif
+class _XOSIMDALIGN Ray {
+public:
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/ray.html#constructors
+    Ray() { } 
+    Ray(const Vector3& origin, const Vector3& direction) : origin(origin), direction(direction) { } 
+    ////////////////////////////////////////////////////////////////////////// Set / Get Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/ray.html#set_get_methods
+    Ray& Set(const Vector3& origin, const Vector3& direction) {
+        this->origin = origin;
+        this->direction = direction;
+        return *this;
+    }
+    Vector3 PointAt(float t) const {
+        return origin + direction * t;
+    }
 
-float& Vector3::operator [](int i) {
-    return f[i];
-}
+    ////////////////////////////////////////////////////////////////////////// Special Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/ray.html#special_operators
+    _XO_OVERLOAD_NEW_DELETE();
 
-const float& Vector3::operator [](int i) const {
-    return f[i];
-}
+    ////////////////////////////////////////////////////////////////////////// Intersection Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/ray.html#intersection_methods
+    _XOINL bool IntersectTriangle(const Vector3& v0, const Vector3& v1, const Vector3& v2, float& inOutT, float& outU, float& outV) const;
+    _XOINL bool IntersectAABB(const AABB& box, float& inOutT) const;
+    _XOINL bool IntersectSphere(const Vector3& center, float radius, float& inOutT) const;
+    bool IntersectTriangles(const Vector3* vertices, size_t count, float& inOutT, float& outU, float& outV, size_t& outIndex) const;
 
-Vector3 Vector3::operator -() const {
+#ifndef XO_NO_OSTREAM
+    ////////////////////////////////////////////////////////////////////////// Extras
+    // See: http://xo-math.rtfd.io/en/latest/classes/ray.html#extras
+    friend std::ostream& operator <<(std::ostream& os, const Ray& ray) {
+        os << "(origin:" << ray.origin << ", direction:" << ray.direction << ")";
+        return os;
+    }
+#endif
+
+    ////////////////////////////////////////////////////////////////////////// Members
+    // See: http://xo-math.rtfd.io/en/latest/classes/ray.html#public_members
+    Vector3 origin;
+    Vector3 direction; 
+};
+
+template <int N>
+class _XOSIMDALIGN RayPacket {
+    static_assert(N == 4 || N == 8, "xo-math RayPacket holds 4 or 8 rays.");
+public:
+    static const int Size = N;
+
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/ray.html#constructors
+    RayPacket() { } 
+    explicit RayPacket(const Ray* rays) { Set(rays); } 
+    ////////////////////////////////////////////////////////////////////////// Set / Get Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/ray.html#set_get_methods
+    RayPacket& Set(const Ray* rays) {
+        for (int i = 0; i < N; ++i) {
+            Set(i, rays[i]);
+        }
+        return *this;
+    }
+    RayPacket& Set(int i, const Ray& ray) {
+        XO_ASSERT(i >= 0 && i < N, "xo-math RayPacket::Set index out of range.");
+        originX[i] = ray.origin.x;
+        originY[i] = ray.origin.y;
+        originZ[i] = ray.origin.z;
+        directionX[i] = ray.direction.x;
+        directionY[i] = ray.direction.y;
+        directionZ[i] = ray.direction.z;
+        inverseDirectionX[i] = 1.0f / ray.direction.x;
+        inverseDirectionY[i] = 1.0f / ray.direction.y;
+        inverseDirectionZ[i] = 1.0f / ray.direction.z;
+        return *this;
+    }
+    Ray Get(int i) const {
+        XO_ASSERT(i >= 0 && i < N, "xo-math RayPacket::Get index out of range.");
+        return Ray(Vector3(originX[i], originY[i], originZ[i]), Vector3(directionX[i], directionY[i], directionZ[i]));
+    }
+
+    ////////////////////////////////////////////////////////////////////////// Special Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/ray.html#special_operators
+    _XO_OVERLOAD_NEW_DELETE();
+
+    ////////////////////////////////////////////////////////////////////////// Intersection Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/ray.html#intersection_methods
+    int IntersectTriangle(const Vector3& v0, const Vector3& v1, const Vector3& v2, float* inOutT, float* outU, float* outV) const;
+    int IntersectAABB(const AABB& box, float* inOutT) const;
+    int IntersectSphere(const Vector3& center, float radius, float* inOutT) const;
+
+    ////////////////////////////////////////////////////////////////////////// Members
+    // See: http://xo-math.rtfd.io/en/latest/classes/ray.html#public_members
+    // Write rays with Set, which keeps the inverse directions used by the slab test up to date.
+    float originX[N], originY[N], originZ[N];
+    float directionX[N], directionY[N], directionZ[N];
+    float inverseDirectionX[N], inverseDirectionY[N], inverseDirectionZ[N];
+};
+
+typedef RayPacket<4> RayPacket4;
+typedef RayPacket<8> RayPacket8;
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+class BVH {
+public:
+    struct Node {
+        float minX[4], minY[4], minZ[4];
+        float maxX[4], maxY[4], maxZ[4];
+        uint32_t child[4];
+        uint32_t count[4];
+    };
+
+    static const uint32_t LeafBit = 0x80000000u;
+    static const int MaxLeafSize = 16;
+
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/bvh.html#constructors
+    BVH(); 
+    BVH(const BVH& bvh); 
+    BVH(BVH&& bvh); 
+    ~BVH();
+
+    ////////////////////////////////////////////////////////////////////////// Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/bvh.html#operators
+    BVH& operator = (const BVH& bvh);
+    BVH& operator = (BVH&& bvh);
+
+    ////////////////////////////////////////////////////////////////////////// Building
+    // See: http://xo-math.rtfd.io/en/latest/classes/bvh.html#building
+    void Build(const AABB* bounds, size_t count, int leafSize = 4, unsigned threadCount = 0);
+    void BuildTriangles(const Vector3* vertices, size_t count, int leafSize = 4, unsigned threadCount = 0);
+    void Refit(const AABB* bounds);
+    void RefitTriangles(const Vector3* vertices);
+    void Clear();
+
+    ////////////////////////////////////////////////////////////////////////// Queries
+    // See: http://xo-math.rtfd.io/en/latest/classes/bvh.html#queries
+    bool IntersectTriangles(const Ray& ray, const Vector3* vertices, float& inOutT, float& outU, float& outV, uint32_t& outIndex) const;
+    size_t QueryRay(const Ray& ray, float maxT, uint32_t* outIndices) const;
+    size_t QueryAABB(const AABB& box, uint32_t* outIndices) const;
+    size_t QueryFrustum(const Frustum& frustum, uint32_t* outIndices) const;
+
+    ////////////////////////////////////////////////////////////////////////// Get Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/bvh.html#get_methods
+    AABB Bounds() const;
+    size_t PrimitiveCount() const { return primitiveCount; }
+    size_t NodeCount() const { return nodeCount; }
+    const Node* Nodes() const { return nodes; }
+    const uint32_t* Indices() const { return indices; }
+
+private:
+    void Allocate(size_t nodes, size_t primitives);
+    void Release();
+
+    Node* nodes;
+    uint32_t* indices;
+    size_t nodeCount;
+    size_t primitiveCount;
+};
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+class _XOSIMDALIGN BoundingSphere {
+public:
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/boundingsphere.html#constructors
+    BoundingSphere() { } 
+    BoundingSphere(const Vector3& center, float radius) : center(center), radius(radius) { } 
+    ////////////////////////////////////////////////////////////////////////// Set / Get Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/boundingsphere.html#set_get_methods
+    BoundingSphere& Set(const Vector3& center, float radius) {
+        this->center = center;
+        this->radius = radius;
+        return *this;
+    }
+    bool IsEmpty() const {
+        return radius < 0.0f;
+    }
+
+    ////////////////////////////////////////////////////////////////////////// Special Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/boundingsphere.html#special_operators
+    _XO_OVERLOAD_NEW_DELETE();
+
+    ////////////////////////////////////////////////////////////////////////// Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/boundingsphere.html#methods
+    _XOINL BoundingSphere& Expand(const Vector3& point);
+    _XOINL BoundingSphere& Expand(const BoundingSphere& sphere);
+    _XOINL bool Contains(const Vector3& point) const;
+    _XOINL bool Contains(const BoundingSphere& sphere) const;
+    _XOINL bool Overlaps(const BoundingSphere& sphere) const;
+    _XOINL Vector3 Support(const Vector3& direction) const;
+
+    ////////////////////////////////////////////////////////////////////////// Static Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/boundingsphere.html#static_methods
+    static BoundingSphere FromPoints(const Vector3* points, size_t count, unsigned threadCount = 0);
+    static BoundingSphere FromPointsRitter(const Vector3* points, size_t count, unsigned threadCount = 0);
+    static BoundingSphere FromPointsExact(const Vector3* points, size_t count);
+
+#ifndef XO_NO_OSTREAM
+    ////////////////////////////////////////////////////////////////////////// Extras
+    // See: http://xo-math.rtfd.io/en/latest/classes/boundingsphere.html#extras
+    friend std::ostream& operator <<(std::ostream& os, const BoundingSphere& sphere) {
+        os << "(center:" << sphere.center << ", radius:" << sphere.radius << ")";
+        return os;
+    }
+#endif
+
+    ////////////////////////////////////////////////////////////////////////// Static Attributes
+    // See: http://xo-math.rtfd.io/en/latest/classes/boundingsphere.html#public_static_attributes
+    static const BoundingSphere Empty;
+
+    ////////////////////////////////////////////////////////////////////////// Members
+    // See: http://xo-math.rtfd.io/en/latest/classes/boundingsphere.html#public_members
+    Vector3 center;
+    float radius; 
+};
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+enum class PlaneSide : uint8_t {
+    On = 0,         
+    Front = 1,      
+    Back = 2,       
+    Straddling = 3  
+};
+
+class _XOSIMDALIGN Plane {
+public:
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/plane.html#constructors
+    Plane() { } 
+    Plane(const Vector3& normal, float d) : normal(normal), d(d) { } 
+    explicit Plane(const Vector4& v) : normal(v.x, v.y, v.z), d(v.w) { }
+
+    ////////////////////////////////////////////////////////////////////////// Set / Get Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/plane.html#set_get_methods
+    Plane& Set(const Vector3& normal, float d) {
+        this->normal = normal;
+        this->d = d;
+        return *this;
+    }
+    Vector4 ToVector4() const {
+        return Vector4(normal.x, normal.y, normal.z, d);
+    }
+
+    ////////////////////////////////////////////////////////////////////////// Special Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/plane.html#special_operators
+    _XO_OVERLOAD_NEW_DELETE();
+
+    ////////////////////////////////////////////////////////////////////////// Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/plane.html#methods
+    Plane& Normalize();
+    Plane Normalized() const {
+        return Plane(*this).Normalize();
+    }
+    Plane& Transform(const Matrix4x4& m);
+    Plane& TransformByInverse(const Matrix4x4& inverse);
+    Plane Transformed(const Matrix4x4& m) const {
+        return Plane(*this).Transform(m);
+    }
+    _XOINL float SignedDistance(const Vector3& point) const;
+    _XOINL Vector3 ClosestPoint(const Vector3& point) const;
+    _XOINL PlaneSide Classify(const Vector3& point, float epsilon = 0.0f) const;
+
+    ////////////////////////////////////////////////////////////////////////// Array Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/plane.html#array_methods
+    void SignedDistances(const Vector3* points, size_t count, float* outDistances) const;
+    void SignedDistances(const Vector3Stream& points, float* outDistances) const;
+    PlaneSide ClassifyPoints(const Vector3* points, size_t count, PlaneSide* outSides = nullptr, float epsilon = 0.0f) const;
+    PlaneSide ClassifyPoints(const Vector3Stream& points, PlaneSide* outSides = nullptr, float epsilon = 0.0f) const;
+
+    ////////////////////////////////////////////////////////////////////////// Static Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/plane.html#static_methods
+    static Plane FromPointNormal(const Vector3& point, const Vector3& normal) {
+        return Plane(normal, -(normal.x * point.x + normal.y * point.y + normal.z * point.z));
+    }
+    static Plane FromPoints(const Vector3& a, const Vector3& b, const Vector3& c);
+
+#ifndef XO_NO_OSTREAM
+    ////////////////////////////////////////////////////////////////////////// Extras
+    // See: http://xo-math.rtfd.io/en/latest/classes/plane.html#extras
+    friend std::ostream& operator <<(std::ostream& os, const Plane& plane) {
+        os << "(normal:" << plane.normal << ", d:" << plane.d << ")";
+        return os;
+    }
+#endif
+
+    ////////////////////////////////////////////////////////////////////////// Members
+    // See: http://xo-math.rtfd.io/en/latest/classes/plane.html#public_members
+    Vector3 normal; 
+    float d;        
+};
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+class _XOSIMDALIGN Segment {
+public:
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/segment.html#constructors
+    Segment() { } 
+    Segment(const Vector3& start, const Vector3& end) : start(start), end(end) { } 
+    ////////////////////////////////////////////////////////////////////////// Set / Get Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/segment.html#set_get_methods
+    Segment& Set(const Vector3& start, const Vector3& end) {
+        this->start = start;
+        this->end = end;
+        return *this;
+    }
+    Vector3 PointAt(float t) const {
+        return start + (end - start) * t;
+    }
+
+    ////////////////////////////////////////////////////////////////////////// Special Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/segment.html#special_operators
+    _XO_OVERLOAD_NEW_DELETE();
+
+    ////////////////////////////////////////////////////////////////////////// Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/segment.html#methods
+    Vector3 ClosestPoint(const Vector3& point) const;
+    float ClosestPoints(const Segment& segment, Vector3& outPoint, Vector3& outSegmentPoint) const;
+    Vector3 Support(const Vector3& direction) const {
+        return direction.Dot(end - start) > 0.0f ? end : start;
+    }
+
+    ////////////////////////////////////////////////////////////////////////// Stream Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/segment.html#stream_methods
+    static void ClosestPoints(const Vector3Stream& points, const Vector3Stream& starts, const Vector3Stream& ends, Vector3Stream& outPoints, float* outDistancesSquared = nullptr);
+    static void ClosestPoints(const Vector3Stream& starts1, const Vector3Stream& ends1, const Vector3Stream& starts2, const Vector3Stream& ends2, 
+                              Vector3Stream& outPoints1, Vector3Stream& outPoints2, float* outDistancesSquared = nullptr);
+
+#ifndef XO_NO_OSTREAM
+    ////////////////////////////////////////////////////////////////////////// Extras
+    // See: http://xo-math.rtfd.io/en/latest/classes/segment.html#extras
+    friend std::ostream& operator <<(std::ostream& os, const Segment& segment) {
+        os << "(start:" << segment.start << ", end:" << segment.end << ")";
+        return os;
+    }
+#endif
+
+    ////////////////////////////////////////////////////////////////////////// Members
+    // See: http://xo-math.rtfd.io/en/latest/classes/segment.html#public_members
+    Vector3 start;
+    Vector3 end;
+};
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+class _XOSIMDALIGN Triangle {
+public:
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/triangle.html#constructors
+    Triangle() { } 
+    Triangle(const Vector3& v0, const Vector3& v1, const Vector3& v2) : v0(v0), v1(v1), v2(v2) { } 
+    ////////////////////////////////////////////////////////////////////////// Set / Get Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/triangle.html#set_get_methods
+    Triangle& Set(const Vector3& v0, const Vector3& v1, const Vector3& v2) {
+        this->v0 = v0;
+        this->v1 = v1;
+        this->v2 = v2;
+        return *this;
+    }
+
+    ////////////////////////////////////////////////////////////////////////// Special Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/triangle.html#special_operators
+    _XO_OVERLOAD_NEW_DELETE();
+
+    ////////////////////////////////////////////////////////////////////////// Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/triangle.html#methods
+    Vector3 ClosestPoint(const Vector3& point) const;
+    Vector3 Support(const Vector3& direction) const {
+        const float d0 = direction.Dot(v0), d1 = direction.Dot(v1), d2 = direction.Dot(v2);
+        return d0 >= d1 ? (d0 >= d2 ? v0 : v2) : (d1 >= d2 ? v1 : v2);
+    }
+
+    ////////////////////////////////////////////////////////////////////////// Stream Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/triangle.html#stream_methods
+    static void ClosestPoints(const Vector3Stream& points, const Vector3Stream& v0, const Vector3Stream& v1, const Vector3Stream& v2, 
+                              Vector3Stream& outPoints, float* outDistancesSquared = nullptr);
+
+#ifndef XO_NO_OSTREAM
+    ////////////////////////////////////////////////////////////////////////// Extras
+    // See: http://xo-math.rtfd.io/en/latest/classes/triangle.html#extras
+    friend std::ostream& operator <<(std::ostream& os, const Triangle& triangle) {
+        os << "(v0:" << triangle.v0 << ", v1:" << triangle.v1 << ", v2:" << triangle.v2 << ")";
+        return os;
+    }
+#endif
+
+    ////////////////////////////////////////////////////////////////////////// Members
+    // See: http://xo-math.rtfd.io/en/latest/classes/triangle.html#public_members
+    Vector3 v0;
+    Vector3 v1;
+    Vector3 v2;
+};
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+class _XOSIMDALIGN OBB {
+public:
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/obb.html#constructors
+    OBB() { } 
+    OBB(const Vector3& center, const Vector3& axisX, const Vector3& axisY, const Vector3& axisZ, const Vector3& extents) {
+        Set(center, axisX, axisY, axisZ, extents);
+    }
+    explicit OBB(const AABB& box) {
+        Set(box.Center(), Vector3::UnitX, Vector3::UnitY, Vector3::UnitZ, box.Extents());
+    }
+
+    ////////////////////////////////////////////////////////////////////////// Set / Get Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/obb.html#set_get_methods
+    OBB& Set(const Vector3& center, const Vector3& axisX, const Vector3& axisY, const Vector3& axisZ, const Vector3& extents) {
+        this->center = center;
+        axes[0] = axisX;
+        axes[1] = axisY;
+        axes[2] = axisZ;
+        this->extents = extents;
+        return *this;
+    }
+
+    ////////////////////////////////////////////////////////////////////////// Special Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/obb.html#special_operators
+    _XO_OVERLOAD_NEW_DELETE();
+
+    ////////////////////////////////////////////////////////////////////////// Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/obb.html#methods
+    Vector3 ClosestPoint(const Vector3& point) const;
+    float DistanceSquared(const Vector3& point) const;
+    void ClosestPoints(const Vector3Stream& points, Vector3Stream& outPoints, float* outDistancesSquared = nullptr) const;
+    Vector3 Support(const Vector3& direction) const {
+        return center + axes[0] * (direction.Dot(axes[0]) < 0.0f ? -extents.x : extents.x) + 
+                        axes[1] * (direction.Dot(axes[1]) < 0.0f ? -extents.y : extents.y) + 
+                        axes[2] * (direction.Dot(axes[2]) < 0.0f ? -extents.z : extents.z);
+    }
+
+#ifndef XO_NO_OSTREAM
+    ////////////////////////////////////////////////////////////////////////// Extras
+    // See: http://xo-math.rtfd.io/en/latest/classes/obb.html#extras
+    friend std::ostream& operator <<(std::ostream& os, const OBB& box) {
+        os << "(center:" << box.center << ", axes:" << box.axes[0] << box.axes[1] << box.axes[2] << ", extents:" << box.extents << ")";
+        return os;
+    }
+#endif
+
+    ////////////////////////////////////////////////////////////////////////// Members
+    // See: http://xo-math.rtfd.io/en/latest/classes/obb.html#public_members
+    Vector3 center;
+    Vector3 axes[3];    
+    Vector3 extents;    
+};
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+class SpatialHashGrid {
+public:
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/spatialhashgrid.html#constructors
+    SpatialHashGrid(); 
+    SpatialHashGrid(const SpatialHashGrid& grid); 
+    SpatialHashGrid(SpatialHashGrid&& grid); 
+    ~SpatialHashGrid();
+
+    ////////////////////////////////////////////////////////////////////////// Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/spatialhashgrid.html#operators
+    SpatialHashGrid& operator = (const SpatialHashGrid& grid);
+    SpatialHashGrid& operator = (SpatialHashGrid&& grid);
+
+    ////////////////////////////////////////////////////////////////////////// Building
+    // See: http://xo-math.rtfd.io/en/latest/classes/spatialhashgrid.html#building
+    void Build(const Vector3* points, size_t count, float cellSize, unsigned threadCount = 0);
+    void Build(const Vector3Stream& points, float cellSize, unsigned threadCount = 0);
+    void Clear();
+
+    ////////////////////////////////////////////////////////////////////////// Queries
+    // See: http://xo-math.rtfd.io/en/latest/classes/spatialhashgrid.html#queries
+    size_t QueryRadius(const Vector3& center, float radius, uint32_t* outIndices, uint32_t* scratch = nullptr) const;
+
+    ////////////////////////////////////////////////////////////////////////// Get Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/spatialhashgrid.html#get_methods
+    size_t PointCount() const { return pointCount; }
+    float CellSize() const { return cellSize; }
+    size_t BucketCount() const { return bucketCount; }
+    const uint32_t* Indices() const { return indices; }
+    const uint32_t* BucketStarts() const { return bucketStarts; }
+    size_t QueryScratchSize() const { return (bucketCount + 31) / 32; }
+
+private:
+    template <class Points>
+    void BuildPoints(const Points& points, size_t count, float cellSize, unsigned threadCount);
+    uint32_t Bucket(int x, int y, int z) const;
+    void Reserve(size_t points, size_t buckets, unsigned threads);
+    void Release();
+
+    // One allocation holds the x, y and z of the points ordered by bucket, each padded by a group of wide::Width so 
+    // partial groups can be loaded, then their indices and their buckets in input order.
+    float* x;
+    float* y;
+    float* z;
+    uint32_t* indices;
+    uint32_t* pointBuckets;
+    uint32_t* bucketStarts;
+    // Each build thread's count of points per bucket, then its next free place in each bucket.
+    uint32_t* threadCounts;
+    size_t pointCapacity;
+    size_t bucketCapacity;
+    size_t threadCountsCapacity;
+    size_t pointCount;
+    size_t bucketCount;
+    float cellSize;
+    float inverseCellSize;
+};
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+class GJK {
+public:
+    static const int MaxIterations = 64;
+    static const float Tolerance;
+
+    struct Cache {
+        Cache() : direction(0.0f) { } 
+        Vector3 direction;
+    };
+
+    struct Simplex {
+        Vector3 points[4];      
+        Vector3 supportsA[4];   
+        Vector3 supportsB[4];   
+        float weights[4];       
+        int count;              
+
+        void Add(const Vector3& supportA, const Vector3& supportB) {
+            supportsA[count] = supportA;
+            supportsB[count] = supportB;
+            points[count] = supportA - supportB;
+            weights[count] = 0.0f;
+            ++count;
+        }
+        Vector3 Reduce();
+        bool Contains(const Vector3& point) const;
+        Vector3 PointA() const;
+        Vector3 PointB() const;
+    };
+
+    template <class Shape>
+    struct Rounded {
+        Rounded(const Shape& shape, float radius) : shape(shape), radius(radius) { }
+        Vector3 Support(const Vector3& direction) const {
+            const float lengthSquared = direction.MagnitudeSquared();
+            const Vector3 point = shape.Support(direction);
+            return lengthSquared > 0.0f ? point + direction * (radius / Sqrt(lengthSquared)) : point;
+        }
+        const Shape& shape;
+        float radius;
+    };
+
+    struct Hull {
+        Hull(const Vector3* points, size_t count) : points(points), count(count) { }
+        Vector3 Support(const Vector3& direction) const;
+        const Vector3* points;
+        size_t count;
+    };
+
+    ////////////////////////////////////////////////////////////////////////// Queries
+    // See: http://xo-math.rtfd.io/en/latest/classes/gjk.html#queries
+    template <class ShapeA, class ShapeB>
+    static bool Intersects(const ShapeA& a, const ShapeB& b, Cache* cache = nullptr);
+    template <class ShapeA, class ShapeB>
+    static float Distance(const ShapeA& a, const ShapeB& b, Vector3& outPointA, Vector3& outPointB, Cache* cache = nullptr);
+    template <class ShapeA, class ShapeB>
+    static bool Run(const ShapeA& a, const ShapeB& b, Simplex& outSimplex, Cache* cache, bool stopWhenSeparated);
+};
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+class EPA {
+public:
+    static const int MaxIterations = 64;
+    static const int MaxVertices = 128;
+    static const int MaxFaces = MaxVertices * 2;
+    static const float Tolerance;
+
+    struct Polytope {
+        struct Face {
+            Vector3 normal;     
+            float distance;     
+            int vertices[3];    
+        };
+
+        bool Start(const GJK::Simplex& simplex);
+        bool Expand(const Vector3& supportA, const Vector3& supportB);
+        int ClosestFace() const;
+        void Contact(int face, Vector3& outPointA, Vector3& outPointB) const;
+
+        Vector3 points[MaxVertices];
+        Vector3 supportsA[MaxVertices];
+        Vector3 supportsB[MaxVertices];
+        Face faces[MaxFaces];
+        int vertexCount;
+        int faceCount;
+        float size;             
+    };
+
+    ////////////////////////////////////////////////////////////////////////// Queries
+    // See: http://xo-math.rtfd.io/en/latest/classes/epa.html#queries
+    template <class ShapeA, class ShapeB>
+    static bool Penetration(const ShapeA& a, const ShapeB& b, Vector3& outNormal, float& outDepth, Vector3& outPointA, Vector3& outPointB, GJK::Cache* cache = nullptr);
+
+private:
+    template <class ShapeA, class ShapeB>
+    static bool Complete(const ShapeA& a, const ShapeB& b, GJK::Simplex& simplex);
+};
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+class Morton {
+public:
+    static const uint32_t Max30 = 1023;     
+    static const uint32_t Max63 = 2097151;  
+
+    ////////////////////////////////////////////////////////////////////////// Encoding
+    // See: http://xo-math.rtfd.io/en/latest/classes/morton.html#encoding
+    static uint32_t Encode30(uint32_t x, uint32_t y, uint32_t z);
+    static uint64_t Encode63(uint32_t x, uint32_t y, uint32_t z);
+    static void Decode30(uint32_t code, uint32_t& outX, uint32_t& outY, uint32_t& outZ);
+    static void Decode63(uint64_t code, uint32_t& outX, uint32_t& outY, uint32_t& outZ);
+
+    static uint32_t Encode30(const Vector3& point, const AABB& bounds);
+    static uint64_t Encode63(const Vector3& point, const AABB& bounds);
+    static void Encode30(const Vector3* points, size_t count, const AABB& bounds, uint32_t* outCodes);
+    static void Encode30(const Vector3Stream& points, const AABB& bounds, uint32_t* outCodes);
+    static void Encode63(const Vector3* points, size_t count, const AABB& bounds, uint64_t* outCodes);
+    static void Encode63(const Vector3Stream& points, const AABB& bounds, uint64_t* outCodes);
+
+    ////////////////////////////////////////////////////////////////////////// Sorting
+    // See: http://xo-math.rtfd.io/en/latest/classes/morton.html#sorting
+    static void Sort(uint32_t* keys, uint32_t* indices, size_t count, unsigned threadCount = 0, 
+                     uint32_t* scratchKeys = nullptr, uint32_t* scratchIndices = nullptr);
+    static void Sort(uint64_t* keys, uint32_t* indices, size_t count, unsigned threadCount = 0, 
+                     uint64_t* scratchKeys = nullptr, uint32_t* scratchIndices = nullptr);
+    static void Order(const Vector3* points, size_t count, const AABB& bounds, uint32_t* outOrder, unsigned threadCount = 0);
+    static void Order(const Vector3Stream& points, const AABB& bounds, uint32_t* outOrder, unsigned threadCount = 0);
+
+    ////////////////////////////////////////////////////////////////////////// Permuting
+    // See: http://xo-math.rtfd.io/en/latest/classes/morton.html#permuting
+    template <class T>
+    static void Permute(const T* items, const uint32_t* order, size_t count, T* outItems);
+    static void Permute(const Vector3Stream& points, const uint32_t* order, Vector3Stream& outPoints);
+};
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+class _XOSIMDALIGN Transform {
+public:
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/transform.html#constructors
+    Transform(); 
+    Transform(const Vector3& translation, const Quaternion& rotation, const Vector3& scale);
+    Transform(const Vector3& translation, const Quaternion& rotation);
+
+    ////////////////////////////////////////////////////////////////////////// Special Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/transform.html#special_operators
+    _XO_OVERLOAD_NEW_DELETE();
+
+    ////////////////////////////////////////////////////////////////////////// Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/transform.html#operators
+    _XOINL Transform& operator *= (const Transform& t);
+    _XOINL Transform operator * (const Transform& t) const;
+    _XOINL Vector3 operator * (const Vector3& v) const;
+
+    ////////////////////////////////////////////////////////////////////////// Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/transform.html#methods
+    _XOINL Vector3 TransformPoint(const Vector3& v) const;
+    _XOINL Vector3 TransformDirection(const Vector3& v) const;
+    _XOINL Vector3 InverseTransformPoint(const Vector3& v) const;
+    Transform& MakeInverse();
+    Transform Inverse() const { return Transform(*this).MakeInverse(); }
+    void ToMatrix(Matrix4x4& outMatrix) const;
+    void ToMatrix(Matrix3x4& outMatrix) const;
+    Matrix4x4 ToMatrix4x4() const { Matrix4x4 m; ToMatrix(m); return m; }
+    Matrix3x4 ToMatrix3x4() const { Matrix3x4 m; ToMatrix(m); return m; }
+
+    const Transform& TransformPoints(const Vector3* vecs, Vector3* outVecs, size_t count) const;
+
+    ////////////////////////////////////////////////////////////////////////// Static Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/transform.html#static_methods
+    _XOINL static Vector3 Rotate(const Quaternion& q, const Vector3& v);
+    _XOINL static void Multiply(const Transform& a, const Transform& b, Transform& outTransform);
+    static void MultiplyArray(const Transform* a, const Transform* b, Transform* outTransforms, size_t count);
+    static void MultiplyArray(const Transform& a, const Transform* b, Transform* outTransforms, size_t count);
+    static void ToMatrixArray(const Transform* transforms, Matrix4x4* outMatrices, size_t count);
+    static void ToMatrixArray(const Transform* transforms, Matrix3x4* outMatrices, size_t count);
+    static void Lerp(const Transform& a, const Transform& b, float t, Transform& outTransform);
+    static void Slerp(const Transform& a, const Transform& b, float t, Transform& outTransform);
+
+    ////////////////////////////////////////////////////////////////////////// Extras
+    // See: http://xo-math.rtfd.io/en/latest/classes/transform.html#extras
+#ifndef XO_NO_OSTREAM
+    friend std::ostream& operator <<(std::ostream& os, const Transform& t) {
+        os << "\ntranslation: " << t.translation << "\nrotation: (x:" << t.rotation.x << ", y:" << t.rotation.y << ", z:" 
+           << t.rotation.z << ", w:" << t.rotation.w << ")\nscale: " << t.scale << "\n";
+        return os;
+    }
+#endif
+
+    Vector3 translation;
+    Quaternion rotation;
+    Vector3 scale;
+
+    static const Transform
+        Identity; 
+};
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+class _XOSIMDALIGN DualQuaternion {
+public:
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/dualquaternion.html#constructors
+    DualQuaternion(); 
+    DualQuaternion(const Quaternion& real, const Quaternion& dual);
+    DualQuaternion(const Quaternion& rotation, const Vector3& translation);
+    explicit DualQuaternion(const Transform& t);
+
+    ////////////////////////////////////////////////////////////////////////// Special Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/dualquaternion.html#special_operators
+    _XO_OVERLOAD_NEW_DELETE();
+
+    ////////////////////////////////////////////////////////////////////////// Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/dualquaternion.html#operators
+    _XOINL DualQuaternion& operator *= (const DualQuaternion& q);
+    _XOINL DualQuaternion operator * (const DualQuaternion& q) const;
+    _XOINL Vector3 operator * (const Vector3& v) const;
+
+    ////////////////////////////////////////////////////////////////////////// Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/dualquaternion.html#methods
+    const Quaternion& GetRotation() const { return real; }
+    _XOINL Vector3 GetTranslation() const;
+    _XOINL Vector3 TransformPoint(const Vector3& v) const;
+    _XOINL Vector3 TransformDirection(const Vector3& v) const;
+    DualQuaternion& Normalize();
+    DualQuaternion Normalized() const { return DualQuaternion(*this).Normalize(); }
+    DualQuaternion& MakeInverse();
+    DualQuaternion Inverse() const { return DualQuaternion(*this).MakeInverse(); }
+    void ToMatrix(Matrix3x4& outMatrix) const;
+    Transform ToTransform() const { return Transform(GetTranslation(), real); }
+
+    ////////////////////////////////////////////////////////////////////////// Static Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/dualquaternion.html#static_methods
+    _XOINL static void Multiply(const DualQuaternion& a, const DualQuaternion& b, DualQuaternion& outQuat);
+    static void Nlerp(const DualQuaternion& a, const DualQuaternion& b, float t, DualQuaternion& outQuat);
+
+    Quaternion real;
+    Quaternion dual;
+
+    static const DualQuaternion
+        Identity; 
+};
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+class Skinning {
+public:
+    static const int Influences = 4; 
+
+    ////////////////////////////////////////////////////////////////////////// Linear Blend Skinning
+    // See: http://xo-math.rtfd.io/en/latest/classes/skinning.html#linear_blend_skinning
+    static void LinearBlend(const Matrix3x4* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                            const Vector3Stream& positions, const Vector3Stream& normals, 
+                            Vector3Stream& outPositions, Vector3Stream& outNormals, unsigned threadCount = 0);
+    static void LinearBlend(const Matrix3x4* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                            const Vector3Stream& positions, Vector3Stream& outPositions, unsigned threadCount = 0);
+    static void LinearBlend(const Matrix3x4* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                            const Vector3* positions, const Vector3* normals, Vector3* outPositions, Vector3* outNormals, 
+                            size_t count, unsigned threadCount = 0);
+    static void LinearBlend(const Matrix4x4* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                            const Vector3Stream& positions, const Vector3Stream& normals, 
+                            Vector3Stream& outPositions, Vector3Stream& outNormals, unsigned threadCount = 0);
+    static void LinearBlend(const Matrix4x4* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                            const Vector3Stream& positions, Vector3Stream& outPositions, unsigned threadCount = 0);
+    static void LinearBlend(const Matrix4x4* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                            const Vector3* positions, const Vector3* normals, Vector3* outPositions, Vector3* outNormals, 
+                            size_t count, unsigned threadCount = 0);
+
+    ////////////////////////////////////////////////////////////////////////// Dual Quaternion Skinning
+    // See: http://xo-math.rtfd.io/en/latest/classes/skinning.html#dual_quaternion_skinning
+    static void DualQuaternionBlend(const DualQuaternion* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                                    const Vector3Stream& positions, const Vector3Stream& normals, 
+                                    Vector3Stream& outPositions, Vector3Stream& outNormals, unsigned threadCount = 0);
+    static void DualQuaternionBlend(const DualQuaternion* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                                    const Vector3Stream& positions, Vector3Stream& outPositions, unsigned threadCount = 0);
+    static void DualQuaternionBlend(const DualQuaternion* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                                    const Vector3* positions, const Vector3* normals, Vector3* outPositions, Vector3* outNormals, 
+                                    size_t count, unsigned threadCount = 0);
+};
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+class Hierarchy {
+public:
+    static const uint32_t NoParent = 0xFFFFFFFF; 
+
+    ////////////////////////////////////////////////////////////////////////// Constructors
+    // See: http://xo-math.rtfd.io/en/latest/classes/hierarchy.html#constructors
+    Hierarchy(); 
+    Hierarchy(const uint32_t* parents, size_t count);
+    Hierarchy(const Hierarchy& hierarchy); 
+    Hierarchy(Hierarchy&& hierarchy); 
+    ~Hierarchy();
+
+    ////////////////////////////////////////////////////////////////////////// Set / Get Methods
+    // See: http://xo-math.rtfd.io/en/latest/classes/hierarchy.html#set_get_methods
+    void Build(const uint32_t* parents, size_t count);
+    size_t Size() const { return size; }
+    size_t LevelCount() const { return levelCount; }
+    const uint32_t* Nodes() const { return nodes; }
+    const uint32_t* Parents() const { return parents; }
+    const uint32_t* LevelOffsets() const { return levelOffsets; }
+    bool IsLevelOrder() const { return levelOrder; }
+    void LevelOrderParents(uint32_t* outParents) const;
+
+    ////////////////////////////////////////////////////////////////////////// Operators
+    // See: http://xo-math.rtfd.io/en/latest/classes/hierarchy.html#operators
+    Hierarchy& operator = (const Hierarchy& hierarchy);
+    Hierarchy& operator = (Hierarchy&& hierarchy);
+
+    ////////////////////////////////////////////////////////////////////////// Updating
+    // See: http://xo-math.rtfd.io/en/latest/classes/hierarchy.html#updating
+    void Update(const Matrix4x4* locals, Matrix4x4* outWorlds, unsigned threadCount = 0) const;
+    void Update(const Matrix3x4* locals, Matrix3x4* outWorlds, unsigned threadCount = 0) const;
+    void Update(const Transform* locals, Matrix3x4* outWorlds, unsigned threadCount = 0) const;
+    void Update(const Transform* locals, Matrix4x4* outWorlds, unsigned threadCount = 0) const;
+
+private:
+    void Allocate(size_t count);
+    void Release();
+
+    uint32_t* nodes;
+    uint32_t* parents;
+    uint32_t* levelOffsets;
+    size_t size;
+    size_t capacity;
+    size_t levelCount;
+    bool levelOrder;
+};
+
+XOMATH_END_XO_NS();
+
+
+XOMATH_BEGIN_XO_NS();
+
+float& Vector2::operator [](int i) { return f[i]; }
+const float& Vector2::operator [](int i) const { return f[i]; }
+
+Vector2 Vector2::operator - () const { return Vector2(-x, -y); }
+Vector2 Vector2::operator ~ () const { return Vector2(y, x); }
+
+Vector2& Vector2::operator += (const Vector2& v) {
+    x += v.x;
+    y += v.y;
+    return *this; 
+}
+Vector2& Vector2::operator += (float v) {
+    x += v;
+    y += v;
+    return *this; 
+}
+Vector2& Vector2::operator += (double v)                  { return *this += (float)v; }
+Vector2& Vector2::operator += (int v)                     { return *this += (float)v; }
+Vector2& Vector2::operator += (const class Vector3& v)    { return *this += Vector2(v); }
+Vector2& Vector2::operator += (const class Vector4& v)    { return *this += Vector2(v); }
+
+Vector2& Vector2::operator -= (const Vector2& v) {
+    x -= v.x;
+    y -= v.y;
+    return *this; 
+}
+Vector2& Vector2::operator -= (float v) {
+    x -= v;
+    y -= v;
+    return *this; 
+}
+Vector2& Vector2::operator -= (double v)                  { return *this -= (float)v; }
+Vector2& Vector2::operator -= (int v)                     { return *this -= (float)v; }
+Vector2& Vector2::operator -= (const class Vector3& v)    { return *this -= Vector2(v); }
+Vector2& Vector2::operator -= (const class Vector4& v)    { return *this -= Vector2(v); }
+
+Vector2& Vector2::operator *= (const Vector2& v) {
+    x *= v.x;
+    y *= v.y;
+    return *this; 
+}
+Vector2& Vector2::operator *= (float v) {
+    x *= v;
+    y *= v;
+    return *this;
+}
+Vector2& Vector2::operator *= (double v)                  { return *this *= (float)v; }
+Vector2& Vector2::operator *= (int v)                     { return *this *= (float)v; }
+Vector2& Vector2::operator *= (const class Vector3& v)    { return *this *= Vector2(v); }
+Vector2& Vector2::operator *= (const class Vector4& v)    { return *this *= Vector2(v); }
+
+Vector2& Vector2::operator /= (const Vector2& v) {
+    x /= v.x;
+    y /= v.y;
+    return *this;
+}
+Vector2& Vector2::operator /= (float v) {
+#if defined(XO_NO_INVERSE_DIVISION)
+    x /= v;
+    y /= v;
+    return *this;
+#else
+    return (*this) *= (1.0f/v);
+#endif
+    
+}
+Vector2& Vector2::operator /= (double v)                  { return *this /= (float)v; }
+Vector2& Vector2::operator /= (int v)                     { return *this /= (float)v; }
+Vector2& Vector2::operator /= (const class Vector3& v)    { return *this /= Vector2(v); }
+Vector2& Vector2::operator /= (const class Vector4& v)    { return *this /= Vector2(v); }
+
+Vector2 Vector2::operator + (const Vector2& v) const        { return Vector2(*this) += v; }
+Vector2 Vector2::operator + (float v) const                 { return Vector2(*this) += v; }
+Vector2 Vector2::operator + (double v) const                { return Vector2(*this) += v; }
+Vector2 Vector2::operator + (int v) const                   { return Vector2(*this) += v; }
+Vector2 Vector2::operator + (const class Vector3& v) const  { return Vector2(*this) += v; }
+Vector2 Vector2::operator + (const class Vector4& v) const  { return Vector2(*this) += v; }
+
+Vector2 Vector2::operator - (const Vector2& v) const        { return Vector2(*this) -= v; }
+Vector2 Vector2::operator - (float v) const                 { return Vector2(*this) -= v; }
+Vector2 Vector2::operator - (double v) const                { return Vector2(*this) -= v; }
+Vector2 Vector2::operator - (int v) const                   { return Vector2(*this) -= v; }
+Vector2 Vector2::operator - (const class Vector3& v) const  { return Vector2(*this) -= v; }
+Vector2 Vector2::operator - (const class Vector4& v) const  { return Vector2(*this) -= v; }
+
+Vector2 Vector2::operator * (const Vector2& v) const        { return Vector2(*this) *= v; }
+Vector2 Vector2::operator * (float v) const                 { return Vector2(*this) *= v; }
+Vector2 Vector2::operator * (double v) const                { return Vector2(*this) *= v; }
+Vector2 Vector2::operator * (int v) const                   { return Vector2(*this) *= v; }
+Vector2 Vector2::operator * (const class Vector3& v) const  { return Vector2(*this) *= v; }
+Vector2 Vector2::operator * (const class Vector4& v) const  { return Vector2(*this) *= v; }
+
+Vector2 Vector2::operator / (const Vector2& v) const        { return Vector2(*this) /= v; }
+Vector2 Vector2::operator / (float v) const                 { return Vector2(*this) /= v; }
+Vector2 Vector2::operator / (double v) const                { return Vector2(*this) /= v; }
+Vector2 Vector2::operator / (int v) const                   { return Vector2(*this) /= v; }
+Vector2 Vector2::operator / (const class Vector3& v) const  { return Vector2(*this) /= v; }
+Vector2 Vector2::operator / (const class Vector4& v) const  { return Vector2(*this) /= v; }
+
+bool Vector2::operator < (const Vector2& v) const           { return MagnitudeSquared() < v.MagnitudeSquared(); }
+bool Vector2::operator < (float v) const                    { return MagnitudeSquared() < (v * v); }
+bool Vector2::operator < (double v) const                   { return MagnitudeSquared() < (float)(v * v); }
+bool Vector2::operator < (int v) const                      { return MagnitudeSquared() < (float)(v * v); }
+bool Vector2::operator < (const class Vector3& v) const     { return MagnitudeSquared() < v.MagnitudeSquared(); }
+bool Vector2::operator < (const class Vector4& v) const     { return MagnitudeSquared() < v.MagnitudeSquared(); }
+
+bool Vector2::operator <= (const Vector2& v) const          { return MagnitudeSquared() <= v.MagnitudeSquared(); }
+bool Vector2::operator <= (float v) const                   { return MagnitudeSquared() <= (v * v); }
+bool Vector2::operator <= (double v) const                  { return MagnitudeSquared() <= (float)(v * v); }
+bool Vector2::operator <= (int v) const                     { return MagnitudeSquared() <= (float)(v * v); }
+bool Vector2::operator <= (const class Vector3& v) const    { return MagnitudeSquared() <= v.MagnitudeSquared(); }
+bool Vector2::operator <= (const class Vector4& v) const    { return MagnitudeSquared() <= v.MagnitudeSquared(); }
+
+bool Vector2::operator > (const Vector2& v) const           { return MagnitudeSquared() > v.MagnitudeSquared(); }
+bool Vector2::operator > (float v) const                    { return MagnitudeSquared() > (v * v); }
+bool Vector2::operator > (double v) const                   { return MagnitudeSquared() > (float)(v * v); }
+bool Vector2::operator > (int v) const                      { return MagnitudeSquared() > (float)(v * v); }
+bool Vector2::operator > (const class Vector3& v) const     { return MagnitudeSquared() > v.MagnitudeSquared(); }
+bool Vector2::operator > (const class Vector4& v) const     { return MagnitudeSquared() > v.MagnitudeSquared(); }
+
+bool Vector2::operator >= (const Vector2& v) const          { return MagnitudeSquared() >= v.MagnitudeSquared(); }
+bool Vector2::operator >= (float v) const                   { return MagnitudeSquared() >= (v * v); }
+bool Vector2::operator >= (double v) const                  { return MagnitudeSquared() >= (float)(v * v); }
+bool Vector2::operator >= (int v) const                     { return MagnitudeSquared() >= (float)(v * v); }
+bool Vector2::operator >= (const class Vector3& v) const    { return MagnitudeSquared() >= v.MagnitudeSquared(); }
+bool Vector2::operator >= (const class Vector4& v) const    { return MagnitudeSquared() >= v.MagnitudeSquared(); }
+
+bool Vector2::operator == (const Vector2& v) const {
+    return CloseEnough(x, v.x, Epsilon) && CloseEnough(x, v.x, Epsilon);
+}
+bool Vector2::operator == (float v) const                   { return CloseEnough(MagnitudeSquared(), v*v, Epsilon); }
+bool Vector2::operator == (double v) const                  { return *this == (float)(v*v); }
+bool Vector2::operator == (int v) const                     { return *this == (float)(v*v); }
+bool Vector2::operator == (const class Vector3& v) const {
+#   if defined(XO_SSE2)
+    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(_mm_set_ps(0.0f, 0.0f, y, x), v.xmm)), sse::Epsilon)) & 3) == 3;
+#   else
+    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon);
+#   endif
+}
+bool Vector2::operator == (const class Vector4& v) const {
+#   if defined(XO_SSE)
+    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(_mm_set_ps(0.0f, 0.0f, y, x), v.xmm)), sse::Epsilon)) & 3) == 3;
+#   else
+    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon);
+#   endif
+}
+
+bool Vector2::operator != (const Vector2& v) const          { return !((*this) == v); }
+bool Vector2::operator != (float v) const                   { return !((*this) == v); }
+bool Vector2::operator != (double v) const                  { return !((*this) == v); }
+bool Vector2::operator != (int v) const                     { return !((*this) == v); }
+bool Vector2::operator != (const class Vector3& v) const    { return !((*this) == v); }
+bool Vector2::operator != (const class Vector4& v) const    { return !((*this) == v); }
+
+_XOINL 
+Vector2 Abs(const Vector2& v)
+{
+    return Vector2(Abs(v.x), Abs(v.y));
+}
+
+template <Precision P>
+Vector2 Vector2::Reciprocal() const {
+#if defined(XO_SSE)
+    const __m128 r = sse::Reciprocal<P>(_mm_setr_ps(x, y, 1.0f, 1.0f));
+    return Vector2(_mm_cvtss_f32(r), _mm_cvtss_f32(_mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 1, 1, 1))));
+#else
+    return Vector2(1.0f / x, 1.0f / y);
+#endif
+}
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+#if defined(XO_SSE)
+Vector3::operator __m128() const {
+    return xmm;
+}
+#endif
+
+float& Vector3::operator [](int i) {
+    return f[i];
+}
+
+const float& Vector3::operator [](int i) const {
+    return f[i];
+}
+
+Vector3 Vector3::operator -() const {
+#if defined(XO_SSE)
+    return Vector3(_mm_mul_ps(xmm, sse::NegativeOne));
+#else
+    return Vector3(-x, -y, -z);
+#endif
+}
+
+Vector3 Vector3::operator ~() const {
+    return ZYX();
+}
+
+Vector3& Vector3::operator += (const Vector3& v) {
+#if defined(XO_SSE)
+    xmm = _mm_add_ps(xmm, v);
+#else
+    x += v.x;
+    y += v.y;
+    z += v.z;
+#endif
+    return *this;
+}
+
+Vector3& Vector3::operator += (float v) {
+#if defined(XO_SSE)
+    xmm = _mm_add_ps(xmm, _mm_set_ps1(v));
+#else
+    x += v;
+    y += v;
+    z += v;
+#endif
+    return *this;
+}
+
+Vector3& Vector3::operator += (double v)                  { return (*this) += float(v); }
+Vector3& Vector3::operator += (int v)                     { return (*this) += float(v); }
+Vector3& Vector3::operator += (const class Vector2& v)    { return (*this) += Vector3(v); }
+Vector3& Vector3::operator += (const class Vector4& v)    { return (*this) += Vector3(v); }
+
+Vector3& Vector3::operator -= (const Vector3& v) {
+#if defined(XO_SSE)
+    xmm = _mm_sub_ps(xmm, v);
+#else
+    x -= v.x;
+    y -= v.y;
+    z -= v.z;
+#endif
+    return *this;
+}
+
+Vector3& Vector3::operator -= (float v) {
+#if defined(XO_SSE)
+    xmm = _mm_sub_ps(xmm, _mm_set_ps1(v));
+#else
+    x -= v;
+    y -= v;
+    z -= v;
+#endif
+    return *this;
+}
+
+Vector3& Vector3::operator -= (double v)                  { return (*this) -= float(v); }
+Vector3& Vector3::operator -= (int v)                     { return (*this) -= float(v); }
+Vector3& Vector3::operator -= (const class Vector2& v)    { return (*this) -= Vector3(v); }
+Vector3& Vector3::operator -= (const class Vector4& v)    { return (*this) -= Vector3(v); }
+
+Vector3& Vector3::operator *= (const Vector3& v) {
+#if defined(XO_SSE)
+    xmm = _mm_mul_ps(xmm, v);
+#else
+    x *= v.x;
+    y *= v.y;
+    z *= v.z;
+#endif
+    return *this;
+}
+
+Vector3& Vector3::operator *= (float v) {
+#if defined(XO_SSE)
+    xmm = _mm_mul_ps(xmm, _mm_set_ps1(v));
+#else
+    x *= v;
+    y *= v;
+    z *= v;
+#endif
+    return *this;
+}
+
+Vector3& Vector3::operator *= (double v)                  { return (*this) *= float(v); }
+Vector3& Vector3::operator *= (int v)                     { return (*this) *= float(v); }
+Vector3& Vector3::operator *= (const class Vector2& v)    { return (*this) *= Vector3(v); }
+Vector3& Vector3::operator *= (const class Vector4& v)    { return (*this) *= Vector3(v); }
+
+#if defined(XO_NO_INVERSE_DIVISION)
+Vector3& Vector3::operator /= (const Vector3& v) {
+#if defined(XO_SSE)
+    // see: https://software.intel.com/sites/landingpage/IntrinsicsGuide
+    // see: https://software.intel.com/en-us/articles/measuring-instruction-latency-and-throughput
+
+    // _mm_div_ps
+    // -----------------------------------
+    // Architecture    Latency Throughput
+    // Haswell         13      5
+    // Ivy Bridge      13      6
+    // Sandy Bridge    14      14
+    // Westmere        14      12
+    // Nehalem         14      12
+    xmm = _mm_div_ps(xmm, v);
+#else
+    x /= v.x;
+    y /= v.y;
+    z /= v.z;
+#endif
+
+    return *this;
+}
+
+Vector3& Vector3::operator /= (float v) {
+#   if defined(XO_SSE)
+    xmm = _mm_div_ps(xmm, _mm_set_ps1(v));
+#   else
+    x /= v;
+    y /= v;
+    z /= v;
+#   endif
+    return *this;
+}
+#else
+
+Vector3& Vector3::operator /= (const Vector3& v) {
+#   if defined(XO_SSE)
+    // see: https://software.intel.com/sites/landingpage/IntrinsicsGuide
+    // see: https://software.intel.com/en-us/articles/measuring-instruction-latency-and-throughput
+
+    // _mm_rcp_ps
+    // -----------------------------------
+    // Architecture    Latency  Throughput
+    // Haswell         5        1
+    // Ivy Bridge      5        1
+    // Sandy Bridge    5        1
+    // Westmere        3        2
+    // Nehalem         3        2
+
+    // _mm_mul_ps
+    // -----------------------------------
+    // Architecture    Latency  Throughput
+    // Haswell         5        0.5
+    // Ivy Bridge      5        1
+    // Sandy Bridge    5        1
+    // Westmere        4        1
+    // Nehalem         4        1
+    xmm = _mm_mul_ps(xmm, _mm_rcp_ps(v));
+#   else
+    x /= v.x;
+    y /= v.y;
+    z /= v.z;
+#   endif
+
+    return *this;
+}
+
+Vector3& Vector3::operator /= (float v) { 
+#   if defined(XO_SSE)
+    xmm = _mm_mul_ps(xmm, _mm_set_ps1(1.0f/v));
+#   else
+    v = 1.0f / v;
+    x *= v;
+    y *= v;
+    z *= v;
+#   endif
+    return *this;
+}
+#endif
+Vector3& Vector3::operator /= (double v)                    { return (*this) /= float(v); }
+Vector3& Vector3::operator /= (int v)                       { return (*this) /= float(v); }
+Vector3& Vector3::operator /= (const class Vector2& v)      { return (*this) /= Vector3(v); }
+Vector3& Vector3::operator /= (const class Vector4& v)      { return (*this) /= Vector3(v); }
+
+Vector3 Vector3::operator + (const Vector3& v) const        { return Vector3(*this) += v; }
+Vector3 Vector3::operator + (float v) const                 { return Vector3(*this) += v; }
+Vector3 Vector3::operator + (double v) const                { return Vector3(*this) += v; }
+Vector3 Vector3::operator + (int v) const                   { return Vector3(*this) += v; }
+Vector3 Vector3::operator + (const class Vector2& v) const  { return Vector3(*this) += v; }
+Vector3 Vector3::operator + (const class Vector4& v) const  { return Vector3(*this) += v; }
+
+Vector3 Vector3::operator - (const Vector3& v) const        { return Vector3(*this) -= v; }
+Vector3 Vector3::operator - (float v) const                 { return Vector3(*this) -= v; }
+Vector3 Vector3::operator - (double v) const                { return Vector3(*this) -= v; }
+Vector3 Vector3::operator - (int v) const                   { return Vector3(*this) -= v; }
+Vector3 Vector3::operator - (const class Vector2& v) const  { return Vector3(*this) -= v; }
+Vector3 Vector3::operator - (const class Vector4& v) const  { return Vector3(*this) -= v; }
+
+Vector3 Vector3::operator * (const Vector3& v) const        { return Vector3(*this) *= v; }
+Vector3 Vector3::operator * (float v) const                 { return Vector3(*this) *= v; }
+Vector3 Vector3::operator * (double v) const                { return Vector3(*this) *= v; }
+Vector3 Vector3::operator * (int v) const                   { return Vector3(*this) *= v; }
+Vector3 Vector3::operator * (const class Vector2& v) const  { return Vector3(*this) *= v; }
+Vector3 Vector3::operator * (const class Vector4& v) const  { return Vector3(*this) *= v; }
+
+Vector3 Vector3::operator / (const Vector3& v) const        { return Vector3(*this) /= v; }
+Vector3 Vector3::operator / (float v) const                 { return Vector3(*this) /= v; }
+Vector3 Vector3::operator / (double v) const                { return Vector3(*this) /= v; }
+Vector3 Vector3::operator / (int v) const                   { return Vector3(*this) /= v; }
+Vector3 Vector3::operator / (const class Vector2& v) const  { return Vector3(*this) /= v; }
+Vector3 Vector3::operator / (const class Vector4& v) const  { return Vector3(*this) /= v; }
+
+
+bool Vector3::operator < (const Vector3& v) const       { return MagnitudeSquared() < v.MagnitudeSquared(); }
+bool Vector3::operator < (float v) const                { return MagnitudeSquared() < (v * v); }
+bool Vector3::operator < (double v) const               { return MagnitudeSquared() < (float)(v * v); }
+bool Vector3::operator < (int v) const                  { return MagnitudeSquared() < (float)(v * v); }
+bool Vector3::operator < (const class Vector2& v) const { return MagnitudeSquared() < v.MagnitudeSquared(); }
+bool Vector3::operator < (const class Vector4& v) const { return MagnitudeSquared() < v.MagnitudeSquared(); }
+
+bool Vector3::operator <= (const Vector3& v) const          { return MagnitudeSquared() <= v.MagnitudeSquared(); }
+bool Vector3::operator <= (float v) const                   { return MagnitudeSquared() <= (v * v); }
+bool Vector3::operator <= (double v) const                  { return MagnitudeSquared() <= (float)(v * v); }
+bool Vector3::operator <= (int v) const                     { return MagnitudeSquared() <= (float)(v * v); }
+bool Vector3::operator <= (const class Vector2& v) const    { return MagnitudeSquared() <= v.MagnitudeSquared(); }
+bool Vector3::operator <= (const class Vector4& v) const    { return MagnitudeSquared() <= v.MagnitudeSquared(); }
+
+bool Vector3::operator > (const Vector3& v) const       { return MagnitudeSquared() > v.MagnitudeSquared(); }
+bool Vector3::operator > (float v) const                { return MagnitudeSquared() > (v * v); }
+bool Vector3::operator > (double v) const               { return MagnitudeSquared() > (float)(v * v); }
+bool Vector3::operator > (int v) const                  { return MagnitudeSquared() > (float)(v * v); }
+bool Vector3::operator > (const class Vector2& v) const { return MagnitudeSquared() > v.MagnitudeSquared(); }
+bool Vector3::operator > (const class Vector4& v) const { return MagnitudeSquared() > v.MagnitudeSquared(); }
+
+bool Vector3::operator >= (const Vector3& v) const          { return MagnitudeSquared() >= v.MagnitudeSquared(); }
+bool Vector3::operator >= (float v) const                   { return MagnitudeSquared() >= (v * v); }
+bool Vector3::operator >= (double v) const                  { return MagnitudeSquared() >= (float)(v * v); }
+bool Vector3::operator >= (int v) const                     { return MagnitudeSquared() >= (float)(v * v); }
+bool Vector3::operator >= (const class Vector2& v) const    { return MagnitudeSquared() >= v.MagnitudeSquared(); }
+bool Vector3::operator >= (const class Vector4& v) const    { return MagnitudeSquared() >= v.MagnitudeSquared(); }
+
+bool Vector3::operator == (const Vector3& v) const {
+#   if defined(XO_SSE2)
+    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(v, xmm)), sse::Epsilon)) & 7) == 7;
+#   elif XO_SSE
+    // TODO: find a faster way with SSE to do a 'close enough' check.
+    // I'm not sure if there's a way to do the sign bit masking like we have in sse::Abs to acomplish
+    // what we're doing in SSE2
+    return CloseEnough(x, v.x, sse::SSEFloatEpsilon) && CloseEnough(y, v.y, sse::SSEFloatEpsilon) && CloseEnough(z, v.z, sse::SSEFloatEpsilon);
+#   else
+    // CloseEnough is relative, so only zero itself would equal zero: elements near zero get the absolute tolerance SSE2 
+    // uses.
+    return (Abs(x - v.x) < Epsilon || CloseEnough(x, v.x, Epsilon)) && 
+           (Abs(y - v.y) < Epsilon || CloseEnough(y, v.y, Epsilon)) && 
+           (Abs(z - v.z) < Epsilon || CloseEnough(z, v.z, Epsilon));
+#   endif
+}
+bool Vector3::operator == (float v) const                   { return CloseEnough(MagnitudeSquared(), v*v, Epsilon);}
+bool Vector3::operator == (double v) const                  { return CloseEnough(MagnitudeSquared(), (float)(v*v), Epsilon);}
+bool Vector3::operator == (int v) const                     { return CloseEnough(MagnitudeSquared(), (float)(v*v), Epsilon);}
+bool Vector3::operator == (const class Vector2& v) const {
+#   if defined(XO_SSE)
+    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(_mm_set_ps(0.0f, 0.0f, v.y, v.x), xmm)), sse::Epsilon)) & 3) == 3;
+#   else
+    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon);
+#   endif
+}
+bool Vector3::operator == (const class Vector4& v) const {
+#   if defined(XO_SSE)
+    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(v.xmm, xmm)), sse::Epsilon)) & 7) == 7;
+#   else
+    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon) && CloseEnough(z, v.z, Epsilon);
+#   endif
+}
+
+bool Vector3::operator != (const Vector3& v) const          { return !((*this) == v); }
+bool Vector3::operator != (float v) const                   { return !((*this) == v); }
+bool Vector3::operator != (double v) const                  { return !((*this) == v); }
+bool Vector3::operator != (int v) const                     { return !((*this) == v); }
+bool Vector3::operator != (const class Vector2& v) const    { return !((*this) == v); }
+bool Vector3::operator != (const class Vector4& v) const    { return !((*this) == v); }
+
+_XOINL
+Vector3 Abs(const Vector3& v)
+{
+#if defined(XO_SSE)
+    return (sse::Abs(v.xmm));
+#else
+    return Vector3(Abs(v.x), Abs(v.y), Abs(v.z));
+#endif
+}
+
+template <Precision P>
+Vector3& Vector3::Normalize() {
+#if defined(XO_SSE4_1)
+    // the dot product lands in every lane, so the scale never leaves the register.
+    xmm = _mm_mul_ps(xmm, sse::InvSqrt<P>(_mm_dp_ps(xmm, xmm, 0x7f)));
+#elif defined(XO_SSE)
+    xmm = _mm_mul_ps(xmm, sse::InvSqrt<P>(_mm_set_ps1(MagnitudeSquared())));
+#else
+    (*this) *= InvSqrt<P>(MagnitudeSquared());
+#endif
+    return *this;
+}
+
+template <Precision P>
+Vector3 Vector3::Reciprocal() const {
+#if defined(XO_SSE)
+    // w is 0, keep it that way rather than letting it become infinity.
+    return Vector3(_mm_and_ps(sse::Reciprocal<P>(xmm), MASK));
+#else
+    return Vector3(1.0f / x, 1.0f / y, 1.0f / z);
+#endif
+}
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+#if defined(XO_SSE)
+
+#if !defined(IDX_X)
+#   define IDX_X 0
+#endif
+
+#if !defined(IDX_Y)
+#   define IDX_Y 1
+#endif
+
+#if !defined(IDX_Z)
+#   define IDX_Z 2
+#endif
+
+#if !defined(IDX_W)
+#   define IDX_W 3
+#endif
+
+#endif
+
+#if defined(XO_SSE)
+Vector4::operator const __m128&() const {
+    return xmm;
+}
+#endif
+
+float& Vector4::operator [](int i) {
+    return f[i];
+}
+
+const float& Vector4::operator [](int i) const {
+    return f[i];
+}
+
+Vector4 Vector4::operator -() const {
+#if defined(XO_SSE)
+    return Vector4(_mm_mul_ps(xmm, sse::NegativeOne));
+#else
+    return Vector4(-x, -y, -z, -w);
+#endif
+}
+
+Vector4 Vector4::operator ~() const {
 #if defined(XO_SSE)
-    return Vector3(_mm_mul_ps(xmm, sse::NegativeOne));
+    return Vector3(_mm_shuffle_ps(xmm, xmm, _MM_SHUFFLE(IDX_X, IDX_Y, IDX_Z, IDX_W)));
 #else
-    return Vector3(-x, -y, -z);
+    return Vector4(w, z, y, x);
+#endif
+}
+
+Vector4& Vector4::operator += (const Vector4& v) {
+#if defined(XO_SSE)
+    xmm = _mm_add_ps(xmm, v.xmm);
+#else
+    x += v.x;
+    y += v.y;
+    z += v.z;
+    w += v.w;
+#endif
+    return *this;
+}
+
+Vector4& Vector4::operator += (float v) {
+#if defined(XO_SSE)
+    xmm = _mm_add_ps(xmm, _mm_set_ps1(v));
+#else
+    x += v;
+    y += v;
+    z += v;
+    w += v;
+#endif
+    return *this;
+}
+
+Vector4& Vector4::operator += (double v)          { return (*this) += (float)v; }
+Vector4& Vector4::operator += (int v)             { return (*this) += (float)v; }
+Vector4& Vector4::operator += (const class Vector2& v)  { return (*this) += Vector4(v); }
+Vector4& Vector4::operator += (const class Vector3& v)  { return (*this) += Vector4(v); }
+
+Vector4& Vector4::operator -= (const Vector4& v) {
+#if defined(XO_SSE)
+    xmm = _mm_sub_ps(xmm, v.xmm);
+#else
+    x -= v.x;
+    y -= v.y;
+    z -= v.z;
+    w -= v.w;
+#endif
+    return *this;
+}
+
+Vector4& Vector4::operator -= (float v) {
+#if defined(XO_SSE)
+    xmm = _mm_sub_ps(xmm, _mm_set_ps1(v));
+#else
+    x -= v;
+    y -= v;
+    z -= v;
+    w -= v;
+#endif
+    return *this;
+}
+
+Vector4& Vector4::operator -= (double v)          { return (*this) -= (float)v; }
+Vector4& Vector4::operator -= (int v)             { return (*this) -= (float)v; }
+Vector4& Vector4::operator -= (const class Vector2& v)  { return (*this) -= Vector4(v); }
+Vector4& Vector4::operator -= (const class Vector3& v)  { return (*this) -= Vector4(v); }
+
+Vector4& Vector4::operator *= (const Vector4& v) {
+#if defined(XO_SSE)
+    xmm = _mm_mul_ps(xmm, v.xmm);
+#else
+    x *= v.x;
+    y *= v.y;
+    z *= v.z;
+    w *= v.w;
+#endif
+    return *this;
+}
+
+Vector4& Vector4::operator *= (float v) {
+#if defined(XO_SSE)
+    xmm = _mm_mul_ps(xmm, _mm_set_ps1(v));
+#else
+    x *= v;
+    y *= v;
+    z *= v;
+    w *= v;
+#endif
+    return *this;
+}
+
+Vector4& Vector4::operator *= (double v)          { return (*this) *= (float)v; }
+Vector4& Vector4::operator *= (int v)             { return (*this) *= (float)v; }
+Vector4& Vector4::operator *= (const class Vector2& v)  { return (*this) *= Vector4(v); }
+Vector4& Vector4::operator *= (const class Vector3& v)  { return (*this) *= Vector4(v); }
+
+#if defined(XO_NO_INVERSE_DIVISION)
+Vector4& Vector4::operator /= (const Vector4& v) {
+#   if defined(XO_SSE)
+    // see: https://software.intel.com/sites/landingpage/IntrinsicsGuide
+    // see: https://software.intel.com/en-us/articles/measuring-instruction-latency-and-throughput
+
+    // _mm_div_ps
+    // -----------------------------------
+    // Architecture    Latency Throughput
+    // Haswell         13      5
+    // Ivy Bridge      13      6
+    // Sandy Bridge    14      14
+    // Westmere        14      12
+    // Nehalem         14      12
+    xmm = _mm_div_ps(xmm, v.xmm);
+#   else
+    x /= v.x;
+    y /= v.y;
+    z /= v.z;
+    w /= v.w;
+#   endif
+    return *this;
+}
+
+Vector4& Vector4::operator /= (float v) {
+#   if defined(XO_SSE)
+    xmm = _mm_div_ps(xmm, _mm_set_ps1(v));
+#   else
+    x /= v;
+    y /= v;
+    z /= v;
+    w /= v;
+#   endif
+    return *this;
+}
+#else
+
+Vector4& Vector4::operator /= (const Vector4& v) {
+#   if defined(XO_SSE)
+    // see: https://software.intel.com/sites/landingpage/IntrinsicsGuide
+    // see: https://software.intel.com/en-us/articles/measuring-instruction-latency-and-throughput
+
+    // _mm_rcp_ps
+    // -----------------------------------
+    // Architecture    Latency  Throughput
+    // Haswell         5        1
+    // Ivy Bridge      5        1
+    // Sandy Bridge    5        1
+    // Westmere        3        2
+    // Nehalem         3        2
+
+    // _mm_mul_ps
+    // -----------------------------------
+    // Architecture    Latency  Throughput
+    // Haswell         5        0.5
+    // Ivy Bridge      5        1
+    // Sandy Bridge    5        1
+    // Westmere        4        1
+    // Nehalem         4        1
+    xmm = _mm_mul_ps(xmm, _mm_rcp_ps(v.xmm));
+#   else
+    x /= v.x;
+    y /= v.y;
+    z /= v.z;
+    w /= v.w;
+#endif
+    return *this;
+}
+
+Vector4& Vector4::operator /= (float v) { 
+#   if defined(XO_SSE)
+    xmm = _mm_mul_ps(xmm, _mm_set_ps1(1.0f/v));
+#   else
+    v = 1.0f / v;
+    x *= v;
+    y *= v;
+    z *= v;
+    w *= v;
+#   endif
+    return *this;
+}
 #endif
+Vector4& Vector4::operator /= (double v)          { return (*this) /= float(v); }
+Vector4& Vector4::operator /= (int v)             { return (*this) /= float(v); }
+Vector4& Vector4::operator /= (const class Vector2& v)  { return (*this) /= Vector4(v); }
+Vector4& Vector4::operator /= (const class Vector3& v)  { return (*this) /= Vector4(v); }
+
+Vector4 Vector4::operator + (const Vector4& v) const    { return Vector4(*this) += v; }
+Vector4 Vector4::operator + (float v) const             { return Vector4(*this) += v; }
+Vector4 Vector4::operator + (double v) const            { return Vector4(*this) += v; }
+Vector4 Vector4::operator + (int v) const               { return Vector4(*this) += v; }
+Vector4 Vector4::operator + (const class Vector2& v) const    { return Vector4(*this) += v; }
+Vector4 Vector4::operator + (const class Vector3& v) const    { return Vector4(*this) += v; }
+
+Vector4 Vector4::operator - (const Vector4& v) const    { return Vector4(*this) -= v; }
+Vector4 Vector4::operator - (float v) const             { return Vector4(*this) -= v; }
+Vector4 Vector4::operator - (double v) const            { return Vector4(*this) -= v; }
+Vector4 Vector4::operator - (int v) const               { return Vector4(*this) -= v; }
+Vector4 Vector4::operator - (const class Vector2& v) const    { return Vector4(*this) -= v; }
+Vector4 Vector4::operator - (const class Vector3& v) const    { return Vector4(*this) -= v; }
+
+Vector4 Vector4::operator * (const Vector4& v) const    { return Vector4(*this) *= v; }
+Vector4 Vector4::operator * (float v) const             { return Vector4(*this) *= v; }
+Vector4 Vector4::operator * (double v) const            { return Vector4(*this) *= v; }
+Vector4 Vector4::operator * (int v) const               { return Vector4(*this) *= v; }
+Vector4 Vector4::operator * (const class Vector2& v) const    { return Vector4(*this) *= v; }
+Vector4 Vector4::operator * (const class Vector3& v) const    { return Vector4(*this) *= v; }
+
+Vector4 Vector4::operator / (const Vector4& v) const    { return Vector4(*this) /= v; }
+Vector4 Vector4::operator / (float v) const             { return Vector4(*this) /= v; }
+Vector4 Vector4::operator / (double v) const            { return Vector4(*this) /= v; }
+Vector4 Vector4::operator / (int v) const               { return Vector4(*this) /= v; }
+Vector4 Vector4::operator / (const class Vector2& v) const    { return Vector4(*this) /= v; }
+Vector4 Vector4::operator / (const class Vector3& v) const    { return Vector4(*this) /= v; }
+
+bool Vector4::operator < (const Vector4& v) const       { return MagnitudeSquared() < v.MagnitudeSquared(); }
+bool Vector4::operator < (float v) const                { return MagnitudeSquared() < (v * v); }
+bool Vector4::operator < (double v) const               { return MagnitudeSquared() < (float)(v * v); }
+bool Vector4::operator < (int v) const                  { return MagnitudeSquared() < (float)(v * v); }
+bool Vector4::operator < (const class Vector2& v) const       { return MagnitudeSquared() < v.MagnitudeSquared(); }
+bool Vector4::operator < (const class Vector3& v) const       { return MagnitudeSquared() < v.MagnitudeSquared(); }
+
+bool Vector4::operator <= (const Vector4& v) const      { return MagnitudeSquared() <= v.MagnitudeSquared(); }
+bool Vector4::operator <= (float v) const               { return MagnitudeSquared() <= (v * v); }
+bool Vector4::operator <= (double v) const              { return MagnitudeSquared() <= (float)(v * v); }
+bool Vector4::operator <= (int v) const                 { return MagnitudeSquared() <= (float)(v * v); }
+bool Vector4::operator <= (const class Vector2& v) const      { return MagnitudeSquared() <= v.MagnitudeSquared(); }
+bool Vector4::operator <= (const class Vector3& v) const      { return MagnitudeSquared() <= v.MagnitudeSquared(); }
+
+bool Vector4::operator > (const Vector4& v) const       { return MagnitudeSquared() > v.MagnitudeSquared(); }
+bool Vector4::operator > (float v) const                { return MagnitudeSquared() > (v * v); }
+bool Vector4::operator > (double v) const               { return MagnitudeSquared() > (float)(v * v); }
+bool Vector4::operator > (int v) const                  { return MagnitudeSquared() > (float)(v * v); }
+bool Vector4::operator > (const class Vector2& v) const       { return MagnitudeSquared() > v.MagnitudeSquared(); }
+bool Vector4::operator > (const class Vector3& v) const       { return MagnitudeSquared() > v.MagnitudeSquared(); }
+
+bool Vector4::operator >= (const Vector4& v) const      { return MagnitudeSquared() >= v.MagnitudeSquared(); }
+bool Vector4::operator >= (float v) const               { return MagnitudeSquared() >= (v * v); }
+bool Vector4::operator >= (double v) const              { return MagnitudeSquared() >= (float)(v * v); }
+bool Vector4::operator >= (int v) const                 { return MagnitudeSquared() >= (float)(v * v); }
+bool Vector4::operator >= (const class Vector2& v) const      { return MagnitudeSquared() >= v.MagnitudeSquared(); }
+bool Vector4::operator >= (const class Vector3& v) const      { return MagnitudeSquared() >= v.MagnitudeSquared(); }
+
+bool Vector4::operator == (const Vector4& v) const {
+#   if defined(XO_SSE2)
+    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(v.xmm, xmm)), sse::Epsilon)) & 15) == 15;
+#   elif XO_SSE
+    // TODO: find a faster way with SSE to do a 'close enough' check.
+    // I'm not sure if there's a way to do the sign bit masking like we have in sse::Abs to acomplish
+    // what we're doing in SSE2
+    return 
+        CloseEnough(x, v.x, sse::SSEFloatEpsilon) && 
+        CloseEnough(y, v.y, sse::SSEFloatEpsilon) && 
+        CloseEnough(z, v.z, sse::SSEFloatEpsilon) &&
+        CloseEnough(w, v.w, sse::SSEFloatEpsilon);
+#   else
+    return 
+        CloseEnough(x, v.x, Epsilon) && 
+        CloseEnough(y, v.y, Epsilon) && 
+        CloseEnough(z, v.z, Epsilon) &&
+        CloseEnough(w, v.w, Epsilon);
+#   endif
 }
+bool Vector4::operator == (float v) const           { return CloseEnough(MagnitudeSquared(), v * v, Epsilon); }
+bool Vector4::operator == (double v) const          { return CloseEnough(MagnitudeSquared(), (float)(v * v), Epsilon); }
+bool Vector4::operator == (int v) const             { return CloseEnough(MagnitudeSquared(), (float)(v * v), Epsilon); }
 
-Vector3 Vector3::operator ~() const {
-    return ZYX();
+bool Vector4::operator == (const class Vector2& v) const {
+#   if defined(XO_SSE)
+    // Todo: check that this is actually faster.
+    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(xmm, _mm_set_ps(0.0f, 0.0f, v.y, v.x))), sse::Epsilon)) & 3) == 3;
+#   else
+    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon);
+#   endif
 }
 
-Vector3& Vector3::operator += (const Vector3& v) {
-#if defined(XO_SSE)
-    xmm = _mm_add_ps(xmm, v);
-#else
-    x += v.x;
-    y += v.y;
-    z += v.z;
-#endif
-    return *this;
+bool Vector4::operator == (const class Vector3& v) const {
+#   if defined(XO_SSE)
+    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(v.xmm, xmm)), sse::Epsilon)) & 7) == 7;
+#   else
+    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon) && CloseEnough(z, v.z, Epsilon);
+#   endif
 }
 
-Vector3& Vector3::operator += (float v) {
+bool Vector4::operator != (const Vector4& v) const  { return !((*this) == v); }
+bool Vector4::operator != (float v) const           { return !((*this) == v); }
+bool Vector4::operator != (double v) const          { return !((*this) == v); }
+bool Vector4::operator != (int v) const             { return !((*this) == v); }
+bool Vector4::operator != (const class Vector2& v) const  { return !((*this) == v); }
+bool Vector4::operator != (const class Vector3& v) const  { return !((*this) == v); }
+
+_XOINL 
+Vector4 Abs(const Vector4& v)
+{
 #if defined(XO_SSE)
-    xmm = _mm_add_ps(xmm, _mm_set_ps1(v));
+    return (sse::Abs(v.xmm));
 #else
-    x += v;
-    y += v;
-    z += v;
+    return Vector4(Abs(v.x), Abs(v.y), Abs(v.z));
 #endif
-    return *this;
 }
 
-Vector3& Vector3::operator += (double v)                  { return (*this) += float(v); }
-Vector3& Vector3::operator += (int v)                     { return (*this) += float(v); }
-Vector3& Vector3::operator += (const class Vector2& v)    { return (*this) += Vector3(v); }
-Vector3& Vector3::operator += (const class Vector4& v)    { return (*this) += Vector3(v); }
+#undef IDX_X
+#undef IDX_Y
+#undef IDX_Z
+#undef IDX_W
 
-Vector3& Vector3::operator -= (const Vector3& v) {
-#if defined(XO_SSE)
-    xmm = _mm_sub_ps(xmm, v);
+template <Precision P>
+Vector4& Vector4::Normalize() {
+#if defined(XO_SSE4_1)
+    // the dot product lands in every lane, so the scale never leaves the register.
+    xmm = _mm_mul_ps(xmm, sse::InvSqrt<P>(_mm_dp_ps(xmm, xmm, 0xff)));
+#elif defined(XO_SSE)
+    xmm = _mm_mul_ps(xmm, sse::InvSqrt<P>(_mm_set_ps1(MagnitudeSquared())));
 #else
-    x -= v.x;
-    y -= v.y;
-    z -= v.z;
+    (*this) *= InvSqrt<P>(MagnitudeSquared());
 #endif
     return *this;
 }
 
-Vector3& Vector3::operator -= (float v) {
+template <Precision P>
+Vector4 Vector4::Reciprocal() const {
 #if defined(XO_SSE)
-    xmm = _mm_sub_ps(xmm, _mm_set_ps1(v));
+    return Vector4(sse::Reciprocal<P>(xmm));
 #else
-    x -= v;
-    y -= v;
-    z -= v;
+    return Vector4(1.0f / x, 1.0f / y, 1.0f / z, 1.0f / w);
 #endif
-    return *this;
 }
 
-Vector3& Vector3::operator -= (double v)                  { return (*this) -= float(v); }
-Vector3& Vector3::operator -= (int v)                     { return (*this) -= float(v); }
-Vector3& Vector3::operator -= (const class Vector2& v)    { return (*this) -= Vector3(v); }
-Vector3& Vector3::operator -= (const class Vector4& v)    { return (*this) -= Vector3(v); }
+XOMATH_END_XO_NS();
 
-Vector3& Vector3::operator *= (const Vector3& v) {
-#if defined(XO_SSE)
-    xmm = _mm_mul_ps(xmm, v);
-#else
-    x *= v.x;
-    y *= v.y;
-    z *= v.z;
-#endif
-    return *this;
+XOMATH_BEGIN_XO_NS();
+
+const Vector4& Matrix4x4::operator [](int i) const {
+    return r[i];
 }
 
-Vector3& Vector3::operator *= (float v) {
-#if defined(XO_SSE)
-    xmm = _mm_mul_ps(xmm, _mm_set_ps1(v));
-#else
-    x *= v;
-    y *= v;
-    z *= v;
-#endif
-    return *this;
+Vector4& Matrix4x4::operator [](int i) {
+    return r[i];
 }
 
-Vector3& Vector3::operator *= (double v)                  { return (*this) *= float(v); }
-Vector3& Vector3::operator *= (int v)                     { return (*this) *= float(v); }
-Vector3& Vector3::operator *= (const class Vector2& v)    { return (*this) *= Vector3(v); }
-Vector3& Vector3::operator *= (const class Vector4& v)    { return (*this) *= Vector3(v); }
+const float& Matrix4x4::operator ()(int r, int c) const {
+    return this->r[r][c];
+}
 
-#if defined(XO_NO_INVERSE_DIVISION)
-Vector3& Vector3::operator /= (const Vector3& v) {
-#if defined(XO_SSE)
-    // see: https://software.intel.com/sites/landingpage/IntrinsicsGuide
-    // see: https://software.intel.com/en-us/articles/measuring-instruction-latency-and-throughput
+float& Matrix4x4::operator ()(int r, int c) {
+    return this->r[r][c];
+}
 
-    // _mm_div_ps
-    // -----------------------------------
-    // Architecture    Latency Throughput
-    // Haswell         13      5
-    // Ivy Bridge      13      6
-    // Sandy Bridge    14      14
-    // Westmere        14      12
-    // Nehalem         14      12
-    xmm = _mm_div_ps(xmm, v);
-#else
-    x /= v.x;
-    y /= v.y;
-    z /= v.z;
-#endif
+Matrix4x4 Matrix4x4::operator ~() const {
+    auto m = *this;
+    return m.Transpose();
+}
 
+Matrix4x4& Matrix4x4::operator += (const Matrix4x4& m) {
+    r[0] += m[0];
+    r[1] += m[1];
+    r[2] += m[2];
+    r[3] += m[3];
     return *this;
 }
 
-Vector3& Vector3::operator /= (float v) {
-#   if defined(XO_SSE)
-    xmm = _mm_div_ps(xmm, _mm_set_ps1(v));
-#   else
-    x /= v;
-    y /= v;
-    z /= v;
-#   endif
+Matrix4x4& Matrix4x4::operator -= (const Matrix4x4& m) {
+    r[0] -= m[0];
+    r[1] -= m[1];
+    r[2] -= m[2];
+    r[3] -= m[3];
     return *this;
 }
-#else
 
-Vector3& Vector3::operator /= (const Vector3& v) {
-#   if defined(XO_SSE)
-    // see: https://software.intel.com/sites/landingpage/IntrinsicsGuide
-    // see: https://software.intel.com/en-us/articles/measuring-instruction-latency-and-throughput
+Matrix4x4& Matrix4x4::operator *= (const Matrix4x4& m) {
+    Multiply(*this, m, *this);
+    return *this;
+}
 
-    // _mm_rcp_ps
-    // -----------------------------------
-    // Architecture    Latency  Throughput
-    // Haswell         5        1
-    // Ivy Bridge      5        1
-    // Sandy Bridge    5        1
-    // Westmere        3        2
-    // Nehalem         3        2
+Matrix4x4 Matrix4x4::operator + (const Matrix4x4& m) const { return Matrix4x4(*this) += m; }
+Matrix4x4 Matrix4x4::operator - (const Matrix4x4& m) const { return Matrix4x4(*this) -= m; }
+Matrix4x4 Matrix4x4::operator * (const Matrix4x4& m) const {
+    Matrix4x4 result;
+    Multiply(*this, m, result);
+    return result;
+}
 
-    // _mm_mul_ps
-    // -----------------------------------
-    // Architecture    Latency  Throughput
-    // Haswell         5        0.5
-    // Ivy Bridge      5        1
-    // Sandy Bridge    5        1
-    // Westmere        4        1
-    // Nehalem         4        1
-    xmm = _mm_mul_ps(xmm, _mm_rcp_ps(v));
-#   else
-    x /= v.x;
-    y /= v.y;
-    z /= v.z;
-#   endif
+void Matrix4x4::Multiply(const Matrix4x4& a, const Matrix4x4& b, Matrix4x4& outMatrix) {
+    // result row i = (a[i].x * b[0]) + (a[i].y * b[1]) + (a[i].z * b[2]) + (a[i].w * b[3])
+    // All of b is read before anything is written, so outMatrix may alias either input.
+#if defined(XO_AVX)
+    const __m256 b0 = _mm256_broadcast_ps(&b.r[0].xmm);
+    const __m256 b1 = _mm256_broadcast_ps(&b.r[1].xmm);
+    const __m256 b2 = _mm256_broadcast_ps(&b.r[2].xmm);
+    const __m256 b3 = _mm256_broadcast_ps(&b.r[3].xmm);
+    const __m256 a01 = _mm256_loadu_ps(a.r[0].f);
+    const __m256 a23 = _mm256_loadu_ps(a.r[2].f);
+    __m256 r01 = _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+    __m256 r23 = _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+    r01 = wide::MulAdd(_mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(1, 1, 1, 1)), b1, r01);
+    r23 = wide::MulAdd(_mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(1, 1, 1, 1)), b1, r23);
+    r01 = wide::MulAdd(_mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(2, 2, 2, 2)), b2, r01);
+    r23 = wide::MulAdd(_mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(2, 2, 2, 2)), b2, r23);
+    r01 = wide::MulAdd(_mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(3, 3, 3, 3)), b3, r01);
+    r23 = wide::MulAdd(_mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(3, 3, 3, 3)), b3, r23);
+    _mm256_storeu_ps(outMatrix.r[0].f, r01);
+    _mm256_storeu_ps(outMatrix.r[2].f, r23);
+#elif defined(XO_SSE)
+    const __m128 b0 = b.r[0].xmm, b1 = b.r[1].xmm, b2 = b.r[2].xmm, b3 = b.r[3].xmm;
+#   define _XO_MULTIPLY_ROW(row) \
+        sse::MulAdd(_mm_shuffle_ps(row, row, _MM_SHUFFLE(3, 3, 3, 3)), b3, \
+        sse::MulAdd(_mm_shuffle_ps(row, row, _MM_SHUFFLE(2, 2, 2, 2)), b2, \
+        sse::MulAdd(_mm_shuffle_ps(row, row, _MM_SHUFFLE(1, 1, 1, 1)), b1, \
+        _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(0, 0, 0, 0)), b0))))
+    const __m128 a0 = a.r[0].xmm, a1 = a.r[1].xmm, a2 = a.r[2].xmm, a3 = a.r[3].xmm;
+    outMatrix.r[0].xmm = _XO_MULTIPLY_ROW(a0);
+    outMatrix.r[1].xmm = _XO_MULTIPLY_ROW(a1);
+    outMatrix.r[2].xmm = _XO_MULTIPLY_ROW(a2);
+    outMatrix.r[3].xmm = _XO_MULTIPLY_ROW(a3);
+#   undef _XO_MULTIPLY_ROW
+#else
+    const Vector4 b0 = b.r[0], b1 = b.r[1], b2 = b.r[2], b3 = b.r[3];
+    for (int i = 0; i < 4; ++i) {
+        const Vector4 row = a.r[i];
+        outMatrix.r[i] = (b0 * row.x) + (b1 * row.y) + (b2 * row.z) + (b3 * row.w);
+    }
+#endif
+}
 
-    return *this;
+Vector4 Matrix4x4::operator * (const Vector4& v) const {
+    return Vector4((r[0] * v).Sum(), (r[1] * v).Sum(), (r[2] * v).Sum(), (r[3] * v).Sum());
 }
 
-Vector3& Vector3::operator /= (float v) { 
-#   if defined(XO_SSE)
-    xmm = _mm_mul_ps(xmm, _mm_set_ps1(1.0f/v));
-#   else
-    v = 1.0f / v;
-    x *= v;
-    y *= v;
-    z *= v;
-#   endif
-    return *this;
+Vector3 Matrix4x4::operator * (const Vector3& v) const {
+    return Vector3((r[0] * v).Sum(), (r[1] * v).Sum(), (r[2] * v).Sum());
 }
-#endif
-Vector3& Vector3::operator /= (double v)                    { return (*this) /= float(v); }
-Vector3& Vector3::operator /= (int v)                       { return (*this) /= float(v); }
-Vector3& Vector3::operator /= (const class Vector2& v)      { return (*this) /= Vector3(v); }
-Vector3& Vector3::operator /= (const class Vector4& v)      { return (*this) /= Vector3(v); }
 
-Vector3 Vector3::operator + (const Vector3& v) const        { return Vector3(*this) += v; }
-Vector3 Vector3::operator + (float v) const                 { return Vector3(*this) += v; }
-Vector3 Vector3::operator + (double v) const                { return Vector3(*this) += v; }
-Vector3 Vector3::operator + (int v) const                   { return Vector3(*this) += v; }
-Vector3 Vector3::operator + (const class Vector2& v) const  { return Vector3(*this) += v; }
-Vector3 Vector3::operator + (const class Vector4& v) const  { return Vector3(*this) += v; }
+XOMATH_END_XO_NS();
 
-Vector3 Vector3::operator - (const Vector3& v) const        { return Vector3(*this) -= v; }
-Vector3 Vector3::operator - (float v) const                 { return Vector3(*this) -= v; }
-Vector3 Vector3::operator - (double v) const                { return Vector3(*this) -= v; }
-Vector3 Vector3::operator - (int v) const                   { return Vector3(*this) -= v; }
-Vector3 Vector3::operator - (const class Vector2& v) const  { return Vector3(*this) -= v; }
-Vector3 Vector3::operator - (const class Vector4& v) const  { return Vector3(*this) -= v; }
+XOMATH_BEGIN_XO_NS();
 
-Vector3 Vector3::operator * (const Vector3& v) const        { return Vector3(*this) *= v; }
-Vector3 Vector3::operator * (float v) const                 { return Vector3(*this) *= v; }
-Vector3 Vector3::operator * (double v) const                { return Vector3(*this) *= v; }
-Vector3 Vector3::operator * (int v) const                   { return Vector3(*this) *= v; }
-Vector3 Vector3::operator * (const class Vector2& v) const  { return Vector3(*this) *= v; }
-Vector3 Vector3::operator * (const class Vector4& v) const  { return Vector3(*this) *= v; }
+Matrix3x4& Matrix3x4::operator *= (const Matrix3x4& m) {
+    Multiply(*this, m, *this);
+    return *this;
+}
 
-Vector3 Vector3::operator / (const Vector3& v) const        { return Vector3(*this) /= v; }
-Vector3 Vector3::operator / (float v) const                 { return Vector3(*this) /= v; }
-Vector3 Vector3::operator / (double v) const                { return Vector3(*this) /= v; }
-Vector3 Vector3::operator / (int v) const                   { return Vector3(*this) /= v; }
-Vector3 Vector3::operator / (const class Vector2& v) const  { return Vector3(*this) /= v; }
-Vector3 Vector3::operator / (const class Vector4& v) const  { return Vector3(*this) /= v; }
+Matrix3x4 Matrix3x4::operator * (const Matrix3x4& m) const {
+    Matrix3x4 result;
+    Multiply(*this, m, result);
+    return result;
+}
 
+Vector3 Matrix3x4::operator * (const Vector3& v) const {
+    return TransformPoint(v);
+}
 
-bool Vector3::operator < (const Vector3& v) const       { return MagnitudeSquared() < v.MagnitudeSquared(); }
-bool Vector3::operator < (float v) const                { return MagnitudeSquared() < (v * v); }
-bool Vector3::operator < (double v) const               { return MagnitudeSquared() < (float)(v * v); }
-bool Vector3::operator < (int v) const                  { return MagnitudeSquared() < (float)(v * v); }
-bool Vector3::operator < (const class Vector2& v) const { return MagnitudeSquared() < v.MagnitudeSquared(); }
-bool Vector3::operator < (const class Vector4& v) const { return MagnitudeSquared() < v.MagnitudeSquared(); }
+void Matrix3x4::Multiply(const Matrix3x4& a, const Matrix3x4& b, Matrix3x4& outMatrix) {
+    // result row i = (a[i].x * b[0]) + (a[i].y * b[1]) + (a[i].z * b[2]) + (0, 0, 0, a[i].w)
+    // All of b is read before anything is written, so outMatrix may alias either input.
+#if defined(XO_SSE)
+    const __m128 b0 = b.r[0].xmm, b1 = b.r[1].xmm, b2 = b.r[2].xmm;
+    const __m128 translation = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+#   define _XO_MULTIPLY_ROW(row) \
+        sse::MulAdd(_mm_shuffle_ps(row, row, _MM_SHUFFLE(2, 2, 2, 2)), b2, \
+        sse::MulAdd(_mm_shuffle_ps(row, row, _MM_SHUFFLE(1, 1, 1, 1)), b1, \
+        sse::MulAdd(_mm_shuffle_ps(row, row, _MM_SHUFFLE(0, 0, 0, 0)), b0, _mm_and_ps(row, translation))))
+    const __m128 a0 = a.r[0].xmm, a1 = a.r[1].xmm, a2 = a.r[2].xmm;
+    outMatrix.r[0].xmm = _XO_MULTIPLY_ROW(a0);
+    outMatrix.r[1].xmm = _XO_MULTIPLY_ROW(a1);
+    outMatrix.r[2].xmm = _XO_MULTIPLY_ROW(a2);
+#   undef _XO_MULTIPLY_ROW
+#else
+    const Vector4 b0 = b.r[0], b1 = b.r[1], b2 = b.r[2];
+    for (int i = 0; i < 3; ++i) {
+        const Vector4 row = a.r[i];
+        outMatrix.r[i] = (b0 * row.x) + (b1 * row.y) + (b2 * row.z);
+        outMatrix.r[i].w += row.w;
+    }
+#endif
+}
 
-bool Vector3::operator <= (const Vector3& v) const          { return MagnitudeSquared() <= v.MagnitudeSquared(); }
-bool Vector3::operator <= (float v) const                   { return MagnitudeSquared() <= (v * v); }
-bool Vector3::operator <= (double v) const                  { return MagnitudeSquared() <= (float)(v * v); }
-bool Vector3::operator <= (int v) const                     { return MagnitudeSquared() <= (float)(v * v); }
-bool Vector3::operator <= (const class Vector2& v) const    { return MagnitudeSquared() <= v.MagnitudeSquared(); }
-bool Vector3::operator <= (const class Vector4& v) const    { return MagnitudeSquared() <= v.MagnitudeSquared(); }
+Vector3 Matrix3x4::TransformPoint(const Vector3& v) const {
+    return Vector3(r[0].x * v.x + r[0].y * v.y + r[0].z * v.z + r[0].w,
+                   r[1].x * v.x + r[1].y * v.y + r[1].z * v.z + r[1].w,
+                   r[2].x * v.x + r[2].y * v.y + r[2].z * v.z + r[2].w);
+}
+
+Vector3 Matrix3x4::TransformDirection(const Vector3& v) const {
+    return Vector3(r[0].x * v.x + r[0].y * v.y + r[0].z * v.z,
+                   r[1].x * v.x + r[1].y * v.y + r[1].z * v.z,
+                   r[2].x * v.x + r[2].y * v.y + r[2].z * v.z);
+}
+
+XOMATH_END_XO_NS();
 
-bool Vector3::operator > (const Vector3& v) const       { return MagnitudeSquared() > v.MagnitudeSquared(); }
-bool Vector3::operator > (float v) const                { return MagnitudeSquared() > (v * v); }
-bool Vector3::operator > (double v) const               { return MagnitudeSquared() > (float)(v * v); }
-bool Vector3::operator > (int v) const                  { return MagnitudeSquared() > (float)(v * v); }
-bool Vector3::operator > (const class Vector2& v) const { return MagnitudeSquared() > v.MagnitudeSquared(); }
-bool Vector3::operator > (const class Vector4& v) const { return MagnitudeSquared() > v.MagnitudeSquared(); }
+XOMATH_BEGIN_XO_NS();
 
-bool Vector3::operator >= (const Vector3& v) const          { return MagnitudeSquared() >= v.MagnitudeSquared(); }
-bool Vector3::operator >= (float v) const                   { return MagnitudeSquared() >= (v * v); }
-bool Vector3::operator >= (double v) const                  { return MagnitudeSquared() >= (float)(v * v); }
-bool Vector3::operator >= (int v) const                     { return MagnitudeSquared() >= (float)(v * v); }
-bool Vector3::operator >= (const class Vector2& v) const    { return MagnitudeSquared() >= v.MagnitudeSquared(); }
-bool Vector3::operator >= (const class Vector4& v) const    { return MagnitudeSquared() >= v.MagnitudeSquared(); }
+float& Quaternion::operator [](int i) { 
+  return f[i]; 
+}
 
-bool Vector3::operator == (const Vector3& v) const {
-#   if defined(XO_SSE2)
-    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(v, xmm)), sse::Epsilon)) & 7) == 7;
-#   elif XO_SSE
-    // TODO: find a faster way with SSE to do a 'close enough' check.
-    // I'm not sure if there's a way to do the sign bit masking like we have in sse::Abs to acomplish
-    // what we're doing in SSE2
-    return CloseEnough(x, v.x, sse::SSEFloatEpsilon) && CloseEnough(y, v.y, sse::SSEFloatEpsilon) && CloseEnough(z, v.z, sse::SSEFloatEpsilon);
-#   else
-    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon) && CloseEnough(z, v.z, Epsilon);
-#   endif
+const float& Quaternion::operator [](int i) const { 
+  return f[i]; 
 }
-bool Vector3::operator == (float v) const                   { return CloseEnough(MagnitudeSquared(), v*v, Epsilon);}
-bool Vector3::operator == (double v) const                  { return CloseEnough(MagnitudeSquared(), (float)(v*v), Epsilon);}
-bool Vector3::operator == (int v) const                     { return CloseEnough(MagnitudeSquared(), (float)(v*v), Epsilon);}
-bool Vector3::operator == (const class Vector2& v) const {
-#   if defined(XO_SSE)
-    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(_mm_set_ps(0.0f, 0.0f, v.y, v.x), xmm)), sse::Epsilon)) & 3) == 3;
-#   else
-    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon);
-#   endif
+
+Quaternion& Quaternion::operator *= (const Quaternion& q) {
+    // TODO: see if there's a cute intrinsic way to do this.
+    // Every product is taken before anything is assigned, q may be this.
+    const float rx = w * q.x + x * q.w + y * q.z - z * q.y;
+    const float ry = w * q.y - x * q.z + y * q.w + z * q.x;
+    const float rz = w * q.z + x * q.y - y * q.x + z * q.w;
+    const float rw = w * q.w - x * q.x - y * q.y - z * q.z;
+    _XO_ASSIGN_QUAT(rw, rx, ry, rz);
+  return *this;
 }
-bool Vector3::operator == (const class Vector4& v) const {
+
+Quaternion Quaternion::operator * (const Quaternion& q) const {
+  return Quaternion(*this) *= q;
+}
+
+bool Quaternion::operator == (const Quaternion& q) const {
 #   if defined(XO_SSE)
-    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(v.xmm, xmm)), sse::Epsilon)) & 7) == 7;
+    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(q.xmm, xmm)), sse::Epsilon)) & 15) == 15;
 #   else
-    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon) && CloseEnough(z, v.z, Epsilon);
+    return 
+        CloseEnough(x, q.x, Epsilon) && 
+        CloseEnough(y, q.y, Epsilon) && 
+        CloseEnough(z, q.z, Epsilon) &&
+        CloseEnough(w, q.w, Epsilon);
 #   endif
 }
 
-bool Vector3::operator != (const Vector3& v) const          { return !((*this) == v); }
-bool Vector3::operator != (float v) const                   { return !((*this) == v); }
-bool Vector3::operator != (double v) const                  { return !((*this) == v); }
-bool Vector3::operator != (int v) const                     { return !((*this) == v); }
-bool Vector3::operator != (const class Vector2& v) const    { return !((*this) == v); }
-bool Vector3::operator != (const class Vector4& v) const    { return !((*this) == v); }
+bool Quaternion::operator != (const Quaternion& q) const {
+  return !((*this) == q);
+}
 
-_XOINL
-Vector3 Abs(const Vector3& v)
-{
-#if defined(XO_SSE)
-    return (sse::Abs(v.xmm));
-#else
-    return Vector3(Abs(v.x), Abs(v.y), Abs(v.z));
-#endif
+template <Precision P>
+Quaternion& Quaternion::Normalize() {
+    (*(Vector4*)this).Normalize<P>();
+    return *this;
 }
 
 XOMATH_END_XO_NS();
 
 XOMATH_BEGIN_XO_NS();
 
+Vector3 AABB::Center() const {
 #if defined(XO_SSE)
-
-#if !defined(IDX_X)
-#   define IDX_X 0
-#endif
-
-#if !defined(IDX_Y)
-#   define IDX_Y 1
+    return Vector3(_mm_mul_ps(_mm_add_ps(min.xmm, max.xmm), _mm_set1_ps(0.5f)));
+#else
+    return (min + max) * 0.5f;
 #endif
+}
 
-#if !defined(IDX_Z)
-#   define IDX_Z 2
+Vector3 AABB::Extents() const {
+#if defined(XO_SSE)
+    return Vector3(_mm_mul_ps(_mm_sub_ps(max.xmm, min.xmm), _mm_set1_ps(0.5f)));
+#else
+    return (max - min) * 0.5f;
 #endif
+}
 
-#if !defined(IDX_W)
-#   define IDX_W 3
+Vector3 AABB::Size() const {
+#if defined(XO_SSE)
+    return Vector3(_mm_sub_ps(max.xmm, min.xmm));
+#else
+    return max - min;
 #endif
+}
 
+bool AABB::IsEmpty() const {
+#if defined(XO_SSE)
+    // only x, y and z take part, w is whatever the corners were built with.
+    return (_mm_movemask_ps(_mm_cmplt_ps(max.xmm, min.xmm)) & 7) != 0;
+#else
+    return max.x < min.x || max.y < min.y || max.z < min.z;
 #endif
+}
 
+AABB& AABB::Expand(const Vector3& point) {
 #if defined(XO_SSE)
-Vector4::operator const __m128&() const {
-    return xmm;
-}
+    min.xmm = _mm_min_ps(min.xmm, point.xmm);
+    max.xmm = _mm_max_ps(max.xmm, point.xmm);
+#else
+    Vector3::Min(min, point, min);
+    Vector3::Max(max, point, max);
 #endif
-
-float& Vector4::operator [](int i) {
-    return f[i];
+    return *this;
 }
 
-const float& Vector4::operator [](int i) const {
-    return f[i];
+AABB& AABB::Expand(const AABB& box) {
+    Union(*this, box, *this);
+    return *this;
 }
 
-Vector4 Vector4::operator -() const {
+AABB& AABB::Expand(float amount) {
 #if defined(XO_SSE)
-    return Vector4(_mm_mul_ps(xmm, sse::NegativeOne));
+    const __m128 a = _mm_set1_ps(amount);
+    min.xmm = _mm_sub_ps(min.xmm, a);
+    max.xmm = _mm_add_ps(max.xmm, a);
 #else
-    return Vector4(-x, -y, -z, -w);
+    min -= amount;
+    max += amount;
 #endif
+    return *this;
 }
 
-Vector4 Vector4::operator ~() const {
+bool AABB::Contains(const Vector3& point) const {
 #if defined(XO_SSE)
-    return Vector3(_mm_shuffle_ps(xmm, xmm, _MM_SHUFFLE(IDX_X, IDX_Y, IDX_Z, IDX_W)));
+    const __m128 inside = _mm_and_ps(_mm_cmple_ps(min.xmm, point.xmm), _mm_cmple_ps(point.xmm, max.xmm));
+    return (_mm_movemask_ps(inside) & 7) == 7;
 #else
-    return Vector4(w, z, y, x);
+    return min.x <= point.x && point.x <= max.x &&
+           min.y <= point.y && point.y <= max.y &&
+           min.z <= point.z && point.z <= max.z;
 #endif
 }
 
-Vector4& Vector4::operator += (const Vector4& v) {
+bool AABB::Contains(const AABB& box) const {
 #if defined(XO_SSE)
-    xmm = _mm_add_ps(xmm, v.xmm);
+    const __m128 inside = _mm_and_ps(_mm_cmple_ps(min.xmm, box.min.xmm), _mm_cmple_ps(box.max.xmm, max.xmm));
+    return (_mm_movemask_ps(inside) & 7) == 7;
 #else
-    x += v.x;
-    y += v.y;
-    z += v.z;
-    w += v.w;
+    return min.x <= box.min.x && box.max.x <= max.x &&
+           min.y <= box.min.y && box.max.y <= max.y &&
+           min.z <= box.min.z && box.max.z <= max.z;
 #endif
-    return *this;
 }
 
-Vector4& Vector4::operator += (float v) {
+bool AABB::Overlaps(const AABB& box) const {
 #if defined(XO_SSE)
-    xmm = _mm_add_ps(xmm, _mm_set_ps1(v));
+    const __m128 overlap = _mm_and_ps(_mm_cmple_ps(min.xmm, box.max.xmm), _mm_cmple_ps(box.min.xmm, max.xmm));
+    return (_mm_movemask_ps(overlap) & 7) == 7;
 #else
-    x += v;
-    y += v;
-    z += v;
-    w += v;
+    return min.x <= box.max.x && box.min.x <= max.x &&
+           min.y <= box.max.y && box.min.y <= max.y &&
+           min.z <= box.max.z && box.min.z <= max.z;
 #endif
-    return *this;
 }
 
-Vector4& Vector4::operator += (double v)          { return (*this) += (float)v; }
-Vector4& Vector4::operator += (int v)             { return (*this) += (float)v; }
-Vector4& Vector4::operator += (const class Vector2& v)  { return (*this) += Vector4(v); }
-Vector4& Vector4::operator += (const class Vector3& v)  { return (*this) += Vector4(v); }
-
-Vector4& Vector4::operator -= (const Vector4& v) {
+Vector3 AABB::ClosestPoint(const Vector3& point) const {
 #if defined(XO_SSE)
-    xmm = _mm_sub_ps(xmm, v.xmm);
+    return Vector3(_mm_min_ps(_mm_max_ps(point.xmm, min.xmm), max.xmm));
 #else
-    x -= v.x;
-    y -= v.y;
-    z -= v.z;
-    w -= v.w;
+    return Vector3(Clamp(point.x, min.x, max.x), Clamp(point.y, min.y, max.y), Clamp(point.z, min.z, max.z));
 #endif
-    return *this;
 }
 
-Vector4& Vector4::operator -= (float v) {
+float AABB::DistanceSquared(const Vector3& point) const {
 #if defined(XO_SSE)
-    xmm = _mm_sub_ps(xmm, _mm_set_ps1(v));
+    // how far outside each face the point is, zero on the axes where it's between them.
+    const __m128 outside = _mm_max_ps(_mm_max_ps(_mm_sub_ps(min.xmm, point.xmm), _mm_sub_ps(point.xmm, max.xmm)), _mm_setzero_ps());
+    const __m128 squared = _mm_mul_ps(outside, outside);
+    return _mm_cvtss_f32(squared) + _mm_cvtss_f32(_mm_shuffle_ps(squared, squared, _MM_SHUFFLE(1, 1, 1, 1))) + 
+           _mm_cvtss_f32(_mm_shuffle_ps(squared, squared, _MM_SHUFFLE(2, 2, 2, 2)));
 #else
-    x -= v;
-    y -= v;
-    z -= v;
-    w -= v;
+    return Vector3::DistanceSquared(point, ClosestPoint(point));
 #endif
-    return *this;
 }
 
-Vector4& Vector4::operator -= (double v)          { return (*this) -= (float)v; }
-Vector4& Vector4::operator -= (int v)             { return (*this) -= (float)v; }
-Vector4& Vector4::operator -= (const class Vector2& v)  { return (*this) -= Vector4(v); }
-Vector4& Vector4::operator -= (const class Vector3& v)  { return (*this) -= Vector4(v); }
+Vector3 AABB::Support(const Vector3& direction) const {
+#if defined(XO_SSE)
+    const __m128 negative = _mm_cmplt_ps(direction.xmm, _mm_setzero_ps());
+    return Vector3(_mm_or_ps(_mm_and_ps(negative, min.xmm), _mm_andnot_ps(negative, max.xmm)));
+#else
+    return Vector3(direction.x < 0.0f ? min.x : max.x, direction.y < 0.0f ? min.y : max.y, direction.z < 0.0f ? min.z : max.z);
+#endif
+}
 
-Vector4& Vector4::operator *= (const Vector4& v) {
+void AABB::Union(const AABB& a, const AABB& b, AABB& outBox) {
 #if defined(XO_SSE)
-    xmm = _mm_mul_ps(xmm, v.xmm);
+    outBox.min.xmm = _mm_min_ps(a.min.xmm, b.min.xmm);
+    outBox.max.xmm = _mm_max_ps(a.max.xmm, b.max.xmm);
 #else
-    x *= v.x;
-    y *= v.y;
-    z *= v.z;
-    w *= v.w;
+    Vector3::Min(a.min, b.min, outBox.min);
+    Vector3::Max(a.max, b.max, outBox.max);
 #endif
-    return *this;
 }
 
-Vector4& Vector4::operator *= (float v) {
+bool AABB::Intersection(const AABB& a, const AABB& b, AABB& outBox) {
 #if defined(XO_SSE)
-    xmm = _mm_mul_ps(xmm, _mm_set_ps1(v));
+    outBox.min.xmm = _mm_max_ps(a.min.xmm, b.min.xmm);
+    outBox.max.xmm = _mm_min_ps(a.max.xmm, b.max.xmm);
 #else
-    x *= v;
-    y *= v;
-    z *= v;
-    w *= v;
+    Vector3::Max(a.min, b.min, outBox.min);
+    Vector3::Min(a.max, b.max, outBox.max);
 #endif
-    return *this;
+    return !outBox.IsEmpty();
 }
 
-Vector4& Vector4::operator *= (double v)          { return (*this) *= (float)v; }
-Vector4& Vector4::operator *= (int v)             { return (*this) *= (float)v; }
-Vector4& Vector4::operator *= (const class Vector2& v)  { return (*this) *= Vector4(v); }
-Vector4& Vector4::operator *= (const class Vector3& v)  { return (*this) *= Vector4(v); }
+XOMATH_END_XO_NS();
 
-#if defined(XO_NO_INVERSE_DIVISION)
-Vector4& Vector4::operator /= (const Vector4& v) {
-#   if defined(XO_SSE)
-    // see: https://software.intel.com/sites/landingpage/IntrinsicsGuide
-    // see: https://software.intel.com/en-us/articles/measuring-instruction-latency-and-throughput
+XOMATH_BEGIN_XO_NS();
 
-    // _mm_div_ps
-    // -----------------------------------
-    // Architecture    Latency Throughput
-    // Haswell         13      5
-    // Ivy Bridge      13      6
-    // Sandy Bridge    14      14
-    // Westmere        14      12
-    // Nehalem         14      12
-    xmm = _mm_div_ps(xmm, v.xmm);
-#   else
-    x /= v.x;
-    y /= v.y;
-    z /= v.z;
-    w /= v.w;
-#   endif
-    return *this;
+bool Frustum::Contains(const Vector3& point) const {
+    for (int i = 0; i < PlaneCount; ++i) {
+        const Vector4& p = planes[i];
+        if (p.x * point.x + p.y * point.y + p.z * point.z + p.w < 0.0f) {
+            return false;
+        }
+    }
+    return true;
 }
 
-Vector4& Vector4::operator /= (float v) {
-#   if defined(XO_SSE)
-    xmm = _mm_div_ps(xmm, _mm_set_ps1(v));
-#   else
-    x /= v;
-    y /= v;
-    z /= v;
-    w /= v;
-#   endif
-    return *this;
+bool Frustum::IntersectsSphere(const Vector3& center, float radius) const {
+    uint32_t planeMask = AllPlanes;
+    return IntersectsSphere(center, radius, planeMask);
 }
-#else
 
-Vector4& Vector4::operator /= (const Vector4& v) {
-#   if defined(XO_SSE)
-    // see: https://software.intel.com/sites/landingpage/IntrinsicsGuide
-    // see: https://software.intel.com/en-us/articles/measuring-instruction-latency-and-throughput
+bool Frustum::IntersectsSphere(const Vector3& center, float radius, uint32_t& inOutPlaneMask) const {
+    uint32_t mask = inOutPlaneMask;
+    for (int i = 0; i < PlaneCount; ++i) {
+        if (inOutPlaneMask & (1 << i)) {
+            const Vector4& p = planes[i];
+            const float distance = p.x * center.x + p.y * center.y + p.z * center.z + p.w;
+            if (distance < -radius) {
+                return false;
+            }
+            if (distance >= radius) {
+                mask &= ~(1 << i);
+            }
+        }
+    }
+    inOutPlaneMask = mask;
+    return true;
+}
 
-    // _mm_rcp_ps
-    // -----------------------------------
-    // Architecture    Latency  Throughput
-    // Haswell         5        1
-    // Ivy Bridge      5        1
-    // Sandy Bridge    5        1
-    // Westmere        3        2
-    // Nehalem         3        2
+bool Frustum::IntersectsAABB(const AABB& box) const {
+    uint32_t planeMask = AllPlanes;
+    return IntersectsAABB(box, planeMask);
+}
 
-    // _mm_mul_ps
-    // -----------------------------------
-    // Architecture    Latency  Throughput
-    // Haswell         5        0.5
-    // Ivy Bridge      5        1
-    // Sandy Bridge    5        1
-    // Westmere        4        1
-    // Nehalem         4        1
-    xmm = _mm_mul_ps(xmm, _mm_rcp_ps(v.xmm));
-#   else
-    x /= v.x;
-    y /= v.y;
-    z /= v.z;
-    w /= v.w;
-#endif
+bool Frustum::IntersectsAABB(const AABB& box, uint32_t& inOutPlaneMask) const {
+    const Vector3 center = box.Center(), extents = box.Extents();
+    uint32_t mask = inOutPlaneMask;
+    for (int i = 0; i < PlaneCount; ++i) {
+        if (inOutPlaneMask & (1 << i)) {
+            const Vector4& p = planes[i];
+            const float distance = p.x * center.x + p.y * center.y + p.z * center.z + p.w;
+            // how far the box reaches toward the plane, along its normal.
+            const float radius = Abs(p.x) * extents.x + Abs(p.y) * extents.y + Abs(p.z) * extents.z;
+            if (distance < -radius) {
+                return false;
+            }
+            if (distance >= radius) {
+                mask &= ~(1 << i);
+            }
+        }
+    }
+    inOutPlaneMask = mask;
+    return true;
+}
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+bool Ray::IntersectTriangle(const Vector3& v0, const Vector3& v1, const Vector3& v2, float& inOutT, float& outU, float& outV) const {
+    const Vector3& o = origin;
+    const Vector3& d = direction;
+    const float e1x = v1.x - v0.x, e1y = v1.y - v0.y, e1z = v1.z - v0.z;
+    const float e2x = v2.x - v0.x, e2y = v2.y - v0.y, e2z = v2.z - v0.z;
+    const float px = d.y * e2z - d.z * e2y, py = d.z * e2x - d.x * e2z, pz = d.x * e2y - d.y * e2x;
+    const float det = e1x * px + e1y * py + e1z * pz;
+    if (det == 0.0f) {
+        // the ray is parallel to the triangle's plane.
+        return false;
+    }
+    const float inverseDet = 1.0f / det;
+    const float sx = o.x - v0.x, sy = o.y - v0.y, sz = o.z - v0.z;
+    const float u = (sx * px + sy * py + sz * pz) * inverseDet;
+    const float qx = sy * e1z - sz * e1y, qy = sz * e1x - sx * e1z, qz = sx * e1y - sy * e1x;
+    const float v = (d.x * qx + d.y * qy + d.z * qz) * inverseDet;
+    const float t = (e2x * qx + e2y * qy + e2z * qz) * inverseDet;
+    // written so that a NaN anywhere is a miss.
+    if (!(u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t >= 0.0f && t < inOutT)) {
+        return false;
+    }
+    inOutT = t;
+    outU = u;
+    outV = v;
+    return true;
+}
+
+bool Ray::IntersectAABB(const AABB& box, float& inOutT) const {
+    float enter = 0.0f, exit = inOutT;
+    for (int i = 0; i < 3; ++i) {
+        // a zero direction divides to +-infinity, which keeps the slab only when the origin lies within it.
+        const float inverse = 1.0f / direction[i];
+        float t0 = (box.min[i] - origin[i]) * inverse;
+        float t1 = (box.max[i] - origin[i]) * inverse;
+        if (t0 > t1) {
+            const float swap = t0;
+            t0 = t1;
+            t1 = swap;
+        }
+        enter = t0 > enter ? t0 : enter;
+        exit = t1 < exit ? t1 : exit;
+    }
+    if (!(enter <= exit && enter < inOutT)) {
+        return false;
+    }
+    inOutT = enter;
+    return true;
+}
+
+bool Ray::IntersectSphere(const Vector3& center, float radius, float& inOutT) const {
+    // Solves |origin + direction * t - center|^2 = radius^2 as a t^2 + 2 b t + c = 0.
+    const Vector3& d = direction;
+    const float ox = origin.x - center.x, oy = origin.y - center.y, oz = origin.z - center.z;
+    const float a = d.x * d.x + d.y * d.y + d.z * d.z;
+    const float b = ox * d.x + oy * d.y + oz * d.z;
+    const float c = ox * ox + oy * oy + oz * oz - radius * radius;
+    const float discriminant = b * b - a * c;
+    if (discriminant < 0.0f) {
+        return false;
+    }
+    const float root = Sqrt(discriminant);
+    const float inverseA = 1.0f / a;
+    const float tNear = (-b - root) * inverseA;
+    const float t = tNear >= 0.0f ? tNear : (-b + root) * inverseA;
+    if (!(t >= 0.0f && t < inOutT)) {
+        return false;
+    }
+    inOutT = t;
+    return true;
+}
+
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+BoundingSphere& BoundingSphere::Expand(const Vector3& point) {
+    if (IsEmpty()) {
+        return Set(point, 0.0f);
+    }
+    const Vector3 offset = point - center;
+    const float distanceSquared = offset.MagnitudeSquared();
+    if (distanceSquared > radius * radius) {
+        // the new sphere touches point and the far side of the old one.
+        const float distance = Sqrt(distanceSquared);
+        const float grownRadius = (radius + distance) * 0.5f;
+        center += offset * ((grownRadius - radius) / distance);
+        radius = grownRadius;
+    }
     return *this;
 }
 
-Vector4& Vector4::operator /= (float v) { 
-#   if defined(XO_SSE)
-    xmm = _mm_mul_ps(xmm, _mm_set_ps1(1.0f/v));
-#   else
-    v = 1.0f / v;
-    x *= v;
-    y *= v;
-    z *= v;
-    w *= v;
-#   endif
+BoundingSphere& BoundingSphere::Expand(const BoundingSphere& sphere) {
+    if (sphere.IsEmpty() || Contains(sphere)) {
+        return *this;
+    }
+    if (IsEmpty() || sphere.Contains(*this)) {
+        return *this = sphere;
+    }
+    const Vector3 offset = sphere.center - center;
+    const float distance = offset.Magnitude();
+    const float grownRadius = (distance + radius + sphere.radius) * 0.5f;
+    center += offset * ((grownRadius - radius) / distance);
+    radius = grownRadius;
     return *this;
 }
-#endif
-Vector4& Vector4::operator /= (double v)          { return (*this) /= float(v); }
-Vector4& Vector4::operator /= (int v)             { return (*this) /= float(v); }
-Vector4& Vector4::operator /= (const class Vector2& v)  { return (*this) /= Vector4(v); }
-Vector4& Vector4::operator /= (const class Vector3& v)  { return (*this) /= Vector4(v); }
 
-Vector4 Vector4::operator + (const Vector4& v) const    { return Vector4(*this) += v; }
-Vector4 Vector4::operator + (float v) const             { return Vector4(*this) += v; }
-Vector4 Vector4::operator + (double v) const            { return Vector4(*this) += v; }
-Vector4 Vector4::operator + (int v) const               { return Vector4(*this) += v; }
-Vector4 Vector4::operator + (const class Vector2& v) const    { return Vector4(*this) += v; }
-Vector4 Vector4::operator + (const class Vector3& v) const    { return Vector4(*this) += v; }
+bool BoundingSphere::Contains(const Vector3& point) const {
+    return Vector3::DistanceSquared(center, point) <= radius * radius && !IsEmpty();
+}
 
-Vector4 Vector4::operator - (const Vector4& v) const    { return Vector4(*this) -= v; }
-Vector4 Vector4::operator - (float v) const             { return Vector4(*this) -= v; }
-Vector4 Vector4::operator - (double v) const            { return Vector4(*this) -= v; }
-Vector4 Vector4::operator - (int v) const               { return Vector4(*this) -= v; }
-Vector4 Vector4::operator - (const class Vector2& v) const    { return Vector4(*this) -= v; }
-Vector4 Vector4::operator - (const class Vector3& v) const    { return Vector4(*this) -= v; }
+bool BoundingSphere::Contains(const BoundingSphere& sphere) const {
+    if (sphere.IsEmpty()) {
+        return true;
+    }
+    const float room = radius - sphere.radius;
+    return room >= 0.0f && Vector3::DistanceSquared(center, sphere.center) <= room * room;
+}
 
-Vector4 Vector4::operator * (const Vector4& v) const    { return Vector4(*this) *= v; }
-Vector4 Vector4::operator * (float v) const             { return Vector4(*this) *= v; }
-Vector4 Vector4::operator * (double v) const            { return Vector4(*this) *= v; }
-Vector4 Vector4::operator * (int v) const               { return Vector4(*this) *= v; }
-Vector4 Vector4::operator * (const class Vector2& v) const    { return Vector4(*this) *= v; }
-Vector4 Vector4::operator * (const class Vector3& v) const    { return Vector4(*this) *= v; }
+bool BoundingSphere::Overlaps(const BoundingSphere& sphere) const {
+    const float reach = radius + sphere.radius;
+    return Vector3::DistanceSquared(center, sphere.center) <= reach * reach && !IsEmpty() && !sphere.IsEmpty();
+}
 
-Vector4 Vector4::operator / (const Vector4& v) const    { return Vector4(*this) /= v; }
-Vector4 Vector4::operator / (float v) const             { return Vector4(*this) /= v; }
-Vector4 Vector4::operator / (double v) const            { return Vector4(*this) /= v; }
-Vector4 Vector4::operator / (int v) const               { return Vector4(*this) /= v; }
-Vector4 Vector4::operator / (const class Vector2& v) const    { return Vector4(*this) /= v; }
-Vector4 Vector4::operator / (const class Vector3& v) const    { return Vector4(*this) /= v; }
+Vector3 BoundingSphere::Support(const Vector3& direction) const {
+    const float lengthSquared = direction.MagnitudeSquared();
+    return lengthSquared > 0.0f ? center + direction * (radius / Sqrt(lengthSquared)) : center;
+}
 
-bool Vector4::operator < (const Vector4& v) const       { return MagnitudeSquared() < v.MagnitudeSquared(); }
-bool Vector4::operator < (float v) const                { return MagnitudeSquared() < (v * v); }
-bool Vector4::operator < (double v) const               { return MagnitudeSquared() < (float)(v * v); }
-bool Vector4::operator < (int v) const                  { return MagnitudeSquared() < (float)(v * v); }
-bool Vector4::operator < (const class Vector2& v) const       { return MagnitudeSquared() < v.MagnitudeSquared(); }
-bool Vector4::operator < (const class Vector3& v) const       { return MagnitudeSquared() < v.MagnitudeSquared(); }
+XOMATH_END_XO_NS();
 
-bool Vector4::operator <= (const Vector4& v) const      { return MagnitudeSquared() <= v.MagnitudeSquared(); }
-bool Vector4::operator <= (float v) const               { return MagnitudeSquared() <= (v * v); }
-bool Vector4::operator <= (double v) const              { return MagnitudeSquared() <= (float)(v * v); }
-bool Vector4::operator <= (int v) const                 { return MagnitudeSquared() <= (float)(v * v); }
-bool Vector4::operator <= (const class Vector2& v) const      { return MagnitudeSquared() <= v.MagnitudeSquared(); }
-bool Vector4::operator <= (const class Vector3& v) const      { return MagnitudeSquared() <= v.MagnitudeSquared(); }
+XOMATH_BEGIN_XO_NS();
 
-bool Vector4::operator > (const Vector4& v) const       { return MagnitudeSquared() > v.MagnitudeSquared(); }
-bool Vector4::operator > (float v) const                { return MagnitudeSquared() > (v * v); }
-bool Vector4::operator > (double v) const               { return MagnitudeSquared() > (float)(v * v); }
-bool Vector4::operator > (int v) const                  { return MagnitudeSquared() > (float)(v * v); }
-bool Vector4::operator > (const class Vector2& v) const       { return MagnitudeSquared() > v.MagnitudeSquared(); }
-bool Vector4::operator > (const class Vector3& v) const       { return MagnitudeSquared() > v.MagnitudeSquared(); }
+float Plane::SignedDistance(const Vector3& point) const {
+    return normal.x * point.x + normal.y * point.y + normal.z * point.z + d;
+}
 
-bool Vector4::operator >= (const Vector4& v) const      { return MagnitudeSquared() >= v.MagnitudeSquared(); }
-bool Vector4::operator >= (float v) const               { return MagnitudeSquared() >= (v * v); }
-bool Vector4::operator >= (double v) const              { return MagnitudeSquared() >= (float)(v * v); }
-bool Vector4::operator >= (int v) const                 { return MagnitudeSquared() >= (float)(v * v); }
-bool Vector4::operator >= (const class Vector2& v) const      { return MagnitudeSquared() >= v.MagnitudeSquared(); }
-bool Vector4::operator >= (const class Vector3& v) const      { return MagnitudeSquared() >= v.MagnitudeSquared(); }
+Vector3 Plane::ClosestPoint(const Vector3& point) const {
+    return point - normal * SignedDistance(point);
+}
 
-bool Vector4::operator == (const Vector4& v) const {
-#   if defined(XO_SSE2)
-    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(v.xmm, xmm)), sse::Epsilon)) & 15) == 15;
-#   elif XO_SSE
-    // TODO: find a faster way with SSE to do a 'close enough' check.
-    // I'm not sure if there's a way to do the sign bit masking like we have in sse::Abs to acomplish
-    // what we're doing in SSE2
-    return 
-        CloseEnough(x, v.x, sse::SSEFloatEpsilon) && 
-        CloseEnough(y, v.y, sse::SSEFloatEpsilon) && 
-        CloseEnough(z, v.z, sse::SSEFloatEpsilon) &&
-        CloseEnough(w, v.w, sse::SSEFloatEpsilon);
-#   else
-    return 
-        CloseEnough(x, v.x, Epsilon) && 
-        CloseEnough(y, v.y, Epsilon) && 
-        CloseEnough(z, v.z, Epsilon) &&
-        CloseEnough(w, v.w, Epsilon);
-#   endif
+PlaneSide Plane::Classify(const Vector3& point, float epsilon) const {
+    const float distance = SignedDistance(point);
+    return distance > epsilon ? PlaneSide::Front : distance < -epsilon ? PlaneSide::Back : PlaneSide::On;
 }
-bool Vector4::operator == (float v) const           { return CloseEnough(MagnitudeSquared(), v * v, Epsilon); }
-bool Vector4::operator == (double v) const          { return CloseEnough(MagnitudeSquared(), (float)(v * v), Epsilon); }
-bool Vector4::operator == (int v) const             { return CloseEnough(MagnitudeSquared(), (float)(v * v), Epsilon); }
 
-bool Vector4::operator == (const class Vector2& v) const {
-#   if defined(XO_SSE)
-    // Todo: check that this is actually faster.
-    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(xmm, _mm_set_ps(0.0f, 0.0f, v.y, v.x))), sse::Epsilon)) & 3) == 3;
-#   else
-    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon);
-#   endif
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+template <class ShapeA, class ShapeB>
+bool GJK::Run(const ShapeA& a, const ShapeB& b, Simplex& outSimplex, Cache* cache, bool stopWhenSeparated) {
+    // v is the point of the simplex closest to the origin. Each step adds the support point of the difference 
+    // furthest towards the origin from v, w, and moves v to the closest point of the new simplex.
+    const Vector3 start = cache && cache->direction.MagnitudeSquared() > 0.0f ? cache->direction : Vector3::UnitX;
+    outSimplex.count = 0;
+    outSimplex.Add(a.Support(-start), b.Support(start));
+    outSimplex.weights[0] = 1.0f;
+    Vector3 v = outSimplex.points[0];
+    bool inside = false;
+    for (int i = 0; i < MaxIterations; ++i) {
+        const float vv = v.MagnitudeSquared();
+        float largest = 0.0f;
+        for (int p = 0; p < outSimplex.count; ++p) {
+            largest = Max(largest, outSimplex.points[p].MagnitudeSquared());
+        }
+        // the origin is on the simplex, to within the precision of its points.
+        if (vv <= Tolerance * Tolerance * largest) {
+            inside = true;
+            break;
+        }
+        const Vector3 supportA = a.Support(-v), supportB = b.Support(v);
+        const Vector3 w = supportA - supportB;
+        const float vw = v.Dot(w);
+        // every point of the difference is on the far side of the plane through w facing v, and so is the origin.
+        if (stopWhenSeparated && vw > 0.0f) {
+            break;
+        }
+        // w is no closer to the origin than v along v, so v is as close as the difference gets.
+        if (vv - vw <= Tolerance * vv || outSimplex.Contains(w)) {
+            break;
+        }
+        const Simplex last = outSimplex;
+        outSimplex.Add(supportA, supportB);
+        const Vector3 closer = outSimplex.Reduce();
+        if (outSimplex.count == 4) {
+            inside = true;
+            break;
+        }
+        // rounding in a sliver of a simplex can give a point further away, which would only send the search in circles.
+        if (closer.MagnitudeSquared() >= vv) {
+            outSimplex = last;
+            break;
+        }
+        v = closer;
+    }
+    if (cache && !inside) {
+        cache->direction = v;
+    }
+    return inside;
 }
 
-bool Vector4::operator == (const class Vector3& v) const {
-#   if defined(XO_SSE)
-    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(v.xmm, xmm)), sse::Epsilon)) & 7) == 7;
-#   else
-    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon) && CloseEnough(z, v.z, Epsilon);
-#   endif
+template <class ShapeA, class ShapeB>
+bool GJK::Intersects(const ShapeA& a, const ShapeB& b, Cache* cache) {
+    Simplex simplex;
+    return Run(a, b, simplex, cache, true);
 }
 
-bool Vector4::operator != (const Vector4& v) const  { return !((*this) == v); }
-bool Vector4::operator != (float v) const           { return !((*this) == v); }
-bool Vector4::operator != (double v) const          { return !((*this) == v); }
-bool Vector4::operator != (int v) const             { return !((*this) == v); }
-bool Vector4::operator != (const class Vector2& v) const  { return !((*this) == v); }
-bool Vector4::operator != (const class Vector3& v) const  { return !((*this) == v); }
+template <class ShapeA, class ShapeB>
+float GJK::Distance(const ShapeA& a, const ShapeB& b, Vector3& outPointA, Vector3& outPointB, Cache* cache) {
+    Simplex simplex;
+    if (Run(a, b, simplex, cache, false)) {
+        outPointA = outPointB = simplex.PointA();
+        return 0.0f;
+    }
+    outPointA = simplex.PointA();
+    outPointB = simplex.PointB();
+    return (outPointA - outPointB).Magnitude();
+}
 
-_XOINL 
-Vector4 Abs(const Vector4& v)
-{
-#if defined(XO_SSE)
-    return (sse::Abs(v.xmm));
-#else
-    return Vector4(Abs(v.x), Abs(v.y), Abs(v.z));
-#endif
+XOMATH_END_XO_NS();
+
+XOMATH_BEGIN_XO_NS();
+
+template <class ShapeA, class ShapeB>
+bool EPA::Complete(const ShapeA& a, const ShapeB& b, GJK::Simplex& simplex) {
+    // GJK stops with fewer than four points when the origin is on the simplex, which happens when the shapes touch. 
+    // Support points in directions away from the simplex make it a tetrahedron, with the origin on its surface.
+    float size = 0.0f;
+    for (int p = 0; p < simplex.count; ++p) {
+        size = Max(size, simplex.points[p].Magnitude());
+    }
+    const float apart = Tolerance * Max(size, 1e-6f);
+    if (simplex.count == 1) {
+        for (int axis = 0; axis < 6 && simplex.count == 1; ++axis) {
+            Vector3 direction(0.0f);
+            direction[axis % 3] = axis < 3 ? 1.0f : -1.0f;
+            const Vector3 supportA = a.Support(direction), supportB = b.Support(-direction);
+            if (Vector3::DistanceSquared(supportA - supportB, simplex.points[0]) > apart * apart) {
+                simplex.Add(supportA, supportB);
+            }
+        }
+    }
+    if (simplex.count == 2) {
+        const Vector3 line = (simplex.points[1] - simplex.points[0]).Normalized();
+        // crossed with the axis the line is least along, for two directions perpendicular to it.
+        const Vector3 axis = Abs(line.x) <= Abs(line.y) && Abs(line.x) <= Abs(line.z) ? Vector3::UnitX : Abs(line.y) <= Abs(line.z) ? Vector3::UnitY : Vector3::UnitZ;
+        const Vector3 across = line.Cross(axis).Normalized(), across2 = line.Cross(across);
+        for (int turn = 0; turn < 6 && simplex.count == 2; ++turn) {
+            const float angle = turn * (PI / 3.0f);
+            const Vector3 direction = across * Cos(angle) + across2 * Sin(angle);
+            const Vector3 supportA = a.Support(direction), supportB = b.Support(-direction);
+            const Vector3 fromLine = supportA - supportB - simplex.points[0];
+            if ((fromLine - line * fromLine.Dot(line)).MagnitudeSquared() > apart * apart) {
+                simplex.Add(supportA, supportB);
+            }
+        }
+    }
+    if (simplex.count == 3) {
+        const Vector3 normal = (simplex.points[1] - simplex.points[0]).Cross(simplex.points[2] - simplex.points[0]).Normalized();
+        for (int side = 0; side < 2 && simplex.count == 3; ++side) {
+            const Vector3 direction = side ? -normal : normal;
+            const Vector3 supportA = a.Support(direction), supportB = b.Support(-direction);
+            if (Abs((supportA - supportB - simplex.points[0]).Dot(normal)) > apart) {
+                simplex.Add(supportA, supportB);
+            }
+        }
+    }
+    return simplex.count == 4;
 }
 
-#undef IDX_X
-#undef IDX_Y
-#undef IDX_Z
-#undef IDX_W
+template <class ShapeA, class ShapeB>
+bool EPA::Penetration(const ShapeA& a, const ShapeB& b, Vector3& outNormal, float& outDepth, Vector3& outPointA, Vector3& outPointB, GJK::Cache* cache) {
+    GJK::Simplex simplex;
+    if (!GJK::Run(a, b, simplex, cache, true)) {
+        return false;
+    }
+    Polytope polytope;
+    if (!Complete(a, b, simplex) || !polytope.Start(simplex)) {
+        // the difference is flat, so the shapes touch without overlapping.
+        // the cache points from B towards A, as the closest point of the difference does.
+        outNormal = cache && cache->direction.MagnitudeSquared() > 0.0f ? -cache->direction.Normalized() : Vector3::UnitX;
+        outDepth = 0.0f;
+        outPointA = outPointB = simplex.PointA();
+        return true;
+    }
+    int face = polytope.ClosestFace();
+    for (int i = 0; i < MaxIterations; ++i) {
+        const Polytope::Face& closest = polytope.faces[face];
+        const Vector3 supportA = a.Support(closest.normal), supportB = b.Support(-closest.normal);
+        const float distance = (supportA - supportB).Dot(closest.normal);
+        // the difference reaches no further past the face than the tolerance, so the face is on its surface.
+        if (distance - closest.distance <= Tolerance * Max(distance, polytope.size) || !polytope.Expand(supportA, supportB)) {
+            break;
+        }
+        face = polytope.ClosestFace();
+    }
+    outNormal = polytope.faces[face].normal;
+    outDepth = Max(polytope.faces[face].distance, 0.0f);
+    polytope.Contact(face, outPointA, outPointB);
+    if (cache) {
+        cache->direction = -outNormal;
+    }
+    return true;
+}
 
 XOMATH_END_XO_NS();
 
 XOMATH_BEGIN_XO_NS();
 
-const Vector4& Matrix4x4::operator [](int i) const {
-    return r[i];
+template <class T>
+void Morton::Permute(const T* items, const uint32_t* order, size_t count, T* outItems) {
+    XO_ASSERT(items + count <= outItems || outItems + count <= items, "xo-math Morton::Permute items and outItems overlap.");
+    for (size_t i = 0; i < count; ++i) {
+        outItems[i] = items[order[i]];
+    }
 }
 
-Vector4& Matrix4x4::operator [](int i) {
-    return r[i];
-}
+XOMATH_END_XO_NS();
 
-const float& Matrix4x4::operator ()(int r, int c) const {
-    return this->r[r][c];
+XOMATH_BEGIN_XO_NS();
+
+#if defined(XO_SSE)
+namespace xo_internal {
+    // v rotated by the normalized quaternion q: t = 2 * cross(q.xyz, v), v' = v + q.w * t + cross(q.xyz, t). The w 
+    // lane of q is carried through the cross products, where it cancels to zero. Each cross product comes out with 
+    // its lanes in z, x, y order and is put back by one more shuffle.
+    _XOINL __m128 TransformRotate(__m128 q, __m128 v) {
+        const __m128 qYZX = _mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 0, 2, 1));
+        __m128 t = _mm_sub_ps(_mm_mul_ps(q, _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 2, 1))), _mm_mul_ps(qYZX, v));
+        t = _mm_shuffle_ps(t, t, _MM_SHUFFLE(3, 0, 2, 1));
+        t = _mm_add_ps(t, t);
+        const __m128 c = _mm_sub_ps(_mm_mul_ps(q, _mm_shuffle_ps(t, t, _MM_SHUFFLE(3, 0, 2, 1))), _mm_mul_ps(qYZX, t));
+        return _mm_add_ps(sse::MulAdd(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 3, 3, 3)), t, v), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1)));
+    }
+
+    // The quaternion product a * b as a sum of b scaled by each element of a, with the elements of b swapped and 
+    // negated to match. The same terms as Quaternion::operator *=.
+    _XOINL __m128 TransformQuaternionMultiply(__m128 a, __m128 b) {
+        __m128 q = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)), b);
+        q = sse::MulAdd(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)),
+                        _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3)), _mm_set_ps(-0.0f, 0.0f, -0.0f, 0.0f)), q);
+        q = sse::MulAdd(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)),
+                        _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2)), _mm_set_ps(-0.0f, -0.0f, 0.0f, 0.0f)), q);
+        return sse::MulAdd(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)),
+                           _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1)), _mm_set_ps(-0.0f, 0.0f, 0.0f, -0.0f)), q);
+    }
 }
+#endif
 
-float& Matrix4x4::operator ()(int r, int c) {
-    return this->r[r][c];
+Transform& Transform::operator *= (const Transform& t) {
+    Multiply(*this, t, *this);
+    return *this;
 }
 
-Matrix4x4 Matrix4x4::operator ~() const {
-    auto m = *this;
-    return m.Transpose();
+Transform Transform::operator * (const Transform& t) const {
+    Transform result;
+    Multiply(*this, t, result);
+    return result;
 }
 
-Matrix4x4& Matrix4x4::operator += (const Matrix4x4& m) {
-    r[0] += m[0];
-    r[1] += m[1];
-    r[2] += m[2];
-    r[3] += m[3];
-    return *this;
+Vector3 Transform::operator * (const Vector3& v) const {
+    return TransformPoint(v);
 }
 
-Matrix4x4& Matrix4x4::operator -= (const Matrix4x4& m) {
-    r[0] -= m[0];
-    r[1] -= m[1];
-    r[2] -= m[2];
-    r[3] -= m[3];
-    return *this;
+Vector3 Transform::TransformPoint(const Vector3& v) const {
+#if defined(XO_SSE)
+    return Vector3(_mm_add_ps(translation.xmm, xo_internal::TransformRotate(rotation.xmm, _mm_mul_ps(scale.xmm, v.xmm))));
+#else
+    return translation + Rotate(rotation, scale * v);
+#endif
 }
 
-Matrix4x4& Matrix4x4::operator *= (const Matrix4x4& m) {
-    auto t = m.Transposed();
-    return (*this) = Matrix4x4(
-        (r[0] * t[0]).Sum(), (r[0] * t[1]).Sum(), (r[0] * t[2]).Sum(), (r[0] * t[3]).Sum(),
-        (r[1] * t[0]).Sum(), (r[1] * t[1]).Sum(), (r[1] * t[2]).Sum(), (r[1] * t[3]).Sum(),
-        (r[2] * t[0]).Sum(), (r[2] * t[1]).Sum(), (r[2] * t[2]).Sum(), (r[2] * t[3]).Sum(),
-        (r[3] * t[0]).Sum(), (r[3] * t[1]).Sum(), (r[3] * t[2]).Sum(), (r[3] * t[3]).Sum()
-    );
+Vector3 Transform::TransformDirection(const Vector3& v) const {
+#if defined(XO_SSE)
+    return Vector3(xo_internal::TransformRotate(rotation.xmm, _mm_mul_ps(scale.xmm, v.xmm)));
+#else
+    return Rotate(rotation, scale * v);
+#endif
 }
 
-Matrix4x4 Matrix4x4::operator + (const Matrix4x4& m) const { return Matrix4x4(*this) += m; }
-Matrix4x4 Matrix4x4::operator - (const Matrix4x4& m) const { return Matrix4x4(*this) -= m; }
-Matrix4x4 Matrix4x4::operator * (const Matrix4x4& m) const { return Matrix4x4(*this) *= m; }
+Vector3 Transform::InverseTransformPoint(const Vector3& v) const {
+    return Rotate(rotation.Conjugate(), v - translation) * Vector3(1.0f / scale.x, 1.0f / scale.y, 1.0f / scale.z);
+}
 
-Vector4 Matrix4x4::operator * (const Vector4& v) const {
-    return Vector4((r[0] * v).Sum(), (r[1] * v).Sum(), (r[2] * v).Sum(), (r[3] * v).Sum());
+Vector3 Transform::Rotate(const Quaternion& q, const Vector3& v) {
+#if defined(XO_SSE)
+    return Vector3(xo_internal::TransformRotate(q.xmm, v.xmm));
+#else
+    // t = 2 * cross(q.xyz, v), v' = v + q.w * t + cross(q.xyz, t)
+    const Vector3 u(q.x, q.y, q.z);
+    const Vector3 t = u.Cross(v) * 2.0f;
+    return v + (t * q.w) + u.Cross(t);
+#endif
 }
 
-Vector3 Matrix4x4::operator * (const Vector3& v) const {
-    return Vector3((r[0] * v).Sum(), (r[1] * v).Sum(), (r[2] * v).Sum());
+void Transform::Multiply(const Transform& a, const Transform& b, Transform& outTransform) {
+    // Every part of a and b is read before anything is written, so outTransform may alias either input.
+#if defined(XO_SSE)
+    const __m128 translation = _mm_add_ps(a.translation.xmm, xo_internal::TransformRotate(a.rotation.xmm, _mm_mul_ps(a.scale.xmm, b.translation.xmm)));
+    const __m128 rotation = xo_internal::TransformQuaternionMultiply(a.rotation.xmm, b.rotation.xmm);
+    outTransform.scale.xmm = _mm_mul_ps(a.scale.xmm, b.scale.xmm);
+    outTransform.rotation.xmm = rotation;
+    outTransform.translation.xmm = translation;
+#else
+    const Vector3 translation = a.translation + Rotate(a.rotation, a.scale * b.translation);
+    const Quaternion rotation = a.rotation * b.rotation;
+    outTransform.scale = a.scale * b.scale;
+    outTransform.rotation = rotation;
+    outTransform.translation = translation;
+#endif
 }
 
 XOMATH_END_XO_NS();
 
 XOMATH_BEGIN_XO_NS();
 
-float& Quaternion::operator [](int i) { 
-  return f[i]; 
+DualQuaternion& DualQuaternion::operator *= (const DualQuaternion& q) {
+    Multiply(*this, q, *this);
+    return *this;
 }
 
-const float& Quaternion::operator [](int i) const { 
-  return f[i]; 
+DualQuaternion DualQuaternion::operator * (const DualQuaternion& q) const {
+    DualQuaternion result;
+    Multiply(*this, q, result);
+    return result;
 }
 
-Quaternion& Quaternion::operator *= (const Quaternion& q) {
-    // TODO: see if there's a cute intrinsic way to do this.
-    _XO_ASSIGN_QUAT(
-      w * q.x + x * q.w + y * q.z - z * q.y,
-      w * q.y - x * q.z + y * q.w + z * q.x,
-      w * q.z + x * q.y - y * q.x + z * q.w,
-      w * q.w - x * q.x - y * q.y - z * q.z);
-  return *this;
+Vector3 DualQuaternion::operator * (const Vector3& v) const {
+    return TransformPoint(v);
 }
 
-Quaternion Quaternion::operator * (const Quaternion& q) const {
-  return Quaternion(*this) *= q;
+Vector3 DualQuaternion::GetTranslation() const {
+    // The vector part of 2 * dual * conjugate(real): 2 * (real.w * dual.xyz - dual.w * real.xyz + real.xyz x dual.xyz)
+#if defined(XO_SSE)
+    const __m128 r = real.xmm, d = dual.xmm;
+    const __m128 rYZX = _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 c = _mm_sub_ps(_mm_mul_ps(r, _mm_shuffle_ps(d, d, _MM_SHUFFLE(3, 0, 2, 1))), _mm_mul_ps(rYZX, d));
+    c = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+    const __m128 t = _mm_sub_ps(sse::MulAdd(_mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3)), d, c), 
+                                _mm_mul_ps(_mm_shuffle_ps(d, d, _MM_SHUFFLE(3, 3, 3, 3)), r));
+    return Vector3(_mm_add_ps(t, t));
+#else
+    const Vector3 r(real.x, real.y, real.z), d(dual.x, dual.y, dual.z);
+    return ((d * real.w) - (r * dual.w) + r.Cross(d)) * 2.0f;
+#endif
 }
 
-bool Quaternion::operator == (const Quaternion& q) const {
-#   if defined(XO_SSE)
-    return (_mm_movemask_ps(_mm_cmplt_ps(sse::Abs(_mm_sub_ps(q.xmm, xmm)), sse::Epsilon)) & 15) == 15;
-#   else
-    return 
-        CloseEnough(x, q.x, Epsilon) && 
-        CloseEnough(y, q.y, Epsilon) && 
-        CloseEnough(z, q.z, Epsilon) &&
-        CloseEnough(w, q.w, Epsilon);
-#   endif
+Vector3 DualQuaternion::TransformPoint(const Vector3& v) const {
+    return Transform::Rotate(real, v) + GetTranslation();
 }
 
-bool Quaternion::operator != (const Quaternion& q) const {
-  return !((*this) == q);
+Vector3 DualQuaternion::TransformDirection(const Vector3& v) const {
+    return Transform::Rotate(real, v);
+}
+
+void DualQuaternion::Multiply(const DualQuaternion& a, const DualQuaternion& b, DualQuaternion& outQuat) {
+    // Every part of a and b is read before anything is written, so outQuat may alias either input.
+    const Quaternion real = a.real * b.real;
+    const Quaternion dualLeft = a.real * b.dual, dualRight = a.dual * b.real;
+#if defined(XO_SSE)
+    outQuat.dual.xmm = _mm_add_ps(dualLeft.xmm, dualRight.xmm);
+#else
+    outQuat.dual = Quaternion(dualLeft.x + dualRight.x, dualLeft.y + dualRight.y, dualLeft.z + dualRight.z, dualLeft.w + dualRight.w);
+#endif
+    outQuat.real = real;
 }
 
 XOMATH_END_XO_NS();
@@ -2567,14 +5278,12 @@ XOMATH_END_XO_NS();
 
 #if !defined(XO_EXPORT_ALL)
 #   undef _XOSIMDALIGN
+#   undef _XOSIMDALIGN32
 
 #   undef _XOCONSTEXPR
 #   undef _XOINL
 #   undef _XOTLS
 
-#   undef _XO_TLS_ENGINE
-#   undef _XO_TLS_DISTRIBUTION
-
 #   undef _XO_OVERLOAD_NEW_DELETE
 
 #   undef _XO_MIN
@@ -0,0 +1,1661 @@
+// Throughput benchmarks for xo-math. Build this in place of Main.cpp with the same sources and flags, for example:
+//   g++ -std=c++11 -O3 -msse4.2 -Iinclude src/*.cpp Bench.cpp -o build/bench
+// Build it once per simd configuration to compare them (the sublime project has a variant for each): -DXO_NO_SIMD for 
+// scalar, -msse2, -msse4.1 and -mavx. Pass --json <file> to also write every result out for comparing runs.
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <iostream>
+#include <fstream>
+#include <cstring>
+using std::cout;
+using std::endl;
+
+#include "include/xo-math.h" // the development version of xo-math
+
+#include "xo-bench.h"
+
+Bench bench;
+
+void BenchVectorOps() {
+    using xo::Vector2;
+    using xo::Vector3;
+    using xo::Vector4;
+    using xo::Vector3Stream;
+
+    const size_t count = 1 << 16;
+    std::vector<Vector2> a2(count), b2(count), out2(count);
+    std::vector<Vector3> a3(count), b3(count), out3(count);
+    std::vector<Vector4> a4(count), b4(count), out4(count);
+    std::vector<float> floats(count);
+    for (size_t i = 0; i < count; ++i) {
+        a2[i].Set(0.5f * i, 1.0f - i);
+        b2[i].Set(2.0f, 0.25f * i);
+        a3[i].Set((float)i, 1.0f - i, 0.5f * i);
+        b3[i].Set(0.25f * i, 3.0f, -1.0f - i);
+        a4[i].Set(a3[i], 1.0f);
+        b4[i].Set(b3[i], 0.5f);
+    }
+    Vector3Stream streamA(a3.data(), count), streamB(b3.data(), count), streamOut(count);
+
+    bench("Vector2 + Vector2", count, count * 3 * sizeof(Vector2), [&]{
+        for (size_t i = 0; i < count; ++i) {
+            out2[i] = a2[i] + b2[i];
+        }
+        ClobberMemory();
+    });
+    bench("Vector2::Dot", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            floats[i] = Vector2::Dot(a2[i], b2[i]);
+        }
+        ClobberMemory();
+    });
+    bench("Vector2::Normalized", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            out2[i] = a2[i].Normalized();
+        }
+        ClobberMemory();
+    });
+    bench("Vector3 + Vector3", count, count * 3 * sizeof(Vector3), [&]{
+        for (size_t i = 0; i < count; ++i) {
+            out3[i] = a3[i] + b3[i];
+        }
+        ClobberMemory();
+    });
+    bench("Vector3 * float", count, count * 2 * sizeof(Vector3), [&]{
+        for (size_t i = 0; i < count; ++i) {
+            out3[i] = a3[i] * 0.5f;
+        }
+        ClobberMemory();
+    });
+    double dot = bench("Vector3::Dot", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            floats[i] = Vector3::Dot(a3[i], b3[i]);
+        }
+        ClobberMemory();
+    });
+    double cross = bench("Vector3::Cross", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            out3[i] = Vector3::Cross(a3[i], b3[i]);
+        }
+        ClobberMemory();
+    });
+    double normalize = bench("Vector3::Normalized", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            out3[i] = a3[i].Normalized();
+        }
+        ClobberMemory();
+    });
+    bench("Vector3::Magnitude", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            floats[i] = a3[i].Magnitude();
+        }
+        ClobberMemory();
+    });
+    bench("Vector3::Lerp", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            Vector3::Lerp(a3[i], b3[i], 0.25f, out3[i]);
+        }
+        ClobberMemory();
+    });
+    bench("Vector4 + Vector4", count, count * 3 * sizeof(Vector4), [&]{
+        for (size_t i = 0; i < count; ++i) {
+            out4[i] = a4[i] + b4[i];
+        }
+        ClobberMemory();
+    });
+    bench("Vector4::Dot", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            floats[i] = Vector4::Dot(a4[i], b4[i]);
+        }
+        ClobberMemory();
+    });
+    bench("Vector4::Normalized", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            out4[i] = a4[i].Normalized();
+        }
+        ClobberMemory();
+    });
+    bench("Vector3Stream::Add", count, count * 9 * sizeof(float), [&]{
+        Vector3Stream::Add(streamA, streamB, streamOut);
+        ClobberMemory();
+    });
+    double streamDot = bench("Vector3Stream::Dot", count, count * 7 * sizeof(float), [&]{
+        Vector3Stream::Dot(streamA, streamB, floats.data());
+        ClobberMemory();
+    });
+    double streamCross = bench("Vector3Stream::Cross", count, count * 9 * sizeof(float), [&]{
+        Vector3Stream::Cross(streamA, streamB, streamOut);
+        ClobberMemory();
+    });
+    double streamNormalize = bench("Vector3Stream::Normalize", count, count * 6 * sizeof(float), [&]{
+        Vector3Stream::Normalize(streamA, streamOut);
+        ClobberMemory();
+    });
+
+    cout << "Vector3Stream speedup, Dot: " << dot / streamDot << "x, Cross: " << cross / streamCross 
+         << "x, Normalize: " << normalize / streamNormalize << "x" << endl << endl;
+}
+
+void BenchMatrix4x4Transform() {
+    using xo::Vector3;
+    using xo::Vector4;
+    using xo::Matrix4x4;
+
+    const size_t count = 1 << 16;
+    Matrix4x4 m;
+    Matrix4x4::RotationRadians(0.3f, -1.1f, 2.0f, m);
+    m(0, 3) = 4.0f;
+
+    std::vector<Vector3> vecs(count), out(count);
+    std::vector<float> packed(count * 3), packedOut(count * 3);
+    for (size_t i = 0; i < count; ++i) {
+        vecs[i].Set((float)i, 1.0f - i, 0.5f * i);
+        packed[i * 3] = vecs[i].x;
+        packed[i * 3 + 1] = vecs[i].y;
+        packed[i * 3 + 2] = vecs[i].z;
+    }
+
+    double transform = bench("Matrix4x4::Transform (per vector)", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = vecs[i];
+            m.Transform(out[i]);
+        }
+        ClobberMemory();
+    });
+    double directions = bench("Matrix4x4::TransformDirections", count, count * 2 * sizeof(Vector3), [&]{
+        m.TransformDirections(vecs.data(), out.data(), count);
+        ClobberMemory();
+    });
+    double packedDirections = bench("Matrix4x4::TransformDirections (packed)", count, packed.size() * 2 * sizeof(float), [&]{
+        m.TransformDirections(packed.data(), packedOut.data(), count);
+        ClobberMemory();
+    });
+    double perPoint = bench("Matrix4x4 * Vector4(v, 1) (per point)", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = m * Vector4(vecs[i], 1.0f);
+        }
+        ClobberMemory();
+    });
+    double points = bench("Matrix4x4::TransformPoints", count, count * 2 * sizeof(Vector3), [&]{
+        m.TransformPoints(vecs.data(), out.data(), count);
+        ClobberMemory();
+    });
+    double packedPoints = bench("Matrix4x4::TransformPoints (packed)", count, packed.size() * 2 * sizeof(float), [&]{
+        m.TransformPoints(packed.data(), packedOut.data(), count);
+        ClobberMemory();
+    });
+
+    cout << "TransformDirections speedup: " << transform / directions << "x, packed: " << transform / packedDirections << "x" << endl;
+    cout << "TransformPoints speedup: " << perPoint / points << "x, packed: " << perPoint / packedPoints << "x" << endl << endl;
+}
+
+// The transpose-and-sum product Matrix4x4::operator *= used before Matrix4x4::Multiply, kept as a baseline.
+xo::Matrix4x4 MultiplyBySums(const xo::Matrix4x4& a, const xo::Matrix4x4& b) {
+    xo::Matrix4x4 t = b.Transposed();
+    return xo::Matrix4x4(
+        (a[0] * t[0]).Sum(), (a[0] * t[1]).Sum(), (a[0] * t[2]).Sum(), (a[0] * t[3]).Sum(),
+        (a[1] * t[0]).Sum(), (a[1] * t[1]).Sum(), (a[1] * t[2]).Sum(), (a[1] * t[3]).Sum(),
+        (a[2] * t[0]).Sum(), (a[2] * t[1]).Sum(), (a[2] * t[2]).Sum(), (a[2] * t[3]).Sum(),
+        (a[3] * t[0]).Sum(), (a[3] * t[1]).Sum(), (a[3] * t[2]).Sum(), (a[3] * t[3]).Sum()
+    );
+}
+
+void BenchMatrix4x4Multiply() {
+    using xo::Matrix4x4;
+
+    const size_t count = 1 << 14;
+    std::vector<Matrix4x4> a(count), b(count), out(count);
+    for (size_t i = 0; i < count; ++i) {
+        Matrix4x4::RotationRadians(0.001f * i, 0.5f, -0.002f * i, a[i]);
+        Matrix4x4::AxisAngleRadians(xo::Vector3::Up, 0.003f * i, b[i]);
+    }
+    const Matrix4x4 parent = a[count / 2];
+
+    double sums = bench("Matrix4x4 transpose and sum multiply", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = MultiplyBySums(a[i], b[i]);
+        }
+        ClobberMemory();
+    });
+    double op = bench("Matrix4x4::operator *", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = a[i] * b[i];
+        }
+        ClobberMemory();
+    });
+    double array = bench("Matrix4x4::MultiplyArray", count, count * 3 * sizeof(Matrix4x4), [&]{
+        Matrix4x4::MultiplyArray(a.data(), b.data(), out.data(), count);
+        ClobberMemory();
+    });
+    double parentOp = bench("Matrix4x4::operator * (parent * child)", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = parent * b[i];
+        }
+        ClobberMemory();
+    });
+    double parentArray = bench("Matrix4x4::MultiplyArray (parent * children)", count, count * 2 * sizeof(Matrix4x4), [&]{
+        Matrix4x4::MultiplyArray(parent, b.data(), out.data(), count);
+        ClobberMemory();
+    });
+
+    cout << "operator * speedup over transpose and sum: " << sums / op << "x" << endl;
+    cout << "MultiplyArray speedup over transpose and sum: " << sums / array << "x" << endl;
+    cout << "MultiplyArray (parent * children) speedup over operator *: " << parentOp / parentArray << "x" << endl << endl;
+}
+
+void BenchMatrix4x4Inverse() {
+    using xo::Matrix4x4;
+
+    const size_t count = 1 << 14;
+    std::vector<Matrix4x4> rigid(count), projective(count), out(count);
+    for (size_t i = 0; i < count; ++i) {
+        Matrix4x4::RotationRadians(0.001f * i, 0.5f, -0.002f * i, rigid[i]);
+        rigid[i](0, 3) = (float)i;
+        rigid[i](1, 3) = 1.0f;
+        projective[i] = rigid[i];
+        projective[i](3, 2) = 0.5f;
+    }
+
+    double single = bench("Matrix4x4::MakeInverse", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = projective[i];
+            out[i].MakeInverse();
+        }
+        ClobberMemory();
+    });
+    double array = bench("Matrix4x4::InverseArray", count, count * 2 * sizeof(Matrix4x4), [&]{
+        Matrix4x4::InverseArray(projective.data(), out.data(), count);
+        ClobberMemory();
+    });
+    double tryArray = bench("Matrix4x4::TryInverseArray", count, [&]{
+        DoNotOptimize(Matrix4x4::TryInverseArray(projective.data(), out.data(), count));
+        ClobberMemory();
+    });
+    double affine = bench("Matrix4x4::InverseArray (affine)", count, [&]{
+        Matrix4x4::InverseArray(rigid.data(), out.data(), count);
+        ClobberMemory();
+    });
+    double rigidArray = bench("Matrix4x4::InverseRigidArray", count, [&]{
+        Matrix4x4::InverseRigidArray(rigid.data(), out.data(), count);
+        ClobberMemory();
+    });
+
+    cout << "InverseArray speedup over MakeInverse: " << single / array << "x, try: " << single / tryArray << "x" << endl;
+    cout << "InverseArray (affine) speedup: " << single / affine << "x, InverseRigidArray: " << single / rigidArray << "x" << endl << endl;
+}
+
+void BenchQuaternionBlend() {
+    using xo::Quaternion;
+
+    // 80 bones for each of 2000 characters.
+    const size_t count = 80 * 2000;
+    std::vector<Quaternion> a(count), b(count), out(count);
+    std::vector<float> t(count);
+    for (size_t i = 0; i < count; ++i) {
+        a[i] = Quaternion::RotationRadians(0.001f * i, 0.7f, -0.3f);
+        b[i] = Quaternion::RotationRadians(-0.2f, 0.002f * i, 1.1f);
+        t[i] = (i % 97) / 97.0f;
+    }
+
+    double slerp = bench("Quaternion::Slerp (per quaternion)", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            Quaternion::Slerp(a[i], b[i], t[i], out[i]);
+        }
+        ClobberMemory();
+    });
+    double slerpArray = bench("Quaternion::SlerpArray", count, count * (3 * sizeof(Quaternion) + sizeof(float)), [&]{
+        Quaternion::SlerpArray(a.data(), b.data(), t.data(), out.data(), count);
+        ClobberMemory();
+    });
+    double nlerp = bench("Quaternion::Nlerp (per quaternion)", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            Quaternion::Nlerp(a[i], b[i], t[i], out[i]);
+        }
+        ClobberMemory();
+    });
+    double nlerpArray = bench("Quaternion::NlerpArray", count, count * (3 * sizeof(Quaternion) + sizeof(float)), [&]{
+        Quaternion::NlerpArray(a.data(), b.data(), t.data(), out.data(), count);
+        ClobberMemory();
+    });
+
+    cout << "SlerpArray speedup: " << slerp / slerpArray << "x, NlerpArray speedup: " << nlerp / nlerpArray << "x" << endl << endl;
+}
+
+void BenchTrig() {
+    const size_t count = 1 << 16;
+    std::vector<float> f(count), s(count), c(count);
+    for (size_t i = 0; i < count; ++i) {
+        f[i] = (i % 4099) * 0.01f - 20.0f;
+    }
+
+    double libm = bench("sinf + cosf (per float)", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            s[i] = sinf(f[i]);
+            c[i] = cosf(f[i]);
+        }
+        ClobberMemory();
+    });
+    double scalar = bench("xo::SinCos (per float)", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            xo::SinCos(f[i], s[i], c[i]);
+        }
+        ClobberMemory();
+    });
+    double x4 = bench("xo::SinCos_x4", count, [&]{
+        for (size_t i = 0; i < count; i += 4) {
+            xo::SinCos_x4(f.data() + i, s.data() + i, c.data() + i);
+        }
+        ClobberMemory();
+    });
+    double array = bench("xo::SinCosArray", count, count * 3 * sizeof(float), [&]{
+        xo::SinCosArray(f.data(), s.data(), c.data(), count);
+        ClobberMemory();
+    });
+    double rotation = bench("Matrix4x4::RotationRadians", count / 4, [&]{
+        xo::Matrix4x4 m;
+        for (size_t i = 0; i < count; i += 4) {
+            xo::Matrix4x4::RotationRadians(f[i], f[i + 1], f[i + 2], m);
+            DoNotOptimize(m);
+        }
+    });
+
+    cout << "SinCos speedup: " << libm / scalar << "x, SinCos_x4 speedup: " << libm / x4 << "x, SinCosArray speedup: " << libm / array << "x" << endl;
+    cout << "RotationRadians: " << rotation << " ns" << endl << endl;
+}
+
+void BenchPrecision() {
+    using xo::Precision;
+    using xo::Vector3;
+    using xo::Quaternion;
+
+    const size_t count = 1 << 16;
+    std::vector<Vector3> vecs(count), out(count);
+    std::vector<Quaternion> quats(count), outQuats(count);
+    for (size_t i = 0; i < count; ++i) {
+        vecs[i].Set(1.0f + i % 13, 2.0f - i % 7, 0.5f * (i % 5) + 0.1f);
+        quats[i] = Quaternion(vecs[i].x, vecs[i].y, vecs[i].z, 1.0f);
+    }
+
+    double normalize = bench("Vector3::Normalize()", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = vecs[i].Normalized();
+        }
+        ClobberMemory();
+    });
+    double exact = bench("Vector3::Normalize<Exact>", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = vecs[i].Normalized<Precision::Exact>();
+        }
+        ClobberMemory();
+    });
+    double fast = bench("Vector3::Normalize<Fast>", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = vecs[i].Normalized<Precision::Fast>();
+        }
+        ClobberMemory();
+    });
+    double approximate = bench("Vector3::Normalize<Approximate>", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = vecs[i].Normalized<Precision::Approximate>();
+        }
+        ClobberMemory();
+    });
+    bench("Quaternion::Normalize()", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            outQuats[i] = quats[i].Normalized();
+        }
+        ClobberMemory();
+    });
+    bench("Quaternion::Normalize<Fast>", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            outQuats[i] = quats[i].Normalized<Precision::Fast>();
+        }
+        ClobberMemory();
+    });
+    bench("Vector3::Reciprocal<Exact>", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = vecs[i].Reciprocal();
+        }
+        ClobberMemory();
+    });
+    bench("Vector3::Reciprocal<Approximate>", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = vecs[i].Reciprocal<Precision::Approximate>();
+        }
+        ClobberMemory();
+    });
+
+    cout << "Normalize speedup over Normalize(), Exact: " << normalize / exact << "x, Fast: " << normalize / fast 
+         << "x, Approximate: " << normalize / approximate << "x" << endl << endl;
+}
+
+void BenchRandom() {
+    using xo::Vector3;
+
+    const size_t count = 1 << 16;
+    std::vector<float> floats(count);
+    std::vector<Vector3> vecs(count);
+
+    // how RandomRange used to work: a distribution built per call over a thread local mt19937.
+    double distribution = bench("thread_local std::mt19937 (per float)", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            static thread_local std::mt19937 engine(1234);
+            std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+            floats[i] = dist(engine);
+        }
+        ClobberMemory();
+    });
+    double range = bench("xo::RandomRange (per float)", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            floats[i] = xo::RandomRange(-1.0f, 1.0f);
+        }
+        ClobberMemory();
+    });
+    double array = bench("xo::RandomRangeArray", count, count * sizeof(float), [&]{
+        xo::RandomRangeArray(-1.0f, 1.0f, floats.data(), count);
+        ClobberMemory();
+    });
+    bench("Vector3::RandomOnCube", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            Vector3::RandomOnCube(1.0f, vecs[i]);
+        }
+        ClobberMemory();
+    });
+    bench("Vector3::RandomInConeRadians", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            Vector3::RandomInConeRadians(Vector3::Up, 0.5f, vecs[i]);
+        }
+        ClobberMemory();
+    });
+
+    cout << "RandomRange speedup: " << distribution / range << "x, RandomRangeArray speedup: " << distribution / array << "x" << endl << endl;
+}
+
+void BenchRandomArrays() {
+    using xo::Vector3;
+    using xo::Vector3Stream;
+
+    // one burst of a particle emitter.
+    const size_t count = 1 << 14;
+    std::vector<Vector3> vecs(count);
+    Vector3Stream stream(count);
+    const Vector3 forward = Vector3(0.2f, 1.0f, 0.1f).Normalized();
+
+    double cone = bench("Vector3::RandomInConeRadians (per vector)", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            Vector3::RandomInConeRadians(forward, 0.5f, vecs[i]);
+        }
+        ClobberMemory();
+    });
+    double coneArray = bench("Vector3::RandomInConeRadiansArray", count, [&]{
+        Vector3::RandomInConeRadiansArray(forward, 0.5f, vecs.data(), count);
+        ClobberMemory();
+    });
+    double coneStream = bench("Vector3::RandomInConeRadiansArray (stream)", count, [&]{
+        Vector3::RandomInConeRadiansArray(forward, 0.5f, stream.X(), stream.Y(), stream.Z(), count);
+        ClobberMemory();
+    });
+    double sphere = bench("Vector3::RandomOnSphere (per vector)", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            Vector3::RandomOnSphere(1.0f, vecs[i]);
+        }
+        ClobberMemory();
+    });
+    double sphereArray = bench("Vector3::RandomOnSphereArray", count, [&]{
+        Vector3::RandomOnSphereArray(1.0f, vecs.data(), count);
+        ClobberMemory();
+    });
+    double circle = bench("Vector3::RandomInCircle (per vector)", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            Vector3::RandomInCircle(Vector3::Up, 1.0f, vecs[i]);
+        }
+        ClobberMemory();
+    });
+    double circleArray = bench("Vector3::RandomInCircleArray", count, [&]{
+        Vector3::RandomInCircleArray(Vector3::Up, 1.0f, vecs.data(), count);
+        ClobberMemory();
+    });
+    double cube = bench("Vector3::RandomOnCube (per vector)", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            Vector3::RandomOnCube(1.0f, vecs[i]);
+        }
+        ClobberMemory();
+    });
+    double cubeArray = bench("Vector3::RandomOnCubeArray", count, [&]{
+        Vector3::RandomOnCubeArray(1.0f, vecs.data(), count);
+        ClobberMemory();
+    });
+
+    cout << "Array speedups, cone: " << cone / coneArray << "x (stream " << cone / coneStream << "x), sphere: " << sphere / sphereArray 
+         << "x, circle: " << circle / circleArray << "x, cube: " << cube / cubeArray << "x" << endl << endl;
+}
+
+void BenchAABB() {
+    using xo::Vector3;
+    using xo::Vector4;
+    using xo::Matrix4x4;
+    using xo::AABB;
+
+    // the per frame bounds update of a scene.
+    const size_t count = 200000;
+    std::vector<AABB> boxes(count), out(count);
+    for (size_t i = 0; i < count; ++i) {
+        Vector3 center((float)(i % 577), (float)(i % 331), (float)(i % 97));
+        boxes[i] = AABB::FromCenterExtents(center, Vector3(0.5f + (i % 7), 1.0f, 0.25f * (i % 5) + 0.1f));
+    }
+    Matrix4x4 m;
+    Matrix4x4::RotationRadians(0.3f, -1.1f, 2.0f, m);
+    m(0, 3) = 4.0f;
+
+    double corners = bench("AABB 8 corner transform (per box)", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            AABB box = AABB::Empty;
+            for (int c = 0; c < 8; ++c) {
+                Vector3 corner((c & 1) ? boxes[i].max.x : boxes[i].min.x, (c & 2) ? boxes[i].max.y : boxes[i].min.y, (c & 4) ? boxes[i].max.z : boxes[i].min.z);
+                box.Expand(Vector3(m * Vector4(corner, 1.0f)));
+            }
+            out[i] = box;
+        }
+        ClobberMemory();
+    });
+    double transform = bench("AABB::Transform (per box)", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            AABB::Transform(boxes[i], m, out[i]);
+        }
+        ClobberMemory();
+    });
+    double array = bench("AABB::TransformArray", count, count * 2 * sizeof(AABB), [&]{
+        AABB::TransformArray(m, boxes.data(), out.data(), count);
+        ClobberMemory();
+    });
+    bench("AABB::Union", count, [&]{
+        AABB total = AABB::Empty;
+        for (size_t i = 0; i < count; ++i) {
+            total.Expand(boxes[i]);
+        }
+        DoNotOptimize(total);
+    });
+    bench("AABB::Overlaps", count, [&]{
+        const AABB query(Vector3(100.0f, 100.0f, 10.0f), Vector3(300.0f, 200.0f, 50.0f));
+        size_t hits = 0;
+        for (size_t i = 0; i < count; ++i) {
+            hits += query.Overlaps(boxes[i]) ? 1 : 0;
+        }
+        DoNotOptimize(hits);
+    });
+
+    cout << "TransformArray speedup over 8 corners: " << corners / array << "x, over Transform: " << transform / array << "x" << endl << endl;
+}
+
+void BenchFrustum() {
+    using xo::Vector3;
+    using xo::Vector4;
+    using xo::Matrix4x4;
+    using xo::AABB;
+    using xo::Frustum;
+
+    // one view's worth of instances, roughly a third of them visible.
+    const size_t count = 500000;
+    const float n = 0.5f, f = 1000.0f;
+    const Frustum frustum(Matrix4x4(
+        1.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, f / (f - n), -n * f / (f - n),
+        0.0f, 0.0f, 1.0f, 0.0f));
+    xo::RandomGenerator rng(99);
+    std::vector<Vector4> spheres(count);
+    std::vector<AABB> boxes(count);
+    for (size_t i = 0; i < count; ++i) {
+        Vector3 center(rng.Range(-1000.0f, 1000.0f), rng.Range(-1000.0f, 1000.0f), rng.Range(-200.0f, 1200.0f));
+        float radius = rng.Range(0.5f, 5.0f);
+        spheres[i].Set(center.x, center.y, center.z, radius);
+        boxes[i] = AABB::FromCenterExtents(center, Vector3(radius));
+    }
+    std::vector<uint32_t> bits((count + 31) / 32), indices(count);
+    std::vector<char> visible(count);
+
+    double sphereLoop = bench("Frustum::IntersectsSphere (per sphere)", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            visible[i] = frustum.IntersectsSphere(Vector3(spheres[i]), spheres[i].w);
+        }
+        ClobberMemory();
+    });
+    double sphereBits = bench("Frustum::CullSpheres", count, count * sizeof(Vector4), [&]{
+        DoNotOptimize(frustum.CullSpheres(spheres.data(), count, bits.data()));
+        ClobberMemory();
+    });
+    double sphereIndices = bench("Frustum::CullSpheresIndices", count, count * sizeof(Vector4), [&]{
+        DoNotOptimize(frustum.CullSpheresIndices(spheres.data(), count, indices.data()));
+        ClobberMemory();
+    });
+    double boxLoop = bench("Frustum::IntersectsAABB (per box)", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            visible[i] = frustum.IntersectsAABB(boxes[i]);
+        }
+        ClobberMemory();
+    });
+    double boxBits = bench("Frustum::CullAABBs", count, count * sizeof(AABB), [&]{
+        DoNotOptimize(frustum.CullAABBs(boxes.data(), count, bits.data()));
+        ClobberMemory();
+    });
+    double boxIndices = bench("Frustum::CullAABBsIndices", count, count * sizeof(AABB), [&]{
+        DoNotOptimize(frustum.CullAABBsIndices(boxes.data(), count, indices.data()));
+        ClobberMemory();
+    });
+
+    cout << "CullSpheres speedup: " << sphereLoop / sphereBits << "x (indices " << sphereLoop / sphereIndices 
+         << "x), CullAABBs speedup: " << boxLoop / boxBits << "x (indices " << boxLoop / boxIndices << "x)" << endl << endl;
+}
+
+void BenchRay() {
+    using xo::Vector3;
+    using xo::AABB;
+    using xo::Ray;
+    using xo::RayPacket8;
+
+    // a narrow phase mesh of small scattered triangles, hit by a handful of the rays.
+    const size_t triangleCount = 4096;
+    xo::RandomGenerator rng(7);
+    std::vector<Vector3> vertices(triangleCount * 3);
+    for (size_t i = 0; i < triangleCount; ++i) {
+        Vector3 center(rng.Range(-50.0f, 50.0f), rng.Range(-50.0f, 50.0f), rng.Range(-50.0f, 50.0f));
+        for (int j = 0; j < 3; ++j) {
+            vertices[i * 3 + j] = center + Vector3(rng.Range(-2.0f, 2.0f), rng.Range(-2.0f, 2.0f), rng.Range(-2.0f, 2.0f));
+        }
+    }
+    const size_t rayCount = 64;
+    std::vector<Ray> rays(rayCount);
+    for (size_t i = 0; i < rayCount; ++i) {
+        rays[i].Set(Vector3(rng.Range(-10.0f, 10.0f), rng.Range(-10.0f, 10.0f), -100.0f), Vector3(rng.Range(-0.2f, 0.2f), rng.Range(-0.2f, 0.2f), 1.0f));
+    }
+    const float infinity = std::numeric_limits<float>::infinity();
+    const size_t pairs = rayCount * triangleCount;
+
+    double triangleLoop = bench("Ray::IntersectTriangle (per triangle)", pairs, [&]{
+        for (const Ray& ray : rays) {
+            float t = infinity, u, v;
+            size_t index = 0;
+            for (size_t i = 0; i < triangleCount; ++i) {
+                if (ray.IntersectTriangle(vertices[i * 3], vertices[i * 3 + 1], vertices[i * 3 + 2], t, u, v)) {
+                    index = i;
+                }
+            }
+            DoNotOptimize(index);
+        }
+    });
+    double triangleBatch = bench("Ray::IntersectTriangles", pairs, pairs * 3 * sizeof(Vector3), [&]{
+        for (const Ray& ray : rays) {
+            float t = infinity, u, v;
+            size_t index = 0;
+            DoNotOptimize(ray.IntersectTriangles(vertices.data(), triangleCount, t, u, v, index));
+            DoNotOptimize(index);
+        }
+    });
+
+    // coherent packets of 8 against every triangle, and against a grid of boxes and spheres.
+    std::vector<RayPacket8> packets(rayCount / 8);
+    for (size_t i = 0; i < packets.size(); ++i) {
+        packets[i].Set(&rays[i * 8]);
+    }
+    std::vector<AABB> boxes(triangleCount);
+    for (size_t i = 0; i < triangleCount; ++i) {
+        boxes[i] = AABB::FromPoints(&vertices[i * 3], 3);
+    }
+    double packetTriangles = bench("RayPacket8::IntersectTriangle", pairs, [&]{
+        for (const RayPacket8& packet : packets) {
+            float t[8] = { infinity, infinity, infinity, infinity, infinity, infinity, infinity, infinity }, u[8], v[8];
+            for (size_t i = 0; i < triangleCount; ++i) {
+                DoNotOptimize(packet.IntersectTriangle(vertices[i * 3], vertices[i * 3 + 1], vertices[i * 3 + 2], t, u, v));
+            }
+            DoNotOptimize(t[0]);
+        }
+    });
+    double boxLoop = bench("Ray::IntersectAABB (per ray)", pairs, [&]{
+        for (const Ray& ray : rays) {
+            float t = infinity;
+            for (size_t i = 0; i < triangleCount; ++i) {
+                DoNotOptimize(ray.IntersectAABB(boxes[i], t));
+            }
+        }
+    });
+    double packetBoxes = bench("RayPacket8::IntersectAABB", pairs, [&]{
+        for (const RayPacket8& packet : packets) {
+            float t[8] = { infinity, infinity, infinity, infinity, infinity, infinity, infinity, infinity };
+            for (size_t i = 0; i < triangleCount; ++i) {
+                DoNotOptimize(packet.IntersectAABB(boxes[i], t));
+            }
+        }
+    });
+    double sphereLoop = bench("Ray::IntersectSphere (per ray)", pairs, [&]{
+        for (const Ray& ray : rays) {
+            float t = infinity;
+            for (size_t i = 0; i < triangleCount; ++i) {
+                DoNotOptimize(ray.IntersectSphere(vertices[i * 3], 2.0f, t));
+            }
+        }
+    });
+    double packetSpheres = bench("RayPacket8::IntersectSphere", pairs, [&]{
+        for (const RayPacket8& packet : packets) {
+            float t[8] = { infinity, infinity, infinity, infinity, infinity, infinity, infinity, infinity };
+            for (size_t i = 0; i < triangleCount; ++i) {
+                DoNotOptimize(packet.IntersectSphere(vertices[i * 3], 2.0f, t));
+            }
+        }
+    });
+
+    cout << "IntersectTriangles speedup: " << triangleLoop / triangleBatch << "x, RayPacket8 speedup: triangles " 
+         << triangleLoop / packetTriangles << "x, boxes " << boxLoop / packetBoxes << "x, spheres " << sphereLoop / packetSpheres << "x" << endl << endl;
+}
+
+void BenchBVH() {
+    using xo::Vector3;
+    using xo::Matrix4x4;
+    using xo::AABB;
+    using xo::Ray;
+    using xo::Frustum;
+    using xo::BVH;
+
+    // A synthetic scene: a million points scattered through a volume, and a quarter million small triangles.
+    const size_t pointCount = 1000000, triangleCount = 250000;
+    xo::RandomGenerator rng(17);
+    std::vector<AABB> points(pointCount);
+    for (size_t i = 0; i < pointCount; ++i) {
+        const Vector3 p(rng.Range(-500.0f, 500.0f), rng.Range(-500.0f, 500.0f), rng.Range(-500.0f, 500.0f));
+        points[i].Set(p, p);
+    }
+    std::vector<Vector3> vertices(triangleCount * 3);
+    for (size_t i = 0; i < triangleCount; ++i) {
+        const Vector3 center(rng.Range(-500.0f, 500.0f), rng.Range(-500.0f, 500.0f), rng.Range(-500.0f, 500.0f));
+        for (int j = 0; j < 3; ++j) {
+            vertices[i * 3 + j] = center + Vector3(rng.Range(-4.0f, 4.0f), rng.Range(-4.0f, 4.0f), rng.Range(-4.0f, 4.0f));
+        }
+    }
+
+    BVH bvh, triangles;
+    const unsigned threads = std::thread::hardware_concurrency();
+    double pointsSerial = bench("BVH::Build (1M points, 1 thread)", pointCount, pointCount * sizeof(AABB), [&]{
+        bvh.Build(points.data(), pointCount, 4, 1);
+    });
+    double pointsThreaded = bench("BVH::Build (1M points, all threads)", pointCount, pointCount * sizeof(AABB), [&]{
+        bvh.Build(points.data(), pointCount, 4, threads);
+    });
+    double trianglesSerial = bench("BVH::BuildTriangles (250K, 1 thread)", triangleCount, [&]{
+        triangles.BuildTriangles(vertices.data(), triangleCount, 4, 1);
+    });
+    double trianglesThreaded = bench("BVH::BuildTriangles (250K, all threads)", triangleCount, [&]{
+        triangles.BuildTriangles(vertices.data(), triangleCount, 4, threads);
+    });
+    bench("BVH::RefitTriangles (250K)", triangleCount, [&]{
+        triangles.RefitTriangles(vertices.data());
+    });
+
+    const size_t rayCount = 4096;
+    std::vector<Ray> rays(rayCount);
+    for (size_t i = 0; i < rayCount; ++i) {
+        const Vector3 origin(rng.Range(-600.0f, 600.0f), rng.Range(-600.0f, 600.0f), -600.0f);
+        rays[i].Set(origin, Vector3(rng.Range(-100.0f, 100.0f), rng.Range(-100.0f, 100.0f), 0.0f) - origin);
+    }
+    const float infinity = std::numeric_limits<float>::infinity();
+    double triangleTree = bench("BVH::IntersectTriangles (per ray, 250K triangles)", rayCount, [&]{
+        for (const Ray& ray : rays) {
+            float t = infinity, u, v;
+            uint32_t index;
+            DoNotOptimize(triangles.IntersectTriangles(ray, vertices.data(), t, u, v, index));
+        }
+    });
+    double triangleBrute = bench("Ray::IntersectTriangles (per ray, 250K triangles)", 16, [&]{
+        for (size_t r = 0; r < 16; ++r) {
+            float t = infinity, u, v;
+            size_t index;
+            DoNotOptimize(rays[r].IntersectTriangles(vertices.data(), triangleCount, t, u, v, index));
+        }
+    });
+
+    std::vector<uint32_t> found(pointCount);
+    const size_t queryCount = 1024;
+    std::vector<AABB> queries(queryCount);
+    for (size_t i = 0; i < queryCount; ++i) {
+        queries[i] = AABB::FromCenterExtents(Vector3(rng.Range(-500.0f, 500.0f), rng.Range(-500.0f, 500.0f), rng.Range(-500.0f, 500.0f)), Vector3(10.0f));
+    }
+    bench("BVH::QueryAABB (per query, 1M points)", queryCount, [&]{
+        for (const AABB& query : queries) {
+            DoNotOptimize(bvh.QueryAABB(query, found.data()));
+        }
+    });
+    const float n = 1.0f, f = 400.0f;
+    const Frustum frustum(Matrix4x4(
+        1.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, f / (f - n), -n * f / (f - n),
+        0.0f, 0.0f, 1.0f, 0.0f));
+    std::vector<uint32_t> visibleBits((pointCount + 31) / 32);
+    std::vector<xo::Vector4> spheres(pointCount);
+    for (size_t i = 0; i < pointCount; ++i) {
+        spheres[i].Set(points[i].min.x, points[i].min.y, points[i].min.z, 0.0f);
+    }
+    double frustumTree = bench("BVH::QueryFrustum (1M points)", pointCount, [&]{
+        DoNotOptimize(bvh.QueryFrustum(frustum, found.data()));
+    });
+    double frustumFlat = bench("Frustum::CullSpheres (1M points)", pointCount, pointCount * sizeof(xo::Vector4), [&]{
+        DoNotOptimize(frustum.CullSpheres(spheres.data(), pointCount, visibleBits.data()));
+    });
+
+    cout << "Build speedup on " << threads << " threads: points " << pointsSerial / pointsThreaded << "x, triangles " 
+         << trianglesSerial / trianglesThreaded << "x. Speedup over testing everything: rays " << triangleBrute / triangleTree 
+         << "x, frustum " << frustumFlat / frustumTree << "x" << endl << endl;
+}
+
+void BenchPlane() {
+    using xo::Vector3;
+    using xo::Vector4;
+    using xo::Plane;
+    using xo::PlaneSide;
+
+    const size_t count = 100000;
+    xo::RandomGenerator rng(29);
+    std::vector<Vector3> points(count);
+    for (size_t i = 0; i < count; ++i) {
+        points[i].Set(rng.Range(-100.0f, 100.0f), rng.Range(-100.0f, 100.0f), rng.Range(-100.0f, 100.0f));
+    }
+    const xo::Vector3Stream stream(points.data(), count);
+    const Plane plane = Plane::FromPointNormal(Vector3(1.0f, 2.0f, 3.0f), Vector3(1.0f, -2.0f, 0.5f).Normalized());
+    const Vector4 planeVector = plane.ToVector4();
+    std::vector<float> distances(count);
+    std::vector<PlaneSide> sides(count);
+
+    double dot = bench("Vector4::Dot per point (100K)", count, count * sizeof(Vector3), [&]{
+        for (size_t i = 0; i < count; ++i) {
+            distances[i] = Vector4(points[i], 1.0f).Dot(planeVector);
+        }
+        ClobberMemory();
+    });
+    double array = bench("Plane::SignedDistances (100K)", count, count * sizeof(Vector3), [&]{
+        plane.SignedDistances(points.data(), count, distances.data());
+        ClobberMemory();
+    });
+    double streamed = bench("Plane::SignedDistances, stream (100K)", count, count * sizeof(float) * 3, [&]{
+        plane.SignedDistances(stream, distances.data());
+        ClobberMemory();
+    });
+    double classify = bench("Plane::ClassifyPoints (100K)", count, count * sizeof(Vector3), [&]{
+        DoNotOptimize(plane.ClassifyPoints(points.data(), count, sides.data(), 0.01f));
+        ClobberMemory();
+    });
+    bench("Plane::ClassifyPoints, stream (100K)", count, count * sizeof(float) * 3, [&]{
+        DoNotOptimize(plane.ClassifyPoints(stream, sides.data(), 0.01f));
+        ClobberMemory();
+    });
+
+    cout << "Speedup over Vector4::Dot: array " << dot / array << "x, stream " << dot / streamed << "x, classify " << dot / classify 
+         << "x" << endl << endl;
+}
+
+void BenchBoundingSphere() {
+    using xo::Vector3;
+    using xo::BoundingSphere;
+
+    // A stretched box of points, which Ritter's method fits poorly. Each size uses the start of the same cloud.
+    const size_t sizes[] = { 10000, 100000, 1000000, 10000000 };
+    const char* names[] = { "10K", "100K", "1M", "10M" };
+    const size_t maxCount = 10000000;
+    xo::RandomGenerator rng(23);
+    std::vector<Vector3> points(maxCount);
+    for (size_t i = 0; i < maxCount; ++i) {
+        points[i].Set(rng.Range(-300.0f, 300.0f), rng.Range(-100.0f, 100.0f), rng.Range(-50.0f, 50.0f));
+    }
+
+    const unsigned threads = std::thread::hardware_concurrency();
+    for (int s = 0; s < 4; ++s) {
+        const size_t count = sizes[s];
+        const std::string size = std::string(" (") + names[s] + ")";
+        BoundingSphere ritter, epos, threaded;
+        bench(("BoundingSphere::FromPointsRitter" + size).c_str(), count, count * sizeof(Vector3), [&]{
+            ritter = BoundingSphere::FromPointsRitter(points.data(), count, 1);
+        });
+        bench(("BoundingSphere::FromPoints" + size).c_str(), count, count * sizeof(Vector3), [&]{
+            epos = BoundingSphere::FromPoints(points.data(), count, 1);
+        });
+        if (count >= 1000000) {
+            bench(("BoundingSphere::FromPoints, all threads" + size).c_str(), count, count * sizeof(Vector3), [&]{
+                threaded = BoundingSphere::FromPoints(points.data(), count, threads);
+            });
+        }
+        // the reference is only run once, it's far slower than the fits.
+        const BoundingSphere exact = BoundingSphere::FromPointsExact(points.data(), count);
+        cout << "Radius over the smallest sphere" << size << ": Ritter " << ritter.radius / exact.radius << ", EPOS " 
+             << epos.radius / exact.radius;
+        if (count >= 1000000) {
+            cout << ", EPOS on " << threads << " threads " << threaded.radius / exact.radius;
+        }
+        cout << endl;
+    }
+    cout << endl;
+}
+
+void BenchClosestPoints() {
+    using xo::Vector3;
+    using xo::Vector3Stream;
+    using xo::Segment;
+    using xo::Triangle;
+    using xo::AABB;
+    using xo::OBB;
+
+    const size_t count = 100000;
+    xo::RandomGenerator rng(31);
+    auto random = [&rng]{ return Vector3(rng.Range(-10.0f, 10.0f), rng.Range(-10.0f, 10.0f), rng.Range(-10.0f, 10.0f)); };
+    std::vector<Vector3> points(count), a(count), b(count), c(count), d(count), closest(count), closest2(count);
+    for (size_t i = 0; i < count; ++i) {
+        points[i] = random();
+        a[i] = random();
+        b[i] = random();
+        c[i] = random();
+        d[i] = random();
+    }
+    const Vector3Stream pointStream(points.data(), count), aStream(a.data(), count), bStream(b.data(), count);
+    const Vector3Stream cStream(c.data(), count), dStream(d.data(), count);
+    Vector3Stream outStream(count), outStream2(count);
+    std::vector<float> distances(count);
+
+    double scalar = bench("Segment::ClosestPoint per point (100K)", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            closest[i] = Segment(a[i], b[i]).ClosestPoint(points[i]);
+        }
+        ClobberMemory();
+    });
+    double streamed = bench("Segment::ClosestPoints, point stream (100K)", count, [&]{
+        Segment::ClosestPoints(pointStream, aStream, bStream, outStream, distances.data());
+        ClobberMemory();
+    });
+    cout << "Speedup: " << scalar / streamed << "x" << endl;
+
+    scalar = bench("Segment::ClosestPoints per pair (100K)", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            distances[i] = Segment(a[i], b[i]).ClosestPoints(Segment(c[i], d[i]), closest[i], closest2[i]);
+        }
+        ClobberMemory();
+    });
+    streamed = bench("Segment::ClosestPoints, pair stream (100K)", count, [&]{
+        Segment::ClosestPoints(aStream, bStream, cStream, dStream, outStream, outStream2, distances.data());
+        ClobberMemory();
+    });
+    cout << "Speedup: " << scalar / streamed << "x" << endl;
+
+    scalar = bench("Triangle::ClosestPoint per point (100K)", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            closest[i] = Triangle(a[i], b[i], c[i]).ClosestPoint(points[i]);
+        }
+        ClobberMemory();
+    });
+    streamed = bench("Triangle::ClosestPoints, stream (100K)", count, [&]{
+        Triangle::ClosestPoints(pointStream, aStream, bStream, cStream, outStream, distances.data());
+        ClobberMemory();
+    });
+    cout << "Speedup: " << scalar / streamed << "x" << endl;
+
+    const AABB box(Vector3(-3.0f, -2.0f, -1.0f), Vector3(3.0f, 2.0f, 1.0f));
+    scalar = bench("AABB::ClosestPoint per point (100K)", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            closest[i] = box.ClosestPoint(points[i]);
+        }
+        ClobberMemory();
+    });
+    streamed = bench("AABB::ClosestPoints, stream (100K)", count, [&]{
+        box.ClosestPoints(pointStream, outStream, distances.data());
+        ClobberMemory();
+    });
+    cout << "Speedup: " << scalar / streamed << "x" << endl;
+
+    const Vector3 axisX = Vector3(1.0f, 1.0f, 0.0f).Normalized(), axisY = Vector3(-1.0f, 1.0f, 1.0f).Normalized();
+    const OBB obb(Vector3(1.0f, -2.0f, 0.5f), axisX, axisY, axisX.Cross(axisY), Vector3(3.0f, 2.0f, 1.0f));
+    scalar = bench("OBB::ClosestPoint per point (100K)", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            closest[i] = obb.ClosestPoint(points[i]);
+        }
+        ClobberMemory();
+    });
+    streamed = bench("OBB::ClosestPoints, stream (100K)", count, [&]{
+        obb.ClosestPoints(pointStream, outStream, distances.data());
+        ClobberMemory();
+    });
+    cout << "Speedup: " << scalar / streamed << "x" << endl << endl;
+}
+
+void BenchSpatialHashGrid() {
+    using xo::Vector3;
+    using xo::SpatialHashGrid;
+
+    // About 27 neighbors within the radius of each point.
+    const size_t count = 100000;
+    const float radius = 2.0f;
+    xo::RandomGenerator rng(37);
+    std::vector<Vector3> points(count);
+    for (size_t i = 0; i < count; ++i) {
+        points[i].Set(rng.Range(-25.0f, 25.0f), rng.Range(-25.0f, 25.0f), rng.Range(-25.0f, 25.0f));
+    }
+    std::vector<uint32_t> found(count);
+    SpatialHashGrid grid;
+
+    double build = bench("SpatialHashGrid::Build per point (100K)", count, count * sizeof(Vector3), [&]{
+        grid.Build(points.data(), count, radius, 1);
+    });
+    const unsigned threads = std::thread::hardware_concurrency();
+    double threadedBuild = bench("SpatialHashGrid::Build per point, all threads (100K)", count, count * sizeof(Vector3), [&]{
+        grid.Build(points.data(), count, radius, threads);
+    });
+    cout << "Speedup on " << threads << " threads: " << build / threadedBuild << "x" << endl;
+
+    // Brute force is too slow to query from every point.
+    const size_t bruteCount = 1000;
+    double brute = bench("Brute force radius query (1K of 100K)", bruteCount, [&]{
+        const float radiusSquared = radius * radius;
+        for (size_t q = 0; q < bruteCount; ++q) {
+            const Vector3& center = points[q];
+            size_t n = 0;
+            for (size_t i = 0; i < count; ++i) {
+                if (Vector3::DistanceSquared(points[i], center) <= radiusSquared) {
+                    found[n++] = (uint32_t)i;
+                }
+            }
+            DoNotOptimize(n);
+        }
+        ClobberMemory();
+    });
+    size_t neighbors = 0;
+    double query = bench("SpatialHashGrid::QueryRadius (100K of 100K)", count, [&]{
+        neighbors = 0;
+        for (size_t q = 0; q < count; ++q) {
+            neighbors += grid.QueryRadius(points[q], radius, found.data());
+        }
+        ClobberMemory();
+    });
+    cout << "Neighbors per query: " << (double)neighbors / count << ", speedup over brute force: " << brute / query << "x, "
+         << "one frame of building and querying from every point: " << (threadedBuild + query) * count / 1e6 << " ms" << endl << endl;
+}
+
+void BenchGJK() {
+    using xo::Vector3;
+    using xo::OBB;
+    using xo::Segment;
+    using xo::GJK;
+    using xo::EPA;
+
+    // Pairs of boxes, capsules and hulls a little apart or a little overlapping, each frame moved a little further 
+    // along a circle, as a physics engine would see them.
+    const int count = 1000;
+    xo::RandomGenerator rng(41);
+    auto random = [&rng](float range) { return Vector3(rng.Range(-range, range), rng.Range(-range, range), rng.Range(-range, range)); };
+    std::vector<OBB> boxes(count * 2);
+    std::vector<Segment> segments(count * 2);
+    std::vector<Vector3> offsets(count);
+    for (int i = 0; i < count * 2; ++i) {
+        const Vector3 axisX = random(1.0f).Normalized(), axisY = axisX.Cross(random(1.0f)).Normalized();
+        boxes[i].Set(random(0.8f), axisX, axisY, axisX.Cross(axisY), Vector3(rng.Range(0.2f, 1.0f), rng.Range(0.2f, 1.0f), rng.Range(0.2f, 1.0f)));
+        segments[i].Set(random(1.5f), random(1.5f));
+    }
+    for (int i = 0; i < count; ++i) {
+        offsets[i] = random(1.0f);
+    }
+    // a rounded box of 8 corners and 56 points inside: a 64 point hull.
+    std::vector<Vector3> hullPoints;
+    for (int i = 0; i < 64; ++i) {
+        hullPoints.push_back(i < 8 ? Vector3(i & 1 ? 1.0f : -1.0f, i & 2 ? 0.5f : -0.5f, i & 4 ? 0.7f : -0.7f) : random(0.5f));
+    }
+    const GJK::Hull hull(hullPoints.data(), hullPoints.size());
+    std::vector<GJK::Cache> caches(count);
+    int frame = 0;
+    auto moved = [&](int i) {
+        const float t = (frame + i) * 0.01f;
+        return offsets[i] + Vector3(xo::Cos(t), xo::Sin(t), 0.0f) * 0.5f;
+    };
+    Vector3 pointA, pointB, normal;
+    float depth;
+
+    double cold = bench("GJK::Distance, boxes (1K pairs)", count, [&]{
+        for (int i = 0; i < count; ++i) {
+            OBB b = boxes[i * 2 + 1];
+            b.center += moved(i);
+            DoNotOptimize(GJK::Distance(boxes[i * 2], b, pointA, pointB));
+        }
+        ++frame;
+    });
+    double warm = bench("GJK::Distance, boxes, warm started (1K pairs)", count, [&]{
+        for (int i = 0; i < count; ++i) {
+            OBB b = boxes[i * 2 + 1];
+            b.center += moved(i);
+            DoNotOptimize(GJK::Distance(boxes[i * 2], b, pointA, pointB, &caches[i]));
+        }
+        ++frame;
+    });
+    cout << "Warm start speedup: " << cold / warm << "x" << endl;
+    bench("GJK::Intersects, boxes, warm started (1K pairs)", count, [&]{
+        for (int i = 0; i < count; ++i) {
+            OBB b = boxes[i * 2 + 1];
+            b.center += moved(i);
+            DoNotOptimize(GJK::Intersects(boxes[i * 2], b, &caches[i]));
+        }
+        ++frame;
+    });
+    bench("GJK::Distance, capsules (1K pairs)", count, [&]{
+        for (int i = 0; i < count; ++i) {
+            const Vector3 offset = moved(i);
+            const Segment s(segments[i * 2 + 1].start + offset, segments[i * 2 + 1].end + offset);
+            DoNotOptimize(GJK::Distance(GJK::Rounded<Segment>(segments[i * 2], 0.3f), GJK::Rounded<Segment>(s, 0.2f), pointA, pointB));
+        }
+        ++frame;
+    });
+    bench("GJK::Distance, 64 point hull and box (1K pairs)", count, [&]{
+        for (int i = 0; i < count; ++i) {
+            OBB b = boxes[i * 2 + 1];
+            b.center += moved(i) * 2.0f;
+            DoNotOptimize(GJK::Distance(hull, b, pointA, pointB));
+        }
+        ++frame;
+    });
+    for (auto& cache : caches) {
+        cache = GJK::Cache();
+    }
+    bench("EPA::Penetration, boxes, warm started (1K pairs)", count, [&]{
+        for (int i = 0; i < count; ++i) {
+            OBB b = boxes[i * 2 + 1];
+            b.center += moved(i) * 0.3f;
+            DoNotOptimize(EPA::Penetration(boxes[i * 2], b, normal, depth, pointA, pointB, &caches[i]));
+        }
+        ++frame;
+    });
+    cout << endl;
+}
+
+void BenchMorton() {
+    using xo::Vector3;
+    using xo::Vector3Stream;
+    using xo::AABB;
+    using xo::Morton;
+
+    const size_t count = 1000000;
+    xo::RandomGenerator rng(43);
+    std::vector<Vector3> points(count);
+    for (size_t i = 0; i < count; ++i) {
+        points[i].Set(rng.Range(-50.0f, 50.0f), rng.Range(-50.0f, 50.0f), rng.Range(-50.0f, 50.0f));
+    }
+    const Vector3Stream stream(points.data(), count);
+    const AABB bounds(Vector3(-50.0f), Vector3(50.0f));
+    std::vector<uint32_t> codes(count), sortCodes(count), indices(count), scratch(count * 2);
+    std::vector<uint64_t> codes63(count), sortCodes63(count), scratch63(count);
+
+    double scalar = bench("Morton::Encode30 per point, one at a time (1M)", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            codes[i] = Morton::Encode30(points[i], bounds);
+        }
+        ClobberMemory();
+    });
+    double array = bench("Morton::Encode30 per point, array (1M)", count, count * sizeof(Vector3), [&]{
+        Morton::Encode30(points.data(), count, bounds, codes.data());
+        ClobberMemory();
+    });
+    cout << "Speedup: " << scalar / array << "x" << endl;
+    bench("Morton::Encode30 per point, stream (1M)", count, count * sizeof(float) * 3, [&]{
+        Morton::Encode30(stream, bounds, codes.data());
+        ClobberMemory();
+    });
+    scalar = bench("Morton::Encode63 per point, one at a time (1M)", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            codes63[i] = Morton::Encode63(points[i], bounds);
+        }
+        ClobberMemory();
+    });
+    array = bench("Morton::Encode63 per point, array (1M)", count, count * sizeof(Vector3), [&]{
+        Morton::Encode63(points.data(), count, bounds, codes63.data());
+        ClobberMemory();
+    });
+    cout << "Speedup: " << scalar / array << "x" << endl;
+
+    std::vector<std::pair<uint32_t, uint32_t>> pairs(count);
+    double stdSort = bench("std::sort of 30 bit code and index pairs per key (1M)", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            pairs[i] = std::make_pair(codes[i], (uint32_t)i);
+        }
+        std::sort(pairs.begin(), pairs.end());
+        ClobberMemory();
+    });
+    double radix = bench("Morton::Sort of 30 bit codes per key (1M)", count, [&]{
+        std::copy(codes.begin(), codes.end(), sortCodes.begin());
+        for (size_t i = 0; i < count; ++i) {
+            indices[i] = (uint32_t)i;
+        }
+        Morton::Sort(sortCodes.data(), indices.data(), count, 1, scratch.data(), scratch.data() + count);
+        ClobberMemory();
+    });
+    cout << "Speedup: " << stdSort / radix << "x" << endl;
+    const unsigned threads = std::thread::hardware_concurrency();
+    double threadedRadix = bench("Morton::Sort of 30 bit codes per key, all threads (1M)", count, [&]{
+        std::copy(codes.begin(), codes.end(), sortCodes.begin());
+        for (size_t i = 0; i < count; ++i) {
+            indices[i] = (uint32_t)i;
+        }
+        Morton::Sort(sortCodes.data(), indices.data(), count, threads, scratch.data(), scratch.data() + count);
+        ClobberMemory();
+    });
+    cout << "Speedup on " << threads << " threads: " << radix / threadedRadix << "x" << endl;
+    bench("Morton::Sort of 63 bit codes per key (1M)", count, [&]{
+        std::copy(codes63.begin(), codes63.end(), sortCodes63.begin());
+        for (size_t i = 0; i < count; ++i) {
+            indices[i] = (uint32_t)i;
+        }
+        Morton::Sort(sortCodes63.data(), indices.data(), count, 1, scratch63.data(), scratch.data());
+        ClobberMemory();
+    });
+    std::vector<Vector3> sorted(count);
+    bench("Morton::Order and Permute per point (1M)", count, [&]{
+        Morton::Order(points.data(), count, bounds, indices.data(), 1);
+        Morton::Permute(points.data(), indices.data(), count, sorted.data());
+        ClobberMemory();
+    });
+
+    // The payoff: radius queries from every tenth point, visiting the points in memory order. In Morton order each 
+    // query mostly touches cells the last one did.
+    xo::SpatialHashGrid grid;
+    std::vector<uint32_t> found(count);
+    auto queryAll = [&](const char* name, const std::vector<Vector3>& from) {
+        grid.Build(from.data(), count, 1.0f, 1);
+        return bench(name, count / 10, [&]{
+            size_t n = 0;
+            for (size_t i = 0; i < count; i += 10) {
+                n += grid.QueryRadius(from[i], 1.0f, found.data());
+            }
+            DoNotOptimize(n);
+        });
+    };
+    double randomOrder = queryAll("SpatialHashGrid::QueryRadius from every tenth point, random order (100K of 1M)", points);
+    double mortonOrder = queryAll("SpatialHashGrid::QueryRadius from every tenth point, Morton order (100K of 1M)", sorted);
+    cout << "Speedup: " << randomOrder / mortonOrder << "x" << endl;
+    cout << endl;
+}
+
+void BenchMatrix3x4() {
+    using xo::Vector3;
+    using xo::Matrix3x4;
+    using xo::Matrix4x4;
+
+    // The same affine matrices both ways.
+    const size_t count = 1 << 14;
+    std::vector<Matrix4x4> a4(count), b4(count), out4(count);
+    std::vector<Matrix3x4> a3(count), b3(count), out3(count);
+    for (size_t i = 0; i < count; ++i) {
+        a4[i] = ~Matrix4x4::RotationRadians(0.001f * i, 0.5f, -0.002f * i) * Matrix4x4::Scale(1.0f + 0.0001f * i);
+        b4[i] = ~Matrix4x4::AxisAngleRadians(Vector3::Up, 0.003f * i);
+        a4[i](0, 3) = (float)i;
+        b4[i](1, 3) = 1.0f;
+        a3[i] = Matrix3x4(a4[i]);
+        b3[i] = Matrix3x4(b4[i]);
+    }
+
+    double multiply4 = bench("Matrix4x4::MultiplyArray (affine)", count, count * 3 * sizeof(Matrix4x4), [&]{
+        Matrix4x4::MultiplyArray(a4.data(), b4.data(), out4.data(), count);
+        ClobberMemory();
+    });
+    double multiply3 = bench("Matrix3x4::MultiplyArray", count, count * 3 * sizeof(Matrix3x4), [&]{
+        Matrix3x4::MultiplyArray(a3.data(), b3.data(), out3.data(), count);
+        ClobberMemory();
+    });
+    double parent4 = bench("Matrix4x4::MultiplyArray (affine parent * children)", count, count * 2 * sizeof(Matrix4x4), [&]{
+        Matrix4x4::MultiplyArray(a4[0], b4.data(), out4.data(), count);
+        ClobberMemory();
+    });
+    double parent3 = bench("Matrix3x4::MultiplyArray (parent * children)", count, count * 2 * sizeof(Matrix3x4), [&]{
+        Matrix3x4::MultiplyArray(a3[0], b3.data(), out3.data(), count);
+        ClobberMemory();
+    });
+    double inverse4 = bench("Matrix4x4::InverseArray (affine)", count, count * 2 * sizeof(Matrix4x4), [&]{
+        Matrix4x4::InverseArray(a4.data(), out4.data(), count);
+        ClobberMemory();
+    });
+    double inverse3 = bench("Matrix3x4::InverseArray", count, count * 2 * sizeof(Matrix3x4), [&]{
+        Matrix3x4::InverseArray(a3.data(), out3.data(), count);
+        ClobberMemory();
+    });
+
+    std::vector<Vector3> points(count), outPoints(count);
+    for (size_t i = 0; i < count; ++i) {
+        points[i].Set(0.1f * i, 1.0f, -0.2f * i);
+    }
+    double transform4 = bench("Matrix4x4::TransformPoints", count, [&]{
+        a4[1].TransformPoints(points.data(), outPoints.data(), count);
+        ClobberMemory();
+    });
+    double transform3 = bench("Matrix3x4::TransformPoints", count, [&]{
+        a3[1].TransformPoints(points.data(), outPoints.data(), count);
+        ClobberMemory();
+    });
+
+    cout << "Matrix3x4 speedup over Matrix4x4, MultiplyArray: " << multiply4 / multiply3 << "x, parent * children: " 
+         << parent4 / parent3 << "x, InverseArray: " << inverse4 / inverse3 << "x, TransformPoints: " << transform4 / transform3 << "x" << endl << endl;
+}
+
+void BenchTransform() {
+    using xo::Vector3;
+    using xo::Quaternion;
+    using xo::Transform;
+    using xo::Matrix3x4;
+    using xo::Matrix4x4;
+
+    // The same parent/child pairs as transforms and as matrices.
+    const size_t count = 1 << 14;
+    std::vector<Transform> a(count), b(count), out(count);
+    std::vector<Matrix4x4> a4(count), b4(count), out4(count);
+    for (size_t i = 0; i < count; ++i) {
+        a[i] = Transform(Vector3((float)i, 0.0f, 0.0f), Quaternion::RotationRadians(0.001f * i, 0.5f, -0.002f * i), Vector3(1.0f + 0.0001f * i));
+        b[i] = Transform(Vector3(0.0f, 1.0f, 0.0f), Quaternion::AxisAngleRadians(Vector3::Up, 0.003f * i));
+        a4[i] = a[i].ToMatrix4x4();
+        b4[i] = b[i].ToMatrix4x4();
+    }
+
+    double multiply4 = bench("Matrix4x4::MultiplyArray (parent * child)", count, count * 3 * sizeof(Matrix4x4), [&]{
+        Matrix4x4::MultiplyArray(a4.data(), b4.data(), out4.data(), count);
+        ClobberMemory();
+    });
+    double multiply = bench("Transform::MultiplyArray", count, count * 3 * sizeof(Transform), [&]{
+        Transform::MultiplyArray(a.data(), b.data(), out.data(), count);
+        ClobberMemory();
+    });
+    double single = bench("Transform::Multiply, one at a time", count, count * 3 * sizeof(Transform), [&]{
+        for (size_t i = 0; i < count; ++i) {
+            Transform::Multiply(a[i], b[i], out[i]);
+        }
+        ClobberMemory();
+    });
+    bench("Transform::MultiplyArray (parent * children)", count, count * 2 * sizeof(Transform), [&]{
+        Transform::MultiplyArray(a[0], b.data(), out.data(), count);
+        ClobberMemory();
+    });
+    double inverse4 = bench("Matrix4x4::InverseArray (parent)", count, count * 2 * sizeof(Matrix4x4), [&]{
+        Matrix4x4::InverseArray(a4.data(), out4.data(), count);
+        ClobberMemory();
+    });
+    double inverse = bench("Transform::MakeInverse", count, count * 2 * sizeof(Transform), [&]{
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = a[i].Inverse();
+        }
+        ClobberMemory();
+    });
+
+    double convert = bench("Transform::ToMatrixArray (Matrix4x4)", count, count * (sizeof(Transform) + sizeof(Matrix4x4)), [&]{
+        Transform::ToMatrixArray(a.data(), out4.data(), count);
+        ClobberMemory();
+    });
+    double convertSingle = bench("Transform::ToMatrix (Matrix4x4), one at a time", count, count * (sizeof(Transform) + sizeof(Matrix4x4)), [&]{
+        for (size_t i = 0; i < count; ++i) {
+            a[i].ToMatrix(out4[i]);
+        }
+        ClobberMemory();
+    });
+
+    cout << "Transform speedup over Matrix4x4, compose: " << multiply4 / multiply << "x, inverse: " << inverse4 / inverse 
+         << "x. MultiplyArray over Multiply: " << single / multiply << "x, ToMatrixArray over ToMatrix: " << convertSingle / convert << "x" << endl << endl;
+}
+
+void BenchDualQuaternionSkinning() {
+    using xo::Vector3;
+    using xo::Vector3Stream;
+    using xo::Quaternion;
+    using xo::DualQuaternion;
+    using xo::Matrix3x4;
+    using xo::Transform;
+    using xo::Skinning;
+
+    // A 64 bone palette both ways, and vertices with up to four influences each.
+    const int bones = 64;
+    std::vector<DualQuaternion> dualQuaternions(bones);
+    std::vector<Matrix3x4> matrices(bones);
+    for (int i = 0; i < bones; ++i) {
+        const Transform t(Vector3(0.1f * i, 1.0f, -0.05f * i), Quaternion::RotationRadians(0.1f * i, 0.2f, -0.03f * i));
+        dualQuaternions[i] = DualQuaternion(t);
+        matrices[i] = t.ToMatrix3x4();
+    }
+    const size_t count = 1 << 16;
+    std::vector<uint16_t> indices(count * Skinning::Influences);
+    std::vector<float> weights(count * Skinning::Influences);
+    Vector3Stream positions(count), normals(count), outPositions(count), outNormals(count);
+    for (size_t i = 0; i < count; ++i) {
+        for (int j = 0; j < Skinning::Influences; ++j) {
+            indices[i * Skinning::Influences + j] = (uint16_t)((i / 64 + j * 3) % bones);
+            weights[i * Skinning::Influences + j] = j < 2 ? 0.375f : 0.125f;
+        }
+        positions.Set(i, Vector3(0.001f * i, 1.0f, -0.002f * i));
+        normals.Set(i, Vector3(0.0f, 1.0f, 0.0f));
+    }
+
+    // Linear blend skinning a vertex at a time: the weighted sum of the bones' matrices, applied.
+    double linear = bench("Linear blend, a vertex at a time (Matrix3x4)", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            const uint16_t* index = &indices[i * Skinning::Influences];
+            const float* weight = &weights[i * Skinning::Influences];
+            Matrix3x4 m(matrices[index[0]].r[0] * weight[0], matrices[index[0]].r[1] * weight[0], matrices[index[0]].r[2] * weight[0]);
+            for (int j = 1; j < Skinning::Influences; ++j) {
+                m.r[0] += matrices[index[j]].r[0] * weight[j];
+                m.r[1] += matrices[index[j]].r[1] * weight[j];
+                m.r[2] += matrices[index[j]].r[2] * weight[j];
+            }
+            outPositions.Set(i, m.TransformPoint(positions.Get(i)));
+            outNormals.Set(i, m.TransformDirection(normals.Get(i)));
+        }
+        ClobberMemory();
+    });
+    double dualQuaternion = bench("Skinning::DualQuaternionBlend (1 thread)", count, [&]{
+        Skinning::DualQuaternionBlend(dualQuaternions.data(), indices.data(), weights.data(), positions, normals, outPositions, outNormals, 1);
+        ClobberMemory();
+    });
+    double threaded = bench("Skinning::DualQuaternionBlend (all threads)", count, [&]{
+        Skinning::DualQuaternionBlend(dualQuaternions.data(), indices.data(), weights.data(), positions, normals, outPositions, outNormals);
+        ClobberMemory();
+    });
+
+    cout << "DualQuaternionBlend: " << 1e3 / dualQuaternion << "M vertices/s on 1 thread, " << 1e3 / threaded 
+         << "M on all; " << linear / dualQuaternion << "x linear blend a vertex at a time" << endl << endl;
+}
+
+void BenchLinearBlendSkinning() {
+    using xo::Vector3;
+    using xo::Vector4;
+    using xo::Vector3Stream;
+    using xo::Quaternion;
+    using xo::DualQuaternion;
+    using xo::Matrix3x4;
+    using xo::Matrix4x4;
+    using xo::Transform;
+    using xo::Skinning;
+
+    // A 64 bone palette, and vertices with up to four influences each, as streams and as interleaved arrays.
+    const int bones = 64;
+    std::vector<Matrix4x4> matrices4(bones);
+    std::vector<Matrix3x4> matrices(bones);
+    std::vector<DualQuaternion> dualQuaternions(bones);
+    for (int i = 0; i < bones; ++i) {
+        const Transform t(Vector3(0.1f * i, 1.0f, -0.05f * i), Quaternion::RotationRadians(0.1f * i, 0.2f, -0.03f * i));
+        matrices[i] = t.ToMatrix3x4();
+        matrices4[i] = t.ToMatrix4x4();
+        dualQuaternions[i] = DualQuaternion(t);
+    }
+    const size_t count = 1 << 16;
+    std::vector<uint16_t> indices(count * Skinning::Influences);
+    std::vector<float> weights(count * Skinning::Influences);
+    std::vector<Vector3> positions(count), normals(count), outPositions(count), outNormals(count);
+    for (size_t i = 0; i < count; ++i) {
+        for (int j = 0; j < Skinning::Influences; ++j) {
+            indices[i * Skinning::Influences + j] = (uint16_t)((i / 64 + j * 3) % bones);
+            weights[i * Skinning::Influences + j] = j < 2 ? 0.375f : 0.125f;
+        }
+        positions[i].Set(0.001f * i, 1.0f, -0.002f * i);
+        normals[i].Set(0.0f, 1.0f, 0.0f);
+    }
+    Vector3Stream positionStream(positions.data(), count), normalStream(normals.data(), count), outPositionStream(count), outNormalStream(count);
+
+    // The weighted sum of each vertex's bone matrices, then Matrix4x4::Transform on the position and normal.
+    double naive = bench("Matrix4x4::Transform, a vertex at a time", count, [&]{
+        for (size_t i = 0; i < count; ++i) {
+            const uint16_t* index = &indices[i * Skinning::Influences];
+            const float* weight = &weights[i * Skinning::Influences];
+            Matrix4x4 m;
+            for (int r = 0; r < 4; ++r) {
+                m.r[r] = matrices4[index[0]].r[r] * weight[0] + matrices4[index[1]].r[r] * weight[1] + 
+                         matrices4[index[2]].r[r] * weight[2] + matrices4[index[3]].r[r] * weight[3];
+            }
+            Vector4 p(positions[i], 1.0f), n(normals[i], 0.0f);
+            m.Transform(p);
+            m.Transform(n);
+            outPositions[i].Set(p.x, p.y, p.z);
+            outNormals[i].Set(n.x, n.y, n.z);
+        }
+        ClobberMemory();
+    });
+    double linear = bench("Skinning::LinearBlend (Matrix3x4, streams, 1 thread)", count, [&]{
+        Skinning::LinearBlend(matrices.data(), indices.data(), weights.data(), positionStream, normalStream, outPositionStream, outNormalStream, 1);
+        ClobberMemory();
+    });
+    bench("Skinning::LinearBlend (Matrix4x4, streams, 1 thread)", count, [&]{
+        Skinning::LinearBlend(matrices4.data(), indices.data(), weights.data(), positionStream, normalStream, outPositionStream, outNormalStream, 1);
+        ClobberMemory();
+    });
+    bench("Skinning::LinearBlend (Matrix3x4, positions only, 1 thread)", count, [&]{
+        Skinning::LinearBlend(matrices.data(), indices.data(), weights.data(), positionStream, outPositionStream, 1);
+        ClobberMemory();
+    });
+    double interleaved = bench("Skinning::LinearBlend (Matrix3x4, interleaved, 1 thread)", count, [&]{
+        Skinning::LinearBlend(matrices.data(), indices.data(), weights.data(), positions.data(), normals.data(), outPositions.data(), outNormals.data(), count, 1);
+        ClobberMemory();
+    });
+    double threaded = bench("Skinning::LinearBlend (Matrix3x4, streams, all threads)", count, [&]{
+        Skinning::LinearBlend(matrices.data(), indices.data(), weights.data(), positionStream, normalStream, outPositionStream, outNormalStream);
+        ClobberMemory();
+    });
+    double dualQuaternion = bench("Skinning::DualQuaternionBlend (streams, 1 thread)", count, [&]{
+        Skinning::DualQuaternionBlend(dualQuaternions.data(), indices.data(), weights.data(), positionStream, normalStream, outPositionStream, outNormalStream, 1);
+        ClobberMemory();
+    });
+
+    cout << "LinearBlend: " << 1e3 / linear << "M vertices/s on 1 thread (" << 1e3 / interleaved << "M interleaved), " 
+         << 1e3 / threaded << "M on all, against " << 1e3 / naive << "M for Matrix4x4::Transform: " << naive / linear 
+         << "x. DualQuaternionBlend costs " << dualQuaternion / linear << "x LinearBlend" << endl << endl;
+}
+
+void BenchHierarchy() {
+    using xo::Vector3;
+    using xo::Quaternion;
+    using xo::Matrix3x4;
+    using xo::Matrix4x4;
+    using xo::Transform;
+    using xo::Hierarchy;
+    using xo::Morton;
+
+    // A scene graph of 300k nodes under 8 roots, each node after its parent but the levels interleaved, a few hundred 
+    // to tens of thousands of nodes a level.
+    const size_t count = 300000;
+    std::vector<uint32_t> parents(count);
+    std::vector<Transform> locals(count);
+    std::vector<Matrix3x4> locals3(count), worlds3(count);
+    std::vector<Matrix4x4> locals4(count), worlds4(count);
+    for (size_t i = 0; i < count; ++i) {
+        parents[i] = i < 8 ? Hierarchy::NoParent : (uint32_t)(i / (2 + i % 4));
+        locals[i] = Transform(Vector3(0.1f, 0.001f * (i % 100), 0.0f), Quaternion::RotationRadians(0.0f, 0.01f * (i % 50), 0.0f));
+        locals3[i] = locals[i].ToMatrix3x4();
+        locals4[i] = locals[i].ToMatrix4x4();
+    }
+    Hierarchy hierarchy;
+    bench("Hierarchy::Build", count, [&]{
+        hierarchy.Build(parents.data(), count);
+        ClobberMemory();
+    });
+    auto nodeByNode = [&]{
+        for (size_t i = 0; i < count; ++i) {
+            worlds4[i] = parents[i] == Hierarchy::NoParent ? locals4[i] : worlds4[parents[i]] * locals4[i];
+        }
+        ClobberMemory();
+    };
+    double naive = bench("Matrix4x4::operator*, node by node", count, nodeByNode);
+    double scattered = bench("Hierarchy::Update (Matrix4x4, 1 thread)", count, [&]{
+        hierarchy.Update(locals4.data(), worlds4.data(), 1);
+        ClobberMemory();
+    });
+
+    // The same scene renumbered in level order.
+    std::vector<uint32_t> levelParents(count);
+    std::vector<Transform> levelLocals(count);
+    hierarchy.LevelOrderParents(levelParents.data());
+    Morton::Permute(locals.data(), hierarchy.Nodes(), count, levelLocals.data());
+    parents.swap(levelParents);
+    locals.swap(levelLocals);
+    for (size_t i = 0; i < count; ++i) {
+        locals3[i] = locals[i].ToMatrix3x4();
+        locals4[i] = locals[i].ToMatrix4x4();
+    }
+    hierarchy.Build(parents.data(), count);
+    double naiveLevelOrder = bench("Matrix4x4::operator*, node by node in level order", count, nodeByNode);
+    double single = bench("Hierarchy::Update (Matrix4x4, 1 thread, level order)", count, [&]{
+        hierarchy.Update(locals4.data(), worlds4.data(), 1);
+        ClobberMemory();
+    });
+    double threaded = bench("Hierarchy::Update (Matrix4x4, all threads, level order)", count, [&]{
+        hierarchy.Update(locals4.data(), worlds4.data());
+        ClobberMemory();
+    });
+    double affine = bench("Hierarchy::Update (Matrix3x4, 1 thread, level order)", count, [&]{
+        hierarchy.Update(locals3.data(), worlds3.data(), 1);
+        ClobberMemory();
+    });
+    bench("Hierarchy::Update (Transform to Matrix3x4, 1 thread, level order)", count, [&]{
+        hierarchy.Update(locals.data(), worlds3.data(), 1);
+        ClobberMemory();
+    });
+
+    cout << "Hierarchy::Update over " << hierarchy.LevelCount() << " levels: " << 1e3 / single << "M nodes/s on 1 thread, " 
+         << 1e3 / threaded << "M on all (" << std::thread::hardware_concurrency() << " hardware threads), " << 1e3 / affine 
+         << "M with Matrix3x4, against " << 1e3 / naiveLevelOrder << "M node by node: " << naiveLevelOrder / threaded 
+         << "x. Out of level order: " << 1e3 / scattered << "M against " << 1e3 / naive << "M node by node" << endl << endl;
+}
+
+int main(int argc, char** argv) {
+    const char* jsonPath = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        }
+    }
+
+    cout << XO_MATH_COMPILER_INFO << endl << endl;
+
+    BenchVectorOps();
+    BenchMatrix4x4Transform();
+    BenchMatrix4x4Multiply();
+    BenchMatrix4x4Inverse();
+    BenchQuaternionBlend();
+    BenchTrig();
+    BenchPrecision();
+    BenchRandom();
+    BenchRandomArrays();
+    BenchAABB();
+    BenchFrustum();
+    BenchRay();
+    BenchBVH();
+    BenchBoundingSphere();
+    BenchPlane();
+    BenchClosestPoints();
+    BenchSpatialHashGrid();
+    BenchGJK();
+    BenchMorton();
+    BenchMatrix3x4();
+    BenchTransform();
+    BenchDualQuaternionSkinning();
+    BenchLinearBlendSkinning();
+    BenchHierarchy();
+
+    if (jsonPath) {
+        std::ofstream json(jsonPath);
+        bench.WriteJson(json, XO_MATH_HIGHEST_SIMD);
+        if (!json) {
+            cout << "Failed to write " << jsonPath << endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
\ No newline at end of file
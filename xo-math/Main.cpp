@@ -1,4 +1,5 @@
 #include <vector>
+#include <algorithm>
 #include <iostream>
 #include <cmath>
 using std::cout;
@@ -21,6 +22,28 @@ Test test;
 
 #define TEST_MSG(x)  "Main.cpp(" _XO_MATH_STRINGIFY(__LINE__) ") " x
 
+// Fixtures shared by the randomized tests.
+xo::Vector3 RandomVector(xo::RandomGenerator& rng, float range) {
+    return xo::Vector3(rng.Range(-range, range), rng.Range(-range, range), rng.Range(-range, range));
+}
+
+xo::Quaternion RandomRotation(xo::RandomGenerator& rng) {
+    return xo::Quaternion::AxisAngleRadians(RandomVector(rng, 1.0f).Normalized(), rng.Range(-3.0f, 3.0f));
+}
+
+bool CloseVector(const xo::Vector3& a, const xo::Vector3& b, float tolerance = 1e-3f) {
+    return xo::Abs(a.x - b.x) < tolerance && xo::Abs(a.y - b.y) < tolerance && xo::Abs(a.z - b.z) < tolerance;
+}
+
+bool CloseMatrix(const xo::Matrix3x4& a, const xo::Matrix3x4& b, float tolerance) {
+    for (int i = 0; i < 12; ++i) {
+        if (xo::Abs(a.m[i] - b.m[i]) > tolerance) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void TestVector2Operators() {
     test("Vector2 Operators", []{
         using xo::Vector2;
@@ -633,6 +656,2042 @@ void TestVector4Methods() {
     });  
 }
 
+void TestVector3Stream() {
+    test("Vector3Stream", []{
+        using xo::Vector3;
+        using xo::Vector3Stream;
+
+        // an odd count, so every kernel has to deal with a partial simd step.
+        const size_t count = 37;
+        std::vector<Vector3> a(count), b(count), out(count);
+        for (size_t i = 0; i < count; ++i) {
+            a[i].Set(1.0f + i, 2.0f - i * 0.5f, 0.25f * i);
+            b[i].Set(-0.5f * i, 3.0f, 1.0f + i * 0.1f);
+        }
+        a[3] = Vector3::Zero;
+
+        Vector3Stream sa(a.data(), count), sb(b.data(), count), so;
+        test.ReportSuccessIf(sa.Size(), count, TEST_MSG("Constructor (vecs, count) did not set the size."));
+        test.ReportSuccessIf((sa.Capacity() % xo::wide::Width) == 0, TEST_MSG("Capacity should be a multiple of the simd width."));
+        test.ReportSuccessIf(xo::IsAligned16(sa.X()) && xo::IsAligned16(sa.Y()) && xo::IsAligned16(sa.Z()), TEST_MSG("stream arrays should be aligned."));
+        test.ReportSuccessIf(sa.Get(5), a[5], TEST_MSG("Get(i) did not return the vector it was built from."));
+
+        sa.Get(out.data());
+        bool same = true;
+        for (size_t i = 0; i < count; ++i) same = same && out[i] == a[i];
+        test.ReportSuccessIf(same, TEST_MSG("Get(vecs) did not round trip the vectors the stream was built from."));
+
+#define _XO_STREAM_OP(call, expected, msg) \
+        call; \
+        so.Get(out.data()); \
+        same = true; \
+        for (size_t i = 0; i < count; ++i) same = same && out[i] == (expected); \
+        test.ReportSuccessIf(same, TEST_MSG(msg));
+
+        _XO_STREAM_OP(Vector3Stream::Add(sa, sb, so), a[i] + b[i], "Add did not match Vector3 +.");
+        _XO_STREAM_OP(Vector3Stream::Add(sa, Vector3::One, so), a[i] + Vector3::One, "Add (Vector3) did not match Vector3 +.");
+        _XO_STREAM_OP(Vector3Stream::Subtract(sa, sb, so), a[i] - b[i], "Subtract did not match Vector3 -.");
+        _XO_STREAM_OP(Vector3Stream::Multiply(sa, sb, so), a[i] * b[i], "Multiply did not match Vector3 *.");
+        _XO_STREAM_OP(Vector3Stream::Scale(sa, 0.5f, so), a[i] * 0.5f, "Scale did not match Vector3 * float.");
+        _XO_STREAM_OP(Vector3Stream::Lerp(sa, sb, 0.25f, so), Vector3::Lerp(a[i], b[i], 0.25f), "Lerp did not match Vector3::Lerp.");
+        _XO_STREAM_OP(Vector3Stream::Cross(sa, sb, so), Vector3::Cross(a[i], b[i]), "Cross did not match Vector3::Cross.");
+        _XO_STREAM_OP(Vector3Stream::Normalize(sa, so), a[i].NormalizedSafe(), "Normalize did not match Vector3::NormalizedSafe.");
+        _XO_STREAM_OP(so = sa; so += sb, a[i] + b[i], "operator += did not match Vector3 +=.");
+        _XO_STREAM_OP(so = sa; so *= 2.0f, a[i] * 2.0f, "operator *= did not match Vector3 *=.");
+#undef _XO_STREAM_OP
+
+        std::vector<float> f(count);
+        Vector3Stream::Dot(sa, sb, f.data());
+        same = true;
+        for (size_t i = 0; i < count; ++i) same = same && xo::CloseEnough(f[i], a[i].Dot(b[i]), Vector3::Epsilon);
+        test.ReportSuccessIf(same, TEST_MSG("Dot did not match Vector3::Dot."));
+        Vector3Stream::Magnitude(sa, f.data());
+        same = true;
+        for (size_t i = 0; i < count; ++i) same = same && xo::CloseEnough(f[i], a[i].Magnitude(), Vector3::Epsilon);
+        test.ReportSuccessIf(same, TEST_MSG("Magnitude did not match Vector3::Magnitude."));
+
+        sa.Resize(40);
+        test.ReportSuccessIf(sa.Get(36), a[36], TEST_MSG("Resize should keep existing vectors."));
+        test.ReportSuccessIf(sa.Get(39), Vector3::Zero, TEST_MSG("Resize should zero new vectors."));
+        Vector3Stream moved(std::move(sa));
+        test.ReportSuccessIf(moved.Size() == 40 && sa.Size() == 0, TEST_MSG("Move constructor should take the arrays."));
+    });
+}
+
+void TestMatrix4x4Methods() {
+    test("Matrix4x4 Methods", []{
+        using xo::Vector3;
+        using xo::Vector4;
+        using xo::Matrix4x4;
+
+        Matrix4x4 m;
+        Matrix4x4::RotationRadians(0.3f, -1.1f, 2.0f, m);
+        m(0, 3) = 4.0f;
+        m(1, 3) = -5.0f;
+        m(2, 3) = 6.0f;
+
+        // not a multiple of four, so the packed path has a tail to finish.
+        const size_t count = 11;
+        std::vector<Vector3> vecs(count), points(count), directions(count);
+        std::vector<float> packed(count * 3), packedPoints(count * 3), packedDirections(count * 3);
+        for (size_t i = 0; i < count; ++i) {
+            vecs[i].Set(1.0f + i, -2.0f + i * 0.5f, 0.25f * i);
+            packed[i * 3] = vecs[i].x;
+            packed[i * 3 + 1] = vecs[i].y;
+            packed[i * 3 + 2] = vecs[i].z;
+        }
+
+        m.TransformPoints(vecs.data(), points.data(), count);
+        m.TransformDirections(vecs.data(), directions.data(), count);
+        m.TransformPoints(packed.data(), packedPoints.data(), count);
+        m.TransformDirections(packed.data(), packedDirections.data(), count);
+
+        bool pointsMatch = true, directionsMatch = true, packedPointsMatch = true, packedDirectionsMatch = true;
+        for (size_t i = 0; i < count; ++i) {
+            Vector3 point = m * Vector4(vecs[i], 1.0f);
+            Vector3 direction = vecs[i];
+            m.Transform(direction);
+            pointsMatch = pointsMatch && points[i] == point;
+            directionsMatch = directionsMatch && directions[i] == direction;
+            packedPointsMatch = packedPointsMatch && Vector3(packedPoints[i * 3], packedPoints[i * 3 + 1], packedPoints[i * 3 + 2]) == point;
+            packedDirectionsMatch = packedDirectionsMatch && Vector3(packedDirections[i * 3], packedDirections[i * 3 + 1], packedDirections[i * 3 + 2]) == direction;
+        }
+        test.ReportSuccessIf(pointsMatch, TEST_MSG("TransformPoints did not match transforming each point with a w of 1."));
+        test.ReportSuccessIf(directionsMatch, TEST_MSG("TransformDirections did not match Transform."));
+        test.ReportSuccessIf(packedPointsMatch, TEST_MSG("TransformPoints (packed) did not match transforming each point with a w of 1."));
+        test.ReportSuccessIf(packedDirectionsMatch, TEST_MSG("TransformDirections (packed) did not match Transform."));
+
+        m.TransformPoints(vecs.data(), count);
+        m.TransformDirections(packed.data(), count);
+        test.ReportSuccessIf(vecs[7], points[7], TEST_MSG("TransformPoints in place did not match out of place."));
+        test.ReportSuccessIf(Vector3(packed[21], packed[22], packed[23]), directions[7], TEST_MSG("TransformDirections (packed) in place did not match out of place."));
+
+        Matrix4x4 a( 1.0f,  2.0f,  3.0f,  4.0f,
+                     5.0f,  6.0f,  7.0f,  8.0f,
+                     9.0f, 10.0f, 11.0f, 12.0f,
+                    13.0f, 14.0f, 15.0f, 16.0f);
+        Matrix4x4 b(-1.0f,  0.5f,  2.0f,  0.0f,
+                     3.0f, -2.0f,  1.0f,  1.0f,
+                     0.0f,  4.0f, -3.0f,  2.0f,
+                     1.0f,  1.0f,  0.5f, -1.0f);
+        Matrix4x4 expected( 9.0f, 12.5f, -3.0f,  4.0f,
+                           21.0f, 26.5f, -1.0f, 12.0f,
+                           33.0f, 40.5f,  1.0f, 20.0f,
+                           45.0f, 54.5f,  3.0f, 28.0f);
+        Matrix4x4 ab = a * b;
+        bool productMatch = true;
+        for (int r = 0; r < 4; ++r) productMatch = productMatch && ab[r] == expected[r];
+        test.ReportSuccessIf(productMatch, TEST_MSG("operator * did not produce the expected product."));
+
+        Matrix4x4 aliased = a;
+        Matrix4x4::Multiply(aliased, b, aliased);
+        Matrix4x4 aliasedB = b;
+        Matrix4x4::Multiply(a, aliasedB, aliasedB);
+        bool aliasMatch = true;
+        for (int r = 0; r < 4; ++r) aliasMatch = aliasMatch && aliased[r] == expected[r] && aliasedB[r] == expected[r];
+        test.ReportSuccessIf(aliasMatch, TEST_MSG("Multiply should allow the output to be either input."));
+
+        Matrix4x4 as[3] = { a, b, m };
+        Matrix4x4 bs[3] = { b, m, a };
+        Matrix4x4 outs[3];
+        bool arrayMatch = true;
+        Matrix4x4::MultiplyArray(as, bs, outs, 3);
+        for (int i = 0; i < 3; ++i) for (int r = 0; r < 4; ++r) arrayMatch = arrayMatch && outs[i][r] == (as[i] * bs[i])[r];
+        Matrix4x4::MultiplyArray(m, bs, outs, 3);
+        for (int i = 0; i < 3; ++i) for (int r = 0; r < 4; ++r) arrayMatch = arrayMatch && outs[i][r] == (m * bs[i])[r];
+        Matrix4x4::MultiplyArray(as, m, outs, 3);
+        for (int i = 0; i < 3; ++i) for (int r = 0; r < 4; ++r) arrayMatch = arrayMatch && outs[i][r] == (as[i] * m)[r];
+        test.ReportSuccessIf(arrayMatch, TEST_MSG("MultiplyArray did not match operator *."));
+
+        // general, affine and rigid matrices, with a singular one in the middle and a partial simd group at the end.
+        const size_t inverseCount = 11;
+        Matrix4x4 toInvert[inverseCount], inverted[inverseCount];
+        for (size_t i = 0; i < inverseCount; ++i) {
+            Matrix4x4::RotationRadians(0.2f * i, 1.0f - 0.1f * i, 0.3f, toInvert[i]);
+            toInvert[i](0, 3) = 1.0f + i;
+            toInvert[i](1, 3) = -2.0f;
+            toInvert[i](2, 3) = 0.5f * i;
+        }
+        Matrix4x4 rigid[inverseCount];
+        for (size_t i = 0; i < inverseCount; ++i) rigid[i] = toInvert[i];
+        toInvert[1](3, 0) = 0.25f; // not affine
+        toInvert[5] = Matrix4x4::One; // singular
+
+        // the batch and single inverses round differently, so compare with a tolerance that suits any build.
+        auto matricesClose = [](const Matrix4x4& a, const Matrix4x4& b) {
+            bool match = true;
+            for (int k = 0; k < 16; ++k) match = match && std::fabs(a.m[k] - b.m[k]) <= 0.0001f;
+            return match;
+        };
+        auto inverseMatches = [&matricesClose](const Matrix4x4& got, const Matrix4x4& original) {
+            Matrix4x4 expected = original;
+            expected.MakeInverse();
+            return matricesClose(got, expected);
+        };
+
+        uint32_t singularMask = 0xffffffff;
+        bool allInverted = Matrix4x4::TryInverseArray(toInvert, inverted, inverseCount, &singularMask);
+        test.ReportSuccessIf(!allInverted, TEST_MSG("TryInverseArray should fail when a matrix is singular."));
+        test.ReportSuccessIf(singularMask, (uint32_t)(1 << 5), TEST_MSG("TryInverseArray should report only the singular matrix."));
+        bool inverseMatch = true;
+        for (size_t i = 0; i < inverseCount; ++i) inverseMatch = inverseMatch && (i == 5 || inverseMatches(inverted[i], toInvert[i]));
+        test.ReportSuccessIf(inverseMatch, TEST_MSG("TryInverseArray did not match MakeInverse."));
+        test.ReportSuccessIf(inverted[5][2], Matrix4x4::One[2], TEST_MSG("TryInverseArray should leave a singular matrix unchanged."));
+
+        Matrix4x4::InverseArray(rigid, inverted, inverseCount);
+        inverseMatch = true;
+        for (size_t i = 0; i < inverseCount; ++i) inverseMatch = inverseMatch && inverseMatches(inverted[i], rigid[i]);
+        test.ReportSuccessIf(inverseMatch, TEST_MSG("InverseArray did not match MakeInverse."));
+
+        Matrix4x4::InverseRigidArray(rigid, rigid, inverseCount);
+        inverseMatch = true;
+        for (size_t i = 0; i < inverseCount; ++i) inverseMatch = inverseMatch && matricesClose(rigid[i], inverted[i]);
+        test.ReportSuccessIf(inverseMatch, TEST_MSG("InverseRigidArray in place did not match InverseArray."));
+    });
+}
+
+void TestQuaternionMethods() {
+    test("Quaternion Methods", []{
+        using xo::Vector3;
+        using xo::Quaternion;
+
+        // not a multiple of the simd width, with pairs that exercise the early outs and the shortest path fold.
+        const size_t count = 13;
+        std::vector<Quaternion> a(count), b(count), slerped(count), nlerped(count);
+        std::vector<float> t(count);
+        for (size_t i = 0; i < count; ++i) {
+            a[i] = Quaternion::RotationRadians(0.1f * i, 0.7f, -0.3f * i);
+            b[i] = Quaternion::RotationRadians(-0.2f * i, 0.4f * i, 1.1f);
+            t[i] = i / (float)(count - 1);
+        }
+        b[4] = a[4];
+        b[6] = Quaternion(-a[6].x, -a[6].y, -a[6].z, -a[6].w);
+        b[7] = Quaternion(-b[7].x, -b[7].y, -b[7].z, -b[7].w);
+
+        Quaternion::SlerpArray(a.data(), b.data(), t.data(), slerped.data(), count);
+        Quaternion::NlerpArray(a.data(), b.data(), t.data(), nlerped.data(), count);
+
+        bool slerpMatch = true, nlerpMatch = true;
+        for (size_t i = 0; i < count; ++i) {
+            slerpMatch = slerpMatch && slerped[i] == Quaternion::Slerp(a[i], b[i], t[i]);
+            nlerpMatch = nlerpMatch && nlerped[i] == Quaternion::Nlerp(a[i], b[i], t[i]);
+        }
+        test.ReportSuccessIf(slerpMatch, TEST_MSG("SlerpArray did not match Slerp."));
+        test.ReportSuccessIf(nlerpMatch, TEST_MSG("NlerpArray did not match Nlerp."));
+        test.ReportSuccessIf(slerped[0] == a[0] && slerped[count - 1] == b[count - 1], TEST_MSG("SlerpArray should return the end points at t of 0 and 1."));
+
+        Quaternion half = Quaternion::Nlerp(Quaternion::Identity, Quaternion(0.0f, 0.0f, -1.0f, 0.0f), 0.5f);
+        test.ReportSuccessIf(half.w > 0.0f && half.z < 0.0f, TEST_MSG("Nlerp should take the shortest path."));
+
+        Quaternion::SlerpArray(a.data(), b.data(), t.data(), a.data(), count);
+        test.ReportSuccessIf(a[5] == slerped[5], TEST_MSG("SlerpArray in place did not match out of place."));
+    });
+}
+
+void TestTrig() {
+    test("Sin / Cos", []{
+        // relative to the larger of the result and 1e-6, which covers the 2.3 ulp max error of wide::SinCos with room to spare.
+        auto close = [](float got, double expected) {
+            return std::fabs(got - expected) <= 1e-6 * std::fmax(std::fabs(expected), 1e-6) * 4.0;
+        };
+
+        // not a multiple of the simd width, covering every quadrant and both signs.
+        const size_t count = 1003;
+        std::vector<float> f(count), s(count), c(count), sOnly(count), cOnly(count);
+        for (size_t i = 0; i < count; ++i) {
+            f[i] = -8000.0f + 16.0f * i + 0.37f * (i % 7);
+        }
+        f[0] = 0.0f;
+        f[1] = HalfPI;
+        f[2] = -PI;
+
+        xo::SinCosArray(f.data(), s.data(), c.data(), count);
+        xo::SinArray(f.data(), sOnly.data(), count);
+        xo::CosArray(f.data(), cOnly.data(), count);
+        bool sinMatch = true, cosMatch = true, splitMatch = true;
+        for (size_t i = 0; i < count; ++i) {
+            sinMatch = sinMatch && close(s[i], std::sin((double)f[i]));
+            cosMatch = cosMatch && close(c[i], std::cos((double)f[i]));
+            splitMatch = splitMatch && s[i] == sOnly[i] && c[i] == cOnly[i];
+        }
+        test.ReportSuccessIf(sinMatch, TEST_MSG("SinCosArray sine is not within tolerance of std::sin."));
+        test.ReportSuccessIf(cosMatch, TEST_MSG("SinCosArray cosine is not within tolerance of std::cos."));
+        test.ReportSuccessIf(splitMatch, TEST_MSG("SinArray and CosArray should match SinCosArray."));
+        test.ReportSuccessIf(s[0] == 0.0f && c[0] == 1.0f, TEST_MSG("SinCos of 0 should be exact."));
+
+        _XOSIMDALIGN float v[4] = { 0.5f, -2.0f, 3.0f, 100.0f };
+        _XOSIMDALIGN float s4[4] = { 9.0f, 9.0f, 9.0f, 9.0f };
+        _XOSIMDALIGN float c4[4] = { 9.0f, 9.0f, 9.0f, 9.0f };
+        xo::SinCos_x3(v, s4, c4);
+        test.ReportSuccessIf(close(s4[2], std::sin(3.0)) && close(c4[1], std::cos(-2.0)), TEST_MSG("SinCos_x3 is not within tolerance."));
+        test.ReportSuccessIf(s4[3] == 9.0f && c4[3] == 9.0f, TEST_MSG("SinCos_x3 should not write a fourth element."));
+        xo::Sin_x4(v, s4);
+        xo::Cos_x2(v, c4);
+        test.ReportSuccessIf(close(s4[3], std::sin(100.0)) && close(c4[0], std::cos(0.5)) && c4[3] == 9.0f, TEST_MSG("Sin_x4 / Cos_x2 is not within tolerance."));
+
+        float sf, cf;
+        xo::SinCos(1.0f, sf, cf);
+        test.ReportSuccessIf(close(sf, std::sin(1.0)) && close(cf, std::cos(1.0)), TEST_MSG("SinCos is not within tolerance."));
+        // Large angles, past where the reduction stays exact, mixed with small ones in the same group.
+        _XOSIMDALIGN const float largeAngles[12] = { 1e5f, -54321.5f, 300000.25f, 1.0f, 1e6f, -4e6f, 1.6e7f, 3e7f, 1e8f, -1e9f, 2.5f, 1e9f };
+        const size_t largeCount = 11;
+        std::vector<float> largeSin(largeCount), largeCos(largeCount), largeSinOnly(largeCount);
+        xo::SinCosArray(largeAngles, largeSin.data(), largeCos.data(), largeCount);
+        xo::SinArray(largeAngles, largeSinOnly.data(), largeCount);
+        bool large = true, largeArray = true, largeQuad = true;
+        for (size_t i = 0; i < largeCount; ++i) {
+            const double expectedSin = std::sin((double)largeAngles[i]), expectedCos = std::cos((double)largeAngles[i]);
+            xo::SinCos(largeAngles[i], sf, cf);
+            large = large && close(sf, expectedSin) && close(cf, expectedCos);
+            largeArray = largeArray && close(largeSin[i], expectedSin) && close(largeCos[i], expectedCos) && largeSinOnly[i] == largeSin[i];
+        }
+        for (size_t i = 0; i < 12; i += 4) {
+            _XOSIMDALIGN float sinOnly4[4], cosOnly4[4];
+            xo::SinCos_x4(largeAngles + i, s4, c4);
+            xo::Sin_x4(largeAngles + i, sinOnly4);
+            xo::Cos_x4(largeAngles + i, cosOnly4);
+            for (size_t j = 0; j < 4; ++j) {
+                const double expectedSin = std::sin((double)largeAngles[i + j]), expectedCos = std::cos((double)largeAngles[i + j]);
+                largeQuad = largeQuad && close(s4[j], expectedSin) && close(c4[j], expectedCos) && sinOnly4[j] == s4[j] && cosOnly4[j] == c4[j];
+            }
+        }
+        test.ReportSuccessIf(large, TEST_MSG("SinCos of large angles is not within tolerance."));
+        test.ReportSuccessIf(largeArray, TEST_MSG("SinCosArray of large angles is not within tolerance."));
+        test.ReportSuccessIf(largeQuad, TEST_MSG("SinCos_x4 of large angles is not within tolerance."));
+    });
+}
+
+void TestPrecision() {
+    test("Precision Policies", []{
+        using xo::Precision;
+        using xo::Vector2;
+        using xo::Vector3;
+        using xo::Vector4;
+        using xo::Quaternion;
+
+        // the documented max relative error of each policy.
+        auto within = [](float got, float expected, Precision p) {
+            const float tolerance = p == Precision::Approximate ? 3.7e-4f : 3e-7f;
+            return std::fabs(got - expected) <= tolerance * std::fabs(expected);
+        };
+        const Precision policies[] = { Precision::Exact, Precision::Fast, Precision::Approximate };
+        bool scalars = true, vectors = true, reciprocals = true;
+        for (Precision p : policies) {
+            for (float f = 0.01f; f < 1000.0f; f *= 1.37f) {
+                const float rcp = p == Precision::Exact ? xo::Reciprocal(f) : p == Precision::Fast ? xo::Reciprocal<Precision::Fast>(f) : xo::Reciprocal<Precision::Approximate>(f);
+                const float rsqrt = p == Precision::Exact ? xo::InvSqrt(f) : p == Precision::Fast ? xo::InvSqrt<Precision::Fast>(f) : xo::InvSqrt<Precision::Approximate>(f);
+                scalars = scalars && within(rcp, (float)(1.0 / f), p) && within(rsqrt, (float)(1.0 / std::sqrt((double)f)), p);
+            }
+        }
+
+        const Vector2 v2(3.0f, -4.0f);
+        const Vector3 v3(1.0f, -2.0f, 2.0f);
+        const Vector4 v4(2.0f, -4.0f, 4.0f, 1.0f);
+        const Quaternion q(1.0f, 2.0f, -3.0f, 4.0f);
+        auto quaternionMagnitude = [](const Quaternion& r) { return std::sqrt(r.x * r.x + r.y * r.y + r.z * r.z + r.w * r.w); };
+
+        vectors = vectors && within(v2.Normalized<Precision::Exact>().Magnitude(), 1.0f, Precision::Exact);
+        vectors = vectors && within(v3.Normalized<Precision::Exact>().Magnitude(), 1.0f, Precision::Exact);
+        vectors = vectors && within(v4.Normalized<Precision::Exact>().Magnitude(), 1.0f, Precision::Exact);
+        vectors = vectors && within(quaternionMagnitude(q.Normalized<Precision::Exact>()), 1.0f, Precision::Exact);
+        vectors = vectors && within(v2.Normalized<Precision::Fast>().Magnitude(), 1.0f, Precision::Fast);
+        vectors = vectors && within(v3.Normalized<Precision::Fast>().Magnitude(), 1.0f, Precision::Fast);
+        vectors = vectors && within(v4.Normalized<Precision::Fast>().Magnitude(), 1.0f, Precision::Fast);
+        vectors = vectors && within(quaternionMagnitude(q.Normalized<Precision::Fast>()), 1.0f, Precision::Fast);
+        vectors = vectors && within(v2.Normalized<Precision::Approximate>().Magnitude(), 1.0f, Precision::Approximate);
+        vectors = vectors && within(v3.Normalized<Precision::Approximate>().Magnitude(), 1.0f, Precision::Approximate);
+        vectors = vectors && within(v4.Normalized<Precision::Approximate>().Magnitude(), 1.0f, Precision::Approximate);
+        vectors = vectors && within(quaternionMagnitude(q.Normalized<Precision::Approximate>()), 1.0f, Precision::Approximate);
+        vectors = vectors && within(v3.InverseMagnitude(), 1.0f / 3.0f, Precision::Exact) && within(v4.InverseMagnitude<Precision::Fast>(), 1.0f / 6.08276253f, Precision::Fast);
+        test.ReportSuccessIf(scalars, TEST_MSG("Reciprocal / InvSqrt exceeded the documented error of a policy."));
+        test.ReportSuccessIf(vectors, TEST_MSG("Normalize / InverseMagnitude exceeded the documented error of a policy."));
+
+        const Vector2 r2 = v2.Reciprocal();
+        const Vector3 r3 = v3.Reciprocal<Precision::Fast>();
+        const Vector4 r4 = v4.Reciprocal<Precision::Approximate>();
+        reciprocals = within(r2.x, 1.0f / 3.0f, Precision::Exact) && within(r2.y, -0.25f, Precision::Exact);
+        reciprocals = reciprocals && within(r3.x, 1.0f, Precision::Fast) && within(r3.y, -0.5f, Precision::Fast) && within(r3.z, 0.5f, Precision::Fast);
+        reciprocals = reciprocals && within(r4.x, 0.5f, Precision::Approximate) && within(r4.z, 0.25f, Precision::Approximate) && within(r4.w, 1.0f, Precision::Approximate);
+        test.ReportSuccessIf(reciprocals, TEST_MSG("Reciprocal exceeded the documented error of a policy."));
+#if defined(XO_SSE)
+        test.ReportSuccessIf(r3.w == 0.0f, TEST_MSG("Vector3::Reciprocal should keep w at 0."));
+#endif
+    });
+}
+
+void TestRandom() {
+    test("Random", []{
+        using xo::RandomGenerator;
+        using xo::Vector3;
+
+        RandomGenerator a(1234), b(1234);
+        bool repeats = true;
+        for (int i = 0; i < 100; ++i) {
+            repeats = repeats && a.Next() == b.Next();
+        }
+        test.ReportSuccessIf(repeats, TEST_MSG("Generators with the same seed should produce the same sequence."));
+
+        // not a multiple of 4, so the bulk tail is covered.
+        const size_t count = 10003;
+        std::vector<float> floats(count + 1, -1.0f), ranged(count);
+        a.Floats(floats.data(), count);
+        b.RangeArray(-2.0f, 6.0f, ranged.data(), count);
+        bool inUnit = true, inRange = true;
+        double sum = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            inUnit = inUnit && floats[i] >= 0.0f && floats[i] < 1.0f;
+            inRange = inRange && ranged[i] >= -2.0f && ranged[i] <= 6.0f;
+            sum += floats[i];
+        }
+        test.ReportSuccessIf(inUnit && floats[count] == -1.0f, TEST_MSG("RandomGenerator::Floats should fill exactly count floats in [0, 1)."));
+        test.ReportSuccessIf(inRange, TEST_MSG("RandomGenerator::RangeArray went out of range."));
+        test.ReportSuccessIf(std::fabs(sum / count - 0.5) < 0.01, TEST_MSG("RandomGenerator::Floats should average about 0.5."));
+
+        int hits[4] = { };
+        bool inInts = true;
+        for (int i = 0; i < 4000; ++i) {
+            const int r = a.Range(-1, 2);
+            inInts = inInts && r >= -1 && r <= 2;
+            if (r >= -1 && r <= 2) {
+                ++hits[r + 1];
+            }
+        }
+        test.ReportSuccessIf(inInts && hits[0] > 800 && hits[3] > 800, TEST_MSG("RandomGenerator::Range(int, int) should cover both inclusive ends."));
+
+        bool onCube = true;
+        for (int i = 0; i < 100; ++i) {
+            const Vector3 v = Vector3::RandomOnCube(2.0f);
+            const float m = xo::Max(xo::Abs(v.x), xo::Max(xo::Abs(v.y), xo::Abs(v.z)));
+            onCube = onCube && m == 2.0f;
+        }
+        test.ReportSuccessIf(onCube, TEST_MSG("Vector3::RandomOnCube should land on the cube's surface."));
+    });
+}
+
+void TestRandomArrays() {
+    test("Vector3 Random Arrays", []{
+        using xo::Vector3;
+
+        // more than one batch of random numbers and not a multiple of the simd width.
+        const size_t count = 1003;
+        const float tolerance = 1e-4f;
+        std::vector<Vector3> v(count);
+        std::vector<float> x(count + 1, 7.0f), y(count + 1, 7.0f), z(count + 1, 7.0f);
+
+        const Vector3 up = Vector3(1.0f, 2.0f, -2.0f).Normalized();
+        const Vector3 forward(0.0f, 0.0f, 2.0f);
+        const float angle = 0.8f;
+
+        bool sphere = true;
+        Vector3::RandomOnSphereArray(3.0f, v.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            sphere = sphere && std::fabs(v[i].Magnitude() - 3.0f) < tolerance * 3.0f;
+        }
+        test.ReportSuccessIf(sphere && std::fabs(Vector3::RandomOnSphere(2.0f).Magnitude() - 2.0f) < tolerance, TEST_MSG("RandomOnSphere should land on the sphere."));
+
+        bool inCircle = true, onCircle = true;
+        Vector3::RandomInCircleArray(up, 2.0f, v.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            inCircle = inCircle && std::fabs(Vector3::Dot(v[i], up)) < tolerance && v[i].Magnitude() <= 2.0f + tolerance;
+        }
+        Vector3::RandomOnCircleArray(up, 2.0f, v.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            onCircle = onCircle && std::fabs(Vector3::Dot(v[i], up)) < tolerance && std::fabs(v[i].Magnitude() - 2.0f) < tolerance;
+        }
+        test.ReportSuccessIf(inCircle, TEST_MSG("RandomInCircleArray should stay in the circle perpendicular to up."));
+        test.ReportSuccessIf(onCircle, TEST_MSG("RandomOnCircleArray should land on the circle perpendicular to up."));
+
+        bool inCone = true, onCone = true;
+        Vector3::RandomInConeRadiansArray(forward, angle, v.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            inCone = inCone && std::fabs(v[i].Magnitude() - 2.0f) < tolerance && Vector3::AngleRadians(v[i], forward) <= angle * 0.5f + 1e-3f;
+        }
+        Vector3::RandomOnConeRadiansArray(forward, angle, v.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            onCone = onCone && std::fabs(Vector3::AngleRadians(v[i], forward) - angle * 0.5f) < 1e-3f;
+        }
+        test.ReportSuccessIf(inCone, TEST_MSG("RandomInConeRadiansArray should stay within half the angle of forward."));
+        test.ReportSuccessIf(onCone, TEST_MSG("RandomOnConeRadiansArray should be half the angle from forward."));
+
+        // Axes the cross products used to fall on: forward along -Up and up along -Right.
+        bool downCone = true, leftCircle = true;
+        Vector3::RandomOnConeRadiansArray(Vector3::Down, angle, v.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            downCone = downCone && std::fabs(Vector3::AngleRadians(v[i], Vector3::Down) - angle * 0.5f) < 1e-3f;
+        }
+        Vector3::RandomOnCircleArray(Vector3::Left, 2.0f, v.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            leftCircle = leftCircle && std::fabs(v[i].x) < tolerance && std::fabs(v[i].Magnitude() - 2.0f) < tolerance;
+        }
+        const Vector3 cone = Vector3::RandomInConeRadians(Vector3::Down, angle), circle = Vector3::RandomOnCircle(Vector3::Left, 2.0f);
+        downCone = downCone && Vector3::AngleRadians(cone, Vector3::Down) <= angle * 0.5f + 1e-3f;
+        leftCircle = leftCircle && std::fabs(circle.x) < tolerance && std::fabs(circle.Magnitude() - 2.0f) < tolerance;
+        test.ReportSuccessIf(downCone, TEST_MSG("a cone about -Up should be half the angle from it."));
+        test.ReportSuccessIf(leftCircle, TEST_MSG("a circle about -Right should land on the circle."));
+
+        bool inCube = true, onCube = true;
+        int faces[6] = { };
+        Vector3::RandomInCubeArray(0.5f, x.data(), y.data(), z.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            inCube = inCube && std::fabs(x[i]) <= 0.5f && std::fabs(y[i]) <= 0.5f && std::fabs(z[i]) <= 0.5f;
+        }
+        Vector3::RandomOnCubeArray(0.5f, x.data(), y.data(), z.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            const float f[3] = { x[i], y[i], z[i] };
+            int onFaces = 0;
+            for (int a = 0; a < 3; ++a) {
+                if (std::fabs(f[a]) == 0.5f) {
+                    ++onFaces;
+                    ++faces[a * 2 + (f[a] < 0.0f ? 1 : 0)];
+                }
+            }
+            onCube = onCube && onFaces >= 1;
+        }
+        bool allFaces = true;
+        for (int f = 0; f < 6; ++f) {
+            allFaces = allFaces && faces[f] > 100;
+        }
+        test.ReportSuccessIf(inCube, TEST_MSG("RandomInCubeArray should stay in the cube."));
+        test.ReportSuccessIf(onCube && allFaces, TEST_MSG("RandomOnCubeArray should land on all six faces."));
+        test.ReportSuccessIf(x[count] == 7.0f && y[count] == 7.0f && z[count] == 7.0f, TEST_MSG("Random arrays should write exactly count samples."));
+    });
+}
+
+void TestAABB() {
+    test("AABB", []{
+        using xo::Vector3;
+        using xo::Vector4;
+        using xo::Matrix4x4;
+        using xo::AABB;
+
+        const AABB a(Vector3(-1.0f, -2.0f, -3.0f), Vector3(1.0f, 2.0f, 3.0f));
+        const AABB b(Vector3(0.5f, 1.0f, -10.0f), Vector3(4.0f, 5.0f, 0.0f));
+        const AABB far(Vector3(10.0f, 10.0f, 10.0f), Vector3(11.0f, 11.0f, 11.0f));
+
+        test.ReportSuccessIf(a.Center(), Vector3::Zero, TEST_MSG("Center is not halfway between the corners."));
+        test.ReportSuccessIf(a.Extents(), Vector3(1.0f, 2.0f, 3.0f), TEST_MSG("Extents is not half the size."));
+        test.ReportSuccessIf(a.SurfaceArea(), 2.0f * (2.0f * 4.0f + 4.0f * 6.0f + 6.0f * 2.0f), TEST_MSG("SurfaceArea is wrong."));
+        test.ReportSuccessIf(a.Volume(), 48.0f, TEST_MSG("Volume is wrong."));
+        test.ReportSuccessIf(!a.IsEmpty() && AABB::Empty.IsEmpty(), TEST_MSG("IsEmpty is wrong."));
+
+        AABB u = AABB::Union(a, b);
+        test.ReportSuccessIf(u.min == Vector3(-1.0f, -2.0f, -10.0f) && u.max == Vector3(4.0f, 5.0f, 3.0f), TEST_MSG("Union is wrong."));
+        AABB i;
+        test.ReportSuccessIf(AABB::Intersection(a, b, i), TEST_MSG("Intersection of overlapping boxes reported no overlap."));
+        test.ReportSuccessIf(i.min == Vector3(0.5f, 1.0f, -3.0f) && i.max == Vector3(1.0f, 2.0f, 0.0f), TEST_MSG("Intersection is wrong."));
+        test.ReportSuccessIf(!AABB::Intersection(a, far, i) && i.IsEmpty(), TEST_MSG("Intersection of separate boxes is not empty."));
+
+        test.ReportSuccessIf(a.Overlaps(b) && b.Overlaps(a) && !a.Overlaps(far), TEST_MSG("Overlaps is wrong."));
+        // touching faces count as overlapping.
+        test.ReportSuccessIf(a.Overlaps(AABB(Vector3(1.0f, 0.0f, 0.0f), Vector3(2.0f, 1.0f, 1.0f))), TEST_MSG("Overlaps missed touching boxes."));
+        test.ReportSuccessIf(a.Contains(Vector3(1.0f, -2.0f, 0.0f)) && !a.Contains(Vector3(0.0f, 0.0f, 3.5f)), TEST_MSG("Contains (point) is wrong."));
+        test.ReportSuccessIf(u.Contains(a) && u.Contains(b) && !a.Contains(b), TEST_MSG("Contains (box) is wrong."));
+
+        AABB e = AABB::Empty;
+        e.Expand(Vector3(1.0f, 2.0f, 3.0f)).Expand(Vector3(-1.0f, 0.0f, 5.0f));
+        test.ReportSuccessIf(e.min == Vector3(-1.0f, 0.0f, 3.0f) && e.max == Vector3(1.0f, 2.0f, 5.0f), TEST_MSG("Expand (point) from Empty is wrong."));
+        e.Expand(1.0f);
+        test.ReportSuccessIf(e.min == Vector3(-2.0f, -1.0f, 2.0f) && e.max == Vector3(2.0f, 3.0f, 6.0f), TEST_MSG("Expand (float) is wrong."));
+        e = AABB::Empty;
+        e.Expand(a);
+        test.ReportSuccessIf(e.min == a.min && e.max == a.max, TEST_MSG("Expand (box) from Empty is wrong."));
+
+        Matrix4x4 m;
+        Matrix4x4::RotationRadians(0.3f, -1.1f, 2.0f, m);
+        m(0, 0) *= 2.0f;
+        m(0, 3) = 4.0f;
+        m(1, 3) = -5.0f;
+        m(2, 3) = 6.0f;
+
+        // not a multiple of anything, and with a box that is a single point.
+        const size_t count = 7;
+        std::vector<AABB> boxes(count), outBoxes(count);
+        for (size_t n = 0; n < count; ++n) {
+            Vector3 lo(-1.0f + n, 0.5f * n, -2.0f), hi(1.0f + n * 2.0f, 0.5f * n + 1.0f, n * 0.25f - 2.0f);
+            boxes[n] = AABB(lo, n == 3 ? lo : hi);
+        }
+        AABB::TransformArray(m, boxes.data(), outBoxes.data(), count);
+
+        // the corners round differently from the center and extents form, by an ulp or two.
+        auto close = [](const AABB& x, const AABB& y) {
+            return (x.min - y.min).Magnitude() < 1e-5f && (x.max - y.max).Magnitude() < 1e-5f;
+        };
+        bool matchesCorners = true, matchesTransform = true;
+        for (size_t n = 0; n < count; ++n) {
+            AABB corners = AABB::Empty;
+            for (int c = 0; c < 8; ++c) {
+                Vector3 corner((c & 1) ? boxes[n].max.x : boxes[n].min.x, (c & 2) ? boxes[n].max.y : boxes[n].min.y, (c & 4) ? boxes[n].max.z : boxes[n].min.z);
+                corners.Expand(Vector3(m * Vector4(corner, 1.0f)));
+            }
+            matchesCorners = matchesCorners && close(outBoxes[n], corners);
+            AABB single = boxes[n].Transformed(m);
+            matchesTransform = matchesTransform && single.min == outBoxes[n].min && single.max == outBoxes[n].max;
+        }
+        test.ReportSuccessIf(matchesCorners, TEST_MSG("TransformArray did not match the bounds of the eight transformed corners."));
+        test.ReportSuccessIf(matchesTransform, TEST_MSG("TransformArray did not match Transformed."));
+
+        AABB::TransformArray(m, boxes.data(), boxes.data(), count);
+        bool inPlace = true;
+        for (size_t n = 0; n < count; ++n) {
+            inPlace = inPlace && boxes[n].min == outBoxes[n].min && boxes[n].max == outBoxes[n].max;
+        }
+        test.ReportSuccessIf(inPlace, TEST_MSG("TransformArray in place did not match."));
+
+        std::vector<Vector3> points = { Vector3(1.0f, -1.0f, 0.0f), Vector3(-3.0f, 2.0f, 0.5f), Vector3(0.0f, 0.0f, -4.0f) };
+        AABB fromPoints = AABB::FromPoints(points.data(), points.size());
+        test.ReportSuccessIf(fromPoints.min == Vector3(-3.0f, -1.0f, -4.0f) && fromPoints.max == Vector3(1.0f, 2.0f, 0.5f), TEST_MSG("FromPoints is wrong."));
+        test.ReportSuccessIf(AABB::FromPoints(points.data(), 0).IsEmpty(), TEST_MSG("FromPoints with no points is not empty."));
+    });
+}
+
+void TestFrustum() {
+    test("Frustum", []{
+        using xo::Vector3;
+        using xo::Vector4;
+        using xo::Matrix4x4;
+        using xo::AABB;
+        using xo::Frustum;
+        using xo::ClipDepth;
+        using xo::RandomGenerator;
+
+        // 90 degree perspective looking down +z with near 1 and far 100, mapping points as m * p.
+        const float n = 1.0f, f = 100.0f;
+        const Matrix4x4 d3d(
+            1.0f, 0.0f, 0.0f, 0.0f,
+            0.0f, 1.0f, 0.0f, 0.0f,
+            0.0f, 0.0f, f / (f - n), -n * f / (f - n),
+            0.0f, 0.0f, 1.0f, 0.0f);
+        const Matrix4x4 gl(
+            1.0f, 0.0f, 0.0f, 0.0f,
+            0.0f, 1.0f, 0.0f, 0.0f,
+            0.0f, 0.0f, (f + n) / (f - n), -2.0f * n * f / (f - n),
+            0.0f, 0.0f, 1.0f, 0.0f);
+
+        bool containsMatch = true;
+        for (const Frustum& frustum : { Frustum(d3d, ClipDepth::ZeroToOne), Frustum(gl, ClipDepth::NegativeOneToOne) }) {
+            containsMatch = containsMatch &&
+                frustum.Contains(Vector3(0.0f, 0.0f, 50.0f)) && frustum.Contains(Vector3(49.0f, -49.0f, 50.0f)) &&
+                !frustum.Contains(Vector3(0.0f, 0.0f, 0.5f)) && !frustum.Contains(Vector3(0.0f, 0.0f, 101.0f)) &&
+                !frustum.Contains(Vector3(51.0f, 0.0f, 50.0f)) && !frustum.Contains(Vector3(0.0f, -51.0f, 50.0f));
+        }
+        test.ReportSuccessIf(containsMatch, TEST_MSG("Contains did not match the D3D and GL frustums."));
+
+        const Frustum frustum(d3d);
+        const float h = 0.70710678f;
+        test.ReportSuccessIf(frustum.planes[Frustum::Left], Vector4(h, 0.0f, h, 0.0f), TEST_MSG("Left plane was not extracted and normalized."));
+        test.ReportSuccessIf(frustum.planes[Frustum::Near], Vector4(0.0f, 0.0f, 1.0f, -1.0f), TEST_MSG("Near plane was not extracted and normalized."));
+
+        test.ReportSuccessIf(!frustum.IntersectsSphere(Vector3(0.0f, 0.0f, -1.0f), 1.5f), TEST_MSG("A sphere behind the near plane was not culled."));
+        test.ReportSuccessIf(frustum.IntersectsSphere(Vector3(0.0f, 0.0f, -1.0f), 2.5f), TEST_MSG("A sphere crossing the near plane was culled."));
+        uint32_t mask = Frustum::AllPlanes;
+        test.ReportSuccessIf(frustum.IntersectsSphere(Vector3(0.0f, 0.0f, 50.0f), 1.0f, mask) && mask == 0, TEST_MSG("A sphere inside every plane kept planes in its mask."));
+        mask = Frustum::AllPlanes;
+        test.ReportSuccessIf(frustum.IntersectsSphere(Vector3(0.0f, 0.0f, 1.0f), 0.5f, mask) && mask == (1u << Frustum::Near), TEST_MSG("A sphere on the near plane did not narrow its mask to the near plane."));
+        mask = Frustum::AllPlanes;
+        const AABB straddle(Vector3(40.0f, -1.0f, 45.0f), Vector3(60.0f, 1.0f, 55.0f));
+        test.ReportSuccessIf(frustum.IntersectsAABB(straddle, mask) && mask == (1u << Frustum::Right), TEST_MSG("A box on the right plane did not narrow its mask to the right plane."));
+        test.ReportSuccessIf(!frustum.IntersectsAABB(AABB(Vector3(-5.0f, -5.0f, 101.0f), Vector3(5.0f, 5.0f, 110.0f))), TEST_MSG("A box beyond the far plane was not culled."));
+        mask = Frustum::AllPlanes & ~(1u << Frustum::Far);
+        test.ReportSuccessIf(frustum.IntersectsAABB(AABB(Vector3(-5.0f, -5.0f, 101.0f), Vector3(5.0f, 5.0f, 110.0f)), mask), TEST_MSG("A box beyond the far plane was culled without testing the far plane."));
+
+        // not a multiple of four or eight, so the kernels have a tail to finish.
+        const size_t count = 203;
+        RandomGenerator rng(1234);
+        std::vector<Vector4> spheres(count);
+        std::vector<AABB> boxes(count);
+        for (size_t i = 0; i < count; ++i) {
+            Vector3 center(rng.Range(-120.0f, 120.0f), rng.Range(-120.0f, 120.0f), rng.Range(-20.0f, 120.0f));
+            spheres[i].Set(center.x, center.y, center.z, rng.Range(0.0f, 10.0f));
+            boxes[i] = AABB::FromCenterExtents(center, Vector3(rng.Range(0.0f, 10.0f), rng.Range(0.0f, 10.0f), rng.Range(0.0f, 10.0f)));
+        }
+
+        for (uint32_t planeMask : { Frustum::AllPlanes, Frustum::AllPlanes & ~(1u << Frustum::Far), 0u }) {
+            std::vector<uint32_t> sphereBits((count + 31) / 32, 0xffffffff), boxBits((count + 31) / 32, 0xffffffff);
+            std::vector<uint32_t> sphereIndices(count), boxIndices(count);
+            size_t sphereCount = frustum.CullSpheres(spheres.data(), count, sphereBits.data(), planeMask);
+            size_t boxCount = frustum.CullAABBs(boxes.data(), count, boxBits.data(), planeMask);
+            size_t sphereIndexCount = frustum.CullSpheresIndices(spheres.data(), count, sphereIndices.data(), planeMask);
+            size_t boxIndexCount = frustum.CullAABBsIndices(boxes.data(), count, boxIndices.data(), planeMask);
+
+            bool sphereMatch = sphereCount == sphereIndexCount, boxMatch = boxCount == boxIndexCount;
+            size_t expectedSpheres = 0, expectedBoxes = 0;
+            for (size_t i = 0; i < count; ++i) {
+                uint32_t sphereMask = planeMask, boxMask = planeMask;
+                bool sphereVisible = frustum.IntersectsSphere(Vector3(spheres[i]), spheres[i].w, sphereMask);
+                bool boxVisible = frustum.IntersectsAABB(boxes[i], boxMask);
+                sphereMatch = sphereMatch && (((sphereBits[i / 32] >> (i % 32)) & 1) != 0) == sphereVisible;
+                boxMatch = boxMatch && (((boxBits[i / 32] >> (i % 32)) & 1) != 0) == boxVisible;
+                if (sphereVisible) {
+                    sphereMatch = sphereMatch && expectedSpheres < sphereIndexCount && sphereIndices[expectedSpheres] == i;
+                    ++expectedSpheres;
+                }
+                if (boxVisible) {
+                    boxMatch = boxMatch && expectedBoxes < boxIndexCount && boxIndices[expectedBoxes] == i;
+                    ++expectedBoxes;
+                }
+            }
+            sphereMatch = sphereMatch && expectedSpheres == sphereCount && (sphereBits.back() >> (count % 32)) == 0;
+            boxMatch = boxMatch && expectedBoxes == boxCount && (boxBits.back() >> (count % 32)) == 0;
+            test.ReportSuccessIf(sphereMatch, TEST_MSG("CullSpheres and CullSpheresIndices did not match IntersectsSphere."));
+            test.ReportSuccessIf(boxMatch, TEST_MSG("CullAABBs and CullAABBsIndices did not match IntersectsAABB."));
+            test.ReportSuccessIf(planeMask != 0 || (sphereCount == count && boxCount == count), TEST_MSG("Culling with no planes culled something."));
+            test.ReportSuccessIf(planeMask == 0 || (sphereCount > 0 && sphereCount < count && boxCount > 0 && boxCount < count), TEST_MSG("The culling test set is not mixed."));
+        }
+    });
+}
+
+void TestRay() {
+    test("Ray", []{
+        using xo::Vector3;
+        using xo::AABB;
+        using xo::Ray;
+        using xo::RayPacket4;
+        using xo::RayPacket8;
+        using xo::RandomGenerator;
+        const float infinity = std::numeric_limits<float>::infinity();
+        auto close = [](float a, float b) { return std::abs(a - b) <= 1e-4f * (1.0f + std::abs(b)); };
+
+        const Vector3 v0(0.0f, 0.0f, 5.0f), v1(2.0f, 0.0f, 5.0f), v2(0.0f, 2.0f, 5.0f);
+        const Ray forward(Vector3(0.5f, 0.25f, 0.0f), Vector3(0.0f, 0.0f, 2.0f));
+        float t = infinity, u = 0.0f, v = 0.0f;
+        test.ReportSuccessIf(forward.IntersectTriangle(v0, v1, v2, t, u, v) && close(t, 2.5f) && close(u, 0.25f) && close(v, 0.125f), TEST_MSG("Triangle hit distance or barycentrics were wrong."));
+        test.ReportSuccessIf(forward.PointAt(t), v0 * (1.0f - u - v) + v1 * u + v2 * v, TEST_MSG("Barycentrics did not reproduce the hit point."));
+        t = 2.0f;
+        test.ReportSuccessIf(!forward.IntersectTriangle(v0, v1, v2, t, u, v) && t == 2.0f, TEST_MSG("A triangle beyond inOutT was hit."));
+        t = infinity;
+        test.ReportSuccessIf(!Ray(Vector3(1.5f, 1.5f, 0.0f), Vector3(0.0f, 0.0f, 1.0f)).IntersectTriangle(v0, v1, v2, t, u, v), TEST_MSG("A ray outside the triangle hit it."));
+        test.ReportSuccessIf(!Ray(Vector3(0.5f, 0.25f, 0.0f), Vector3(1.0f, 0.0f, 0.0f)).IntersectTriangle(v0, v1, v2, t, u, v), TEST_MSG("A ray parallel to the triangle hit it."));
+        test.ReportSuccessIf(!Ray(Vector3(0.5f, 0.25f, 6.0f), Vector3(0.0f, 0.0f, 1.0f)).IntersectTriangle(v0, v1, v2, t, u, v), TEST_MSG("A triangle behind the ray was hit."));
+
+        const AABB box(Vector3(-1.0f, -1.0f, 4.0f), Vector3(1.0f, 1.0f, 6.0f));
+        t = infinity;
+        test.ReportSuccessIf(forward.IntersectAABB(box, t) && close(t, 2.0f), TEST_MSG("Box entry distance was wrong."));
+        t = infinity;
+        test.ReportSuccessIf(Ray(Vector3(0.0f, 0.0f, 5.0f), Vector3(0.0f, 0.0f, 1.0f)).IntersectAABB(box, t) && t == 0.0f, TEST_MSG("A ray starting inside a box did not hit it at 0."));
+        t = infinity;
+        test.ReportSuccessIf(!Ray(Vector3(2.0f, 0.0f, 0.0f), Vector3(0.0f, 0.0f, 1.0f)).IntersectAABB(box, t), TEST_MSG("An axis aligned ray beside a box hit it."));
+
+        t = infinity;
+        test.ReportSuccessIf(forward.IntersectSphere(Vector3(0.5f, 0.25f, 10.0f), 1.0f, t) && close(t, 4.5f), TEST_MSG("Sphere entry distance was wrong."));
+        t = infinity;
+        test.ReportSuccessIf(forward.IntersectSphere(Vector3(0.5f, 0.25f, 0.0f), 1.0f, t) && close(t, 0.5f), TEST_MSG("A ray starting inside a sphere did not hit where it leaves."));
+        t = infinity;
+        test.ReportSuccessIf(!forward.IntersectSphere(Vector3(5.0f, 0.0f, 10.0f), 1.0f, t), TEST_MSG("A sphere beside the ray was hit."));
+
+        // Packets and the many triangle kernel against the single ray tests, over random rays aimed into a cloud of 
+        // primitives. 61 triangles is not a multiple of four or eight, so the kernel has a tail to finish.
+        RandomGenerator rng(4321);
+        const size_t triangleCount = 61;
+        std::vector<Vector3> vertices(triangleCount * 3);
+        for (size_t i = 0; i < triangleCount; ++i) {
+            const Vector3 center = RandomVector(rng, 4.0f);
+            vertices[i * 3] = center + RandomVector(rng, 2.0f);
+            vertices[i * 3 + 1] = center + RandomVector(rng, 2.0f);
+            vertices[i * 3 + 2] = center + RandomVector(rng, 2.0f);
+        }
+
+        bool manyMatch = true, packet4Match = true, packet8Match = true;
+        int hits = 0;
+        for (int trial = 0; trial < 16; ++trial) {
+            Ray rays[8];
+            for (int i = 0; i < 8; ++i) {
+                rays[i].Set(RandomVector(rng, 10.0f), RandomVector(rng, 1.0f) - rays[i].origin * 0.1f);
+            }
+
+            float expectedT = infinity, expectedU = 0.0f, expectedV = 0.0f, manyT = infinity, manyU = 0.0f, manyV = 0.0f;
+            size_t expectedIndex = 0, manyIndex = 0;
+            for (size_t i = 0; i < triangleCount; ++i) {
+                if (rays[0].IntersectTriangle(vertices[i * 3], vertices[i * 3 + 1], vertices[i * 3 + 2], expectedT, expectedU, expectedV)) {
+                    expectedIndex = i;
+                }
+            }
+            const bool manyHit = rays[0].IntersectTriangles(vertices.data(), triangleCount, manyT, manyU, manyV, manyIndex);
+            manyMatch = manyMatch && manyHit == (expectedT != infinity) &&
+                (!manyHit || (manyIndex == expectedIndex && close(manyT, expectedT) && close(manyU, expectedU) && close(manyV, expectedV)));
+            hits += manyHit;
+
+            const RayPacket4 packet4(rays);
+            const RayPacket8 packet8(rays);
+            packet8Match = packet8Match && packet8.Get(7).origin == rays[7].origin && packet8.Get(7).direction == rays[7].direction;
+            float t4[4], u4[4], v4[4], t8[8], u8[8], v8[8], ts[8], us[8], vs[8];
+            const Vector3 center = RandomVector(rng, 4.0f);
+            for (int shape = 0; shape < 3; ++shape) {
+                for (int i = 0; i < 8; ++i) {
+                    t4[i % 4] = t8[i] = ts[i] = 20.0f;
+                    u4[i % 4] = u8[i] = us[i] = v4[i % 4] = v8[i] = vs[i] = 0.0f;
+                }
+                int expected = 0, bits4 = 0, bits8 = 0;
+                for (int i = 0; i < 8; ++i) {
+                    bool hit = false;
+                    switch (shape) {
+                    case 0: hit = rays[i].IntersectTriangle(vertices[0], vertices[1], vertices[2], ts[i], us[i], vs[i]); break;
+                    case 1: hit = rays[i].IntersectAABB(AABB::FromCenterExtents(center, Vector3(3.0f)), ts[i]); break;
+                    case 2: hit = rays[i].IntersectSphere(center, 3.0f, ts[i]); break;
+                    }
+                    expected |= hit << i;
+                }
+                switch (shape) {
+                case 0:
+                    bits4 = packet4.IntersectTriangle(vertices[0], vertices[1], vertices[2], t4, u4, v4);
+                    bits8 = packet8.IntersectTriangle(vertices[0], vertices[1], vertices[2], t8, u8, v8);
+                    break;
+                case 1:
+                    bits4 = packet4.IntersectAABB(AABB::FromCenterExtents(center, Vector3(3.0f)), t4);
+                    bits8 = packet8.IntersectAABB(AABB::FromCenterExtents(center, Vector3(3.0f)), t8);
+                    break;
+                case 2:
+                    bits4 = packet4.IntersectSphere(center, 3.0f, t4);
+                    bits8 = packet8.IntersectSphere(center, 3.0f, t8);
+                    break;
+                }
+                packet4Match = packet4Match && bits4 == (expected & 15);
+                packet8Match = packet8Match && bits8 == expected;
+                for (int i = 0; i < 8; ++i) {
+                    packet8Match = packet8Match && close(t8[i], ts[i]) && close(u8[i], us[i]) && close(v8[i], vs[i]);
+                    if (i < 4) {
+                        packet4Match = packet4Match && close(t4[i], ts[i]) && close(u4[i], us[i]) && close(v4[i], vs[i]);
+                    }
+                }
+                hits += expected != 0;
+            }
+        }
+        test.ReportSuccessIf(hits > 16, TEST_MSG("Too few random rays hit anything to compare the kernels."));
+        test.ReportSuccessIf(manyMatch, TEST_MSG("IntersectTriangles did not find the same closest triangle as IntersectTriangle."));
+        test.ReportSuccessIf(packet4Match, TEST_MSG("RayPacket4 did not match the single ray tests."));
+        test.ReportSuccessIf(packet8Match, TEST_MSG("RayPacket8 did not match the single ray tests."));
+    });
+}
+
+void TestBVH() {
+    test("BVH", []{
+        using xo::Vector3;
+        using xo::Matrix4x4;
+        using xo::AABB;
+        using xo::Ray;
+        using xo::Frustum;
+        using xo::BVH;
+        using xo::RandomGenerator;
+        const float infinity = std::numeric_limits<float>::infinity();
+        RandomGenerator rng(2468);
+        auto sorted = [](std::vector<uint32_t> v, size_t count) { v.resize(count); std::sort(v.begin(), v.end()); return v; };
+        auto isPermutation = [&sorted](const BVH& bvh) {
+            std::vector<uint32_t> indices = sorted(std::vector<uint32_t>(bvh.Indices(), bvh.Indices() + bvh.PrimitiveCount()), bvh.PrimitiveCount());
+            for (size_t i = 0; i < indices.size(); ++i) {
+                if (indices[i] != i) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        // Enough boxes for the threaded build to bin the top of the tree in parallel, and not a multiple of four.
+        const size_t count = 70001;
+        std::vector<AABB> boxes(count);
+        AABB all = AABB::Empty;
+        for (size_t i = 0; i < count; ++i) {
+            boxes[i] = AABB::FromCenterExtents(RandomVector(rng, 100.0f), Vector3(rng.Range(0.0f, 1.0f), rng.Range(0.0f, 1.0f), rng.Range(0.0f, 1.0f)));
+            all.Expand(boxes[i]);
+        }
+        BVH serial, threaded;
+        serial.Build(boxes.data(), count, 1, 1);
+        threaded.Build(boxes.data(), count, 1, 4);
+        test.ReportSuccessIf(isPermutation(serial) && isPermutation(threaded), TEST_MSG("Build did not index every primitive exactly once."));
+        test.ReportSuccessIf(serial.Bounds().min == all.min && serial.Bounds().max == all.max, TEST_MSG("The root bounds were not the bounds of every primitive."));
+        test.ReportSuccessIf(serial.NodeCount() < count / 2 && threaded.NodeCount() == serial.NodeCount(), TEST_MSG("The serial and threaded builds made a different number of nodes."));
+
+        // with one primitive per leaf the queries are exact, so they must match testing every box.
+        std::vector<uint32_t> found(count), expected;
+        bool aabbMatch = true;
+        for (int trial = 0; trial < 8; ++trial) {
+            const AABB query = AABB::FromCenterExtents(RandomVector(rng, 100.0f), Vector3(10.0f));
+            expected.clear();
+            for (size_t i = 0; i < count; ++i) {
+                if (boxes[i].Overlaps(query)) {
+                    expected.push_back((uint32_t)i);
+                }
+            }
+            aabbMatch = aabbMatch && sorted(found, serial.QueryAABB(query, found.data())) == expected;
+            aabbMatch = aabbMatch && sorted(found, threaded.QueryAABB(query, found.data())) == expected;
+        }
+        test.ReportSuccessIf(aabbMatch && !expected.empty(), TEST_MSG("QueryAABB did not find exactly the overlapping boxes."));
+
+        const float n = 1.0f, f = 60.0f;
+        const Frustum frustum(Matrix4x4(
+            1.0f, 0.0f, 0.0f, 0.0f,
+            0.0f, 1.0f, 0.0f, 0.0f,
+            0.0f, 0.0f, f / (f - n), -n * f / (f - n),
+            0.0f, 0.0f, 1.0f, 0.0f));
+        expected.clear();
+        for (size_t i = 0; i < count; ++i) {
+            if (frustum.IntersectsAABB(boxes[i])) {
+                expected.push_back((uint32_t)i);
+            }
+        }
+        test.ReportSuccessIf(sorted(found, threaded.QueryFrustum(frustum, found.data())) == expected && !expected.empty(), TEST_MSG("QueryFrustum did not find exactly the visible boxes."));
+
+        // Triangles in bigger leaves, against the closest hit found by testing every triangle.
+        const size_t triangleCount = 5003;
+        std::vector<Vector3> vertices(triangleCount * 3);
+        for (size_t i = 0; i < triangleCount; ++i) {
+            const Vector3 center = RandomVector(rng, 20.0f);
+            for (int j = 0; j < 3; ++j) {
+                vertices[i * 3 + j] = center + RandomVector(rng, 1.0f);
+            }
+        }
+        BVH triangles;
+        triangles.BuildTriangles(vertices.data(), triangleCount, 4, 2);
+        auto raysMatch = [&](int trials) {
+            bool match = true;
+            int hits = 0;
+            for (int trial = 0; trial < trials; ++trial) {
+                const Vector3 origin = RandomVector(rng, 30.0f);
+                const Ray ray(origin, RandomVector(rng, 5.0f) - origin);
+                float expectedT = infinity, expectedU, expectedV, t = infinity, u, v;
+                uint32_t expectedIndex = 0, index = 0;
+                bool expectedHit = false;
+                for (size_t i = 0; i < triangleCount; ++i) {
+                    if (ray.IntersectTriangle(vertices[i * 3], vertices[i * 3 + 1], vertices[i * 3 + 2], expectedT, expectedU, expectedV)) {
+                        expectedIndex = (uint32_t)i;
+                        expectedHit = true;
+                    }
+                }
+                const bool hit = triangles.IntersectTriangles(ray, vertices.data(), t, u, v, index);
+                match = match && hit == expectedHit && (!hit || (index == expectedIndex && t == expectedT));
+                hits += hit;
+                // every triangle the ray hits is in a leaf the ray hits.
+                const size_t candidates = triangles.QueryRay(ray, infinity, found.data());
+                for (size_t i = 0; i < triangleCount && match; ++i) {
+                    float anyT = infinity;
+                    if (ray.IntersectTriangle(vertices[i * 3], vertices[i * 3 + 1], vertices[i * 3 + 2], anyT, u, v)) {
+                        match = std::find(found.begin(), found.begin() + candidates, (uint32_t)i) != found.begin() + candidates;
+                    }
+                }
+            }
+            return match && hits > trials / 4;
+        };
+        test.ReportSuccessIf(isPermutation(triangles) && raysMatch(64), TEST_MSG("IntersectTriangles or QueryRay disagreed with testing every triangle."));
+
+        for (size_t i = 0; i < triangleCount * 3; ++i) {
+            vertices[i] += Vector3(5.0f, 0.0f, 0.0f) + RandomVector(rng, 0.5f);
+        }
+        triangles.RefitTriangles(vertices.data());
+        test.ReportSuccessIf(raysMatch(64), TEST_MSG("IntersectTriangles disagreed with testing every triangle after a refit."));
+
+        BVH copy(triangles);
+        BVH moved(std::move(triangles));
+        test.ReportSuccessIf(copy.NodeCount() == moved.NodeCount() && triangles.NodeCount() == 0 && 
+            memcmp(copy.Nodes(), moved.Nodes(), copy.NodeCount() * sizeof(BVH::Node)) == 0, TEST_MSG("Copying or moving a BVH lost its nodes."));
+
+        // primitives SAH can't separate still build, and one primitive per leaf is honored.
+        std::vector<AABB> same(100, AABB(Vector3(1.0f), Vector3(2.0f)));
+        BVH stacked;
+        stacked.Build(same.data(), same.size(), 1);
+        test.ReportSuccessIf(isPermutation(stacked) && stacked.QueryAABB(AABB(Vector3(0.0f), Vector3(1.0f)), found.data()) == 100, TEST_MSG("Identical primitives were not all found."));
+        stacked.Build(same.data(), 0);
+        test.ReportSuccessIf(stacked.NodeCount() == 0 && stacked.QueryAABB(same[0], found.data()) == 0, TEST_MSG("An empty BVH found something."));
+    });
+}
+
+void TestBoundingSphere() {
+    test("BoundingSphere", []{
+        using xo::Vector3;
+        using xo::BoundingSphere;
+        using xo::RandomGenerator;
+        RandomGenerator rng(1357);
+        auto holdsAll = [](const BoundingSphere& sphere, const std::vector<Vector3>& points) {
+            const float limit = sphere.radius * 1.00001f;
+            for (const Vector3& p : points) {
+                if (Vector3::DistanceSquared(sphere.center, p) > limit * limit) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        // A stretched cloud with enough points to be split between threads, and not a multiple of eight.
+        const size_t count = 300001;
+        std::vector<Vector3> points(count);
+        for (size_t i = 0; i < count; ++i) {
+            points[i].Set(rng.Range(-40.0f, 40.0f), rng.Range(-10.0f, 10.0f), rng.Range(-20.0f, 20.0f));
+        }
+        const BoundingSphere exact = BoundingSphere::FromPointsExact(points.data(), count);
+        const BoundingSphere epos = BoundingSphere::FromPoints(points.data(), count, 1);
+        const BoundingSphere ritter = BoundingSphere::FromPointsRitter(points.data(), count, 1);
+        const BoundingSphere threaded = BoundingSphere::FromPoints(points.data(), count, 4);
+        test.ReportSuccessIf(holdsAll(exact, points), TEST_MSG("FromPointsExact leaves a point outside"));
+        test.ReportSuccessIf(holdsAll(epos, points), TEST_MSG("FromPoints leaves a point outside"));
+        test.ReportSuccessIf(holdsAll(ritter, points), TEST_MSG("FromPointsRitter leaves a point outside"));
+        test.ReportSuccessIf(holdsAll(threaded, points), TEST_MSG("threaded FromPoints leaves a point outside"));
+        test.ReportSuccessIf(exact.radius <= epos.radius && exact.radius <= ritter.radius && exact.radius <= threaded.radius, TEST_MSG("a fit is smaller than the smallest sphere"));
+        test.ReportSuccessIf(epos.radius < exact.radius * 1.05f, TEST_MSG("FromPoints isn't within 5% of the smallest sphere"));
+
+        // The corners of a cube among points inside it. The smallest sphere passes through the corners, which are 
+        // also the extremes along the diagonals.
+        std::vector<Vector3> cube(1000);
+        for (size_t i = 0; i < cube.size(); ++i) {
+            cube[i] = i < 8 ? Vector3(i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f, i & 4 ? 1.0f : -1.0f) : Vector3(rng.Range(-1.0f, 1.0f), rng.Range(-1.0f, 1.0f), rng.Range(-1.0f, 1.0f));
+        }
+        std::swap(cube[3], cube[500]);
+        const BoundingSphere cubeExact = BoundingSphere::FromPointsExact(cube.data(), cube.size());
+        const BoundingSphere cubeEpos = BoundingSphere::FromPoints(cube.data(), cube.size());
+        test.ReportSuccessIf(cubeExact.center, Vector3::Zero, TEST_MSG("FromPointsExact missed the center of a cube"));
+        test.ReportSuccessIf(cubeExact.radius, xo::Sqrt(3.0f), TEST_MSG("FromPointsExact missed the radius of a cube"));
+        test.ReportSuccessIf(xo::CloseEnough(cubeEpos.radius, xo::Sqrt(3.0f), 1e-4f), TEST_MSG("FromPoints missed the corners of a cube"));
+
+        const Vector3 lone(1.0f, 2.0f, 3.0f);
+        const BoundingSphere single = BoundingSphere::FromPoints(&lone, 1);
+        test.ReportSuccessIf(single.center == lone && single.radius == 0.0f, TEST_MSG("a single point isn't its own sphere"));
+        test.ReportSuccessIf(BoundingSphere::FromPoints(points.data(), 0).IsEmpty() && BoundingSphere::FromPointsExact(points.data(), 0).IsEmpty(), TEST_MSG("no points isn't empty"));
+
+        BoundingSphere grown = BoundingSphere::Empty;
+        grown.Expand(Vector3(-1.0f, 0.0f, 0.0f)).Expand(Vector3(3.0f, 0.0f, 0.0f));
+        test.ReportSuccessIf(grown.center, Vector3(1.0f, 0.0f, 0.0f), TEST_MSG("Expand by a point"));
+        test.ReportSuccessIf(grown.radius, 2.0f, TEST_MSG("Expand by a point"));
+        grown.Expand(BoundingSphere(Vector3(0.0f, 0.0f, 6.0f), 1.0f));
+        test.ReportSuccessIf(grown.Contains(BoundingSphere(Vector3(0.0f, 0.0f, 6.0f), 1.0f)) && grown.Contains(Vector3(3.0f, 0.0f, 0.0f)), TEST_MSG("Expand by a sphere"));
+        test.ReportSuccessIf(!grown.Contains(BoundingSphere(Vector3(0.0f, 0.0f, 20.0f), 1.0f)) && !BoundingSphere::Empty.Contains(Vector3::Zero), TEST_MSG("Contains"));
+        const BoundingSphere a(Vector3::Zero, 1.0f), b(Vector3(3.0f, 0.0f, 0.0f), 2.0f), c(Vector3(3.0f, 0.1f, 0.0f), 1.9f);
+        test.ReportSuccessIf(a.Overlaps(b) && !a.Overlaps(c) && !a.Overlaps(BoundingSphere::Empty), TEST_MSG("Overlaps"));
+    });
+}
+
+void TestPlane() {
+    test("Plane", []{
+        using xo::Vector3;
+        using xo::Vector4;
+        using xo::Matrix4x4;
+        using xo::Plane;
+        using xo::PlaneSide;
+        using xo::Vector3Stream;
+        using xo::RandomGenerator;
+        RandomGenerator rng(9753);
+
+        const Plane up = Plane::FromPoints(Vector3(0.0f, 0.0f, 1.0f), Vector3(1.0f, 0.0f, 1.0f), Vector3(0.0f, 1.0f, 1.0f));
+        test.ReportSuccessIf(up.normal, Vector3(0.0f, 0.0f, 1.0f), TEST_MSG("FromPoints has the wrong normal"));
+        test.ReportSuccessIf(up.d, -1.0f, TEST_MSG("FromPoints has the wrong distance term"));
+        test.ReportSuccessIf(up.SignedDistance(Vector3(5.0f, -3.0f, 4.0f)), 3.0f, TEST_MSG("SignedDistance"));
+        test.ReportSuccessIf(up.ClosestPoint(Vector3(5.0f, -3.0f, -4.0f)), Vector3(5.0f, -3.0f, 1.0f), TEST_MSG("ClosestPoint"));
+        test.ReportSuccessIf(up.Classify(Vector3(0.0f, 0.0f, 1.05f)) == PlaneSide::Front && up.Classify(Vector3(0.0f, 0.0f, 0.95f)) == PlaneSide::Back && 
+                             up.Classify(Vector3(0.0f, 0.0f, 1.05f), 0.1f) == PlaneSide::On, TEST_MSG("Classify"));
+        const Plane scaled = Plane(Vector3(0.0f, 0.0f, 2.0f), -2.0f).Normalized();
+        test.ReportSuccessIf(scaled.normal == up.normal && scaled.d == up.d, TEST_MSG("Normalize"));
+        const Plane fromVector(Vector4(0.0f, 0.0f, 1.0f, -1.0f));
+        test.ReportSuccessIf(fromVector.ToVector4(), Vector4(0.0f, 0.0f, 1.0f, -1.0f), TEST_MSG("Vector4 round trip"));
+
+        // Points on the plane stay on it and points in front stay in front, under a transform that doesn't keep angles. 
+        // The factories build matrices for row vectors, transposed they transform points as TransformPoints does.
+        const Matrix4x4 m = (Matrix4x4::Scale(1.0f, 2.0f, 0.5f) * Matrix4x4::AxisAngleRadians(Vector3(1.0f, 1.0f, 0.0f).Normalized(), 0.7f) * Matrix4x4::Translation(1.0f, -2.0f, 3.0f)).Transposed();
+        const Plane slanted = Plane::FromPointNormal(Vector3(0.5f, 0.0f, 0.0f), Vector3(1.0f, 2.0f, -1.0f).Normalized());
+        Vector3 onAndFront[3] = { Vector3(0.5f, 1.0f, 2.0f), Vector3(-1.5f, 0.0f, -2.0f), Vector3(0.5f, 0.0f, 0.0f) + slanted.normal };
+        const Plane moved = slanted.Transformed(m);
+        m.TransformPoints(onAndFront, 3);
+        test.ReportSuccessIf(xo::Abs(moved.SignedDistance(onAndFront[0])) < 1e-5f && xo::Abs(moved.SignedDistance(onAndFront[1])) < 1e-5f, TEST_MSG("Transform moved points off the plane"));
+        test.ReportSuccessIf(moved.SignedDistance(onAndFront[2]) > 0.1f && moved.normal.IsNormalized(), TEST_MSG("Transform flipped or didn't normalize the plane"));
+
+        // Not a multiple of eight, so both kernels have a partial last group.
+        const size_t count = 1003;
+        std::vector<Vector3> points(count);
+        for (size_t i = 0; i < count; ++i) {
+            points[i].Set(rng.Range(-10.0f, 10.0f), rng.Range(-10.0f, 10.0f), rng.Range(-10.0f, 10.0f));
+        }
+        const Vector3Stream stream(points.data(), count);
+        std::vector<float> distances(count + 1, 123.0f), streamDistances(count + 1, 123.0f);
+        slanted.SignedDistances(points.data(), count, distances.data());
+        slanted.SignedDistances(stream, streamDistances.data());
+        std::vector<PlaneSide> sides(count + 1, (PlaneSide)7), streamSides(count + 1, (PlaneSide)7);
+        const PlaneSide all = slanted.ClassifyPoints(points.data(), count, sides.data(), 0.5f);
+        const PlaneSide streamAll = slanted.ClassifyPoints(stream, streamSides.data(), 0.5f);
+        bool distancesMatch = true, sidesMatch = true;
+        for (size_t i = 0; i < count; ++i) {
+            const float expected = slanted.SignedDistance(points[i]);
+            distancesMatch &= xo::Abs(distances[i] - expected) < 1e-5f && xo::Abs(streamDistances[i] - expected) < 1e-5f;
+            sidesMatch &= sides[i] == slanted.Classify(points[i], 0.5f) && streamSides[i] == sides[i];
+        }
+        test.ReportSuccessIf(distancesMatch && distances[count] == 123.0f && streamDistances[count] == 123.0f, TEST_MSG("SignedDistances doesn't match SignedDistance"));
+        test.ReportSuccessIf(sidesMatch && sides[count] == (PlaneSide)7 && streamSides[count] == (PlaneSide)7, TEST_MSG("ClassifyPoints doesn't match Classify"));
+        test.ReportSuccessIf(all == PlaneSide::Straddling && streamAll == PlaneSide::Straddling && slanted.ClassifyPoints(points.data(), count) == PlaneSide::Straddling, TEST_MSG("a cloud around the plane doesn't straddle it"));
+
+        // One side, with the odd point on the plane.
+        std::vector<Vector3> above(count);
+        for (size_t i = 0; i < count; ++i) {
+            above[i] = i % 7 ? Vector3(rng.Range(-10.0f, 10.0f), rng.Range(-10.0f, 10.0f), rng.Range(1.5f, 10.0f)) : Vector3(rng.Range(-10.0f, 10.0f), rng.Range(-10.0f, 10.0f), 1.0f);
+        }
+        test.ReportSuccessIf(up.ClassifyPoints(above.data(), count, nullptr, 0.001f) == PlaneSide::Front && up.ClassifyPoints(Vector3Stream(above.data(), count)) == PlaneSide::Front, TEST_MSG("points above aren't in front"));
+        test.ReportSuccessIf(Plane(-up.normal, -up.d).ClassifyPoints(above.data(), count, nullptr, 0.001f) == PlaneSide::Back, TEST_MSG("points below aren't behind"));
+        test.ReportSuccessIf(up.ClassifyPoints(above.data(), 1) == PlaneSide::On && up.ClassifyPoints(above.data(), 0) == PlaneSide::On, TEST_MSG("points on the plane aren't on it"));
+    });
+}
+
+void TestSegment() {
+    test("Segment", []{
+        using xo::Vector3;
+        using xo::Segment;
+        using xo::Vector3Stream;
+        using xo::RandomGenerator;
+        RandomGenerator rng(8642);
+
+        const Segment s(Vector3(0.0f, 0.0f, 0.0f), Vector3(10.0f, 0.0f, 0.0f));
+        test.ReportSuccessIf(s.ClosestPoint(Vector3(4.0f, 3.0f, -2.0f)), Vector3(4.0f, 0.0f, 0.0f), TEST_MSG("ClosestPoint inside the segment"));
+        test.ReportSuccessIf(s.ClosestPoint(Vector3(-4.0f, 3.0f, 0.0f)), Vector3(0.0f, 0.0f, 0.0f), TEST_MSG("ClosestPoint before the start"));
+        test.ReportSuccessIf(s.ClosestPoint(Vector3(14.0f, 3.0f, 0.0f)), Vector3(10.0f, 0.0f, 0.0f), TEST_MSG("ClosestPoint past the end"));
+        const Segment point(Vector3(1.0f, 2.0f, 3.0f), Vector3(1.0f, 2.0f, 3.0f));
+        test.ReportSuccessIf(point.ClosestPoint(Vector3(5.0f, 5.0f, 5.0f)), Vector3(1.0f, 2.0f, 3.0f), TEST_MSG("ClosestPoint on a point segment"));
+
+        Vector3 a, b;
+        float d = s.ClosestPoints(Segment(Vector3(3.0f, -5.0f, 2.0f), Vector3(3.0f, 5.0f, 2.0f)), a, b);
+        test.ReportSuccessIf(a == Vector3(3.0f, 0.0f, 0.0f) && b == Vector3(3.0f, 0.0f, 2.0f) && d == 4.0f, TEST_MSG("crossing segments"));
+        d = s.ClosestPoints(Segment(Vector3(12.0f, 1.0f, 0.0f), Vector3(15.0f, 1.0f, 0.0f)), a, b);
+        test.ReportSuccessIf(a == Vector3(10.0f, 0.0f, 0.0f) && b == Vector3(12.0f, 1.0f, 0.0f) && d == 5.0f, TEST_MSG("parallel segments apart"));
+        d = s.ClosestPoints(Segment(Vector3(2.0f, 1.0f, 0.0f), Vector3(5.0f, 1.0f, 0.0f)), a, b);
+        test.ReportSuccessIf(d == 1.0f && a.y == 0.0f && b.y == 1.0f && xo::Abs(a.x - b.x) < 1e-5f, TEST_MSG("overlapping parallel segments"));
+        d = point.ClosestPoints(s, a, b);
+        test.ReportSuccessIf(a == point.start && b == Vector3(1.0f, 0.0f, 0.0f) && d == 13.0f, TEST_MSG("point segment against a segment"));
+        d = point.ClosestPoints(point, a, b);
+        test.ReportSuccessIf(a == point.start && b == point.start && d == 0.0f, TEST_MSG("two point segments"));
+
+        // Not a multiple of eight, so the kernels have a partial last group. Every 13th segment is a point, and every 
+        // 17th pair is parallel.
+        const size_t count = 1003;
+        std::vector<Vector3> points(count), starts(count), ends(count), starts2(count), ends2(count);
+        for (size_t i = 0; i < count; ++i) {
+            points[i].Set(rng.Range(-10.0f, 10.0f), rng.Range(-10.0f, 10.0f), rng.Range(-10.0f, 10.0f));
+            starts[i].Set(rng.Range(-10.0f, 10.0f), rng.Range(-10.0f, 10.0f), rng.Range(-10.0f, 10.0f));
+            ends[i] = i % 13 ? Vector3(rng.Range(-10.0f, 10.0f), rng.Range(-10.0f, 10.0f), rng.Range(-10.0f, 10.0f)) : starts[i];
+            starts2[i].Set(rng.Range(-10.0f, 10.0f), rng.Range(-10.0f, 10.0f), rng.Range(-10.0f, 10.0f));
+            ends2[i] = i % 17 ? Vector3(rng.Range(-10.0f, 10.0f), rng.Range(-10.0f, 10.0f), rng.Range(-10.0f, 10.0f)) : starts2[i] + (ends[i] - starts[i]) * 0.5f;
+        }
+        const Vector3Stream pointStream(points.data(), count), startStream(starts.data(), count), endStream(ends.data(), count);
+        const Vector3Stream start2Stream(starts2.data(), count), end2Stream(ends2.data(), count);
+        Vector3Stream closest, closest1, closest2;
+        std::vector<float> distances(count + 1, 123.0f), pairDistances(count + 1, 123.0f);
+        Segment::ClosestPoints(pointStream, startStream, endStream, closest, distances.data());
+        Segment::ClosestPoints(startStream, endStream, start2Stream, end2Stream, closest1, closest2, pairDistances.data());
+        bool pointsMatch = true, pairsMatch = true;
+        for (size_t i = 0; i < count; ++i) {
+            const Segment first(starts[i], ends[i]), second(starts2[i], ends2[i]);
+            const Vector3 expected = first.ClosestPoint(points[i]);
+            pointsMatch &= xo::Abs(distances[i] - Vector3::DistanceSquared(points[i], expected)) < 1e-3f && 
+                           Vector3::DistanceSquared(closest.Get(i), expected) < 1e-6f;
+            // parallel pairs have many closest pairs, so the points only have to be on the segments the right distance apart.
+            const float expectedDistance = first.ClosestPoints(second, a, b);
+            pairsMatch &= xo::Abs(pairDistances[i] - expectedDistance) < 1e-3f && 
+                          xo::Abs(Vector3::DistanceSquared(closest2.Get(i), closest1.Get(i)) - expectedDistance) < 1e-3f &&
+                          Vector3::DistanceSquared(first.ClosestPoint(closest1.Get(i)), closest1.Get(i)) < 1e-6f &&
+                          Vector3::DistanceSquared(second.ClosestPoint(closest2.Get(i)), closest2.Get(i)) < 1e-6f;
+        }
+        test.ReportSuccessIf(pointsMatch && distances[count] == 123.0f, TEST_MSG("the point kernel doesn't match ClosestPoint"));
+        test.ReportSuccessIf(pairsMatch && pairDistances[count] == 123.0f, TEST_MSG("the pair kernel doesn't match ClosestPoints"));
+    });
+}
+
+void TestTriangle() {
+    test("Triangle", []{
+        using xo::Vector3;
+        using xo::Triangle;
+        using xo::Vector3Stream;
+        using xo::RandomGenerator;
+        RandomGenerator rng(7531);
+
+        // One point in each of the seven regions around the triangle.
+        const Triangle t(Vector3(0.0f, 0.0f, 0.0f), Vector3(4.0f, 0.0f, 0.0f), Vector3(0.0f, 4.0f, 0.0f));
+        test.ReportSuccessIf(t.ClosestPoint(Vector3(1.0f, 1.0f, 5.0f)), Vector3(1.0f, 1.0f, 0.0f), TEST_MSG("face region"));
+        test.ReportSuccessIf(t.ClosestPoint(Vector3(-1.0f, -1.0f, 1.0f)), t.v0, TEST_MSG("v0 region"));
+        test.ReportSuccessIf(t.ClosestPoint(Vector3(6.0f, -1.0f, 1.0f)), t.v1, TEST_MSG("v1 region"));
+        test.ReportSuccessIf(t.ClosestPoint(Vector3(-1.0f, 6.0f, 1.0f)), t.v2, TEST_MSG("v2 region"));
+        test.ReportSuccessIf(t.ClosestPoint(Vector3(2.0f, -3.0f, 1.0f)), Vector3(2.0f, 0.0f, 0.0f), TEST_MSG("v0 v1 edge region"));
+        test.ReportSuccessIf(t.ClosestPoint(Vector3(-3.0f, 2.0f, 1.0f)), Vector3(0.0f, 2.0f, 0.0f), TEST_MSG("v0 v2 edge region"));
+        test.ReportSuccessIf(t.ClosestPoint(Vector3(3.0f, 3.0f, 1.0f)), Vector3(2.0f, 2.0f, 0.0f), TEST_MSG("v1 v2 edge region"));
+
+        // Random triangles around random points reach every region, as do the kernels' partial last group.
+        const size_t count = 1003;
+        std::vector<Vector3> points(count), v0(count), v1(count), v2(count);
+        for (size_t i = 0; i < count; ++i) {
+            points[i].Set(rng.Range(-10.0f, 10.0f), rng.Range(-10.0f, 10.0f), rng.Range(-10.0f, 10.0f));
+            v0[i].Set(rng.Range(-10.0f, 10.0f), rng.Range(-10.0f, 10.0f), rng.Range(-10.0f, 10.0f));
+            v1[i].Set(rng.Range(-10.0f, 10.0f), rng.Range(-10.0f, 10.0f), rng.Range(-10.0f, 10.0f));
+            v2[i].Set(rng.Range(-10.0f, 10.0f), rng.Range(-10.0f, 10.0f), rng.Range(-10.0f, 10.0f));
+        }
+        Vector3Stream closest;
+        std::vector<float> distances(count + 1, 123.0f);
+        Triangle::ClosestPoints(Vector3Stream(points.data(), count), Vector3Stream(v0.data(), count), Vector3Stream(v1.data(), count), 
+                                Vector3Stream(v2.data(), count), closest, distances.data());
+        bool match = true;
+        for (size_t i = 0; i < count; ++i) {
+            const Vector3 expected = Triangle(v0[i], v1[i], v2[i]).ClosestPoint(points[i]);
+            match &= Vector3::DistanceSquared(closest.Get(i), expected) < 1e-6f && 
+                     xo::Abs(distances[i] - Vector3::DistanceSquared(points[i], expected)) < 1e-3f;
+        }
+        test.ReportSuccessIf(match && distances[count] == 123.0f, TEST_MSG("the kernel doesn't match ClosestPoint"));
+    });
+}
+
+void TestOBB() {
+    test("OBB", []{
+        using xo::Vector3;
+        using xo::AABB;
+        using xo::OBB;
+        using xo::Vector3Stream;
+        using xo::RandomGenerator;
+        RandomGenerator rng(6420);
+
+        const AABB box(Vector3(-1.0f, -2.0f, -3.0f), Vector3(1.0f, 2.0f, 3.0f));
+        test.ReportSuccessIf(box.ClosestPoint(Vector3(0.5f, -1.0f, 2.0f)), Vector3(0.5f, -1.0f, 2.0f), TEST_MSG("AABB::ClosestPoint inside"));
+        test.ReportSuccessIf(box.ClosestPoint(Vector3(5.0f, -1.0f, -9.0f)), Vector3(1.0f, -1.0f, -3.0f), TEST_MSG("AABB::ClosestPoint outside"));
+        test.ReportSuccessIf(box.DistanceSquared(Vector3(0.5f, -1.0f, 2.0f)) == 0.0f && box.DistanceSquared(Vector3(5.0f, -1.0f, -9.0f)) == 52.0f, 
+                             TEST_MSG("AABB::DistanceSquared"));
+
+        // The box turned 90 degrees about z, so its 2 wide side now lies along x.
+        const OBB turned(Vector3(10.0f, 0.0f, 0.0f), Vector3::UnitY, -Vector3::UnitX, Vector3::UnitZ, Vector3(1.0f, 2.0f, 3.0f));
+        test.ReportSuccessIf(turned.ClosestPoint(Vector3(11.5f, 0.5f, 0.0f)), Vector3(11.5f, 0.5f, 0.0f), TEST_MSG("OBB::ClosestPoint inside"));
+        test.ReportSuccessIf(turned.ClosestPoint(Vector3(15.0f, 5.0f, 4.0f)), Vector3(12.0f, 1.0f, 3.0f), TEST_MSG("OBB::ClosestPoint outside"));
+        test.ReportSuccessIf(turned.DistanceSquared(Vector3(15.0f, 5.0f, 4.0f)) == 26.0f, TEST_MSG("OBB::DistanceSquared"));
+        const OBB unturned(box);
+        test.ReportSuccessIf(unturned.ClosestPoint(Vector3(5.0f, -1.0f, -9.0f)), Vector3(1.0f, -1.0f, -3.0f), TEST_MSG("OBB from an AABB"));
+
+        // Points inside and outside a box at an angle. Not a multiple of eight, so the kernels have a partial last group.
+        const Vector3 axisX = Vector3(1.0f, 1.0f, 0.0f).Normalized(), axisY = Vector3(-1.0f, 1.0f, 1.0f).Normalized();
+        const OBB slanted(Vector3(1.0f, -2.0f, 0.5f), axisX, axisY, axisX.Cross(axisY), Vector3(3.0f, 2.0f, 1.0f));
+        const size_t count = 1003;
+        std::vector<Vector3> points(count);
+        for (size_t i = 0; i < count; ++i) {
+            points[i].Set(rng.Range(-6.0f, 6.0f), rng.Range(-6.0f, 6.0f), rng.Range(-6.0f, 6.0f));
+        }
+        const Vector3Stream stream(points.data(), count);
+        Vector3Stream closest, boxClosest;
+        std::vector<float> distances(count + 1, 123.0f), boxDistances(count + 1, 123.0f);
+        slanted.ClosestPoints(stream, closest, distances.data());
+        box.ClosestPoints(stream, boxClosest, boxDistances.data());
+        bool match = true, boxMatch = true;
+        size_t inside = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const Vector3 expected = slanted.ClosestPoint(points[i]);
+            match &= Vector3::DistanceSquared(closest.Get(i), expected) < 1e-6f && xo::Abs(distances[i] - slanted.DistanceSquared(points[i])) < 1e-3f;
+            boxMatch &= boxClosest.Get(i) == box.ClosestPoint(points[i]) && xo::Abs(boxDistances[i] - box.DistanceSquared(points[i])) < 1e-3f;
+            inside += distances[i] == 0.0f;
+        }
+        test.ReportSuccessIf(match && distances[count] == 123.0f, TEST_MSG("the OBB kernel doesn't match ClosestPoint"));
+        test.ReportSuccessIf(boxMatch && boxDistances[count] == 123.0f, TEST_MSG("the AABB kernel doesn't match ClosestPoint"));
+        test.ReportSuccessIf(inside > 0 && inside < count, TEST_MSG("the points weren't both inside and outside the box"));
+    });
+}
+
+void TestSpatialHashGrid() {
+    test("SpatialHashGrid", []{
+        using xo::Vector3;
+        using xo::Vector3Stream;
+        using xo::SpatialHashGrid;
+        using xo::RandomGenerator;
+        RandomGenerator rng(5318);
+
+        SpatialHashGrid grid;
+        uint32_t none[1];
+        test.ReportSuccessIf(grid.QueryRadius(Vector3(0.0f), 10.0f, none) == 0, TEST_MSG("an empty grid found points"));
+
+        // A cloud with points on top of each other, far away and at negative coordinates, so cells hash together.
+        const size_t count = 1003;
+        std::vector<Vector3> points(count);
+        for (size_t i = 0; i < count; ++i) {
+            points[i].Set(rng.Range(-10.0f, 10.0f), rng.Range(-10.0f, 10.0f), rng.Range(-10.0f, 10.0f));
+        }
+        points[5] = points[6] = points[7];
+        points[100].Set(1e6f, -1e6f, 3.5f);
+        points[101].Set(1e6f + 0.25f, -1e6f, 3.5f);
+        grid.Build(points.data(), count, 1.0f);
+        test.ReportSuccessIf(grid.PointCount() == count && grid.BucketCount() >= count && grid.BucketStarts()[grid.BucketCount()] == count, TEST_MSG("bad table size"));
+
+        // Every query must find exactly the points brute force does.
+        std::vector<uint32_t> found(count), expected;
+        auto matches = [&](const SpatialHashGrid& g, const Vector3& center, float radius) {
+            const size_t n = g.QueryRadius(center, radius, found.data());
+            expected.clear();
+            for (size_t i = 0; i < count; ++i) {
+                if (Vector3::DistanceSquared(points[i], center) <= radius * radius) {
+                    expected.push_back((uint32_t)i);
+                }
+            }
+            std::sort(found.begin(), found.begin() + n);
+            return n == expected.size() && std::equal(expected.begin(), expected.end(), found.begin());
+        };
+        bool allMatch = true;
+        const float radii[] = { 0.0f, 0.3f, 1.0f, 2.5f, 6.0f, 40.0f };
+        for (int r = 0; r < 6; ++r) {
+            for (int q = 0; q < 50; ++q) {
+                const Vector3 center = q % 10 ? Vector3(rng.Range(-11.0f, 11.0f), rng.Range(-11.0f, 11.0f), rng.Range(-11.0f, 11.0f)) : points[q];
+                allMatch &= matches(grid, center, radii[r]);
+            }
+        }
+        test.ReportSuccessIf(allMatch, TEST_MSG("QueryRadius doesn't match brute force"));
+        test.ReportSuccessIf(matches(grid, points[7], 0.0f) && expected.size() >= 3, TEST_MSG("points on top of each other weren't all found"));
+        test.ReportSuccessIf(matches(grid, Vector3(1e6f, -1e6f, 3.5f), 0.5f) && expected.size() == 2, TEST_MSG("far away points weren't found"));
+        test.ReportSuccessIf(grid.QueryRadius(Vector3(0.0f), -1.0f, found.data()) == 0, TEST_MSG("a negative radius found points"));
+
+        const SpatialHashGrid copy(grid);
+        SpatialHashGrid moved(std::move(grid));
+        test.ReportSuccessIf(matches(copy, points[10], 2.0f) && matches(moved, points[10], 2.0f) && grid.PointCount() == 0, TEST_MSG("copy or move"));
+
+        // The grid doesn't depend on the number of threads that built it, or on whether it was built from a stream.
+        const size_t manyCount = 200003;
+        std::vector<Vector3> many(manyCount);
+        for (size_t i = 0; i < manyCount; ++i) {
+            many[i].Set(rng.Range(-50.0f, 50.0f), rng.Range(-50.0f, 50.0f), rng.Range(-50.0f, 50.0f));
+        }
+        SpatialHashGrid serial, threaded, streamed;
+        serial.Build(many.data(), manyCount, 2.0f, 1);
+        threaded.Build(many.data(), manyCount, 2.0f, 8);
+        streamed.Build(Vector3Stream(many.data(), manyCount), 2.0f, 3);
+        const size_t buckets = serial.BucketCount();
+        test.ReportSuccessIf(threaded.BucketCount() == buckets && streamed.BucketCount() == buckets &&
+                             std::equal(serial.BucketStarts(), serial.BucketStarts() + buckets + 1, threaded.BucketStarts()) &&
+                             std::equal(serial.Indices(), serial.Indices() + manyCount, threaded.Indices()) &&
+                             std::equal(serial.Indices(), serial.Indices() + manyCount, streamed.Indices()), TEST_MSG("threaded builds differ"));
+
+        // A radius over many cells, which tracks the buckets it has seen with a bit each.
+        std::vector<uint32_t> manyFound(manyCount);
+        const Vector3 center(3.0f, -4.0f, 5.0f);
+        size_t inside = 0;
+        for (size_t i = 0; i < manyCount; ++i) {
+            inside += Vector3::DistanceSquared(many[i], center) <= 81.0f;
+        }
+        const size_t n = threaded.QueryRadius(center, 9.0f, manyFound.data());
+        std::sort(manyFound.begin(), manyFound.begin() + n);
+        test.ReportSuccessIf(n == inside && std::unique(manyFound.begin(), manyFound.begin() + n) == manyFound.begin() + n, TEST_MSG("a wide query found the wrong points"));
+        // With the caller's own scratch, twice, which would miss buckets the first query left marked.
+        std::vector<uint32_t> scratch(threaded.QueryScratchSize());
+        const bool withScratch = threaded.QueryRadius(center, 9.0f, manyFound.data(), scratch.data()) == inside;
+        const bool again = threaded.QueryRadius(center, 9.0f, manyFound.data(), scratch.data()) == inside;
+        test.ReportSuccessIf(again && withScratch && std::all_of(scratch.begin(), scratch.end(), [](uint32_t w) { return w == 0; }), TEST_MSG("wide queries don't clear their scratch"));
+        // Wide queries without scratch from several threads at once.
+        std::vector<uint32_t> otherFound(manyCount);
+        size_t concurrent[2] = { 0, 0 };
+        std::thread other([&]{
+            for (int q = 0; q < 20; ++q) {
+                concurrent[1] += threaded.QueryRadius(center, 9.0f, otherFound.data()) == inside;
+            }
+        });
+        for (int q = 0; q < 20; ++q) {
+            concurrent[0] += threaded.QueryRadius(center, 9.0f, manyFound.data()) == inside;
+        }
+        other.join();
+        test.ReportSuccessIf(concurrent[0] == 20 && concurrent[1] == 20, TEST_MSG("concurrent wide queries lost points"));
+
+        // Rebuilding over fewer points reuses the arrays.
+        serial.Build(points.data(), count, 1.0f, 1);
+        test.ReportSuccessIf(matches(serial, points[20], 1.5f), TEST_MSG("rebuilding over fewer points"));
+    });
+}
+
+void TestGJK() {
+    test("GJK", []{
+        using xo::Vector3;
+        using xo::AABB;
+        using xo::OBB;
+        using xo::BoundingSphere;
+        using xo::Segment;
+        using xo::GJK;
+        using xo::RandomGenerator;
+        RandomGenerator rng(4242);
+
+        Vector3 pointA, pointB;
+        const AABB box(Vector3(-1.0f), Vector3(1.0f)), right(Vector3(2.0f, -0.5f, -0.5f), Vector3(4.0f, 0.5f, 0.5f));
+        test.ReportSuccessIf(GJK::Distance(box, right, pointA, pointB), 1.0f, TEST_MSG("distance between boxes"));
+        test.ReportSuccessIf(pointA.x == 1.0f && pointB.x == 2.0f && pointA.y == pointB.y && pointA.z == pointB.z, TEST_MSG("closest points of boxes"));
+        test.ReportSuccessIf(!GJK::Intersects(box, right) && GJK::Intersects(box, AABB(Vector3(0.5f), Vector3(3.0f))), TEST_MSG("Intersects boxes"));
+
+        const BoundingSphere sphere(Vector3(0.0f), 1.0f), sphere2(Vector3(3.0f, 1.0f, 0.5f), 0.5f);
+        const float expected = Vector3(3.0f, 1.0f, 0.5f).Magnitude() - 1.5f;
+        test.ReportSuccessIf(xo::Abs(GJK::Distance(sphere, sphere2, pointA, pointB) - expected) < 1e-4f && xo::Abs(pointA.Magnitude() - 1.0f) < 1e-4f, 
+                             TEST_MSG("distance between spheres"));
+
+        // Segments have an exact answer in Segment::ClosestPoints, and capsules are segments grown by their radius.
+        bool segmentsMatch = true, capsulesMatch = true;
+        for (int i = 0; i < 200; ++i) {
+            const Segment s1(RandomVector(rng, 5.0f), RandomVector(rng, 5.0f)), s2(RandomVector(rng, 5.0f), RandomVector(rng, 5.0f));
+            Vector3 exactA, exactB;
+            const float exact = xo::Sqrt(s1.ClosestPoints(s2, exactA, exactB));
+            const float distance = GJK::Distance(s1, s2, pointA, pointB);
+            segmentsMatch &= xo::Abs(distance - exact) < 1e-3f && (pointA - pointB).Magnitude() - distance < 1e-3f && 
+                             Vector3::DistanceSquared(s1.ClosestPoint(pointA), pointA) < 1e-5f && Vector3::DistanceSquared(s2.ClosestPoint(pointB), pointB) < 1e-5f;
+            const float r1 = rng.Range(0.1f, 1.0f), r2 = rng.Range(0.1f, 1.0f);
+            const GJK::Rounded<Segment> capsule1(s1, r1), capsule2(s2, r2);
+            capsulesMatch &= xo::Abs(GJK::Distance(capsule1, capsule2, pointA, pointB) - xo::Max(exact - r1 - r2, 0.0f)) < 2e-3f &&
+                             GJK::Intersects(capsule1, capsule2) == (exact < r1 + r2);
+        }
+        test.ReportSuccessIf(segmentsMatch, TEST_MSG("segment distances don't match Segment::ClosestPoints"));
+        test.ReportSuccessIf(capsulesMatch, TEST_MSG("capsule distances don't match the segments'"));
+
+        // The corners of a box with points inside it make a hull the same as the box. Not a multiple of eight, so the 
+        // support function has a partial last group.
+        std::vector<Vector3> cloud;
+        for (int corner = 0; corner < 8; ++corner) {
+            cloud.push_back(Vector3(corner & 1 ? 1.0f : -1.0f, corner & 2 ? 1.0f : -1.0f, corner & 4 ? 1.0f : -1.0f));
+        }
+        for (int i = 0; i < 95; ++i) {
+            cloud.insert(cloud.begin() + rng.Range(0, (int)cloud.size()), RandomVector(rng, 0.99f));
+        }
+        const GJK::Hull hull(cloud.data(), cloud.size());
+        bool supportsMatch = true, hullMatches = true;
+        for (int i = 0; i < 100; ++i) {
+            const Vector3 direction = RandomVector(rng, 1.0f);
+            supportsMatch &= xo::Abs(hull.Support(direction).Dot(direction) - box.Support(direction).Dot(direction)) < 1e-5f;
+            const BoundingSphere ball(RandomVector(rng, 4.0f), rng.Range(0.1f, 1.0f));
+            Vector3 boxA, boxB;
+            hullMatches &= xo::Abs(GJK::Distance(hull, ball, pointA, pointB) - GJK::Distance(box, ball, boxA, boxB)) < 1e-4f;
+        }
+        test.ReportSuccessIf(supportsMatch, TEST_MSG("Hull::Support"));
+        test.ReportSuccessIf(hullMatches, TEST_MSG("a hull of a box doesn't match the box"));
+
+        // Boxes at an angle overlap when the distance between them is zero. Boxes without one overlap when AABB says so.
+        bool obbsAgree = true, aabbsAgree = true;
+        for (int i = 0; i < 300; ++i) {
+            const Vector3 axisX = RandomVector(rng, 1.0f).Normalized(), axisY = axisX.Cross(RandomVector(rng, 1.0f)).Normalized();
+            const OBB obb1(RandomVector(rng, 2.0f), axisX, axisY, axisX.Cross(axisY), Vector3(rng.Range(0.2f, 1.0f), rng.Range(0.2f, 1.0f), rng.Range(0.2f, 1.0f)));
+            const OBB obb2(RandomVector(rng, 2.0f), axisY, axisX.Cross(axisY), axisX, Vector3(rng.Range(0.2f, 1.0f), rng.Range(0.2f, 1.0f), rng.Range(0.2f, 1.0f)));
+            const float distance = GJK::Distance(obb1, obb2, pointA, pointB);
+            obbsAgree &= distance > 1e-3f ? !GJK::Intersects(obb1, obb2) : distance == 0.0f ? GJK::Intersects(obb1, obb2) : true;
+            const Vector3 c1 = RandomVector(rng, 2.0f), c2 = RandomVector(rng, 2.0f);
+            const Vector3 e1(rng.Range(0.1f, 1.0f), rng.Range(0.1f, 1.0f), rng.Range(0.1f, 1.0f)), e2(rng.Range(0.1f, 1.0f), rng.Range(0.1f, 1.0f), rng.Range(0.1f, 1.0f));
+            const AABB aabb1(c1 - e1, c1 + e1), aabb2(c2 - e2, c2 + e2);
+            bool nearTouching = false;
+            for (int axis = 0; axis < 3; ++axis) {
+                nearTouching |= xo::Abs(xo::Abs(c2[axis] - c1[axis]) - e1[axis] - e2[axis]) < 1e-3f;
+            }
+            if (!nearTouching) {
+                aabbsAgree &= GJK::Intersects(aabb1, aabb2) == aabb1.Overlaps(aabb2);
+            }
+        }
+        test.ReportSuccessIf(obbsAgree, TEST_MSG("Intersects and Distance disagree"));
+        test.ReportSuccessIf(aabbsAgree, TEST_MSG("Intersects and AABB::Overlaps disagree"));
+
+        // A cache carried from frame to frame doesn't change the answers.
+        GJK::Cache cache;
+        bool cachedMatch = true;
+        for (int frame = 0; frame < 100; ++frame) {
+            const float t = frame * 0.05f;
+            const Vector3 center(xo::Cos(t) * 3.0f, xo::Sin(t) * 3.0f, 0.5f);
+            const OBB moving(center, Vector3(xo::Cos(t), xo::Sin(t), 0.0f), Vector3(-xo::Sin(t), xo::Cos(t), 0.0f), Vector3::UnitZ, Vector3(1.0f, 0.5f, 0.25f));
+            Vector3 freshA, freshB;
+            cachedMatch &= xo::Abs(GJK::Distance(box, moving, pointA, pointB, &cache) - GJK::Distance(box, moving, freshA, freshB)) < 1e-4f;
+        }
+        test.ReportSuccessIf(cachedMatch && cache.direction.MagnitudeSquared() > 0.0f, TEST_MSG("warm started queries differ"));
+    });
+}
+
+void TestEPA() {
+    test("EPA", []{
+        using xo::Vector3;
+        using xo::AABB;
+        using xo::OBB;
+        using xo::BoundingSphere;
+        using xo::GJK;
+        using xo::EPA;
+        using xo::RandomGenerator;
+        RandomGenerator rng(2424);
+
+        Vector3 normal, pointA, pointB;
+        float depth;
+        const AABB box(Vector3(-1.0f), Vector3(1.0f));
+        test.ReportSuccessIf(EPA::Penetration(box, AABB(Vector3(0.5f, -0.2f, -0.3f), Vector3(2.0f, 1.0f, 1.0f)), normal, depth, pointA, pointB), TEST_MSG("overlapping boxes"));
+        test.ReportSuccessIf(normal == Vector3::UnitX && xo::Abs(depth - 0.5f) < 1e-5f && xo::Abs(pointA.x - 1.0f) < 1e-5f && xo::Abs(pointB.x - 0.5f) < 1e-5f, 
+                             TEST_MSG("box penetration"));
+        test.ReportSuccessIf(!EPA::Penetration(box, AABB(Vector3(2.0f), Vector3(3.0f)), normal, depth, pointA, pointB), TEST_MSG("apart boxes"));
+        test.ReportSuccessIf(EPA::Penetration(box, AABB(Vector3(1.0f, -0.5f, -0.5f), Vector3(2.0f, 0.5f, 0.5f)), normal, depth, pointA, pointB) && depth < 1e-5f, 
+                             TEST_MSG("touching boxes"));
+
+        const BoundingSphere sphere(Vector3(0.0f), 1.0f), sphere2(Vector3(1.0f, 0.5f, -0.5f), 0.8f);
+        const Vector3 between = Vector3(1.0f, 0.5f, -0.5f);
+        test.ReportSuccessIf(EPA::Penetration(sphere, sphere2, normal, depth, pointA, pointB) && xo::Abs(depth - (1.8f - between.Magnitude())) < 1e-3f && 
+                             normal.Dot(between.Normalized()) > 0.999f, TEST_MSG("sphere penetration"));
+
+        // Moving B along the normal by the depth leaves the shapes just touching.
+        bool separates = true, pointsMatch = true;
+        int overlapping = 0;
+        for (int i = 0; i < 300; ++i) {
+            const Vector3 axisX = RandomVector(rng, 1.0f).Normalized(), axisY = axisX.Cross(RandomVector(rng, 1.0f)).Normalized();
+            const OBB obb1(RandomVector(rng, 1.0f), axisX, axisY, axisX.Cross(axisY), Vector3(rng.Range(0.2f, 1.0f), rng.Range(0.2f, 1.0f), rng.Range(0.2f, 1.0f)));
+            OBB obb2(RandomVector(rng, 1.0f), axisY, axisX.Cross(axisY), axisX, Vector3(rng.Range(0.2f, 1.0f), rng.Range(0.2f, 1.0f), rng.Range(0.2f, 1.0f)));
+            if (!EPA::Penetration(obb1, obb2, normal, depth, pointA, pointB)) {
+                continue;
+            }
+            ++overlapping;
+            pointsMatch &= Vector3::DistanceSquared(pointA - pointB, normal * depth) < 1e-5f && normal.IsNormalized();
+            obb2.center += normal * (depth + 1e-3f);
+            separates &= !GJK::Intersects(obb1, obb2);
+            obb2.center -= normal * 2e-3f;
+            separates &= GJK::Intersects(obb1, obb2);
+        }
+        test.ReportSuccessIf(overlapping > 50, TEST_MSG("too few boxes overlapped"));
+        test.ReportSuccessIf(separates, TEST_MSG("moving by the depth didn't separate the boxes"));
+        test.ReportSuccessIf(pointsMatch, TEST_MSG("the contact points aren't depth apart along the normal"));
+
+        // GJK and EPA sharing a cache agree on its direction: B was above A, so the normal of the touch points up.
+        GJK::Cache cache;
+        const xo::Segment segment(Vector3(-1.0f, 0.0f, 0.0f), Vector3(1.0f, 0.0f, 0.0f));
+        GJK::Distance(segment, xo::Segment(Vector3(0.0f, -1.0f, 1.0f), Vector3(0.0f, 1.0f, 1.0f)), pointA, pointB, &cache);
+        test.ReportSuccessIf(EPA::Penetration(segment, xo::Segment(Vector3(0.0f, -1.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f)), normal, depth, pointA, pointB, &cache) && 
+                             normal == Vector3::UnitZ && depth == 0.0f, TEST_MSG("EPA after GJK flipped the normal"));
+        test.ReportSuccessIf(EPA::Penetration(box, AABB(Vector3(0.5f, -0.2f, -0.3f), Vector3(2.0f, 1.0f, 1.0f)), normal, depth, pointA, pointB, &cache) && 
+                             cache.direction == -normal, TEST_MSG("EPA left the cache pointing from A towards B"));
+    });
+}
+
+void TestMorton() {
+    test("Morton", []{
+        using xo::Vector3;
+        using xo::Vector3Stream;
+        using xo::AABB;
+        using xo::Morton;
+        using xo::RandomGenerator;
+        RandomGenerator rng(2718);
+
+        // Codes against interleaving a bit at a time.
+        auto interleave = [](uint32_t x, uint32_t y, uint32_t z, int bits) {
+            uint64_t code = 0;
+            for (int b = 0; b < bits; ++b) {
+                code |= (uint64_t)((x >> b) & 1) << (b * 3);
+                code |= (uint64_t)((y >> b) & 1) << (b * 3 + 1);
+                code |= (uint64_t)((z >> b) & 1) << (b * 3 + 2);
+            }
+            return code;
+        };
+        bool encodes = Morton::Encode30(Morton::Max30, Morton::Max30, Morton::Max30) == 0x3fffffff && 
+                       Morton::Encode63(Morton::Max63, Morton::Max63, Morton::Max63) == 0x7fffffffffffffffull;
+        bool decodes = true;
+        for (int i = 0; i < 1000; ++i) {
+            const uint32_t x = (uint32_t)rng.Range(0, (int)Morton::Max63), y = (uint32_t)rng.Range(0, (int)Morton::Max63), z = (uint32_t)rng.Range(0, (int)Morton::Max63);
+            const uint32_t code30 = Morton::Encode30(x, y, z);
+            const uint64_t code63 = Morton::Encode63(x, y, z);
+            encodes &= code30 == interleave(x & Morton::Max30, y & Morton::Max30, z & Morton::Max30, 10) && code63 == interleave(x, y, z, 21);
+            uint32_t dx, dy, dz, ex, ey, ez;
+            Morton::Decode30(code30, dx, dy, dz);
+            Morton::Decode63(code63, ex, ey, ez);
+            decodes &= dx == (x & Morton::Max30) && dy == (y & Morton::Max30) && dz == (z & Morton::Max30) && ex == x && ey == y && ez == z;
+        }
+        test.ReportSuccessIf(encodes, TEST_MSG("codes of cells don't interleave their bits"));
+        test.ReportSuccessIf(decodes, TEST_MSG("decoding doesn't give back the cell"));
+
+        // The array and stream encoders against the one point encoders, with points on and outside the bounds and a 
+        // count that isn't a multiple of the SIMD width.
+        const AABB bounds(Vector3(-10.0f, -5.0f, 0.0f), Vector3(10.0f, 5.0f, 2.0f));
+        const size_t count = 1003;
+        std::vector<Vector3> points(count);
+        for (size_t i = 0; i < count; ++i) {
+            points[i].Set(rng.Range(-12.0f, 12.0f), rng.Range(-5.0f, 5.0f), rng.Range(0.0f, 2.0f));
+        }
+        points[0] = bounds.min;
+        points[1] = bounds.max;
+        points[2].Set(1e9f, -1e9f, 1.0f);
+        const Vector3Stream stream(points.data(), count);
+        std::vector<uint32_t> codes30(count), streamCodes30(count);
+        std::vector<uint64_t> codes63(count), streamCodes63(count);
+        Morton::Encode30(points.data(), count, bounds, codes30.data());
+        Morton::Encode30(stream, bounds, streamCodes30.data());
+        Morton::Encode63(points.data(), count, bounds, codes63.data());
+        Morton::Encode63(stream, bounds, streamCodes63.data());
+        bool bulkMatches = true;
+        for (size_t i = 0; i < count; ++i) {
+            const uint32_t code30 = Morton::Encode30(points[i], bounds);
+            const uint64_t code63 = Morton::Encode63(points[i], bounds);
+            bulkMatches &= codes30[i] == code30 && streamCodes30[i] == code30 && codes63[i] == code63 && streamCodes63[i] == code63;
+        }
+        test.ReportSuccessIf(bulkMatches, TEST_MSG("the array or stream encoders don't match encoding each point"));
+        uint32_t x, y, z;
+        Morton::Decode30(codes30[1], x, y, z);
+        bool clamped = x == Morton::Max30 && y == Morton::Max30 && z == Morton::Max30 && codes30[0] == 0;
+        Morton::Decode63(codes63[2], x, y, z);
+        clamped &= x == Morton::Max63 && y == 0 && z == Morton::Max63 / 2 + 1;
+        test.ReportSuccessIf(clamped, TEST_MSG("points on or outside the bounds aren't in the closest cell"));
+        const AABB flat(Vector3(0.0f), Vector3(1.0f, 1.0f, 0.0f));
+        Morton::Decode30(Morton::Encode30(Vector3(0.5f, 0.25f, 3.0f), flat), x, y, z);
+        test.ReportSuccessIf(x == 512 && y == 256 && z == 0, TEST_MSG("bounds without depth put points in the wrong cell"));
+
+        // Sorts against std::stable_sort, with few distinct keys so stability shows, single and multi threaded. 
+        // 300000 keys is enough for four threads to each get a share.
+        const size_t sortCount = 300000;
+        std::vector<uint32_t> keys32(sortCount), indices(sortCount);
+        std::vector<uint64_t> keys64(sortCount);
+        std::vector<std::pair<uint64_t, uint32_t>> expected(sortCount);
+        auto sorts = [&](int bits, unsigned threads, bool with64) {
+            for (size_t i = 0; i < sortCount; ++i) {
+                const uint64_t random = (uint64_t)rng.Range(0, 0x7fffffff) << 32 | (uint64_t)rng.Range(0, 0x7fffffff) << 1;
+                const uint64_t key = bits ? random >> (64 - bits) : 0;
+                keys64[i] = key;
+                keys32[i] = (uint32_t)key;
+                expected[i] = std::make_pair(with64 ? key : (uint32_t)key, (uint32_t)i);
+                indices[i] = (uint32_t)i;
+            }
+            std::stable_sort(expected.begin(), expected.end(), [](const std::pair<uint64_t, uint32_t>& a, const std::pair<uint64_t, uint32_t>& b) { return a.first < b.first; });
+            if (with64) {
+                Morton::Sort(keys64.data(), indices.data(), sortCount, threads);
+            }
+            else {
+                Morton::Sort(keys32.data(), indices.data(), sortCount, threads);
+            }
+            for (size_t i = 0; i < sortCount; ++i) {
+                if ((with64 ? keys64[i] : keys32[i]) != expected[i].first || indices[i] != expected[i].second) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        test.ReportSuccessIf(sorts(30, 1, false) && sorts(30, 4, false) && sorts(32, 3, false) && sorts(6, 2, false), TEST_MSG("32 bit keys sorted wrong"));
+        test.ReportSuccessIf(sorts(63, 1, true) && sorts(64, 4, true) && sorts(40, 2, true) && sorts(0, 4, true), TEST_MSG("64 bit keys sorted wrong"));
+
+        // Ordering points, then permuting arrays and streams by it.
+        std::vector<uint32_t> order(count), streamOrder(count);
+        Morton::Order(points.data(), count, bounds, order.data());
+        Morton::Order(stream, bounds, streamOrder.data());
+        std::vector<Vector3> sorted(count);
+        Morton::Permute(points.data(), order.data(), count, sorted.data());
+        Vector3Stream sortedStream;
+        Morton::Permute(stream, streamOrder.data(), sortedStream);
+        bool ordered = order == streamOrder && sortedStream.Size() == count;
+        for (size_t i = 0; i < count && ordered; ++i) {
+            ordered &= sorted[i] == points[order[i]] && sortedStream.Get(i) == sorted[i];
+            ordered &= i == 0 || Morton::Encode30(sorted[i - 1], bounds) <= Morton::Encode30(sorted[i], bounds);
+        }
+        test.ReportSuccessIf(ordered, TEST_MSG("points aren't in Morton order after permuting"));
+    });
+}
+
+void TestMatrix3x4() {
+    test("Matrix3x4", []{
+        using xo::Vector3;
+        using xo::Vector4;
+        using xo::Matrix3x4;
+        using xo::Matrix4x4;
+        using xo::RandomGenerator;
+        RandomGenerator rng(3141);
+
+        // Rotation, non-uniform scale and translation, as columns.
+        auto randomAffine = [&]() {
+            const Matrix4x4 rotation = ~Matrix4x4::AxisAngleRadians(RandomVector(rng, 1.0f).Normalized(), rng.Range(-3.0f, 3.0f));
+            const Vector3 scale(rng.Range(0.5f, 2.0f), rng.Range(0.5f, 2.0f), rng.Range(0.5f, 2.0f));
+            const Vector3 translation = RandomVector(rng, 10.0f);
+            return Matrix3x4(rotation * Matrix4x4::Scale(scale)).SetTranslation(translation);
+        };
+
+        bool converts = true, multiplies = true, transforms = true, inverts = true;
+        for (int i = 0; i < 100; ++i) {
+            const Matrix3x4 a = randomAffine(), b = randomAffine();
+            const Matrix4x4 a4(a), b4(b);
+            const Matrix3x4 back(a4);
+            converts &= memcmp(back.m, a.m, sizeof(a.m)) == 0 && a4(3, 0) == 0.0f && a4(3, 1) == 0.0f && a4(3, 2) == 0.0f && a4(3, 3) == 1.0f;
+
+            Matrix3x4 product = a;
+            product *= b;
+            multiplies &= CloseMatrix(a * b, Matrix3x4(a4 * b4), 1e-4f) && CloseMatrix(product, a * b, 0.0f);
+            const Vector3 row0(a.m00, a.m01, a.m02), row1(a.m10, a.m11, a.m12), row2(a.m20, a.m21, a.m22);
+            multiplies &= xo::Abs(a.Determinant() - row0.Dot(row1.Cross(row2))) < 1e-3f;
+
+            const Vector3 v = RandomVector(rng, 10.0f);
+            Vector3 points[2] = { v, v }, directions[2] = { v, v };
+            a4.TransformPoints(points, 1);
+            a4.TransformDirections(directions, 1);
+            a.TransformPoints(points + 1, points + 1, 1);
+            a.TransformDirections(directions + 1, directions + 1, 1);
+            transforms &= CloseVector(a.TransformPoint(v), points[0]) && CloseVector(a * v, points[0]) && CloseVector(points[1], points[0]);
+            transforms &= CloseVector(a.TransformDirection(v), directions[0]) && CloseVector(directions[1], directions[0]);
+
+            Matrix3x4 inverse;
+            a.GetInverse(inverse);
+            inverts &= CloseMatrix(a * inverse, Matrix3x4::Identity, 1e-4f) && CloseMatrix(inverse * a, Matrix3x4::Identity, 1e-4f);
+            Matrix4x4 inverse4 = a4;
+            inverse4.MakeInverse();
+            inverts &= CloseMatrix(inverse, Matrix3x4(inverse4), 1e-3f);
+        }
+        test.ReportSuccessIf(converts, TEST_MSG("converting to Matrix4x4 and back isn't lossless"));
+        test.ReportSuccessIf(multiplies, TEST_MSG("Multiply doesn't match Matrix4x4"));
+        test.ReportSuccessIf(transforms, TEST_MSG("transforming points and directions doesn't match Matrix4x4"));
+        test.ReportSuccessIf(inverts, TEST_MSG("the inverse times the matrix isn't the identity"));
+
+        // A rigid matrix inverts without division, and singular matrices are left alone.
+        const Matrix3x4 rigid = Matrix3x4(~Matrix4x4::AxisAngleRadians(Vector3(1.0f, 2.0f, 3.0f).Normalized(), 0.7f)).SetTranslation(Vector3(4.0f, -5.0f, 6.0f));
+        Matrix3x4 rigidInverse = rigid;
+        rigidInverse.MakeInverseRigid();
+        Matrix3x4 generalInverse;
+        rigid.GetInverse(generalInverse);
+        test.ReportSuccessIf(CloseMatrix(rigidInverse, generalInverse, 1e-5f), TEST_MSG("MakeInverseRigid doesn't match MakeInverse"));
+        Matrix3x4 singular(1.0f, 2.0f, 3.0f, 4.0f, 2.0f, 4.0f, 6.0f, 8.0f, 0.0f, 1.0f, 0.0f, 1.0f);
+        const Matrix3x4 before = singular;
+        test.ReportSuccessIf(!singular.TryMakeInverse() && memcmp(singular.m, before.m, sizeof(singular.m)) == 0, TEST_MSG("a singular matrix was inverted"));
+
+        // The arrays against one matrix at a time, in place.
+        std::vector<Matrix3x4> parents, children, products, inverses;
+        for (int i = 0; i < 9; ++i) {
+            parents.push_back(randomAffine());
+            children.push_back(randomAffine());
+        }
+        products = children;
+        inverses = parents;
+        Matrix3x4::MultiplyArray(parents[0], products.data(), products.data(), products.size());
+        bool arrays = true;
+        for (size_t i = 0; i < children.size(); ++i) {
+            arrays &= CloseMatrix(products[i], parents[0] * children[i], 1e-5f);
+        }
+        Matrix3x4::MultiplyArray(parents.data(), children.data(), products.data(), products.size());
+        Matrix3x4::InverseArray(inverses.data(), inverses.data(), inverses.size());
+        for (size_t i = 0; i < children.size(); ++i) {
+            Matrix3x4 inverse;
+            parents[i].GetInverse(inverse);
+            arrays &= CloseMatrix(products[i], parents[i] * children[i], 0.0f) && CloseMatrix(inverses[i], inverse, 0.0f);
+        }
+        test.ReportSuccessIf(arrays, TEST_MSG("the array methods don't match one matrix at a time"));
+    });
+}
+
+void TestTransform() {
+    test("Transform", []{
+        using xo::Vector3;
+        using xo::Quaternion;
+        using xo::Transform;
+        using xo::Matrix3x4;
+        using xo::Matrix4x4;
+        using xo::RandomGenerator;
+        RandomGenerator rng(2718);
+
+        // Uniform scale, where composing and inverting are exact.
+        auto randomTransform = [&]() {
+            const float scale = rng.Range(0.5f, 2.0f);
+            return Transform(RandomVector(rng, 10.0f), RandomRotation(rng), Vector3(scale, scale, scale));
+        };
+
+        bool transforms = true, converts = true, multiplies = true, inverts = true;
+        for (int i = 0; i < 100; ++i) {
+            const Vector3 axis = RandomVector(rng, 1.0f).Normalized();
+            const float angle = rng.Range(-3.0f, 3.0f);
+            const Vector3 scale(rng.Range(0.5f, 2.0f), rng.Range(0.5f, 2.0f), rng.Range(0.5f, 2.0f));
+            const Transform t(RandomVector(rng, 10.0f), Quaternion::AxisAngleRadians(axis, angle), scale);
+            const Vector3 v = RandomVector(rng, 10.0f);
+            Vector3 rotated;
+            Vector3::RotateRadians(v * scale, axis, angle, rotated);
+            transforms &= CloseVector(t.TransformPoint(v), rotated + t.translation) && CloseVector(t * v, rotated + t.translation);
+            transforms &= CloseVector(t.TransformDirection(v), rotated) && CloseVector(t.InverseTransformPoint(t * v), v);
+
+            const Matrix3x4 m = t.ToMatrix3x4();
+            const Matrix4x4 m4 = t.ToMatrix4x4();
+            Vector3 points[2] = { v, v };
+            m4.TransformPoints(points, 1);
+            t.TransformPoints(points + 1, points + 1, 1);
+            converts &= CloseVector(m.TransformPoint(v), t * v) && CloseVector(points[0], t * v) && CloseVector(points[1], t * v);
+
+            // Non uniform scale is fine on the child.
+            const Transform a = randomTransform();
+            Transform product = a;
+            product *= t;
+            multiplies &= CloseMatrix((a * t).ToMatrix3x4(), a.ToMatrix3x4() * m, 1e-3f) && CloseMatrix(product.ToMatrix3x4(), (a * t).ToMatrix3x4(), 0.0f);
+
+            const Transform inverse = a.Inverse();
+            inverts &= CloseMatrix((a * inverse).ToMatrix3x4(), Matrix3x4::Identity, 1e-4f) && CloseMatrix((inverse * a).ToMatrix3x4(), Matrix3x4::Identity, 1e-4f);
+        }
+        test.ReportSuccessIf(transforms, TEST_MSG("transforming doesn't match scaling then rotating then translating"));
+        test.ReportSuccessIf(converts, TEST_MSG("the matrices don't transform as the Transform does"));
+        test.ReportSuccessIf(multiplies, TEST_MSG("Multiply doesn't match multiplying the matrices"));
+        test.ReportSuccessIf(inverts, TEST_MSG("the inverse times the transform isn't the identity"));
+
+        const Transform a = randomTransform(), b = randomTransform();
+        Transform lerped, slerped;
+        Transform::Lerp(a, b, 0.0f, lerped);
+        Transform::Slerp(a, b, 1.0f, slerped);
+        test.ReportSuccessIf(CloseMatrix(lerped.ToMatrix3x4(), a.ToMatrix3x4(), 1e-4f) && CloseMatrix(slerped.ToMatrix3x4(), b.ToMatrix3x4(), 1e-4f), TEST_MSG("interpolation doesn't start at a and end at b"));
+        Transform::Lerp(a, b, 0.5f, lerped);
+        Transform::Slerp(a, b, 0.5f, slerped);
+        const float cosine = lerped.rotation.x * slerped.rotation.x + lerped.rotation.y * slerped.rotation.y + lerped.rotation.z * slerped.rotation.z + lerped.rotation.w * slerped.rotation.w;
+        test.ReportSuccessIf(CloseVector(lerped.translation, (a.translation + b.translation) * 0.5f) && xo::Abs(cosine) > 0.9999f, TEST_MSG("the midpoint is off"));
+
+        // The array kernels, over a count that leaves a remainder for every width.
+        const size_t count = 37;
+        std::vector<Transform> parents(count), children(count), out(count), outParent(count);
+        for (size_t i = 0; i < count; ++i) {
+            parents[i] = randomTransform();
+            children[i] = randomTransform();
+        }
+        Transform::MultiplyArray(parents.data(), children.data(), out.data(), count);
+        Transform::MultiplyArray(parents[0], children.data(), outParent.data(), count);
+        std::vector<Matrix4x4> matrices4(count);
+        std::vector<Matrix3x4> matrices3(count);
+        Transform::ToMatrixArray(out.data(), matrices4.data(), count);
+        Transform::ToMatrixArray(out.data(), matrices3.data(), count);
+        bool arrays = true;
+        for (size_t i = 0; i < count; ++i) {
+            arrays &= CloseMatrix(out[i].ToMatrix3x4(), (parents[i] * children[i]).ToMatrix3x4(), 1e-4f);
+            arrays &= CloseMatrix(outParent[i].ToMatrix3x4(), (parents[0] * children[i]).ToMatrix3x4(), 1e-4f);
+            arrays &= CloseMatrix(matrices3[i], out[i].ToMatrix3x4(), 1e-5f) && CloseMatrix(Matrix3x4(matrices4[i]), matrices3[i], 0.0f);
+            arrays &= matrices4[i](3, 0) == 0.0f && matrices4[i](3, 1) == 0.0f && matrices4[i](3, 2) == 0.0f && matrices4[i](3, 3) == 1.0f;
+        }
+        test.ReportSuccessIf(arrays, TEST_MSG("the array kernels don't match the single versions"));
+    });
+}
+
+void TestDualQuaternion() {
+    test("DualQuaternion", []{
+        using xo::Vector3;
+        using xo::Quaternion;
+        using xo::DualQuaternion;
+        using xo::Transform;
+        using xo::RandomGenerator;
+        RandomGenerator rng(1618);
+
+
+        bool transforms = true, multiplies = true, normalizes = true, inverts = true;
+        for (int i = 0; i < 100; ++i) {
+            const Transform t(RandomVector(rng, 10.0f), RandomRotation(rng)), u(RandomVector(rng, 10.0f), RandomRotation(rng));
+            const DualQuaternion a(t.rotation, t.translation), b(u);
+            const Vector3 v = RandomVector(rng, 10.0f);
+            transforms &= CloseVector(a.GetTranslation(), t.translation) && CloseVector(a * v, t * v) && CloseVector(a.TransformPoint(v), t * v);
+            transforms &= CloseVector(a.TransformDirection(v), t.TransformDirection(v)) && CloseVector(a.ToTransform() * v, t * v);
+
+            DualQuaternion product = a;
+            product *= b;
+            multiplies &= CloseVector((a * b) * v, (t * u) * v) && CloseVector(product * v, (t * u) * v);
+
+            // Scaled, and with some of the real part in the dual part.
+            const float s = rng.Range(0.5f, 2.0f), d = rng.Range(-1.0f, 1.0f);
+            DualQuaternion skewed(Quaternion(a.real.x * s, a.real.y * s, a.real.z * s, a.real.w * s), 
+                                  Quaternion(a.dual.x * s + a.real.x * d, a.dual.y * s + a.real.y * d, a.dual.z * s + a.real.z * d, a.dual.w * s + a.real.w * d));
+            skewed.Normalize();
+            const float dot = skewed.real.x * skewed.dual.x + skewed.real.y * skewed.dual.y + skewed.real.z * skewed.dual.z + skewed.real.w * skewed.dual.w;
+            normalizes &= CloseVector(skewed * v, a * v) && xo::Abs(dot) < 1e-4f;
+
+            inverts &= CloseVector(a.Inverse() * (a * v), v) && CloseVector((a * a.Inverse()) * v, v);
+        }
+        test.ReportSuccessIf(transforms, TEST_MSG("transforming doesn't match the Transform it was made from"));
+        test.ReportSuccessIf(multiplies, TEST_MSG("Multiply doesn't match Transform::Multiply"));
+        test.ReportSuccessIf(normalizes, TEST_MSG("Normalize doesn't recover the unit dual quaternion"));
+        test.ReportSuccessIf(inverts, TEST_MSG("the inverse doesn't undo the transformation"));
+
+        const DualQuaternion a(RandomRotation(rng), RandomVector(rng, 10.0f)), b(RandomRotation(rng), RandomVector(rng, 10.0f));
+        DualQuaternion start, end, flipped;
+        DualQuaternion::Nlerp(a, b, 0.0f, start);
+        DualQuaternion::Nlerp(a, b, 1.0f, end);
+        // The same transformation with both parts negated, which Nlerp should blend the same way.
+        const DualQuaternion negated(Quaternion(-b.real.x, -b.real.y, -b.real.z, -b.real.w), Quaternion(-b.dual.x, -b.dual.y, -b.dual.z, -b.dual.w));
+        DualQuaternion half;
+        DualQuaternion::Nlerp(a, b, 0.5f, half);
+        DualQuaternion::Nlerp(a, negated, 0.5f, flipped);
+        const Vector3 v(1.0f, 2.0f, 3.0f);
+        test.ReportSuccessIf(CloseVector(start * v, a * v) && CloseVector(end * v, b * v) && CloseVector(half * v, flipped * v), TEST_MSG("Nlerp doesn't blend along the short path"));
+    });
+}
+
+void TestSkinning() {
+    test("Skinning", []{
+        using xo::Vector3;
+        using xo::Vector3Stream;
+        using xo::Quaternion;
+        using xo::DualQuaternion;
+        using xo::Skinning;
+        using xo::RandomGenerator;
+        RandomGenerator rng(4242);
+
+
+        const int bones = 20;
+        std::vector<DualQuaternion> dualQuaternions(bones);
+        for (int i = 0; i < bones; ++i) {
+            dualQuaternions[i] = DualQuaternion(RandomRotation(rng), RandomVector(rng, 5.0f));
+        }
+        // Enough vertices for several threads, and a count that leaves a partial block at any width.
+        const size_t count = 50001;
+        std::vector<uint16_t> indices(count * Skinning::Influences);
+        std::vector<float> weights(count * Skinning::Influences);
+        Vector3Stream positions(count), normals(count);
+        for (size_t i = 0; i < count; ++i) {
+            float sum = 0.0f;
+            for (int j = 0; j < Skinning::Influences; ++j) {
+                indices[i * Skinning::Influences + j] = (uint16_t)rng.Range(0, bones - 1);
+                weights[i * Skinning::Influences + j] = j < (int)(i % 5) ? rng.Range(0.1f, 1.0f) : 0.0f;
+                sum += weights[i * Skinning::Influences + j];
+            }
+            for (int j = 0; j < Skinning::Influences; ++j) {
+                weights[i * Skinning::Influences + j] = sum > 0.0f ? weights[i * Skinning::Influences + j] / sum : (j == 0 ? 1.0f : 0.0f);
+            }
+            positions.Set(i, RandomVector(rng, 10.0f));
+            normals.Set(i, RandomVector(rng, 1.0f).Normalized());
+        }
+
+        Vector3Stream skinned, skinnedNormals, threaded, threadedNormals, positionsOnly;
+        Skinning::DualQuaternionBlend(dualQuaternions.data(), indices.data(), weights.data(), positions, normals, skinned, skinnedNormals, 1);
+        Skinning::DualQuaternionBlend(dualQuaternions.data(), indices.data(), weights.data(), positions, normals, threaded, threadedNormals, 3);
+        Skinning::DualQuaternionBlend(dualQuaternions.data(), indices.data(), weights.data(), positions, positionsOnly, 1);
+        bool matches = true, threadsMatch = true;
+        for (size_t i = 0; i < count; ++i) {
+            // The blend a vertex at a time, through DualQuaternion.
+            const uint16_t* index = &indices[i * Skinning::Influences];
+            const float* weight = &weights[i * Skinning::Influences];
+            const DualQuaternion& first = dualQuaternions[index[0]];
+            Quaternion real(0.0f, 0.0f, 0.0f, 0.0f), dual(0.0f, 0.0f, 0.0f, 0.0f);
+            for (int j = 0; j < Skinning::Influences; ++j) {
+                const DualQuaternion& q = dualQuaternions[index[j]];
+                const float w = (first.real.x * q.real.x + first.real.y * q.real.y + first.real.z * q.real.z + first.real.w * q.real.w) < 0.0f ? -weight[j] : weight[j];
+                real = Quaternion(real.x + q.real.x * w, real.y + q.real.y * w, real.z + q.real.z * w, real.w + q.real.w * w);
+                dual = Quaternion(dual.x + q.dual.x * w, dual.y + q.dual.y * w, dual.z + q.dual.z * w, dual.w + q.dual.w * w);
+            }
+            const DualQuaternion blended = DualQuaternion(real, dual).Normalized();
+            matches &= CloseVector(skinned.Get(i), blended * positions.Get(i)) && CloseVector(skinnedNormals.Get(i), blended.TransformDirection(normals.Get(i)));
+            matches &= CloseVector(positionsOnly.Get(i), skinned.Get(i));
+            threadsMatch &= threaded.Get(i) == skinned.Get(i) && threadedNormals.Get(i) == skinnedNormals.Get(i);
+        }
+        test.ReportSuccessIf(matches, TEST_MSG("DualQuaternionBlend doesn't match blending a vertex at a time"));
+        test.ReportSuccessIf(threadsMatch, TEST_MSG("DualQuaternionBlend depends on the number of threads"));
+
+        // Skinning in place.
+        Vector3Stream inPlace = positions;
+        Skinning::DualQuaternionBlend(dualQuaternions.data(), indices.data(), weights.data(), inPlace, inPlace, 2);
+        bool inPlaceMatches = true;
+        for (size_t i = 0; i < count; ++i) {
+            inPlaceMatches &= inPlace.Get(i) == skinned.Get(i);
+        }
+        test.ReportSuccessIf(inPlaceMatches, TEST_MSG("skinning in place doesn't match"));
+
+        // Linear blend skinning, against summing the matrices a vertex at a time. The palette has some non uniform scale.
+        std::vector<xo::Matrix3x4> matrices(bones);
+        std::vector<xo::Matrix4x4> matrices4(bones);
+        for (int i = 0; i < bones; ++i) {
+            const Vector3 scale(rng.Range(0.5f, 2.0f), rng.Range(0.5f, 2.0f), rng.Range(0.5f, 2.0f));
+            matrices[i] = xo::Transform(RandomVector(rng, 5.0f), dualQuaternions[i].real, scale).ToMatrix3x4();
+            matrices4[i] = xo::Matrix4x4(matrices[i]);
+        }
+        Vector3Stream linear, linearNormals, linear4, linear4Normals, linearThreaded, linearThreadedNormals;
+        Skinning::LinearBlend(matrices.data(), indices.data(), weights.data(), positions, normals, linear, linearNormals, 1);
+        Skinning::LinearBlend(matrices4.data(), indices.data(), weights.data(), positions, normals, linear4, linear4Normals, 1);
+        Skinning::LinearBlend(matrices.data(), indices.data(), weights.data(), positions, normals, linearThreaded, linearThreadedNormals, 3);
+        bool linearMatches = true, linearThreadsMatch = true;
+        for (size_t i = 0; i < count; ++i) {
+            const uint16_t* index = &indices[i * Skinning::Influences];
+            const float* weight = &weights[i * Skinning::Influences];
+            xo::Matrix3x4 blended(xo::Vector4(0.0f), xo::Vector4(0.0f), xo::Vector4(0.0f));
+            for (int j = 0; j < Skinning::Influences; ++j) {
+                for (int r = 0; r < 3; ++r) {
+                    blended.r[r] += matrices[index[j]].r[r] * weight[j];
+                }
+            }
+            linearMatches &= CloseVector(linear.Get(i), blended.TransformPoint(positions.Get(i))) && CloseVector(linearNormals.Get(i), blended.TransformDirection(normals.Get(i)));
+            linearMatches &= CloseVector(linear4.Get(i), linear.Get(i)) && CloseVector(linear4Normals.Get(i), linearNormals.Get(i));
+            linearThreadsMatch &= linearThreaded.Get(i) == linear.Get(i) && linearThreadedNormals.Get(i) == linearNormals.Get(i);
+        }
+        test.ReportSuccessIf(linearMatches, TEST_MSG("LinearBlend doesn't match blending a vertex at a time"));
+        test.ReportSuccessIf(linearThreadsMatch, TEST_MSG("LinearBlend depends on the number of threads"));
+
+        // Interleaved arrays, over a count that leaves a partial block, match the streams.
+        const size_t arrayCount = 1003;
+        std::vector<Vector3> arrayPositions(arrayCount), arrayNormals(arrayCount), outLinear(arrayCount), outLinearNormals(arrayCount);
+        std::vector<Vector3> outDual(arrayCount), outDualNormals(arrayCount), outPositionsOnly(arrayCount + 1, Vector3(7.0f, 7.0f, 7.0f));
+        for (size_t i = 0; i < arrayCount; ++i) {
+            arrayPositions[i] = positions.Get(i);
+            arrayNormals[i] = normals.Get(i);
+        }
+        Skinning::LinearBlend(matrices4.data(), indices.data(), weights.data(), arrayPositions.data(), arrayNormals.data(), outLinear.data(), outLinearNormals.data(), arrayCount, 2);
+        Skinning::DualQuaternionBlend(dualQuaternions.data(), indices.data(), weights.data(), arrayPositions.data(), arrayNormals.data(), outDual.data(), outDualNormals.data(), arrayCount);
+        Skinning::LinearBlend(matrices.data(), indices.data(), weights.data(), arrayPositions.data(), nullptr, outPositionsOnly.data(), nullptr, arrayCount);
+        bool arraysMatch = outPositionsOnly[arrayCount] == Vector3(7.0f, 7.0f, 7.0f);
+        for (size_t i = 0; i < arrayCount; ++i) {
+            arraysMatch &= CloseVector(outLinear[i], linear.Get(i)) && CloseVector(outLinearNormals[i], linearNormals.Get(i)) && CloseVector(outPositionsOnly[i], linear.Get(i));
+            arraysMatch &= CloseVector(outDual[i], skinned.Get(i)) && CloseVector(outDualNormals[i], skinnedNormals.Get(i));
+        }
+        test.ReportSuccessIf(arraysMatch, TEST_MSG("skinning interleaved arrays doesn't match the streams"));
+    });
+}
+
+void TestHierarchy() {
+    test("Hierarchy", []{
+        using xo::Vector3;
+        using xo::Quaternion;
+        using xo::Matrix3x4;
+        using xo::Matrix4x4;
+        using xo::Transform;
+        using xo::Hierarchy;
+        using xo::RandomGenerator;
+        RandomGenerator rng(2525);
+
+        // 1 is the root, 2 its child, 0 and 3 the children of 2 and 4 the child of 0.
+        const uint32_t small[] = { 2, Hierarchy::NoParent, 1, 2, 0 };
+        Hierarchy hierarchy(small, 5);
+        const uint32_t expectedNodes[] = { 1, 2, 0, 3, 4 };
+        const uint32_t expectedParents[] = { Hierarchy::NoParent, 1, 2, 2, 0 };
+        const uint32_t expectedOffsets[] = { 0, 1, 2, 4, 5 };
+        test.ReportSuccessIf(hierarchy.LevelCount(), 4u, TEST_MSG("wrong number of levels"));
+        test.ReportSuccessIf(memcmp(hierarchy.Nodes(), expectedNodes, sizeof(expectedNodes)) == 0 && 
+                             memcmp(hierarchy.Parents(), expectedParents, sizeof(expectedParents)) == 0 && 
+                             memcmp(hierarchy.LevelOffsets(), expectedOffsets, sizeof(expectedOffsets)) == 0, 
+                             TEST_MSG("nodes aren't sorted by level"));
+
+        // A forest with wide enough levels to be split over threads. Nodes are shuffled so that parents come before or 
+        // after their children.
+        const size_t count = 60000;
+        std::vector<uint32_t> shuffled(count), parents(count);
+        for (size_t i = 0; i < count; ++i) {
+            shuffled[i] = (uint32_t)i;
+        }
+        for (size_t i = count - 1; i > 0; --i) {
+            std::swap(shuffled[i], shuffled[rng.Range(0, (int)i)]);
+        }
+        for (size_t i = 0; i < count; ++i) {
+            parents[shuffled[i]] = i < 3 ? Hierarchy::NoParent : shuffled[i / rng.Range(2, 5)];
+        }
+        std::vector<Transform> locals(count);
+        std::vector<Matrix3x4> locals3(count);
+        std::vector<Matrix4x4> locals4(count);
+        for (size_t i = 0; i < count; ++i) {
+            const Vector3 axis(rng.Range(-1.0f, 1.0f), rng.Range(-1.0f, 1.0f), rng.Range(-1.0f, 1.0f));
+            const Vector3 translation(rng.Range(-1.0f, 1.0f), rng.Range(-1.0f, 1.0f), rng.Range(-1.0f, 1.0f));
+            const Vector3 scale(rng.Range(0.9f, 1.1f), rng.Range(0.9f, 1.1f), rng.Range(0.9f, 1.1f));
+            locals[i] = Transform(translation, Quaternion::AxisAngleRadians(axis.Normalized(), rng.Range(-3.0f, 3.0f)), scale);
+            locals3[i] = locals[i].ToMatrix3x4();
+            locals4[i] = Matrix4x4(locals3[i]);
+        }
+        // Node by node, each after its parent.
+        std::vector<Matrix3x4> expected(count);
+        for (size_t i = 0; i < count; ++i) {
+            const uint32_t node = shuffled[i];
+            expected[node] = parents[node] == Hierarchy::NoParent ? locals3[node] : expected[parents[node]] * locals3[node];
+        }
+
+        hierarchy.Build(parents.data(), count);
+        std::vector<Matrix3x4> worlds3(count), threaded3(count), fromTransforms3(count);
+        std::vector<Matrix4x4> worlds4(count), fromTransforms4(count);
+        hierarchy.Update(locals3.data(), worlds3.data(), 1);
+        hierarchy.Update(locals3.data(), threaded3.data(), 3);
+        hierarchy.Update(locals.data(), fromTransforms3.data(), 2);
+        hierarchy.Update(locals4.data(), worlds4.data(), 3);
+        hierarchy.Update(locals.data(), fromTransforms4.data(), 1);
+        auto close = [](const xo::Vector4& a, const xo::Vector4& b) {
+            return xo::Abs(a.x - b.x) < 1e-3f && xo::Abs(a.y - b.y) < 1e-3f && xo::Abs(a.z - b.z) < 1e-3f && xo::Abs(a.w - b.w) < 1e-3f;
+        };
+        bool matches = true, threadsMatch = true, transformsMatch = true, matrices4Match = true;
+        for (size_t i = 0; i < count; ++i) {
+            for (int r = 0; r < 3; ++r) {
+                matches &= close(worlds3[i].r[r], expected[i].r[r]);
+                threadsMatch &= memcmp(&threaded3[i].r[r], &worlds3[i].r[r], sizeof(float) * 4) == 0;
+                transformsMatch &= close(fromTransforms3[i].r[r], expected[i].r[r]) && close(fromTransforms4[i].r[r], expected[i].r[r]);
+                matrices4Match &= close(worlds4[i].r[r], expected[i].r[r]);
+            }
+            matrices4Match &= close(worlds4[i].r[3], xo::Vector4(0.0f, 0.0f, 0.0f, 1.0f));
+        }
+        test.ReportSuccessIf(matches, TEST_MSG("Update doesn't match multiplying node by node"));
+        test.ReportSuccessIf(threadsMatch, TEST_MSG("Update depends on the number of threads"));
+        test.ReportSuccessIf(transformsMatch, TEST_MSG("Update of Transforms doesn't match their matrices"));
+        test.ReportSuccessIf(matrices4Match, TEST_MSG("Update of Matrix4x4 doesn't match Matrix3x4"));
+
+        // In place, on a copy of the hierarchy.
+        const Hierarchy copy = hierarchy;
+        std::vector<Matrix3x4> inPlace = locals3;
+        copy.Update(inPlace.data(), inPlace.data(), 3);
+        test.ReportSuccessIf(memcmp(inPlace.data(), threaded3.data(), sizeof(Matrix3x4) * count) == 0, TEST_MSG("updating in place doesn't match"));
+
+        // Renumbered in level order, with the local transforms permuted to match.
+        std::vector<uint32_t> levelParents(count);
+        std::vector<Matrix3x4> levelLocals(count), levelWorlds(count);
+        hierarchy.LevelOrderParents(levelParents.data());
+        xo::Morton::Permute(locals3.data(), hierarchy.Nodes(), count, levelLocals.data());
+        const Hierarchy levelOrder(levelParents.data(), count);
+        levelOrder.Update(levelLocals.data(), levelWorlds.data(), 3);
+        bool levelOrderMatches = levelOrder.IsLevelOrder() && !hierarchy.IsLevelOrder() && levelOrder.LevelCount() == hierarchy.LevelCount();
+        for (size_t i = 0; i < count; ++i) {
+            levelOrderMatches &= memcmp(&levelWorlds[i], &threaded3[hierarchy.Nodes()[i]], sizeof(Matrix3x4)) == 0;
+        }
+        test.ReportSuccessIf(levelOrderMatches, TEST_MSG("renumbering in level order changes the result"));
+    });
+}
+
 int main() {
 
 #if defined(XO_SSE)
@@ -653,6 +2712,31 @@ int main() {
     TestVector3Methods();
     TestVector4Operators();
     TestVector4Methods();
+    TestVector3Stream();
+    TestMatrix4x4Methods();
+    TestQuaternionMethods();
+    TestTrig();
+    TestPrecision();
+    TestRandom();
+    TestRandomArrays();
+    TestAABB();
+    TestFrustum();
+    TestRay();
+    TestBVH();
+    TestBoundingSphere();
+    TestPlane();
+    TestSegment();
+    TestTriangle();
+    TestOBB();
+    TestSpatialHashGrid();
+    TestGJK();
+    TestEPA();
+    TestMorton();
+    TestMatrix3x4();
+    TestTransform();
+    TestDualQuaternion();
+    TestSkinning();
+    TestHierarchy();
 
     auto m = xo::Matrix4x4::RotationDegrees(20.0f, 30.0f, 40.0f);
 
@@ -10,18 +10,52 @@ var g_SourceInputName = 'xo-math.cpp';
 var g_SourceInputText = null;
 
 var g_IncludeNames = [
+  'AABB.h',
+  'AABBInline.h',
+  'BoundingSphere.h',
+  'BoundingSphereInline.h',
+  'BVH.h',
   'DetectSIMD.h',
+  'DualQuaternion.h',
+  'DualQuaternionInline.h',
+  'EPA.h',
+  'EPAInline.h',
+  'Frustum.h',
+  'FrustumInline.h',
+  'GJK.h',
+  'GJKInline.h',
+  'Hierarchy.h',
+  'Matrix3x4.h',
+  'Matrix3x4Inline.h',
   'Matrix4x4.h',
   'Matrix4x4Inline.h',
+  'Morton.h',
+  'MortonInline.h',
+  'OBB.h',
+  'Parallel.h',
+  'Plane.h',
+  'PlaneInline.h',
   'Quaternion.h',
   'QuaternionInline.h',
+  'Random.h',
+  'Ray.h',
+  'RayInline.h',
+  'Segment.h',
+  'Skinning.h',
+  'SpatialHashGrid.h',
   'SSE.h',
+  'Transform.h',
+  'TransformInline.h',
+  'Triangle.h',
+  'Trig.h',
   'Vector2.h',
   'Vector2Inline.h',
   'Vector3.h',
   'Vector3Inline.h',
+  'Vector3Stream.h',
   'Vector4.h',
   'Vector4Inline.h',
+  'Wide.h',
 ];
 var g_IncludesText = [];
 for(var i = 0; i < g_IncludeNames.length; ++i) {
@@ -34,11 +68,32 @@ var g_StraightCopyIncludes = [
 ];
 
 var g_SourcesNames = [
+  'AABB.cpp',
+  'BoundingSphere.cpp',
+  'BVH.cpp',
+  'DualQuaternion.cpp',
+  'EPA.cpp',
+  'Frustum.cpp',
+  'GJK.cpp',
+  'Hierarchy.cpp',
+  'Matrix3x4.cpp',
   'Matrix4x4.cpp',
+  'Morton.cpp',
+  'OBB.cpp',
+  'Plane.cpp',
   'Quaternion.cpp',
+  'Random.cpp',
+  'Ray.cpp',
+  'Segment.cpp',
+  'Skinning.cpp',
+  'SpatialHashGrid.cpp',
   'SSE.cpp',
+  'Transform.cpp',
+  'Triangle.cpp',
+  'Trig.cpp',
   'Vector2.cpp',
   'Vector3.cpp',
+  'Vector3Stream.cpp',
   'Vector4.cpp'
 ];
 var g_SourcesText = [];
@@ -0,0 +1,169 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief An axis aligned bounding box, stored as its minimum and maximum corners.
+//!
+//! With SSE each corner is one xmm register, so union, intersection and the containment and overlap tests are a 
+//! handful of vertical min, max and compare instructions with no per-axis branches.
+//!
+//! A box is empty when min is greater than max on any axis. AABB::Empty is the identity for AABB::Union and 
+//! AABB::Expand, so bounds can be accumulated starting from it.
+//! @sa https://en.wikipedia.org/wiki/Minimum_bounding_box#Axis-aligned_minimum_bounding_box
+class _XOSIMDALIGN AABB {
+public:
+    //>See
+    //! @name Constructors
+    //! @{
+    AABB() { } //!< Performs no initialization.
+    AABB(const Vector3& min, const Vector3& max) : min(min), max(max) { } //!< Assigns the two corners.
+    //! @}
+
+    //>See
+    //! @name Set / Get Methods
+    //! @{
+
+    //! Set all. Assigns the two corners.
+    AABB& Set(const Vector3& min, const Vector3& max) {
+        this->min = min;
+        this->max = max;
+        return *this;
+    }
+    //! The point halfway between min and max.
+    _XOINL Vector3 Center() const;
+    //! Half of the size of the box on each axis.
+    _XOINL Vector3 Extents() const;
+    //! The size of the box on each axis, max - min.
+    _XOINL Vector3 Size() const;
+    //! The total area of the six faces. Useful as a cost when building bounding volume hierarchies.
+    float SurfaceArea() const;
+    //! The product of the size on each axis.
+    float Volume() const;
+    //! Returns true if min is greater than max on any axis.
+    _XOINL bool IsEmpty() const;
+    //! @}
+
+    //>See
+    //! @name Special Operators
+    //! @{
+
+    //! Overloads the new and delete operators for AABB when memory alignment is required (such as with SSE).
+    //! @sa XO_16ALIGNED_MALLOC, XO_16ALIGNED_FREE
+    _XO_OVERLOAD_NEW_DELETE();
+    //! @}
+
+    //>See
+    //! @name Methods
+    //! @{
+
+    //! Grows the box just enough to contain point.
+    _XOINL AABB& Expand(const Vector3& point);
+    //! Grows the box just enough to contain box. The same as the union of this box and box.
+    _XOINL AABB& Expand(const AABB& box);
+    //! Moves each face outward by amount. A negative amount shrinks the box, which may leave it empty.
+    _XOINL AABB& Expand(float amount);
+    //! Returns true if point is inside the box or on its surface.
+    _XOINL bool Contains(const Vector3& point) const;
+    //! Returns true if every point of box is inside this box or on its surface.
+    _XOINL bool Contains(const AABB& box) const;
+    //! Returns true if the boxes share any point, including when they only touch.
+    _XOINL bool Overlaps(const AABB& box) const;
+    //! The point of the box, including its inside, closest to point: point clamped to the box on each axis.
+    _XOINL Vector3 ClosestPoint(const Vector3& point) const;
+    //! The squared distance from point to the box, zero when it's inside.
+    _XOINL float DistanceSquared(const Vector3& point) const;
+    //! outPoints[i] is the point of the box closest to points[i], for wide::Width points per iteration. outPoints is 
+    //! resized to points.Size(), and may be points. When outDistancesSquared isn't null it must hold as many floats.
+    void ClosestPoints(const Vector3Stream& points, Vector3Stream& outPoints, float* outDistancesSquared = nullptr) const;
+    //! The corner of the box furthest along direction. Makes AABB a shape for GJK and EPA.
+    _XOINL Vector3 Support(const Vector3& direction) const;
+    //! Returns this box transformed by m. See AABB::Transform.
+    AABB Transformed(const Matrix4x4& m) const {
+        AABB box;
+        Transform(*this, m, box);
+        return box;
+    }
+    //! @}
+
+    //>See
+    //! @name Static Methods
+    //! @{
+
+    //! A box with its center at center, reaching extents away from it on each axis.
+    static AABB FromCenterExtents(const Vector3& center, const Vector3& extents) {
+        return AABB(center - extents, center + extents);
+    }
+    //! The smallest box containing count points. Returns AABB::Empty when count is zero.
+    static AABB FromPoints(const Vector3* points, size_t count);
+    //! Assigns outBox the smallest box containing both a and b.
+    _XOINL static void Union(const AABB& a, const AABB& b, AABB& outBox);
+    //! Assigns outBox the region shared by a and b. Returns false, leaving outBox empty, if they don't overlap.
+    _XOINL static bool Intersection(const AABB& a, const AABB& b, AABB& outBox);
+    //! Assigns outBox the smallest axis aligned box containing box transformed by m.
+    //!
+    //! Uses Arvo's method in its center and extents form: the center is transformed as a point and the new extents are 
+    //! the old extents transformed by the absolute value of the upper 3x3 of m. The result is exact for any affine m, 
+    //! at the cost of one point and one direction transform instead of eight corner transforms. The bottom row of m is 
+    //! ignored. box must not be empty.
+    //! @sa https://www.researchgate.net/publication/247398734_Transforming_Axis-Aligned_Bounding_Boxes
+    static void Transform(const AABB& box, const Matrix4x4& m, AABB& outBox);
+    //! Transforms count boxes from boxes by m, writing the results to outBoxes. See AABB::Transform.
+    //! boxes and outBoxes may be the same array.
+    //!
+    //! The columns of m and their absolute values are loaded once for the whole array, leaving each box to cost only 
+    //! vertical multiply-adds.
+    static void TransformArray(const Matrix4x4& m, const AABB* boxes, AABB* outBoxes, size_t count);
+
+    //! Returns the smallest box containing both a and b.
+    static AABB Union(const AABB& a, const AABB& b) {
+        AABB box;
+        Union(a, b, box);
+        return box;
+    }
+    //! @}
+
+#ifndef XO_NO_OSTREAM
+    //>See
+    //! @name Extras
+    //! @{
+
+    //! Prints both corners of box to the provided ostream.
+    friend std::ostream& operator <<(std::ostream& os, const AABB& box) {
+        os << "(min:" << box.min << ", max:" << box.max << ")";
+        return os;
+    }
+    //! @}
+#endif
+
+    ////////////////////////////////////////////////////////////////////////// Static Attributes
+    // See: http://xo-math.rtfd.io/en/latest/classes/aabb.html#public_static_attributes
+    //! Infinite min and negative infinite max. Expanding it by anything gives that thing back.
+    static const AABB Empty;
+
+    ////////////////////////////////////////////////////////////////////////// Members
+    // See: http://xo-math.rtfd.io/en/latest/classes/aabb.html#public_members
+    Vector3 min; //!< The corner with the smallest value on every axis.
+    Vector3 max; //!< The corner with the largest value on every axis.
+};
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,169 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+XOMATH_BEGIN_XO_NS();
+
+Vector3 AABB::Center() const {
+#if defined(XO_SSE)
+    return Vector3(_mm_mul_ps(_mm_add_ps(min.xmm, max.xmm), _mm_set1_ps(0.5f)));
+#else
+    return (min + max) * 0.5f;
+#endif
+}
+
+Vector3 AABB::Extents() const {
+#if defined(XO_SSE)
+    return Vector3(_mm_mul_ps(_mm_sub_ps(max.xmm, min.xmm), _mm_set1_ps(0.5f)));
+#else
+    return (max - min) * 0.5f;
+#endif
+}
+
+Vector3 AABB::Size() const {
+#if defined(XO_SSE)
+    return Vector3(_mm_sub_ps(max.xmm, min.xmm));
+#else
+    return max - min;
+#endif
+}
+
+bool AABB::IsEmpty() const {
+#if defined(XO_SSE)
+    // only x, y and z take part, w is whatever the corners were built with.
+    return (_mm_movemask_ps(_mm_cmplt_ps(max.xmm, min.xmm)) & 7) != 0;
+#else
+    return max.x < min.x || max.y < min.y || max.z < min.z;
+#endif
+}
+
+AABB& AABB::Expand(const Vector3& point) {
+#if defined(XO_SSE)
+    min.xmm = _mm_min_ps(min.xmm, point.xmm);
+    max.xmm = _mm_max_ps(max.xmm, point.xmm);
+#else
+    Vector3::Min(min, point, min);
+    Vector3::Max(max, point, max);
+#endif
+    return *this;
+}
+
+AABB& AABB::Expand(const AABB& box) {
+    Union(*this, box, *this);
+    return *this;
+}
+
+AABB& AABB::Expand(float amount) {
+#if defined(XO_SSE)
+    const __m128 a = _mm_set1_ps(amount);
+    min.xmm = _mm_sub_ps(min.xmm, a);
+    max.xmm = _mm_add_ps(max.xmm, a);
+#else
+    min -= amount;
+    max += amount;
+#endif
+    return *this;
+}
+
+bool AABB::Contains(const Vector3& point) const {
+#if defined(XO_SSE)
+    const __m128 inside = _mm_and_ps(_mm_cmple_ps(min.xmm, point.xmm), _mm_cmple_ps(point.xmm, max.xmm));
+    return (_mm_movemask_ps(inside) & 7) == 7;
+#else
+    return min.x <= point.x && point.x <= max.x &&
+           min.y <= point.y && point.y <= max.y &&
+           min.z <= point.z && point.z <= max.z;
+#endif
+}
+
+bool AABB::Contains(const AABB& box) const {
+#if defined(XO_SSE)
+    const __m128 inside = _mm_and_ps(_mm_cmple_ps(min.xmm, box.min.xmm), _mm_cmple_ps(box.max.xmm, max.xmm));
+    return (_mm_movemask_ps(inside) & 7) == 7;
+#else
+    return min.x <= box.min.x && box.max.x <= max.x &&
+           min.y <= box.min.y && box.max.y <= max.y &&
+           min.z <= box.min.z && box.max.z <= max.z;
+#endif
+}
+
+bool AABB::Overlaps(const AABB& box) const {
+#if defined(XO_SSE)
+    const __m128 overlap = _mm_and_ps(_mm_cmple_ps(min.xmm, box.max.xmm), _mm_cmple_ps(box.min.xmm, max.xmm));
+    return (_mm_movemask_ps(overlap) & 7) == 7;
+#else
+    return min.x <= box.max.x && box.min.x <= max.x &&
+           min.y <= box.max.y && box.min.y <= max.y &&
+           min.z <= box.max.z && box.min.z <= max.z;
+#endif
+}
+
+Vector3 AABB::ClosestPoint(const Vector3& point) const {
+#if defined(XO_SSE)
+    return Vector3(_mm_min_ps(_mm_max_ps(point.xmm, min.xmm), max.xmm));
+#else
+    return Vector3(Clamp(point.x, min.x, max.x), Clamp(point.y, min.y, max.y), Clamp(point.z, min.z, max.z));
+#endif
+}
+
+float AABB::DistanceSquared(const Vector3& point) const {
+#if defined(XO_SSE)
+    // how far outside each face the point is, zero on the axes where it's between them.
+    const __m128 outside = _mm_max_ps(_mm_max_ps(_mm_sub_ps(min.xmm, point.xmm), _mm_sub_ps(point.xmm, max.xmm)), _mm_setzero_ps());
+    const __m128 squared = _mm_mul_ps(outside, outside);
+    return _mm_cvtss_f32(squared) + _mm_cvtss_f32(_mm_shuffle_ps(squared, squared, _MM_SHUFFLE(1, 1, 1, 1))) + 
+           _mm_cvtss_f32(_mm_shuffle_ps(squared, squared, _MM_SHUFFLE(2, 2, 2, 2)));
+#else
+    return Vector3::DistanceSquared(point, ClosestPoint(point));
+#endif
+}
+
+Vector3 AABB::Support(const Vector3& direction) const {
+#if defined(XO_SSE)
+    const __m128 negative = _mm_cmplt_ps(direction.xmm, _mm_setzero_ps());
+    return Vector3(_mm_or_ps(_mm_and_ps(negative, min.xmm), _mm_andnot_ps(negative, max.xmm)));
+#else
+    return Vector3(direction.x < 0.0f ? min.x : max.x, direction.y < 0.0f ? min.y : max.y, direction.z < 0.0f ? min.z : max.z);
+#endif
+}
+
+void AABB::Union(const AABB& a, const AABB& b, AABB& outBox) {
+#if defined(XO_SSE)
+    outBox.min.xmm = _mm_min_ps(a.min.xmm, b.min.xmm);
+    outBox.max.xmm = _mm_max_ps(a.max.xmm, b.max.xmm);
+#else
+    Vector3::Min(a.min, b.min, outBox.min);
+    Vector3::Max(a.max, b.max, outBox.max);
+#endif
+}
+
+bool AABB::Intersection(const AABB& a, const AABB& b, AABB& outBox) {
+#if defined(XO_SSE)
+    outBox.min.xmm = _mm_max_ps(a.min.xmm, b.min.xmm);
+    outBox.max.xmm = _mm_min_ps(a.max.xmm, b.max.xmm);
+#else
+    Vector3::Max(a.min, b.min, outBox.min);
+    Vector3::Min(a.max, b.max, outBox.max);
+#endif
+    return !outBox.IsEmpty();
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
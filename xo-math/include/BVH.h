@@ -0,0 +1,139 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief A four wide bounding volume hierarchy over primitives given by their bounds, for ray casts, overlap and 
+//! visibility queries over large scenes.
+//!
+//! The hierarchy is built top down with the binned surface area heuristic (SAH). The largest nodes are binned by 
+//! several threads at once and independent subtrees are built on separate threads. Each node holds the boxes of up to 
+//! four children as a structure of arrays (a QBVH), so every query tests all four children of a node in one go with 
+//! SSE, and a node is exactly two cache lines.
+//!
+//! Primitives are identified by their index in the array the hierarchy was built from. Every subtree covers a 
+//! contiguous run of BVH::Indices, so a subtree that is found to be entirely inside a query is reported without 
+//! visiting it.
+//!
+//! Queries write primitive indices to an output array that must hold at least PrimitiveCount() entries, and return 
+//! how many were written. A primitive is reported when the box of its leaf passes the query, so with leaves larger 
+//! than one primitive the results are candidates for an exact test.
+//! @sa https://en.wikipedia.org/wiki/Bounding_volume_hierarchy, AABB::SurfaceArea
+class BVH {
+public:
+    //! @brief A node of the hierarchy: the bounds of up to four children, stored per axis.
+    //!
+    //! A slot with count zero is empty. Otherwise it holds count primitives, either directly as a leaf when 
+    //! child & LeafBit is set, with child & ~LeafBit the first of them in BVH::Indices, or under the node at index 
+    //! child. The primitives of the slots follow each other in BVH::Indices in slot order.
+    struct Node {
+        float minX[4], minY[4], minZ[4];
+        float maxX[4], maxY[4], maxZ[4];
+        uint32_t child[4];
+        uint32_t count[4];
+    };
+
+    //! Set in Node::child for slots holding primitives directly.
+    static const uint32_t LeafBit = 0x80000000u;
+    //! The largest number of primitives a leaf can be asked to hold.
+    static const int MaxLeafSize = 16;
+
+    //>See
+    //! @name Constructors
+    //! @{
+    BVH(); //!< An empty hierarchy, performs no allocation.
+    BVH(const BVH& bvh); //!< Copy constructor, copies every node.
+    BVH(BVH&& bvh); //!< Move constructor, takes the arrays of bvh leaving it empty.
+    ~BVH();
+    //! @}
+
+    //>See
+    //! @name Operators
+    //! @{
+    BVH& operator = (const BVH& bvh);
+    BVH& operator = (BVH&& bvh);
+    //! @}
+
+    //>See
+    //! @name Building
+    //! @{
+
+    //! Builds the hierarchy over count primitives with the given bounds, replacing any previous one. Ranges of up to 
+    //! leafSize primitives (at most MaxLeafSize) become leaves. threadCount threads are used, or one per hardware 
+    //! thread when it's zero.
+    void Build(const AABB* bounds, size_t count, int leafSize = 4, unsigned threadCount = 0);
+    //! Builds the hierarchy over count triangles, triangle i being vertices[i * 3], vertices[i * 3 + 1] and 
+    //! vertices[i * 3 + 2]. See BVH::Build.
+    void BuildTriangles(const Vector3* vertices, size_t count, int leafSize = 4, unsigned threadCount = 0);
+    //! Updates every node for new bounds of the same primitives, keeping the tree's structure. Much faster than a 
+    //! rebuild for animated primitives, but the tree's quality falls as they move away from where it was built.
+    void Refit(const AABB* bounds);
+    //! Refits for new positions of the triangles the hierarchy was built from. See BVH::Refit.
+    void RefitTriangles(const Vector3* vertices);
+    //! Frees the hierarchy.
+    void Clear();
+    //! @}
+
+    //>See
+    //! @name Queries
+    //! @{
+
+    //! Finds the closest triangle hit by ray, where vertices is the array the hierarchy was built from with 
+    //! BVH::BuildTriangles. inOutT, outU and outV work as with Ray::IntersectTriangle, and on a hit outIndex is the 
+    //! index of the triangle. Children are visited nearest first, and skipped once they start beyond the closest hit.
+    bool IntersectTriangles(const Ray& ray, const Vector3* vertices, float& inOutT, float& outU, float& outV, uint32_t& outIndex) const;
+    //! Writes the primitives of every leaf that ray hits between 0 and maxT.
+    size_t QueryRay(const Ray& ray, float maxT, uint32_t* outIndices) const;
+    //! Writes the primitives of every leaf that overlaps box.
+    size_t QueryAABB(const AABB& box, uint32_t* outIndices) const;
+    //! Writes the primitives of every leaf that frustum doesn't cull. Planes are dropped for subtrees that are inside 
+    //! them, as with Frustum::IntersectsAABB.
+    size_t QueryFrustum(const Frustum& frustum, uint32_t* outIndices) const;
+    //! @}
+
+    //>See
+    //! @name Get Methods
+    //! @{
+
+    //! The box around every primitive, or AABB::Empty when there are none.
+    AABB Bounds() const;
+    //! The number of primitives the hierarchy was built over.
+    size_t PrimitiveCount() const { return primitiveCount; }
+    //! The number of nodes in use. The root is node 0.
+    size_t NodeCount() const { return nodeCount; }
+    //! The nodes, aligned to 64 bytes.
+    const Node* Nodes() const { return nodes; }
+    //! Primitive indices in the order the leaves refer to them.
+    const uint32_t* Indices() const { return indices; }
+    //! @}
+
+private:
+    void Allocate(size_t nodes, size_t primitives);
+    void Release();
+
+    Node* nodes;
+    uint32_t* indices;
+    size_t nodeCount;
+    size_t primitiveCount;
+};
+
+XOMATH_END_XO_NS();
\ No newline at end of file
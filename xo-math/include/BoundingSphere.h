@@ -0,0 +1,144 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief A sphere stored as its center and radius, for bounding volumes that stay valid under rotation.
+//!
+//! A sphere is empty when its radius is negative. BoundingSphere::Empty is the identity for BoundingSphere::Expand, 
+//! so bounds can be accumulated starting from it.
+//!
+//! BoundingSphere::FromPoints and BoundingSphere::FromPointsRitter fit a sphere to a point cloud in two passes over 
+//! it, testing wide::Width points (4 with SSE, 8 with AVX) per iteration. Neither finds the smallest sphere; 
+//! BoundingSphere::FromPointsExact does, but is many times slower.
+//! @sa https://en.wikipedia.org/wiki/Bounding_sphere
+class _XOSIMDALIGN BoundingSphere {
+public:
+    //>See
+    //! @name Constructors
+    //! @{
+    BoundingSphere() { } //!< Performs no initialization.
+    BoundingSphere(const Vector3& center, float radius) : center(center), radius(radius) { } //!< Assigns each named value accordingly.
+    //! @}
+
+    //>See
+    //! @name Set / Get Methods
+    //! @{
+
+    //! Set all. Assigns each named value accordingly.
+    BoundingSphere& Set(const Vector3& center, float radius) {
+        this->center = center;
+        this->radius = radius;
+        return *this;
+    }
+    //! Returns true if the radius is negative.
+    bool IsEmpty() const {
+        return radius < 0.0f;
+    }
+    //! @}
+
+    //>See
+    //! @name Special Operators
+    //! @{
+
+    //! Overloads the new and delete operators for BoundingSphere when memory alignment is required (such as with SSE).
+    //! @sa XO_16ALIGNED_MALLOC, XO_16ALIGNED_FREE
+    _XO_OVERLOAD_NEW_DELETE();
+    //! @}
+
+    //>See
+    //! @name Methods
+    //! @{
+
+    //! Grows the sphere just enough to contain point, moving its center toward point by as much as the radius grows. 
+    //! This is the step Ritter's method takes for every point outside its sphere.
+    _XOINL BoundingSphere& Expand(const Vector3& point);
+    //! Grows the sphere to the smallest one containing both this sphere and sphere.
+    _XOINL BoundingSphere& Expand(const BoundingSphere& sphere);
+    //! Returns true if point is inside the sphere or on its surface.
+    _XOINL bool Contains(const Vector3& point) const;
+    //! Returns true if every point of sphere is inside this sphere or on its surface.
+    _XOINL bool Contains(const BoundingSphere& sphere) const;
+    //! Returns true if the spheres share any point, including when they only touch.
+    _XOINL bool Overlaps(const BoundingSphere& sphere) const;
+    //! The point of the sphere furthest along direction, or its center when direction is zero. Makes BoundingSphere a 
+    //! shape for GJK and EPA.
+    _XOINL Vector3 Support(const Vector3& direction) const;
+    //! @}
+
+    //>See
+    //! @name Static Methods
+    //! @{
+
+    //! A sphere containing count points, found with the EPOS-14 method of Larsson. Returns BoundingSphere::Empty 
+    //! when count is zero.
+    //!
+    //! The first pass finds the two extreme points along each of seven directions, the three axes and the four 
+    //! diagonals of the unit cube. The smallest sphere around those fourteen points is then grown over a second pass 
+    //! as in Ritter's method. The result is typically within a few percent of the smallest sphere.
+    //!
+    //! Clouds of a few hundred thousand points or more are split between threadCount threads, or one per hardware 
+    //! thread when it's zero. Each thread grows its own copy of the starting sphere over its share of the points, 
+    //! and the merged result can be slightly larger than a single thread's.
+    //! @sa http://www.ep.liu.se/ecp/034/009/ecp083409.pdf
+    static BoundingSphere FromPoints(const Vector3* points, size_t count, unsigned threadCount = 0);
+    //! A sphere containing count points, found with Ritter's method: the sphere around the farthest apart pair of 
+    //! extreme points on the three axes, grown over a second pass to contain every point. Slightly faster than 
+    //! BoundingSphere::FromPoints, but typically 5 to 20 percent larger than the smallest sphere. threadCount is as 
+    //! in BoundingSphere::FromPoints.
+    //! @sa https://en.wikipedia.org/wiki/Bounding_sphere#Ritter.27s_bounding_sphere
+    static BoundingSphere FromPointsRitter(const Vector3* points, size_t count, unsigned threadCount = 0);
+    //! The smallest sphere containing count points, found with Welzl's algorithm in double precision.
+    //!
+    //! The expected running time is linear when the points are in random order, but ordered input such as points 
+    //! sorted along an axis can take far longer, so shuffle it first. Meant for offline use and as a reference for 
+    //! the faster fits.
+    //! @sa https://en.wikipedia.org/wiki/Smallest-circle_problem#Welzl.27s_algorithm
+    static BoundingSphere FromPointsExact(const Vector3* points, size_t count);
+    //! @}
+
+#ifndef XO_NO_OSTREAM
+    //>See
+    //! @name Extras
+    //! @{
+
+    //! Prints the center and radius of sphere to the provided ostream.
+    friend std::ostream& operator <<(std::ostream& os, const BoundingSphere& sphere) {
+        os << "(center:" << sphere.center << ", radius:" << sphere.radius << ")";
+        return os;
+    }
+    //! @}
+#endif
+
+    ////////////////////////////////////////////////////////////////////////// Static Attributes
+    // See: http://xo-math.rtfd.io/en/latest/classes/boundingsphere.html#public_static_attributes
+    //! A sphere at the origin with a radius of -1. Expanding it by anything gives that thing back.
+    static const BoundingSphere Empty;
+
+    ////////////////////////////////////////////////////////////////////////// Members
+    // See: http://xo-math.rtfd.io/en/latest/classes/boundingsphere.html#public_members
+    Vector3 center;
+    float radius; //!< Negative when the sphere is empty.
+};
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,78 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+XOMATH_BEGIN_XO_NS();
+
+BoundingSphere& BoundingSphere::Expand(const Vector3& point) {
+    if (IsEmpty()) {
+        return Set(point, 0.0f);
+    }
+    const Vector3 offset = point - center;
+    const float distanceSquared = offset.MagnitudeSquared();
+    if (distanceSquared > radius * radius) {
+        // the new sphere touches point and the far side of the old one.
+        const float distance = Sqrt(distanceSquared);
+        const float grownRadius = (radius + distance) * 0.5f;
+        center += offset * ((grownRadius - radius) / distance);
+        radius = grownRadius;
+    }
+    return *this;
+}
+
+BoundingSphere& BoundingSphere::Expand(const BoundingSphere& sphere) {
+    if (sphere.IsEmpty() || Contains(sphere)) {
+        return *this;
+    }
+    if (IsEmpty() || sphere.Contains(*this)) {
+        return *this = sphere;
+    }
+    const Vector3 offset = sphere.center - center;
+    const float distance = offset.Magnitude();
+    const float grownRadius = (distance + radius + sphere.radius) * 0.5f;
+    center += offset * ((grownRadius - radius) / distance);
+    radius = grownRadius;
+    return *this;
+}
+
+bool BoundingSphere::Contains(const Vector3& point) const {
+    return Vector3::DistanceSquared(center, point) <= radius * radius && !IsEmpty();
+}
+
+bool BoundingSphere::Contains(const BoundingSphere& sphere) const {
+    if (sphere.IsEmpty()) {
+        return true;
+    }
+    const float room = radius - sphere.radius;
+    return room >= 0.0f && Vector3::DistanceSquared(center, sphere.center) <= room * room;
+}
+
+bool BoundingSphere::Overlaps(const BoundingSphere& sphere) const {
+    const float reach = radius + sphere.radius;
+    return Vector3::DistanceSquared(center, sphere.center) <= reach * reach && !IsEmpty() && !sphere.IsEmpty();
+}
+
+Vector3 BoundingSphere::Support(const Vector3& direction) const {
+    const float lengthSquared = direction.MagnitudeSquared();
+    return lengthSquared > 0.0f ? center + direction * (radius / Sqrt(lengthSquared)) : center;
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
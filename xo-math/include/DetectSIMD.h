@@ -19,7 +19,9 @@
 // OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
 // THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
-#if defined(_MSC_VER)
+#if defined(XO_NO_SIMD)
+    // every simd flag is left undefined, forcing the scalar paths regardless of compiler flags.
+#elif defined(_MSC_VER)
 #   if defined(_M_ARM)
         // note: directx defines _XM_ARM_NEON_INTRINSICS_ if _M_ARM is defined, 
         // so we're assuming under msvc that it's all that's required to determine neon support...
@@ -50,6 +52,12 @@
 #       define XO_SSE4_2 1
 #       define XO_AVX 1
 #       define XO_AVX2 1
+        // msvc emits fused multiply-add for /arch:AVX2
+#       define XO_FMA 1
+        // msvc has no flag of its own for bmi2, every cpu with avx2 has it.
+#       if defined(_M_X64)
+#           define XO_BMI2 1
+#       endif
 #   endif
 //! @todo add AVX512 for msvc when it exists.
 #elif defined(__clang__) || defined (__GNUC__)
@@ -77,6 +85,12 @@
 #   if defined(__AVX2__)
 #       define XO_AVX2 1
 #   endif
+#   if defined(__FMA__)
+#       define XO_FMA 1
+#   endif
+#   if defined(__BMI2__) && defined(__x86_64__)
+#       define XO_BMI2 1
+#   endif
 #   if defined(__AVX512__) || defined(__AVX512F__)
 #       define XO_AVX512 1
 #   endif
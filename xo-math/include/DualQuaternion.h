@@ -0,0 +1,113 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief A rigid transformation, a rotation and a translation, held as a pair of quaternions.
+//!
+//! The real part is the rotation and the dual part is half the translation, as a pure quaternion, times the rotation. 
+//! Unlike a matrix, a weighted sum of unit dual quaternions normalizes back to a rigid transformation with no shrinking 
+//! or shear, which is why they blend bones well: see Skinning::DualQuaternionBlend. As with Quaternion, methods other 
+//! than DualQuaternion::Normalize expect unit dual quaternions.
+//! @sa https://en.wikipedia.org/wiki/Dual_quaternion
+class _XOSIMDALIGN DualQuaternion {
+public:
+    //>See
+    //! @name Constructors
+    //! @{
+    DualQuaternion(); //!< Performs no initialization.
+    //! Specify each part.
+    DualQuaternion(const Quaternion& real, const Quaternion& dual);
+    //! The rotation then the translation, with real set to rotation and dual to 0.5 * (translation, 0) * rotation.
+    DualQuaternion(const Quaternion& rotation, const Vector3& translation);
+    //! The rotation and translation of t, whose scale is ignored.
+    explicit DualQuaternion(const Transform& t);
+    //! @}
+
+    //>See
+    //! @name Special Operators
+    //! @{
+
+    //! Overloads the new and delete operators for DualQuaternion when memory alignment is required (such as with SSE).
+    //! @sa XO_16ALIGNED_MALLOC, XO_16ALIGNED_FREE
+    _XO_OVERLOAD_NEW_DELETE();
+    //! @}
+
+    //>See
+    //! @name Operators
+    //! @{
+
+    //! @sa DualQuaternion::Multiply
+    _XOINL DualQuaternion& operator *= (const DualQuaternion& q);
+    //! @sa DualQuaternion::Multiply
+    _XOINL DualQuaternion operator * (const DualQuaternion& q) const;
+    //! Transforms point v. See DualQuaternion::TransformPoint.
+    _XOINL Vector3 operator * (const Vector3& v) const;
+    //! @}
+
+    //>See
+    //! @name Methods
+    //! @{
+
+    //! The rotation, which is the real part.
+    const Quaternion& GetRotation() const { return real; }
+    //! The translation, the vector part of 2 * dual * conjugate(real).
+    _XOINL Vector3 GetTranslation() const;
+    //! Returns point v rotated then translated.
+    _XOINL Vector3 TransformPoint(const Vector3& v) const;
+    //! Returns direction v rotated, ignoring the translation.
+    _XOINL Vector3 TransformDirection(const Vector3& v) const;
+    //! Scales both parts so the real part has a magnitude of one, then removes the part of dual along real so that the 
+    //! two are orthogonal, making this a unit dual quaternion. The result for a zero real part is undefined.
+    DualQuaternion& Normalize();
+    DualQuaternion Normalized() const { return DualQuaternion(*this).Normalize(); }
+    //! Conjugates both quaternions, which inverts a unit dual quaternion.
+    DualQuaternion& MakeInverse();
+    DualQuaternion Inverse() const { return DualQuaternion(*this).MakeInverse(); }
+    //! The equivalent Matrix3x4.
+    void ToMatrix(Matrix3x4& outMatrix) const;
+    //! The equivalent Transform, with a scale of one.
+    Transform ToTransform() const { return Transform(GetTranslation(), real); }
+    //! @}
+
+    //>See
+    //! @name Static Methods
+    //! @{
+
+    //! Assigns outQuat to a * b, the transformation applying b then a. outQuat may be a or b.
+    //!
+    //! The real part is a.real * b.real and the dual part a.real * b.dual + a.dual * b.real.
+    _XOINL static void Multiply(const DualQuaternion& a, const DualQuaternion& b, DualQuaternion& outQuat);
+    //! Interpolates from a to b by t, taking the shorter path, and normalizes the result. This is the blend used for 
+    //! skinning, reduced to two weights.
+    static void Nlerp(const DualQuaternion& a, const DualQuaternion& b, float t, DualQuaternion& outQuat);
+    //! @}
+
+    Quaternion real;
+    Quaternion dual;
+
+    static const DualQuaternion
+        Identity; //!< No rotation and no translation.
+};
+
+XOMATH_END_XO_NS();
\ No newline at end of file
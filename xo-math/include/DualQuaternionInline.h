@@ -0,0 +1,76 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+XOMATH_BEGIN_XO_NS();
+
+DualQuaternion& DualQuaternion::operator *= (const DualQuaternion& q) {
+    Multiply(*this, q, *this);
+    return *this;
+}
+
+DualQuaternion DualQuaternion::operator * (const DualQuaternion& q) const {
+    DualQuaternion result;
+    Multiply(*this, q, result);
+    return result;
+}
+
+Vector3 DualQuaternion::operator * (const Vector3& v) const {
+    return TransformPoint(v);
+}
+
+Vector3 DualQuaternion::GetTranslation() const {
+    // The vector part of 2 * dual * conjugate(real): 2 * (real.w * dual.xyz - dual.w * real.xyz + real.xyz x dual.xyz)
+#if defined(XO_SSE)
+    const __m128 r = real.xmm, d = dual.xmm;
+    const __m128 rYZX = _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 c = _mm_sub_ps(_mm_mul_ps(r, _mm_shuffle_ps(d, d, _MM_SHUFFLE(3, 0, 2, 1))), _mm_mul_ps(rYZX, d));
+    c = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+    const __m128 t = _mm_sub_ps(sse::MulAdd(_mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3)), d, c), 
+                                _mm_mul_ps(_mm_shuffle_ps(d, d, _MM_SHUFFLE(3, 3, 3, 3)), r));
+    return Vector3(_mm_add_ps(t, t));
+#else
+    const Vector3 r(real.x, real.y, real.z), d(dual.x, dual.y, dual.z);
+    return ((d * real.w) - (r * dual.w) + r.Cross(d)) * 2.0f;
+#endif
+}
+
+Vector3 DualQuaternion::TransformPoint(const Vector3& v) const {
+    return Transform::Rotate(real, v) + GetTranslation();
+}
+
+Vector3 DualQuaternion::TransformDirection(const Vector3& v) const {
+    return Transform::Rotate(real, v);
+}
+
+void DualQuaternion::Multiply(const DualQuaternion& a, const DualQuaternion& b, DualQuaternion& outQuat) {
+    // Every part of a and b is read before anything is written, so outQuat may alias either input.
+    const Quaternion real = a.real * b.real;
+    const Quaternion dualLeft = a.real * b.dual, dualRight = a.dual * b.real;
+#if defined(XO_SSE)
+    outQuat.dual.xmm = _mm_add_ps(dualLeft.xmm, dualRight.xmm);
+#else
+    outQuat.dual = Quaternion(dualLeft.x + dualRight.x, dualLeft.y + dualRight.y, dualLeft.z + dualRight.z, dualLeft.w + dualRight.w);
+#endif
+    outQuat.real = real;
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,94 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief The expanding polytope algorithm (EPA): how deeply two overlapping convex shapes overlap, and in which 
+//! direction to move them apart.
+//!
+//! Shapes are as for GJK. When GJK finds the origin inside the Minkowski difference of the shapes, EPA grows its 
+//! simplex into a polytope inside the difference, each step pushing out the face closest to the origin to the support 
+//! point beyond it, until that face lies on the difference's surface. The face's normal and its distance from the 
+//! origin are the penetration normal and depth.
+//!
+//! The polytope has room for EPA::MaxVertices points and lives on the stack. Curved shapes are approached to within 
+//! EPA::Tolerance of their size, or until the polytope is full.
+//! @sa GJK
+class EPA {
+public:
+    //! The most points EPA adds to the polytope before it settles on its closest face.
+    static const int MaxIterations = 64;
+    //! The most points the polytope holds.
+    static const int MaxVertices = 128;
+    //! The most faces the polytope holds, enough for a closed polytope of MaxVertices points.
+    static const int MaxFaces = MaxVertices * 2;
+    //! A face is on the surface of the difference when the support point beyond it is no further than this, relative 
+    //! to the size of the difference.
+    static const float Tolerance;
+
+    //! @brief The convex polytope EPA grows, with every face's normal pointing away from the origin inside it.
+    struct Polytope {
+        struct Face {
+            Vector3 normal;     //!< The unit normal, pointing out.
+            float distance;     //!< The face's distance from the origin along normal.
+            int vertices[3];    //!< Counterclockwise seen from outside.
+        };
+
+        //! Starts from the tetrahedron of simplex's four points. Returns false when the tetrahedron is flat.
+        bool Start(const GJK::Simplex& simplex);
+        //! Adds the point supportA - supportB, replacing the faces that can see it with faces joining it to the 
+        //! edges around them. Returns false, leaving the polytope as it was, when the point sees no face or there's 
+        //! no room for it.
+        bool Expand(const Vector3& supportA, const Vector3& supportB);
+        //! The index of the face closest to the origin.
+        int ClosestFace() const;
+        //! The points of A and B that met at the point of face closest to the origin.
+        void Contact(int face, Vector3& outPointA, Vector3& outPointB) const;
+
+        Vector3 points[MaxVertices];
+        Vector3 supportsA[MaxVertices];
+        Vector3 supportsB[MaxVertices];
+        Face faces[MaxFaces];
+        int vertexCount;
+        int faceCount;
+        float size;             //!< The distance of the furthest starting point from the origin.
+    };
+
+    //>See
+    //! @name Queries
+    //! @{
+
+    //! When shapes a and b overlap, finds outNormal, the unit direction from A towards B to move B by outDepth to 
+    //! separate them, and outPointA and outPointB, the points of each shape furthest into the other, and returns 
+    //! true. Returns false when they don't overlap. Shapes that only touch give a depth near zero. cache is the 
+    //! GJK::Cache of the pair, and is left holding outNormal.
+    template <class ShapeA, class ShapeB>
+    static bool Penetration(const ShapeA& a, const ShapeB& b, Vector3& outNormal, float& outDepth, Vector3& outPointA, Vector3& outPointB, GJK::Cache* cache = nullptr);
+    //! @}
+
+private:
+    template <class ShapeA, class ShapeB>
+    static bool Complete(const ShapeA& a, const ShapeB& b, GJK::Simplex& simplex);
+};
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,107 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+XOMATH_BEGIN_XO_NS();
+
+template <class ShapeA, class ShapeB>
+bool EPA::Complete(const ShapeA& a, const ShapeB& b, GJK::Simplex& simplex) {
+    // GJK stops with fewer than four points when the origin is on the simplex, which happens when the shapes touch. 
+    // Support points in directions away from the simplex make it a tetrahedron, with the origin on its surface.
+    float size = 0.0f;
+    for (int p = 0; p < simplex.count; ++p) {
+        size = Max(size, simplex.points[p].Magnitude());
+    }
+    const float apart = Tolerance * Max(size, 1e-6f);
+    if (simplex.count == 1) {
+        for (int axis = 0; axis < 6 && simplex.count == 1; ++axis) {
+            Vector3 direction(0.0f);
+            direction[axis % 3] = axis < 3 ? 1.0f : -1.0f;
+            const Vector3 supportA = a.Support(direction), supportB = b.Support(-direction);
+            if (Vector3::DistanceSquared(supportA - supportB, simplex.points[0]) > apart * apart) {
+                simplex.Add(supportA, supportB);
+            }
+        }
+    }
+    if (simplex.count == 2) {
+        const Vector3 line = (simplex.points[1] - simplex.points[0]).Normalized();
+        // crossed with the axis the line is least along, for two directions perpendicular to it.
+        const Vector3 axis = Abs(line.x) <= Abs(line.y) && Abs(line.x) <= Abs(line.z) ? Vector3::UnitX : Abs(line.y) <= Abs(line.z) ? Vector3::UnitY : Vector3::UnitZ;
+        const Vector3 across = line.Cross(axis).Normalized(), across2 = line.Cross(across);
+        for (int turn = 0; turn < 6 && simplex.count == 2; ++turn) {
+            const float angle = turn * (PI / 3.0f);
+            const Vector3 direction = across * Cos(angle) + across2 * Sin(angle);
+            const Vector3 supportA = a.Support(direction), supportB = b.Support(-direction);
+            const Vector3 fromLine = supportA - supportB - simplex.points[0];
+            if ((fromLine - line * fromLine.Dot(line)).MagnitudeSquared() > apart * apart) {
+                simplex.Add(supportA, supportB);
+            }
+        }
+    }
+    if (simplex.count == 3) {
+        const Vector3 normal = (simplex.points[1] - simplex.points[0]).Cross(simplex.points[2] - simplex.points[0]).Normalized();
+        for (int side = 0; side < 2 && simplex.count == 3; ++side) {
+            const Vector3 direction = side ? -normal : normal;
+            const Vector3 supportA = a.Support(direction), supportB = b.Support(-direction);
+            if (Abs((supportA - supportB - simplex.points[0]).Dot(normal)) > apart) {
+                simplex.Add(supportA, supportB);
+            }
+        }
+    }
+    return simplex.count == 4;
+}
+
+template <class ShapeA, class ShapeB>
+bool EPA::Penetration(const ShapeA& a, const ShapeB& b, Vector3& outNormal, float& outDepth, Vector3& outPointA, Vector3& outPointB, GJK::Cache* cache) {
+    GJK::Simplex simplex;
+    if (!GJK::Run(a, b, simplex, cache, true)) {
+        return false;
+    }
+    Polytope polytope;
+    if (!Complete(a, b, simplex) || !polytope.Start(simplex)) {
+        // the difference is flat, so the shapes touch without overlapping.
+        // the cache points from B towards A, as the closest point of the difference does.
+        outNormal = cache && cache->direction.MagnitudeSquared() > 0.0f ? -cache->direction.Normalized() : Vector3::UnitX;
+        outDepth = 0.0f;
+        outPointA = outPointB = simplex.PointA();
+        return true;
+    }
+    int face = polytope.ClosestFace();
+    for (int i = 0; i < MaxIterations; ++i) {
+        const Polytope::Face& closest = polytope.faces[face];
+        const Vector3 supportA = a.Support(closest.normal), supportB = b.Support(-closest.normal);
+        const float distance = (supportA - supportB).Dot(closest.normal);
+        // the difference reaches no further past the face than the tolerance, so the face is on its surface.
+        if (distance - closest.distance <= Tolerance * Max(distance, polytope.size) || !polytope.Expand(supportA, supportB)) {
+            break;
+        }
+        face = polytope.ClosestFace();
+    }
+    outNormal = polytope.faces[face].normal;
+    outDepth = Max(polytope.faces[face].distance, 0.0f);
+    polytope.Contact(face, outPointA, outPointB);
+    if (cache) {
+        cache->direction = -outNormal;
+    }
+    return true;
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
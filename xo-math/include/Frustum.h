@@ -0,0 +1,132 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+XOMATH_BEGIN_XO_NS();
+
+//! The range of clip space depth that a projection matrix maps the near and far planes to.
+enum class ClipDepth {
+    ZeroToOne,          //!< Direct3D, Metal and Vulkan.
+    NegativeOneToOne    //!< OpenGL.
+};
+
+//! @brief A view frustum as six inward facing planes, for visibility culling.
+//!
+//! Each plane is a Vector4 holding a unit normal in x, y, z and the distance term in w, so that a point p is on the 
+//! inside of the plane when \f$plane.x p.x + plane.y p.y + plane.z p.z + plane.w \geq 0\f$.
+//!
+//! Planes are also addressed by bit in a plane mask, so a hierarchy can skip the planes a parent volume is entirely 
+//! inside of when testing its children (plane coherency). The single volume tests narrow a mask as they go, and the 
+//! batch kernels take one to apply to every object.
+//!
+//! Sphere and box tests are conservative: an object near a corner of the frustum may be reported as visible while 
+//! outside, but a visible object is never culled.
+//! @sa http://www.cs.otago.ac.nz/postgrads/alexis/planeExtraction.pdf
+class _XOSIMDALIGN Frustum {
+public:
+    //! Plane indices. Plane i is bit (1 << i) of a plane mask.
+    enum PlaneIndex {
+        Left,
+        Right,
+        Bottom,
+        Top,
+        Near,
+        Far,
+        PlaneCount
+    };
+    //! A plane mask selecting every plane.
+    static const uint32_t AllPlanes = (1 << PlaneCount) - 1;
+
+    //>See
+    //! @name Constructors
+    //! @{
+    Frustum() { } //!< Performs no initialization.
+    //! Extracts the planes of viewProjection. See Frustum::Set.
+    Frustum(const Matrix4x4& viewProjection, ClipDepth depth = ClipDepth::ZeroToOne) {
+        Set(viewProjection, depth);
+    }
+    //! @}
+
+    //>See
+    //! @name Set / Get Methods
+    //! @{
+
+    //! Set all. Extracts the planes from the rows of viewProjection with the Gribb-Hartmann method, and normalizes them.
+    //! viewProjection maps world space points to clip space as viewProjection * Vector4(p, 1), the way 
+    //! Matrix4x4::TransformPoints applies a matrix. For a matrix built to multiply row vectors, pass its transpose.
+    //! depth selects where the near plane is taken from. The far plane of an infinite projection is left as zero, which 
+    //! every object passes.
+    Frustum& Set(const Matrix4x4& viewProjection, ClipDepth depth = ClipDepth::ZeroToOne);
+    //! @}
+
+    //>See
+    //! @name Special Operators
+    //! @{
+
+    //! Overloads the new and delete operators for Frustum when memory alignment is required (such as with SSE).
+    //! @sa XO_16ALIGNED_MALLOC, XO_16ALIGNED_FREE
+    _XO_OVERLOAD_NEW_DELETE();
+    //! @}
+
+    //>See
+    //! @name Methods
+    //! @{
+
+    //! Returns true if point is inside or on every plane.
+    _XOINL bool Contains(const Vector3& point) const;
+    //! Returns true if a sphere may be visible.
+    _XOINL bool IntersectsSphere(const Vector3& center, float radius) const;
+    //! Returns true if a sphere may be visible, testing only the planes in inOutPlaneMask. On a true return, the bits of 
+    //! planes the sphere is entirely inside of are cleared from inOutPlaneMask, leaving the mask its children need.
+    //! When inOutPlaneMask becomes zero the sphere is entirely inside the frustum.
+    _XOINL bool IntersectsSphere(const Vector3& center, float radius, uint32_t& inOutPlaneMask) const;
+    //! Returns true if box may be visible.
+    _XOINL bool IntersectsAABB(const AABB& box) const;
+    //! Returns true if box may be visible, testing only the planes in inOutPlaneMask. See the sphere variant for how the 
+    //! mask is narrowed.
+    _XOINL bool IntersectsAABB(const AABB& box, uint32_t& inOutPlaneMask) const;
+    //! @}
+
+    //>See
+    //! @name Batch Methods
+    //! Test wide::Width objects (4 with SSE, 8 with AVX) per iteration against the planes in planeMask, with no 
+    //! per-object branches. Each returns the number of visible objects.
+    //!
+    //! The bit variants set bit (i % 32) of outVisibleBits[i / 32] when object i is visible. outVisibleBits must hold 
+    //! (count + 31) / 32 words, all of which are written. The index variants write the index of each visible object to 
+    //! outIndices in ascending order. outIndices must hold count indices.
+    //! @{
+
+    //! Spheres are stored as a center in x, y, z and a radius in w.
+    size_t CullSpheres(const Vector4* spheres, size_t count, uint32_t* outVisibleBits, uint32_t planeMask = AllPlanes) const;
+    //! Spheres are stored as a center in x, y, z and a radius in w.
+    size_t CullSpheresIndices(const Vector4* spheres, size_t count, uint32_t* outIndices, uint32_t planeMask = AllPlanes) const;
+    size_t CullAABBs(const AABB* boxes, size_t count, uint32_t* outVisibleBits, uint32_t planeMask = AllPlanes) const;
+    size_t CullAABBsIndices(const AABB* boxes, size_t count, uint32_t* outIndices, uint32_t planeMask = AllPlanes) const;
+    //! @}
+
+    ////////////////////////////////////////////////////////////////////////// Members
+    // See: http://xo-math.rtfd.io/en/latest/classes/frustum.html#public_members
+    //! Inward facing planes, indexed by Frustum::PlaneIndex.
+    Vector4 planes[PlaneCount];
+};
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,84 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+XOMATH_BEGIN_XO_NS();
+
+bool Frustum::Contains(const Vector3& point) const {
+    for (int i = 0; i < PlaneCount; ++i) {
+        const Vector4& p = planes[i];
+        if (p.x * point.x + p.y * point.y + p.z * point.z + p.w < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Frustum::IntersectsSphere(const Vector3& center, float radius) const {
+    uint32_t planeMask = AllPlanes;
+    return IntersectsSphere(center, radius, planeMask);
+}
+
+bool Frustum::IntersectsSphere(const Vector3& center, float radius, uint32_t& inOutPlaneMask) const {
+    uint32_t mask = inOutPlaneMask;
+    for (int i = 0; i < PlaneCount; ++i) {
+        if (inOutPlaneMask & (1 << i)) {
+            const Vector4& p = planes[i];
+            const float distance = p.x * center.x + p.y * center.y + p.z * center.z + p.w;
+            if (distance < -radius) {
+                return false;
+            }
+            if (distance >= radius) {
+                mask &= ~(1 << i);
+            }
+        }
+    }
+    inOutPlaneMask = mask;
+    return true;
+}
+
+bool Frustum::IntersectsAABB(const AABB& box) const {
+    uint32_t planeMask = AllPlanes;
+    return IntersectsAABB(box, planeMask);
+}
+
+bool Frustum::IntersectsAABB(const AABB& box, uint32_t& inOutPlaneMask) const {
+    const Vector3 center = box.Center(), extents = box.Extents();
+    uint32_t mask = inOutPlaneMask;
+    for (int i = 0; i < PlaneCount; ++i) {
+        if (inOutPlaneMask & (1 << i)) {
+            const Vector4& p = planes[i];
+            const float distance = p.x * center.x + p.y * center.y + p.z * center.z + p.w;
+            // how far the box reaches toward the plane, along its normal.
+            const float radius = Abs(p.x) * extents.x + Abs(p.y) * extents.y + Abs(p.z) * extents.z;
+            if (distance < -radius) {
+                return false;
+            }
+            if (distance >= radius) {
+                mask &= ~(1 << i);
+            }
+        }
+    }
+    inOutPlaneMask = mask;
+    return true;
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
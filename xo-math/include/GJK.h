@@ -0,0 +1,130 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief The Gilbert-Johnson-Keerthi (GJK) algorithm: distance, closest points and overlap between two convex 
+//! shapes.
+//!
+//! A shape is any type with a method <tt>Vector3 Support(const Vector3& direction) const</tt> returning one of its 
+//! points furthest along direction (which needn't be normalized). AABB, OBB, BoundingSphere, Segment and Triangle are 
+//! shapes, GJK::Hull is the convex hull of an array of points, and GJK::Rounded grows any shape by a radius, which 
+//! makes capsules from segments. The queries are templates over both shapes, so their support functions inline.
+//!
+//! GJK searches the Minkowski difference of the shapes, every point of A minus every point of B, for the point 
+//! closest to the origin, using simplices of up to four of its points found with the support functions. The shapes 
+//! overlap when the difference holds the origin. Curved shapes are approached to within a relative tolerance.
+//!
+//! Passing the same GJK::Cache to the queries of a pair of shapes each frame starts each search from the last one's 
+//! answer, which for shapes that moved a little usually finishes in one or two steps.
+//! @sa EPA, https://en.wikipedia.org/wiki/Gilbert%E2%80%93Johnson%E2%80%93Keerthi_distance_algorithm
+class GJK {
+public:
+    //! The most support points a query looks for before it settles on the best answer found.
+    static const int MaxIterations = 64;
+    //! The search stops when a new support point brings the closest point this much closer, relative to its distance.
+    static const float Tolerance;
+
+    //! What a query of a pair of shapes leaves for the next one.
+    struct Cache {
+        Cache() : direction(0.0f) { } //!< An empty cache, the first query starts from scratch.
+        //! The direction of the last closest point of the Minkowski difference, or the reverse of the last EPA normal, 
+        //! so either way from B towards A. Zero when there's no last query.
+        Vector3 direction;
+    };
+
+    //! @brief Up to four points of the Minkowski difference, the state of a query.
+    //!
+    //! GJK::Run leaves the simplex closest to the origin, or one holding it when the shapes overlap, which is where EPA 
+    //! starts.
+    struct Simplex {
+        Vector3 points[4];      //!< supportsA[i] - supportsB[i].
+        Vector3 supportsA[4];   //!< The points of A the points came from.
+        Vector3 supportsB[4];   //!< The points of B the points came from.
+        float weights[4];       //!< The barycentric weights of the point closest to the origin.
+        int count;              //!< The number of points in use.
+
+        //! Adds a point from supports of each shape.
+        void Add(const Vector3& supportA, const Vector3& supportB) {
+            supportsA[count] = supportA;
+            supportsB[count] = supportB;
+            points[count] = supportA - supportB;
+            weights[count] = 0.0f;
+            ++count;
+        }
+        //! Finds the point of the simplex closest to the origin and keeps only the points needed to express it, in 
+        //! their order. The origin is inside when all four points are kept.
+        Vector3 Reduce();
+        //! Whether point is already one of the simplex's.
+        bool Contains(const Vector3& point) const;
+        //! The closest point of A, the weighted sum of supportsA.
+        Vector3 PointA() const;
+        //! The closest point of B, the weighted sum of supportsB.
+        Vector3 PointB() const;
+    };
+
+    //! A shape grown by radius in every direction, the set of points within radius of it. A rounded Segment is a 
+    //! capsule and a rounded Triangle or OBB has rounded edges. Holds a reference to the shape, which must outlive it.
+    template <class Shape>
+    struct Rounded {
+        Rounded(const Shape& shape, float radius) : shape(shape), radius(radius) { }
+        Vector3 Support(const Vector3& direction) const {
+            const float lengthSquared = direction.MagnitudeSquared();
+            const Vector3 point = shape.Support(direction);
+            return lengthSquared > 0.0f ? point + direction * (radius / Sqrt(lengthSquared)) : point;
+        }
+        const Shape& shape;
+        float radius;
+    };
+
+    //! The convex hull of count points, such as the vertices of a convex mesh. The points aren't copied, and needn't 
+    //! all be corners of the hull. The support function tests wide::Width points at a time.
+    struct Hull {
+        Hull(const Vector3* points, size_t count) : points(points), count(count) { }
+        Vector3 Support(const Vector3& direction) const;
+        const Vector3* points;
+        size_t count;
+    };
+
+    //>See
+    //! @name Queries
+    //! @{
+
+    //! Whether shapes a and b overlap, including touching to within GJK::Tolerance. Stops at the first direction that 
+    //! separates them, so it's quicker than GJK::Distance.
+    template <class ShapeA, class ShapeB>
+    static bool Intersects(const ShapeA& a, const ShapeB& b, Cache* cache = nullptr);
+    //! Returns the distance between shapes a and b, with outPointA and outPointB the closest points of each. When the 
+    //! shapes overlap the distance is zero and both points are set to the same point of A. See EPA for how deep they 
+    //! overlap.
+    template <class ShapeA, class ShapeB>
+    static float Distance(const ShapeA& a, const ShapeB& b, Vector3& outPointA, Vector3& outPointB, Cache* cache = nullptr);
+    //! The search both queries run: finds the simplex closest to the origin of the Minkowski difference of a and b, 
+    //! and returns whether it holds the origin. With stopWhenSeparated it returns as soon as a direction separating the 
+    //! shapes is found, leaving the simplex unfinished.
+    template <class ShapeA, class ShapeB>
+    static bool Run(const ShapeA& a, const ShapeB& b, Simplex& outSimplex, Cache* cache, bool stopWhenSeparated);
+    //! @}
+};
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,95 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+XOMATH_BEGIN_XO_NS();
+
+template <class ShapeA, class ShapeB>
+bool GJK::Run(const ShapeA& a, const ShapeB& b, Simplex& outSimplex, Cache* cache, bool stopWhenSeparated) {
+    // v is the point of the simplex closest to the origin. Each step adds the support point of the difference 
+    // furthest towards the origin from v, w, and moves v to the closest point of the new simplex.
+    const Vector3 start = cache && cache->direction.MagnitudeSquared() > 0.0f ? cache->direction : Vector3::UnitX;
+    outSimplex.count = 0;
+    outSimplex.Add(a.Support(-start), b.Support(start));
+    outSimplex.weights[0] = 1.0f;
+    Vector3 v = outSimplex.points[0];
+    bool inside = false;
+    for (int i = 0; i < MaxIterations; ++i) {
+        const float vv = v.MagnitudeSquared();
+        float largest = 0.0f;
+        for (int p = 0; p < outSimplex.count; ++p) {
+            largest = Max(largest, outSimplex.points[p].MagnitudeSquared());
+        }
+        // the origin is on the simplex, to within the precision of its points.
+        if (vv <= Tolerance * Tolerance * largest) {
+            inside = true;
+            break;
+        }
+        const Vector3 supportA = a.Support(-v), supportB = b.Support(v);
+        const Vector3 w = supportA - supportB;
+        const float vw = v.Dot(w);
+        // every point of the difference is on the far side of the plane through w facing v, and so is the origin.
+        if (stopWhenSeparated && vw > 0.0f) {
+            break;
+        }
+        // w is no closer to the origin than v along v, so v is as close as the difference gets.
+        if (vv - vw <= Tolerance * vv || outSimplex.Contains(w)) {
+            break;
+        }
+        const Simplex last = outSimplex;
+        outSimplex.Add(supportA, supportB);
+        const Vector3 closer = outSimplex.Reduce();
+        if (outSimplex.count == 4) {
+            inside = true;
+            break;
+        }
+        // rounding in a sliver of a simplex can give a point further away, which would only send the search in circles.
+        if (closer.MagnitudeSquared() >= vv) {
+            outSimplex = last;
+            break;
+        }
+        v = closer;
+    }
+    if (cache && !inside) {
+        cache->direction = v;
+    }
+    return inside;
+}
+
+template <class ShapeA, class ShapeB>
+bool GJK::Intersects(const ShapeA& a, const ShapeB& b, Cache* cache) {
+    Simplex simplex;
+    return Run(a, b, simplex, cache, true);
+}
+
+template <class ShapeA, class ShapeB>
+float GJK::Distance(const ShapeA& a, const ShapeB& b, Vector3& outPointA, Vector3& outPointB, Cache* cache) {
+    Simplex simplex;
+    if (Run(a, b, simplex, cache, false)) {
+        outPointA = outPointB = simplex.PointA();
+        return 0.0f;
+    }
+    outPointA = simplex.PointA();
+    outPointB = simplex.PointB();
+    return (outPointA - outPointB).Magnitude();
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
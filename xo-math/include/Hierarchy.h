@@ -0,0 +1,122 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief The levels of a tree of nodes given by the index of each node's parent, to compute world transforms from 
+//! local ones a level at a time.
+//!
+//! A scene graph flattened to arrays gives each node the index of its parent, or Hierarchy::NoParent for a root. The 
+//! world transform of a node is the world transform of its parent times its own local transform, so a node can only 
+//! be done once its parent is, but the nodes of one level (the same number of ancestors) don't depend on each other. 
+//! A Hierarchy sorts the nodes by level once, then each Update walks the levels in order and splits the wider ones 
+//! over threads, synchronizing only between levels.
+//!
+//! Building allocates and walks the tree, and should be redone only when the tree's shape changes. Update allocates 
+//! no memory of its own, so it can run every frame. It's fastest on nodes numbered in level order, see 
+//! Hierarchy::LevelOrderParents.
+//! @sa https://en.wikipedia.org/wiki/Scene_graph
+class Hierarchy {
+public:
+    static const uint32_t NoParent = 0xFFFFFFFF; //!< The parent of a root node.
+
+    //>See
+    //! @name Constructors
+    //! @{
+    Hierarchy(); //!< An empty hierarchy, performs no allocation.
+    //! The hierarchy of count nodes whose parents are given by parents. See Hierarchy::Build.
+    Hierarchy(const uint32_t* parents, size_t count);
+    Hierarchy(const Hierarchy& hierarchy); //!< Copy constructor, copies the levels.
+    Hierarchy(Hierarchy&& hierarchy); //!< Move constructor, takes the arrays of hierarchy leaving it empty.
+    ~Hierarchy();
+    //! @}
+
+    //>See
+    //! @name Set / Get Methods
+    //! @{
+
+    //! Sorts count nodes into levels, where parents[i] is the index of the parent of node i or Hierarchy::NoParent. 
+    //! Parents may come before or after their children. Memory is reused when the count doesn't grow.
+    void Build(const uint32_t* parents, size_t count);
+    //! The number of nodes.
+    size_t Size() const { return size; }
+    //! The number of levels, one more than the depth of the deepest node.
+    size_t LevelCount() const { return levelCount; }
+    //! The nodes level by level, roots first. Nodes of the same level keep their order.
+    const uint32_t* Nodes() const { return nodes; }
+    //! The parent of each node of Hierarchy::Nodes, in the same order.
+    const uint32_t* Parents() const { return parents; }
+    //! Where each level starts in Hierarchy::Nodes, followed by Hierarchy::Size: level l is Nodes()[LevelOffsets()[l]] 
+    //! up to Nodes()[LevelOffsets()[l + 1]].
+    const uint32_t* LevelOffsets() const { return levelOffsets; }
+    //! True when every node already comes after all the nodes of lower levels, so Hierarchy::Nodes is 0, 1, 2...
+    bool IsLevelOrder() const { return levelOrder; }
+    //! Writes to outParents, which must hold Hierarchy::Size entries, the parent of each node once the nodes are 
+    //! renumbered in the order of Hierarchy::Nodes. A hierarchy built from outParents is in level order.
+    //!
+    //! Update reads the nodes of a level scattered through the arrays when they aren't in level order, which costs 
+    //! more than the multiplies on large trees. Keeping a scene's arrays in level order, by building from these parents 
+    //! and permuting its local transforms and other node data with Morton::Permute and Hierarchy::Nodes, lets Update 
+    //! read them straight through.
+    void LevelOrderParents(uint32_t* outParents) const;
+    //! @}
+
+    //>See
+    //! @name Operators
+    //! @{
+    Hierarchy& operator = (const Hierarchy& hierarchy);
+    Hierarchy& operator = (Hierarchy&& hierarchy);
+    //! @}
+
+    //>See
+    //! @name Updating
+    //! @{
+
+    //! Assigns outWorlds[i] to outWorlds[parent] * locals[i], or locals[i] for a root, for every node i. As with 
+    //! Matrix4x4::Multiply the parent is applied after the child. outWorlds may be locals.
+    //!
+    //! threadCount threads are used, or one per hardware thread when it's zero. Levels too narrow to be worth 
+    //! splitting are done by the calling thread alone. The result doesn't depend on the number of threads.
+    void Update(const Matrix4x4* locals, Matrix4x4* outWorlds, unsigned threadCount = 0) const;
+    //! World matrices of affine local matrices. See Hierarchy::Update.
+    void Update(const Matrix3x4* locals, Matrix3x4* outWorlds, unsigned threadCount = 0) const;
+    //! World matrices of local transforms, each converted as Transform::ToMatrix does. See Hierarchy::Update.
+    void Update(const Transform* locals, Matrix3x4* outWorlds, unsigned threadCount = 0) const;
+    //! World matrices of local transforms, each converted as Transform::ToMatrix does. See Hierarchy::Update.
+    void Update(const Transform* locals, Matrix4x4* outWorlds, unsigned threadCount = 0) const;
+    //! @}
+
+private:
+    void Allocate(size_t count);
+    void Release();
+
+    uint32_t* nodes;
+    uint32_t* parents;
+    uint32_t* levelOffsets;
+    size_t size;
+    size_t capacity;
+    size_t levelCount;
+    bool levelOrder;
+};
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,183 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief An affine transformation stored as the top three rows of a Matrix4x4, whose bottom row is always 0, 0, 0, 1.
+//!
+//! Most transformations (rotation, scale, shear and translation) are affine, so a Matrix4x4 spends a row on constants. 
+//! Dropping it makes Matrix3x4 48 bytes rather than 64, three SSE registers, and composing two costs 36 multiplies 
+//! rather than 64. Vectors are columns as with Matrix4x4::TransformPoints: the upper left 3x3 is the linear part and 
+//! the fourth column (the w of each row) is the translation. Converting to and from Matrix4x4 is lossless for affine 
+//! matrices.
+//! @sa https://en.wikipedia.org/wiki/Affine_transformation
+class _XOSIMDALIGN Matrix3x4 {
+public:
+    //>See
+    //! @name Constructors
+    //! @{
+    Matrix3x4(); //!< Performs no initialization.
+    //! Specify each element.
+    /*!
+        \f[
+            \begin{bmatrix}
+            m00&m01&m02&m03\\
+            m10&m11&m12&m13\\
+            m20&m21&m22&m23\\
+            0&0&0&1
+            \end{bmatrix}
+        \f]
+    */
+    Matrix3x4(float m00, float m01, float m02, float m03,
+              float m10, float m11, float m12, float m13,
+              float m20, float m21, float m22, float m23);
+    //! Copy constructor, trivial.
+    Matrix3x4(const Matrix3x4& m);
+    //! Specifies each row.
+    Matrix3x4(const Vector4& r0, const Vector4& r1, const Vector4& r2);
+    //! A linear part given one Vector3 per row, and a translation.
+    Matrix3x4(const Vector3& r0, const Vector3& r1, const Vector3& r2, const Vector3& translation);
+    //! The top three rows of m, whose bottom row is assumed to be 0, 0, 0, 1.
+    explicit Matrix3x4(const Matrix4x4& m);
+    //! @}
+
+    //>See
+    //! @name Special Operators
+    //! @{
+
+    //! Overloads the new and delete operators for Matrix3x4 when memory alignment is required (such as with SSE).
+    //! @sa XO_16ALIGNED_MALLOC, XO_16ALIGNED_FREE
+    _XO_OVERLOAD_NEW_DELETE();
+    //! Extracts a const reference of a row, useful for getting rows by index.
+    const Vector4& operator [](int i) const { return r[i]; }
+    //! Extracts a reference of a row, useful for setting rows by index.
+    Vector4& operator [](int i) { return r[i]; }
+    //! Extracts a const reference of a value, useful for getting values by index.
+    const float& operator ()(int r, int c) const { return this->r[r][c]; }
+    //! Extracts a reference of a value, useful for setting values by index.
+    float& operator ()(int r, int c) { return this->r[r][c]; }
+    //! @}
+
+    //>See
+    //! @name Operators
+    //! @{
+
+    //! @sa Matrix3x4::Multiply
+    _XOINL Matrix3x4& operator *= (const Matrix3x4& m);
+    //! @sa Matrix3x4::Multiply
+    _XOINL Matrix3x4 operator * (const Matrix3x4& m) const;
+    //! Transforms point v, applying the translation. See Matrix3x4::TransformPoint.
+    _XOINL Vector3 operator * (const Vector3& v) const;
+    //! @}
+
+    //>See
+    //! @name Methods
+    //! @{
+
+    //! The fourth column.
+    Vector3 GetTranslation() const { return Vector3(r[0].w, r[1].w, r[2].w); }
+    //! Sets the fourth column.
+    Matrix3x4& SetTranslation(const Vector3& t) { r[0].w = t.x; r[1].w = t.y; r[2].w = t.z; return *this; }
+    //! Returns point v transformed by this matrix, treated as having a w of 1 so the translation is applied.
+    _XOINL Vector3 TransformPoint(const Vector3& v) const;
+    //! Returns direction v transformed by this matrix, treated as having a w of 0 so the translation is ignored.
+    _XOINL Vector3 TransformDirection(const Vector3& v) const;
+    //! The determinant of the upper left 3x3, which is also the determinant of the whole affine matrix.
+    float Determinant() const;
+    //! Inverts this matrix: the upper left 3x3 is inverted and the translation is moved back through it. The result of 
+    //! inverting a singular matrix is undefined.
+    void MakeInverse();
+    void GetInverse(Matrix3x4& o) const { o = *this; o.MakeInverse(); }
+    //! Inverts this matrix as Matrix3x4::MakeInverse does, unless it's singular (a determinant of zero), in which case 
+    //! it's left unchanged and false is returned.
+    bool TryMakeInverse();
+    bool TryGetInverse(Matrix3x4& o) const { o = *this; return o.TryMakeInverse(); }
+    //! Inverts this matrix when it's rigid, a rotation and a translation with no scale or shear: the rotation is 
+    //! transposed and the translation rotated back, with no division. The result is undefined for matrices that aren't 
+    //! rigid.
+    void MakeInverseRigid();
+
+    //! Transforms count points from vecs by this matrix, writing the results to outVecs. Points are treated as having a 
+    //! w of 1, so the translation is applied. vecs and outVecs may be the same array.
+    const Matrix3x4& TransformPoints(const Vector3* vecs, Vector3* outVecs, size_t count) const;
+    //! Transforms count directions from vecs by this matrix, writing the results to outVecs. Directions are treated as 
+    //! having a w of 0, so the translation is ignored. vecs and outVecs may be the same array.
+    const Matrix3x4& TransformDirections(const Vector3* vecs, Vector3* outVecs, size_t count) const;
+    //! @}
+
+    //>See
+    //! @name Static Methods
+    //! @{
+
+    //! Assigns outMatrix to a * b, the transformation applying b then a. outMatrix may be a or b.
+    //!
+    //! As with Matrix4x4::Multiply each row of the result is a linear combination of the rows of b, but the implied 
+    //! bottom rows drop a quarter of the work: three multiplies per row of four elements, and the translation of a 
+    //! added in.
+    _XOINL static void Multiply(const Matrix3x4& a, const Matrix3x4& b, Matrix3x4& outMatrix);
+    //! Assigns outMatrices[i] to a[i] * b[i] for count matrices. outMatrices may be a or b.
+    static void MultiplyArray(const Matrix3x4* a, const Matrix3x4* b, Matrix3x4* outMatrices, size_t count);
+    //! Assigns outMatrices[i] to a * b[i] for count matrices, such as a parent transform applied to each of its 
+    //! children. The elements of a are broadcast once for the whole array. outMatrices may be b.
+    static void MultiplyArray(const Matrix3x4& a, const Matrix3x4* b, Matrix3x4* outMatrices, size_t count);
+    //! Inverts count matrices, writing them to outMatrices. See Matrix3x4::MakeInverse. outMatrices may be matrices.
+    static void InverseArray(const Matrix3x4* matrices, Matrix3x4* outMatrices, size_t count);
+    //! @}
+
+    //>See
+    //! @name Extras
+    //! @{
+#ifndef XO_NO_OSTREAM
+    //! Prints the contents of matrix m to the provided ostream in the form of its three row vectors.
+    friend std::ostream& operator <<(std::ostream& os, const Matrix3x4& m) {
+        os << "\nrow 0: " << m.r[0] << "\nrow 1: " << m.r[1] << "\nrow 2: " << m.r[2] << "\n";
+        return os;
+    }
+#endif
+    //! @}
+
+    //! Matrix rows
+    union {
+        Vector4 r[3];
+        float m[12];
+        struct {
+            float   m00, m01, m02, m03,
+                    m10, m11, m12, m13,
+                    m20, m21, m22, m23;
+        };
+    };
+
+    static const Matrix3x4
+        /*!
+        \f[
+            \begin{bmatrix}
+            1&0&0&0\\
+            0&1&0&0\\
+            0&0&1&0
+            \end{bmatrix}
+        \f]
+        */
+        Identity;
+};
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,77 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+XOMATH_BEGIN_XO_NS();
+
+Matrix3x4& Matrix3x4::operator *= (const Matrix3x4& m) {
+    Multiply(*this, m, *this);
+    return *this;
+}
+
+Matrix3x4 Matrix3x4::operator * (const Matrix3x4& m) const {
+    Matrix3x4 result;
+    Multiply(*this, m, result);
+    return result;
+}
+
+Vector3 Matrix3x4::operator * (const Vector3& v) const {
+    return TransformPoint(v);
+}
+
+void Matrix3x4::Multiply(const Matrix3x4& a, const Matrix3x4& b, Matrix3x4& outMatrix) {
+    // result row i = (a[i].x * b[0]) + (a[i].y * b[1]) + (a[i].z * b[2]) + (0, 0, 0, a[i].w)
+    // All of b is read before anything is written, so outMatrix may alias either input.
+#if defined(XO_SSE)
+    const __m128 b0 = b.r[0].xmm, b1 = b.r[1].xmm, b2 = b.r[2].xmm;
+    const __m128 translation = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+#   define _XO_MULTIPLY_ROW(row) \
+        sse::MulAdd(_mm_shuffle_ps(row, row, _MM_SHUFFLE(2, 2, 2, 2)), b2, \
+        sse::MulAdd(_mm_shuffle_ps(row, row, _MM_SHUFFLE(1, 1, 1, 1)), b1, \
+        sse::MulAdd(_mm_shuffle_ps(row, row, _MM_SHUFFLE(0, 0, 0, 0)), b0, _mm_and_ps(row, translation))))
+    const __m128 a0 = a.r[0].xmm, a1 = a.r[1].xmm, a2 = a.r[2].xmm;
+    outMatrix.r[0].xmm = _XO_MULTIPLY_ROW(a0);
+    outMatrix.r[1].xmm = _XO_MULTIPLY_ROW(a1);
+    outMatrix.r[2].xmm = _XO_MULTIPLY_ROW(a2);
+#   undef _XO_MULTIPLY_ROW
+#else
+    const Vector4 b0 = b.r[0], b1 = b.r[1], b2 = b.r[2];
+    for (int i = 0; i < 3; ++i) {
+        const Vector4 row = a.r[i];
+        outMatrix.r[i] = (b0 * row.x) + (b1 * row.y) + (b2 * row.z);
+        outMatrix.r[i].w += row.w;
+    }
+#endif
+}
+
+Vector3 Matrix3x4::TransformPoint(const Vector3& v) const {
+    return Vector3(r[0].x * v.x + r[0].y * v.y + r[0].z * v.z + r[0].w,
+                   r[1].x * v.x + r[1].y * v.y + r[1].z * v.z + r[1].w,
+                   r[2].x * v.x + r[2].y * v.y + r[2].z * v.z + r[2].w);
+}
+
+Vector3 Matrix3x4::TransformDirection(const Vector3& v) const {
+    return Vector3(r[0].x * v.x + r[0].y * v.y + r[0].z * v.z,
+                   r[1].x * v.x + r[1].y * v.y + r[1].z * v.z,
+                   r[2].x * v.x + r[2].y * v.y + r[2].z * v.z);
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
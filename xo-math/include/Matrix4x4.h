@@ -75,6 +75,8 @@ public:
     Matrix4x4(const Vector3& r0, const Vector3& r1, const Vector3& r2);
     //! Creates a rotation matrix from quaternion q.
     Matrix4x4(const class Quaternion& q);
+    //! The affine matrix m, with a bottom row of 0, 0, 0, 1.
+    explicit Matrix4x4(const class Matrix3x4& m);
     //! @}
 
     //! @name Set / Get Methods
@@ -235,6 +237,31 @@ public:
     //! Transforms vector v in place by this matrix.
     const Matrix4x4& Transform(Vector4& v) const;
 
+    //! Transforms count points from vecs by this matrix, writing the results to outVecs. Points are treated as having a w 
+    //! of 1, so the translation of this matrix is applied. vecs and outVecs may be the same array.
+    //!
+    //! The columns of this matrix are loaded once for the whole array and each point costs only vertical 
+    //! multiply-adds, which is much cheaper than calling Matrix4x4::Transform once per point.
+    const Matrix4x4& TransformPoints(const Vector3* vecs, Vector3* outVecs, size_t count) const;
+    //! Transforms count points in vecs in place. See Matrix4x4::TransformPoints.
+    const Matrix4x4& TransformPoints(Vector3* vecs, size_t count) const { return TransformPoints(vecs, vecs, count); }
+    //! Transforms count points stored as tightly packed x, y, z float triples (3 * count floats, no padding) from xyz, 
+    //! writing them to outXyz in the same layout. xyz and outXyz may be the same array.
+    const Matrix4x4& TransformPoints(const float* xyz, float* outXyz, size_t count) const;
+    //! Transforms count packed x, y, z float triples in place. See Matrix4x4::TransformPoints.
+    const Matrix4x4& TransformPoints(float* xyz, size_t count) const { return TransformPoints(xyz, xyz, count); }
+    //! Transforms count directions from vecs by this matrix, writing the results to outVecs. Directions are treated as 
+    //! having a w of 0, so the translation of this matrix is ignored, as with Matrix4x4::Transform. 
+    //! vecs and outVecs may be the same array.
+    const Matrix4x4& TransformDirections(const Vector3* vecs, Vector3* outVecs, size_t count) const;
+    //! Transforms count directions in vecs in place. See Matrix4x4::TransformDirections.
+    const Matrix4x4& TransformDirections(Vector3* vecs, size_t count) const { return TransformDirections(vecs, vecs, count); }
+    //! Transforms count directions stored as tightly packed x, y, z float triples from xyz, writing them to outXyz.
+    //! xyz and outXyz may be the same array.
+    const Matrix4x4& TransformDirections(const float* xyz, float* outXyz, size_t count) const;
+    //! Transforms count packed x, y, z float triples in place. See Matrix4x4::TransformDirections.
+    const Matrix4x4& TransformDirections(float* xyz, size_t count) const { return TransformDirections(xyz, xyz, count); }
+
     //! Returns a copy of this matrix transposed. See Matrix4x4::Transposed
     //! @sa https://en.wikipedia.org/wiki/Transpose
     Matrix4x4 Transposed() const;
@@ -244,6 +271,37 @@ public:
     //! @name Static Methods
     //! @{
 
+    //! Assigns outMatrix to a * b. outMatrix may be a or b.
+    //!
+    //! Each row of the result is built as a linear combination of the rows of b, weighted by the elements of the same 
+    //! row of a. This needs no transpose and no horizontal adds: under AVX two rows are built per instruction.
+    //! @sa https://en.wikipedia.org/wiki/Matrix_multiplication
+    _XOINL static void Multiply(const Matrix4x4& a, const Matrix4x4& b, Matrix4x4& outMatrix);
+    //! Assigns outMatrices[i] to a[i] * b[i] for count matrices. outMatrices may be a or b.
+    static void MultiplyArray(const Matrix4x4* a, const Matrix4x4* b, Matrix4x4* outMatrices, size_t count);
+    //! Assigns outMatrices[i] to a * b[i] for count matrices, such as a parent transform applied to each of its 
+    //! children. The elements of a are broadcast once for the whole array. outMatrices may be b.
+    static void MultiplyArray(const Matrix4x4& a, const Matrix4x4* b, Matrix4x4* outMatrices, size_t count);
+    //! Assigns outMatrices[i] to a[i] * b for count matrices. The rows of b are loaded once for the whole array. 
+    //! outMatrices may be a.
+    static void MultiplyArray(const Matrix4x4* a, const Matrix4x4& b, Matrix4x4* outMatrices, size_t count);
+    //! Inverts count matrices, writing them to outMatrices. outMatrices may be matrices.
+    //!
+    //! Matrices are transposed into lanes (4 at a time with SSE, 8 with AVX) and inverted together with the cofactor 
+    //! expansion, with no shuffles. When every matrix of a group is affine (bottom row of 0, 0, 0, 1) only the upper 
+    //! 3x3 is inverted and the translation is solved directly. As with Matrix4x4::MakeInverse the result of inverting 
+    //! a singular matrix is undefined.
+    static void InverseArray(const Matrix4x4* matrices, Matrix4x4* outMatrices, size_t count);
+    //! Like Matrix4x4::InverseArray, but a singular matrix (determinant of zero) is copied to outMatrices unchanged, as 
+    //! Matrix4x4::TryMakeInverse leaves it. Returns true if every matrix was inverted.
+    //!
+    //! When outSingularMask is provided it must hold (count + 31) / 32 values; bit (i % 32) of outSingularMask[i / 32] 
+    //! is set when matrices[i] was singular.
+    static bool TryInverseArray(const Matrix4x4* matrices, Matrix4x4* outMatrices, size_t count, uint32_t* outSingularMask = nullptr);
+    //! Inverts count rigid matrices: an orthonormal rotation with a translation in the fourth column and a bottom row 
+    //! of 0, 0, 0, 1. The rotation is transposed and the translation rotated back, with no division at all.
+    //! The result is undefined for matrices that are not rigid. outMatrices may be matrices.
+    static void InverseRigidArray(const Matrix4x4* matrices, Matrix4x4* outMatrices, size_t count);
     //! Assigns outMatrix to a scale matrix, where each of x y and z scale values are equal to xyz.
     /*!
     \f[
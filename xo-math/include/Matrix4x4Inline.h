@@ -59,18 +59,59 @@ Matrix4x4& Matrix4x4::operator -= (const Matrix4x4& m) {
 }
 
 Matrix4x4& Matrix4x4::operator *= (const Matrix4x4& m) {
-    auto t = m.Transposed();
-    return (*this) = Matrix4x4(
-        (r[0] * t[0]).Sum(), (r[0] * t[1]).Sum(), (r[0] * t[2]).Sum(), (r[0] * t[3]).Sum(),
-        (r[1] * t[0]).Sum(), (r[1] * t[1]).Sum(), (r[1] * t[2]).Sum(), (r[1] * t[3]).Sum(),
-        (r[2] * t[0]).Sum(), (r[2] * t[1]).Sum(), (r[2] * t[2]).Sum(), (r[2] * t[3]).Sum(),
-        (r[3] * t[0]).Sum(), (r[3] * t[1]).Sum(), (r[3] * t[2]).Sum(), (r[3] * t[3]).Sum()
-    );
+    Multiply(*this, m, *this);
+    return *this;
 }
 
 Matrix4x4 Matrix4x4::operator + (const Matrix4x4& m) const { return Matrix4x4(*this) += m; }
 Matrix4x4 Matrix4x4::operator - (const Matrix4x4& m) const { return Matrix4x4(*this) -= m; }
-Matrix4x4 Matrix4x4::operator * (const Matrix4x4& m) const { return Matrix4x4(*this) *= m; }
+Matrix4x4 Matrix4x4::operator * (const Matrix4x4& m) const {
+    Matrix4x4 result;
+    Multiply(*this, m, result);
+    return result;
+}
+
+void Matrix4x4::Multiply(const Matrix4x4& a, const Matrix4x4& b, Matrix4x4& outMatrix) {
+    // result row i = (a[i].x * b[0]) + (a[i].y * b[1]) + (a[i].z * b[2]) + (a[i].w * b[3])
+    // All of b is read before anything is written, so outMatrix may alias either input.
+#if defined(XO_AVX)
+    const __m256 b0 = _mm256_broadcast_ps(&b.r[0].xmm);
+    const __m256 b1 = _mm256_broadcast_ps(&b.r[1].xmm);
+    const __m256 b2 = _mm256_broadcast_ps(&b.r[2].xmm);
+    const __m256 b3 = _mm256_broadcast_ps(&b.r[3].xmm);
+    const __m256 a01 = _mm256_loadu_ps(a.r[0].f);
+    const __m256 a23 = _mm256_loadu_ps(a.r[2].f);
+    __m256 r01 = _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+    __m256 r23 = _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+    r01 = wide::MulAdd(_mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(1, 1, 1, 1)), b1, r01);
+    r23 = wide::MulAdd(_mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(1, 1, 1, 1)), b1, r23);
+    r01 = wide::MulAdd(_mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(2, 2, 2, 2)), b2, r01);
+    r23 = wide::MulAdd(_mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(2, 2, 2, 2)), b2, r23);
+    r01 = wide::MulAdd(_mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(3, 3, 3, 3)), b3, r01);
+    r23 = wide::MulAdd(_mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(3, 3, 3, 3)), b3, r23);
+    _mm256_storeu_ps(outMatrix.r[0].f, r01);
+    _mm256_storeu_ps(outMatrix.r[2].f, r23);
+#elif defined(XO_SSE)
+    const __m128 b0 = b.r[0].xmm, b1 = b.r[1].xmm, b2 = b.r[2].xmm, b3 = b.r[3].xmm;
+#   define _XO_MULTIPLY_ROW(row) \
+        sse::MulAdd(_mm_shuffle_ps(row, row, _MM_SHUFFLE(3, 3, 3, 3)), b3, \
+        sse::MulAdd(_mm_shuffle_ps(row, row, _MM_SHUFFLE(2, 2, 2, 2)), b2, \
+        sse::MulAdd(_mm_shuffle_ps(row, row, _MM_SHUFFLE(1, 1, 1, 1)), b1, \
+        _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(0, 0, 0, 0)), b0))))
+    const __m128 a0 = a.r[0].xmm, a1 = a.r[1].xmm, a2 = a.r[2].xmm, a3 = a.r[3].xmm;
+    outMatrix.r[0].xmm = _XO_MULTIPLY_ROW(a0);
+    outMatrix.r[1].xmm = _XO_MULTIPLY_ROW(a1);
+    outMatrix.r[2].xmm = _XO_MULTIPLY_ROW(a2);
+    outMatrix.r[3].xmm = _XO_MULTIPLY_ROW(a3);
+#   undef _XO_MULTIPLY_ROW
+#else
+    const Vector4 b0 = b.r[0], b1 = b.r[1], b2 = b.r[2], b3 = b.r[3];
+    for (int i = 0; i < 4; ++i) {
+        const Vector4 row = a.r[i];
+        outMatrix.r[i] = (b0 * row.x) + (b1 * row.y) + (b2 * row.z) + (b3 * row.w);
+    }
+#endif
+}
 
 Vector4 Matrix4x4::operator * (const Vector4& v) const {
     return Vector4((r[0] * v).Sum(), (r[1] * v).Sum(), (r[2] * v).Sum(), (r[3] * v).Sum());
@@ -0,0 +1,107 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief Morton (Z-order) codes of points, and a radix sort to put points in their order.
+//!
+//! A Morton code interleaves the bits of the coordinates of a point's cell in a grid over some bounds, with x in the 
+//! lowest bit. Sorted by their codes, points follow a Z shaped curve through the cells that keeps points near in space 
+//! mostly near in memory, so reordering point clouds, particle buffers or BVH primitives this way makes work on 
+//! neighbourhoods touch far fewer cache lines.
+//!
+//! 30 bit codes give each axis 10 bits, a grid of 1024 cells a side, and fit a uint32_t. 63 bit codes give each axis 
+//! 21 bits and fit a uint64_t. The array and stream encoders find the cells of wide::Width points at a time and spread 
+//! their bits with SIMD shifts and masks, or for 63 bit codes with the BMI2 PDEP instruction when compiled for it.
+//!
+//! Morton::Sort is a least significant digit radix sort of keys, Morton codes or not, each carrying a 32 bit index. 
+//! Morton::Order encodes and sorts in one go, leaving the order to hand to Morton::Permute.
+//! @sa https://en.wikipedia.org/wiki/Z-order_curve, https://en.wikipedia.org/wiki/Radix_sort
+class Morton {
+public:
+    static const uint32_t Max30 = 1023;     //!< The largest cell coordinate of a 30 bit code.
+    static const uint32_t Max63 = 2097151;  //!< The largest cell coordinate of a 63 bit code.
+
+    //>See
+    //! @name Encoding
+    //! @{
+
+    //! The 30 bit code of cell x, y, z. Bits above the tenth of each coordinate are ignored.
+    static uint32_t Encode30(uint32_t x, uint32_t y, uint32_t z);
+    //! The 63 bit code of cell x, y, z. Bits above the 21st of each coordinate are ignored.
+    static uint64_t Encode63(uint32_t x, uint32_t y, uint32_t z);
+    //! The cell of a 30 bit code, the reverse of Encode30.
+    static void Decode30(uint32_t code, uint32_t& outX, uint32_t& outY, uint32_t& outZ);
+    //! The cell of a 63 bit code, the reverse of Encode63.
+    static void Decode63(uint64_t code, uint32_t& outX, uint32_t& outY, uint32_t& outZ);
+
+    //! The 30 bit code of point, in a grid of Max30 + 1 cells a side filling bounds. Points outside bounds get the code 
+    //! of the closest cell.
+    static uint32_t Encode30(const Vector3& point, const AABB& bounds);
+    //! The 63 bit code of point, in a grid of Max63 + 1 cells a side filling bounds. See Morton::Encode30.
+    static uint64_t Encode63(const Vector3& point, const AABB& bounds);
+    //! Writes the 30 bit code of each of count points to outCodes. See Morton::Encode30.
+    static void Encode30(const Vector3* points, size_t count, const AABB& bounds, uint32_t* outCodes);
+    //! Writes the 30 bit code of each point of a stream to outCodes. See Morton::Encode30.
+    static void Encode30(const Vector3Stream& points, const AABB& bounds, uint32_t* outCodes);
+    //! Writes the 63 bit code of each of count points to outCodes. See Morton::Encode63.
+    static void Encode63(const Vector3* points, size_t count, const AABB& bounds, uint64_t* outCodes);
+    //! Writes the 63 bit code of each point of a stream to outCodes. See Morton::Encode63.
+    static void Encode63(const Vector3Stream& points, const AABB& bounds, uint64_t* outCodes);
+    //! @}
+
+    //>See
+    //! @name Sorting
+    //! @{
+
+    //! Sorts count keys in place, moving indices along with them. The sort is stable. threadCount threads are used, or 
+    //! one per hardware thread when it's zero; the result doesn't depend on the number of threads. The sort needs room 
+    //! for another count keys and indices: pass scratchKeys and scratchIndices to reuse memory between sorts, or leave 
+    //! them null to have it allocated and freed.
+    static void Sort(uint32_t* keys, uint32_t* indices, size_t count, unsigned threadCount = 0, 
+                     uint32_t* scratchKeys = nullptr, uint32_t* scratchIndices = nullptr);
+    //! Sorts count 64 bit keys in place, moving indices along with them. See Morton::Sort.
+    static void Sort(uint64_t* keys, uint32_t* indices, size_t count, unsigned threadCount = 0, 
+                     uint64_t* scratchKeys = nullptr, uint32_t* scratchIndices = nullptr);
+    //! Writes to outOrder the indices of count points in the order of their 30 bit codes in bounds: outOrder[i] is the 
+    //! index of the point that goes i-th. Points with the same code keep their order.
+    static void Order(const Vector3* points, size_t count, const AABB& bounds, uint32_t* outOrder, unsigned threadCount = 0);
+    //! Writes to outOrder the indices of the points of a stream in the order of their 30 bit codes. See Morton::Order.
+    static void Order(const Vector3Stream& points, const AABB& bounds, uint32_t* outOrder, unsigned threadCount = 0);
+    //! @}
+
+    //>See
+    //! @name Permuting
+    //! @{
+
+    //! Gathers count items into outItems in order, so outItems[i] = items[order[i]]. items and outItems must not 
+    //! overlap. Any other arrays of the same elements, such as particle velocities or colors, can be permuted the same 
+    //! way to stay in step.
+    template <class T>
+    static void Permute(const T* items, const uint32_t* order, size_t count, T* outItems);
+    //! Gathers the points of a stream into outPoints in order, resizing it to match. See Morton::Permute.
+    static void Permute(const Vector3Stream& points, const uint32_t* order, Vector3Stream& outPoints);
+    //! @}
+};
+
+XOMATH_END_XO_NS();
\ No newline at end of file
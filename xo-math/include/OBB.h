@@ -0,0 +1,111 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief An oriented bounding box: a center, three perpendicular unit axes and the half size of the box along each.
+//!
+//! The point of the box closest to a point is the point's offset from the center, measured along each axis and 
+//! clamped to the extents. OBB::ClosestPoints does this for a stream of points, wide::Width (4 with SSE, 8 with AVX) 
+//! per iteration.
+//! @sa AABB
+class _XOSIMDALIGN OBB {
+public:
+    //>See
+    //! @name Constructors
+    //! @{
+    OBB() { } //!< Performs no initialization.
+    //! Assigns each named value accordingly. The axes must be perpendicular and have a length of 1.
+    OBB(const Vector3& center, const Vector3& axisX, const Vector3& axisY, const Vector3& axisZ, const Vector3& extents) {
+        Set(center, axisX, axisY, axisZ, extents);
+    }
+    //! The box covering box, which has no rotation.
+    explicit OBB(const AABB& box) {
+        Set(box.Center(), Vector3::UnitX, Vector3::UnitY, Vector3::UnitZ, box.Extents());
+    }
+    //! @}
+
+    //>See
+    //! @name Set / Get Methods
+    //! @{
+
+    //! Set all. Assigns each named value accordingly. The axes must be perpendicular and have a length of 1.
+    OBB& Set(const Vector3& center, const Vector3& axisX, const Vector3& axisY, const Vector3& axisZ, const Vector3& extents) {
+        this->center = center;
+        axes[0] = axisX;
+        axes[1] = axisY;
+        axes[2] = axisZ;
+        this->extents = extents;
+        return *this;
+    }
+    //! @}
+
+    //>See
+    //! @name Special Operators
+    //! @{
+
+    //! Overloads the new and delete operators for OBB when memory alignment is required (such as with SSE).
+    //! @sa XO_16ALIGNED_MALLOC, XO_16ALIGNED_FREE
+    _XO_OVERLOAD_NEW_DELETE();
+    //! @}
+
+    //>See
+    //! @name Methods
+    //! @{
+
+    //! The point of the box, including its inside, closest to point.
+    Vector3 ClosestPoint(const Vector3& point) const;
+    //! The squared distance from point to the box, zero when it's inside.
+    float DistanceSquared(const Vector3& point) const;
+    //! outPoints[i] is the point of the box closest to points[i]. outPoints is resized to points.Size(), and may be 
+    //! points. When outDistancesSquared isn't null it must hold as many floats.
+    void ClosestPoints(const Vector3Stream& points, Vector3Stream& outPoints, float* outDistancesSquared = nullptr) const;
+    //! The corner of the box furthest along direction. Makes OBB a shape for GJK and EPA.
+    Vector3 Support(const Vector3& direction) const {
+        return center + axes[0] * (direction.Dot(axes[0]) < 0.0f ? -extents.x : extents.x) + 
+                        axes[1] * (direction.Dot(axes[1]) < 0.0f ? -extents.y : extents.y) + 
+                        axes[2] * (direction.Dot(axes[2]) < 0.0f ? -extents.z : extents.z);
+    }
+    //! @}
+
+#ifndef XO_NO_OSTREAM
+    //>See
+    //! @name Extras
+    //! @{
+
+    //! Prints the center, axes and extents of box to the provided ostream.
+    friend std::ostream& operator <<(std::ostream& os, const OBB& box) {
+        os << "(center:" << box.center << ", axes:" << box.axes[0] << box.axes[1] << box.axes[2] << ", extents:" << box.extents << ")";
+        return os;
+    }
+    //! @}
+#endif
+
+    ////////////////////////////////////////////////////////////////////////// Members
+    // See: http://xo-math.rtfd.io/en/latest/classes/obb.html#public_members
+    Vector3 center;
+    Vector3 axes[3];    //!< The box's local x, y and z axes in world space.
+    Vector3 extents;    //!< Half the size of the box along each of its axes.
+};
+
+XOMATH_END_XO_NS();
\ No newline at end of file
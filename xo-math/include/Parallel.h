@@ -0,0 +1,56 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+XOMATH_BEGIN_XO_NS();
+
+// Thread fan-out shared by the bulk builds and kernels (BVH, BoundingSphere, SpatialHashGrid, Morton, Skinning and 
+// Hierarchy).
+namespace xo_internal {
+    // The most threads one operation splits its work over.
+    _XOCONSTEXPR const unsigned MaxThreads = 64;
+
+    // The threads to split count items over: threadCount, or one per hardware thread when it's zero, at most 
+    // MaxThreads, and few enough that each gets at least share items. A share of zero doesn't limit them.
+    _XOINL unsigned ThreadCount(unsigned threadCount, size_t count, size_t share) {
+        unsigned threads = threadCount ? threadCount : std::thread::hardware_concurrency();
+        threads = _XO_MIN(_XO_MAX(threads, 1u), MaxThreads);
+        if (share) {
+            threads = (unsigned)_XO_MIN((size_t)threads, _XO_MAX(count / share, (size_t)1));
+        }
+        return threads;
+    }
+
+    // Runs task(i) for each i below count, each on its own thread. task(0) runs on the calling thread.
+    template <class Task>
+    void Parallel(unsigned count, const Task& task) {
+        std::thread threads[MaxThreads];
+        for (unsigned i = 1; i < count; ++i) {
+            threads[i] = std::thread(task, i);
+        }
+        task(0u);
+        for (unsigned i = 1; i < count; ++i) {
+            threads[i].join();
+        }
+    }
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
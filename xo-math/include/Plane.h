@@ -0,0 +1,160 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+XOMATH_BEGIN_XO_NS();
+
+//! Which side of a plane a point is on. The sides of a set of points are the bitwise or of its points' sides, so a 
+//! set with points on both sides is PlaneSide::Straddling.
+enum class PlaneSide : uint8_t {
+    On = 0,         //!< Within epsilon of the plane.
+    Front = 1,      //!< Further than epsilon along the normal.
+    Back = 2,       //!< Further than epsilon against the normal.
+    Straddling = 3  //!< Front | Back. Only returned for sets of points.
+};
+
+//! @brief A plane stored as a unit normal and a distance term, so that the signed distance from the plane to a point p 
+//! is \f$normal \cdot p + d\f$.
+//!
+//! Points the normal faces are in front of the plane. This is the same convention as the Vector4 planes of Frustum, 
+//! and a plane converts to and from one with x, y, z holding the normal and w holding d.
+//!
+//! The array methods measure or classify wide::Width points (4 with SSE, 8 with AVX) per iteration with vertical 
+//! multiply-adds, from either a Vector3 array or a Vector3Stream.
+//! @sa https://en.wikipedia.org/wiki/Plane_(geometry)#Point.E2.80.93normal_form_and_general_form_of_the_equation_of_a_plane
+class _XOSIMDALIGN Plane {
+public:
+    //>See
+    //! @name Constructors
+    //! @{
+    Plane() { } //!< Performs no initialization.
+    Plane(const Vector3& normal, float d) : normal(normal), d(d) { } //!< Assigns each named value accordingly.
+    //! Takes the normal from x, y, z and d from w, as stored by Frustum.
+    explicit Plane(const Vector4& v) : normal(v.x, v.y, v.z), d(v.w) { }
+    //! @}
+
+    //>See
+    //! @name Set / Get Methods
+    //! @{
+
+    //! Set all. Assigns each named value accordingly.
+    Plane& Set(const Vector3& normal, float d) {
+        this->normal = normal;
+        this->d = d;
+        return *this;
+    }
+    //! Returns the plane as a Vector4, with the normal in x, y, z and d in w.
+    Vector4 ToVector4() const {
+        return Vector4(normal.x, normal.y, normal.z, d);
+    }
+    //! @}
+
+    //>See
+    //! @name Special Operators
+    //! @{
+
+    //! Overloads the new and delete operators for Plane when memory alignment is required (such as with SSE).
+    //! @sa XO_16ALIGNED_MALLOC, XO_16ALIGNED_FREE
+    _XO_OVERLOAD_NEW_DELETE();
+    //! @}
+
+    //>See
+    //! @name Methods
+    //! @{
+
+    //! Scales the plane so its normal has a length of 1, leaving the points on it unchanged.
+    Plane& Normalize();
+    //! Returns a copy of this plane with a normal of length 1. See Plane::Normalize.
+    Plane Normalized() const {
+        return Plane(*this).Normalize();
+    }
+    //! Transforms the plane by m, the matrix its points are transformed by as with Matrix4x4::TransformPoints, and 
+    //! normalizes it. Planes transform by the inverse transpose of m, so this inverts m first. When transforming many 
+    //! planes by the same matrix, invert it once and use Plane::TransformByInverse.
+    Plane& Transform(const Matrix4x4& m);
+    //! Transforms the plane by the matrix whose inverse is inverse, and normalizes it. See Plane::Transform.
+    Plane& TransformByInverse(const Matrix4x4& inverse);
+    //! Returns a copy of this plane transformed by m. See Plane::Transform.
+    Plane Transformed(const Matrix4x4& m) const {
+        return Plane(*this).Transform(m);
+    }
+    //! Positive in front of the plane and negative behind it. A true distance when the normal has a length of 1.
+    _XOINL float SignedDistance(const Vector3& point) const;
+    //! The point on the plane closest to point. The normal must have a length of 1.
+    _XOINL Vector3 ClosestPoint(const Vector3& point) const;
+    //! Which side of the plane point is on. Points within epsilon of the plane are PlaneSide::On.
+    _XOINL PlaneSide Classify(const Vector3& point, float epsilon = 0.0f) const;
+    //! @}
+
+    //>See
+    //! @name Array Methods
+    //! @{
+
+    //! Writes the signed distance of each of count points to outDistances, which must hold count floats.
+    void SignedDistances(const Vector3* points, size_t count, float* outDistances) const;
+    //! Writes the signed distance of each point of points to outDistances, which must hold points.Size() floats.
+    void SignedDistances(const Vector3Stream& points, float* outDistances) const;
+    //! Classifies count points, as with Plane::Classify, and returns the sides of the whole set: PlaneSide::Front or 
+    //! PlaneSide::Back when every point is on that side or on the plane, PlaneSide::Straddling when there are points on 
+    //! both, and PlaneSide::On when every point is on the plane.
+    //!
+    //! When outSides isn't null it must hold count sides, one written per point. When it's null only the sides of the 
+    //! set are found, and the scan stops at the first group of points that shows it straddles the plane. This is the 
+    //! test for whether a polygon needs splitting.
+    PlaneSide ClassifyPoints(const Vector3* points, size_t count, PlaneSide* outSides = nullptr, float epsilon = 0.0f) const;
+    //! Classifies the points of points. See the array variant.
+    PlaneSide ClassifyPoints(const Vector3Stream& points, PlaneSide* outSides = nullptr, float epsilon = 0.0f) const;
+    //! @}
+
+    //>See
+    //! @name Static Methods
+    //! @{
+
+    //! The plane through point facing normal, which must have a length of 1.
+    static Plane FromPointNormal(const Vector3& point, const Vector3& normal) {
+        return Plane(normal, -(normal.x * point.x + normal.y * point.y + normal.z * point.z));
+    }
+    //! The plane through a, b and c, facing the side they appear counterclockwise from. The points must not be on a 
+    //! line.
+    static Plane FromPoints(const Vector3& a, const Vector3& b, const Vector3& c);
+    //! @}
+
+#ifndef XO_NO_OSTREAM
+    //>See
+    //! @name Extras
+    //! @{
+
+    //! Prints the normal and distance term of plane to the provided ostream.
+    friend std::ostream& operator <<(std::ostream& os, const Plane& plane) {
+        os << "(normal:" << plane.normal << ", d:" << plane.d << ")";
+        return os;
+    }
+    //! @}
+#endif
+
+    ////////////////////////////////////////////////////////////////////////// Members
+    // See: http://xo-math.rtfd.io/en/latest/classes/plane.html#public_members
+    Vector3 normal; //!< Faces the front of the plane. Most methods expect a length of 1.
+    float d;        //!< The negated distance from the origin to the plane along normal.
+};
+
+XOMATH_END_XO_NS();
\ No newline at end of file
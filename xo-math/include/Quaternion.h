@@ -44,6 +44,15 @@ public:
     Quaternion Conjugate() const;
     Quaternion Inverse() const;
     Quaternion Normalized() const;
+    //! Normalize with the precision policy P. Unlike Normalize(), quaternions that are already normalized or are 
+    //! zero aren't special cased.
+    //! @sa Precision
+    template <Precision P>
+    _XOINL Quaternion& Normalize();
+    template <Precision P>
+    Quaternion Normalized() const {
+        return Quaternion(*this).Normalize<P>();
+    }
     void GetAxisAngleRadians(Vector3& axis, float& radians) const;
 
     static void AxisAngleRadians(const Vector3& axis, float radians, Quaternion& outQuat);
@@ -55,6 +64,17 @@ public:
     static void RotationRadians(const Vector3& v, Quaternion& outQuat);
     static void RotationRadians(float x, float y, float z, Quaternion& outQuat);
     static void Slerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat);
+    //! Normalized lerp along the shortest path: b is negated when it is more than 90 degrees from a, then the lerp 
+    //! of a and b is normalized. Cheaper than Quaternion::Slerp but does not keep a constant angular velocity.
+    static void Nlerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat);
+    //! outQuats[i] = Slerp(a[i], b[i], t[i]) for count quaternions. outQuats may be a or b.
+    //!
+    //! Evaluates the same division free polynomial as Quaternion::Slerp, 4 (SSE) or 8 (AVX) quaternions at a time, 
+    //! with the shortest path fold and the early outs of the single version resolved by masks rather than branches.
+    //! Results match Quaternion::Slerp to within Quaternion::Epsilon.
+    static void SlerpArray(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* outQuats, size_t count);
+    //! outQuats[i] = Nlerp(a[i], b[i], t[i]) for count quaternions, 4 (SSE) or 8 (AVX) at a time. outQuats may be a or b.
+    static void NlerpArray(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* outQuats, size_t count);
 
 #define _RET_VARIANT(name) { Quaternion tempV; name(
 #define _RET_VARIANT_END() tempV); return tempV; }
@@ -68,6 +88,7 @@ public:
 
     static Quaternion AxisAngleRadians(const Vector3& axis, float radians)                          _RET_VARIANT_2(AxisAngleRadians, axis, radians)
     static Quaternion Lerp(const Quaternion& a, const Quaternion& b, float t)                       _RET_VARIANT_3(Lerp, a, b, t)
+    static Quaternion Nlerp(const Quaternion& a, const Quaternion& b, float t)                      _RET_VARIANT_3(Nlerp, a, b, t)
     static Quaternion LookAtFromDirection(const Vector3& direction)                                 _RET_VARIANT_1(LookAtFromDirection, direction)
     static Quaternion LookAtFromDirection(const Vector3& direction, const Vector3& up)              _RET_VARIANT_2(LookAtFromDirection, direction, up)
     static Quaternion LookAtFromPosition(const Vector3& from, const Vector3& to)                    _RET_VARIANT_2(LookAtFromPosition, from, to)
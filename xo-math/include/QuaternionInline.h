@@ -31,11 +31,12 @@ const float& Quaternion::operator [](int i) const {
 
 Quaternion& Quaternion::operator *= (const Quaternion& q) {
     // TODO: see if there's a cute intrinsic way to do this.
-    _XO_ASSIGN_QUAT(
-      w * q.x + x * q.w + y * q.z - z * q.y,
-      w * q.y - x * q.z + y * q.w + z * q.x,
-      w * q.z + x * q.y - y * q.x + z * q.w,
-      w * q.w - x * q.x - y * q.y - z * q.z);
+    // Every product is taken before anything is assigned, q may be this.
+    const float rx = w * q.x + x * q.w + y * q.z - z * q.y;
+    const float ry = w * q.y - x * q.z + y * q.w + z * q.x;
+    const float rz = w * q.z + x * q.y - y * q.x + z * q.w;
+    const float rw = w * q.w - x * q.x - y * q.y - z * q.z;
+    _XO_ASSIGN_QUAT(rw, rx, ry, rz);
   return *this;
 }
 
@@ -59,4 +60,10 @@ bool Quaternion::operator != (const Quaternion& q) const {
   return !((*this) == q);
 }
 
+template <Precision P>
+Quaternion& Quaternion::Normalize() {
+    (*(Vector4*)this).Normalize<P>();
+    return *this;
+}
+
 XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,153 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief A small and fast pseudo random number generator.
+//!
+//! Four independent xoshiro128+ generators (http://prng.di.unimi.it/) run side by side, 16 words of state in total. 
+//! Single values come from the first one. The bulk methods step all four at once with SSE2 integer math and write 
+//! their outputs in an interleaved order, which is the same with and without SIMD, so a seeded generator produces 
+//! the same sequence on every platform.
+//!
+//! Floats are made from the top 24 bits of an output, so every value in [0, 1) is a multiple of 2^-24 and each 
+//! multiple is equally likely. Integer ranges use a multiply instead of a modulo.
+//!
+//! RandomGenerator::ThreadLocal gives each thread its own generator seeded from the clock, which is what RandomRange, 
+//! RandomBool, the array functions and the Vector3::Random methods use.
+class _XOSIMDALIGN RandomGenerator {
+public:
+    //>See
+    //! @name Constructors
+    //! @{
+    RandomGenerator(); //!< Seeded from the clock and the address of the generator.
+    explicit RandomGenerator(uint64_t seed); //!< Seeded from seed, always producing the same sequence.
+    //! @}
+
+    //>See
+    //! @name Methods
+    //! @{
+
+    //! Restarts the generator from seed. The 16 words of state are filled by splitmix64.
+    void Seed(uint64_t seed);
+
+    //! 32 random bits. The low bits are of lower quality (a linear feedback) than the high bits.
+    uint32_t Next() {
+        uint32_t* w0 = s[0];
+        uint32_t* w1 = s[1];
+        uint32_t* w2 = s[2];
+        uint32_t* w3 = s[3];
+        const uint32_t result = w0[0] + w3[0];
+        const uint32_t t = w1[0] << 9;
+        w2[0] ^= w0[0];
+        w3[0] ^= w1[0];
+        w1[0] ^= w2[0];
+        w0[0] ^= w3[0];
+        w2[0] ^= t;
+        w3[0] = (w3[0] << 11) | (w3[0] >> 21);
+        return result;
+    }
+    //! A float in [0, 1).
+    float NextFloat() {
+        return (Next() >> 8) * (1.0f / 16777216.0f);
+    }
+    //! A float between low and high. Like low + NextFloat() * (high - low), high itself can only come from rounding.
+    float Range(float low, float high) {
+        return low + (Next() >> 8) * ((high - low) * (1.0f / 16777216.0f));
+    }
+    //! An int in [low, high], both inclusive.
+    int Range(int low, int high) {
+        XO_ASSERT(low <= high, "xo-math RandomGenerator::Range requires low <= high.");
+        const uint64_t span = (uint64_t)((int64_t)high - low) + 1;
+        return (int)(low + (int64_t)((Next() * span) >> 32));
+    }
+    //! True or false with equal odds, from the top bit.
+    bool Bool() {
+        return (Next() >> 31) != 0;
+    }
+
+    //! Fills outFloats with count floats in [0, 1). No alignment is required.
+    void Floats(float* outFloats, size_t count) {
+        RangeArray(0.0f, 1.0f, outFloats, count);
+    }
+    //! Fills outFloats with count floats between low and high, 4 per step. No alignment is required.
+    void RangeArray(float low, float high, float* outFloats, size_t count);
+    //! @}
+
+    //>See
+    //! @name Static Methods
+    //! @{
+
+    //! This thread's generator, created and seeded from the clock on first use.
+    static RandomGenerator& ThreadLocal() {
+#if _XO_NO_TLS
+        static _XOTLS RandomGenerator* generator;
+        static _XOTLS _XOSIMDALIGN char mem[sizeof(RandomGenerator)];
+        if (!generator) {
+            generator = new(mem) RandomGenerator();
+        }
+        return *generator;
+#else
+        static _XOTLS RandomGenerator generator;
+        return generator;
+#endif
+    }
+    //! @}
+
+private:
+    // s[word][generator]: the four state words of each generator, stored so each word of all four is one __m128i.
+    uint32_t s[4][4];
+};
+
+//>See
+//! @name Random Functions
+//! Drawn from RandomGenerator::ThreadLocal.
+//! @{
+_XOINL 
+bool RandomBool() {
+    return RandomGenerator::ThreadLocal().Bool();
+}
+
+//! An int in [low, high], both inclusive.
+_XOINL 
+int RandomRange(int low, int high) {
+    return RandomGenerator::ThreadLocal().Range(low, high);
+}
+
+_XOINL 
+float RandomRange(float low, float high) {
+    return RandomGenerator::ThreadLocal().Range(low, high);
+}
+
+//! Fills outFloats with count floats between low and high.
+_XOINL
+void RandomRangeArray(float low, float high, float* outFloats, size_t count) {
+    RandomGenerator::ThreadLocal().RangeArray(low, high, outFloats, count);
+}
+
+//! Fills outFloats with count floats in [0, 1).
+_XOINL
+void RandomFloats(float* outFloats, size_t count) {
+    RandomGenerator::ThreadLocal().Floats(outFloats, count);
+}
+//! @}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,192 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief A half line from an origin along a direction, for picking, line of sight and projectile hit tests.
+//!
+//! The direction doesn't need to be normalized. Hit distances are measured in multiples of it, so points along the 
+//! ray are origin + direction * t and a hit at t = 1 is one direction length away.
+//!
+//! Every intersection test keeps the closest hit so far: pass the farthest distance of interest in inOutT (for 
+//! example std::numeric_limits<float>::infinity()), and it's only replaced, and true returned, by a hit with 
+//! \f$0 \leq t < inOutT\f$. Calling tests one after another with the same inOutT finds the closest of them.
+//! @sa RayPacket
+class _XOSIMDALIGN Ray {
+public:
+    //>See
+    //! @name Constructors
+    //! @{
+    Ray() { } //!< Performs no initialization.
+    Ray(const Vector3& origin, const Vector3& direction) : origin(origin), direction(direction) { } //!< Assigns each named value accordingly.
+    //! @}
+
+    //>See
+    //! @name Set / Get Methods
+    //! @{
+
+    //! Set all. Assigns each named value accordingly.
+    Ray& Set(const Vector3& origin, const Vector3& direction) {
+        this->origin = origin;
+        this->direction = direction;
+        return *this;
+    }
+    //! The point t direction lengths along the ray. \f$origin + direction \times t\f$
+    Vector3 PointAt(float t) const {
+        return origin + direction * t;
+    }
+    //! @}
+
+    //>See
+    //! @name Special Operators
+    //! @{
+
+    //! Overloads the new and delete operators for Ray when memory alignment is required (such as with SSE).
+    //! @sa XO_16ALIGNED_MALLOC, XO_16ALIGNED_FREE
+    _XO_OVERLOAD_NEW_DELETE();
+    //! @}
+
+    //>See
+    //! @name Intersection Methods
+    //! @{
+
+    //! Möller-Trumbore ray-triangle intersection, hitting either side of the triangle. On a hit outU and outV are the 
+    //! barycentric weights of v1 and v2 at the hit point, and the weight of v0 is 1 - outU - outV.
+    //! @sa https://en.wikipedia.org/wiki/M%C3%B6ller%E2%80%93Trumbore_intersection_algorithm
+    _XOINL bool IntersectTriangle(const Vector3& v0, const Vector3& v1, const Vector3& v2, float& inOutT, float& outU, float& outV) const;
+    //! Slab test against box. On a hit inOutT is where the ray enters the box, or 0 if the origin is inside it.
+    //! @sa https://en.wikipedia.org/wiki/Slab_method
+    _XOINL bool IntersectAABB(const AABB& box, float& inOutT) const;
+    //! On a hit inOutT is where the ray enters the sphere, or where it leaves if the origin is inside it.
+    _XOINL bool IntersectSphere(const Vector3& center, float radius, float& inOutT) const;
+    //! Finds the closest of count triangles, testing wide::Width triangles (4 with SSE, 8 with AVX) per iteration.
+    //! Triangle i is vertices[i * 3], vertices[i * 3 + 1] and vertices[i * 3 + 2]. On a hit outIndex is the index of 
+    //! the closest triangle, and outU and outV its barycentrics as with Ray::IntersectTriangle.
+    bool IntersectTriangles(const Vector3* vertices, size_t count, float& inOutT, float& outU, float& outV, size_t& outIndex) const;
+    //! @}
+
+#ifndef XO_NO_OSTREAM
+    //>See
+    //! @name Extras
+    //! @{
+
+    //! Prints the origin and direction of ray to the provided ostream.
+    friend std::ostream& operator <<(std::ostream& os, const Ray& ray) {
+        os << "(origin:" << ray.origin << ", direction:" << ray.direction << ")";
+        return os;
+    }
+    //! @}
+#endif
+
+    ////////////////////////////////////////////////////////////////////////// Members
+    // See: http://xo-math.rtfd.io/en/latest/classes/ray.html#public_members
+    Vector3 origin;
+    Vector3 direction; //!< Not required to be normalized.
+};
+
+//! @brief N rays stored as a structure of arrays, for testing many coherent rays against the same primitive at once.
+//!
+//! Each test runs every ray of the packet through the same vertical instructions, wide::Width rays at a time, and 
+//! returns a bitmask with bit i set for each ray i that hit. inOutT, outU and outV hold N floats, one per ray, with 
+//! the same closest-hit-so-far meaning as the Ray tests. Lanes that miss are left unchanged.
+//!
+//! Use RayPacket4 or RayPacket8. A RayPacket4 under AVX fills both halves of each register with the same four rays.
+//! @sa Ray
+template <int N>
+class _XOSIMDALIGN RayPacket {
+    static_assert(N == 4 || N == 8, "xo-math RayPacket holds 4 or 8 rays.");
+public:
+    //! The number of rays in the packet.
+    static const int Size = N;
+
+    //>See
+    //! @name Constructors
+    //! @{
+    RayPacket() { } //!< Performs no initialization.
+    explicit RayPacket(const Ray* rays) { Set(rays); } //!< Assigns N rays from rays.
+    //! @}
+
+    //>See
+    //! @name Set / Get Methods
+    //! @{
+
+    //! Set all. Assigns N rays from rays.
+    RayPacket& Set(const Ray* rays) {
+        for (int i = 0; i < N; ++i) {
+            Set(i, rays[i]);
+        }
+        return *this;
+    }
+    //! Set one. Assigns ray to index i, along with the reciprocal of its direction.
+    RayPacket& Set(int i, const Ray& ray) {
+        XO_ASSERT(i >= 0 && i < N, "xo-math RayPacket::Set index out of range.");
+        originX[i] = ray.origin.x;
+        originY[i] = ray.origin.y;
+        originZ[i] = ray.origin.z;
+        directionX[i] = ray.direction.x;
+        directionY[i] = ray.direction.y;
+        directionZ[i] = ray.direction.z;
+        inverseDirectionX[i] = 1.0f / ray.direction.x;
+        inverseDirectionY[i] = 1.0f / ray.direction.y;
+        inverseDirectionZ[i] = 1.0f / ray.direction.z;
+        return *this;
+    }
+    //! Extract one getter. Returns the ray at index i.
+    Ray Get(int i) const {
+        XO_ASSERT(i >= 0 && i < N, "xo-math RayPacket::Get index out of range.");
+        return Ray(Vector3(originX[i], originY[i], originZ[i]), Vector3(directionX[i], directionY[i], directionZ[i]));
+    }
+    //! @}
+
+    //>See
+    //! @name Special Operators
+    //! @{
+
+    //! Overloads the new and delete operators for RayPacket when memory alignment is required (such as with SSE).
+    //! @sa XO_16ALIGNED_MALLOC, XO_16ALIGNED_FREE
+    _XO_OVERLOAD_NEW_DELETE();
+    //! @}
+
+    //>See
+    //! @name Intersection Methods
+    //! @{
+
+    //! Möller-Trumbore against one triangle for every ray. See Ray::IntersectTriangle.
+    int IntersectTriangle(const Vector3& v0, const Vector3& v1, const Vector3& v2, float* inOutT, float* outU, float* outV) const;
+    //! Slab test against box for every ray. See Ray::IntersectAABB.
+    int IntersectAABB(const AABB& box, float* inOutT) const;
+    //! Sphere test for every ray. See Ray::IntersectSphere.
+    int IntersectSphere(const Vector3& center, float radius, float* inOutT) const;
+    //! @}
+
+    ////////////////////////////////////////////////////////////////////////// Members
+    // See: http://xo-math.rtfd.io/en/latest/classes/ray.html#public_members
+    // Write rays with Set, which keeps the inverse directions used by the slab test up to date.
+    float originX[N], originY[N], originZ[N];
+    float directionX[N], directionY[N], directionZ[N];
+    float inverseDirectionX[N], inverseDirectionY[N], inverseDirectionZ[N];
+};
+
+typedef RayPacket<4> RayPacket4;
+typedef RayPacket<8> RayPacket8;
+
+XOMATH_END_XO_NS();
\ No newline at end of file
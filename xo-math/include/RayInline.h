@@ -0,0 +1,96 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+XOMATH_BEGIN_XO_NS();
+
+bool Ray::IntersectTriangle(const Vector3& v0, const Vector3& v1, const Vector3& v2, float& inOutT, float& outU, float& outV) const {
+    const Vector3& o = origin;
+    const Vector3& d = direction;
+    const float e1x = v1.x - v0.x, e1y = v1.y - v0.y, e1z = v1.z - v0.z;
+    const float e2x = v2.x - v0.x, e2y = v2.y - v0.y, e2z = v2.z - v0.z;
+    const float px = d.y * e2z - d.z * e2y, py = d.z * e2x - d.x * e2z, pz = d.x * e2y - d.y * e2x;
+    const float det = e1x * px + e1y * py + e1z * pz;
+    if (det == 0.0f) {
+        // the ray is parallel to the triangle's plane.
+        return false;
+    }
+    const float inverseDet = 1.0f / det;
+    const float sx = o.x - v0.x, sy = o.y - v0.y, sz = o.z - v0.z;
+    const float u = (sx * px + sy * py + sz * pz) * inverseDet;
+    const float qx = sy * e1z - sz * e1y, qy = sz * e1x - sx * e1z, qz = sx * e1y - sy * e1x;
+    const float v = (d.x * qx + d.y * qy + d.z * qz) * inverseDet;
+    const float t = (e2x * qx + e2y * qy + e2z * qz) * inverseDet;
+    // written so that a NaN anywhere is a miss.
+    if (!(u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t >= 0.0f && t < inOutT)) {
+        return false;
+    }
+    inOutT = t;
+    outU = u;
+    outV = v;
+    return true;
+}
+
+bool Ray::IntersectAABB(const AABB& box, float& inOutT) const {
+    float enter = 0.0f, exit = inOutT;
+    for (int i = 0; i < 3; ++i) {
+        // a zero direction divides to +-infinity, which keeps the slab only when the origin lies within it.
+        const float inverse = 1.0f / direction[i];
+        float t0 = (box.min[i] - origin[i]) * inverse;
+        float t1 = (box.max[i] - origin[i]) * inverse;
+        if (t0 > t1) {
+            const float swap = t0;
+            t0 = t1;
+            t1 = swap;
+        }
+        enter = t0 > enter ? t0 : enter;
+        exit = t1 < exit ? t1 : exit;
+    }
+    if (!(enter <= exit && enter < inOutT)) {
+        return false;
+    }
+    inOutT = enter;
+    return true;
+}
+
+bool Ray::IntersectSphere(const Vector3& center, float radius, float& inOutT) const {
+    // Solves |origin + direction * t - center|^2 = radius^2 as a t^2 + 2 b t + c = 0.
+    const Vector3& d = direction;
+    const float ox = origin.x - center.x, oy = origin.y - center.y, oz = origin.z - center.z;
+    const float a = d.x * d.x + d.y * d.y + d.z * d.z;
+    const float b = ox * d.x + oy * d.y + oz * d.z;
+    const float c = ox * ox + oy * oy + oz * oz - radius * radius;
+    const float discriminant = b * b - a * c;
+    if (discriminant < 0.0f) {
+        return false;
+    }
+    const float root = Sqrt(discriminant);
+    const float inverseA = 1.0f / a;
+    const float tNear = (-b - root) * inverseA;
+    const float t = tNear >= 0.0f ? tNear : (-b + root) * inverseA;
+    if (!(t >= 0.0f && t < inOutT)) {
+        return false;
+    }
+    inOutT = t;
+    return true;
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
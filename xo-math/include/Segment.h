@@ -0,0 +1,117 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief The line segment between two points, with closest point queries against points and other segments.
+//!
+//! The single queries follow Ericson's Real-Time Collision Detection. The stream methods answer one query per lane of 
+//! a set of Vector3Stream, wide::Width (4 with SSE, 8 with AVX) per iteration: the branches of the single queries 
+//! become masks and selects, so every lane takes the same instructions whatever case its query falls in.
+//! @sa Triangle, OBB
+class _XOSIMDALIGN Segment {
+public:
+    //>See
+    //! @name Constructors
+    //! @{
+    Segment() { } //!< Performs no initialization.
+    Segment(const Vector3& start, const Vector3& end) : start(start), end(end) { } //!< Assigns each named value accordingly.
+    //! @}
+
+    //>See
+    //! @name Set / Get Methods
+    //! @{
+
+    //! Set all. Assigns each named value accordingly.
+    Segment& Set(const Vector3& start, const Vector3& end) {
+        this->start = start;
+        this->end = end;
+        return *this;
+    }
+    //! The point t of the way from start to end. \f$start + (end - start) \times t\f$
+    Vector3 PointAt(float t) const {
+        return start + (end - start) * t;
+    }
+    //! @}
+
+    //>See
+    //! @name Special Operators
+    //! @{
+
+    //! Overloads the new and delete operators for Segment when memory alignment is required (such as with SSE).
+    //! @sa XO_16ALIGNED_MALLOC, XO_16ALIGNED_FREE
+    _XO_OVERLOAD_NEW_DELETE();
+    //! @}
+
+    //>See
+    //! @name Methods
+    //! @{
+
+    //! The point of the segment closest to point. A segment with its ends together is treated as a point.
+    Vector3 ClosestPoint(const Vector3& point) const;
+    //! Finds the closest points between this segment and segment, outPoint on this one and outSegmentPoint on the 
+    //! other, and returns the squared distance between them. When the segments are parallel one of the pairs at that 
+    //! distance is picked.
+    float ClosestPoints(const Segment& segment, Vector3& outPoint, Vector3& outSegmentPoint) const;
+    //! The end of the segment furthest along direction. Makes Segment a shape for GJK and EPA, and with GJK::Rounded 
+    //! a capsule.
+    Vector3 Support(const Vector3& direction) const {
+        return direction.Dot(end - start) > 0.0f ? end : start;
+    }
+    //! @}
+
+    //>See
+    //! @name Stream Methods
+    //! All streams must be the same size. Output streams are resized to it, and may be the same as an input stream.
+    //! When outDistancesSquared isn't null it must hold as many floats.
+    //! @{
+
+    //! outPoints[i] is the point of the segment from starts[i] to ends[i] closest to points[i]. See 
+    //! Segment::ClosestPoint.
+    static void ClosestPoints(const Vector3Stream& points, const Vector3Stream& starts, const Vector3Stream& ends, Vector3Stream& outPoints, float* outDistancesSquared = nullptr);
+    //! The closest points between pairs of segments, the first segment of pair i being starts1[i] to ends1[i] and the 
+    //! second starts2[i] to ends2[i]. See Segment::ClosestPoints.
+    static void ClosestPoints(const Vector3Stream& starts1, const Vector3Stream& ends1, const Vector3Stream& starts2, const Vector3Stream& ends2, 
+                              Vector3Stream& outPoints1, Vector3Stream& outPoints2, float* outDistancesSquared = nullptr);
+    //! @}
+
+#ifndef XO_NO_OSTREAM
+    //>See
+    //! @name Extras
+    //! @{
+
+    //! Prints the ends of segment to the provided ostream.
+    friend std::ostream& operator <<(std::ostream& os, const Segment& segment) {
+        os << "(start:" << segment.start << ", end:" << segment.end << ")";
+        return os;
+    }
+    //! @}
+#endif
+
+    ////////////////////////////////////////////////////////////////////////// Members
+    // See: http://xo-math.rtfd.io/en/latest/classes/segment.html#public_members
+    Vector3 start;
+    Vector3 end;
+};
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,94 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief Skinning kernels, moving the vertices of a mesh by a palette of bone transforms.
+//!
+//! Each vertex has Skinning::Influences bones, given as that many consecutive entries of boneIndices, indices into 
+//! the palette, and of boneWeights, which should sum to one. Unused influences have a weight of zero. Vertices are 
+//! read from and written to Vector3Stream positions (and optionally normals) or interleaved Vector3 arrays, 
+//! wide::Width vertices at a time: each vertex's bones are blended in place into one transform, then the blended 
+//! transforms are transposed into one register per component, so no palette entry is gathered lane by lane and the 
+//! transforms of the vertices themselves are vertical.
+//!
+//! Work is split into contiguous ranges of vertices over threadCount threads, or one per hardware thread when it's 
+//! zero. Meshes too small to be worth it are skinned on the calling thread. Outputs are resized to fit, when they're 
+//! streams, and may be the inputs.
+class Skinning {
+public:
+    static const int Influences = 4; //!< The number of bones per vertex.
+
+    //>See
+    //! @name Linear Blend Skinning
+    //! @{
+
+    //! Skins positions and normals by the weighted sum of the matrices of each vertex's bones. Only the top three rows 
+    //! of the palette are read, so Matrix4x4 bones are expected to be affine.
+    //!
+    //! Normals are transformed by the blended matrix without the translation and aren't renormalized. They're exact 
+    //! for bones without non uniform scale; see Vector3Stream::Normalize if unit normals are needed.
+    static void LinearBlend(const Matrix3x4* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                            const Vector3Stream& positions, const Vector3Stream& normals, 
+                            Vector3Stream& outPositions, Vector3Stream& outNormals, unsigned threadCount = 0);
+    //! Skins positions only. See Skinning::LinearBlend.
+    static void LinearBlend(const Matrix3x4* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                            const Vector3Stream& positions, Vector3Stream& outPositions, unsigned threadCount = 0);
+    //! Skins count interleaved positions, and normals unless normals and outNormals are null. See Skinning::LinearBlend.
+    static void LinearBlend(const Matrix3x4* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                            const Vector3* positions, const Vector3* normals, Vector3* outPositions, Vector3* outNormals, 
+                            size_t count, unsigned threadCount = 0);
+    static void LinearBlend(const Matrix4x4* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                            const Vector3Stream& positions, const Vector3Stream& normals, 
+                            Vector3Stream& outPositions, Vector3Stream& outNormals, unsigned threadCount = 0);
+    static void LinearBlend(const Matrix4x4* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                            const Vector3Stream& positions, Vector3Stream& outPositions, unsigned threadCount = 0);
+    static void LinearBlend(const Matrix4x4* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                            const Vector3* positions, const Vector3* normals, Vector3* outPositions, Vector3* outNormals, 
+                            size_t count, unsigned threadCount = 0);
+    //! @}
+
+    //>See
+    //! @name Dual Quaternion Skinning
+    //! @{
+
+    //! Skins positions and normals by blending dual quaternions: the dual quaternions of a vertex's bones are summed by 
+    //! weight, each flipped onto the same side as the first, normalized and applied.
+    //!
+    //! Blending dual quaternions keeps the result rigid, so joints that twist don't collapse like with linear blend 
+    //! skinning, at the cost of supporting no scale or shear in the palette.
+    static void DualQuaternionBlend(const DualQuaternion* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                                    const Vector3Stream& positions, const Vector3Stream& normals, 
+                                    Vector3Stream& outPositions, Vector3Stream& outNormals, unsigned threadCount = 0);
+    //! Skins positions only. See Skinning::DualQuaternionBlend.
+    static void DualQuaternionBlend(const DualQuaternion* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                                    const Vector3Stream& positions, Vector3Stream& outPositions, unsigned threadCount = 0);
+    //! Skins count interleaved positions, and normals unless normals and outNormals are null. See 
+    //! Skinning::DualQuaternionBlend.
+    static void DualQuaternionBlend(const DualQuaternion* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                                    const Vector3* positions, const Vector3* normals, Vector3* outPositions, Vector3* outNormals, 
+                                    size_t count, unsigned threadCount = 0);
+    //! @}
+};
+
+XOMATH_END_XO_NS();
\ No newline at end of file
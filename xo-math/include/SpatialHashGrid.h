@@ -0,0 +1,128 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief A uniform grid over points, stored as a hash table of cells, for finding every point within a radius of a 
+//! position. Meant to be rebuilt each frame for many moving points, as with boids, particle fluids or proximity 
+//! triggers.
+//!
+//! Each point falls in the cube of side CellSize() that holds it, and each cube is hashed to one of BucketCount() 
+//! buckets. Building is a counting sort of the points by bucket: the points' coordinates are copied into one 
+//! structure of arrays ordered by bucket, so the points of a bucket are contiguous and a query tests them wide::Width 
+//! at a time. No memory is allocated per cell, and the arrays are kept between builds so rebuilding for as many 
+//! points or fewer doesn't allocate at all.
+//!
+//! Points are identified by their index in the array the grid was built from. Queries write point indices to an output 
+//! array that must hold at least PointCount() entries, and return how many were written, in no particular order. 
+//! Queries don't change the grid, so any number of threads may run them at once.
+//!
+//! A cell size close to the usual query radius works best: a query then looks at the 27 cells around its center.
+//! @sa https://en.wikipedia.org/wiki/Counting_sort
+class SpatialHashGrid {
+public:
+    //>See
+    //! @name Constructors
+    //! @{
+    SpatialHashGrid(); //!< An empty grid, performs no allocation.
+    SpatialHashGrid(const SpatialHashGrid& grid); //!< Copy constructor, copies every bucket and point.
+    SpatialHashGrid(SpatialHashGrid&& grid); //!< Move constructor, takes the arrays of grid leaving it empty.
+    ~SpatialHashGrid();
+    //! @}
+
+    //>See
+    //! @name Operators
+    //! @{
+    SpatialHashGrid& operator = (const SpatialHashGrid& grid);
+    SpatialHashGrid& operator = (SpatialHashGrid&& grid);
+    //! @}
+
+    //>See
+    //! @name Building
+    //! @{
+
+    //! Builds the grid over count points with cells of side cellSize, replacing any previous one. threadCount threads 
+    //! are used, or one per hardware thread when it's zero. The result doesn't depend on the number of threads.
+    void Build(const Vector3* points, size_t count, float cellSize, unsigned threadCount = 0);
+    //! Builds the grid over the points of a stream. See SpatialHashGrid::Build.
+    void Build(const Vector3Stream& points, float cellSize, unsigned threadCount = 0);
+    //! Empties the grid, keeping its memory for the next build.
+    void Clear();
+    //! @}
+
+    //>See
+    //! @name Queries
+    //! @{
+
+    //! Writes every point within radius of center, including those exactly radius away. A query over more than 64 
+    //! cells marks the buckets it has seen in scratch, which must hold QueryScratchSize() words, all zero, and is left 
+    //! that way. Without scratch, such a query allocates its own.
+    size_t QueryRadius(const Vector3& center, float radius, uint32_t* outIndices, uint32_t* scratch = nullptr) const;
+    //! @}
+
+    //>See
+    //! @name Get Methods
+    //! @{
+
+    //! The number of points the grid was built over.
+    size_t PointCount() const { return pointCount; }
+    //! The side of the grid's cells.
+    float CellSize() const { return cellSize; }
+    //! The number of buckets in the hash table, a power of two.
+    size_t BucketCount() const { return bucketCount; }
+    //! Point indices ordered by bucket. The points of bucket b are those from BucketStarts()[b] to 
+    //! BucketStarts()[b + 1].
+    const uint32_t* Indices() const { return indices; }
+    //! Where each bucket's points start in Indices(), with one more entry holding PointCount().
+    const uint32_t* BucketStarts() const { return bucketStarts; }
+    //! The number of words of scratch a query needs, one bit per bucket.
+    size_t QueryScratchSize() const { return (bucketCount + 31) / 32; }
+    //! @}
+
+private:
+    template <class Points>
+    void BuildPoints(const Points& points, size_t count, float cellSize, unsigned threadCount);
+    uint32_t Bucket(int x, int y, int z) const;
+    void Reserve(size_t points, size_t buckets, unsigned threads);
+    void Release();
+
+    // One allocation holds the x, y and z of the points ordered by bucket, each padded by a group of wide::Width so 
+    // partial groups can be loaded, then their indices and their buckets in input order.
+    float* x;
+    float* y;
+    float* z;
+    uint32_t* indices;
+    uint32_t* pointBuckets;
+    uint32_t* bucketStarts;
+    // Each build thread's count of points per bucket, then its next free place in each bucket.
+    uint32_t* threadCounts;
+    size_t pointCapacity;
+    size_t bucketCapacity;
+    size_t threadCountsCapacity;
+    size_t pointCount;
+    size_t bucketCount;
+    float cellSize;
+    float inverseCellSize;
+};
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,149 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief A translation, a rotation and a scale, applied to points in the reverse order: scale, then rotate, then 
+//! translate.
+//!
+//! Transform keeps the three parts separate so they can be composed, inverted and interpolated directly, without 
+//! building a matrix, and so that animation and scene code can edit one part without decomposing anything. A matrix 
+//! is only made when one is asked for, see Transform::ToMatrix4x4 and Transform::ToMatrixArray, typically once per 
+//! object right before upload. The rotation is expected to be normalized.
+//!
+//! Composing and inverting are exact when scales are uniform. Non uniform scale under a rotation is a shear, which 
+//! can't be held by a scale and a rotation, so like most scene graphs Transform applies the scale of a parent to the 
+//! translation of its child but not to its orientation.
+class _XOSIMDALIGN Transform {
+public:
+    //>See
+    //! @name Constructors
+    //! @{
+    Transform(); //!< Performs no initialization.
+    //! Specify each part.
+    Transform(const Vector3& translation, const Quaternion& rotation, const Vector3& scale);
+    //! A translation and a rotation, with a scale of one.
+    Transform(const Vector3& translation, const Quaternion& rotation);
+    //! @}
+
+    //>See
+    //! @name Special Operators
+    //! @{
+
+    //! Overloads the new and delete operators for Transform when memory alignment is required (such as with SSE).
+    //! @sa XO_16ALIGNED_MALLOC, XO_16ALIGNED_FREE
+    _XO_OVERLOAD_NEW_DELETE();
+    //! @}
+
+    //>See
+    //! @name Operators
+    //! @{
+
+    //! @sa Transform::Multiply
+    _XOINL Transform& operator *= (const Transform& t);
+    //! @sa Transform::Multiply
+    _XOINL Transform operator * (const Transform& t) const;
+    //! Transforms point v. See Transform::TransformPoint.
+    _XOINL Vector3 operator * (const Vector3& v) const;
+    //! @}
+
+    //>See
+    //! @name Methods
+    //! @{
+
+    //! Returns point v scaled, rotated and then translated.
+    _XOINL Vector3 TransformPoint(const Vector3& v) const;
+    //! Returns direction v scaled and rotated, ignoring the translation.
+    _XOINL Vector3 TransformDirection(const Vector3& v) const;
+    //! Returns point v moved back through this transform: translated, rotated and scaled by the inverse of each part. 
+    //! Unlike transforming by Transform::Inverse this is exact for non uniform scales.
+    _XOINL Vector3 InverseTransformPoint(const Vector3& v) const;
+    //! Inverts this transform: the rotation is conjugated, the scale is reciprocated and the translation is moved back 
+    //! through both. Exact when the scale is uniform, see Transform. The result for a scale with a zero element is 
+    //! undefined.
+    Transform& MakeInverse();
+    Transform Inverse() const { return Transform(*this).MakeInverse(); }
+    //! The equivalent Matrix4x4, with vectors as columns as with Matrix4x4::TransformPoints.
+    void ToMatrix(Matrix4x4& outMatrix) const;
+    //! The equivalent Matrix3x4.
+    void ToMatrix(Matrix3x4& outMatrix) const;
+    Matrix4x4 ToMatrix4x4() const { Matrix4x4 m; ToMatrix(m); return m; }
+    Matrix3x4 ToMatrix3x4() const { Matrix3x4 m; ToMatrix(m); return m; }
+
+    //! Transforms count points from vecs, writing the results to outVecs. The transform is converted to a Matrix3x4 
+    //! once for the whole array. vecs and outVecs may be the same array.
+    const Transform& TransformPoints(const Vector3* vecs, Vector3* outVecs, size_t count) const;
+    //! @}
+
+    //>See
+    //! @name Static Methods
+    //! @{
+
+    //! Returns v rotated by the normalized quaternion q, with two cross products rather than two quaternion products 
+    //! or a matrix.
+    _XOINL static Vector3 Rotate(const Quaternion& q, const Vector3& v);
+    //! Assigns outTransform to a * b, the transform applying b then a, such as a parent a and a child b. outTransform 
+    //! may be a or b.
+    _XOINL static void Multiply(const Transform& a, const Transform& b, Transform& outTransform);
+    //! Assigns outTransforms[i] to a[i] * b[i] for count transforms. outTransforms may be a or b.
+    //!
+    //! Each transform is already a translation, a quaternion and a scale, one SSE register each, which is the layout 
+    //! Transform::Multiply works in; transposing wide::Width of them into one register per component measured slower 
+    //! than the transposes save.
+    static void MultiplyArray(const Transform* a, const Transform* b, Transform* outTransforms, size_t count);
+    //! Assigns outTransforms[i] to a * b[i] for count transforms, such as a parent applied to each of its children. 
+    //! outTransforms may be b.
+    static void MultiplyArray(const Transform& a, const Transform* b, Transform* outTransforms, size_t count);
+    //! Converts count transforms to matrices, as Transform::ToMatrix does, wide::Width at a time. For uploading a 
+    //! whole scene or skeleton at once.
+    static void ToMatrixArray(const Transform* transforms, Matrix4x4* outMatrices, size_t count);
+    static void ToMatrixArray(const Transform* transforms, Matrix3x4* outMatrices, size_t count);
+    //! Interpolates each part from a to b by t: the translation and scale are lerped and the rotation is taken by 
+    //! Quaternion::Nlerp.
+    static void Lerp(const Transform& a, const Transform& b, float t, Transform& outTransform);
+    //! As Transform::Lerp, but the rotation is taken by Quaternion::Slerp for a constant angular velocity.
+    static void Slerp(const Transform& a, const Transform& b, float t, Transform& outTransform);
+    //! @}
+
+    //>See
+    //! @name Extras
+    //! @{
+#ifndef XO_NO_OSTREAM
+    //! Prints each part of transform t to the provided ostream.
+    friend std::ostream& operator <<(std::ostream& os, const Transform& t) {
+        os << "\ntranslation: " << t.translation << "\nrotation: (x:" << t.rotation.x << ", y:" << t.rotation.y << ", z:" 
+           << t.rotation.z << ", w:" << t.rotation.w << ")\nscale: " << t.scale << "\n";
+        return os;
+    }
+#endif
+    //! @}
+
+    Vector3 translation;
+    Quaternion rotation;
+    Vector3 scale;
+
+    static const Transform
+        Identity; //!< No translation, the identity rotation and a scale of one.
+};
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,116 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+XOMATH_BEGIN_XO_NS();
+
+#if defined(XO_SSE)
+namespace xo_internal {
+    // v rotated by the normalized quaternion q: t = 2 * cross(q.xyz, v), v' = v + q.w * t + cross(q.xyz, t). The w 
+    // lane of q is carried through the cross products, where it cancels to zero. Each cross product comes out with 
+    // its lanes in z, x, y order and is put back by one more shuffle.
+    _XOINL __m128 TransformRotate(__m128 q, __m128 v) {
+        const __m128 qYZX = _mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 0, 2, 1));
+        __m128 t = _mm_sub_ps(_mm_mul_ps(q, _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 2, 1))), _mm_mul_ps(qYZX, v));
+        t = _mm_shuffle_ps(t, t, _MM_SHUFFLE(3, 0, 2, 1));
+        t = _mm_add_ps(t, t);
+        const __m128 c = _mm_sub_ps(_mm_mul_ps(q, _mm_shuffle_ps(t, t, _MM_SHUFFLE(3, 0, 2, 1))), _mm_mul_ps(qYZX, t));
+        return _mm_add_ps(sse::MulAdd(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 3, 3, 3)), t, v), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1)));
+    }
+
+    // The quaternion product a * b as a sum of b scaled by each element of a, with the elements of b swapped and 
+    // negated to match. The same terms as Quaternion::operator *=.
+    _XOINL __m128 TransformQuaternionMultiply(__m128 a, __m128 b) {
+        __m128 q = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)), b);
+        q = sse::MulAdd(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)),
+                        _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3)), _mm_set_ps(-0.0f, 0.0f, -0.0f, 0.0f)), q);
+        q = sse::MulAdd(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)),
+                        _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2)), _mm_set_ps(-0.0f, -0.0f, 0.0f, 0.0f)), q);
+        return sse::MulAdd(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)),
+                           _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1)), _mm_set_ps(-0.0f, 0.0f, 0.0f, -0.0f)), q);
+    }
+}
+#endif
+
+Transform& Transform::operator *= (const Transform& t) {
+    Multiply(*this, t, *this);
+    return *this;
+}
+
+Transform Transform::operator * (const Transform& t) const {
+    Transform result;
+    Multiply(*this, t, result);
+    return result;
+}
+
+Vector3 Transform::operator * (const Vector3& v) const {
+    return TransformPoint(v);
+}
+
+Vector3 Transform::TransformPoint(const Vector3& v) const {
+#if defined(XO_SSE)
+    return Vector3(_mm_add_ps(translation.xmm, xo_internal::TransformRotate(rotation.xmm, _mm_mul_ps(scale.xmm, v.xmm))));
+#else
+    return translation + Rotate(rotation, scale * v);
+#endif
+}
+
+Vector3 Transform::TransformDirection(const Vector3& v) const {
+#if defined(XO_SSE)
+    return Vector3(xo_internal::TransformRotate(rotation.xmm, _mm_mul_ps(scale.xmm, v.xmm)));
+#else
+    return Rotate(rotation, scale * v);
+#endif
+}
+
+Vector3 Transform::InverseTransformPoint(const Vector3& v) const {
+    return Rotate(rotation.Conjugate(), v - translation) * Vector3(1.0f / scale.x, 1.0f / scale.y, 1.0f / scale.z);
+}
+
+Vector3 Transform::Rotate(const Quaternion& q, const Vector3& v) {
+#if defined(XO_SSE)
+    return Vector3(xo_internal::TransformRotate(q.xmm, v.xmm));
+#else
+    // t = 2 * cross(q.xyz, v), v' = v + q.w * t + cross(q.xyz, t)
+    const Vector3 u(q.x, q.y, q.z);
+    const Vector3 t = u.Cross(v) * 2.0f;
+    return v + (t * q.w) + u.Cross(t);
+#endif
+}
+
+void Transform::Multiply(const Transform& a, const Transform& b, Transform& outTransform) {
+    // Every part of a and b is read before anything is written, so outTransform may alias either input.
+#if defined(XO_SSE)
+    const __m128 translation = _mm_add_ps(a.translation.xmm, xo_internal::TransformRotate(a.rotation.xmm, _mm_mul_ps(a.scale.xmm, b.translation.xmm)));
+    const __m128 rotation = xo_internal::TransformQuaternionMultiply(a.rotation.xmm, b.rotation.xmm);
+    outTransform.scale.xmm = _mm_mul_ps(a.scale.xmm, b.scale.xmm);
+    outTransform.rotation.xmm = rotation;
+    outTransform.translation.xmm = translation;
+#else
+    const Vector3 translation = a.translation + Rotate(a.rotation, a.scale * b.translation);
+    const Quaternion rotation = a.rotation * b.rotation;
+    outTransform.scale = a.scale * b.scale;
+    outTransform.rotation = rotation;
+    outTransform.translation = translation;
+#endif
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,107 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief A triangle as its three corners, with closest point queries.
+//!
+//! Triangle::ClosestPoint finds which Voronoi region of the triangle (a corner, an edge or the face) a point projects 
+//! into, as in Ericson's Real-Time Collision Detection. Triangle::ClosestPoints does the same for a stream of queries, 
+//! wide::Width (4 with SSE, 8 with AVX) per iteration, evaluating every region and selecting with masks.
+//! @sa Segment, OBB
+class _XOSIMDALIGN Triangle {
+public:
+    //>See
+    //! @name Constructors
+    //! @{
+    Triangle() { } //!< Performs no initialization.
+    Triangle(const Vector3& v0, const Vector3& v1, const Vector3& v2) : v0(v0), v1(v1), v2(v2) { } //!< Assigns each named value accordingly.
+    //! @}
+
+    //>See
+    //! @name Set / Get Methods
+    //! @{
+
+    //! Set all. Assigns each named value accordingly.
+    Triangle& Set(const Vector3& v0, const Vector3& v1, const Vector3& v2) {
+        this->v0 = v0;
+        this->v1 = v1;
+        this->v2 = v2;
+        return *this;
+    }
+    //! @}
+
+    //>See
+    //! @name Special Operators
+    //! @{
+
+    //! Overloads the new and delete operators for Triangle when memory alignment is required (such as with SSE).
+    //! @sa XO_16ALIGNED_MALLOC, XO_16ALIGNED_FREE
+    _XO_OVERLOAD_NEW_DELETE();
+    //! @}
+
+    //>See
+    //! @name Methods
+    //! @{
+
+    //! The point of the triangle, including its inside, closest to point.
+    Vector3 ClosestPoint(const Vector3& point) const;
+    //! The corner of the triangle furthest along direction. Makes Triangle a shape for GJK and EPA.
+    Vector3 Support(const Vector3& direction) const {
+        const float d0 = direction.Dot(v0), d1 = direction.Dot(v1), d2 = direction.Dot(v2);
+        return d0 >= d1 ? (d0 >= d2 ? v0 : v2) : (d1 >= d2 ? v1 : v2);
+    }
+    //! @}
+
+    //>See
+    //! @name Stream Methods
+    //! @{
+
+    //! outPoints[i] is the point of the triangle v0[i], v1[i], v2[i] closest to points[i]. See Triangle::ClosestPoint.
+    //! All streams must be the same size. outPoints is resized to it, and may be the same as an input stream. When 
+    //! outDistancesSquared isn't null it must hold as many floats.
+    static void ClosestPoints(const Vector3Stream& points, const Vector3Stream& v0, const Vector3Stream& v1, const Vector3Stream& v2, 
+                              Vector3Stream& outPoints, float* outDistancesSquared = nullptr);
+    //! @}
+
+#ifndef XO_NO_OSTREAM
+    //>See
+    //! @name Extras
+    //! @{
+
+    //! Prints the corners of triangle to the provided ostream.
+    friend std::ostream& operator <<(std::ostream& os, const Triangle& triangle) {
+        os << "(v0:" << triangle.v0 << ", v1:" << triangle.v1 << ", v2:" << triangle.v2 << ")";
+        return os;
+    }
+    //! @}
+#endif
+
+    ////////////////////////////////////////////////////////////////////////// Members
+    // See: http://xo-math.rtfd.io/en/latest/classes/triangle.html#public_members
+    Vector3 v0;
+    Vector3 v1;
+    Vector3 v2;
+};
+
+XOMATH_END_XO_NS();
\ No newline at end of file
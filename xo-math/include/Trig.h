@@ -0,0 +1,237 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+XOMATH_BEGIN_XO_NS();
+
+namespace wide {
+    //! The largest |a| wide::SinCos is accurate for.
+#if defined(XO_FMA) && defined(XO_SSE)
+    _XOCONSTEXPR const float SinCosLimit = 1e6f;
+#else
+    _XOCONSTEXPR const float SinCosLimit = 8192.0f;
+#endif
+
+    //! Sine and cosine of every lane, computed together.
+    //!
+    //! The argument is reduced to [-pi/4, pi/4] by Cody-Waite reduction: k = round(a * 2/pi), then a - k*pi/2 with 
+    //! pi/2 split into four parts, the first three short enough that their products with k are exact. Minimax 
+    //! polynomials (degree 7 for sine, 8 for cosine) are evaluated on the reduced argument and the quadrant k mod 4 
+    //! picks and signs the results.
+    //!
+    //! Measured against double precision sin and cos the max error is 1.6 ulp for |a| <= 1000 and 2.3 ulp for 
+    //! |a| <= 8192. Without FMA the reduction is only exact up to |a| of about 12000, past that results fall apart. 
+    //! With FMA the error stays under 4 ulp up to |a| of 1e6. Infinity and NaN produce NaN. Lanes past SinCosLimit 
+    //! should be recomputed with the C library, as xo-math's own Sin and Cos functions do.
+    _XOINL void SinCos(Float a, Float& outSin, Float& outCos) {
+        const Float k = Round(Mul(a, Set(0.636619772f)));
+        Float r = NegMulAdd(k, Set(1.5703125f), a);
+        r = NegMulAdd(k, Set(4.837512969970703125e-4f), r);
+        r = NegMulAdd(k, Set(7.549533620476723e-8f), r);
+        r = NegMulAdd(k, Set(2.5633440682570896e-12f), r);
+        const Float r2 = Mul(r, r);
+
+        Float s = MulAdd(r2, Set(-1.9515295891e-4f), Set(8.3321608736e-3f));
+        s = MulAdd(s, r2, Set(-1.6666654611e-1f));
+        s = MulAdd(Mul(s, r2), r, r);
+        Float c = MulAdd(r2, Set(2.443315711809948e-5f), Set(-1.388731625493765e-3f));
+        c = MulAdd(c, r2, Set(4.166664568298827e-2f));
+        c = MulAdd(c, Mul(r2, r2), NegMulAdd(r2, Set(0.5f), Set(1.0f)));
+
+        // The quadrant bits are found with float math, AVX (without AVX2) has no 256 bit integer operations.
+        const Float half = Floor(Mul(k, Set(0.5f)));
+        const Float bit0 = Sub(k, Add(half, half));
+        const Float bit1 = Sub(half, Mul(Floor(Mul(k, Set(0.25f))), Set(2.0f)));
+        const Float swap = CmpNeq(bit0, Zero());
+        outSin = Xor(Select(swap, c, s), And(CmpNeq(bit1, Zero()), SignBit()));
+        outCos = Xor(Select(swap, s, c), And(CmpNeq(bit0, bit1), SignBit()));
+    }
+    _XOINL Float Sin(Float a) {
+        Float s, c;
+        SinCos(a, s, c);
+        return s;
+    }
+    _XOINL Float Cos(Float a) {
+        Float s, c;
+        SinCos(a, s, c);
+        return c;
+    }
+}
+
+namespace xo_internal {
+    // Overwrites the results of the lanes set in large, those past wide::SinCosLimit, with the C library's. Either 
+    // output may be null.
+    _XOINL void SinCosLargeLanes(const float* f, float* s, float* c, int large) {
+        for (int i = 0; large; ++i, large >>= 1) {
+            if (large & 1) {
+                if (s) s[i] = sinf(f[i]);
+                if (c) c[i] = cosf(f[i]);
+            }
+        }
+    }
+
+    // wide::SinCos over Count (2 to 4) floats in 16 byte aligned memory. Lanes past Count are neither read nor 
+    // written. Either output may be null when it isn't wanted.
+    template <int Count>
+    _XOINL void SinCosQuad(const float* f, float* s, float* c) {
+#if defined(XO_SSE)
+        __m128 v = Count == 4 ? _mm_load_ps(f) : _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)f);
+        if (Count == 3) {
+            v = _mm_movelh_ps(v, _mm_load_ss(f + 2));
+        }
+        const int large = _mm_movemask_ps(_mm_cmpgt_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), v), _mm_set1_ps(wide::SinCosLimit)));
+#   if defined(XO_AVX)
+        __m256 sw, cw;
+        wide::SinCos(_mm256_insertf128_ps(_mm256_setzero_ps(), v, 0), sw, cw);
+        const __m128 sv = _mm256_castps256_ps128(sw), cv = _mm256_castps256_ps128(cw);
+#   else
+        __m128 sv, cv;
+        wide::SinCos(v, sv, cv);
+#   endif
+        float* outs[2] = { s, c };
+        const __m128 results[2] = { sv, cv };
+        for (int i = 0; i < 2; ++i) {
+            if (!outs[i]) {
+                continue;
+            }
+            if (Count == 4) {
+                _mm_store_ps(outs[i], results[i]);
+            }
+            else {
+                _mm_storel_pi((__m64*)outs[i], results[i]);
+                if (Count == 3) {
+                    _mm_store_ss(outs[i] + 2, _mm_movehl_ps(results[i], results[i]));
+                }
+            }
+        }
+        if (large) {
+            SinCosLargeLanes(f, s, c, large);
+        }
+#else
+        for (int i = 0; i < Count; ++i) {
+            float sv, cv;
+            if (Abs(f[i]) > wide::SinCosLimit) {
+                sv = sinf(f[i]);
+                cv = cosf(f[i]);
+            }
+            else {
+                wide::SinCos(f[i], sv, cv);
+            }
+            if (s) s[i] = sv;
+            if (c) c[i] = cv;
+        }
+#endif
+    }
+}
+
+//! Sine and cosine of f in one call, using wide::SinCos on a single lane. Results may differ from Sin and Cos, which 
+//! use the C library, by a couple of ulp. Arguments past wide::SinCosLimit go to the C library instead.
+_XOINL
+void SinCos(float f, float& s, float& c) {
+    if (Abs(f) > wide::SinCosLimit) {
+        s = sinf(f);
+        c = cosf(f);
+        return;
+    }
+#if defined(XO_AVX)
+    __m256 sw, cw;
+    wide::SinCos(_mm256_set1_ps(f), sw, cw);
+    s = _mm_cvtss_f32(_mm256_castps256_ps128(sw));
+    c = _mm_cvtss_f32(_mm256_castps256_ps128(cw));
+#elif defined(XO_SSE)
+    __m128 sv, cv;
+    wide::SinCos(_mm_set_ss(f), sv, cv);
+    s = _mm_cvtss_f32(sv);
+    c = _mm_cvtss_f32(cv);
+#else
+    wide::SinCos(f, s, c);
+#endif
+}
+
+//>See
+//! @name Aligned Sin / Cos
+//! Vectorized with wide::SinCos, with arguments past wide::SinCosLimit going to the C library. Every pointer must be 
+//! 16 byte aligned.
+//! @{
+_XOINL
+void Sin_x2(const float* f, float* s) {
+    XO_ASSERT(IsAligned16(f) && IsAligned16(s), "xo-math Sin_x2 requires aligned params.");
+    xo_internal::SinCosQuad<2>(f, s, nullptr);
+}
+
+_XOINL
+void Sin_x3(const float* f, float* s) {
+    XO_ASSERT(IsAligned16(f) && IsAligned16(s), "xo-math Sin_x3 requires aligned params.");
+    xo_internal::SinCosQuad<3>(f, s, nullptr);
+}
+
+_XOINL
+void Sin_x4(const float* f, float* s) {
+    XO_ASSERT(IsAligned16(f) && IsAligned16(s), "xo-math Sin_x4 requires aligned params.");
+    xo_internal::SinCosQuad<4>(f, s, nullptr);
+}
+
+_XOINL
+void Cos_x2(const float* f, float* c) {
+    XO_ASSERT(IsAligned16(f) && IsAligned16(c), "xo-math Cos_x2 requires aligned params.");
+    xo_internal::SinCosQuad<2>(f, nullptr, c);
+}
+
+_XOINL
+void Cos_x3(const float* f, float* c) {
+    XO_ASSERT(IsAligned16(f) && IsAligned16(c), "xo-math Cos_x3 requires aligned params.");
+    xo_internal::SinCosQuad<3>(f, nullptr, c);
+}
+
+_XOINL
+void Cos_x4(const float* f, float* c) {
+    XO_ASSERT(IsAligned16(f) && IsAligned16(c), "xo-math Cos_x4 requires aligned params.");
+    xo_internal::SinCosQuad<4>(f, nullptr, c);
+}
+
+_XOINL
+void SinCos_x2(const float* f, float* s, float* c) {
+    XO_ASSERT(IsAligned16(f) && IsAligned16(s) && IsAligned16(c), "xo-math SinCos_x2 requires aligned params.");
+    xo_internal::SinCosQuad<2>(f, s, c);
+}
+
+_XOINL
+void SinCos_x3(const float* f, float* s, float* c) {
+    XO_ASSERT(IsAligned16(f) && IsAligned16(s) && IsAligned16(c), "xo-math SinCos_x3 requires aligned params.");
+    xo_internal::SinCosQuad<3>(f, s, c);
+}
+
+_XOINL
+void SinCos_x4(const float* f, float* s, float* c) {
+    XO_ASSERT(IsAligned16(f) && IsAligned16(s) && IsAligned16(c), "xo-math SinCos_x4 requires aligned params.");
+    xo_internal::SinCosQuad<4>(f, s, c);
+}
+//! @}
+
+//>See
+//! @name Sin / Cos Arrays
+//! wide::SinCos over count floats, wide::Width at a time. No alignment is required and the output may be the input.
+//! @{
+void SinArray(const float* f, float* outSin, size_t count);
+void CosArray(const float* f, float* outCos, size_t count);
+void SinCosArray(const float* f, float* outSin, float* outCos, size_t count);
+//! @}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -226,6 +226,29 @@ public:
     Vector2 Normalized() const {
         return Vector2(*this).Normalize();
     }
+
+    //! Normalizes this vector to a Magnitude of 1 with the precision policy P. Normalize() without a policy divides 
+    //! by Magnitude() as picked by XO_NO_INVERSE_DIVISION.
+    //! @sa Precision
+    template <Precision P>
+    Vector2& Normalize() {
+        return (*this) *= InvSqrt<P>(MagnitudeSquared());
+    }
+    //! Returns a copy of this vector with a Magnitude of 1, using the precision policy P.
+    template <Precision P>
+    Vector2 Normalized() const {
+        return Vector2(*this).Normalize<P>();
+    }
+    //! 1/Magnitude() with the precision policy P.
+    template <Precision P = Precision::Exact>
+    float InverseMagnitude() const {
+        return InvSqrt<P>(MagnitudeSquared());
+    }
+    //! Returns the reciprocal of each element with the precision policy P.
+    //!
+    //! \f$\begin{pmatrix}1/x,&1/y\end{pmatrix}\f$
+    template <Precision P = Precision::Exact>
+    _XOINL Vector2 Reciprocal() const;
     //! @}
 
     //>See
@@ -182,4 +182,14 @@ Vector2 Abs(const Vector2& v)
     return Vector2(Abs(v.x), Abs(v.y));
 }
 
+template <Precision P>
+Vector2 Vector2::Reciprocal() const {
+#if defined(XO_SSE)
+    const __m128 r = sse::Reciprocal<P>(_mm_setr_ps(x, y, 1.0f, 1.0f));
+    return Vector2(_mm_cvtss_f32(r), _mm_cvtss_f32(_mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 1, 1, 1))));
+#else
+    return Vector2(1.0f / x, 1.0f / y);
+#endif
+}
+
 XOMATH_END_XO_NS();
\ No newline at end of file
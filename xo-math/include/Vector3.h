@@ -237,6 +237,27 @@ public:
         return Vector3(*this).Normalize();
     }
 
+    //! Normalizes this vector to a Magnitude of 1 with the precision policy P. Normalize() without a policy divides 
+    //! by Magnitude() as picked by XO_NO_INVERSE_DIVISION.
+    //! @sa Precision
+    template <Precision P>
+    _XOINL Vector3& Normalize();
+    //! Returns a copy of this vector with a Magnitude of 1, using the precision policy P.
+    template <Precision P>
+    Vector3 Normalized() const {
+        return Vector3(*this).Normalize<P>();
+    }
+    //! 1/Magnitude() with the precision policy P.
+    template <Precision P = Precision::Exact>
+    float InverseMagnitude() const {
+        return InvSqrt<P>(MagnitudeSquared());
+    }
+    //! Returns the reciprocal of each element with the precision policy P.
+    //!
+    //! \f$\begin{pmatrix}1/x,&1/y,&1/z\end{pmatrix}\f$
+    template <Precision P = Precision::Exact>
+    _XOINL Vector3 Reciprocal() const;
+
     Vector3 NormalizedSafe() const {
         return Vector3(*this).NormalizeSafe();
     }
@@ -263,13 +284,21 @@ public:
     //!
     //! \f$\begin{pmatrix}\max(a.x, b.x)&\max(a.y, b.y)&\max(a.z, b.z)\end{pmatrix}\f$
     static void Max(const Vector3& a, const Vector3& b, Vector3& outVec) {
+#if defined(XO_SSE)
+        outVec.xmm = _mm_max_ps(a.xmm, b.xmm);
+#else
         outVec.Set(_XO_MAX(a.x, b.x), _XO_MAX(a.y, b.y), _XO_MAX(a.z, b.z));
+#endif
     }
     //! Set outVec to have elements equal to the min of each element in a and b.
     //!
     //! \f$\begin{pmatrix}\min(a.x, b.x)&\min(a.y, b.y)&\min(a.z, b.z)\end{pmatrix}\f$
     static void Min(const Vector3& a, const Vector3& b, Vector3& outVec) {
+#if defined(XO_SSE)
+        outVec.xmm = _mm_min_ps(a.xmm, b.xmm);
+#else
         outVec.Set(_XO_MIN(a.x, b.x), _XO_MIN(a.y, b.y), _XO_MIN(a.z, b.z));
+#endif
     }
     //! Calls Vector3::RotateRadians, converting the input angle in degrees to radians.
     static void RotateDegrees(const Vector3& v, const Vector3& axis, float angle, Vector3& outVec) {
@@ -326,7 +355,8 @@ public:
         Vector3::RotateRadians(forward, up, RandomRange(-angle*0.5f, angle*0.5f), outVec);
     }
     static void RandomInCube(float size, Vector3& outVec) {
-        outVec.Set(RandomRange(-size, size), RandomRange(-size, size), RandomRange(-size, size));
+        RandomGenerator& rng = RandomGenerator::ThreadLocal();
+        outVec.Set(rng.Range(-size, size), rng.Range(-size, size), rng.Range(-size, size));
     }
     static void RandomInSphere(float minRadius, float maxRadius, Vector3& outVec) {
         RandomOnSphere(Sqrt(RandomRange(minRadius, maxRadius)), outVec);
@@ -361,6 +391,33 @@ public:
 
     //! @}
 
+    //>See
+    //! @name Random Array Methods
+    //! Bulk versions of the random methods for particle emitters and the like. Each writes count samples, either to 
+    //! outVecs or as a structure of arrays to outX, outY and outZ (which may be the arrays of a Vector3Stream resized 
+    //! to count). No alignment is required.
+    //!
+    //! Random floats are drawn in batches from RandomGenerator::ThreadLocal, the cone or circle frame is built once 
+    //! per call and samples are made wide::Width at a time with wide::SinCos and no branches. The shapes follow the 
+    //! single sample methods: cones tilt up to (In) or exactly (On) half the angle away from forward and keep its 
+    //! length, circles are perpendicular to up. Spheres use Archimedes' method rather than rejection.
+    //! @{
+    static void RandomInCircleArray(const Vector3& up, float radius, Vector3* outVecs, size_t count);
+    static void RandomInCircleArray(const Vector3& up, float radius, float* outX, float* outY, float* outZ, size_t count);
+    static void RandomOnCircleArray(const Vector3& up, float radius, Vector3* outVecs, size_t count);
+    static void RandomOnCircleArray(const Vector3& up, float radius, float* outX, float* outY, float* outZ, size_t count);
+    static void RandomInConeRadiansArray(const Vector3& forward, float angle, Vector3* outVecs, size_t count);
+    static void RandomInConeRadiansArray(const Vector3& forward, float angle, float* outX, float* outY, float* outZ, size_t count);
+    static void RandomOnConeRadiansArray(const Vector3& forward, float angle, Vector3* outVecs, size_t count);
+    static void RandomOnConeRadiansArray(const Vector3& forward, float angle, float* outX, float* outY, float* outZ, size_t count);
+    static void RandomInCubeArray(float size, Vector3* outVecs, size_t count);
+    static void RandomInCubeArray(float size, float* outX, float* outY, float* outZ, size_t count);
+    static void RandomOnCubeArray(float size, Vector3* outVecs, size_t count);
+    static void RandomOnCubeArray(float size, float* outX, float* outY, float* outZ, size_t count);
+    static void RandomOnSphereArray(float radius, Vector3* outVecs, size_t count);
+    static void RandomOnSphereArray(float radius, float* outX, float* outY, float* outZ, size_t count);
+    //! @}
+
 #define _RET_VARIANT(name) { Vector3 tempV; name(
 #define _RET_VARIANT_END() tempV); return tempV; }
 #define _RET_VARIANT_0(name)                                 _RET_VARIANT(name)                               _RET_VARIANT_END()
@@ -279,7 +279,11 @@ bool Vector3::operator == (const Vector3& v) const {
     // what we're doing in SSE2
     return CloseEnough(x, v.x, sse::SSEFloatEpsilon) && CloseEnough(y, v.y, sse::SSEFloatEpsilon) && CloseEnough(z, v.z, sse::SSEFloatEpsilon);
 #   else
-    return CloseEnough(x, v.x, Epsilon) && CloseEnough(y, v.y, Epsilon) && CloseEnough(z, v.z, Epsilon);
+    // CloseEnough is relative, so only zero itself would equal zero: elements near zero get the absolute tolerance SSE2 
+    // uses.
+    return (Abs(x - v.x) < Epsilon || CloseEnough(x, v.x, Epsilon)) && 
+           (Abs(y - v.y) < Epsilon || CloseEnough(y, v.y, Epsilon)) && 
+           (Abs(z - v.z) < Epsilon || CloseEnough(z, v.z, Epsilon));
 #   endif
 }
 bool Vector3::operator == (float v) const                   { return CloseEnough(MagnitudeSquared(), v*v, Epsilon);}
@@ -317,4 +321,27 @@ Vector3 Abs(const Vector3& v)
 #endif
 }
 
+template <Precision P>
+Vector3& Vector3::Normalize() {
+#if defined(XO_SSE4_1)
+    // the dot product lands in every lane, so the scale never leaves the register.
+    xmm = _mm_mul_ps(xmm, sse::InvSqrt<P>(_mm_dp_ps(xmm, xmm, 0x7f)));
+#elif defined(XO_SSE)
+    xmm = _mm_mul_ps(xmm, sse::InvSqrt<P>(_mm_set_ps1(MagnitudeSquared())));
+#else
+    (*this) *= InvSqrt<P>(MagnitudeSquared());
+#endif
+    return *this;
+}
+
+template <Precision P>
+Vector3 Vector3::Reciprocal() const {
+#if defined(XO_SSE)
+    // w is 0, keep it that way rather than letting it become infinity.
+    return Vector3(_mm_and_ps(sse::Reciprocal<P>(xmm), MASK));
+#else
+    return Vector3(1.0f / x, 1.0f / y, 1.0f / z);
+#endif
+}
+
 XOMATH_END_XO_NS();
\ No newline at end of file
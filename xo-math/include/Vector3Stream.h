@@ -0,0 +1,139 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief A structure of arrays container for many Vector3 values.
+//!
+//! Where a Vector3 array interleaves x, y, z (and w when SIMD is in use), a Vector3Stream keeps all x values in one 
+//! array, all y values in another and all z values in a third. Each array starts on an XO_STREAM_ALIGNMENT boundary 
+//! and is padded to a whole multiple of it, so bulk methods can process 4 (SSE) or 8 (AVX) vectors 
+//! per instruction without any horizontal operations.
+//!
+//! Bulk static methods take their output stream as the last parameter, which is resized to fit. The output may be 
+//! one of the inputs.
+//! @sa XO_ALIGNED_MALLOC, XO_ALIGNED_FREE
+class Vector3Stream {
+public:
+    //>See
+    //! @name Constructors
+    //! @{
+    Vector3Stream(); //!< An empty stream, performs no allocation.
+    explicit Vector3Stream(size_t count); //!< A stream of count zero vectors.
+    Vector3Stream(const Vector3* vecs, size_t count); //!< A stream holding a copy of count vectors from vecs.
+    Vector3Stream(const Vector3Stream& stream); //!< Copy constructor, copies each element.
+    Vector3Stream(Vector3Stream&& stream); //!< Move constructor, takes the arrays of stream leaving it empty.
+    ~Vector3Stream();
+    //! @}
+
+    //>See
+    //! @name Set / Get Methods
+    //! @{
+
+    //! Changes the number of vectors held. Existing vectors are kept up to the smaller of the two sizes, new vectors are zero.
+    void Resize(size_t count);
+    //! Set all. The stream is resized to count and filled with a copy of vecs.
+    void Set(const Vector3* vecs, size_t count);
+    //! Set one. Assigns v to the vector at index i.
+    void Set(size_t i, const Vector3& v) {
+        XO_ASSERT(i < size, "xo-math Vector3Stream::Set index out of range.");
+        x[i] = v.x;
+        y[i] = v.y;
+        z[i] = v.z;
+    }
+    //! Extract all getter. Writes every vector of the stream to vecs, which must hold at least Size() vectors.
+    void Get(Vector3* vecs) const;
+    //! Extract one getter. Returns the vector at index i.
+    Vector3 Get(size_t i) const {
+        XO_ASSERT(i < size, "xo-math Vector3Stream::Get index out of range.");
+        return Vector3(x[i], y[i], z[i]);
+    }
+    //! The number of vectors held.
+    size_t Size() const { return size; }
+    //! The number of floats in each of the x, y and z arrays, including padding. A multiple of wide::Width.
+    size_t Capacity() const { return capacity; }
+
+    float* X() { return x; } //!< The x array, aligned to XO_STREAM_ALIGNMENT.
+    float* Y() { return y; } //!< The y array, aligned to XO_STREAM_ALIGNMENT.
+    float* Z() { return z; } //!< The z array, aligned to XO_STREAM_ALIGNMENT.
+    const float* X() const { return x; } //!< The x array, aligned to XO_STREAM_ALIGNMENT.
+    const float* Y() const { return y; } //!< The y array, aligned to XO_STREAM_ALIGNMENT.
+    const float* Z() const { return z; } //!< The z array, aligned to XO_STREAM_ALIGNMENT.
+    //! @}
+
+    //>See
+    //! @name Operators
+    //! Operates element-wise on every vector in the stream. Streams must be the same size.
+    //! @{
+    Vector3Stream& operator = (const Vector3Stream& stream);
+    Vector3Stream& operator = (Vector3Stream&& stream);
+    Vector3Stream& operator += (const Vector3Stream& stream) { Add(*this, stream, *this); return *this; }
+    Vector3Stream& operator -= (const Vector3Stream& stream) { Subtract(*this, stream, *this); return *this; }
+    Vector3Stream& operator *= (const Vector3Stream& stream) { Multiply(*this, stream, *this); return *this; }
+    Vector3Stream& operator *= (float f) { Scale(*this, f, *this); return *this; }
+    //! @}
+
+    //>See
+    //! @name Static Methods
+    //! Bulk equivalents of the same-name Vector3 methods.
+    //! @{
+
+    //! outStream[i] = a[i] + b[i]
+    static void Add(const Vector3Stream& a, const Vector3Stream& b, Vector3Stream& outStream);
+    //! outStream[i] = a[i] + v
+    static void Add(const Vector3Stream& a, const Vector3& v, Vector3Stream& outStream);
+    //! outStream[i] = a[i] - b[i]
+    static void Subtract(const Vector3Stream& a, const Vector3Stream& b, Vector3Stream& outStream);
+    //! outStream[i] = a[i] * b[i], element-wise.
+    static void Multiply(const Vector3Stream& a, const Vector3Stream& b, Vector3Stream& outStream);
+    //! outStream[i] = a[i] * f
+    static void Scale(const Vector3Stream& a, float f, Vector3Stream& outStream);
+    //! outStream[i] = a[i] + ((b[i] - a[i]) * t)
+    //! @sa Vector3::Lerp
+    static void Lerp(const Vector3Stream& a, const Vector3Stream& b, float t, Vector3Stream& outStream);
+    //! outStream[i] = a[i] x b[i]
+    //! @sa Vector3::Cross
+    static void Cross(const Vector3Stream& a, const Vector3Stream& b, Vector3Stream& outStream);
+    //! outStream[i] = a[i] with a magnitude of 1. Zero length vectors are left as zero, as with Vector3::NormalizeSafe.
+    //! Uses a refined reciprocal square root unless XO_NO_INVERSE_DIVISION is defined.
+    //! @sa XO_NO_INVERSE_DIVISION
+    static void Normalize(const Vector3Stream& a, Vector3Stream& outStream);
+    //! outFloats[i] = a[i] . b[i] where outFloats holds at least a.Size() floats.
+    //! @sa Vector3::Dot
+    static void Dot(const Vector3Stream& a, const Vector3Stream& b, float* outFloats);
+    //! outFloats[i] = |a[i]| where outFloats holds at least a.Size() floats.
+    static void Magnitude(const Vector3Stream& a, float* outFloats);
+    //! outFloats[i] = |a[i]|^2 where outFloats holds at least a.Size() floats.
+    static void MagnitudeSquared(const Vector3Stream& a, float* outFloats);
+    //! @}
+
+private:
+    void Allocate(size_t count);
+    void Release();
+
+    float* x;
+    float* y;
+    float* z;
+    size_t size;
+    size_t capacity;
+};
+
+XOMATH_END_XO_NS();
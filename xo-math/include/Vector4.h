@@ -256,6 +256,27 @@ public:
         return Vector4(*this).Normalize();
     }
 
+    //! Normalizes this vector to a Magnitude of 1 with the precision policy P. Normalize() without a policy divides 
+    //! by Magnitude() as picked by XO_NO_INVERSE_DIVISION.
+    //! @sa Precision
+    template <Precision P>
+    _XOINL Vector4& Normalize();
+    //! Returns a copy of this vector with a Magnitude of 1, using the precision policy P.
+    template <Precision P>
+    Vector4 Normalized() const {
+        return Vector4(*this).Normalize<P>();
+    }
+    //! 1/Magnitude() with the precision policy P.
+    template <Precision P = Precision::Exact>
+    float InverseMagnitude() const {
+        return InvSqrt<P>(MagnitudeSquared());
+    }
+    //! Returns the reciprocal of each element with the precision policy P.
+    //!
+    //! \f$\begin{pmatrix}1/x,&1/y,&1/z,&1/w\end{pmatrix}\f$
+    template <Precision P = Precision::Exact>
+    _XOINL Vector4 Reciprocal() const;
+
     Vector3 NormalizedSafe() const {
         return Vector3(*this).NormalizeSafe();
     }
@@ -274,13 +295,21 @@ public:
     //!
     //! \f$\begin{pmatrix}\max(a.x, b.x)&\max(a.y, b.y)&\max(a.z, b.z)&\max(a.w, b.w)\end{pmatrix}\f$
     static void Max(const Vector4& a, const Vector4& b, Vector4& outVec) {
+#if defined(XO_SSE)
+        outVec.xmm = _mm_max_ps(a.xmm, b.xmm);
+#else
         outVec.Set(_XO_MAX(a.x, b.x), _XO_MAX(a.y, b.y), _XO_MAX(a.z, b.z), _XO_MAX(a.w, b.w));
+#endif
     }
     //! Set outVec to have elements equal to the min of each element in a and b.
     //!
     //! \f$\begin{pmatrix}\min(a.x, b.x)&\min(a.y, b.y)&\min(a.z, b.z)&\min(a.w, b.w)\end{pmatrix}\f$
     static void Min(const Vector4& a, const Vector4& b, Vector4& outVec) {
+#if defined(XO_SSE)
+        outVec.xmm = _mm_min_ps(a.xmm, b.xmm);
+#else
         outVec.Set(_XO_MIN(a.x, b.x), _XO_MIN(a.y, b.y), _XO_MIN(a.z, b.z), _XO_MIN(a.w, b.w));
+#endif
     }
     //! Returns the distance between vectors a and b in 4 dimensional space.
     //! It's preferred to use the DistanceSquared when possible, as Distance requires a call to Sqrt.
@@ -364,4 +364,26 @@ Vector4 Abs(const Vector4& v)
 #undef IDX_Z
 #undef IDX_W
 
+template <Precision P>
+Vector4& Vector4::Normalize() {
+#if defined(XO_SSE4_1)
+    // the dot product lands in every lane, so the scale never leaves the register.
+    xmm = _mm_mul_ps(xmm, sse::InvSqrt<P>(_mm_dp_ps(xmm, xmm, 0xff)));
+#elif defined(XO_SSE)
+    xmm = _mm_mul_ps(xmm, sse::InvSqrt<P>(_mm_set_ps1(MagnitudeSquared())));
+#else
+    (*this) *= InvSqrt<P>(MagnitudeSquared());
+#endif
+    return *this;
+}
+
+template <Precision P>
+Vector4 Vector4::Reciprocal() const {
+#if defined(XO_SSE)
+    return Vector4(sse::Reciprocal<P>(xmm));
+#else
+    return Vector4(1.0f / x, 1.0f / y, 1.0f / z, 1.0f / w);
+#endif
+}
+
 XOMATH_END_XO_NS();
\ No newline at end of file
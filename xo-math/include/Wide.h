@@ -0,0 +1,339 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+XOMATH_BEGIN_XO_NS();
+
+//! @brief Width agnostic helpers for the bulk (array and stream) kernels.
+//!
+//! wide::Float is the widest float register xo-math is compiled for: __m256 with AVX, __m128 with SSE and a plain 
+//! float otherwise. Kernels written against these helpers handle wide::Width elements per step using only vertical 
+//! operations, so the same kernel source serves every instruction set.
+//!
+//! Comparisons return a mask with all bits set in each lane where the comparison holds. Masks can be combined with 
+//! And/Or/AndNot and consumed by Select or MoveMask.
+namespace wide {
+#if defined(XO_AVX)
+    typedef __m256 Float;
+    _XOCONSTEXPR const int Width = 8;
+
+    _XOINL Float Load(const float* f)                   { return _mm256_load_ps(f); }
+    _XOINL Float LoadUnaligned(const float* f)          { return _mm256_loadu_ps(f); }
+    _XOINL void Store(float* f, Float v)                { _mm256_store_ps(f, v); }
+    _XOINL void StoreUnaligned(float* f, Float v)       { _mm256_storeu_ps(f, v); }
+    _XOINL Float Set(float f)                           { return _mm256_set1_ps(f); }
+    _XOINL Float Zero()                                 { return _mm256_setzero_ps(); }
+
+    _XOINL Float Add(Float a, Float b)                  { return _mm256_add_ps(a, b); }
+    _XOINL Float Sub(Float a, Float b)                  { return _mm256_sub_ps(a, b); }
+    _XOINL Float Mul(Float a, Float b)                  { return _mm256_mul_ps(a, b); }
+    _XOINL Float Div(Float a, Float b)                  { return _mm256_div_ps(a, b); }
+    _XOINL Float Min(Float a, Float b)                  { return _mm256_min_ps(a, b); }
+    _XOINL Float Max(Float a, Float b)                  { return _mm256_max_ps(a, b); }
+    _XOINL Float Sqrt(Float a)                          { return _mm256_sqrt_ps(a); }
+    _XOINL Float RcpEstimate(Float a)                   { return _mm256_rcp_ps(a); }
+    _XOINL Float RsqrtEstimate(Float a)                 { return _mm256_rsqrt_ps(a); }
+    _XOINL Float Round(Float a)                         { return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+    _XOINL Float Floor(Float a)                         { return _mm256_floor_ps(a); }
+
+    _XOINL Float And(Float a, Float b)                  { return _mm256_and_ps(a, b); }
+    _XOINL Float AndNot(Float a, Float b)               { return _mm256_andnot_ps(a, b); } //!< (~a) & b
+    _XOINL Float Or(Float a, Float b)                   { return _mm256_or_ps(a, b); }
+    _XOINL Float Xor(Float a, Float b)                  { return _mm256_xor_ps(a, b); }
+
+    _XOINL Float CmpEq(Float a, Float b)                { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+    _XOINL Float CmpNeq(Float a, Float b)               { return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ); }
+    _XOINL Float CmpLt(Float a, Float b)                { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    _XOINL Float CmpLe(Float a, Float b)                { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    _XOINL Float CmpGt(Float a, Float b)                { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    _XOINL Float CmpGe(Float a, Float b)                { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    //! Per lane: mask ? a : b
+    _XOINL Float Select(Float mask, Float a, Float b)   { return _mm256_blendv_ps(b, a, mask); }
+    //! One bit per lane, taken from the lane's sign bit. Lane 0 is the lowest bit.
+    _XOINL int MoveMask(Float mask)                     { return _mm256_movemask_ps(mask); }
+#elif defined(XO_SSE)
+    typedef __m128 Float;
+    _XOCONSTEXPR const int Width = 4;
+
+    _XOINL Float Load(const float* f)                   { return _mm_load_ps(f); }
+    _XOINL Float LoadUnaligned(const float* f)          { return _mm_loadu_ps(f); }
+    _XOINL void Store(float* f, Float v)                { _mm_store_ps(f, v); }
+    _XOINL void StoreUnaligned(float* f, Float v)       { _mm_storeu_ps(f, v); }
+    _XOINL Float Set(float f)                           { return _mm_set1_ps(f); }
+    _XOINL Float Zero()                                 { return _mm_setzero_ps(); }
+
+    _XOINL Float Add(Float a, Float b)                  { return _mm_add_ps(a, b); }
+    _XOINL Float Sub(Float a, Float b)                  { return _mm_sub_ps(a, b); }
+    _XOINL Float Mul(Float a, Float b)                  { return _mm_mul_ps(a, b); }
+    _XOINL Float Div(Float a, Float b)                  { return _mm_div_ps(a, b); }
+    _XOINL Float Min(Float a, Float b)                  { return _mm_min_ps(a, b); }
+    _XOINL Float Max(Float a, Float b)                  { return _mm_max_ps(a, b); }
+    _XOINL Float Sqrt(Float a)                          { return _mm_sqrt_ps(a); }
+    _XOINL Float RcpEstimate(Float a)                   { return _mm_rcp_ps(a); }
+    _XOINL Float RsqrtEstimate(Float a)                 { return _mm_rsqrt_ps(a); }
+
+    _XOINL Float And(Float a, Float b)                  { return _mm_and_ps(a, b); }
+    _XOINL Float AndNot(Float a, Float b)               { return _mm_andnot_ps(a, b); } //!< (~a) & b
+    _XOINL Float Or(Float a, Float b)                   { return _mm_or_ps(a, b); }
+    _XOINL Float Xor(Float a, Float b)                  { return _mm_xor_ps(a, b); }
+
+    _XOINL Float CmpEq(Float a, Float b)                { return _mm_cmpeq_ps(a, b); }
+    _XOINL Float CmpNeq(Float a, Float b)               { return _mm_cmpneq_ps(a, b); }
+    _XOINL Float CmpLt(Float a, Float b)                { return _mm_cmplt_ps(a, b); }
+    _XOINL Float CmpLe(Float a, Float b)                { return _mm_cmple_ps(a, b); }
+    _XOINL Float CmpGt(Float a, Float b)                { return _mm_cmpgt_ps(a, b); }
+    _XOINL Float CmpGe(Float a, Float b)                { return _mm_cmpge_ps(a, b); }
+    //! Per lane: mask ? a : b
+    _XOINL Float Select(Float mask, Float a, Float b) {
+#   if defined(XO_SSE4_1)
+        return _mm_blendv_ps(b, a, mask);
+#   else
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+#   endif
+    }
+    //! One bit per lane, taken from the lane's sign bit. Lane 0 is the lowest bit.
+    _XOINL int MoveMask(Float mask)                     { return _mm_movemask_ps(mask); }
+
+#   if defined(XO_SSE4_1)
+    _XOINL Float Round(Float a)                         { return _mm_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+    _XOINL Float Floor(Float a)                         { return _mm_floor_ps(a); }
+#   else
+    //! Round to nearest even. Adding and removing 1.5*2^23 pushes the fraction out of the mantissa, valid for |a| < 2^22.
+    _XOINL Float Round(Float a) {
+        const Float magic = _mm_set1_ps(12582912.0f);
+        return _mm_sub_ps(_mm_add_ps(a, magic), magic);
+    }
+    _XOINL Float Floor(Float a) {
+        Float r = Round(a);
+        return _mm_sub_ps(r, _mm_and_ps(_mm_cmpgt_ps(r, a), _mm_set1_ps(1.0f)));
+    }
+#   endif
+#else
+    typedef float Float;
+    _XOCONSTEXPR const int Width = 1;
+
+    _XOINL unsigned Bits(float f) {
+        union {
+            float f;
+            unsigned u;
+        } Converter;
+        Converter.f = f;
+        return Converter.u;
+    }
+    _XOINL float Mask(bool b)                           { return HexFloat(b ? 0xffffffff : 0u); }
+
+    _XOINL Float Load(const float* f)                   { return *f; }
+    _XOINL Float LoadUnaligned(const float* f)          { return *f; }
+    _XOINL void Store(float* f, Float v)                { *f = v; }
+    _XOINL void StoreUnaligned(float* f, Float v)       { *f = v; }
+    _XOINL Float Set(float f)                           { return f; }
+    _XOINL Float Zero()                                 { return 0.0f; }
+
+    _XOINL Float Add(Float a, Float b)                  { return a + b; }
+    _XOINL Float Sub(Float a, Float b)                  { return a - b; }
+    _XOINL Float Mul(Float a, Float b)                  { return a * b; }
+    _XOINL Float Div(Float a, Float b)                  { return a / b; }
+    _XOINL Float Min(Float a, Float b)                  { return a < b ? a : b; }
+    _XOINL Float Max(Float a, Float b)                  { return a > b ? a : b; }
+    _XOINL Float Sqrt(Float a)                          { return sqrtf(a); }
+    _XOINL Float RcpEstimate(Float a)                   { return 1.0f / a; }
+    _XOINL Float RsqrtEstimate(Float a)                 { return 1.0f / sqrtf(a); }
+    _XOINL Float Round(Float a)                         { return nearbyintf(a); }
+    _XOINL Float Floor(Float a)                         { return floorf(a); }
+
+    _XOINL Float And(Float a, Float b)                  { return HexFloat(Bits(a) & Bits(b)); }
+    _XOINL Float AndNot(Float a, Float b)               { return HexFloat(~Bits(a) & Bits(b)); } //!< (~a) & b
+    _XOINL Float Or(Float a, Float b)                   { return HexFloat(Bits(a) | Bits(b)); }
+    _XOINL Float Xor(Float a, Float b)                  { return HexFloat(Bits(a) ^ Bits(b)); }
+
+    _XOINL Float CmpEq(Float a, Float b)                { return Mask(a == b); }
+    _XOINL Float CmpNeq(Float a, Float b)               { return Mask(a != b); }
+    _XOINL Float CmpLt(Float a, Float b)                { return Mask(a < b); }
+    _XOINL Float CmpLe(Float a, Float b)                { return Mask(a <= b); }
+    _XOINL Float CmpGt(Float a, Float b)                { return Mask(a > b); }
+    _XOINL Float CmpGe(Float a, Float b)                { return Mask(a >= b); }
+    //! Per lane: mask ? a : b
+    _XOINL Float Select(Float mask, Float a, Float b)   { return Bits(mask) ? a : b; }
+    //! One bit per lane, taken from the lane's sign bit. Lane 0 is the lowest bit.
+    _XOINL int MoveMask(Float mask)                     { return (int)(Bits(mask) >> 31); }
+#endif
+
+    //! a*b+c, fused when the target has FMA.
+    _XOINL Float MulAdd(Float a, Float b, Float c) {
+#if defined(XO_FMA) && defined(XO_AVX)
+        return _mm256_fmadd_ps(a, b, c);
+#elif defined(XO_FMA) && defined(XO_SSE)
+        return _mm_fmadd_ps(a, b, c);
+#else
+        return Add(Mul(a, b), c);
+#endif
+    }
+    //! c-a*b, fused when the target has FMA.
+    _XOINL Float NegMulAdd(Float a, Float b, Float c) {
+#if defined(XO_FMA) && defined(XO_AVX)
+        return _mm256_fnmadd_ps(a, b, c);
+#elif defined(XO_FMA) && defined(XO_SSE)
+        return _mm_fnmadd_ps(a, b, c);
+#else
+        return Sub(c, Mul(a, b));
+#endif
+    }
+
+    _XOINL Float SignBit()                              { return Set(HexFloat(0x80000000)); }
+    _XOINL Float Abs(Float a)                           { return AndNot(SignBit(), a); }
+    _XOINL Float Negate(Float a)                        { return Xor(SignBit(), a); }
+    //! Mask with every bit set in each lane.
+    _XOINL Float True()                                 { return CmpEq(Zero(), Zero()); }
+    //! Bitmask with the lowest count bits set, matching MoveMask of a full mask over count lanes.
+    _XOINL int LaneBits(int count)                      { return (1 << count) - 1; }
+
+    //! Reciprocal refined by one Newton-Raphson step (about 22 bits when compiled for simd).
+    _XOINL Float Rcp(Float a) {
+        Float r = RcpEstimate(a);
+        return Mul(r, NegMulAdd(a, r, Set(2.0f)));
+    }
+    //! Reciprocal square root refined by one Newton-Raphson step (about 22 bits when compiled for simd).
+    _XOINL Float Rsqrt(Float a) {
+        Float r = RsqrtEstimate(a);
+        Float halfA = Mul(a, Set(0.5f));
+        return Mul(r, NegMulAdd(Mul(halfA, r), r, Set(1.5f)));
+    }
+
+    //! Loads the first count (< Width) elements of f, remaining lanes are zero. f needs no alignment.
+    _XOINL Float LoadPartial(const float* f, size_t count) {
+        _XOSIMDALIGN32 float t[Width] = { };
+        for (size_t i = 0; i < count; ++i) {
+            t[i] = f[i];
+        }
+        return Load(t);
+    }
+    //! Stores the first count (< Width) lanes of v to f. f needs no alignment.
+    _XOINL void StorePartial(float* f, Float v, size_t count) {
+        _XOSIMDALIGN32 float t[Width];
+        Store(t, v);
+        for (size_t i = 0; i < count; ++i) {
+            f[i] = t[i];
+        }
+    }
+
+    //! Loads Width records of four floats, each starting stride floats after the last, into four registers so that a 
+    //! holds element 0 of every record, b element 1 and so on. Records must be 16 byte aligned when compiled for SSE.
+    _XOINL void LoadTransposed4(const float* f, size_t stride, Float& a, Float& b, Float& c, Float& d) {
+#if defined(XO_AVX)
+        __m128 l0 = _mm_load_ps(f), l1 = _mm_load_ps(f + stride), l2 = _mm_load_ps(f + stride * 2), l3 = _mm_load_ps(f + stride * 3);
+        __m128 h0 = _mm_load_ps(f + stride * 4), h1 = _mm_load_ps(f + stride * 5), h2 = _mm_load_ps(f + stride * 6), h3 = _mm_load_ps(f + stride * 7);
+        _MM_TRANSPOSE4_PS(l0, l1, l2, l3);
+        _MM_TRANSPOSE4_PS(h0, h1, h2, h3);
+        a = _mm256_insertf128_ps(_mm256_castps128_ps256(l0), h0, 1);
+        b = _mm256_insertf128_ps(_mm256_castps128_ps256(l1), h1, 1);
+        c = _mm256_insertf128_ps(_mm256_castps128_ps256(l2), h2, 1);
+        d = _mm256_insertf128_ps(_mm256_castps128_ps256(l3), h3, 1);
+#elif defined(XO_SSE)
+        a = _mm_load_ps(f);
+        b = _mm_load_ps(f + stride);
+        c = _mm_load_ps(f + stride * 2);
+        d = _mm_load_ps(f + stride * 3);
+        _MM_TRANSPOSE4_PS(a, b, c, d);
+#else
+        (void)stride;
+        a = f[0];
+        b = f[1];
+        c = f[2];
+        d = f[3];
+#endif
+    }
+    //! The reverse of LoadTransposed4.
+    _XOINL void StoreTransposed4(float* f, size_t stride, Float a, Float b, Float c, Float d) {
+#if defined(XO_AVX)
+        __m128 l0 = _mm256_castps256_ps128(a), l1 = _mm256_castps256_ps128(b), l2 = _mm256_castps256_ps128(c), l3 = _mm256_castps256_ps128(d);
+        __m128 h0 = _mm256_extractf128_ps(a, 1), h1 = _mm256_extractf128_ps(b, 1), h2 = _mm256_extractf128_ps(c, 1), h3 = _mm256_extractf128_ps(d, 1);
+        _MM_TRANSPOSE4_PS(l0, l1, l2, l3);
+        _MM_TRANSPOSE4_PS(h0, h1, h2, h3);
+        _mm_store_ps(f, l0); _mm_store_ps(f + stride, l1); _mm_store_ps(f + stride * 2, l2); _mm_store_ps(f + stride * 3, l3);
+        _mm_store_ps(f + stride * 4, h0); _mm_store_ps(f + stride * 5, h1); _mm_store_ps(f + stride * 6, h2); _mm_store_ps(f + stride * 7, h3);
+#elif defined(XO_SSE)
+        _MM_TRANSPOSE4_PS(a, b, c, d);
+        _mm_store_ps(f, a);
+        _mm_store_ps(f + stride, b);
+        _mm_store_ps(f + stride * 2, c);
+        _mm_store_ps(f + stride * 3, d);
+#else
+        (void)stride;
+        f[0] = a;
+        f[1] = b;
+        f[2] = c;
+        f[3] = d;
+#endif
+    }
+
+    //! Width 3d vectors, one register per component, as loaded from the arrays of a Vector3Stream.
+    struct Float3 {
+        Float x, y, z;
+    };
+
+    //! Loads Width vectors from three component arrays, each aligned as with Load.
+    _XOINL Float3 Load(const float* x, const float* y, const float* z) {
+        Float3 v = { Load(x), Load(y), Load(z) };
+        return v;
+    }
+    //! Stores Width vectors to three component arrays, each aligned as with Store.
+    _XOINL void Store(float* x, float* y, float* z, const Float3& v) {
+        Store(x, v.x);
+        Store(y, v.y);
+        Store(z, v.z);
+    }
+    //! The same vector in every lane.
+    _XOINL Float3 Set(float x, float y, float z) {
+        Float3 v = { Set(x), Set(y), Set(z) };
+        return v;
+    }
+    _XOINL Float3 Add(const Float3& a, const Float3& b) {
+        Float3 v = { Add(a.x, b.x), Add(a.y, b.y), Add(a.z, b.z) };
+        return v;
+    }
+    _XOINL Float3 Sub(const Float3& a, const Float3& b) {
+        Float3 v = { Sub(a.x, b.x), Sub(a.y, b.y), Sub(a.z, b.z) };
+        return v;
+    }
+    //! Each vector scaled by the float in its lane.
+    _XOINL Float3 Mul(const Float3& a, Float s) {
+        Float3 v = { Mul(a.x, s), Mul(a.y, s), Mul(a.z, s) };
+        return v;
+    }
+    //! a*s+c, with s one float per lane.
+    _XOINL Float3 MulAdd(const Float3& a, Float s, const Float3& c) {
+        Float3 v = { MulAdd(a.x, s, c.x), MulAdd(a.y, s, c.y), MulAdd(a.z, s, c.z) };
+        return v;
+    }
+    _XOINL Float Dot(const Float3& a, const Float3& b) {
+        return MulAdd(a.x, b.x, MulAdd(a.y, b.y, Mul(a.z, b.z)));
+    }
+    //! Per lane: mask ? a : b
+    _XOINL Float3 Select(Float mask, const Float3& a, const Float3& b) {
+        Float3 v = { Select(mask, a.x, b.x), Select(mask, a.y, b.y), Select(mask, a.z, b.z) };
+        return v;
+    }
+    //! Each lane clamped to [0, 1]. NaN lanes become 0.
+    _XOINL Float Saturate(Float a) {
+        return Min(Max(a, Zero()), Set(1.0f));
+    }
+}
+
+XOMATH_END_XO_NS();
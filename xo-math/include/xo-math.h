@@ -24,19 +24,15 @@
 // TODO:
 //  * Ensure macros are consistently named.
 //  * Support NEON (investigate http://projectne10.github.io/Ne10/ license)
-//  * Add transformation object.
 //  * Move trivial methods to headers, keep only "meaningful" code in *.cpp/*inline.h files
 //  * Use macros to generate variant functions for other classes, like in Vector3.h
 //  * Consider other simpler documentation solution. github pages?
 //  * Consider something like premake or similar for dev project files. Check out https://github.com/bkaradzic/GENie
 //  * Move CI back to travis, include more compiler versions.
 //  * Matrix: finish filling out stubs
-//  * fast sin/cos, sincos, _x2 _x2 _x3
-//  * RNG: https://blogs.unity3d.com/2015/01/07/a-primer-on-repeatable-random-numbers/
 //  * Noise:
 //  * Consider moving all randoms out of types themselves and into a separate file.
 //  * Make a very simple graphics demo using many features of xo-math.
-//  * Add recip methods to vectors (and use inside Matrix -> Quaternion conversion)
 
 #ifndef XO_MATH_H
 #define XO_MATH_H
@@ -72,11 +68,15 @@
 #endif 
 
 #include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 #ifndef XO_NO_OSTREAM
 #   include <ostream>
 #endif
 #include <random>
 #include <thread>
+#include <atomic>
 #include <limits>
 #if defined(__arm__)
 #   if defined(__ARM_NEON__)
@@ -89,7 +89,7 @@
             // so we're assuming under msvc that it's all that's required to determine neon support...
 #           include <arm_neon.h>
 #       else
-#           include <xmmintrin.h>
+#           include <immintrin.h>
 #       endif
 #   else
 #       include <x86intrin.h>
@@ -107,12 +107,16 @@
 #   else
 #       define _XOSIMDALIGN __declspec(align(16))
 #   endif
+    // wide enough for any wide::Float
+#   define _XOSIMDALIGN32 __declspec(align(32))
 #else
 #   if defined(__arm__)
 #       define _XOSIMDALIGN __attribute__((aligned(8)))
 #   else
 #       define _XOSIMDALIGN __attribute__((aligned(16)))
 #   endif
+    // wide enough for any wide::Float
+#   define _XOSIMDALIGN32 __attribute__((aligned(32)))
 #endif
 
 #define XOMATH_INTERNAL 1
@@ -157,20 +161,6 @@
 
 # define _XO_NO_TLS (defined(__clang__) && defined(__APPLE__)) || (defined(_MSC_VER) && _MSC_VER < 1800)
 
-// apple clang doesn't give us thread_local until xcode 8.
-#if _XO_NO_TLS
-#   define _XO_TLS_ENGINE \
-        static _XOTLS std::mt19937* tls_engline; \
-        static _XOTLS char mem[sizeof(std::mt19937)];\
-        if(!tls_engline) { \
-            tls_engline = new(mem) std::mt19937((unsigned)clock()); \
-        }
-#    define _XO_TLS_DISTRIBUTION dist(*tls_engline)
-#else
-#   define _XO_TLS_ENGINE \
-        static _XOTLS std::mt19937 tls_engline((unsigned)clock());
-#    define _XO_TLS_DISTRIBUTION dist(tls_engline)
-#endif
 
 XOMATH_BEGIN_XO_NS();
 
@@ -209,6 +199,20 @@ _XOINL float HexFloat(unsigned u) {
     return Converter.f;
 }
 
+//! Precision policies for reciprocals, inverse square roots and the methods built on them, picked per call site as a 
+//! template argument, such as v.Normalize<Precision::Fast>().
+//!
+//! Exact uses IEEE division and square root, max relative error 1.2e-7 for a reciprocal and 1.8e-7 for an inverse 
+//! square root (which rounds twice). Fast starts from the hardware estimate and refines it with one Newton-Raphson 
+//! step, max relative error 2.8e-7. Approximate uses the hardware estimate as is, max relative error 1.5*2^-12 
+//! (about 3.7e-4). Without SSE there is no estimate to start from and every policy is Exact.
+//! @sa XO_NO_INVERSE_DIVISION, which picks the precision of the division operators for the whole build.
+enum class Precision {
+    Exact,
+    Fast,
+    Approximate
+};
+
 #if defined(XO_SSE)
 namespace sse {
     static const __m128 AbsMask = _mm_set1_ps(HexFloat(0x7fffffff));
@@ -225,6 +229,42 @@ namespace sse {
     static const __m128 One = _mm_set1_ps(1.0f);
     static const __m128 NegativeOne = _mm_set1_ps(-1.0f);
     static const __m128 Epsilon = _mm_set_ps1(SSEFloatEpsilon);
+
+    // a*b+c, fused when the target has FMA.
+    _XOINL __m128 MulAdd(__m128 a, __m128 b, __m128 c) {
+#   if defined(XO_FMA)
+        return _mm_fmadd_ps(a, b, c);
+#   else
+        return _mm_add_ps(_mm_mul_ps(a, b), c);
+#   endif
+    }
+
+    // 1/v per lane, see Precision.
+    template <Precision P>
+    _XOINL __m128 Reciprocal(__m128 v) {
+        if (P == Precision::Exact) {
+            return _mm_div_ps(One, v);
+        }
+        __m128 r = _mm_rcp_ps(v);
+        if (P == Precision::Fast) {
+            r = _mm_sub_ps(_mm_add_ps(r, r), _mm_mul_ps(_mm_mul_ps(v, r), r));
+        }
+        return r;
+    }
+
+    // 1/sqrt(v) per lane, see Precision.
+    template <Precision P>
+    _XOINL __m128 InvSqrt(__m128 v) {
+        if (P == Precision::Exact) {
+            return _mm_div_ps(One, _mm_sqrt_ps(v));
+        }
+        __m128 r = _mm_rsqrt_ps(v);
+        if (P == Precision::Fast) {
+            const __m128 halfV = _mm_mul_ps(v, _mm_set1_ps(0.5f));
+            r = _mm_mul_ps(r, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(halfV, r), r)));
+        }
+        return r;
+    }
 }
 
 // We wont warn about pre-defining XO_16ALIGNED_MALLOC or XO_16ALIGNED_FREE.
@@ -247,12 +287,33 @@ namespace sse {
 #   define _XO_OVERLOAD_NEW_DELETE()
 #endif
 
+// Stream types (such as Vector3Stream) keep their arrays on cache line boundaries so the widest simd loads never split one.
+// As with XO_16ALIGNED_MALLOC, a user provided allocator wins.
+#if !defined(XO_STREAM_ALIGNMENT)
+#   define XO_STREAM_ALIGNMENT 64
+#endif
+#if !defined(XO_ALIGNED_MALLOC)
+#   if defined(XO_SSE)
+#       define XO_ALIGNED_MALLOC(size, alignment) _mm_malloc(size, alignment)
+#   else
+#       define XO_ALIGNED_MALLOC(size, alignment) malloc(size)
+#   endif
+#endif
+#if !defined(XO_ALIGNED_FREE)
+#   if defined(XO_SSE)
+#       define XO_ALIGNED_FREE(ptr) _mm_free(ptr)
+#   else
+#       define XO_ALIGNED_FREE(ptr) free(ptr)
+#   endif
+#endif
+
 #define _XO_MIN(a, b) (a < b ? a : b)
 #define _XO_MAX(a, b) (a > b ? a : b)
 
 // wrap for now, so we have the option to make a faster version later.
 _XOINL float Min(float x, float y)      { return _XO_MIN(x, y); }
 _XOINL float Max(float x, float y)      { return _XO_MAX(x, y); }
+_XOINL float Clamp(float f, float min, float max) { return Min(Max(f, min), max); }
 _XOINL float Abs(float f)               { return f > 0.0f ? f : -f; }
 _XOINL float Sqrt(float f)              { return sqrtf(f); } 
 _XOINL float Cbrt(float f)              { return cbrtf(f); }
@@ -265,79 +326,26 @@ _XOINL float ATan(float f)              { return atanf(f); }
 _XOINL float ATan2(float y, float x)    { return atan2f(y, x); } 
 _XOINL float Difference(float x, float y) { return Abs(x-y); }
 
-_XOINL
-void Sin_x2(const float* f, float* s) {
-    XO_ASSERT(IsAligned16(f) && IsAligned16(s), "xo-math Sin_x2 requires aligned params.");
-    s[0] = Sin(f[0]);
-    s[1] = Sin(f[1]);
-}
-
-_XOINL
-void Sin_x3(const float* f, float* s) {
-    XO_ASSERT(IsAligned16(f) && IsAligned16(s), "xo-math Sin_x3 requires aligned params.");
-    s[0] = Sin(f[0]);
-    s[1] = Sin(f[1]);
-    s[2] = Sin(f[2]);
-}
-
-_XOINL
-void Sin_x4(const float* f, float* s) {
-    XO_ASSERT(IsAligned16(f) && IsAligned16(s), "xo-math Sin_x4 requires aligned params.");
-    s[0] = Sin(f[0]);
-    s[1] = Sin(f[1]);
-    s[2] = Sin(f[2]);
-    s[3] = Sin(f[3]);
-}
-
-_XOINL
-void Cos_x2(const float* f, float* c) {
-    XO_ASSERT(IsAligned16(f) && IsAligned16(c), "xo-math Cos_x2 requires aligned params.");
-    c[0] = Cos(f[0]);
-    c[1] = Cos(f[1]);
-}
-
-_XOINL
-void Cos_x3(const float* f, float* c) {
-    XO_ASSERT(IsAligned16(f) && IsAligned16(c), "xo-math Cos_x3 requires aligned params.");
-    c[0] = Cos(f[0]);
-    c[1] = Cos(f[1]);
-    c[2] = Cos(f[2]);
-}
-
-_XOINL
-void Cos_x4(const float* f, float* c) {
-    XO_ASSERT(IsAligned16(f) && IsAligned16(c), "xo-math Cos_x4 requires aligned params.");
-    c[0] = Cos(f[0]);
-    c[1] = Cos(f[1]);
-    c[2] = Cos(f[2]);
-    c[3] = Cos(f[3]);
-}
-
-_XOINL
-void SinCos(float f, float& s, float& c) { 
-    s = Sin(f);
-    c = Cos(f);
-}
-
-_XOINL
-void SinCos_x2(const float* f, float* s, float* c) {
-    XO_ASSERT(IsAligned16(f) && IsAligned16(s) && IsAligned16(c), "xo-math SinCos_x2 requires aligned params.");
-    Sin_x2(f, s);
-    Cos_x2(f, c);
-}
-
-_XOINL
-void SinCos_x3(const float* f, float* s, float* c) {
-    XO_ASSERT(IsAligned16(f) && IsAligned16(s) && IsAligned16(c), "xo-math SinCos_x3 requires aligned params.");
-    Sin_x3(f, s);
-    Cos_x3(f, c);
+//! 1/f with the precision policy P. Approximate and Fast return NaN rather than infinity for 0.
+template <Precision P = Precision::Exact>
+_XOINL float Reciprocal(float f) {
+#if defined(XO_SSE)
+    if (P != Precision::Exact) {
+        return _mm_cvtss_f32(sse::Reciprocal<P>(_mm_set_ss(f)));
+    }
+#endif
+    return 1.0f / f;
 }
 
-_XOINL
-void SinCos_x4(const float* f, float* s, float* c) {
-    XO_ASSERT(IsAligned16(f) && IsAligned16(s) && IsAligned16(c), "xo-math SinCos_x4 requires aligned params.");
-    Sin_x4(f, s);
-    Cos_x4(f, c);
+//! 1/Sqrt(f) with the precision policy P. Approximate and Fast return NaN rather than infinity for 0.
+template <Precision P = Precision::Exact>
+_XOINL float InvSqrt(float f) {
+#if defined(XO_SSE)
+    if (P != Precision::Exact) {
+        return _mm_cvtss_f32(sse::InvSqrt<P>(_mm_set_ss(f)));
+    }
+#endif
+    return 1.0f / Sqrt(f);
 }
 
 _XOINL
@@ -349,27 +357,6 @@ _XOCONSTEXPR _XOINL float Square(float t)      { return t*t; }
 _XOCONSTEXPR _XOINL double Square(double t)    { return t*t; }
 _XOCONSTEXPR _XOINL int Square(int t)          { return t*t; }
 
-_XOINL 
-bool RandomBool() {
-    _XO_TLS_ENGINE
-    std::uniform_int_distribution<int> dist(0, 1);
-    return _XO_TLS_DISTRIBUTION == 1;
-}
-
-_XOINL 
-int RandomRange(int low, int high) {
-    _XO_TLS_ENGINE
-    std::uniform_int_distribution<int> dist(low, high);
-    return _XO_TLS_DISTRIBUTION;
-}
-
-_XOINL 
-float RandomRange(float low, float high) {
-    _XO_TLS_ENGINE
-    std::uniform_real_distribution<float> dist(low, high);
-    return _XO_TLS_DISTRIBUTION;
-}
-
 XOMATH_END_XO_NS();
 
 #if defined(XO_SSE)
@@ -381,17 +368,52 @@ XOMATH_END_XO_NS();
 #endif
 
 ////////////////////////////////////////////////////////////////////////// Module Includes
+#include "Wide.h"
+#include "Parallel.h"
+#include "Trig.h"
+#include "Random.h"
+
 #include "Vector2.h"
 #include "Vector3.h"
 #include "Vector4.h"
 #include "Matrix4x4.h"
+#include "Matrix3x4.h"
 #include "Quaternion.h"
+#include "Vector3Stream.h"
+#include "AABB.h"
+#include "Frustum.h"
+#include "Ray.h"
+#include "BVH.h"
+#include "BoundingSphere.h"
+#include "Plane.h"
+#include "Segment.h"
+#include "Triangle.h"
+#include "OBB.h"
+#include "SpatialHashGrid.h"
+#include "GJK.h"
+#include "EPA.h"
+#include "Morton.h"
+#include "Transform.h"
+#include "DualQuaternion.h"
+#include "Skinning.h"
+#include "Hierarchy.h"
 
 #include "Vector2Inline.h"
 #include "Vector3Inline.h"
 #include "Vector4Inline.h"
 #include "Matrix4x4Inline.h"
+#include "Matrix3x4Inline.h"
 #include "QuaternionInline.h"
+#include "AABBInline.h"
+#include "FrustumInline.h"
+#include "RayInline.h"
+#include "BoundingSphereInline.h"
+#include "PlaneInline.h"
+#include "GJKInline.h"
+#include "EPAInline.h"
+#include "MortonInline.h"
+#include "TransformInline.h"
+#include "DualQuaternionInline.h"
 
 #include "SSE.h"
 
@@ -410,14 +432,12 @@ XOMATH_END_XO_NS();
 
 #if !defined(XO_EXPORT_ALL)
 #   undef _XOSIMDALIGN
+#   undef _XOSIMDALIGN32
 
 #   undef _XOCONSTEXPR
 #   undef _XOINL
 #   undef _XOTLS
 
-#   undef _XO_TLS_ENGINE
-#   undef _XO_TLS_DISTRIBUTION
-
 #   undef _XO_OVERLOAD_NEW_DELETE
 
 #   undef _XO_MIN
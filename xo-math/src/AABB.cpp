@@ -0,0 +1,154 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+const AABB AABB::Empty(Vector3(std::numeric_limits<float>::infinity()), Vector3(-std::numeric_limits<float>::infinity()));
+
+float AABB::SurfaceArea() const {
+    const Vector3 s = Size();
+    return 2.0f * (s.x * s.y + s.y * s.z + s.z * s.x);
+}
+
+float AABB::Volume() const {
+    const Vector3 s = Size();
+    return s.x * s.y * s.z;
+}
+
+AABB AABB::FromPoints(const Vector3* points, size_t count) {
+    if (count == 0) {
+        return Empty;
+    }
+    AABB box(points[0], points[0]);
+    for (size_t i = 1; i < count; ++i) {
+        box.Expand(points[i]);
+    }
+    return box;
+}
+
+void AABB::ClosestPoints(const Vector3Stream& points, Vector3Stream& outPoints, float* outDistancesSquared) const {
+    using namespace wide;
+    const size_t count = points.Size();
+    outPoints.Resize(count);
+    const Float3 lower = wide::Set(min.x, min.y, min.z), upper = wide::Set(max.x, max.y, max.z);
+    for (size_t i = 0; i < count; i += Width) {
+        const Float3 p = Load(points.X() + i, points.Y() + i, points.Z() + i);
+        Float3 closest;
+        closest.x = wide::Min(wide::Max(p.x, lower.x), upper.x);
+        closest.y = wide::Min(wide::Max(p.y, lower.y), upper.y);
+        closest.z = wide::Min(wide::Max(p.z, lower.z), upper.z);
+        Store(outPoints.X() + i, outPoints.Y() + i, outPoints.Z() + i, closest);
+        if (outDistancesSquared) {
+            const Float3 offset = Sub(p, closest);
+            if (i + Width <= count) {
+                StoreUnaligned(outDistancesSquared + i, Dot(offset, offset));
+            }
+            else {
+                StorePartial(outDistancesSquared + i, Dot(offset, offset), count - i);
+            }
+        }
+    }
+}
+
+namespace
+{
+    // The matrix as Arvo's method uses it: half of each column and its absolute value, so that the new center is 
+    // half * (min + max) + translation and the new extents are |half| * (max - min), with no other scaling per box.
+    struct AABBTransformColumns {
+        AABBTransformColumns(const Matrix4x4& m) {
+#if defined(XO_SSE)
+            __m128 c0 = m[0].xmm, c1 = m[1].xmm, c2 = m[2].xmm, c3 = m[3].xmm;
+            _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+            // Dropping the bottom row keeps the padding of every output corner at zero.
+            const __m128 mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+            const __m128 absMask = _mm_castsi128_ps(_mm_set_epi32(0, 0x7fffffff, 0x7fffffff, 0x7fffffff));
+            const __m128 half = _mm_set1_ps(0.5f);
+            half0 = _mm_mul_ps(c0, half);
+            half1 = _mm_mul_ps(c1, half);
+            half2 = _mm_mul_ps(c2, half);
+            abs0 = _mm_and_ps(half0, absMask);
+            abs1 = _mm_and_ps(half1, absMask);
+            abs2 = _mm_and_ps(half2, absMask);
+            half0 = _mm_and_ps(half0, mask);
+            half1 = _mm_and_ps(half1, mask);
+            half2 = _mm_and_ps(half2, mask);
+            translation = _mm_and_ps(c3, mask);
+#else
+            for (int r = 0; r < 3; ++r) {
+                for (int c = 0; c < 3; ++c) {
+                    half[r][c] = m(r, c) * 0.5f;
+                    abs[r][c] = Abs(half[r][c]);
+                }
+                translation[r] = m(r, 3);
+            }
+#endif
+        }
+
+        _XOINL void Transform(const AABB& box, AABB& outBox) const {
+#if defined(XO_SSE)
+            const __m128 sum = _mm_add_ps(box.min.xmm, box.max.xmm);
+            const __m128 size = _mm_sub_ps(box.max.xmm, box.min.xmm);
+            __m128 center = sse::MulAdd(_mm_shuffle_ps(sum, sum, _MM_SHUFFLE(0, 0, 0, 0)), half0, translation);
+            __m128 extents = _mm_mul_ps(_mm_shuffle_ps(size, size, _MM_SHUFFLE(0, 0, 0, 0)), abs0);
+            center = sse::MulAdd(_mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1)), half1, center);
+            extents = sse::MulAdd(_mm_shuffle_ps(size, size, _MM_SHUFFLE(1, 1, 1, 1)), abs1, extents);
+            center = sse::MulAdd(_mm_shuffle_ps(sum, sum, _MM_SHUFFLE(2, 2, 2, 2)), half2, center);
+            extents = sse::MulAdd(_mm_shuffle_ps(size, size, _MM_SHUFFLE(2, 2, 2, 2)), abs2, extents);
+            outBox.min.xmm = _mm_sub_ps(center, extents);
+            outBox.max.xmm = _mm_add_ps(center, extents);
+#else
+            const float sum[3] = { box.min.x + box.max.x, box.min.y + box.max.y, box.min.z + box.max.z };
+            const float size[3] = { box.max.x - box.min.x, box.max.y - box.min.y, box.max.z - box.min.z };
+            for (int r = 0; r < 3; ++r) {
+                const float center = translation[r] + half[r][0] * sum[0] + half[r][1] * sum[1] + half[r][2] * sum[2];
+                const float extents = abs[r][0] * size[0] + abs[r][1] * size[1] + abs[r][2] * size[2];
+                outBox.min[r] = center - extents;
+                outBox.max[r] = center + extents;
+            }
+#endif
+        }
+
+#if defined(XO_SSE)
+        __m128 half0, half1, half2, abs0, abs1, abs2, translation;
+#else
+        float half[3][3];
+        float abs[3][3];
+        float translation[3];
+#endif
+    };
+}
+
+void AABB::Transform(const AABB& box, const Matrix4x4& m, AABB& outBox) {
+    AABBTransformColumns(m).Transform(box, outBox);
+}
+
+void AABB::TransformArray(const Matrix4x4& m, const AABB* boxes, AABB* outBoxes, size_t count) {
+    const AABBTransformColumns columns(m);
+    for (size_t i = 0; i < count; ++i) {
+        columns.Transform(boxes[i], outBoxes[i]);
+    }
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
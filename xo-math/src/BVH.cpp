@@ -0,0 +1,839 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+namespace
+{
+    const int BVHBinCount = 16;
+    // Ranges with at least this many primitives are binned by all of their subtree's threads.
+    const size_t BVHParallelBinning = 1 << 16;
+    // Nodes with at least this many primitives build their children on separate threads.
+    const size_t BVHParallelSubtree = 1 << 12;
+    // Deeper ranges are split in half by count instead of by SAH. This bounds the depth of the tree, and so the size 
+    // of the traversal stacks, even for primitives the heuristic can't separate.
+    const int BVHMaxSahDepth = 48;
+    const int BVHStackSize = 256;
+
+    // Primitives are binned by the centers of their boxes, kept doubled (min + max) to save the multiply. The build's 
+    // inner loops keep centroids in raw lanes rather than in a Vector3, whose constructors aren't inline.
+#if defined(XO_SSE)
+    typedef __m128 BVHPoint;
+
+    _XOINL BVHPoint BVHCentroid(const AABB& box) {
+        return _mm_add_ps(box.min.xmm, box.max.xmm);
+    }
+    _XOINL void BVHExpand(AABB& box, BVHPoint p) {
+        box.min.xmm = _mm_min_ps(box.min.xmm, p);
+        box.max.xmm = _mm_max_ps(box.max.xmm, p);
+    }
+    // (p - offset) * scale, no greater than last, truncated to int on each axis.
+    _XOINL void BVHBinIndices(BVHPoint p, const Vector3& offset, const Vector3& scale, const Vector3& last, int* outBins) {
+        _mm_storeu_si128((__m128i*)outBins, _mm_cvttps_epi32(_mm_min_ps(_mm_mul_ps(_mm_sub_ps(p, offset.xmm), scale.xmm), last.xmm)));
+    }
+#else
+    struct BVHPoint {
+        float f[3];
+    };
+
+    _XOINL BVHPoint BVHCentroid(const AABB& box) {
+        BVHPoint p = { { box.min.x + box.max.x, box.min.y + box.max.y, box.min.z + box.max.z } };
+        return p;
+    }
+    _XOINL void BVHExpand(AABB& box, BVHPoint p) {
+        for (int axis = 0; axis < 3; ++axis) {
+            box.min[axis] = Min(box.min[axis], p.f[axis]);
+            box.max[axis] = Max(box.max[axis], p.f[axis]);
+        }
+    }
+    _XOINL void BVHBinIndices(BVHPoint p, const Vector3& offset, const Vector3& scale, const Vector3& last, int* outBins) {
+        for (int axis = 0; axis < 3; ++axis) {
+            outBins[axis] = (int)Min((p.f[axis] - offset[axis]) * scale[axis], last[axis]);
+        }
+    }
+#endif
+
+    struct BVHBin {
+        void Clear() {
+            bounds = AABB::Empty;
+            count = 0;
+        }
+        void Add(const BVHBin& bin) {
+            bounds.Expand(bin.bounds);
+            count += bin.count;
+        }
+
+        AABB bounds;
+        size_t count;
+    };
+
+    // The primitives from begin to end, with the box around them and the box around their centroids.
+    struct BVHRange {
+        size_t Count() const { return end - begin; }
+
+        AABB bounds;
+        AABB centroids;
+        size_t begin;
+        size_t end;
+    };
+
+    void BVHRangeBounds(const AABB* boxes, BVHRange& range) {
+        range.bounds = range.centroids = AABB::Empty;
+        for (size_t i = range.begin; i < range.end; ++i) {
+            range.bounds.Expand(boxes[i]);
+            BVHExpand(range.centroids, BVHCentroid(boxes[i]));
+        }
+    }
+
+    // Maps centroids to bins along each axis. Small ranges use fewer bins, as binning costs them more than their 
+    // primitives do.
+    struct BVHBinMapping {
+        BVHBinMapping(const AABB& centroids, size_t count) : binCount((int)_XO_MIN(count, (size_t)BVHBinCount)) {
+            const Vector3 extent = centroids.max - centroids.min;
+            offset = centroids.min;
+            // just under binCount, so the largest centroid still lands in the last bin.
+            for (int axis = 0; axis < 3; ++axis) {
+                scale[axis] = extent[axis] > 0.0f ? binCount * 0.99999f / extent[axis] : 0.0f;
+            }
+            lastBin = Vector3((float)(binCount - 1));
+        }
+
+        // The bin of centroid along each axis. outBins holds four ints.
+        _XOINL void Bins(BVHPoint centroid, int* outBins) const {
+            BVHBinIndices(centroid, offset, scale, lastBin, outBins);
+        }
+
+        Vector3 offset;
+        Vector3 scale;
+        Vector3 lastBin;
+        int binCount;
+    };
+
+    struct BVHBuilder {
+        BVHBuilder(BVH::Node* nodes, uint32_t* indices, AABB* boxes, int leafSize) :
+            nodes(nodes), indices(indices), boxes(boxes), leafSize((size_t)leafSize), nodeCount(1) {
+        }
+
+        void BinRange(const BVHBinMapping& mapping, size_t begin, size_t end, BVHBin (&bins)[3][BVHBinCount]) const {
+            for (int axis = 0; axis < 3; ++axis) {
+                for (int b = 0; b < mapping.binCount; ++b) {
+                    bins[axis][b].Clear();
+                }
+            }
+            for (size_t i = begin; i < end; ++i) {
+                const AABB& box = boxes[i];
+                int b[4];
+                mapping.Bins(BVHCentroid(box), b);
+                BVHBin& x = bins[0][b[0]];
+                BVHBin& y = bins[1][b[1]];
+                BVHBin& z = bins[2][b[2]];
+                x.bounds.Expand(box);
+                y.bounds.Expand(box);
+                z.bounds.Expand(box);
+                ++x.count;
+                ++y.count;
+                ++z.count;
+            }
+        }
+
+        void Bin(const BVHBinMapping& mapping, const BVHRange& range, unsigned threads, BVHBin (&bins)[3][BVHBinCount]) const {
+            if (threads < 2 || range.Count() < BVHParallelBinning) {
+                BinRange(mapping, range.begin, range.end, bins);
+                return;
+            }
+            // each thread bins its own share of the range, and the bins are summed after.
+            typedef BVHBin Bins[3][BVHBinCount];
+            Bins* threadBins = (Bins*)XO_ALIGNED_MALLOC(sizeof(Bins) * threads, 64);
+            const size_t share = (range.Count() + threads - 1) / threads;
+            xo_internal::Parallel(threads, [&](unsigned t) {
+                const size_t begin = _XO_MIN(range.begin + share * t, range.end);
+                BinRange(mapping, begin, _XO_MIN(begin + share, range.end), threadBins[t]);
+            });
+            for (int axis = 0; axis < 3; ++axis) {
+                for (int b = 0; b < mapping.binCount; ++b) {
+                    bins[axis][b] = threadBins[0][axis][b];
+                    for (unsigned t = 1; t < threads; ++t) {
+                        bins[axis][b].Add(threadBins[t][axis][b]);
+                    }
+                }
+            }
+            XO_ALIGNED_FREE(threadBins);
+        }
+
+        void Swap(size_t a, size_t b) const {
+            AABB box;
+            box = boxes[a];
+            boxes[a] = boxes[b];
+            boxes[b] = box;
+            const uint32_t index = indices[a];
+            indices[a] = indices[b];
+            indices[b] = index;
+        }
+
+        // Splits range, which holds at least two primitives, in two.
+        void Split(const BVHRange& range, int depth, unsigned threads, BVHRange& outLeft, BVHRange& outRight) const {
+            const BVHBinMapping mapping(range.centroids, range.Count());
+            const int binCount = mapping.binCount;
+            int bestAxis = -1, bestBin = 0;
+            if (depth <= BVHMaxSahDepth && (mapping.scale.x > 0.0f || mapping.scale.y > 0.0f || mapping.scale.z > 0.0f)) {
+                BVHBin bins[3][BVHBinCount];
+                Bin(mapping, range, threads, bins);
+                // The cost of a split is the surface area of each side times the primitives in it. A sweep from the 
+                // right gives the cost of every split's right side, and a sweep from the left adds its left side.
+                float bestCost = std::numeric_limits<float>::infinity();
+                for (int axis = 0; axis < 3; ++axis) {
+                    if (mapping.scale[axis] == 0.0f) {
+                        continue;
+                    }
+                    float rightCost[BVHBinCount];
+                    BVHBin side;
+                    side.Clear();
+                    for (int b = binCount - 1; b > 0; --b) {
+                        side.Add(bins[axis][b]);
+                        rightCost[b] = side.count ? side.bounds.SurfaceArea() * side.count : -1.0f;
+                    }
+                    side.Clear();
+                    for (int b = 0; b < binCount - 1; ++b) {
+                        side.Add(bins[axis][b]);
+                        if (side.count == 0 || rightCost[b + 1] < 0.0f) {
+                            continue;
+                        }
+                        const float cost = side.bounds.SurfaceArea() * side.count + rightCost[b + 1];
+                        if (cost < bestCost) {
+                            bestCost = cost;
+                            bestAxis = axis;
+                            bestBin = b;
+                        }
+                    }
+                }
+            }
+
+            outLeft.begin = range.begin;
+            outRight.end = range.end;
+            if (bestAxis >= 0) {
+                // The centroid bounds of each side are gathered while partitioning, so the bins don't need to keep them.
+                AABB left = AABB::Empty, right = AABB::Empty, leftCentroids = AABB::Empty, rightCentroids = AABB::Empty;
+                size_t i = range.begin, j = range.end;
+                while (i < j) {
+                    const BVHPoint centroid = BVHCentroid(boxes[i]);
+                    int b[4];
+                    mapping.Bins(centroid, b);
+                    if (b[bestAxis] <= bestBin) {
+                        left.Expand(boxes[i]);
+                        BVHExpand(leftCentroids, centroid);
+                        ++i;
+                    }
+                    else {
+                        right.Expand(boxes[i]);
+                        BVHExpand(rightCentroids, centroid);
+                        Swap(i, --j);
+                    }
+                }
+                outLeft.end = outRight.begin = i;
+                outLeft.bounds = left;
+                outLeft.centroids = leftCentroids;
+                outRight.bounds = right;
+                outRight.centroids = rightCentroids;
+            }
+            else {
+                // too deep, or every centroid is in the same place.
+                outLeft.end = outRight.begin = range.begin + range.Count() / 2;
+                BVHRangeBounds(boxes, outLeft);
+                BVHRangeBounds(boxes, outRight);
+            }
+        }
+
+        void BuildNode(uint32_t nodeIndex, const BVHRange& range, int depth, unsigned threads) {
+            // Splits the range with the largest surface area until there are four, or every range fits in a leaf. 
+            // Each split replaces a range with its two halves in place, keeping the ranges in index order.
+            BVHRange ranges[4];
+            ranges[0] = range;
+            int rangeCount = 1;
+            while (rangeCount < 4) {
+                int largest = -1;
+                float largestArea = -1.0f;
+                for (int r = 0; r < rangeCount; ++r) {
+                    const float area = ranges[r].bounds.SurfaceArea();
+                    if (ranges[r].Count() > leafSize && area > largestArea) {
+                        largest = r;
+                        largestArea = area;
+                    }
+                }
+                if (largest < 0) {
+                    break;
+                }
+                BVHRange left, right;
+                Split(ranges[largest], depth, threads, left, right);
+                for (int r = rangeCount; r > largest + 1; --r) {
+                    ranges[r] = ranges[r - 1];
+                }
+                ranges[largest] = left;
+                ranges[largest + 1] = right;
+                ++rangeCount;
+            }
+
+            BVH::Node& node = nodes[nodeIndex];
+            uint32_t children[4];
+            BVHRange childRanges[4];
+            unsigned childCount = 0;
+            for (int slot = 0; slot < 4; ++slot) {
+                if (slot < rangeCount) {
+                    const BVHRange& r = ranges[slot];
+                    node.minX[slot] = r.bounds.min.x;
+                    node.minY[slot] = r.bounds.min.y;
+                    node.minZ[slot] = r.bounds.min.z;
+                    node.maxX[slot] = r.bounds.max.x;
+                    node.maxY[slot] = r.bounds.max.y;
+                    node.maxZ[slot] = r.bounds.max.z;
+                    node.count[slot] = (uint32_t)r.Count();
+                    if (r.Count() <= leafSize) {
+                        node.child[slot] = BVH::LeafBit | (uint32_t)r.begin;
+                    }
+                    else {
+                        node.child[slot] = nodeCount++;
+                        children[childCount] = node.child[slot];
+                        childRanges[childCount++] = r;
+                    }
+                }
+                else {
+                    node.minX[slot] = node.minY[slot] = node.minZ[slot] = std::numeric_limits<float>::infinity();
+                    node.maxX[slot] = node.maxY[slot] = node.maxZ[slot] = -std::numeric_limits<float>::infinity();
+                    node.child[slot] = 0;
+                    node.count[slot] = 0;
+                }
+            }
+
+            if (threads > 1 && childCount > 1 && range.Count() >= BVHParallelSubtree) {
+                const unsigned share = _XO_MAX(threads / childCount, 1u);
+                xo_internal::Parallel(childCount, [&](unsigned c) {
+                    BuildNode(children[c], childRanges[c], depth + 1, share);
+                });
+            }
+            else {
+                for (unsigned c = 0; c < childCount; ++c) {
+                    BuildNode(children[c], childRanges[c], depth + 1, threads);
+                }
+            }
+        }
+
+        BVH::Node* nodes;
+        uint32_t* indices;
+        AABB* boxes;
+        size_t leafSize;
+        std::atomic<uint32_t> nodeCount;
+    };
+
+    void BVHSetSlot(BVH::Node& node, int slot, const AABB& box) {
+        node.minX[slot] = box.min.x;
+        node.minY[slot] = box.min.y;
+        node.minZ[slot] = box.min.z;
+        node.maxX[slot] = box.max.x;
+        node.maxY[slot] = box.max.y;
+        node.maxZ[slot] = box.max.z;
+    }
+
+    // The box around every slot of node. Empty slots hold an empty box, so they don't need to be skipped.
+    AABB BVHNodeBounds(const BVH::Node& node) {
+        AABB box;
+#if defined(XO_SSE)
+        __m128 minX = _mm_load_ps(node.minX), minY = _mm_load_ps(node.minY), minZ = _mm_load_ps(node.minZ);
+        __m128 maxX = _mm_load_ps(node.maxX), maxY = _mm_load_ps(node.maxY), maxZ = _mm_load_ps(node.maxZ);
+        __m128 w = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(minX, minY, minZ, w);
+        box.min.xmm = _mm_min_ps(_mm_min_ps(minX, minY), _mm_min_ps(minZ, w));
+        w = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(maxX, maxY, maxZ, w);
+        box.max.xmm = _mm_max_ps(_mm_max_ps(maxX, maxY), _mm_max_ps(maxZ, w));
+#else
+        box = AABB::Empty;
+        for (int slot = 0; slot < 4; ++slot) {
+            box.Expand(AABB(Vector3(node.minX[slot], node.minY[slot], node.minZ[slot]), Vector3(node.maxX[slot], node.maxY[slot], node.maxZ[slot])));
+        }
+#endif
+        return box;
+    }
+
+    // Children are allocated after their parents, so walking the nodes backward reaches every child before its parent.
+    template <class PrimitiveBounds>
+    void BVHRefit(BVH::Node* nodes, size_t nodeCount, const uint32_t* indices, const PrimitiveBounds& primitiveBounds) {
+        for (size_t n = nodeCount; n-- > 0; ) {
+            BVH::Node& node = nodes[n];
+            for (int slot = 0; slot < 4; ++slot) {
+                if (node.count[slot] == 0) {
+                    continue;
+                }
+                if (node.child[slot] & BVH::LeafBit) {
+                    const uint32_t first = node.child[slot] & ~BVH::LeafBit;
+                    AABB box = primitiveBounds(indices[first]);
+                    for (uint32_t i = 1; i < node.count[slot]; ++i) {
+                        box.Expand(primitiveBounds(indices[first + i]));
+                    }
+                    BVHSetSlot(node, slot, box);
+                }
+                else {
+                    BVHSetSlot(node, slot, BVHNodeBounds(nodes[node.child[slot]]));
+                }
+            }
+        }
+    }
+
+    _XOINL AABB BVHTriangleBounds(const Vector3* vertices, uint32_t triangle) {
+        const Vector3* v = vertices + triangle * 3;
+        return AABB(Vector3::Min(Vector3::Min(v[0], v[1]), v[2]), Vector3::Max(Vector3::Max(v[0], v[1]), v[2]));
+    }
+
+    _XOINL size_t BVHEmit(const uint32_t* indices, uint32_t first, uint32_t count, uint32_t* outIndices, size_t written) {
+        memcpy(outIndices + written, indices + first, count * sizeof(uint32_t));
+        return written + count;
+    }
+
+    // The ray with what the slab test needs of it in every lane.
+    struct BVHRay {
+        BVHRay(const Ray& ray) {
+#if defined(XO_SSE)
+            ox = _mm_set1_ps(ray.origin.x);
+            oy = _mm_set1_ps(ray.origin.y);
+            oz = _mm_set1_ps(ray.origin.z);
+            ix = _mm_set1_ps(1.0f / ray.direction.x);
+            iy = _mm_set1_ps(1.0f / ray.direction.y);
+            iz = _mm_set1_ps(1.0f / ray.direction.z);
+#else
+            o = ray.origin;
+            inverse = Vector3(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+#endif
+        }
+
+        // Slab tests the ray against the four slots of node, returning a bit for each slot hit between 0 and maxT and 
+        // the distance the ray enters each slot at.
+        _XOINL int Test(const BVH::Node& node, float maxT, float* outEnter) const {
+#if defined(XO_SSE)
+            const __m128 x0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minX), ox), ix), x1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxX), ox), ix);
+            const __m128 y0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minY), oy), iy), y1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxY), oy), iy);
+            const __m128 z0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minZ), oz), iz), z1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxZ), oz), iz);
+            const __m128 enter = _mm_max_ps(_mm_max_ps(_mm_min_ps(x0, x1), _mm_min_ps(y0, y1)), _mm_max_ps(_mm_min_ps(z0, z1), _mm_setzero_ps()));
+            const __m128 exit = _mm_min_ps(_mm_min_ps(_mm_max_ps(x0, x1), _mm_max_ps(y0, y1)), _mm_min_ps(_mm_max_ps(z0, z1), _mm_set1_ps(maxT)));
+            // empty slots are inside out boxes, which the swapping min and max above would take as infinite.
+            const __m128 used = _mm_castsi128_ps(_mm_cmpgt_epi32(_mm_load_si128((const __m128i*)node.count), _mm_setzero_si128()));
+            _mm_storeu_ps(outEnter, enter);
+            return _mm_movemask_ps(_mm_and_ps(_mm_cmple_ps(enter, exit), used));
+#else
+            int bits = 0;
+            for (int slot = 0; slot < 4; ++slot) {
+                const float x0 = (node.minX[slot] - o.x) * inverse.x, x1 = (node.maxX[slot] - o.x) * inverse.x;
+                const float y0 = (node.minY[slot] - o.y) * inverse.y, y1 = (node.maxY[slot] - o.y) * inverse.y;
+                const float z0 = (node.minZ[slot] - o.z) * inverse.z, z1 = (node.maxZ[slot] - o.z) * inverse.z;
+                const float enter = Max(Max(Min(x0, x1), Min(y0, y1)), Max(Min(z0, z1), 0.0f));
+                const float exit = Min(Min(Max(x0, x1), Max(y0, y1)), Min(Max(z0, z1), maxT));
+                outEnter[slot] = enter;
+                bits |= (node.count[slot] && enter <= exit) << slot;
+            }
+            return bits;
+#endif
+        }
+
+#if defined(XO_SSE)
+        __m128 ox, oy, oz, ix, iy, iz;
+#else
+        Vector3 o, inverse;
+#endif
+    };
+
+    // A bit for each slot of node that overlaps box.
+    _XOINL int BVHOverlaps(const BVH::Node& node, const AABB& box) {
+#if defined(XO_SSE)
+        __m128 overlap = _mm_and_ps(_mm_cmple_ps(_mm_load_ps(node.minX), _mm_set1_ps(box.max.x)), _mm_cmpge_ps(_mm_load_ps(node.maxX), _mm_set1_ps(box.min.x)));
+        overlap = _mm_and_ps(overlap, _mm_and_ps(_mm_cmple_ps(_mm_load_ps(node.minY), _mm_set1_ps(box.max.y)), _mm_cmpge_ps(_mm_load_ps(node.maxY), _mm_set1_ps(box.min.y))));
+        overlap = _mm_and_ps(overlap, _mm_and_ps(_mm_cmple_ps(_mm_load_ps(node.minZ), _mm_set1_ps(box.max.z)), _mm_cmpge_ps(_mm_load_ps(node.maxZ), _mm_set1_ps(box.min.z))));
+        return _mm_movemask_ps(overlap);
+#else
+        int bits = 0;
+        for (int slot = 0; slot < 4; ++slot) {
+            bits |= (node.minX[slot] <= box.max.x && node.maxX[slot] >= box.min.x &&
+                     node.minY[slot] <= box.max.y && node.maxY[slot] >= box.min.y &&
+                     node.minZ[slot] <= box.max.z && node.maxZ[slot] >= box.min.z) << slot;
+        }
+        return bits;
+#endif
+    }
+
+    // Tests the four slots of a node against the planes of a frustum, the same test as Frustum::IntersectsAABB.
+    struct BVHFrustum {
+        BVHFrustum(const Frustum& frustum) {
+            for (int i = 0; i < Frustum::PlaneCount; ++i) {
+                const Vector4& p = frustum.planes[i];
+                for (int slot = 0; slot < 4; ++slot) {
+                    halfX[i][slot] = p.x * 0.5f;
+                    halfY[i][slot] = p.y * 0.5f;
+                    halfZ[i][slot] = p.z * 0.5f;
+                    absHalfX[i][slot] = Abs(p.x) * 0.5f;
+                    absHalfY[i][slot] = Abs(p.y) * 0.5f;
+                    absHalfZ[i][slot] = Abs(p.z) * 0.5f;
+                    w[i][slot] = p.w;
+                }
+            }
+        }
+
+        // Returns a bit for each slot not outside any plane of planeMask, and for those slots outPlaneMasks holds the 
+        // planes they still cross.
+        _XOINL int Test(const BVH::Node& node, uint32_t planeMask, uint32_t* outPlaneMasks) const {
+            for (int slot = 0; slot < 4; ++slot) {
+                outPlaneMasks[slot] = planeMask;
+            }
+#if defined(XO_SSE)
+            const __m128 minX = _mm_load_ps(node.minX), minY = _mm_load_ps(node.minY), minZ = _mm_load_ps(node.minZ);
+            const __m128 maxX = _mm_load_ps(node.maxX), maxY = _mm_load_ps(node.maxY), maxZ = _mm_load_ps(node.maxZ);
+            const __m128 sumX = _mm_add_ps(minX, maxX), sumY = _mm_add_ps(minY, maxY), sumZ = _mm_add_ps(minZ, maxZ);
+            const __m128 sizeX = _mm_sub_ps(maxX, minX), sizeY = _mm_sub_ps(maxY, minY), sizeZ = _mm_sub_ps(maxZ, minZ);
+            __m128 visible = _mm_castsi128_ps(_mm_cmpgt_epi32(_mm_load_si128((const __m128i*)node.count), _mm_setzero_si128()));
+            for (int i = 0; i < Frustum::PlaneCount; ++i) {
+                if (!(planeMask & (1 << i))) {
+                    continue;
+                }
+                const __m128 distance = sse::MulAdd(_mm_load_ps(halfX[i]), sumX, sse::MulAdd(_mm_load_ps(halfY[i]), sumY, sse::MulAdd(_mm_load_ps(halfZ[i]), sumZ, _mm_load_ps(w[i]))));
+                const __m128 reach = sse::MulAdd(_mm_load_ps(absHalfX[i]), sizeX, sse::MulAdd(_mm_load_ps(absHalfY[i]), sizeY, _mm_mul_ps(_mm_load_ps(absHalfZ[i]), sizeZ)));
+                visible = _mm_and_ps(visible, _mm_cmpge_ps(distance, _mm_sub_ps(_mm_setzero_ps(), reach)));
+                const int inside = _mm_movemask_ps(_mm_cmpge_ps(distance, reach));
+                for (int slot = 0; slot < 4; ++slot) {
+                    outPlaneMasks[slot] &= ~(((inside >> slot) & 1u) << i);
+                }
+            }
+            return _mm_movemask_ps(visible);
+#else
+            int bits = 0;
+            for (int slot = 0; slot < 4; ++slot) {
+                if (!node.count[slot]) {
+                    continue;
+                }
+                const AABB box(Vector3(node.minX[slot], node.minY[slot], node.minZ[slot]), Vector3(node.maxX[slot], node.maxY[slot], node.maxZ[slot]));
+                const Vector3 sum = box.min + box.max, size = box.max - box.min;
+                bool visible = true;
+                for (int i = 0; i < Frustum::PlaneCount && visible; ++i) {
+                    if (!(planeMask & (1 << i))) {
+                        continue;
+                    }
+                    const float distance = halfX[i][slot] * sum.x + halfY[i][slot] * sum.y + halfZ[i][slot] * sum.z + w[i][slot];
+                    const float reach = absHalfX[i][slot] * size.x + absHalfY[i][slot] * size.y + absHalfZ[i][slot] * size.z;
+                    visible = distance >= -reach;
+                    if (distance >= reach) {
+                        outPlaneMasks[slot] &= ~(1u << i);
+                    }
+                }
+                bits |= visible << slot;
+            }
+            return bits;
+#endif
+        }
+
+        _XOSIMDALIGN float halfX[Frustum::PlaneCount][4];
+        _XOSIMDALIGN float halfY[Frustum::PlaneCount][4];
+        _XOSIMDALIGN float halfZ[Frustum::PlaneCount][4];
+        _XOSIMDALIGN float absHalfX[Frustum::PlaneCount][4];
+        _XOSIMDALIGN float absHalfY[Frustum::PlaneCount][4];
+        _XOSIMDALIGN float absHalfZ[Frustum::PlaneCount][4];
+        _XOSIMDALIGN float w[Frustum::PlaneCount][4];
+    };
+
+    struct BVHRayEntry {
+        uint32_t child;
+        uint32_t count;
+        float enter;
+    };
+}
+
+BVH::BVH() : nodes(nullptr), indices(nullptr), nodeCount(0), primitiveCount(0) {
+}
+
+BVH::BVH(const BVH& bvh) : nodes(nullptr), indices(nullptr), nodeCount(0), primitiveCount(0) {
+    *this = bvh;
+}
+
+BVH::BVH(BVH&& bvh) : nodes(bvh.nodes), indices(bvh.indices), nodeCount(bvh.nodeCount), primitiveCount(bvh.primitiveCount) {
+    bvh.nodes = nullptr;
+    bvh.indices = nullptr;
+    bvh.nodeCount = bvh.primitiveCount = 0;
+}
+
+BVH::~BVH() {
+    Release();
+}
+
+void BVH::Allocate(size_t nodes, size_t primitives) {
+    this->nodes = (Node*)XO_ALIGNED_MALLOC(nodes * sizeof(Node), 64);
+    indices = (uint32_t*)XO_ALIGNED_MALLOC(primitives * sizeof(uint32_t), 64);
+    nodeCount = nodes;
+    primitiveCount = primitives;
+}
+
+void BVH::Release() {
+    if (nodes) {
+        XO_ALIGNED_FREE(nodes);
+    }
+    if (indices) {
+        XO_ALIGNED_FREE(indices);
+    }
+    nodes = nullptr;
+    indices = nullptr;
+    nodeCount = primitiveCount = 0;
+}
+
+BVH& BVH::operator = (const BVH& bvh) {
+    if (this != &bvh) {
+        Release();
+        if (bvh.nodeCount) {
+            Allocate(bvh.nodeCount, bvh.primitiveCount);
+            memcpy(nodes, bvh.nodes, nodeCount * sizeof(Node));
+            memcpy(indices, bvh.indices, primitiveCount * sizeof(uint32_t));
+        }
+    }
+    return *this;
+}
+
+BVH& BVH::operator = (BVH&& bvh) {
+    if (this != &bvh) {
+        Release();
+        nodes = bvh.nodes;
+        indices = bvh.indices;
+        nodeCount = bvh.nodeCount;
+        primitiveCount = bvh.primitiveCount;
+        bvh.nodes = nullptr;
+        bvh.indices = nullptr;
+        bvh.nodeCount = bvh.primitiveCount = 0;
+    }
+    return *this;
+}
+
+void BVH::Clear() {
+    Release();
+}
+
+void BVH::Build(const AABB* bounds, size_t count, int leafSize, unsigned threadCount) {
+    XO_ASSERT(count < LeafBit, "xo-math BVH::Build has too many primitives.");
+    Release();
+    if (!count) {
+        return;
+    }
+    const unsigned threads = xo_internal::ThreadCount(threadCount, count, 0);
+    leafSize = _XO_MIN(_XO_MAX(leafSize, 1), MaxLeafSize);
+
+    // Every node but a lone root has at least two slots, so there are fewer nodes than primitives. The nodes are 
+    // built into an array that size and copied to one that fits once their number is known.
+    Allocate(count, count);
+    AABB* boxes = (AABB*)XO_ALIGNED_MALLOC(count * sizeof(AABB), 64);
+
+    // The builder sorts a copy of the bounds along with the indices, so every pass over a range reads memory in order.
+    const unsigned rootThreads = count >= BVHParallelBinning ? threads : 1;
+    BVHRange shares[xo_internal::MaxThreads];
+    const size_t share = (count + rootThreads - 1) / rootThreads;
+    xo_internal::Parallel(rootThreads, [&](unsigned t) {
+        BVHRange& range = shares[t];
+        range.begin = _XO_MIN(share * t, count);
+        range.end = _XO_MIN(range.begin + share, count);
+        for (size_t i = range.begin; i < range.end; ++i) {
+            boxes[i] = bounds[i];
+            indices[i] = (uint32_t)i;
+        }
+        BVHRangeBounds(boxes, range);
+    });
+    BVHRange root = shares[0];
+    root.end = count;
+    for (unsigned t = 1; t < rootThreads; ++t) {
+        root.bounds.Expand(shares[t].bounds);
+        root.centroids.Expand(shares[t].centroids);
+    }
+
+    BVHBuilder builder(nodes, indices, boxes, leafSize);
+    builder.BuildNode(0, root, 0, threads);
+    XO_ALIGNED_FREE(boxes);
+
+    Node* built = nodes;
+    nodes = (Node*)XO_ALIGNED_MALLOC(builder.nodeCount * sizeof(Node), 64);
+    nodeCount = builder.nodeCount;
+    memcpy(nodes, built, nodeCount * sizeof(Node));
+    XO_ALIGNED_FREE(built);
+}
+
+void BVH::BuildTriangles(const Vector3* vertices, size_t count, int leafSize, unsigned threadCount) {
+    AABB* bounds = (AABB*)XO_ALIGNED_MALLOC(_XO_MAX(count, (size_t)1) * sizeof(AABB), 64);
+    for (size_t i = 0; i < count; ++i) {
+        bounds[i] = BVHTriangleBounds(vertices, (uint32_t)i);
+    }
+    Build(bounds, count, leafSize, threadCount);
+    XO_ALIGNED_FREE(bounds);
+}
+
+void BVH::Refit(const AABB* bounds) {
+    BVHRefit(nodes, nodeCount, indices, [bounds](uint32_t i) { return bounds[i]; });
+}
+
+void BVH::RefitTriangles(const Vector3* vertices) {
+    BVHRefit(nodes, nodeCount, indices, [vertices](uint32_t i) { return BVHTriangleBounds(vertices, i); });
+}
+
+AABB BVH::Bounds() const {
+    return nodeCount ? BVHNodeBounds(nodes[0]) : AABB::Empty;
+}
+
+bool BVH::IntersectTriangles(const Ray& ray, const Vector3* vertices, float& inOutT, float& outU, float& outV, uint32_t& outIndex) const {
+    if (!nodeCount) {
+        return false;
+    }
+    const BVHRay wideRay(ray);
+    BVHRayEntry stack[BVHStackSize];
+    int top = 0;
+    stack[top++] = { 0, 1, 0.0f };
+    bool found = false;
+    while (top) {
+        const BVHRayEntry entry = stack[--top];
+        // a triangle can't be closer than where the ray enters its box.
+        if (entry.enter >= inOutT) {
+            continue;
+        }
+        if (entry.child & LeafBit) {
+            const uint32_t first = entry.child & ~LeafBit;
+            for (uint32_t i = first; i < first + entry.count; ++i) {
+                const Vector3* v = vertices + indices[i] * 3;
+                if (ray.IntersectTriangle(v[0], v[1], v[2], inOutT, outU, outV)) {
+                    outIndex = indices[i];
+                    found = true;
+                }
+            }
+            continue;
+        }
+        const Node& node = nodes[entry.child];
+        float enter[4];
+        int bits = wideRay.Test(node, inOutT, enter);
+        // Pushes the slots hit farthest first, so the nearest is visited next.
+        BVHRayEntry hits[4];
+        int hitCount = 0;
+        for (; bits; bits &= bits - 1) {
+            const int slot = bits & 1 ? 0 : bits & 2 ? 1 : bits & 4 ? 2 : 3;
+            BVHRayEntry hit = { node.child[slot], node.count[slot], enter[slot] };
+            int h = hitCount++;
+            for (; h > 0 && hits[h - 1].enter < hit.enter; --h) {
+                hits[h] = hits[h - 1];
+            }
+            hits[h] = hit;
+        }
+        XO_ASSERT(top + hitCount <= BVHStackSize, "xo-math BVH traversal stack overflow.");
+        for (int h = 0; h < hitCount; ++h) {
+            stack[top++] = hits[h];
+        }
+    }
+    return found;
+}
+
+size_t BVH::QueryRay(const Ray& ray, float maxT, uint32_t* outIndices) const {
+    if (!nodeCount) {
+        return 0;
+    }
+    const BVHRay wideRay(ray);
+    uint32_t stack[BVHStackSize];
+    int top = 0;
+    stack[top++] = 0;
+    size_t written = 0;
+    while (top) {
+        const Node& node = nodes[stack[--top]];
+        float enter[4];
+        const int bits = wideRay.Test(node, maxT, enter);
+        for (int slot = 0; slot < 4; ++slot) {
+            if (bits & (1 << slot)) {
+                if (node.child[slot] & LeafBit) {
+                    written = BVHEmit(indices, node.child[slot] & ~LeafBit, node.count[slot], outIndices, written);
+                }
+                else {
+                    XO_ASSERT(top < BVHStackSize, "xo-math BVH traversal stack overflow.");
+                    stack[top++] = node.child[slot];
+                }
+            }
+        }
+    }
+    return written;
+}
+
+size_t BVH::QueryAABB(const AABB& box, uint32_t* outIndices) const {
+    if (!nodeCount) {
+        return 0;
+    }
+    uint32_t stack[BVHStackSize];
+    int top = 0;
+    stack[top++] = 0;
+    size_t written = 0;
+    while (top) {
+        const Node& node = nodes[stack[--top]];
+        const int bits = BVHOverlaps(node, box);
+        for (int slot = 0; slot < 4; ++slot) {
+            if (bits & (1 << slot)) {
+                if (node.child[slot] & LeafBit) {
+                    written = BVHEmit(indices, node.child[slot] & ~LeafBit, node.count[slot], outIndices, written);
+                }
+                else {
+                    XO_ASSERT(top < BVHStackSize, "xo-math BVH traversal stack overflow.");
+                    stack[top++] = node.child[slot];
+                }
+            }
+        }
+    }
+    return written;
+}
+
+size_t BVH::QueryFrustum(const Frustum& frustum, uint32_t* outIndices) const {
+    if (!nodeCount) {
+        return 0;
+    }
+    struct Entry {
+        uint32_t node;
+        uint32_t first;
+        uint32_t planeMask;
+    };
+    const BVHFrustum planes(frustum);
+    Entry stack[BVHStackSize];
+    int top = 0;
+    stack[top++] = { 0, 0, Frustum::AllPlanes };
+    size_t written = 0;
+    while (top) {
+        const Entry entry = stack[--top];
+        const Node& node = nodes[entry.node];
+        uint32_t planeMasks[4];
+        const int bits = planes.Test(node, entry.planeMask, planeMasks);
+        uint32_t first = entry.first;
+        for (int slot = 0; slot < 4; ++slot) {
+            if (bits & (1 << slot)) {
+                // a subtree inside every plane is reported whole, its primitives being one run of indices.
+                if ((node.child[slot] & LeafBit) || planeMasks[slot] == 0) {
+                    written = BVHEmit(indices, first, node.count[slot], outIndices, written);
+                }
+                else {
+                    XO_ASSERT(top < BVHStackSize, "xo-math BVH traversal stack overflow.");
+                    stack[top++] = { node.child[slot], first, planeMasks[slot] };
+                }
+            }
+            first += node.count[slot];
+        }
+    }
+    return written;
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,461 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+const BoundingSphere BoundingSphere::Empty(Vector3(0.0f), -1.0f);
+
+namespace
+{
+    // Each thread gets at least this many points.
+    const size_t SphereThreadShare = 1 << 17;
+    // The wide passes track point indices in float lanes, which count exactly up to 2^24, so longer runs of points 
+    // are taken in blocks.
+    const size_t SphereBlockSize = 1 << 22;
+    // EPOS-14 finds extremes along the three axes and the four diagonals (1, 1, 1), (1, 1, -1), (1, -1, 1) and 
+    // (1, -1, -1). Ritter's method only uses the axes.
+    const int SphereAxisCount = 3;
+    const int SphereDirectionCount = 7;
+
+    // The point's projections onto the first D directions. The diagonals' components are all one or minus one, so 
+    // they need no multiplies. The directions aren't normalized, which leaves the extreme points unchanged.
+    template <int D>
+    _XOINL void SphereProject(float x, float y, float z, float* outDots) {
+        outDots[0] = x;
+        outDots[1] = y;
+        outDots[2] = z;
+        if (D > SphereAxisCount) {
+            const float xPlusY = x + y, xMinusY = x - y;
+            outDots[3] = xPlusY + z;
+            outDots[4] = xPlusY - z;
+            outDots[5] = xMinusY + z;
+            outDots[6] = xMinusY - z;
+        }
+    }
+
+    // The smallest and largest projections of a run of points onto each direction, and the points they came from.
+    struct SphereExtremes {
+        void Clear() {
+            for (int d = 0; d < SphereDirectionCount; ++d) {
+                min[d] = std::numeric_limits<float>::infinity();
+                max[d] = -std::numeric_limits<float>::infinity();
+                minIndex[d] = maxIndex[d] = 0;
+            }
+        }
+        void Add(const SphereExtremes& extremes) {
+            for (int d = 0; d < SphereDirectionCount; ++d) {
+                AddMin(d, extremes.min[d], extremes.minIndex[d]);
+                AddMax(d, extremes.max[d], extremes.maxIndex[d]);
+            }
+        }
+        void AddMin(int d, float dot, size_t index) {
+            if (dot < min[d]) {
+                min[d] = dot;
+                minIndex[d] = index;
+            }
+        }
+        void AddMax(int d, float dot, size_t index) {
+            if (dot > max[d]) {
+                max[d] = dot;
+                maxIndex[d] = index;
+            }
+        }
+
+        float min[SphereDirectionCount];
+        float max[SphereDirectionCount];
+        size_t minIndex[SphereDirectionCount];
+        size_t maxIndex[SphereDirectionCount];
+    };
+
+#if defined(XO_SSE)
+    template <int D>
+    _XOINL void SphereProject(wide::Float x, wide::Float y, wide::Float z, wide::Float* outDots) {
+        using namespace wide;
+        outDots[0] = x;
+        outDots[1] = y;
+        outDots[2] = z;
+        if (D > SphereAxisCount) {
+            const Float xPlusY = Add(x, y), xMinusY = Sub(x, y);
+            outDots[3] = Add(xPlusY, z);
+            outDots[4] = Sub(xPlusY, z);
+            outDots[5] = Add(xMinusY, z);
+            outDots[6] = Sub(xMinusY, z);
+        }
+    }
+
+    // Extremes of the points from begin, a multiple of wide::Width of them, kept per lane and reduced at the end.
+    template <int D>
+    void SphereWideExtremes(const Vector3* points, size_t begin, size_t end, SphereExtremes& inOutExtremes) {
+        using namespace wide;
+        _XOSIMDALIGN32 float lanes[Width];
+        for (int l = 0; l < Width; ++l) {
+            lanes[l] = (float)l;
+        }
+        Float min[D], max[D], minIndex[D], maxIndex[D];
+        for (int d = 0; d < D; ++d) {
+            min[d] = wide::Set(std::numeric_limits<float>::infinity());
+            max[d] = wide::Set(-std::numeric_limits<float>::infinity());
+            minIndex[d] = maxIndex[d] = Zero();
+        }
+        const Float step = wide::Set((float)Width);
+        Float index = Load(lanes);
+        for (size_t i = begin; i < end; i += Width) {
+            Float x, y, z, w, dots[D];
+            LoadTransposed4(&points[i].x, 4, x, y, z, w);
+            SphereProject<D>(x, y, z, dots);
+            for (int d = 0; d < D; ++d) {
+                minIndex[d] = Select(CmpLt(dots[d], min[d]), index, minIndex[d]);
+                maxIndex[d] = Select(CmpGt(dots[d], max[d]), index, maxIndex[d]);
+                min[d] = wide::Min(dots[d], min[d]);
+                max[d] = wide::Max(dots[d], max[d]);
+            }
+            index = Add(index, step);
+        }
+        _XOSIMDALIGN32 float dot[Width], at[Width];
+        for (int d = 0; d < D; ++d) {
+            Store(dot, min[d]);
+            Store(at, minIndex[d]);
+            for (int l = 0; l < Width; ++l) {
+                inOutExtremes.AddMin(d, dot[l], begin + (size_t)at[l]);
+            }
+            Store(dot, max[d]);
+            Store(at, maxIndex[d]);
+            for (int l = 0; l < Width; ++l) {
+                inOutExtremes.AddMax(d, dot[l], begin + (size_t)at[l]);
+            }
+        }
+    }
+#endif
+
+    template <int D>
+    void SphereFindExtremes(const Vector3* points, size_t begin, size_t end, SphereExtremes& outExtremes) {
+        outExtremes.Clear();
+        size_t i = begin;
+#if defined(XO_SSE)
+        while (end - i >= (size_t)wide::Width) {
+            const size_t blockEnd = i + _XO_MIN((end - i) / wide::Width * wide::Width, SphereBlockSize);
+            SphereWideExtremes<D>(points, i, blockEnd, outExtremes);
+            i = blockEnd;
+        }
+#endif
+        for (; i < end; ++i) {
+            float dots[SphereDirectionCount];
+            SphereProject<D>(points[i].x, points[i].y, points[i].z, dots);
+            for (int d = 0; d < D; ++d) {
+                outExtremes.AddMin(d, dots[d], i);
+                outExtremes.AddMax(d, dots[d], i);
+            }
+        }
+    }
+
+    // Ritter's growth step, on raw floats to keep Vector3's constructors out of the loop.
+    _XOINL void SphereGrowTo(const Vector3& point, float* center, float& radius) {
+        const float dx = point.x - center[0], dy = point.y - center[1], dz = point.z - center[2];
+        const float distanceSquared = dx * dx + dy * dy + dz * dz;
+        if (distanceSquared > radius * radius) {
+            const float distance = Sqrt(distanceSquared);
+            const float grownRadius = (radius + distance) * 0.5f;
+            const float move = (grownRadius - radius) / distance;
+            center[0] += dx * move;
+            center[1] += dy * move;
+            center[2] += dz * move;
+            radius = grownRadius;
+        }
+    }
+
+    // Grows the sphere over the points from begin to end. Only the rare points found outside it take the scalar path.
+    void SphereGrow(const Vector3* points, size_t begin, size_t end, float* center, float& radius) {
+        size_t i = begin;
+#if defined(XO_SSE)
+        using namespace wide;
+        Float x0 = wide::Set(center[0]), y0 = wide::Set(center[1]), z0 = wide::Set(center[2]), radiusSquared = wide::Set(radius * radius);
+        for (; end - i >= (size_t)Width; i += Width) {
+            Float x, y, z, w;
+            LoadTransposed4(&points[i].x, 4, x, y, z, w);
+            x = Sub(x, x0);
+            y = Sub(y, y0);
+            z = Sub(z, z0);
+            const int outside = MoveMask(CmpGt(MulAdd(z, z, MulAdd(y, y, Mul(x, x))), radiusSquared));
+            if (outside) {
+                for (int l = 0; l < Width; ++l) {
+                    if (outside & (1 << l)) {
+                        SphereGrowTo(points[i + l], center, radius);
+                    }
+                }
+                x0 = wide::Set(center[0]);
+                y0 = wide::Set(center[1]);
+                z0 = wide::Set(center[2]);
+                radiusSquared = wide::Set(radius * radius);
+            }
+        }
+#endif
+        for (; i < end; ++i) {
+            SphereGrowTo(points[i], center, radius);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////// Welzl's algorithm
+
+    // A sphere in double precision, with its squared radius negative when empty.
+    struct SphereBall {
+        bool Outside(const double* p) const {
+            const double dx = p[0] - center[0], dy = p[1] - center[1], dz = p[2] - center[2];
+            // the tolerance keeps points on the surface from being taken as new support points over rounding.
+            return dx * dx + dy * dy + dz * dz > radiusSquared * (1.0 + 1e-9);
+        }
+
+        double center[3];
+        double radiusSquared;
+    };
+
+    _XOINL void SphereSub(const double* a, const double* b, double* out) {
+        out[0] = a[0] - b[0];
+        out[1] = a[1] - b[1];
+        out[2] = a[2] - b[2];
+    }
+    _XOINL void SphereCross(const double* a, const double* b, double* out) {
+        out[0] = a[1] * b[2] - a[2] * b[1];
+        out[1] = a[2] * b[0] - a[0] * b[2];
+        out[2] = a[0] * b[1] - a[1] * b[0];
+    }
+    _XOINL double SphereDot(const double* a, const double* b) {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+
+    // The sphere centered at a + offset, passing through a.
+    SphereBall SphereBallAt(const double* a, const double* offset) {
+        SphereBall ball;
+        for (int axis = 0; axis < 3; ++axis) {
+            ball.center[axis] = a[axis] + offset[axis];
+        }
+        ball.radiusSquared = SphereDot(offset, offset);
+        return ball;
+    }
+
+    SphereBall SphereThrough2(const double* a, const double* b) {
+        double offset[3];
+        SphereSub(b, a, offset);
+        for (int axis = 0; axis < 3; ++axis) {
+            offset[axis] *= 0.5;
+        }
+        return SphereBallAt(a, offset);
+    }
+
+    // The smallest sphere through all three points: the circumcircle of their triangle, or the sphere around the two 
+    // farthest apart when they're on a line.
+    SphereBall SphereThrough3(const double* a, const double* b, const double* c) {
+        double u[3], v[3], n[3];
+        SphereSub(b, a, u);
+        SphereSub(c, a, v);
+        SphereCross(u, v, n);
+        const double uu = SphereDot(u, u), vv = SphereDot(v, v), nn = SphereDot(n, n);
+        if (nn <= uu * vv * 1e-14) {
+            double w[3];
+            SphereSub(c, b, w);
+            const double ww = SphereDot(w, w);
+            if (uu >= vv && uu >= ww) {
+                return SphereThrough2(a, b);
+            }
+            return vv >= ww ? SphereThrough2(a, c) : SphereThrough2(b, c);
+        }
+        // center - a = (|u|^2 (v x n) + |v|^2 (n x u)) / 2|n|^2
+        double vn[3], nu[3], offset[3];
+        SphereCross(v, n, vn);
+        SphereCross(n, u, nu);
+        for (int axis = 0; axis < 3; ++axis) {
+            offset[axis] = (uu * vn[axis] + vv * nu[axis]) / (2.0 * nn);
+        }
+        return SphereBallAt(a, offset);
+    }
+
+    // The sphere through all four points. When they're on a plane there may be none, and the smallest sphere 
+    // through three of them holding the fourth is used instead, or failing that the largest.
+    SphereBall SphereThrough4(const double* a, const double* b, const double* c, const double* d) {
+        double u[3], v[3], w[3], vw[3], wu[3], uv[3];
+        SphereSub(b, a, u);
+        SphereSub(c, a, v);
+        SphereSub(d, a, w);
+        SphereCross(v, w, vw);
+        SphereCross(w, u, wu);
+        SphereCross(u, v, uv);
+        const double uu = SphereDot(u, u), vv = SphereDot(v, v), ww = SphereDot(w, w);
+        const double volume = SphereDot(u, vw);
+        if (volume * volume > uu * vv * ww * 1e-20) {
+            // center - a = (|u|^2 (v x w) + |v|^2 (w x u) + |w|^2 (u x v)) / 2 (u . (v x w))
+            double offset[3];
+            for (int axis = 0; axis < 3; ++axis) {
+                offset[axis] = (uu * vw[axis] + vv * wu[axis] + ww * uv[axis]) / (2.0 * volume);
+            }
+            return SphereBallAt(a, offset);
+        }
+        const double* points[4] = { a, b, c, d };
+        SphereBall best, largest;
+        best.radiusSquared = std::numeric_limits<double>::infinity();
+        largest.radiusSquared = -1.0;
+        for (int skip = 0; skip < 4; ++skip) {
+            const SphereBall ball = SphereThrough3(points[skip == 0 ? 1 : 0], points[skip <= 1 ? 2 : 1], points[skip <= 2 ? 3 : 2]);
+            if (!ball.Outside(points[skip]) && ball.radiusSquared < best.radiusSquared) {
+                best = ball;
+            }
+            if (ball.radiusSquared > largest.radiusSquared) {
+                largest = ball;
+            }
+        }
+        return best.radiusSquared < std::numeric_limits<double>::infinity() ? best : largest;
+    }
+
+    SphereBall SphereThrough(const double (*support)[3], int supportCount) {
+        SphereBall ball;
+        switch (supportCount) {
+        case 0:
+            ball.center[0] = ball.center[1] = ball.center[2] = 0.0;
+            ball.radiusSquared = -1.0;
+            return ball;
+        case 1:
+            ball.center[0] = support[0][0];
+            ball.center[1] = support[0][1];
+            ball.center[2] = support[0][2];
+            ball.radiusSquared = 0.0;
+            return ball;
+        case 2:
+            return SphereThrough2(support[0], support[1]);
+        case 3:
+            return SphereThrough3(support[0], support[1], support[2]);
+        default:
+            return SphereThrough4(support[0], support[1], support[2], support[3]);
+        }
+    }
+
+    // The smallest sphere holding the first count points with every support point on its surface. Each point found 
+    // outside the sphere so far must be on the surface of the final one, and becomes a support point for the 
+    // sphere around the points before it.
+    SphereBall SphereWelzl(const Vector3* points, size_t count, double (*support)[3], int supportCount) {
+        SphereBall ball = SphereThrough(support, supportCount);
+        if (supportCount == 4) {
+            return ball;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            const double p[3] = { points[i].x, points[i].y, points[i].z };
+            if (ball.Outside(p)) {
+                support[supportCount][0] = p[0];
+                support[supportCount][1] = p[1];
+                support[supportCount][2] = p[2];
+                ball = SphereWelzl(points, i, support, supportCount + 1);
+            }
+        }
+        return ball;
+    }
+
+    ////////////////////////////////////////////////////////////////////////// Fitting
+
+    // Finds the starting sphere from the extremes of every point, then grows it over them.
+    template <int D>
+    BoundingSphere SphereFit(const Vector3* points, size_t count, unsigned threadCount) {
+        if (!count) {
+            return BoundingSphere::Empty;
+        }
+        const unsigned threads = xo_internal::ThreadCount(threadCount, count, SphereThreadShare);
+        const size_t share = (count + threads - 1) / threads;
+
+        SphereExtremes extremes[xo_internal::MaxThreads];
+        xo_internal::Parallel(threads, [&](unsigned t) {
+            SphereFindExtremes<D>(points, _XO_MIN(share * t, count), _XO_MIN(share * (t + 1), count), extremes[t]);
+        });
+        for (unsigned t = 1; t < threads; ++t) {
+            extremes[0].Add(extremes[t]);
+        }
+
+        float center[3] = { points[0].x, points[0].y, points[0].z }, radius = 0.0f;
+        if (D == SphereAxisCount) {
+            // Ritter: the sphere around the farthest apart pair.
+            float farthest = -1.0f;
+            for (int d = 0; d < D; ++d) {
+                const Vector3& a = points[extremes[0].minIndex[d]];
+                const Vector3& b = points[extremes[0].maxIndex[d]];
+                const float distanceSquared = Vector3::DistanceSquared(a, b);
+                if (distanceSquared > farthest) {
+                    farthest = distanceSquared;
+                    center[0] = (a.x + b.x) * 0.5f;
+                    center[1] = (a.y + b.y) * 0.5f;
+                    center[2] = (a.z + b.z) * 0.5f;
+                    radius = Sqrt(distanceSquared) * 0.5f;
+                }
+            }
+        }
+        else {
+            // EPOS: the smallest sphere around all the extreme points.
+            Vector3 extremePoints[SphereDirectionCount * 2];
+            for (int d = 0; d < D; ++d) {
+                extremePoints[d * 2] = points[extremes[0].minIndex[d]];
+                extremePoints[d * 2 + 1] = points[extremes[0].maxIndex[d]];
+            }
+            double support[4][3];
+            const SphereBall ball = SphereWelzl(extremePoints, D * 2, support, 0);
+            center[0] = (float)ball.center[0];
+            center[1] = (float)ball.center[1];
+            center[2] = (float)ball.center[2];
+            radius = (float)sqrt(ball.radiusSquared);
+        }
+
+        BoundingSphere grown[xo_internal::MaxThreads];
+        xo_internal::Parallel(threads, [&](unsigned t) {
+            float threadCenter[3] = { center[0], center[1], center[2] };
+            float threadRadius = radius;
+            SphereGrow(points, _XO_MIN(share * t, count), _XO_MIN(share * (t + 1), count), threadCenter, threadRadius);
+            grown[t].Set(Vector3(threadCenter[0], threadCenter[1], threadCenter[2]), threadRadius);
+        });
+        for (unsigned t = 1; t < threads; ++t) {
+            grown[0].Expand(grown[t]);
+        }
+        return grown[0];
+    }
+}
+
+BoundingSphere BoundingSphere::FromPoints(const Vector3* points, size_t count, unsigned threadCount) {
+    return SphereFit<SphereDirectionCount>(points, count, threadCount);
+}
+
+BoundingSphere BoundingSphere::FromPointsRitter(const Vector3* points, size_t count, unsigned threadCount) {
+    return SphereFit<SphereAxisCount>(points, count, threadCount);
+}
+
+BoundingSphere BoundingSphere::FromPointsExact(const Vector3* points, size_t count) {
+    if (!count) {
+        return Empty;
+    }
+    double support[4][3];
+    const SphereBall ball = SphereWelzl(points, count, support, 0);
+    // Rounding to float can leave a support point just outside, so the radius is taken from the farthest point.
+    const Vector3 center((float)ball.center[0], (float)ball.center[1], (float)ball.center[2]);
+    float farthest = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        farthest = Max(farthest, Vector3::DistanceSquared(center, points[i]));
+    }
+    return BoundingSphere(center, Sqrt(farthest));
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,95 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+const DualQuaternion DualQuaternion::Identity(Quaternion(0.0f, 0.0f, 0.0f, 1.0f), Quaternion(0.0f, 0.0f, 0.0f, 0.0f));
+
+namespace
+{
+    _XOINL float DualQuaternionDot(const Quaternion& a, const Quaternion& b) {
+        return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+    }
+
+    // a * s
+    _XOINL Quaternion DualQuaternionScale(const Quaternion& a, float s) {
+        return Quaternion(a.x * s, a.y * s, a.z * s, a.w * s);
+    }
+
+    // a * s + b * t
+    _XOINL Quaternion DualQuaternionSum(const Quaternion& a, float s, const Quaternion& b, float t) {
+        return Quaternion(a.x * s + b.x * t, a.y * s + b.y * t, a.z * s + b.z * t, a.w * s + b.w * t);
+    }
+}
+
+DualQuaternion::DualQuaternion() {
+}
+
+DualQuaternion::DualQuaternion(const Quaternion& real, const Quaternion& dual) :
+    real(real),
+    dual(dual)
+{
+}
+
+DualQuaternion::DualQuaternion(const Quaternion& rotation, const Vector3& translation) :
+    real(rotation),
+    dual(DualQuaternionScale(Quaternion(translation.x, translation.y, translation.z, 0.0f) * rotation, 0.5f))
+{
+}
+
+DualQuaternion::DualQuaternion(const Transform& t) :
+    DualQuaternion(t.rotation, t.translation)
+{
+}
+
+DualQuaternion& DualQuaternion::Normalize() {
+    const float inverseMagnitude = 1.0f / Sqrt(DualQuaternionDot(real, real));
+    real = DualQuaternionScale(real, inverseMagnitude);
+    dual = DualQuaternionSum(dual, inverseMagnitude, real, -DualQuaternionDot(real, dual) * inverseMagnitude);
+    return *this;
+}
+
+DualQuaternion& DualQuaternion::MakeInverse() {
+    real.MakeConjugate();
+    dual.MakeConjugate();
+    return *this;
+}
+
+void DualQuaternion::ToMatrix(Matrix3x4& outMatrix) const {
+    ToTransform().ToMatrix(outMatrix);
+}
+
+void DualQuaternion::Nlerp(const DualQuaternion& a, const DualQuaternion& b, float t, DualQuaternion& outQuat) {
+    const float s = 1.0f - t;
+    if (DualQuaternionDot(a.real, b.real) < 0.0f) {
+        t = -t;
+    }
+    outQuat.real = DualQuaternionSum(a.real, s, b.real, t);
+    outQuat.dual = DualQuaternionSum(a.dual, s, b.dual, t);
+    outQuat.Normalize();
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,193 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+const float EPA::Tolerance = 1e-5f;
+
+namespace
+{
+    // Each new point can see at most every face, whose edges around the visible region are each used once.
+    const int EPAMaxEdges = EPA::MaxFaces * 3 / 2;
+
+    struct EPAEdge {
+        int from, to;
+    };
+
+    // Sets the face's normal and distance from its corners. Returns false when the corners are in a line.
+    bool EPASetFace(const Vector3* points, int a, int b, int c, EPA::Polytope::Face& outFace) {
+        const Vector3 normal = (points[b] - points[a]).Cross(points[c] - points[a]);
+        const float lengthSquared = normal.MagnitudeSquared();
+        if (!(lengthSquared > 0.0f)) {
+            return false;
+        }
+        outFace.normal = normal * (1.0f / Sqrt(lengthSquared));
+        outFace.distance = outFace.normal.Dot(points[a]);
+        outFace.vertices[0] = a;
+        outFace.vertices[1] = b;
+        outFace.vertices[2] = c;
+        return true;
+    }
+
+    // The barycentric coordinates of the origin projected onto the face's plane.
+    void EPABarycentric(const Vector3* points, const EPA::Polytope::Face& face, float& outU, float& outV, float& outW) {
+        const Vector3& a = points[face.vertices[0]];
+        const Vector3 ab = points[face.vertices[1]] - a, ac = points[face.vertices[2]] - a, ap = face.normal * face.distance - a;
+        const float d00 = ab.Dot(ab), d01 = ab.Dot(ac), d11 = ac.Dot(ac), d20 = ap.Dot(ab), d21 = ap.Dot(ac);
+        const float denominator = d00 * d11 - d01 * d01;
+        outV = (d11 * d20 - d01 * d21) / denominator;
+        outW = (d00 * d21 - d01 * d20) / denominator;
+        outU = 1.0f - outV - outW;
+    }
+}
+
+bool EPA::Polytope::Start(const GJK::Simplex& simplex) {
+    XO_ASSERT(simplex.count == 4, "xo-math EPA::Polytope::Start needs a tetrahedron.");
+    size = 0.0f;
+    for (int p = 0; p < 4; ++p) {
+        points[p] = simplex.points[p];
+        supportsA[p] = simplex.supportsA[p];
+        supportsB[p] = simplex.supportsB[p];
+        size = Max(size, points[p].Magnitude());
+    }
+    vertexCount = 4;
+    // each face is wound so its normal points away from the opposite corner.
+    static const int corners[4][4] = { { 0, 1, 2, 3 }, { 0, 3, 1, 2 }, { 0, 2, 3, 1 }, { 1, 3, 2, 0 } };
+    const bool flipped = (points[1] - points[0]).Cross(points[2] - points[0]).Dot(points[3] - points[0]) > 0.0f;
+    for (int f = 0; f < 4; ++f) {
+        const int a = corners[f][0], b = flipped ? corners[f][2] : corners[f][1], c = flipped ? corners[f][1] : corners[f][2];
+        if (!EPASetFace(points, a, b, c, faces[f]) || faces[f].normal.Dot(points[corners[f][3]] - points[a]) >= 0.0f) {
+            return false;
+        }
+    }
+    faceCount = 4;
+    return true;
+}
+
+bool EPA::Polytope::Expand(const Vector3& supportA, const Vector3& supportB) {
+    if (vertexCount == MaxVertices) {
+        return false;
+    }
+    const Vector3 point = supportA - supportB;
+
+    // The faces the point is in front of, and the edges around them, which are those only one of them has. A shared 
+    // edge appears once in each direction.
+    bool visible[MaxFaces];
+    EPAEdge edges[EPAMaxEdges];
+    int visibleCount = 0, edgeCount = 0;
+    for (int f = 0; f < faceCount; ++f) {
+        visible[f] = faces[f].normal.Dot(point - points[faces[f].vertices[0]]) > 0.0f;
+        if (!visible[f]) {
+            continue;
+        }
+        ++visibleCount;
+        for (int e = 0; e < 3; ++e) {
+            const EPAEdge edge = { faces[f].vertices[e], faces[f].vertices[(e + 1) % 3] };
+            int shared = 0;
+            while (shared < edgeCount && !(edges[shared].from == edge.to && edges[shared].to == edge.from)) {
+                ++shared;
+            }
+            if (shared < edgeCount) {
+                edges[shared] = edges[--edgeCount];
+            }
+            else if (edgeCount < EPAMaxEdges) {
+                edges[edgeCount++] = edge;
+            }
+            else {
+                return false;
+            }
+        }
+    }
+    if (visibleCount == 0 || faceCount - visibleCount + edgeCount > MaxFaces) {
+        return false;
+    }
+
+    // Builds the new faces before changing anything, so a point too close to an edge leaves the polytope whole.
+    points[vertexCount] = point;
+    Face added[EPAMaxEdges];
+    for (int e = 0; e < edgeCount; ++e) {
+        if (!EPASetFace(points, edges[e].from, edges[e].to, vertexCount, added[e])) {
+            return false;
+        }
+    }
+    supportsA[vertexCount] = supportA;
+    supportsB[vertexCount] = supportB;
+    ++vertexCount;
+    int kept = 0;
+    for (int f = 0; f < faceCount; ++f) {
+        if (!visible[f]) {
+            faces[kept++] = faces[f];
+        }
+    }
+    for (int e = 0; e < edgeCount; ++e) {
+        faces[kept++] = added[e];
+    }
+    faceCount = kept;
+    return true;
+}
+
+int EPA::Polytope::ClosestFace() const {
+    int closest = 0;
+    for (int f = 1; f < faceCount; ++f) {
+        if (faces[f].distance < faces[closest].distance) {
+            closest = f;
+        }
+    }
+    return closest;
+}
+
+void EPA::Polytope::Contact(int face, Vector3& outPointA, Vector3& outPointB) const {
+    // Flat parts of the difference, such as the sides of boxes, become several faces in one plane, and the origin 
+    // projected onto the plane can be in any of them. The one it's most inside of is used.
+    float u, v, w;
+    EPABarycentric(points, faces[face], u, v, w);
+    for (int f = 0; f < faceCount; ++f) {
+        if (f != face && faces[f].distance - faces[face].distance <= Tolerance * size && 
+            faces[f].normal.Dot(faces[face].normal) >= 1.0f - Tolerance) {
+            float fu, fv, fw;
+            EPABarycentric(points, faces[f], fu, fv, fw);
+            if (Min(fu, Min(fv, fw)) > Min(u, Min(v, w))) {
+                face = f;
+                u = fu;
+                v = fv;
+                w = fw;
+            }
+        }
+    }
+    // the point is inside the face, to within rounding.
+    u = Max(u, 0.0f);
+    v = Max(v, 0.0f);
+    w = Max(w, 0.0f);
+    const float scale = 1.0f / (u + v + w);
+    u *= scale;
+    v *= scale;
+    w *= scale;
+    const Face& f = faces[face];
+    outPointA = supportsA[f.vertices[0]] * u + supportsA[f.vertices[1]] * v + supportsA[f.vertices[2]] * w;
+    outPointB = supportsB[f.vertices[0]] * u + supportsB[f.vertices[1]] * v + supportsB[f.vertices[2]] * w;
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,210 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+Frustum& Frustum::Set(const Matrix4x4& m, ClipDepth depth) {
+    // Clip space x, y and z are the dot products of rows 0, 1 and 2 with the point, and w of row 3. Each plane is one 
+    // of the clip conditions -w <= x <= w, -w <= y <= w, and 0 <= z <= w or -w <= z <= w, rearranged to row . p >= 0.
+    const Vector4 r0 = m[0], r1 = m[1], r2 = m[2], r3 = m[3];
+    planes[Left] = r3 + r0;
+    planes[Right] = r3 - r0;
+    planes[Bottom] = r3 + r1;
+    planes[Top] = r3 - r1;
+    planes[Near] = depth == ClipDepth::ZeroToOne ? r2 : r3 + r2;
+    planes[Far] = r3 - r2;
+    for (int i = 0; i < PlaneCount; ++i) {
+        Vector4& p = planes[i];
+        const float length = Sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
+        if (length > 0.0f) {
+            p /= length;
+        }
+    }
+    return *this;
+}
+
+namespace
+{
+    _XOINL uint32_t FrustumBitCount(uint32_t bits) {
+        bits = bits - ((bits >> 1) & 0x55555555);
+        bits = (bits & 0x33333333) + ((bits >> 2) & 0x33333333);
+        return (((bits + (bits >> 4)) & 0x0f0f0f0f) * 0x01010101) >> 24;
+    }
+
+    // The planes selected by a plane mask, with each element broadcast to every lane. Boxes use the normals halved, and 
+    // the absolute value of those, so they can work from min + max and max - min instead of center and extents.
+    struct FrustumPlanes {
+        FrustumPlanes(const Frustum& frustum, uint32_t planeMask) : count(0) {
+            for (int i = 0; i < Frustum::PlaneCount; ++i) {
+                if (planeMask & (1 << i)) {
+                    const Vector4& p = frustum.planes[i];
+                    x[count] = wide::Set(p.x);
+                    y[count] = wide::Set(p.y);
+                    z[count] = wide::Set(p.z);
+                    w[count] = wide::Set(p.w);
+                    halfX[count] = wide::Set(p.x * 0.5f);
+                    halfY[count] = wide::Set(p.y * 0.5f);
+                    halfZ[count] = wide::Set(p.z * 0.5f);
+                    absHalfX[count] = wide::Set(Abs(p.x) * 0.5f);
+                    absHalfY[count] = wide::Set(Abs(p.y) * 0.5f);
+                    absHalfZ[count] = wide::Set(Abs(p.z) * 0.5f);
+                    ++count;
+                }
+            }
+        }
+
+        // Mask of the lanes whose spheres are not entirely behind any plane.
+        _XOINL wide::Float Spheres(wide::Float cx, wide::Float cy, wide::Float cz, wide::Float radius) const {
+            using namespace wide;
+            const Float reach = Negate(radius);
+            Float visible = True();
+            for (int i = 0; i < count; ++i) {
+                const Float distance = MulAdd(x[i], cx, MulAdd(y[i], cy, MulAdd(z[i], cz, w[i])));
+                visible = And(visible, CmpGe(distance, reach));
+            }
+            return visible;
+        }
+
+        // Mask of the lanes whose boxes are not entirely behind any plane. A box reaches |n| . extents toward a plane.
+        // sum is min + max (twice the center) and size is max - min (twice the extents).
+        _XOINL wide::Float Boxes(wide::Float sumX, wide::Float sumY, wide::Float sumZ, wide::Float sizeX, wide::Float sizeY, wide::Float sizeZ) const {
+            using namespace wide;
+            Float visible = True();
+            for (int i = 0; i < count; ++i) {
+                const Float distance = MulAdd(halfX[i], sumX, MulAdd(halfY[i], sumY, MulAdd(halfZ[i], sumZ, w[i])));
+                const Float reach = MulAdd(absHalfX[i], sizeX, MulAdd(absHalfY[i], sizeY, Mul(absHalfZ[i], sizeZ)));
+                visible = And(visible, CmpGe(distance, Negate(reach)));
+            }
+            return visible;
+        }
+
+        wide::Float x[Frustum::PlaneCount], y[Frustum::PlaneCount], z[Frustum::PlaneCount], w[Frustum::PlaneCount];
+        wide::Float halfX[Frustum::PlaneCount], halfY[Frustum::PlaneCount], halfZ[Frustum::PlaneCount];
+        wide::Float absHalfX[Frustum::PlaneCount], absHalfY[Frustum::PlaneCount], absHalfZ[Frustum::PlaneCount];
+        int count;
+    };
+
+    struct FrustumSphereTest {
+        typedef Vector4 Record;
+        _XOINL static int Visible(const FrustumPlanes& planes, const Vector4* spheres) {
+            wide::Float x, y, z, radius;
+            wide::LoadTransposed4(&spheres->x, sizeof(Vector4) / sizeof(float), x, y, z, radius);
+            return wide::MoveMask(planes.Spheres(x, y, z, radius));
+        }
+    };
+
+    struct FrustumAABBTest {
+        typedef AABB Record;
+        _XOINL static int Visible(const FrustumPlanes& planes, const AABB* boxes) {
+            using namespace wide;
+            Float minX, minY, minZ, maxX, maxY, maxZ;
+#if defined(XO_SSE)
+            // the padding lanes of each corner are loaded and ignored.
+            Float minW, maxW;
+            LoadTransposed4(&boxes->min.x, sizeof(AABB) / sizeof(float), minX, minY, minZ, minW);
+            LoadTransposed4(&boxes->max.x, sizeof(AABB) / sizeof(float), maxX, maxY, maxZ, maxW);
+#else
+            minX = boxes->min.x;
+            minY = boxes->min.y;
+            minZ = boxes->min.z;
+            maxX = boxes->max.x;
+            maxY = boxes->max.y;
+            maxZ = boxes->max.z;
+#endif
+            return MoveMask(planes.Boxes(Add(minX, maxX), Add(minY, maxY), Add(minZ, maxZ), Sub(maxX, minX), Sub(maxY, minY), Sub(maxZ, minZ)));
+        }
+    };
+
+    // The visibility bits of the last count (< Width) records, tested as a whole group with the last record repeated 
+    // in the unused lanes so that they go through exactly the same arithmetic as every other group.
+    template <class Test>
+    _XOINL int FrustumTailVisible(const FrustumPlanes& planes, const typename Test::Record* records, size_t count) {
+        typename Test::Record tail[wide::Width];
+        for (size_t i = 0; i < (size_t)wide::Width; ++i) {
+            tail[i] = records[i < count ? i : count - 1];
+        }
+        return Test::Visible(planes, tail) & wide::LaneBits((int)count);
+    }
+
+    template <class Test>
+    size_t FrustumCullBits(const FrustumPlanes& planes, const typename Test::Record* records, size_t count, uint32_t* outVisibleBits) {
+        // 32 is a multiple of every Width, so a group's bits never straddle two words.
+        memset(outVisibleBits, 0, ((count + 31) / 32) * sizeof(uint32_t));
+        size_t visible = 0;
+        size_t i = 0;
+        for (; i + wide::Width <= count; i += wide::Width) {
+            const uint32_t bits = (uint32_t)Test::Visible(planes, records + i);
+            outVisibleBits[i / 32] |= bits << (i % 32);
+            visible += FrustumBitCount(bits);
+        }
+        if (i < count) {
+            const uint32_t bits = (uint32_t)FrustumTailVisible<Test>(planes, records + i, count - i);
+            outVisibleBits[i / 32] |= bits << (i % 32);
+            visible += FrustumBitCount(bits);
+        }
+        return visible;
+    }
+
+    template <class Test>
+    size_t FrustumCullIndices(const FrustumPlanes& planes, const typename Test::Record* records, size_t count, uint32_t* outIndices) {
+        size_t visible = 0;
+        size_t i = 0;
+        // Every lane writes its index and only visible lanes advance the output, which compacts without branches. The 
+        // write is always in bounds, as visible can never pass i + lane.
+        for (; i + wide::Width <= count; i += wide::Width) {
+            const int bits = Test::Visible(planes, records + i);
+            for (int lane = 0; lane < wide::Width; ++lane) {
+                outIndices[visible] = (uint32_t)(i + lane);
+                visible += (bits >> lane) & 1;
+            }
+        }
+        if (i < count) {
+            const int bits = FrustumTailVisible<Test>(planes, records + i, count - i);
+            for (size_t lane = 0; i + lane < count; ++lane) {
+                outIndices[visible] = (uint32_t)(i + lane);
+                visible += (bits >> lane) & 1;
+            }
+        }
+        return visible;
+    }
+}
+
+size_t Frustum::CullSpheres(const Vector4* spheres, size_t count, uint32_t* outVisibleBits, uint32_t planeMask) const {
+    return FrustumCullBits<FrustumSphereTest>(FrustumPlanes(*this, planeMask), spheres, count, outVisibleBits);
+}
+
+size_t Frustum::CullSpheresIndices(const Vector4* spheres, size_t count, uint32_t* outIndices, uint32_t planeMask) const {
+    return FrustumCullIndices<FrustumSphereTest>(FrustumPlanes(*this, planeMask), spheres, count, outIndices);
+}
+
+size_t Frustum::CullAABBs(const AABB* boxes, size_t count, uint32_t* outVisibleBits, uint32_t planeMask) const {
+    return FrustumCullBits<FrustumAABBTest>(FrustumPlanes(*this, planeMask), boxes, count, outVisibleBits);
+}
+
+size_t Frustum::CullAABBsIndices(const AABB* boxes, size_t count, uint32_t* outIndices, uint32_t planeMask) const {
+    return FrustumCullIndices<FrustumAABBTest>(FrustumPlanes(*this, planeMask), boxes, count, outIndices);
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
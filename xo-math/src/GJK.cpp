@@ -0,0 +1,265 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+const float GJK::Tolerance = 1e-5f;
+
+namespace
+{
+    // The closest point to the origin of part of a simplex: which of its points it needs, and their weights.
+    struct GJKClosest {
+        int indices[4];
+        float weights[4];
+        int count;
+        float distanceSquared;
+
+        void Set(const Vector3* points, int i) {
+            indices[0] = i;
+            weights[0] = 1.0f;
+            count = 1;
+            distanceSquared = points[i].MagnitudeSquared();
+        }
+        void Set(const Vector3* points, int i, int j, float t) {
+            indices[0] = i;
+            indices[1] = j;
+            weights[0] = 1.0f - t;
+            weights[1] = t;
+            count = 2;
+            distanceSquared = (points[i] + (points[j] - points[i]) * t).MagnitudeSquared();
+        }
+        void Set(const Vector3* points, int i, int j, int k, float v, float w) {
+            indices[0] = i;
+            indices[1] = j;
+            indices[2] = k;
+            weights[0] = 1.0f - v - w;
+            weights[1] = v;
+            weights[2] = w;
+            count = 3;
+            distanceSquared = (points[i] + (points[j] - points[i]) * v + (points[k] - points[i]) * w).MagnitudeSquared();
+        }
+    };
+
+    void GJKSegment(const Vector3* points, int i, int j, GJKClosest& out) {
+        const Vector3 ab = points[j] - points[i];
+        const float t = -points[i].Dot(ab), lengthSquared = ab.Dot(ab);
+        if (t <= 0.0f || lengthSquared <= 0.0f) {
+            out.Set(points, i);
+        }
+        else if (t >= lengthSquared) {
+            out.Set(points, j);
+        }
+        else {
+            out.Set(points, i, j, t / lengthSquared);
+        }
+    }
+
+    // Triangle::ClosestPoint for the origin, keeping the corners of the region it falls in.
+    void GJKTriangle(const Vector3* points, int i, int j, int k, GJKClosest& out) {
+        const Vector3& a = points[i];
+        const Vector3& b = points[j];
+        const Vector3& c = points[k];
+        const Vector3 ab = b - a, ac = c - a;
+        const float d1 = -ab.Dot(a), d2 = -ac.Dot(a);
+        if (d1 <= 0.0f && d2 <= 0.0f) {
+            return out.Set(points, i);
+        }
+        const float d3 = -ab.Dot(b), d4 = -ac.Dot(b);
+        if (d3 >= 0.0f && d4 <= d3) {
+            return out.Set(points, j);
+        }
+        const float vc = d1 * d4 - d3 * d2;
+        if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+            return out.Set(points, i, j, d1 / (d1 - d3));
+        }
+        const float d5 = -ab.Dot(c), d6 = -ac.Dot(c);
+        if (d6 >= 0.0f && d5 <= d6) {
+            return out.Set(points, k);
+        }
+        const float vb = d5 * d2 - d1 * d6;
+        if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+            return out.Set(points, i, k, d2 / (d2 - d6));
+        }
+        const float va = d3 * d6 - d5 * d4;
+        if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f) {
+            return out.Set(points, j, k, (d4 - d3) / ((d4 - d3) + (d5 - d6)));
+        }
+        const float sum = va + vb + vc;
+        if (sum <= 0.0f) {
+            // the corners are in a line, so the closest point is on one of the edges.
+            GJKClosest edge;
+            GJKSegment(points, i, j, out);
+            GJKSegment(points, i, k, edge);
+            if (edge.distanceSquared < out.distanceSquared) {
+                out = edge;
+            }
+            GJKSegment(points, j, k, edge);
+            if (edge.distanceSquared < out.distanceSquared) {
+                out = edge;
+            }
+            return;
+        }
+        out.Set(points, i, j, k, vb / sum, vc / sum);
+    }
+
+    // The origin is inside the tetrahedron when it's on the same side of each face as the opposite corner. Otherwise 
+    // the closest point is on one of the faces it's outside of.
+    void GJKTetrahedron(const Vector3* points, GJKClosest& out) {
+        static const int faces[4][4] = { { 0, 1, 2, 3 }, { 0, 1, 3, 2 }, { 0, 2, 3, 1 }, { 1, 2, 3, 0 } };
+        float volumes[4], originVolumes[4];
+        bool outside = false;
+        out.distanceSquared = std::numeric_limits<float>::infinity();
+        for (int f = 0; f < 4; ++f) {
+            const Vector3& a = points[faces[f][0]];
+            const Vector3 normal = (points[faces[f][1]] - a).Cross(points[faces[f][2]] - a);
+            const Vector3 toOpposite = points[faces[f][3]] - a;
+            volumes[f] = normal.Dot(toOpposite);
+            originVolumes[f] = -normal.Dot(a);
+            // a flat tetrahedron has no inside, so all of its faces are tried.
+            const bool flat = volumes[f] * volumes[f] <= 1e-12f * normal.MagnitudeSquared() * toOpposite.MagnitudeSquared();
+            if (flat || originVolumes[f] * volumes[f] < 0.0f) {
+                outside = true;
+                GJKClosest face;
+                GJKTriangle(points, faces[f][0], faces[f][1], faces[f][2], face);
+                if (face.distanceSquared < out.distanceSquared) {
+                    out = face;
+                }
+            }
+        }
+        if (!outside) {
+            // the weight of each corner is the share of the volume of the tetrahedron on its side of the opposite face.
+            for (int f = 0; f < 4; ++f) {
+                out.indices[f] = f;
+                out.weights[faces[f][3]] = originVolumes[f] / volumes[f];
+            }
+            out.count = 4;
+            out.distanceSquared = 0.0f;
+        }
+    }
+}
+
+Vector3 GJK::Simplex::Reduce() {
+    GJKClosest closest;
+    switch (count) {
+    case 1:
+        closest.Set(points, 0);
+        break;
+    case 2:
+        GJKSegment(points, 0, 1, closest);
+        break;
+    case 3:
+        GJKTriangle(points, 0, 1, 2, closest);
+        break;
+    default:
+        GJKTetrahedron(points, closest);
+        break;
+    }
+    // the kept indices are in increasing order, so moving each down doesn't overwrite one still to be moved.
+    for (int p = 0; p < closest.count; ++p) {
+        const int from = closest.indices[p];
+        points[p] = points[from];
+        supportsA[p] = supportsA[from];
+        supportsB[p] = supportsB[from];
+        weights[p] = closest.weights[p];
+    }
+    count = closest.count;
+    Vector3 v = points[0] * weights[0];
+    for (int p = 1; p < count; ++p) {
+        v += points[p] * weights[p];
+    }
+    return v;
+}
+
+bool GJK::Simplex::Contains(const Vector3& point) const {
+    for (int p = 0; p < count; ++p) {
+        if (points[p].x == point.x && points[p].y == point.y && points[p].z == point.z) {
+            return true;
+        }
+    }
+    return false;
+}
+
+Vector3 GJK::Simplex::PointA() const {
+    Vector3 point = supportsA[0] * weights[0];
+    for (int p = 1; p < count; ++p) {
+        point += supportsA[p] * weights[p];
+    }
+    return point;
+}
+
+Vector3 GJK::Simplex::PointB() const {
+    Vector3 point = supportsB[0] * weights[0];
+    for (int p = 1; p < count; ++p) {
+        point += supportsB[p] * weights[p];
+    }
+    return point;
+}
+
+Vector3 GJK::Hull::Support(const Vector3& direction) const {
+    XO_ASSERT(count > 0, "xo-math GJK::Hull::Support needs at least one point.");
+    size_t i = 0, best = 0;
+    float bestDot = -std::numeric_limits<float>::infinity();
+#if defined(XO_SSE)
+    // Each lane keeps the furthest of the points it has seen and its index, in a float which is exact up to 2^24.
+    XO_ASSERT(count <= (1u << 24), "xo-math GJK::Hull::Support too many points.");
+    using namespace wide;
+    const Float dx = wide::Set(direction.x), dy = wide::Set(direction.y), dz = wide::Set(direction.z);
+    _XOSIMDALIGN32 float firstIndices[Width];
+    for (int lane = 0; lane < Width; ++lane) {
+        firstIndices[lane] = (float)lane;
+    }
+    Float laneDots = wide::Set(bestDot), laneIndices = Zero(), indices = Load(firstIndices);
+    const Float step = wide::Set((float)Width);
+    for (; i + Width <= count; i += Width) {
+        Float x, y, z, w;
+        LoadTransposed4(&points[i].x, 4, x, y, z, w);
+        const Float dots = MulAdd(z, dz, MulAdd(y, dy, Mul(x, dx)));
+        const Float further = CmpGt(dots, laneDots);
+        laneDots = Select(further, dots, laneDots);
+        laneIndices = Select(further, indices, laneIndices);
+        indices = Add(indices, step);
+    }
+    _XOSIMDALIGN32 float dots[Width], lanes[Width];
+    Store(dots, laneDots);
+    Store(lanes, laneIndices);
+    for (int lane = 0; lane < Width; ++lane) {
+        if (dots[lane] > bestDot) {
+            bestDot = dots[lane];
+            best = (size_t)lanes[lane];
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        const float dot = points[i].x * direction.x + points[i].y * direction.y + points[i].z * direction.z;
+        if (dot > bestDot) {
+            bestDot = dot;
+            best = i;
+        }
+    }
+    return points[best];
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,324 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+namespace
+{
+    // A level is split over threads only when each thread gets at least this many nodes.
+    const size_t HierarchyThreadShare = 1 << 11;
+
+    // Holds threads at the end of a level until all of them get there. Waiting threads yield rather than sleep, as a 
+    // level is over in microseconds.
+    class HierarchyBarrier {
+    public:
+        explicit HierarchyBarrier(unsigned count) : count(count), waiting(0), generation(0) {
+        }
+
+        void Wait() {
+            const unsigned current = generation.load(std::memory_order_acquire);
+            if (waiting.fetch_add(1, std::memory_order_acq_rel) + 1 == count) {
+                waiting.store(0, std::memory_order_relaxed);
+                generation.fetch_add(1, std::memory_order_release);
+            }
+            else {
+                while (generation.load(std::memory_order_acquire) == current) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+    private:
+        const unsigned count;
+        std::atomic<unsigned> waiting;
+        std::atomic<unsigned> generation;
+    };
+
+    // The world transform of a root, and of a node under parent.
+    template <class Matrix>
+    _XOINL void HierarchyRoot(const Matrix& local, Matrix& outWorld) {
+        outWorld = local;
+    }
+
+    template <class Matrix>
+    _XOINL void HierarchyRoot(const Transform& local, Matrix& outWorld) {
+        local.ToMatrix(outWorld);
+    }
+
+    template <class Matrix>
+    _XOINL void HierarchyChild(const Matrix& parent, const Matrix& local, Matrix& outWorld) {
+        Matrix::Multiply(parent, local, outWorld);
+    }
+
+    // The local transform is made a matrix in place of the world one, then multiplied in place.
+    template <class Matrix>
+    _XOINL void HierarchyChild(const Matrix& parent, const Transform& local, Matrix& outWorld) {
+        local.ToMatrix(outWorld);
+        Matrix::Multiply(parent, outWorld, outWorld);
+    }
+
+    // Computes the world transforms of nodes begin to end of level, in the order of Hierarchy::Nodes. When the nodes 
+    // are already in level order (Ordered) the i-th node is node i, and locals and worlds are read straight through.
+    template <bool Ordered, class Local, class World>
+    _XOINL void HierarchyLevel(const Hierarchy& hierarchy, size_t level, size_t begin, size_t end, 
+                               const Local* locals, World* outWorlds) {
+        const uint32_t* nodes = hierarchy.Nodes();
+        if (level == 0) {
+            for (size_t i = begin; i < end; ++i) {
+                const size_t node = Ordered ? i : nodes[i];
+                HierarchyRoot(locals[node], outWorlds[node]);
+            }
+        }
+        else {
+            const uint32_t* parents = hierarchy.Parents();
+            for (size_t i = begin; i < end; ++i) {
+                const size_t node = Ordered ? i : nodes[i];
+                HierarchyChild(outWorlds[parents[i]], locals[node], outWorlds[node]);
+            }
+        }
+    }
+
+    // Every thread walks every level. Levels wide enough give each thread a contiguous part and end on the barrier; 
+    // narrower ones are done by thread 0 alone, the others waiting for it before the next split level.
+    template <bool Ordered, class Local, class World>
+    void HierarchyUpdate(const Hierarchy& hierarchy, const Local* locals, World* outWorlds, unsigned threadCount) {
+        const uint32_t* offsets = hierarchy.LevelOffsets();
+        const size_t levels = hierarchy.LevelCount();
+        size_t widest = 0;
+        for (size_t level = 0; level < levels; ++level) {
+            widest = _XO_MAX(widest, (size_t)(offsets[level + 1] - offsets[level]));
+        }
+        const unsigned threads = xo_internal::ThreadCount(threadCount, widest, HierarchyThreadShare);
+        if (threads == 1) {
+            for (size_t level = 0; level < levels; ++level) {
+                HierarchyLevel<Ordered>(hierarchy, level, offsets[level], offsets[level + 1], locals, outWorlds);
+            }
+            return;
+        }
+
+        HierarchyBarrier barrier(threads);
+        xo_internal::Parallel(threads, [&](unsigned t) {
+            bool pending = false;
+            for (size_t level = 0; level < levels; ++level) {
+                const size_t begin = offsets[level], width = offsets[level + 1] - begin;
+                if (width < HierarchyThreadShare * threads) {
+                    if (t == 0) {
+                        HierarchyLevel<Ordered>(hierarchy, level, begin, begin + width, locals, outWorlds);
+                    }
+                    pending = true;
+                    continue;
+                }
+                if (pending) {
+                    barrier.Wait();
+                    pending = false;
+                }
+                HierarchyLevel<Ordered>(hierarchy, level, begin + width * t / threads, begin + width * (t + 1) / threads, locals, outWorlds);
+                barrier.Wait();
+            }
+        });
+    }
+
+    template <class Local, class World>
+    void HierarchyUpdate(const Hierarchy& hierarchy, const Local* locals, World* outWorlds, unsigned threadCount) {
+        if (hierarchy.IsLevelOrder()) {
+            HierarchyUpdate<true>(hierarchy, locals, outWorlds, threadCount);
+        }
+        else {
+            HierarchyUpdate<false>(hierarchy, locals, outWorlds, threadCount);
+        }
+    }
+}
+
+Hierarchy::Hierarchy() :
+    nodes(nullptr), parents(nullptr), levelOffsets(nullptr), size(0), capacity(0), levelCount(0), levelOrder(true)
+{
+}
+
+Hierarchy::Hierarchy(const uint32_t* parents, size_t count) :
+    nodes(nullptr), parents(nullptr), levelOffsets(nullptr), size(0), capacity(0), levelCount(0), levelOrder(true)
+{
+    Build(parents, count);
+}
+
+Hierarchy::Hierarchy(const Hierarchy& hierarchy) :
+    nodes(nullptr), parents(nullptr), levelOffsets(nullptr), size(0), capacity(0), levelCount(0), levelOrder(true)
+{
+    *this = hierarchy;
+}
+
+Hierarchy::Hierarchy(Hierarchy&& hierarchy) :
+    nodes(hierarchy.nodes), parents(hierarchy.parents), levelOffsets(hierarchy.levelOffsets), 
+    size(hierarchy.size), capacity(hierarchy.capacity), levelCount(hierarchy.levelCount), levelOrder(hierarchy.levelOrder)
+{
+    hierarchy.nodes = hierarchy.parents = hierarchy.levelOffsets = nullptr;
+    hierarchy.size = hierarchy.capacity = hierarchy.levelCount = 0;
+    hierarchy.levelOrder = true;
+}
+
+Hierarchy::~Hierarchy() {
+    Release();
+}
+
+void Hierarchy::Allocate(size_t count) {
+    // One block: the nodes, their parents, then room for as many levels as there are nodes.
+    nodes = (uint32_t*)XO_ALIGNED_MALLOC((count * 3 + 1) * sizeof(uint32_t), 64);
+    parents = nodes + count;
+    levelOffsets = parents + count;
+    capacity = count;
+}
+
+void Hierarchy::Release() {
+    if (nodes) {
+        XO_ALIGNED_FREE(nodes);
+    }
+    nodes = parents = levelOffsets = nullptr;
+    size = capacity = levelCount = 0;
+    levelOrder = true;
+}
+
+Hierarchy& Hierarchy::operator = (const Hierarchy& hierarchy) {
+    if (this != &hierarchy) {
+        Release();
+        if (hierarchy.nodes) {
+            Allocate(hierarchy.size);
+            size = hierarchy.size;
+            levelCount = hierarchy.levelCount;
+            levelOrder = hierarchy.levelOrder;
+            memcpy(nodes, hierarchy.nodes, size * sizeof(uint32_t));
+            memcpy(parents, hierarchy.parents, size * sizeof(uint32_t));
+            memcpy(levelOffsets, hierarchy.levelOffsets, (levelCount + 1) * sizeof(uint32_t));
+        }
+    }
+    return *this;
+}
+
+Hierarchy& Hierarchy::operator = (Hierarchy&& hierarchy) {
+    if (this != &hierarchy) {
+        Release();
+        nodes = hierarchy.nodes;
+        parents = hierarchy.parents;
+        levelOffsets = hierarchy.levelOffsets;
+        size = hierarchy.size;
+        capacity = hierarchy.capacity;
+        levelCount = hierarchy.levelCount;
+        levelOrder = hierarchy.levelOrder;
+        hierarchy.nodes = hierarchy.parents = hierarchy.levelOffsets = nullptr;
+        hierarchy.size = hierarchy.capacity = hierarchy.levelCount = 0;
+        hierarchy.levelOrder = true;
+    }
+    return *this;
+}
+
+void Hierarchy::Build(const uint32_t* parents, size_t count) {
+    XO_ASSERT(count < NoParent, "xo-math Hierarchy::Build has too many nodes.");
+    if (!nodes || count > capacity) {
+        Release();
+        Allocate(count);
+    }
+    size = count;
+    levelCount = 0;
+    levelOrder = true;
+    if (!count) {
+        levelOffsets[0] = 0;
+        return;
+    }
+
+    // The depth of each node, kept in this->parents until the nodes are sorted. Each walk up the tree stops at the 
+    // first node whose depth is known, then fills in the depths on the way, so every node is walked through once.
+    uint32_t* depths = this->parents;
+    for (size_t i = 0; i < count; ++i) {
+        depths[i] = NoParent;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t node = (uint32_t)i;
+        uint32_t steps = 0;
+        while (depths[node] == NoParent && parents[node] != NoParent) {
+            XO_ASSERT(parents[node] < count, "xo-math Hierarchy::Build parent index out of range.");
+            XO_ASSERT(steps < count, "xo-math Hierarchy::Build parents form a cycle.");
+            node = parents[node];
+            ++steps;
+        }
+        if (depths[node] == NoParent) {
+            depths[node] = 0;
+        }
+        uint32_t depth = depths[node] + steps;
+        for (uint32_t n = (uint32_t)i; n != node; n = parents[n]) {
+            depths[n] = depth--;
+        }
+        levelCount = _XO_MAX(levelCount, (size_t)depths[(uint32_t)i] + 1);
+    }
+
+    // A counting sort by depth, which keeps the nodes of a level in their order.
+    memset(levelOffsets, 0, (levelCount + 1) * sizeof(uint32_t));
+    for (size_t i = 0; i < count; ++i) {
+        ++levelOffsets[depths[i] + 1];
+    }
+    for (size_t level = 1; level <= levelCount; ++level) {
+        levelOffsets[level] += levelOffsets[level - 1];
+    }
+    for (size_t i = 0; i < count; ++i) {
+        nodes[levelOffsets[depths[i]]++] = (uint32_t)i;
+    }
+    for (size_t level = levelCount; level > 0; --level) {
+        levelOffsets[level] = levelOffsets[level - 1];
+    }
+    levelOffsets[0] = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        this->parents[i] = parents[nodes[i]];
+        levelOrder &= nodes[i] == i;
+    }
+}
+
+void Hierarchy::LevelOrderParents(uint32_t* outParents) const {
+    // The new index of each node, then its parent's.
+    uint32_t* indices = (uint32_t*)XO_ALIGNED_MALLOC(_XO_MAX(size, (size_t)1) * sizeof(uint32_t), 64);
+    for (size_t i = 0; i < size; ++i) {
+        indices[nodes[i]] = (uint32_t)i;
+    }
+    for (size_t i = 0; i < size; ++i) {
+        outParents[i] = parents[i] == NoParent ? NoParent : indices[parents[i]];
+    }
+    XO_ALIGNED_FREE(indices);
+}
+
+void Hierarchy::Update(const Matrix4x4* locals, Matrix4x4* outWorlds, unsigned threadCount) const {
+    HierarchyUpdate(*this, locals, outWorlds, threadCount);
+}
+
+void Hierarchy::Update(const Matrix3x4* locals, Matrix3x4* outWorlds, unsigned threadCount) const {
+    HierarchyUpdate(*this, locals, outWorlds, threadCount);
+}
+
+void Hierarchy::Update(const Transform* locals, Matrix3x4* outWorlds, unsigned threadCount) const {
+    HierarchyUpdate(*this, locals, outWorlds, threadCount);
+}
+
+void Hierarchy::Update(const Transform* locals, Matrix4x4* outWorlds, unsigned threadCount) const {
+    HierarchyUpdate(*this, locals, outWorlds, threadCount);
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,251 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+const Matrix3x4 Matrix3x4::Identity(Vector4(1.0f, 0.0f, 0.0f, 0.0f),
+                                    Vector4(0.0f, 1.0f, 0.0f, 0.0f),
+                                    Vector4(0.0f, 0.0f, 1.0f, 0.0f));
+
+namespace
+{
+#if defined(XO_SSE)
+    _XOINL __m128 Matrix3x4XYZ() {
+        return _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    }
+
+    // The cross product of the xyz of a and b, with a w of zero when theirs are.
+    _XOINL __m128 Matrix3x4Cross(__m128 a, __m128 b) {
+        const __m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+        const __m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+        const __m128 c = _mm_sub_ps(_mm_mul_ps(a, bYZX), _mm_mul_ps(aYZX, b));
+        return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+    }
+
+    // The sum of the four lanes of v, in every lane.
+    _XOINL __m128 Matrix3x4Sum(__m128 v) {
+        v = _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+    }
+
+    // The inverse of the rows a, b and c: the columns of the inverse of the 3x3 are the cross products of pairs of 
+    // rows over the determinant, and the translation is moved back through them. The result is transposed back into 
+    // rows. Returns false without writing anything when the determinant is zero and checkSingular is set.
+    _XOINL bool Matrix3x4Inverse(const Matrix3x4& m, Matrix3x4& outMatrix, bool checkSingular) {
+        const __m128 xyz = Matrix3x4XYZ();
+        const __m128 a = _mm_and_ps(m.r[0].xmm, xyz), b = _mm_and_ps(m.r[1].xmm, xyz), c = _mm_and_ps(m.r[2].xmm, xyz);
+        __m128 c0 = Matrix3x4Cross(b, c), c1 = Matrix3x4Cross(c, a), c2 = Matrix3x4Cross(a, b);
+        const __m128 determinant = Matrix3x4Sum(_mm_mul_ps(a, c0));
+        if (checkSingular && _mm_cvtss_f32(determinant) == 0.0f) {
+            return false;
+        }
+        const __m128 inverseDeterminant = _mm_div_ps(_mm_set1_ps(1.0f), determinant);
+        c0 = _mm_mul_ps(c0, inverseDeterminant);
+        c1 = _mm_mul_ps(c1, inverseDeterminant);
+        c2 = _mm_mul_ps(c2, inverseDeterminant);
+        const __m128 t0 = m.r[0].xmm, t1 = m.r[1].xmm, t2 = m.r[2].xmm;
+        __m128 t = _mm_mul_ps(c0, _mm_shuffle_ps(t0, t0, _MM_SHUFFLE(3, 3, 3, 3)));
+        t = sse::MulAdd(c1, _mm_shuffle_ps(t1, t1, _MM_SHUFFLE(3, 3, 3, 3)), t);
+        t = sse::MulAdd(c2, _mm_shuffle_ps(t2, t2, _MM_SHUFFLE(3, 3, 3, 3)), t);
+        t = _mm_sub_ps(_mm_setzero_ps(), t);
+        _MM_TRANSPOSE4_PS(c0, c1, c2, t);
+        outMatrix.r[0].xmm = c0;
+        outMatrix.r[1].xmm = c1;
+        outMatrix.r[2].xmm = c2;
+        return true;
+    }
+#else
+    bool Matrix3x4Inverse(const Matrix3x4& m, Matrix3x4& outMatrix, bool checkSingular) {
+        const Vector3 a(m.m00, m.m01, m.m02), b(m.m10, m.m11, m.m12), c(m.m20, m.m21, m.m22);
+        const Vector3 t(m.m03, m.m13, m.m23);
+        Vector3 c0 = b.Cross(c), c1 = c.Cross(a), c2 = a.Cross(b);
+        const float determinant = a.Dot(c0);
+        if (checkSingular && determinant == 0.0f) {
+            return false;
+        }
+        const float inverseDeterminant = 1.0f / determinant;
+        c0 *= inverseDeterminant;
+        c1 *= inverseDeterminant;
+        c2 *= inverseDeterminant;
+        const Vector3 translation = -(c0 * t.x + c1 * t.y + c2 * t.z);
+        outMatrix = Matrix3x4(c0.x, c1.x, c2.x, translation.x,
+                              c0.y, c1.y, c2.y, translation.y,
+                              c0.z, c1.z, c2.z, translation.z);
+        return true;
+    }
+#endif
+
+    // w is 1 for points and 0 for directions, so only points pick up the translation column.
+    template <bool IsPoint>
+    _XOINL void Matrix3x4TransformArray(const Matrix3x4& m, const Vector3* vecs, Vector3* outVecs, size_t count) {
+#if defined(XO_SSE)
+        // The missing bottom row transposes to a w of zero in every column, keeping the padding of the output at zero.
+        __m128 c0 = m.r[0].xmm, c1 = m.r[1].xmm, c2 = m.r[2].xmm, c3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        if (!IsPoint) {
+            c3 = _mm_setzero_ps();
+        }
+        for (size_t i = 0; i < count; ++i) {
+            __m128 v = vecs[i].xmm;
+            __m128 r = sse::MulAdd(_mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)), c0, c3);
+            r = sse::MulAdd(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), c1, r);
+            outVecs[i].xmm = sse::MulAdd(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), c2, r);
+        }
+#else
+        const float m00 = m.m00, m01 = m.m01, m02 = m.m02, m03 = IsPoint ? m.m03 : 0.0f;
+        const float m10 = m.m10, m11 = m.m11, m12 = m.m12, m13 = IsPoint ? m.m13 : 0.0f;
+        const float m20 = m.m20, m21 = m.m21, m22 = m.m22, m23 = IsPoint ? m.m23 : 0.0f;
+        for (size_t i = 0; i < count; ++i) {
+            const float x = vecs[i].x, y = vecs[i].y, z = vecs[i].z;
+            outVecs[i].x = m00 * x + m01 * y + m02 * z + m03;
+            outVecs[i].y = m10 * x + m11 * y + m12 * z + m13;
+            outVecs[i].z = m20 * x + m21 * y + m22 * z + m23;
+        }
+#endif
+    }
+}
+
+Matrix3x4::Matrix3x4() {
+}
+
+Matrix3x4::Matrix3x4(float m00, float m01, float m02, float m03, 
+                     float m10, float m11, float m12, float m13, 
+                     float m20, float m21, float m22, float m23) 
+{
+    r[0].Set(m00, m01, m02, m03);
+    r[1].Set(m10, m11, m12, m13);
+    r[2].Set(m20, m21, m22, m23);
+}
+
+Matrix3x4::Matrix3x4(const Matrix3x4& m) {
+    r[0].Set(m.r[0]);
+    r[1].Set(m.r[1]);
+    r[2].Set(m.r[2]);
+}
+
+Matrix3x4::Matrix3x4(const Vector4& r0, const Vector4& r1, const Vector4& r2) {
+    r[0].Set(r0);
+    r[1].Set(r1);
+    r[2].Set(r2);
+}
+
+Matrix3x4::Matrix3x4(const Vector3& r0, const Vector3& r1, const Vector3& r2, const Vector3& translation) {
+    r[0].Set(r0.x, r0.y, r0.z, translation.x);
+    r[1].Set(r1.x, r1.y, r1.z, translation.y);
+    r[2].Set(r2.x, r2.y, r2.z, translation.z);
+}
+
+Matrix3x4::Matrix3x4(const Matrix4x4& m) {
+    r[0].Set(m.r[0]);
+    r[1].Set(m.r[1]);
+    r[2].Set(m.r[2]);
+}
+
+float Matrix3x4::Determinant() const {
+    return m00 * (m11 * m22 - m12 * m21) - m01 * (m10 * m22 - m12 * m20) + m02 * (m10 * m21 - m11 * m20);
+}
+
+void Matrix3x4::MakeInverse() {
+    Matrix3x4Inverse(*this, *this, false);
+}
+
+bool Matrix3x4::TryMakeInverse() {
+    return Matrix3x4Inverse(*this, *this, true);
+}
+
+void Matrix3x4::MakeInverseRigid() {
+#if defined(XO_SSE)
+    const __m128 xyz = Matrix3x4XYZ();
+    const __m128 r0 = r[0].xmm, r1 = r[1].xmm, r2 = r[2].xmm;
+    __m128 a = _mm_and_ps(r0, xyz), b = _mm_and_ps(r1, xyz), c = _mm_and_ps(r2, xyz);
+    // The rows of the rotation are the columns of its inverse, the transpose.
+    __m128 t = _mm_mul_ps(a, _mm_shuffle_ps(r0, r0, _MM_SHUFFLE(3, 3, 3, 3)));
+    t = sse::MulAdd(b, _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(3, 3, 3, 3)), t);
+    t = sse::MulAdd(c, _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3, 3, 3, 3)), t);
+    t = _mm_sub_ps(_mm_setzero_ps(), t);
+    _MM_TRANSPOSE4_PS(a, b, c, t);
+    r[0].xmm = a;
+    r[1].xmm = b;
+    r[2].xmm = c;
+#else
+    const Vector3 t = GetTranslation();
+    *this = Matrix3x4(m00, m10, m20, -(m00 * t.x + m10 * t.y + m20 * t.z),
+                      m01, m11, m21, -(m01 * t.x + m11 * t.y + m21 * t.z),
+                      m02, m12, m22, -(m02 * t.x + m12 * t.y + m22 * t.z));
+#endif
+}
+
+const Matrix3x4& Matrix3x4::TransformPoints(const Vector3* vecs, Vector3* outVecs, size_t count) const {
+    Matrix3x4TransformArray<true>(*this, vecs, outVecs, count);
+    return *this;
+}
+
+const Matrix3x4& Matrix3x4::TransformDirections(const Vector3* vecs, Vector3* outVecs, size_t count) const {
+    Matrix3x4TransformArray<false>(*this, vecs, outVecs, count);
+    return *this;
+}
+
+void Matrix3x4::MultiplyArray(const Matrix3x4* a, const Matrix3x4* b, Matrix3x4* outMatrices, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        Multiply(a[i], b[i], outMatrices[i]);
+    }
+}
+
+void Matrix3x4::MultiplyArray(const Matrix3x4& a, const Matrix3x4* b, Matrix3x4* outMatrices, size_t count) {
+#if defined(XO_SSE)
+    // Each element of a is splat once, and its translation column masked once.
+    const __m128 translation = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+    const __m128 a0 = a.r[0].xmm, a1 = a.r[1].xmm, a2 = a.r[2].xmm;
+    const __m128 a0x = _mm_shuffle_ps(a0, a0, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m128 a0y = _mm_shuffle_ps(a0, a0, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 a0z = _mm_shuffle_ps(a0, a0, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m128 a1x = _mm_shuffle_ps(a1, a1, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m128 a1y = _mm_shuffle_ps(a1, a1, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 a1z = _mm_shuffle_ps(a1, a1, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m128 a2x = _mm_shuffle_ps(a2, a2, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m128 a2y = _mm_shuffle_ps(a2, a2, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 a2z = _mm_shuffle_ps(a2, a2, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m128 a0w = _mm_and_ps(a0, translation), a1w = _mm_and_ps(a1, translation), a2w = _mm_and_ps(a2, translation);
+    for (size_t i = 0; i < count; ++i) {
+        const __m128 b0 = b[i].r[0].xmm, b1 = b[i].r[1].xmm, b2 = b[i].r[2].xmm;
+        outMatrices[i].r[0].xmm = sse::MulAdd(a0z, b2, sse::MulAdd(a0y, b1, sse::MulAdd(a0x, b0, a0w)));
+        outMatrices[i].r[1].xmm = sse::MulAdd(a1z, b2, sse::MulAdd(a1y, b1, sse::MulAdd(a1x, b0, a1w)));
+        outMatrices[i].r[2].xmm = sse::MulAdd(a2z, b2, sse::MulAdd(a2y, b1, sse::MulAdd(a2x, b0, a2w)));
+    }
+#else
+    for (size_t i = 0; i < count; ++i) {
+        Multiply(a, b[i], outMatrices[i]);
+    }
+#endif
+}
+
+void Matrix3x4::InverseArray(const Matrix3x4* matrices, Matrix3x4* outMatrices, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        Matrix3x4Inverse(matrices[i], outMatrices[i], false);
+    }
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -91,6 +91,13 @@ Matrix4x4::Matrix4x4(const Vector3& r0, const Vector3& r1, const Vector3& r2)
 	r[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
 }
 
+Matrix4x4::Matrix4x4(const Matrix3x4& m) {
+    r[0].Set(m.r[0]);
+    r[1].Set(m.r[1]);
+    r[2].Set(m.r[2]);
+    r[3].Set(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
 Matrix4x4::Matrix4x4(const class Quaternion& q) {
     Vector4* v4 = (Vector4*)&q;
     Vector4 q2 = *v4 + *v4;
@@ -376,6 +383,340 @@ const Matrix4x4& Matrix4x4::Transform(Vector4& v) const {
     return *this;
 }
 
+namespace
+{
+    // w is 1 for points and 0 for directions, so only points pick up the translation column.
+    template <bool IsPoint>
+    _XOINL void TransformVector3Array(const Matrix4x4& m, const Vector3* vecs, Vector3* outVecs, size_t count) {
+#if defined(XO_SSE)
+        __m128 c0 = m[0].xmm, c1 = m[1].xmm, c2 = m[2].xmm, c3 = m[3].xmm;
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        // Dropping the bottom row keeps the padding of every output vector at zero.
+        const __m128 mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+        c0 = _mm_and_ps(c0, mask);
+        c1 = _mm_and_ps(c1, mask);
+        c2 = _mm_and_ps(c2, mask);
+        c3 = IsPoint ? _mm_and_ps(c3, mask) : _mm_setzero_ps();
+        for (size_t i = 0; i < count; ++i) {
+            __m128 v = vecs[i].xmm;
+            __m128 r = sse::MulAdd(_mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)), c0, c3);
+            r = sse::MulAdd(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), c1, r);
+            outVecs[i].xmm = sse::MulAdd(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), c2, r);
+        }
+#else
+        const float m00 = m(0, 0), m01 = m(0, 1), m02 = m(0, 2), m03 = IsPoint ? m(0, 3) : 0.0f;
+        const float m10 = m(1, 0), m11 = m(1, 1), m12 = m(1, 2), m13 = IsPoint ? m(1, 3) : 0.0f;
+        const float m20 = m(2, 0), m21 = m(2, 1), m22 = m(2, 2), m23 = IsPoint ? m(2, 3) : 0.0f;
+        for (size_t i = 0; i < count; ++i) {
+            const float x = vecs[i].x, y = vecs[i].y, z = vecs[i].z;
+            outVecs[i].x = m00 * x + m01 * y + m02 * z + m03;
+            outVecs[i].y = m10 * x + m11 * y + m12 * z + m13;
+            outVecs[i].z = m20 * x + m21 * y + m22 * z + m23;
+        }
+#endif
+    }
+
+    template <bool IsPoint>
+    _XOINL void TransformPackedArray(const Matrix4x4& m, const float* xyz, float* outXyz, size_t count) {
+        const float m00 = m(0, 0), m01 = m(0, 1), m02 = m(0, 2), m03 = IsPoint ? m(0, 3) : 0.0f;
+        const float m10 = m(1, 0), m11 = m(1, 1), m12 = m(1, 2), m13 = IsPoint ? m(1, 3) : 0.0f;
+        const float m20 = m(2, 0), m21 = m(2, 1), m22 = m(2, 2), m23 = IsPoint ? m(2, 3) : 0.0f;
+        size_t i = 0;
+#if defined(XO_SSE)
+        // Four points are three registers: x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+        // They are shuffled into x, y and z registers, transformed with broadcast matrix elements, then shuffled back.
+        const __m128 s00 = _mm_set1_ps(m00), s01 = _mm_set1_ps(m01), s02 = _mm_set1_ps(m02), s03 = _mm_set1_ps(m03);
+        const __m128 s10 = _mm_set1_ps(m10), s11 = _mm_set1_ps(m11), s12 = _mm_set1_ps(m12), s13 = _mm_set1_ps(m13);
+        const __m128 s20 = _mm_set1_ps(m20), s21 = _mm_set1_ps(m21), s22 = _mm_set1_ps(m22), s23 = _mm_set1_ps(m23);
+        for (; i + 4 <= count; i += 4) {
+            const float* in = xyz + i * 3;
+            float* out = outXyz + i * 3;
+            __m128 a = _mm_loadu_ps(in);
+            __m128 b = _mm_loadu_ps(in + 4);
+            __m128 c = _mm_loadu_ps(in + 8);
+
+            __m128 t = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+            __m128 x = _mm_shuffle_ps(a, t, _MM_SHUFFLE(2, 0, 3, 0));
+            t = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+            __m128 u = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+            __m128 y = _mm_shuffle_ps(t, u, _MM_SHUFFLE(2, 0, 2, 0));
+            t = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+            u = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0));
+            __m128 z = _mm_shuffle_ps(t, u, _MM_SHUFFLE(2, 0, 2, 0));
+
+            __m128 rx = sse::MulAdd(s02, z, sse::MulAdd(s01, y, sse::MulAdd(s00, x, s03)));
+            __m128 ry = sse::MulAdd(s12, z, sse::MulAdd(s11, y, sse::MulAdd(s10, x, s13)));
+            __m128 rz = sse::MulAdd(s22, z, sse::MulAdd(s21, y, sse::MulAdd(s20, x, s23)));
+
+            t = _mm_shuffle_ps(rx, ry, _MM_SHUFFLE(0, 0, 0, 0));
+            u = _mm_shuffle_ps(rz, rx, _MM_SHUFFLE(1, 1, 0, 0));
+            a = _mm_shuffle_ps(t, u, _MM_SHUFFLE(2, 0, 2, 0));
+            t = _mm_shuffle_ps(ry, rz, _MM_SHUFFLE(1, 1, 1, 1));
+            u = _mm_shuffle_ps(rx, ry, _MM_SHUFFLE(2, 2, 2, 2));
+            b = _mm_shuffle_ps(t, u, _MM_SHUFFLE(2, 0, 2, 0));
+            t = _mm_shuffle_ps(rz, rx, _MM_SHUFFLE(3, 3, 2, 2));
+            u = _mm_shuffle_ps(ry, rz, _MM_SHUFFLE(3, 3, 3, 3));
+            c = _mm_shuffle_ps(t, u, _MM_SHUFFLE(2, 0, 2, 0));
+
+            _mm_storeu_ps(out, a);
+            _mm_storeu_ps(out + 4, b);
+            _mm_storeu_ps(out + 8, c);
+        }
+#endif
+        for (; i < count; ++i) {
+            const float x = xyz[i * 3], y = xyz[i * 3 + 1], z = xyz[i * 3 + 2];
+            outXyz[i * 3]     = m00 * x + m01 * y + m02 * z + m03;
+            outXyz[i * 3 + 1] = m10 * x + m11 * y + m12 * z + m13;
+            outXyz[i * 3 + 2] = m20 * x + m21 * y + m22 * z + m23;
+        }
+    }
+}
+
+const Matrix4x4& Matrix4x4::TransformPoints(const Vector3* vecs, Vector3* outVecs, size_t count) const {
+    TransformVector3Array<true>(*this, vecs, outVecs, count);
+    return *this;
+}
+
+const Matrix4x4& Matrix4x4::TransformPoints(const float* xyz, float* outXyz, size_t count) const {
+    TransformPackedArray<true>(*this, xyz, outXyz, count);
+    return *this;
+}
+
+const Matrix4x4& Matrix4x4::TransformDirections(const Vector3* vecs, Vector3* outVecs, size_t count) const {
+    TransformVector3Array<false>(*this, vecs, outVecs, count);
+    return *this;
+}
+
+const Matrix4x4& Matrix4x4::TransformDirections(const float* xyz, float* outXyz, size_t count) const {
+    TransformPackedArray<false>(*this, xyz, outXyz, count);
+    return *this;
+}
+
+void Matrix4x4::MultiplyArray(const Matrix4x4* a, const Matrix4x4* b, Matrix4x4* outMatrices, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        Multiply(a[i], b[i], outMatrices[i]);
+    }
+}
+
+void Matrix4x4::MultiplyArray(const Matrix4x4& a, const Matrix4x4* b, Matrix4x4* outMatrices, size_t count) {
+#if defined(XO_AVX)
+    // Each element of a is splat once, two rows to a register.
+    const __m256 a01 = _mm256_loadu_ps(a.r[0].f);
+    const __m256 a23 = _mm256_loadu_ps(a.r[2].f);
+    const __m256 a01x = _mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m256 a01y = _mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m256 a01z = _mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m256 a01w = _mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(3, 3, 3, 3));
+    const __m256 a23x = _mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m256 a23y = _mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m256 a23z = _mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m256 a23w = _mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(3, 3, 3, 3));
+    for (size_t i = 0; i < count; ++i) {
+        const __m256 b0 = _mm256_broadcast_ps(&b[i].r[0].xmm);
+        const __m256 b1 = _mm256_broadcast_ps(&b[i].r[1].xmm);
+        const __m256 b2 = _mm256_broadcast_ps(&b[i].r[2].xmm);
+        const __m256 b3 = _mm256_broadcast_ps(&b[i].r[3].xmm);
+        __m256 r01 = _mm256_mul_ps(a01x, b0);
+        __m256 r23 = _mm256_mul_ps(a23x, b0);
+        r01 = wide::MulAdd(a01y, b1, r01);
+        r23 = wide::MulAdd(a23y, b1, r23);
+        r01 = wide::MulAdd(a01z, b2, r01);
+        r23 = wide::MulAdd(a23z, b2, r23);
+        r01 = wide::MulAdd(a01w, b3, r01);
+        r23 = wide::MulAdd(a23w, b3, r23);
+        _mm256_storeu_ps(outMatrices[i].r[0].f, r01);
+        _mm256_storeu_ps(outMatrices[i].r[2].f, r23);
+    }
+#else
+    // a is copied so that writing outMatrices can never change it.
+    const Matrix4x4 parent(a);
+    for (size_t i = 0; i < count; ++i) {
+        Multiply(parent, b[i], outMatrices[i]);
+    }
+#endif
+}
+
+void Matrix4x4::MultiplyArray(const Matrix4x4* a, const Matrix4x4& b, Matrix4x4* outMatrices, size_t count) {
+    const Matrix4x4 right(b);
+    for (size_t i = 0; i < count; ++i) {
+        Multiply(a[i], right, outMatrices[i]);
+    }
+}
+
+namespace
+{
+    // Element k of every matrix in a group of wide::Width matrices is held in lanes[k], one matrix per lane.
+    _XOINL void LoadMatrixLanes(const Matrix4x4* m, wide::Float lanes[16]) {
+        for (int r = 0; r < 4; ++r) {
+            wide::LoadTransposed4(m->r[r].f, 16, lanes[r * 4], lanes[r * 4 + 1], lanes[r * 4 + 2], lanes[r * 4 + 3]);
+        }
+    }
+
+    _XOINL void StoreMatrixLanes(const wide::Float lanes[16], Matrix4x4* m) {
+        for (int r = 0; r < 4; ++r) {
+            wide::StoreTransposed4(m->r[r].f, 16, lanes[r * 4], lanes[r * 4 + 1], lanes[r * 4 + 2], lanes[r * 4 + 3]);
+        }
+    }
+
+    // (a * b) - (c * d)
+    _XOINL wide::Float MulSubMul(wide::Float a, wide::Float b, wide::Float c, wide::Float d) {
+        return wide::NegMulAdd(c, d, wide::Mul(a, b));
+    }
+
+    // Full inverse by cofactor expansion, where each cofactor is built from the 2x2 determinants of the top two and 
+    // bottom two rows. Returns the determinants.
+    _XOINL wide::Float InverseGeneralLanes(const wide::Float a[16], wide::Float o[16]) {
+        using namespace wide;
+        const Float s0 = MulSubMul(a[0], a[5], a[4], a[1]);
+        const Float s1 = MulSubMul(a[0], a[6], a[4], a[2]);
+        const Float s2 = MulSubMul(a[0], a[7], a[4], a[3]);
+        const Float s3 = MulSubMul(a[1], a[6], a[5], a[2]);
+        const Float s4 = MulSubMul(a[1], a[7], a[5], a[3]);
+        const Float s5 = MulSubMul(a[2], a[7], a[6], a[3]);
+        const Float c5 = MulSubMul(a[10], a[15], a[14], a[11]);
+        const Float c4 = MulSubMul(a[9], a[15], a[13], a[11]);
+        const Float c3 = MulSubMul(a[9], a[14], a[13], a[10]);
+        const Float c2 = MulSubMul(a[8], a[15], a[12], a[11]);
+        const Float c1 = MulSubMul(a[8], a[14], a[12], a[10]);
+        const Float c0 = MulSubMul(a[8], a[13], a[12], a[9]);
+
+        const Float det = Add(Add(MulSubMul(s0, c5, s1, c4), MulSubMul(s2, c3, Negate(s3), c2)), MulSubMul(s5, c0, s4, c1));
+        const Float inv = Div(Set(1.0f), det);
+
+        o[0]  = Mul(MulAdd(a[7], c3, MulSubMul(a[5], c5, a[6], c4)), inv);
+        o[1]  = Mul(NegMulAdd(a[3], c3, MulSubMul(a[2], c4, a[1], c5)), inv);
+        o[2]  = Mul(MulAdd(a[15], s3, MulSubMul(a[13], s5, a[14], s4)), inv);
+        o[3]  = Mul(NegMulAdd(a[11], s3, MulSubMul(a[10], s4, a[9], s5)), inv);
+        o[4]  = Mul(NegMulAdd(a[7], c1, MulSubMul(a[6], c2, a[4], c5)), inv);
+        o[5]  = Mul(MulAdd(a[3], c1, MulSubMul(a[0], c5, a[2], c2)), inv);
+        o[6]  = Mul(NegMulAdd(a[15], s1, MulSubMul(a[14], s2, a[12], s5)), inv);
+        o[7]  = Mul(MulAdd(a[11], s1, MulSubMul(a[8], s5, a[10], s2)), inv);
+        o[8]  = Mul(MulAdd(a[7], c0, MulSubMul(a[4], c4, a[5], c2)), inv);
+        o[9]  = Mul(NegMulAdd(a[3], c0, MulSubMul(a[1], c2, a[0], c4)), inv);
+        o[10] = Mul(MulAdd(a[15], s0, MulSubMul(a[12], s4, a[13], s2)), inv);
+        o[11] = Mul(NegMulAdd(a[11], s0, MulSubMul(a[9], s2, a[8], s4)), inv);
+        o[12] = Mul(NegMulAdd(a[6], c0, MulSubMul(a[5], c1, a[4], c3)), inv);
+        o[13] = Mul(MulAdd(a[2], c0, MulSubMul(a[0], c3, a[1], c1)), inv);
+        o[14] = Mul(NegMulAdd(a[14], s0, MulSubMul(a[13], s1, a[12], s3)), inv);
+        o[15] = Mul(MulAdd(a[10], s0, MulSubMul(a[8], s3, a[9], s1)), inv);
+        return det;
+    }
+
+    // Inverse of an affine matrix: the upper 3x3 by cofactors, then the translation moved back through it.
+    // The determinant of the 3x3 is the determinant of the whole matrix.
+    _XOINL wide::Float InverseAffineLanes(const wide::Float a[16], wide::Float o[16]) {
+        using namespace wide;
+        const Float c00 = MulSubMul(a[5], a[10], a[6], a[9]);
+        const Float c01 = MulSubMul(a[6], a[8], a[4], a[10]);
+        const Float c02 = MulSubMul(a[4], a[9], a[5], a[8]);
+        const Float det = MulAdd(a[2], c02, MulAdd(a[1], c01, Mul(a[0], c00)));
+        const Float inv = Div(Set(1.0f), det);
+
+        o[0]  = Mul(c00, inv);
+        o[1]  = Mul(MulSubMul(a[2], a[9], a[1], a[10]), inv);
+        o[2]  = Mul(MulSubMul(a[1], a[6], a[2], a[5]), inv);
+        o[4]  = Mul(c01, inv);
+        o[5]  = Mul(MulSubMul(a[0], a[10], a[2], a[8]), inv);
+        o[6]  = Mul(MulSubMul(a[2], a[4], a[0], a[6]), inv);
+        o[8]  = Mul(c02, inv);
+        o[9]  = Mul(MulSubMul(a[1], a[8], a[0], a[9]), inv);
+        o[10] = Mul(MulSubMul(a[0], a[5], a[1], a[4]), inv);
+        o[3]  = Negate(MulAdd(o[2], a[11], MulAdd(o[1], a[7], Mul(o[0], a[3]))));
+        o[7]  = Negate(MulAdd(o[6], a[11], MulAdd(o[5], a[7], Mul(o[4], a[3]))));
+        o[11] = Negate(MulAdd(o[10], a[11], MulAdd(o[9], a[7], Mul(o[8], a[3]))));
+        o[12] = o[13] = o[14] = Zero();
+        o[15] = Set(1.0f);
+        return det;
+    }
+
+    _XOINL void InverseRigidLanes(const wide::Float a[16], wide::Float o[16]) {
+        using namespace wide;
+        o[0] = a[0]; o[1] = a[4]; o[2]  = a[8];
+        o[4] = a[1]; o[5] = a[5]; o[6]  = a[9];
+        o[8] = a[2]; o[9] = a[6]; o[10] = a[10];
+        o[3]  = Negate(MulAdd(a[8], a[11], MulAdd(a[4], a[7], Mul(a[0], a[3]))));
+        o[7]  = Negate(MulAdd(a[9], a[11], MulAdd(a[5], a[7], Mul(a[1], a[3]))));
+        o[11] = Negate(MulAdd(a[10], a[11], MulAdd(a[6], a[7], Mul(a[2], a[3]))));
+        o[12] = o[13] = o[14] = Zero();
+        o[15] = Set(1.0f);
+    }
+
+    enum InverseKind { InverseGeneral, InverseTry, InverseRigid };
+
+    // Inverts exactly wide::Width matrices, returning one bit per singular matrix when kind is InverseTry.
+    template <InverseKind Kind>
+    _XOINL int InverseMatrixGroup(const Matrix4x4* matrices, Matrix4x4* outMatrices) {
+        using namespace wide;
+        Float a[16], o[16];
+        LoadMatrixLanes(matrices, a);
+        int singular = 0;
+        if (Kind == InverseRigid) {
+            InverseRigidLanes(a, o);
+        }
+        else {
+            const Float affine = And(And(CmpEq(a[12], Zero()), CmpEq(a[13], Zero())), 
+                                     And(CmpEq(a[14], Zero()), CmpEq(a[15], Set(1.0f))));
+            const Float det = MoveMask(affine) == MoveMask(True()) ? InverseAffineLanes(a, o) : InverseGeneralLanes(a, o);
+            if (Kind == InverseTry) {
+                const Float isSingular = CmpEq(det, Zero());
+                singular = MoveMask(isSingular);
+                if (singular) {
+                    for (int k = 0; k < 16; ++k) {
+                        o[k] = Select(isSingular, a[k], o[k]);
+                    }
+                }
+            }
+        }
+        StoreMatrixLanes(o, outMatrices);
+        return singular;
+    }
+
+    template <InverseKind Kind>
+    _XOINL bool InverseMatrixArray(const Matrix4x4* matrices, Matrix4x4* outMatrices, size_t count, uint32_t* outSingularMask) {
+        if (outSingularMask) {
+            memset(outSingularMask, 0, ((count + 31) / 32) * sizeof(uint32_t));
+        }
+        bool allInverted = true;
+        for (size_t i = 0; i < count; i += wide::Width) {
+            int singular;
+            if (i + wide::Width <= count) {
+                singular = InverseMatrixGroup<Kind>(matrices + i, outMatrices + i);
+            }
+            else {
+                // The last partial group is padded out with identity matrices.
+                Matrix4x4 in[wide::Width], out[wide::Width];
+                for (size_t j = 0; j < wide::Width; ++j) {
+                    in[j] = i + j < count ? matrices[i + j] : Matrix4x4::Identity;
+                }
+                singular = InverseMatrixGroup<Kind>(in, out);
+                for (size_t j = 0; i + j < count; ++j) {
+                    outMatrices[i + j] = out[j];
+                }
+            }
+            if (singular) {
+                allInverted = false;
+                if (outSingularMask) {
+                    // wide::Width divides 32, so a group never straddles two mask values.
+                    outSingularMask[i / 32] |= (uint32_t)singular << (i % 32);
+                }
+            }
+        }
+        return allInverted;
+    }
+}
+
+void Matrix4x4::InverseArray(const Matrix4x4* matrices, Matrix4x4* outMatrices, size_t count) {
+    InverseMatrixArray<InverseGeneral>(matrices, outMatrices, count, nullptr);
+}
+
+bool Matrix4x4::TryInverseArray(const Matrix4x4* matrices, Matrix4x4* outMatrices, size_t count, uint32_t* outSingularMask) {
+    return InverseMatrixArray<InverseTry>(matrices, outMatrices, count, outSingularMask);
+}
+
+void Matrix4x4::InverseRigidArray(const Matrix4x4* matrices, Matrix4x4* outMatrices, size_t count) {
+    InverseMatrixArray<InverseRigid>(matrices, outMatrices, count, nullptr);
+}
+
 void Matrix4x4::Scale(float xyz, Matrix4x4& m) {
     m[0].Set(xyz,  0.0f, 0.0f, 0.0f);
     m[1].Set(0.0f, xyz,  0.0f, 0.0f);
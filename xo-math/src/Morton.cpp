@@ -0,0 +1,458 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+namespace
+{
+    // Each thread sorts at least this many keys.
+    const size_t MortonThreadShare = 1 << 16;
+    // The sort takes this many bits of the keys per pass: 3 passes for 32 bit keys and 6 for 64 bit keys, with the 
+    // counts of a pass small enough to stay in the L1 cache.
+    const int MortonDigitBits = 11;
+    const size_t MortonBuckets = (size_t)1 << MortonDigitBits;
+
+    // Moves bit i of the low 10 bits of x to bit 3i, a shift and a mask at a time.
+    _XOINL uint32_t MortonSpread10(uint32_t x) {
+        x &= 0x3ff;
+        x = (x | (x << 16)) & 0x030000ff;
+        x = (x | (x << 8)) & 0x0300f00f;
+        x = (x | (x << 4)) & 0x030c30c3;
+        x = (x | (x << 2)) & 0x09249249;
+        return x;
+    }
+
+    // The reverse of MortonSpread10, ignoring the bits in between.
+    _XOINL uint32_t MortonCompact10(uint32_t x) {
+        x &= 0x09249249;
+        x = (x | (x >> 2)) & 0x030c30c3;
+        x = (x | (x >> 4)) & 0x0300f00f;
+        x = (x | (x >> 8)) & 0x030000ff;
+        x = (x | (x >> 16)) & 0x3ff;
+        return x;
+    }
+
+    // Moves bit i of the low 21 bits of x to bit 3i.
+    _XOINL uint64_t MortonSpread21(uint64_t x) {
+#if defined(XO_BMI2)
+        return _pdep_u64(x, 0x1249249249249249ull);
+#else
+        x &= 0x1fffff;
+        x = (x | (x << 32)) & 0x001f00000000ffffull;
+        x = (x | (x << 16)) & 0x001f0000ff0000ffull;
+        x = (x | (x << 8)) & 0x100f00f00f00f00full;
+        x = (x | (x << 4)) & 0x10c30c30c30c30c3ull;
+        x = (x | (x << 2)) & 0x1249249249249249ull;
+        return x;
+#endif
+    }
+
+    // The reverse of MortonSpread21, ignoring the bits in between.
+    _XOINL uint32_t MortonCompact21(uint64_t x) {
+#if defined(XO_BMI2)
+        return (uint32_t)_pext_u64(x, 0x1249249249249249ull);
+#else
+        x &= 0x1249249249249249ull;
+        x = (x | (x >> 2)) & 0x10c30c30c30c30c3ull;
+        x = (x | (x >> 4)) & 0x100f00f00f00f00full;
+        x = (x | (x >> 8)) & 0x001f0000ff0000ffull;
+        x = (x | (x >> 16)) & 0x001f00000000ffffull;
+        x = (x | (x >> 32)) & 0x1fffff;
+        return (uint32_t)x;
+#endif
+    }
+
+    // Maps positions in bounds to the cells of a grid of max + 1 cells a side. The scalar and wide versions do the same 
+    // operations, so a point gets the same cell either way.
+    struct MortonGrid {
+        MortonGrid(const AABB& bounds, uint32_t max) : min(bounds.min), max((float)max) {
+            const Vector3 extent = bounds.max - bounds.min;
+            const float cells = (float)max + 1.0f;
+            for (int axis = 0; axis < 3; ++axis) {
+                scale[axis] = extent[axis] > 0.0f ? cells / extent[axis] : 0.0f;
+                wideMin[axis] = wide::Set(min[axis]);
+                wideScale[axis] = wide::Set(scale[axis]);
+            }
+            wideMax = wide::Set(this->max);
+        }
+        // NaN positions land in cell 0.
+        uint32_t Cell(float f, int axis) const {
+            const float cell = (f - min[axis]) * scale[axis];
+            return (uint32_t)(cell > 0.0f ? (cell < max ? cell : max) : 0.0f);
+        }
+        wide::Float WideCell(wide::Float f, int axis) const {
+            return wide::Min(wide::Max(wide::Mul(wide::Sub(f, wideMin[axis]), wideScale[axis]), wide::Zero()), wideMax);
+        }
+        Vector3 min, scale;
+        float max;
+        wide::Float wideMin[3], wideScale[3], wideMax;
+    };
+
+    _XOINL void MortonCode(uint32_t x, uint32_t y, uint32_t z, uint32_t* outCode) { *outCode = Morton::Encode30(x, y, z); }
+    _XOINL void MortonCode(uint32_t x, uint32_t y, uint32_t z, uint64_t* outCode) { *outCode = Morton::Encode63(x, y, z); }
+
+    // MortonStore writes the codes of wide::Width cells, given as whole floats, picking 30 or 63 bit codes by the type 
+    // of outCodes.
+#if defined(XO_SSE2)
+    _XOINL __m128i MortonSpread10(__m128i x) {
+        x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi32(x, 16)), _mm_set1_epi32(0x030000ff));
+        x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi32(x, 8)), _mm_set1_epi32(0x0300f00f));
+        x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi32(x, 4)), _mm_set1_epi32(0x030c30c3));
+        x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi32(x, 2)), _mm_set1_epi32(0x09249249));
+        return x;
+    }
+
+    _XOINL void MortonStore(__m128 x, __m128 y, __m128 z, uint32_t* outCodes) {
+        const __m128i code = _mm_or_si128(MortonSpread10(_mm_cvttps_epi32(x)), 
+                             _mm_or_si128(_mm_slli_epi32(MortonSpread10(_mm_cvttps_epi32(y)), 1), 
+                                          _mm_slli_epi32(MortonSpread10(_mm_cvttps_epi32(z)), 2)));
+        _mm_storeu_si128((__m128i*)outCodes, code);
+    }
+#endif
+
+#if defined(XO_SSE2) && !defined(XO_BMI2)
+    // Two cells per register, one in each 64 bit lane.
+    _XOINL __m128i MortonSpread21(__m128i x) {
+        x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi64(x, 32)), _mm_set1_epi64x(0x001f00000000ffffll));
+        x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi64(x, 16)), _mm_set1_epi64x(0x001f0000ff0000ffll));
+        x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi64(x, 8)), _mm_set1_epi64x(0x100f00f00f00f00fll));
+        x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi64(x, 4)), _mm_set1_epi64x(0x10c30c30c30c30c3ll));
+        x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi64(x, 2)), _mm_set1_epi64x(0x1249249249249249ll));
+        return x;
+    }
+
+    _XOINL __m128i MortonCombine21(__m128i x, __m128i y, __m128i z) {
+        return _mm_or_si128(MortonSpread21(x), _mm_or_si128(_mm_slli_epi64(MortonSpread21(y), 1), _mm_slli_epi64(MortonSpread21(z), 2)));
+    }
+
+    _XOINL void MortonStore(__m128 x, __m128 y, __m128 z, uint64_t* outCodes) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i cellX = _mm_cvttps_epi32(x), cellY = _mm_cvttps_epi32(y), cellZ = _mm_cvttps_epi32(z);
+        _mm_storeu_si128((__m128i*)outCodes, 
+            MortonCombine21(_mm_unpacklo_epi32(cellX, zero), _mm_unpacklo_epi32(cellY, zero), _mm_unpacklo_epi32(cellZ, zero)));
+        _mm_storeu_si128((__m128i*)(outCodes + 2), 
+            MortonCombine21(_mm_unpackhi_epi32(cellX, zero), _mm_unpackhi_epi32(cellY, zero), _mm_unpackhi_epi32(cellZ, zero)));
+    }
+#endif
+
+#if defined(XO_AVX2)
+    _XOINL __m256i MortonSpread10(__m256i x) {
+        x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi32(x, 16)), _mm256_set1_epi32(0x030000ff));
+        x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi32(x, 8)), _mm256_set1_epi32(0x0300f00f));
+        x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi32(x, 4)), _mm256_set1_epi32(0x030c30c3));
+        x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi32(x, 2)), _mm256_set1_epi32(0x09249249));
+        return x;
+    }
+
+    _XOINL void MortonStore(__m256 x, __m256 y, __m256 z, uint32_t* outCodes) {
+        const __m256i code = _mm256_or_si256(MortonSpread10(_mm256_cvttps_epi32(x)), 
+                             _mm256_or_si256(_mm256_slli_epi32(MortonSpread10(_mm256_cvttps_epi32(y)), 1), 
+                                             _mm256_slli_epi32(MortonSpread10(_mm256_cvttps_epi32(z)), 2)));
+        _mm256_storeu_si256((__m256i*)outCodes, code);
+    }
+#elif defined(XO_AVX)
+    // No 256 bit integer operations before AVX2, so each half is done with SSE2.
+    _XOINL void MortonStore(__m256 x, __m256 y, __m256 z, uint32_t* outCodes) {
+        MortonStore(_mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z), outCodes);
+        MortonStore(_mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(z, 1), outCodes + 4);
+    }
+#endif
+
+#if defined(XO_AVX2)
+    // Four cells per register, one in each 64 bit lane.
+    _XOINL __m256i MortonSpread21(__m256i x) {
+        x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi64(x, 32)), _mm256_set1_epi64x(0x001f00000000ffffll));
+        x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi64(x, 16)), _mm256_set1_epi64x(0x001f0000ff0000ffll));
+        x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi64(x, 8)), _mm256_set1_epi64x(0x100f00f00f00f00fll));
+        x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi64(x, 4)), _mm256_set1_epi64x(0x10c30c30c30c30c3ll));
+        x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi64(x, 2)), _mm256_set1_epi64x(0x1249249249249249ll));
+        return x;
+    }
+
+    _XOINL __m256i MortonCombine21x4(__m128i x, __m128i y, __m128i z) {
+        return _mm256_or_si256(MortonSpread21(_mm256_cvtepu32_epi64(x)), 
+               _mm256_or_si256(_mm256_slli_epi64(MortonSpread21(_mm256_cvtepu32_epi64(y)), 1), 
+                               _mm256_slli_epi64(MortonSpread21(_mm256_cvtepu32_epi64(z)), 2)));
+    }
+
+    _XOINL void MortonStore(__m256 x, __m256 y, __m256 z, uint64_t* outCodes) {
+        const __m256i cellX = _mm256_cvttps_epi32(x), cellY = _mm256_cvttps_epi32(y), cellZ = _mm256_cvttps_epi32(z);
+        _mm256_storeu_si256((__m256i*)outCodes, MortonCombine21x4(_mm256_castsi256_si128(cellX), 
+            _mm256_castsi256_si128(cellY), _mm256_castsi256_si128(cellZ)));
+        _mm256_storeu_si256((__m256i*)(outCodes + 4), MortonCombine21x4(_mm256_extracti128_si256(cellX, 1), 
+            _mm256_extracti128_si256(cellY, 1), _mm256_extracti128_si256(cellZ, 1)));
+    }
+#elif defined(XO_AVX) && !defined(XO_BMI2)
+    _XOINL void MortonStore(__m256 x, __m256 y, __m256 z, uint64_t* outCodes) {
+        MortonStore(_mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z), outCodes);
+        MortonStore(_mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(z, 1), outCodes + 4);
+    }
+#endif
+
+#if !defined(XO_SSE2) || (defined(XO_BMI2) && !defined(XO_AVX2))
+    // A lane at a time. With BMI2 this is how 63 bit codes are made without AVX2, PDEP spreading a coordinate in one 
+    // instruction; with AVX2 shifting four at a time is quicker.
+    template <class Code>
+    _XOINL void MortonStore(wide::Float x, wide::Float y, wide::Float z, Code* outCodes) {
+        _XOSIMDALIGN32 float cellX[wide::Width], cellY[wide::Width], cellZ[wide::Width];
+        wide::Store(cellX, x);
+        wide::Store(cellY, y);
+        wide::Store(cellZ, z);
+        for (int lane = 0; lane < wide::Width; ++lane) {
+            MortonCode((uint32_t)cellX[lane], (uint32_t)cellY[lane], (uint32_t)cellZ[lane], outCodes + lane);
+        }
+    }
+#endif
+
+    template <class Code>
+    void MortonEncodeArray(const Vector3* points, size_t count, const AABB& bounds, uint32_t max, Code* outCodes) {
+        const MortonGrid grid(bounds, max);
+        size_t i = 0;
+#if defined(XO_SSE)
+        // Vector3 is four floats wide with SSE, so wide::Width points load as one register per axis.
+        for (; i + wide::Width <= count; i += wide::Width) {
+            wide::Float x, y, z, w;
+            wide::LoadTransposed4(&points[i].x, 4, x, y, z, w);
+            MortonStore(grid.WideCell(x, 0), grid.WideCell(y, 1), grid.WideCell(z, 2), outCodes + i);
+        }
+#endif
+        for (; i < count; ++i) {
+            MortonCode(grid.Cell(points[i].x, 0), grid.Cell(points[i].y, 1), grid.Cell(points[i].z, 2), outCodes + i);
+        }
+    }
+
+    template <class Code>
+    void MortonEncodeStream(const Vector3Stream& points, const AABB& bounds, uint32_t max, Code* outCodes) {
+        const MortonGrid grid(bounds, max);
+        const float* x = points.X();
+        const float* y = points.Y();
+        const float* z = points.Z();
+        const size_t count = points.Size();
+        size_t i = 0;
+        for (; i + wide::Width <= count; i += wide::Width) {
+            MortonStore(grid.WideCell(wide::Load(x + i), 0), grid.WideCell(wide::Load(y + i), 1), grid.WideCell(wide::Load(z + i), 2), outCodes + i);
+        }
+        for (; i < count; ++i) {
+            MortonCode(grid.Cell(x[i], 0), grid.Cell(y[i], 1), grid.Cell(z[i], 2), outCodes + i);
+        }
+    }
+
+    // A least significant digit radix sort: each pass is a stable counting sort of the keys by the next 
+    // MortonDigitBits of them, from the lowest bits up, moving keys and indices to the other pair of arrays. The 
+    // counts of every pass are taken in one read of the keys up front, and passes where all keys have the same digit, 
+    // such as the top bits of Morton codes of few bits, are skipped. With more than one thread, each thread counts and 
+    // moves its own share of the keys; the keys of a bucket are placed by thread, then by position, so the order is 
+    // the same for any number of threads.
+    template <class Key>
+    void MortonRadixSort(Key* keys, uint32_t* indices, size_t count, unsigned threadCount, Key* scratchKeys, uint32_t* scratchIndices) {
+        const int passes = (int)((sizeof(Key) * 8 + MortonDigitBits - 1) / MortonDigitBits);
+        const Key digitMask = (Key)(MortonBuckets - 1);
+        XO_ASSERT(count < 0xffffffffu, "xo-math Morton::Sort too many keys for 32 bit counts.");
+        if (count < 2) {
+            return;
+        }
+        const unsigned threads = xo_internal::ThreadCount(threadCount, count, MortonThreadShare);
+
+        void* allocated = nullptr;
+        if (!scratchKeys || !scratchIndices) {
+            allocated = XO_ALIGNED_MALLOC(count * (sizeof(Key) + sizeof(uint32_t)), 64);
+            scratchKeys = (Key*)allocated;
+            scratchIndices = (uint32_t*)(scratchKeys + count);
+        }
+        const size_t threadBuckets = passes * MortonBuckets;
+        uint32_t* counts = (uint32_t*)XO_ALIGNED_MALLOC(threads * threadBuckets * sizeof(uint32_t), 64);
+        const size_t share = (count + threads - 1) / threads;
+
+        xo_internal::Parallel(threads, [&](unsigned t) {
+            uint32_t* threadCounts = counts + t * threadBuckets;
+            memset(threadCounts, 0, threadBuckets * sizeof(uint32_t));
+            const size_t end = _XO_MIN(count, (t + 1) * share);
+            for (size_t i = t * share; i < end; ++i) {
+                const Key key = keys[i];
+                for (int pass = 0; pass < passes; ++pass) {
+                    ++threadCounts[pass * MortonBuckets + (size_t)((key >> (pass * MortonDigitBits)) & digitMask)];
+                }
+            }
+        });
+
+        Key* fromKeys = keys;
+        Key* toKeys = scratchKeys;
+        uint32_t* fromIndices = indices;
+        uint32_t* toIndices = scratchIndices;
+        bool moved = false;
+        for (int pass = 0; pass < passes; ++pass) {
+            const int shift = pass * MortonDigitBits;
+            const size_t firstDigit = (size_t)((fromKeys[0] >> shift) & digitMask);
+            size_t firstCount = 0;
+            for (unsigned t = 0; t < threads; ++t) {
+                firstCount += counts[t * threadBuckets + pass * MortonBuckets + firstDigit];
+            }
+            if (firstCount == count) {
+                continue;
+            }
+            // The up front counts are of each thread's share of the keys in their first order, later passes recount 
+            // the shares as the last pass left them.
+            if (threads > 1 && moved) {
+                xo_internal::Parallel(threads, [&](unsigned t) {
+                    uint32_t* passCounts = counts + t * threadBuckets + pass * MortonBuckets;
+                    memset(passCounts, 0, MortonBuckets * sizeof(uint32_t));
+                    const size_t end = _XO_MIN(count, (t + 1) * share);
+                    for (size_t i = t * share; i < end; ++i) {
+                        ++passCounts[(size_t)((fromKeys[i] >> shift) & digitMask)];
+                    }
+                });
+            }
+            uint32_t start = 0;
+            for (size_t b = 0; b < MortonBuckets; ++b) {
+                for (unsigned t = 0; t < threads; ++t) {
+                    uint32_t& bucket = counts[t * threadBuckets + pass * MortonBuckets + b];
+                    const uint32_t counted = bucket;
+                    bucket = start;
+                    start += counted;
+                }
+            }
+            xo_internal::Parallel(threads, [&](unsigned t) {
+                uint32_t* starts = counts + t * threadBuckets + pass * MortonBuckets;
+                const size_t end = _XO_MIN(count, (t + 1) * share);
+                for (size_t i = t * share; i < end; ++i) {
+                    const Key key = fromKeys[i];
+                    const uint32_t to = starts[(size_t)((key >> shift) & digitMask)]++;
+                    toKeys[to] = key;
+                    toIndices[to] = fromIndices[i];
+                }
+            });
+            std::swap(fromKeys, toKeys);
+            std::swap(fromIndices, toIndices);
+            moved = true;
+        }
+        if (fromKeys != keys) {
+            memcpy(keys, fromKeys, count * sizeof(Key));
+            memcpy(indices, fromIndices, count * sizeof(uint32_t));
+        }
+        XO_ALIGNED_FREE(counts);
+        if (allocated) {
+            XO_ALIGNED_FREE(allocated);
+        }
+    }
+
+    // Sorts the indices of count points by the 30 bit codes encode writes.
+    template <class Encode>
+    void MortonOrder(size_t count, uint32_t* outOrder, unsigned threadCount, const Encode& encode) {
+        if (count == 0) {
+            return;
+        }
+        // The codes and the sort's scratch arrays in one allocation.
+        uint32_t* codes = (uint32_t*)XO_ALIGNED_MALLOC(count * 3 * sizeof(uint32_t), 64);
+        encode(codes);
+        for (size_t i = 0; i < count; ++i) {
+            outOrder[i] = (uint32_t)i;
+        }
+        Morton::Sort(codes, outOrder, count, threadCount, codes + count, codes + count * 2);
+        XO_ALIGNED_FREE(codes);
+    }
+}
+
+uint32_t Morton::Encode30(uint32_t x, uint32_t y, uint32_t z) {
+    return MortonSpread10(x) | (MortonSpread10(y) << 1) | (MortonSpread10(z) << 2);
+}
+
+uint64_t Morton::Encode63(uint32_t x, uint32_t y, uint32_t z) {
+    return MortonSpread21(x) | (MortonSpread21(y) << 1) | (MortonSpread21(z) << 2);
+}
+
+void Morton::Decode30(uint32_t code, uint32_t& outX, uint32_t& outY, uint32_t& outZ) {
+    outX = MortonCompact10(code);
+    outY = MortonCompact10(code >> 1);
+    outZ = MortonCompact10(code >> 2);
+}
+
+void Morton::Decode63(uint64_t code, uint32_t& outX, uint32_t& outY, uint32_t& outZ) {
+    outX = MortonCompact21(code);
+    outY = MortonCompact21(code >> 1);
+    outZ = MortonCompact21(code >> 2);
+}
+
+uint32_t Morton::Encode30(const Vector3& point, const AABB& bounds) {
+    const MortonGrid grid(bounds, Max30);
+    return Encode30(grid.Cell(point.x, 0), grid.Cell(point.y, 1), grid.Cell(point.z, 2));
+}
+
+uint64_t Morton::Encode63(const Vector3& point, const AABB& bounds) {
+    const MortonGrid grid(bounds, Max63);
+    return Encode63(grid.Cell(point.x, 0), grid.Cell(point.y, 1), grid.Cell(point.z, 2));
+}
+
+void Morton::Encode30(const Vector3* points, size_t count, const AABB& bounds, uint32_t* outCodes) {
+    MortonEncodeArray(points, count, bounds, Max30, outCodes);
+}
+
+void Morton::Encode30(const Vector3Stream& points, const AABB& bounds, uint32_t* outCodes) {
+    MortonEncodeStream(points, bounds, Max30, outCodes);
+}
+
+void Morton::Encode63(const Vector3* points, size_t count, const AABB& bounds, uint64_t* outCodes) {
+    MortonEncodeArray(points, count, bounds, Max63, outCodes);
+}
+
+void Morton::Encode63(const Vector3Stream& points, const AABB& bounds, uint64_t* outCodes) {
+    MortonEncodeStream(points, bounds, Max63, outCodes);
+}
+
+void Morton::Sort(uint32_t* keys, uint32_t* indices, size_t count, unsigned threadCount, uint32_t* scratchKeys, uint32_t* scratchIndices) {
+    MortonRadixSort(keys, indices, count, threadCount, scratchKeys, scratchIndices);
+}
+
+void Morton::Sort(uint64_t* keys, uint32_t* indices, size_t count, unsigned threadCount, uint64_t* scratchKeys, uint32_t* scratchIndices) {
+    MortonRadixSort(keys, indices, count, threadCount, scratchKeys, scratchIndices);
+}
+
+void Morton::Order(const Vector3* points, size_t count, const AABB& bounds, uint32_t* outOrder, unsigned threadCount) {
+    MortonOrder(count, outOrder, threadCount, [&](uint32_t* codes) { Encode30(points, count, bounds, codes); });
+}
+
+void Morton::Order(const Vector3Stream& points, const AABB& bounds, uint32_t* outOrder, unsigned threadCount) {
+    MortonOrder(points.Size(), outOrder, threadCount, [&](uint32_t* codes) { Encode30(points, bounds, codes); });
+}
+
+void Morton::Permute(const Vector3Stream& points, const uint32_t* order, Vector3Stream& outPoints) {
+    XO_ASSERT(&points != &outPoints, "xo-math Morton::Permute points and outPoints are the same stream.");
+    const size_t count = points.Size();
+    outPoints.Resize(count);
+    const float* x = points.X();
+    const float* y = points.Y();
+    const float* z = points.Z();
+    float* outX = outPoints.X();
+    float* outY = outPoints.Y();
+    float* outZ = outPoints.Z();
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t from = order[i];
+        outX[i] = x[from];
+        outY[i] = y[from];
+        outZ[i] = z[from];
+    }
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,83 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+Vector3 OBB::ClosestPoint(const Vector3& point) const {
+    const Vector3 offset = point - center;
+    Vector3 closest = center;
+    for (int axis = 0; axis < 3; ++axis) {
+        closest += axes[axis] * Clamp(offset.Dot(axes[axis]), -extents[axis], extents[axis]);
+    }
+    return closest;
+}
+
+float OBB::DistanceSquared(const Vector3& point) const {
+    const Vector3 offset = point - center;
+    float distanceSquared = 0.0f;
+    for (int axis = 0; axis < 3; ++axis) {
+        const float outside = Max(Abs(offset.Dot(axes[axis])) - extents[axis], 0.0f);
+        distanceSquared += outside * outside;
+    }
+    return distanceSquared;
+}
+
+void OBB::ClosestPoints(const Vector3Stream& points, Vector3Stream& outPoints, float* outDistancesSquared) const {
+    using namespace wide;
+    const size_t count = points.Size();
+    outPoints.Resize(count);
+    const Float3 c = wide::Set(center.x, center.y, center.z);
+    Float3 axis[3];
+    Float extent[3];
+    for (int a = 0; a < 3; ++a) {
+        axis[a] = wide::Set(axes[a].x, axes[a].y, axes[a].z);
+        extent[a] = wide::Set(extents[a]);
+    }
+    for (size_t i = 0; i < count; i += Width) {
+        const Float3 offset = Sub(Load(points.X() + i, points.Y() + i, points.Z() + i), c);
+        Float3 closest = c;
+        Float distanceSquared = Zero();
+        for (int a = 0; a < 3; ++a) {
+            const Float along = Dot(offset, axis[a]);
+            const Float clamped = wide::Min(wide::Max(along, Negate(extent[a])), extent[a]);
+            const Float outside = Sub(along, clamped);
+            closest = MulAdd(axis[a], clamped, closest);
+            distanceSquared = MulAdd(outside, outside, distanceSquared);
+        }
+        Store(outPoints.X() + i, outPoints.Y() + i, outPoints.Z() + i, closest);
+        if (outDistancesSquared) {
+            if (i + Width <= count) {
+                StoreUnaligned(outDistancesSquared + i, distanceSquared);
+            }
+            else {
+                StorePartial(outDistancesSquared + i, distanceSquared, count - i);
+            }
+        }
+    }
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,205 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+namespace
+{
+    // The plane and classification thresholds broadcast to every lane.
+    struct PlaneTerms {
+        PlaneTerms(const Plane& plane, float epsilon) :
+            x(wide::Set(plane.normal.x)), y(wide::Set(plane.normal.y)), z(wide::Set(plane.normal.z)), d(wide::Set(plane.d)),
+            front(wide::Set(epsilon)), back(wide::Set(-epsilon)) {
+        }
+
+        _XOINL wide::Float Distances(wide::Float px, wide::Float py, wide::Float pz) const {
+            return wide::MulAdd(px, x, wide::MulAdd(py, y, wide::MulAdd(pz, z, d)));
+        }
+
+        wide::Float x, y, z, d;
+        wide::Float front, back;
+    };
+
+    // Calls visit(i, x, y, z, lanes) on the points of a Vector3 array, wide::Width at a time starting from point i, 
+    // where lanes is the number of them that are real points. Stops early if visit returns false.
+    template <class Visit>
+    void PlaneVisitArray(const Vector3* points, size_t count, Visit& visit) {
+        using namespace wide;
+        size_t i = 0;
+        for (; i + Width <= count; i += Width) {
+            Float x, y, z;
+#if defined(XO_SSE)
+            Float w;
+            LoadTransposed4(&points[i].x, 4, x, y, z, w);
+#else
+            x = points[i].x;
+            y = points[i].y;
+            z = points[i].z;
+#endif
+            if (!visit(i, x, y, z, Width)) {
+                return;
+            }
+        }
+#if defined(XO_SSE)
+        if (i < count) {
+            // the last points are copied into a whole group, so they take the same path as the rest.
+            _XOSIMDALIGN32 float tail[Width * 4] = { };
+            for (size_t j = i; j < count; ++j) {
+                memcpy(tail + (j - i) * 4, &points[j].x, sizeof(float) * 3);
+            }
+            Float x, y, z, w;
+            LoadTransposed4(tail, 4, x, y, z, w);
+            visit(i, x, y, z, (int)(count - i));
+        }
+#endif
+    }
+
+    // As PlaneVisitArray, for a stream. Streams are padded to whole groups, so the last one is loaded directly.
+    template <class Visit>
+    void PlaneVisitStream(const Vector3Stream& points, Visit& visit) {
+        using namespace wide;
+        const size_t count = points.Size();
+        for (size_t i = 0; i < count; i += Width) {
+            const int lanes = (int)_XO_MIN(count - i, (size_t)Width);
+            if (!visit(i, Load(points.X() + i), Load(points.Y() + i), Load(points.Z() + i), lanes)) {
+                return;
+            }
+        }
+    }
+
+    // Visits groups, writing their distances to outDistances.
+    struct PlaneDistanceVisitor {
+        bool operator ()(size_t i, wide::Float x, wide::Float y, wide::Float z, int lanes) const {
+            const wide::Float distances = terms.Distances(x, y, z);
+            if (lanes == wide::Width) {
+                wide::StoreUnaligned(outDistances + i, distances);
+            }
+            else {
+                wide::StorePartial(outDistances + i, distances, lanes);
+            }
+            return true;
+        }
+
+        const PlaneTerms& terms;
+        float* outDistances;
+    };
+
+    // Writes the side of each point of a group, one byte per lane, from masks of the points in front and behind.
+    _XOINL void PlaneStoreSides(PlaneSide* outSides, wide::Float front, wide::Float back) {
+        const wide::Float sides = wide::Or(wide::And(front, wide::Set(HexFloat((unsigned)PlaneSide::Front))), 
+                                           wide::And(back, wide::Set(HexFloat((unsigned)PlaneSide::Back))));
+#if defined(XO_AVX)
+        const __m128i low = _mm_castps_si128(_mm256_castps256_ps128(sides)), high = _mm_castps_si128(_mm256_extractf128_ps(sides, 1));
+        _mm_storel_epi64((__m128i*)outSides, _mm_packus_epi16(_mm_packs_epi32(low, high), _mm_setzero_si128()));
+#elif defined(XO_SSE)
+        const __m128i words = _mm_packs_epi32(_mm_castps_si128(sides), _mm_setzero_si128());
+        const int bytes = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+        memcpy(outSides, &bytes, sizeof(bytes));
+#else
+        *outSides = (PlaneSide)wide::Bits(sides);
+#endif
+    }
+
+    // Visits groups, gathering the sides of the set and writing each point's side to outSides if it isn't null.
+    struct PlaneClassifyVisitor {
+        bool operator ()(size_t i, wide::Float x, wide::Float y, wide::Float z, int lanes) {
+            const wide::Float distances = terms.Distances(x, y, z);
+            const wide::Float front = wide::CmpGt(distances, terms.front), back = wide::CmpLt(distances, terms.back);
+            const int valid = wide::LaneBits(lanes);
+            sides |= (wide::MoveMask(front) & valid ? (int)PlaneSide::Front : 0) | (wide::MoveMask(back) & valid ? (int)PlaneSide::Back : 0);
+            if (outSides) {
+                if (lanes == wide::Width) {
+                    PlaneStoreSides(outSides + i, front, back);
+                }
+                else {
+                    PlaneSide group[wide::Width];
+                    PlaneStoreSides(group, front, back);
+                    memcpy(outSides + i, group, lanes);
+                }
+                return true;
+            }
+            return sides != (int)PlaneSide::Straddling;
+        }
+
+        const PlaneTerms& terms;
+        PlaneSide* outSides;
+        int sides;
+    };
+}
+
+Plane& Plane::Normalize() {
+    const float inverseLength = 1.0f / normal.Magnitude();
+    normal *= inverseLength;
+    d *= inverseLength;
+    return *this;
+}
+
+Plane& Plane::Transform(const Matrix4x4& m) {
+    Matrix4x4 inverse;
+    m.GetInverse(inverse);
+    return TransformByInverse(inverse);
+}
+
+Plane& Plane::TransformByInverse(const Matrix4x4& inverse) {
+    // The plane as a row vector times the inverse, which is the inverse transpose times it as a column.
+    const Vector4 v = inverse[0] * normal.x + inverse[1] * normal.y + inverse[2] * normal.z + inverse[3] * d;
+    normal.Set(v.x, v.y, v.z);
+    d = v.w;
+    return Normalize();
+}
+
+void Plane::SignedDistances(const Vector3* points, size_t count, float* outDistances) const {
+    const PlaneTerms terms(*this, 0.0f);
+    PlaneDistanceVisitor visitor{ terms, outDistances };
+    PlaneVisitArray(points, count, visitor);
+}
+
+void Plane::SignedDistances(const Vector3Stream& points, float* outDistances) const {
+    const PlaneTerms terms(*this, 0.0f);
+    PlaneDistanceVisitor visitor{ terms, outDistances };
+    PlaneVisitStream(points, visitor);
+}
+
+PlaneSide Plane::ClassifyPoints(const Vector3* points, size_t count, PlaneSide* outSides, float epsilon) const {
+    const PlaneTerms terms(*this, epsilon);
+    PlaneClassifyVisitor visitor{ terms, outSides, 0 };
+    PlaneVisitArray(points, count, visitor);
+    return (PlaneSide)visitor.sides;
+}
+
+PlaneSide Plane::ClassifyPoints(const Vector3Stream& points, PlaneSide* outSides, float epsilon) const {
+    const PlaneTerms terms(*this, epsilon);
+    PlaneClassifyVisitor visitor{ terms, outSides, 0 };
+    PlaneVisitStream(points, visitor);
+    return (PlaneSide)visitor.sides;
+}
+
+Plane Plane::FromPoints(const Vector3& a, const Vector3& b, const Vector3& c) {
+    return FromPointNormal(a, Vector3::Cross(b - a, c - a).Normalized());
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
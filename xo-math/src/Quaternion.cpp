@@ -39,11 +39,16 @@ namespace xo_internal
 {
     _XOINL float QuaternionSquareSum(const Quaternion& q)
     {
-#if defined(XO_SSE)
+#if defined(XO_SSE3)
         __m128 square = _mm_mul_ps(q.xmm, q.xmm);
         square = _mm_hadd_ps(square, square);
         square = _mm_hadd_ps(square, square);
         return _mm_cvtss_f32(square);
+#elif defined(XO_SSE)
+        __m128 square = _mm_mul_ps(q.xmm, q.xmm);
+        square = _mm_add_ps(square, _mm_movehl_ps(square, square));
+        square = _mm_add_ss(square, _mm_shuffle_ps(square, square, _MM_SHUFFLE(1, 1, 1, 1)));
+        return _mm_cvtss_f32(square);
 #else
         return q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w;
 #endif
@@ -75,14 +80,10 @@ Quaternion::Quaternion(const Matrix4x4& mat)
         return; // too close.
     }
 
-#if defined(XO_SSE)
-#   if defined(XO_NO_INVERSE_DIVISION)
-    Vector3 recipScale = Vector3(_mm_div_ps(Vector4::One.xmm, scale.xmm));
-#   else
-    Vector3 recipScale = Vector3(_mm_rcp_ps(scale.xmm));
-#   endif
+#if defined(XO_NO_INVERSE_DIVISION)
+    Vector3 recipScale = scale.Reciprocal<Precision::Exact>();
 #else
-    Vector3 recipScale = Vector3(1.0f / scale.x, 1.0f / scale.y, 1.0f / scale.z);
+    Vector3 recipScale = scale.Reciprocal<Precision::Approximate>();
 #endif
     xAxis *= recipScale.x;
     yAxis *= recipScale.y;
@@ -240,7 +241,7 @@ void Quaternion::AxisAngleRadians(const Vector3& axis, float radians, Quaternion
 
     Vector3 n = axis.Normalized();
     n *= sr;
-    _XO_ASSIGN_QUAT_Q(outQuat, Cos(radians), n.x, n.y, n.z);
+    _XO_ASSIGN_QUAT_Q(outQuat, Cos(hr), n.x, n.y, n.z);
 }
 
 void Quaternion::LookAtFromPosition(const Vector3& from, const Vector3& to, const Vector3& up, Quaternion& outQuat)
@@ -369,6 +370,164 @@ void Quaternion::Slerp(const Quaternion& a, const Quaternion& b, float t, Quater
     }
 }
 
+void Quaternion::Nlerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat)
+{
+    float cosTheta = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+    float sign = cosTheta < 0.0f ? -1.0f : 1.0f;
+    outQuat = Quaternion(
+        a.x + (b.x * sign - a.x) * t,
+        a.y + (b.y * sign - a.y) * t,
+        a.z + (b.z * sign - a.z) * t,
+        a.w + (b.w * sign - a.w) * t);
+    outQuat.Normalize();
+}
+
+namespace xo_internal
+{
+    // Quaternion::operator == for wide::Width pairs of quaternions at once.
+    _XOINL wide::Float QuaternionLanesEqual(const wide::Float a[4], const wide::Float b[4])
+    {
+        using namespace wide;
+        Float equal = True();
+        for (int i = 0; i < 4; ++i)
+        {
+#if defined(XO_SSE)
+            equal = And(equal, CmpLt(wide::Abs(Sub(a[i], b[i])), Set(sse::SSEFloatEpsilon)));
+#else
+            equal = And(equal, CmpLe(Mul(wide::Abs(Sub(a[i], b[i])), Set(1.0f / Quaternion::Epsilon)), wide::Min(wide::Abs(a[i]), wide::Abs(b[i]))));
+#endif
+        }
+        return equal;
+    }
+
+    // Quaternion::Slerp for wide::Width quaternions at once, see it for details of the polynomial.
+    _XOINL void SlerpLanes(const wide::Float a[4], const wide::Float b[4], wide::Float t, wide::Float o[4])
+    {
+        using namespace wide;
+        const Float one = Set(1.0f);
+        Float cosTheta = MulAdd(a[0], b[0], MulAdd(a[1], b[1], MulAdd(a[2], b[2], Mul(a[3], b[3]))));
+
+        Float alpha = Select(CmpGe(cosTheta, Zero()), one, Set(-1.0f));
+        Float halfY = MulAdd(alpha, cosTheta, one);
+
+        Float f2b = Sub(t, Set(0.5f));
+        Float u = wide::Abs(f2b);
+        Float f2a = Sub(u, f2b);
+        f2b = Add(f2b, u);
+        u = Add(u, u);
+        Float f1 = Sub(one, u);
+
+        Float halfSecHalfTheta = NegMulAdd(NegMulAdd(Set(0.0903321f), halfY, Set(0.476537f)), halfY, Set(1.09f));
+        halfSecHalfTheta = Mul(halfSecHalfTheta, NegMulAdd(Mul(halfY, halfSecHalfTheta), halfSecHalfTheta, Set(1.5f)));
+        Float versHalfTheta = NegMulAdd(halfY, halfSecHalfTheta, one);
+
+        Float sqNotU = Mul(f1, f1);
+        Float ratio2 = Mul(Set(0.0000440917108f), versHalfTheta);
+        Float ratio1 = MulAdd(Sub(sqNotU, Set(16.0f)), ratio2, Set(-0.00158730159f));
+        ratio1 = MulAdd(Mul(ratio1, Sub(sqNotU, Set(9.0f))), versHalfTheta, Set(0.0333333333f));
+        ratio1 = MulAdd(Mul(ratio1, Sub(sqNotU, Set(4.0f))), versHalfTheta, Set(-0.333333333f));
+        ratio1 = MulAdd(Mul(ratio1, Sub(sqNotU, one)), versHalfTheta, one);
+
+        Float sqU = Mul(u, u);
+        ratio2 = MulAdd(Sub(sqU, Set(16.0f)), ratio2, Set(-0.00158730159f));
+        ratio2 = MulAdd(Mul(ratio2, Sub(sqU, Set(9.0f))), versHalfTheta, Set(0.0333333333f));
+        ratio2 = MulAdd(Mul(ratio2, Sub(sqU, Set(4.0f))), versHalfTheta, Set(-0.333333333f));
+        ratio2 = MulAdd(Mul(ratio2, Sub(sqU, one)), versHalfTheta, one);
+
+        f1 = Mul(f1, Mul(ratio1, halfSecHalfTheta));
+        f2a = Mul(f2a, ratio2);
+        f2b = Mul(f2b, ratio2);
+        alpha = Mul(alpha, Add(f1, f2a));
+        Float beta = Add(f1, f2b);
+
+        Float q[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            q[i] = MulAdd(alpha, a[i], Mul(beta, b[i]));
+        }
+        Float correction = NegMulAdd(Set(0.5f), MulAdd(q[0], q[0], MulAdd(q[1], q[1], MulAdd(q[2], q[2], Mul(q[3], q[3])))), Set(1.5f));
+
+        // The early outs of Quaternion::Slerp, in reverse order so the first of them to apply wins.
+        Float useA = QuaternionLanesEqual(a, b);
+        Float useB = CmpLe(Mul(wide::Abs(Sub(t, one)), Set(1.0f / FloatEpsilon)), wide::Min(wide::Abs(t), one));
+        Float useAFirst = CmpEq(t, Zero());
+        for (int i = 0; i < 4; ++i)
+        {
+            Float r = Select(useA, a[i], Mul(q[i], correction));
+            r = Select(useB, b[i], r);
+            o[i] = Select(useAFirst, a[i], r);
+        }
+    }
+
+    // Quaternion::Nlerp for wide::Width quaternions at once.
+    _XOINL void NlerpLanes(const wide::Float a[4], const wide::Float b[4], wide::Float t, wide::Float o[4])
+    {
+        using namespace wide;
+        Float cosTheta = MulAdd(a[0], b[0], MulAdd(a[1], b[1], MulAdd(a[2], b[2], Mul(a[3], b[3]))));
+        Float flip = CmpLt(cosTheta, Zero());
+        for (int i = 0; i < 4; ++i)
+        {
+            Float bi = Select(flip, Negate(b[i]), b[i]);
+            o[i] = MulAdd(Sub(bi, a[i]), t, a[i]);
+        }
+        Float magSq = MulAdd(o[0], o[0], MulAdd(o[1], o[1], MulAdd(o[2], o[2], Mul(o[3], o[3]))));
+#if defined(XO_NO_INVERSE_DIVISION)
+        Float inv = Div(Set(1.0f), wide::Sqrt(magSq));
+#else
+        Float inv = Rsqrt(magSq);
+#endif
+        inv = And(CmpGt(magSq, Zero()), inv);
+        for (int i = 0; i < 4; ++i)
+        {
+            o[i] = Mul(o[i], inv);
+        }
+    }
+
+    typedef void(*QuaternionLanesBlend)(const wide::Float a[4], const wide::Float b[4], wide::Float t, wide::Float o[4]);
+
+    template <QuaternionLanesBlend Blend>
+    _XOINL void QuaternionBlendArray(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* outQuats, size_t count)
+    {
+        wide::Float la[4], lb[4], lo[4];
+        size_t i = 0;
+        for (; i + wide::Width <= count; i += wide::Width)
+        {
+            wide::LoadTransposed4(a[i].f, 4, la[0], la[1], la[2], la[3]);
+            wide::LoadTransposed4(b[i].f, 4, lb[0], lb[1], lb[2], lb[3]);
+            Blend(la, lb, wide::LoadUnaligned(t + i), lo);
+            wide::StoreTransposed4(outQuats[i].f, 4, lo[0], lo[1], lo[2], lo[3]);
+        }
+        if (i < count)
+        {
+            // The last partial group is padded out with identity quaternions.
+            Quaternion pa[wide::Width], pb[wide::Width];
+            for (size_t j = 0; j < wide::Width; ++j)
+            {
+                pa[j] = i + j < count ? a[i + j] : Quaternion::Identity;
+                pb[j] = i + j < count ? b[i + j] : Quaternion::Identity;
+            }
+            wide::LoadTransposed4(pa[0].f, 4, la[0], la[1], la[2], la[3]);
+            wide::LoadTransposed4(pb[0].f, 4, lb[0], lb[1], lb[2], lb[3]);
+            Blend(la, lb, wide::LoadPartial(t + i, count - i), lo);
+            wide::StoreTransposed4(pa[0].f, 4, lo[0], lo[1], lo[2], lo[3]);
+            for (size_t j = 0; i + j < count; ++j)
+            {
+                outQuats[i + j] = pa[j];
+            }
+        }
+    }
+}
+
+void Quaternion::SlerpArray(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* outQuats, size_t count)
+{
+    xo_internal::QuaternionBlendArray<xo_internal::SlerpLanes>(a, b, t, outQuats, count);
+}
+
+void Quaternion::NlerpArray(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* outQuats, size_t count)
+{
+    xo_internal::QuaternionBlendArray<xo_internal::NlerpLanes>(a, b, t, outQuats, count);
+}
+
 void Quaternion::Lerp(const Quaternion& a, const Quaternion& b, float t, Quaternion& outQuat)
 {
     Vector4& vq = (Vector4&)outQuat;
@@ -0,0 +1,110 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+namespace {
+    // http://prng.di.unimi.it/splitmix64.c
+    _XOINL uint64_t SplitMix64(uint64_t& state) {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+}
+
+RandomGenerator::RandomGenerator() {
+    Seed((uint64_t)clock() ^ ((uint64_t)(uintptr_t)this << 16));
+}
+
+RandomGenerator::RandomGenerator(uint64_t seed) {
+    Seed(seed);
+}
+
+void RandomGenerator::Seed(uint64_t seed) {
+    uint32_t* words = &s[0][0];
+    for (int i = 0; i < 16; i += 2) {
+        const uint64_t z = SplitMix64(seed);
+        words[i] = (uint32_t)z;
+        words[i + 1] = (uint32_t)(z >> 32);
+    }
+}
+
+void RandomGenerator::RangeArray(float low, float high, float* outFloats, size_t count) {
+    const float scale = (high - low) * (1.0f / 16777216.0f);
+    size_t i = 0;
+#if defined(XO_SSE)
+    __m128i w0 = _mm_load_si128((const __m128i*)s[0]);
+    __m128i w1 = _mm_load_si128((const __m128i*)s[1]);
+    __m128i w2 = _mm_load_si128((const __m128i*)s[2]);
+    __m128i w3 = _mm_load_si128((const __m128i*)s[3]);
+    const __m128 scaleV = _mm_set1_ps(scale);
+    const __m128 lowV = _mm_set1_ps(low);
+    for (; i < count; i += 4) {
+        // Next() for all four generators at once.
+        const __m128i result = _mm_add_epi32(w0, w3);
+        const __m128i t = _mm_slli_epi32(w1, 9);
+        w2 = _mm_xor_si128(w2, w0);
+        w3 = _mm_xor_si128(w3, w1);
+        w1 = _mm_xor_si128(w1, w2);
+        w0 = _mm_xor_si128(w0, w3);
+        w2 = _mm_xor_si128(w2, t);
+        w3 = _mm_or_si128(_mm_slli_epi32(w3, 11), _mm_srli_epi32(w3, 21));
+
+        const __m128 f = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(result, 8)), scaleV), lowV);
+        if (i + 4 <= count) {
+            _mm_storeu_ps(outFloats + i, f);
+        }
+        else {
+            _XOSIMDALIGN float tail[4];
+            _mm_store_ps(tail, f);
+            for (size_t j = 0; i + j < count; ++j) {
+                outFloats[i + j] = tail[j];
+            }
+        }
+    }
+    _mm_store_si128((__m128i*)s[0], w0);
+    _mm_store_si128((__m128i*)s[1], w1);
+    _mm_store_si128((__m128i*)s[2], w2);
+    _mm_store_si128((__m128i*)s[3], w3);
+#else
+    for (; i < count; i += 4) {
+        for (int g = 0; g < 4; ++g) {
+            const uint32_t result = s[0][g] + s[3][g];
+            const uint32_t t = s[1][g] << 9;
+            s[2][g] ^= s[0][g];
+            s[3][g] ^= s[1][g];
+            s[1][g] ^= s[2][g];
+            s[0][g] ^= s[3][g];
+            s[2][g] ^= t;
+            s[3][g] = (s[3][g] << 11) | (s[3][g] >> 21);
+            if (i + g < count) {
+                outFloats[i + g] = (float)(result >> 8) * scale + low;
+            }
+        }
+    }
+#endif
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,243 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+namespace
+{
+    // Möller-Trumbore over wide::Width ray/triangle pairs, the same arithmetic as Ray::IntersectTriangle. The 
+    // triangle is v0 and its edges e1 = v1 - v0, e2 = v2 - v0. Returns the mask of hits with 0 <= t < tMax.
+    _XOINL wide::Float RayTriangle(
+        wide::Float ox, wide::Float oy, wide::Float oz, wide::Float dx, wide::Float dy, wide::Float dz,
+        wide::Float v0x, wide::Float v0y, wide::Float v0z,
+        wide::Float e1x, wide::Float e1y, wide::Float e1z, wide::Float e2x, wide::Float e2y, wide::Float e2z,
+        wide::Float tMax, wide::Float& outT, wide::Float& outU, wide::Float& outV) {
+        using namespace wide;
+        const Float px = Sub(Mul(dy, e2z), Mul(dz, e2y));
+        const Float py = Sub(Mul(dz, e2x), Mul(dx, e2z));
+        const Float pz = Sub(Mul(dx, e2y), Mul(dy, e2x));
+        const Float det = Add(Add(Mul(e1x, px), Mul(e1y, py)), Mul(e1z, pz));
+        const Float inverseDet = Div(wide::Set(1.0f), det);
+        const Float sx = Sub(ox, v0x), sy = Sub(oy, v0y), sz = Sub(oz, v0z);
+        const Float u = Mul(Add(Add(Mul(sx, px), Mul(sy, py)), Mul(sz, pz)), inverseDet);
+        const Float qx = Sub(Mul(sy, e1z), Mul(sz, e1y));
+        const Float qy = Sub(Mul(sz, e1x), Mul(sx, e1z));
+        const Float qz = Sub(Mul(sx, e1y), Mul(sy, e1x));
+        const Float v = Mul(Add(Add(Mul(dx, qx), Mul(dy, qy)), Mul(dz, qz)), inverseDet);
+        const Float t = Mul(Add(Add(Mul(e2x, qx), Mul(e2y, qy)), Mul(e2z, qz)), inverseDet);
+        const Float zero = Zero();
+        Float hit = And(CmpNeq(det, zero), And(CmpGe(u, zero), CmpGe(v, zero)));
+        hit = And(hit, And(CmpLe(Add(u, v), wide::Set(1.0f)), And(CmpGe(t, zero), CmpLt(t, tMax))));
+        outT = t;
+        outU = u;
+        outV = v;
+        return hit;
+    }
+
+    // A RayPacket is worked through Step rays at a time. A packet narrower than a register (RayPacket4 under AVX) is 
+    // loaded into both halves, and only the low half is stored back.
+    template <int N>
+    struct RayLanes {
+        static const int Step = N < wide::Width ? N : wide::Width;
+
+        _XOINL static wide::Float Load(const float* f) {
+#if defined(XO_AVX)
+            if (N < wide::Width) {
+                return _mm256_broadcast_ps((const __m128*)f);
+            }
+#endif
+            return wide::LoadUnaligned(f);
+        }
+
+        _XOINL static void Store(float* f, wide::Float v) {
+#if defined(XO_AVX)
+            if (N < wide::Width) {
+                _mm_storeu_ps(f, _mm256_castps256_ps128(v));
+                return;
+            }
+#endif
+            wide::StoreUnaligned(f, v);
+        }
+
+        _XOINL static int Bits(wide::Float hit) {
+            return wide::MoveMask(hit) & wide::LaneBits(Step);
+        }
+    };
+
+    // Loads Width triangles, three vertices each, as v0 and the two edges.
+    _XOINL void RayLoadTriangles(const Vector3* vertices, 
+        wide::Float& v0x, wide::Float& v0y, wide::Float& v0z,
+        wide::Float& e1x, wide::Float& e1y, wide::Float& e1z, wide::Float& e2x, wide::Float& e2y, wide::Float& e2z) {
+        using namespace wide;
+        Float v1x, v1y, v1z, v2x, v2y, v2z;
+#if defined(XO_SSE)
+        // the padding lane of each vertex is loaded and ignored.
+        const size_t stride = sizeof(Vector3) * 3 / sizeof(float);
+        Float w;
+        LoadTransposed4(&vertices[0].x, stride, v0x, v0y, v0z, w);
+        LoadTransposed4(&vertices[1].x, stride, v1x, v1y, v1z, w);
+        LoadTransposed4(&vertices[2].x, stride, v2x, v2y, v2z, w);
+#else
+        v0x = vertices[0].x;
+        v0y = vertices[0].y;
+        v0z = vertices[0].z;
+        v1x = vertices[1].x;
+        v1y = vertices[1].y;
+        v1z = vertices[1].z;
+        v2x = vertices[2].x;
+        v2y = vertices[2].y;
+        v2z = vertices[2].z;
+#endif
+        e1x = Sub(v1x, v0x);
+        e1y = Sub(v1y, v0y);
+        e1z = Sub(v1z, v0z);
+        e2x = Sub(v2x, v0x);
+        e2y = Sub(v2y, v0y);
+        e2z = Sub(v2z, v0z);
+    }
+}
+
+bool Ray::IntersectTriangles(const Vector3* vertices, size_t count, float& inOutT, float& outU, float& outV, size_t& outIndex) const {
+    using namespace wide;
+    const Float ox = wide::Set(origin.x), oy = wide::Set(origin.y), oz = wide::Set(origin.z);
+    const Float dx = wide::Set(direction.x), dy = wide::Set(direction.y), dz = wide::Set(direction.z);
+    Float closest = wide::Set(inOutT);
+    bool found = false;
+    // The last partial group is tested with its last triangle repeated in the unused lanes.
+    Vector3 tail[Width * 3];
+    for (size_t i = 0; i < count; i += Width) {
+        const Vector3* group = vertices + i * 3;
+        if (i + Width > count) {
+            for (size_t j = 0; j < (size_t)Width; ++j) {
+                const size_t k = (i + j < count ? j : count - 1 - i) * 3;
+                tail[j * 3] = group[k];
+                tail[j * 3 + 1] = group[k + 1];
+                tail[j * 3 + 2] = group[k + 2];
+            }
+            group = tail;
+        }
+        Float v0x, v0y, v0z, e1x, e1y, e1z, e2x, e2y, e2z, t, u, v;
+        RayLoadTriangles(group, v0x, v0y, v0z, e1x, e1y, e1z, e2x, e2y, e2z);
+        const int bits = MoveMask(RayTriangle(ox, oy, oz, dx, dy, dz, v0x, v0y, v0z, e1x, e1y, e1z, e2x, e2y, e2z, closest, t, u, v));
+        if (bits) {
+            // Hits are rare next to misses, so the closest lane is picked in scalar code and the bound tightened for 
+            // the groups that follow.
+            _XOSIMDALIGN32 float ts[Width], us[Width], vs[Width];
+            Store(ts, t);
+            Store(us, u);
+            Store(vs, v);
+            for (int lane = 0; lane < Width; ++lane) {
+                if (((bits >> lane) & 1) && ts[lane] < inOutT) {
+                    inOutT = ts[lane];
+                    outU = us[lane];
+                    outV = vs[lane];
+                    outIndex = i + lane < count ? i + lane : count - 1;
+                }
+            }
+            closest = wide::Set(inOutT);
+            found = true;
+        }
+    }
+    return found;
+}
+
+template <int N>
+int RayPacket<N>::IntersectTriangle(const Vector3& v0, const Vector3& v1, const Vector3& v2, float* inOutT, float* outU, float* outV) const {
+    using namespace wide;
+    typedef RayLanes<N> Lanes;
+    const Float v0x = wide::Set(v0.x), v0y = wide::Set(v0.y), v0z = wide::Set(v0.z);
+    const Float e1x = wide::Set(v1.x - v0.x), e1y = wide::Set(v1.y - v0.y), e1z = wide::Set(v1.z - v0.z);
+    const Float e2x = wide::Set(v2.x - v0.x), e2y = wide::Set(v2.y - v0.y), e2z = wide::Set(v2.z - v0.z);
+    int bits = 0;
+    for (int i = 0; i < N; i += Lanes::Step) {
+        const Float ox = Lanes::Load(originX + i), oy = Lanes::Load(originY + i), oz = Lanes::Load(originZ + i);
+        const Float dx = Lanes::Load(directionX + i), dy = Lanes::Load(directionY + i), dz = Lanes::Load(directionZ + i);
+        const Float closest = Lanes::Load(inOutT + i);
+        Float t, u, v;
+        const Float hit = RayTriangle(ox, oy, oz, dx, dy, dz, v0x, v0y, v0z, e1x, e1y, e1z, e2x, e2y, e2z, closest, t, u, v);
+        Lanes::Store(inOutT + i, Select(hit, t, closest));
+        Lanes::Store(outU + i, Select(hit, u, Lanes::Load(outU + i)));
+        Lanes::Store(outV + i, Select(hit, v, Lanes::Load(outV + i)));
+        bits |= Lanes::Bits(hit) << i;
+    }
+    return bits;
+}
+
+template <int N>
+int RayPacket<N>::IntersectAABB(const AABB& box, float* inOutT) const {
+    using namespace wide;
+    typedef RayLanes<N> Lanes;
+    const Float minX = wide::Set(box.min.x), minY = wide::Set(box.min.y), minZ = wide::Set(box.min.z);
+    const Float maxX = wide::Set(box.max.x), maxY = wide::Set(box.max.y), maxZ = wide::Set(box.max.z);
+    int bits = 0;
+    for (int i = 0; i < N; i += Lanes::Step) {
+        const Float ox = Lanes::Load(originX + i), oy = Lanes::Load(originY + i), oz = Lanes::Load(originZ + i);
+        const Float ix = Lanes::Load(inverseDirectionX + i), iy = Lanes::Load(inverseDirectionY + i), iz = Lanes::Load(inverseDirectionZ + i);
+        const Float closest = Lanes::Load(inOutT + i);
+        const Float x0 = Mul(Sub(minX, ox), ix), x1 = Mul(Sub(maxX, ox), ix);
+        const Float y0 = Mul(Sub(minY, oy), iy), y1 = Mul(Sub(maxY, oy), iy);
+        const Float z0 = Mul(Sub(minZ, oz), iz), z1 = Mul(Sub(maxZ, oz), iz);
+        const Float enter = wide::Max(wide::Max(wide::Min(x0, x1), wide::Min(y0, y1)), wide::Max(wide::Min(z0, z1), Zero()));
+        const Float exit = wide::Min(wide::Min(wide::Max(x0, x1), wide::Max(y0, y1)), wide::Min(wide::Max(z0, z1), closest));
+        const Float hit = And(CmpLe(enter, exit), CmpLt(enter, closest));
+        Lanes::Store(inOutT + i, Select(hit, enter, closest));
+        bits |= Lanes::Bits(hit) << i;
+    }
+    return bits;
+}
+
+template <int N>
+int RayPacket<N>::IntersectSphere(const Vector3& center, float radius, float* inOutT) const {
+    using namespace wide;
+    typedef RayLanes<N> Lanes;
+    const Float cx = wide::Set(center.x), cy = wide::Set(center.y), cz = wide::Set(center.z);
+    const Float radiusSquared = wide::Set(radius * radius);
+    const Float zero = Zero();
+    int bits = 0;
+    for (int i = 0; i < N; i += Lanes::Step) {
+        const Float ox = Sub(Lanes::Load(originX + i), cx), oy = Sub(Lanes::Load(originY + i), cy), oz = Sub(Lanes::Load(originZ + i), cz);
+        const Float dx = Lanes::Load(directionX + i), dy = Lanes::Load(directionY + i), dz = Lanes::Load(directionZ + i);
+        const Float closest = Lanes::Load(inOutT + i);
+        const Float a = Add(Add(Mul(dx, dx), Mul(dy, dy)), Mul(dz, dz));
+        const Float b = Add(Add(Mul(ox, dx), Mul(oy, dy)), Mul(oz, dz));
+        const Float c = Sub(Add(Add(Mul(ox, ox), Mul(oy, oy)), Mul(oz, oz)), radiusSquared);
+        const Float discriminant = Sub(Mul(b, b), Mul(a, c));
+        const Float root = wide::Sqrt(wide::Max(discriminant, zero));
+        const Float inverseA = Div(wide::Set(1.0f), a);
+        const Float tNear = Mul(Sub(Negate(b), root), inverseA);
+        const Float tFar = Mul(Sub(root, b), inverseA);
+        const Float t = Select(CmpGe(tNear, zero), tNear, tFar);
+        const Float hit = And(CmpGe(discriminant, zero), And(CmpGe(t, zero), CmpLt(t, closest)));
+        Lanes::Store(inOutT + i, Select(hit, t, closest));
+        bits |= Lanes::Bits(hit) << i;
+    }
+    return bits;
+}
+
+template class RayPacket<4>;
+template class RayPacket<8>;
+
+XOMATH_END_XO_NS();
\ No newline at end of file
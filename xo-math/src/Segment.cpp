@@ -0,0 +1,146 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+Vector3 Segment::ClosestPoint(const Vector3& point) const {
+    const Vector3 direction = end - start;
+    const float lengthSquared = direction.MagnitudeSquared();
+    if (lengthSquared <= 0.0f) {
+        return start;
+    }
+    return start + direction * Clamp((point - start).Dot(direction) / lengthSquared, 0.0f, 1.0f);
+}
+
+float Segment::ClosestPoints(const Segment& segment, Vector3& outPoint, Vector3& outSegmentPoint) const {
+    // s and t are how far along this segment and segment the closest points are.
+    const Vector3 d1 = end - start, d2 = segment.end - segment.start, r = start - segment.start;
+    const float a = d1.MagnitudeSquared(), e = d2.MagnitudeSquared(), f = d2.Dot(r);
+    float s, t;
+    if (a <= 0.0f && e <= 0.0f) {
+        s = t = 0.0f;
+    }
+    else if (a <= 0.0f) {
+        s = 0.0f;
+        t = Clamp(f / e, 0.0f, 1.0f);
+    }
+    else {
+        const float c = d1.Dot(r);
+        if (e <= 0.0f) {
+            t = 0.0f;
+            s = Clamp(-c / a, 0.0f, 1.0f);
+        }
+        else {
+            // the closest points of the infinite lines, with s clamped to this segment and t following it. If that 
+            // takes t off the other segment, t is clamped and s found again from it.
+            const float b = d1.Dot(d2);
+            const float denominator = a * e - b * b;
+            s = denominator != 0.0f ? Clamp((b * f - c * e) / denominator, 0.0f, 1.0f) : 0.0f;
+            t = (b * s + f) / e;
+            if (t < 0.0f) {
+                t = 0.0f;
+                s = Clamp(-c / a, 0.0f, 1.0f);
+            }
+            else if (t > 1.0f) {
+                t = 1.0f;
+                s = Clamp((b - c) / a, 0.0f, 1.0f);
+            }
+        }
+    }
+    outPoint = start + d1 * s;
+    outSegmentPoint = segment.start + d2 * t;
+    return (outPoint - outSegmentPoint).MagnitudeSquared();
+}
+
+void Segment::ClosestPoints(const Vector3Stream& points, const Vector3Stream& starts, const Vector3Stream& ends, Vector3Stream& outPoints, float* outDistancesSquared) {
+    XO_ASSERT(points.Size() == starts.Size() && points.Size() == ends.Size(), "xo-math Segment::ClosestPoints streams must be the same size.");
+    using namespace wide;
+    const size_t count = points.Size();
+    outPoints.Resize(count);
+    for (size_t i = 0; i < count; i += Width) {
+        const Float3 p = Load(points.X() + i, points.Y() + i, points.Z() + i);
+        const Float3 start = Load(starts.X() + i, starts.Y() + i, starts.Z() + i);
+        const Float3 direction = Sub(Load(ends.X() + i, ends.Y() + i, ends.Z() + i), start);
+        // a segment with its ends together divides zero by zero, which Saturate takes to its start.
+        const Float t = Saturate(Div(Dot(Sub(p, start), direction), Dot(direction, direction)));
+        const Float3 closest = MulAdd(direction, t, start);
+        Store(outPoints.X() + i, outPoints.Y() + i, outPoints.Z() + i, closest);
+        if (outDistancesSquared) {
+            const Float3 offset = Sub(p, closest);
+            if (i + Width <= count) {
+                StoreUnaligned(outDistancesSquared + i, Dot(offset, offset));
+            }
+            else {
+                StorePartial(outDistancesSquared + i, Dot(offset, offset), count - i);
+            }
+        }
+    }
+}
+
+void Segment::ClosestPoints(const Vector3Stream& starts1, const Vector3Stream& ends1, const Vector3Stream& starts2, const Vector3Stream& ends2, 
+                            Vector3Stream& outPoints1, Vector3Stream& outPoints2, float* outDistancesSquared) {
+    XO_ASSERT(starts1.Size() == ends1.Size() && starts1.Size() == starts2.Size() && starts1.Size() == ends2.Size(), 
+              "xo-math Segment::ClosestPoints streams must be the same size.");
+    using namespace wide;
+    const size_t count = starts1.Size();
+    outPoints1.Resize(count);
+    outPoints2.Resize(count);
+    const Float one = wide::Set(1.0f);
+    for (size_t i = 0; i < count; i += Width) {
+        const Float3 p1 = Load(starts1.X() + i, starts1.Y() + i, starts1.Z() + i);
+        const Float3 p2 = Load(starts2.X() + i, starts2.Y() + i, starts2.Z() + i);
+        const Float3 d1 = Sub(Load(ends1.X() + i, ends1.Y() + i, ends1.Z() + i), p1);
+        const Float3 d2 = Sub(Load(ends2.X() + i, ends2.Y() + i, ends2.Z() + i), p2);
+        const Float3 r = Sub(p1, p2);
+        const Float a = Dot(d1, d1), b = Dot(d1, d2), c = Dot(d1, r), e = Dot(d2, d2), f = Dot(d2, r);
+
+        // Every case of Segment::ClosestPoints is computed and the right one selected per lane. Where a case divides 
+        // zero by zero the NaN is clamped to 0 by Saturate, which is the value the scalar code picks for it.
+        Float s = Saturate(Div(NegMulAdd(c, e, Mul(b, f)), NegMulAdd(b, b, Mul(a, e))));
+        Float t = Div(MulAdd(b, s, f), e);
+        const Float sAtStart = Saturate(Div(Negate(c), a)), sAtEnd = Saturate(Div(Sub(b, c), a));
+        s = Select(CmpLt(t, Zero()), sAtStart, Select(CmpGt(t, one), sAtEnd, s));
+        // the second segment is a point: t is NaN, so neither compare above held.
+        s = Select(CmpLe(e, Zero()), sAtStart, s);
+        t = Saturate(t);
+
+        const Float3 closest1 = MulAdd(d1, s, p1), closest2 = MulAdd(d2, t, p2);
+        Store(outPoints1.X() + i, outPoints1.Y() + i, outPoints1.Z() + i, closest1);
+        Store(outPoints2.X() + i, outPoints2.Y() + i, outPoints2.Z() + i, closest2);
+        if (outDistancesSquared) {
+            const Float3 offset = Sub(closest1, closest2);
+            if (i + Width <= count) {
+                StoreUnaligned(outDistancesSquared + i, Dot(offset, offset));
+            }
+            else {
+                StorePartial(outDistancesSquared + i, Dot(offset, offset), count - i);
+            }
+        }
+    }
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,385 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+namespace
+{
+    // Each thread skins at least this many vertices.
+    const size_t SkinningThreadShare = 1 << 14;
+
+    // Calls kernel(begin, end) over count vertices, split into ranges that start on a multiple of wide::Width so that 
+    // threads never share a block of a stream.
+    template <class Kernel>
+    void SkinningRun(size_t count, unsigned threadCount, const Kernel& kernel) {
+        const unsigned threads = xo_internal::ThreadCount(threadCount, count, SkinningThreadShare);
+        const size_t blocks = (count + wide::Width - 1) / wide::Width;
+        xo_internal::Parallel(threads, [&](unsigned t) {
+            const size_t begin = blocks * t / threads * wide::Width;
+            const size_t end = _XO_MIN(blocks * (t + 1) / threads * wide::Width, count);
+            kernel(begin, end);
+        });
+    }
+
+    // v rotated by the unit quaternion q, for wide::Width vectors: t = 2 * cross(q, v), v' = v + q.w * t + cross(q, t)
+    _XOINL wide::Float3 SkinningRotate(wide::Float qx, wide::Float qy, wide::Float qz, wide::Float qw, const wide::Float3& v) {
+        using namespace wide;
+        Float tx = Sub(Mul(qy, v.z), Mul(qz, v.y));
+        Float ty = Sub(Mul(qz, v.x), Mul(qx, v.z));
+        Float tz = Sub(Mul(qx, v.y), Mul(qy, v.x));
+        tx = Add(tx, tx);
+        ty = Add(ty, ty);
+        tz = Add(tz, tz);
+        Float3 r;
+        r.x = Add(MulAdd(qw, tx, v.x), Sub(Mul(qy, tz), Mul(qz, ty)));
+        r.y = Add(MulAdd(qw, ty, v.y), Sub(Mul(qz, tx), Mul(qx, tz)));
+        r.z = Add(MulAdd(qw, tz, v.z), Sub(Mul(qx, ty), Mul(qy, tx)));
+        return r;
+    }
+
+    // Blends dual quaternions. Each vertex's blend is 8 floats, real then dual.
+    struct SkinningDualQuaternions {
+        static const int Floats = 8;
+
+        // The weighted sum of the dual quaternions of one vertex's bones. Bones whose real part is more than 90 degrees 
+        // from the first bone's are negated, so every bone rotates the short way.
+        _XOINL void Blend(const uint16_t* indices, const float* weights, float* out) const {
+            const DualQuaternion& first = palette[indices[0]];
+#if defined(XO_SSE)
+            // The sign of each dot product is moved onto the weight without leaving the registers.
+            const __m128 w = _mm_set1_ps(weights[0]), sign = _mm_set1_ps(-0.0f);
+            __m128 real = _mm_mul_ps(w, first.real.xmm), dual = _mm_mul_ps(w, first.dual.xmm);
+            for (int i = 1; i < Skinning::Influences; ++i) {
+                const DualQuaternion& q = palette[indices[i]];
+                __m128 dot = _mm_mul_ps(first.real.xmm, q.real.xmm);
+                dot = _mm_add_ps(dot, _mm_shuffle_ps(dot, dot, _MM_SHUFFLE(2, 3, 0, 1)));
+                dot = _mm_add_ps(dot, _mm_shuffle_ps(dot, dot, _MM_SHUFFLE(1, 0, 3, 2)));
+                const __m128 wi = _mm_xor_ps(_mm_set1_ps(weights[i]), _mm_and_ps(dot, sign));
+                real = sse::MulAdd(wi, q.real.xmm, real);
+                dual = sse::MulAdd(wi, q.dual.xmm, dual);
+            }
+            _mm_store_ps(out, real);
+            _mm_store_ps(out + 4, dual);
+#else
+            for (int c = 0; c < 4; ++c) {
+                out[c] = first.real.f[c] * weights[0];
+                out[c + 4] = first.dual.f[c] * weights[0];
+            }
+            for (int i = 1; i < Skinning::Influences; ++i) {
+                const DualQuaternion& q = palette[indices[i]];
+                const float dot = first.real.x * q.real.x + first.real.y * q.real.y + first.real.z * q.real.z + first.real.w * q.real.w;
+                const float wi = dot < 0.0f ? -weights[i] : weights[i];
+                for (int c = 0; c < 4; ++c) {
+                    out[c] += q.real.f[c] * wi;
+                    out[c + 4] += q.dual.f[c] * wi;
+                }
+            }
+#endif
+        }
+
+        // The blend of the lanes past the last vertex, which must normalize.
+        _XOINL void Padding(float* out) const {
+            memcpy(out, &DualQuaternion::Identity, sizeof(float) * Floats);
+        }
+
+        // The rotation and translation of wide::Width blends.
+        struct Lanes {
+            wide::Float rx, ry, rz, rw, tx, ty, tz;
+        };
+
+        // Normalizes by the magnitude of the real part, then takes the translation as 
+        // 2 * (real.w * dual.xyz - dual.w * real.xyz + real.xyz x dual.xyz).
+        _XOINL void Load(const float* blended, Lanes& l) const {
+            using namespace wide;
+            Float dx, dy, dz, dw;
+            LoadTransposed4(blended, Floats, l.rx, l.ry, l.rz, l.rw);
+            LoadTransposed4(blended + 4, Floats, dx, dy, dz, dw);
+            const Float inverseMagnitude = Rsqrt(MulAdd(l.rw, l.rw, MulAdd(l.rz, l.rz, MulAdd(l.ry, l.ry, Mul(l.rx, l.rx)))));
+            l.rx = Mul(l.rx, inverseMagnitude);
+            l.ry = Mul(l.ry, inverseMagnitude);
+            l.rz = Mul(l.rz, inverseMagnitude);
+            l.rw = Mul(l.rw, inverseMagnitude);
+            const Float twice = Add(inverseMagnitude, inverseMagnitude);
+            dx = Mul(dx, twice);
+            dy = Mul(dy, twice);
+            dz = Mul(dz, twice);
+            dw = Mul(dw, twice);
+            l.tx = Add(Sub(Mul(l.rw, dx), Mul(dw, l.rx)), Sub(Mul(l.ry, dz), Mul(l.rz, dy)));
+            l.ty = Add(Sub(Mul(l.rw, dy), Mul(dw, l.ry)), Sub(Mul(l.rz, dx), Mul(l.rx, dz)));
+            l.tz = Add(Sub(Mul(l.rw, dz), Mul(dw, l.rz)), Sub(Mul(l.rx, dy), Mul(l.ry, dx)));
+        }
+
+        _XOINL wide::Float3 Point(const Lanes& l, const wide::Float3& v) const {
+            wide::Float3 r = SkinningRotate(l.rx, l.ry, l.rz, l.rw, v);
+            r.x = wide::Add(r.x, l.tx);
+            r.y = wide::Add(r.y, l.ty);
+            r.z = wide::Add(r.z, l.tz);
+            return r;
+        }
+
+        _XOINL wide::Float3 Direction(const Lanes& l, const wide::Float3& v) const {
+            return SkinningRotate(l.rx, l.ry, l.rz, l.rw, v);
+        }
+
+        const DualQuaternion* palette;
+    };
+
+    // Blends the top three rows of Matrix3x4 or Matrix4x4 palettes. Each vertex's blend is 12 floats, row by row.
+    template <class Matrix>
+    struct SkinningMatrices {
+        static const int Floats = 12;
+
+        // The weighted sum of the matrices of one vertex's bones, a row at a time.
+        _XOINL void Blend(const uint16_t* indices, const float* weights, float* out) const {
+#if defined(XO_SSE)
+            const Matrix& first = palette[indices[0]];
+            const __m128 w = _mm_set1_ps(weights[0]);
+            __m128 r0 = _mm_mul_ps(w, first.r[0].xmm), r1 = _mm_mul_ps(w, first.r[1].xmm), r2 = _mm_mul_ps(w, first.r[2].xmm);
+            for (int i = 1; i < Skinning::Influences; ++i) {
+                const Matrix& m = palette[indices[i]];
+                const __m128 wi = _mm_set1_ps(weights[i]);
+                r0 = sse::MulAdd(wi, m.r[0].xmm, r0);
+                r1 = sse::MulAdd(wi, m.r[1].xmm, r1);
+                r2 = sse::MulAdd(wi, m.r[2].xmm, r2);
+            }
+            _mm_store_ps(out, r0);
+            _mm_store_ps(out + 4, r1);
+            _mm_store_ps(out + 8, r2);
+#else
+            for (int c = 0; c < Floats; ++c) {
+                out[c] = palette[indices[0]].m[c] * weights[0];
+            }
+            for (int i = 1; i < Skinning::Influences; ++i) {
+                const Matrix& m = palette[indices[i]];
+                for (int c = 0; c < Floats; ++c) {
+                    out[c] += m.m[c] * weights[i];
+                }
+            }
+#endif
+        }
+
+        _XOINL void Padding(float* out) const {
+            memset(out, 0, sizeof(float) * Floats);
+        }
+
+        struct Lanes {
+            wide::Float m[12];
+        };
+
+        _XOINL void Load(const float* blended, Lanes& l) const {
+            wide::LoadTransposed4(blended, Floats, l.m[0], l.m[1], l.m[2], l.m[3]);
+            wide::LoadTransposed4(blended + 4, Floats, l.m[4], l.m[5], l.m[6], l.m[7]);
+            wide::LoadTransposed4(blended + 8, Floats, l.m[8], l.m[9], l.m[10], l.m[11]);
+        }
+
+        _XOINL wide::Float3 Point(const Lanes& l, const wide::Float3& v) const {
+            using namespace wide;
+            Float3 r;
+            r.x = MulAdd(l.m[2], v.z, MulAdd(l.m[1], v.y, MulAdd(l.m[0], v.x, l.m[3])));
+            r.y = MulAdd(l.m[6], v.z, MulAdd(l.m[5], v.y, MulAdd(l.m[4], v.x, l.m[7])));
+            r.z = MulAdd(l.m[10], v.z, MulAdd(l.m[9], v.y, MulAdd(l.m[8], v.x, l.m[11])));
+            return r;
+        }
+
+        _XOINL wide::Float3 Direction(const Lanes& l, const wide::Float3& v) const {
+            using namespace wide;
+            Float3 r;
+            r.x = MulAdd(l.m[2], v.z, MulAdd(l.m[1], v.y, Mul(l.m[0], v.x)));
+            r.y = MulAdd(l.m[6], v.z, MulAdd(l.m[5], v.y, Mul(l.m[4], v.x)));
+            r.z = MulAdd(l.m[10], v.z, MulAdd(l.m[9], v.y, Mul(l.m[8], v.x)));
+            return r;
+        }
+
+        const Matrix* palette;
+    };
+
+    // Reads and writes wide::Width vertices of Vector3Streams. Streams are padded to whole blocks, so the last block is 
+    // read and written whole whatever the count.
+    struct SkinningStreams {
+        _XOINL wide::Float3 Load(size_t i, size_t /*lanes*/) const {
+            return wide::Load(in->X() + i, in->Y() + i, in->Z() + i);
+        }
+        _XOINL void Store(size_t i, size_t /*lanes*/, const wide::Float3& v) const {
+            wide::Store(out->X() + i, out->Y() + i, out->Z() + i, v);
+        }
+        const Vector3Stream* in;
+        Vector3Stream* out;
+    };
+
+    // Reads and writes wide::Width vertices of interleaved Vector3 arrays, transposing them on the way. A partial last 
+    // block goes through a copy rather than past the end of the arrays.
+    struct SkinningArrays {
+        _XOINL wide::Float3 Load(size_t i, size_t lanes) const {
+#if defined(XO_SSE)
+            if (lanes == (size_t)wide::Width) {
+                wide::Float3 v;
+                wide::Float w;
+                wide::LoadTransposed4(&in[i].x, 4, v.x, v.y, v.z, w);
+                return v;
+            }
+#endif
+            _XOSIMDALIGN32 float x[wide::Width] = { }, y[wide::Width] = { }, z[wide::Width] = { };
+            for (size_t lane = 0; lane < lanes; ++lane) {
+                x[lane] = in[i + lane].x;
+                y[lane] = in[i + lane].y;
+                z[lane] = in[i + lane].z;
+            }
+            return wide::Load(x, y, z);
+        }
+        _XOINL void Store(size_t i, size_t lanes, const wide::Float3& v) const {
+#if defined(XO_SSE)
+            if (lanes == (size_t)wide::Width) {
+                wide::StoreTransposed4(&out[i].x, 4, v.x, v.y, v.z, wide::Zero());
+                return;
+            }
+#endif
+            _XOSIMDALIGN32 float x[wide::Width], y[wide::Width], z[wide::Width];
+            wide::Store(x, y, z, v);
+            for (size_t lane = 0; lane < lanes; ++lane) {
+                out[i + lane].x = x[lane];
+                out[i + lane].y = y[lane];
+                out[i + lane].z = z[lane];
+            }
+        }
+        const Vector3* in;
+        Vector3* out;
+    };
+
+    // Skins vertices begin to end: the bones of each vertex are blended in place, the blends of wide::Width vertices 
+    // transposed into one register per component, then applied to the positions and, when given, the normals.
+    template <class Skin, class IO>
+    void SkinningKernel(const Skin& skin, const uint16_t* boneIndices, const float* boneWeights, 
+                        const IO& positions, const IO* normals, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i += wide::Width) {
+            const size_t lanes = _XO_MIN(end - i, (size_t)wide::Width);
+            _XOSIMDALIGN32 float blended[wide::Width * Skin::Floats];
+            for (size_t lane = 0; lane < (size_t)wide::Width; ++lane) {
+                if (lane < lanes) {
+                    const size_t v = (i + lane) * Skinning::Influences;
+                    skin.Blend(boneIndices + v, boneWeights + v, blended + lane * Skin::Floats);
+                }
+                else {
+                    skin.Padding(blended + lane * Skin::Floats);
+                }
+            }
+            typename Skin::Lanes l;
+            skin.Load(blended, l);
+            positions.Store(i, lanes, skin.Point(l, positions.Load(i, lanes)));
+            if (normals) {
+                normals->Store(i, lanes, skin.Direction(l, normals->Load(i, lanes)));
+            }
+        }
+    }
+
+    template <class Skin>
+    void SkinningStreamsRun(const Skin& skin, const uint16_t* boneIndices, const float* boneWeights, 
+                            const Vector3Stream& positions, const Vector3Stream* normals, 
+                            Vector3Stream& outPositions, Vector3Stream* outNormals, unsigned threadCount) {
+        XO_ASSERT(!normals || normals->Size() == positions.Size(), "xo-math Skinning normals and positions differ in size.");
+        const size_t count = positions.Size();
+        outPositions.Resize(count);
+        if (outNormals) {
+            outNormals->Resize(count);
+        }
+        const SkinningStreams p = { &positions, &outPositions }, n = { normals, outNormals };
+        SkinningRun(count, threadCount, [&](size_t begin, size_t end) {
+            SkinningKernel(skin, boneIndices, boneWeights, p, normals ? &n : nullptr, begin, end);
+        });
+    }
+
+    template <class Skin>
+    void SkinningArraysRun(const Skin& skin, const uint16_t* boneIndices, const float* boneWeights, 
+                           const Vector3* positions, const Vector3* normals, 
+                           Vector3* outPositions, Vector3* outNormals, size_t count, unsigned threadCount) {
+        XO_ASSERT(!normals == !outNormals, "xo-math Skinning normals and outNormals must both be given or both be null.");
+        const SkinningArrays p = { positions, outPositions }, n = { normals, outNormals };
+        SkinningRun(count, threadCount, [&](size_t begin, size_t end) {
+            SkinningKernel(skin, boneIndices, boneWeights, p, normals ? &n : nullptr, begin, end);
+        });
+    }
+}
+
+void Skinning::DualQuaternionBlend(const DualQuaternion* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                                   const Vector3Stream& positions, const Vector3Stream& normals, 
+                                   Vector3Stream& outPositions, Vector3Stream& outNormals, unsigned threadCount) {
+    const SkinningDualQuaternions skin = { palette };
+    SkinningStreamsRun(skin, boneIndices, boneWeights, positions, &normals, outPositions, &outNormals, threadCount);
+}
+
+void Skinning::DualQuaternionBlend(const DualQuaternion* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                                   const Vector3Stream& positions, Vector3Stream& outPositions, unsigned threadCount) {
+    const SkinningDualQuaternions skin = { palette };
+    SkinningStreamsRun(skin, boneIndices, boneWeights, positions, nullptr, outPositions, nullptr, threadCount);
+}
+
+void Skinning::DualQuaternionBlend(const DualQuaternion* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                                   const Vector3* positions, const Vector3* normals, Vector3* outPositions, Vector3* outNormals, 
+                                   size_t count, unsigned threadCount) {
+    const SkinningDualQuaternions skin = { palette };
+    SkinningArraysRun(skin, boneIndices, boneWeights, positions, normals, outPositions, outNormals, count, threadCount);
+}
+
+void Skinning::LinearBlend(const Matrix3x4* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                           const Vector3Stream& positions, const Vector3Stream& normals, 
+                           Vector3Stream& outPositions, Vector3Stream& outNormals, unsigned threadCount) {
+    const SkinningMatrices<Matrix3x4> skin = { palette };
+    SkinningStreamsRun(skin, boneIndices, boneWeights, positions, &normals, outPositions, &outNormals, threadCount);
+}
+
+void Skinning::LinearBlend(const Matrix3x4* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                           const Vector3Stream& positions, Vector3Stream& outPositions, unsigned threadCount) {
+    const SkinningMatrices<Matrix3x4> skin = { palette };
+    SkinningStreamsRun(skin, boneIndices, boneWeights, positions, nullptr, outPositions, nullptr, threadCount);
+}
+
+void Skinning::LinearBlend(const Matrix3x4* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                           const Vector3* positions, const Vector3* normals, Vector3* outPositions, Vector3* outNormals, 
+                           size_t count, unsigned threadCount) {
+    const SkinningMatrices<Matrix3x4> skin = { palette };
+    SkinningArraysRun(skin, boneIndices, boneWeights, positions, normals, outPositions, outNormals, count, threadCount);
+}
+
+void Skinning::LinearBlend(const Matrix4x4* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                           const Vector3Stream& positions, const Vector3Stream& normals, 
+                           Vector3Stream& outPositions, Vector3Stream& outNormals, unsigned threadCount) {
+    const SkinningMatrices<Matrix4x4> skin = { palette };
+    SkinningStreamsRun(skin, boneIndices, boneWeights, positions, &normals, outPositions, &outNormals, threadCount);
+}
+
+void Skinning::LinearBlend(const Matrix4x4* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                           const Vector3Stream& positions, Vector3Stream& outPositions, unsigned threadCount) {
+    const SkinningMatrices<Matrix4x4> skin = { palette };
+    SkinningStreamsRun(skin, boneIndices, boneWeights, positions, nullptr, outPositions, nullptr, threadCount);
+}
+
+void Skinning::LinearBlend(const Matrix4x4* palette, const uint16_t* boneIndices, const float* boneWeights, 
+                           const Vector3* positions, const Vector3* normals, Vector3* outPositions, Vector3* outNormals, 
+                           size_t count, unsigned threadCount) {
+    const SkinningMatrices<Matrix4x4> skin = { palette };
+    SkinningArraysRun(skin, boneIndices, boneWeights, positions, normals, outPositions, outNormals, count, threadCount);
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,371 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+namespace
+{
+    // Each thread gets at least this many points.
+    const size_t GridThreadShare = 1 << 14;
+    // The table has a bucket per point, rounded up to a power of two, and never fewer than this.
+    const size_t GridMinBuckets = 16;
+    // Queries over up to this many cells track the buckets they've seen on the stack.
+    const size_t GridStackCells = 64;
+    // Cell coordinates are clamped to this, so far away points don't overflow an int.
+    const float GridMaxCell = 1073741824.0f;
+
+    // The cell coordinate of f, already divided by the cell size: floor(f).
+    _XOINL int GridCell(float f) {
+        f = _XO_MIN(_XO_MAX(f, -GridMaxCell), GridMaxCell);
+        const int i = (int)f;
+        return i - (f < (float)i ? 1 : 0);
+    }
+
+    struct GridArrayPoints {
+        const Vector3* points;
+        float X(size_t i) const { return points[i].x; }
+        float Y(size_t i) const { return points[i].y; }
+        float Z(size_t i) const { return points[i].z; }
+    };
+
+    struct GridStreamPoints {
+        const float* x;
+        const float* y;
+        const float* z;
+        float X(size_t i) const { return x[i]; }
+        float Y(size_t i) const { return y[i]; }
+        float Z(size_t i) const { return z[i]; }
+    };
+
+    // Writes the points from begin to end that are within the radius of the center, wide::Width at a time. The arrays 
+    // are padded, so the last group is loaded whole and its lanes past end are dropped.
+    size_t GridTestRange(const float* x, const float* y, const float* z, const uint32_t* indices, size_t begin, size_t end, 
+                         wide::Float centerX, wide::Float centerY, wide::Float centerZ, wide::Float radiusSquared, uint32_t* outIndices) {
+        using namespace wide;
+        size_t found = 0;
+        for (size_t i = begin; i < end; i += Width) {
+            const Float dx = Sub(LoadUnaligned(x + i), centerX);
+            const Float dy = Sub(LoadUnaligned(y + i), centerY);
+            const Float dz = Sub(LoadUnaligned(z + i), centerZ);
+            int bits = MoveMask(CmpLe(MulAdd(dz, dz, MulAdd(dy, dy, Mul(dx, dx))), radiusSquared));
+            if (end - i < (size_t)Width) {
+                bits &= LaneBits((int)(end - i));
+            }
+            // Every lane up to the last one found is written without a branch, and only kept when it's inside. Which 
+            // lanes are inside is random, so branching on each costs more than the extra writes. None of the writes 
+            // pass the last point found.
+            for (int lane = 0; bits; ++lane, bits >>= 1) {
+                outIndices[found] = indices[i + lane];
+                found += bits & 1;
+            }
+        }
+        return found;
+    }
+}
+
+SpatialHashGrid::SpatialHashGrid() : 
+    x(nullptr), y(nullptr), z(nullptr), indices(nullptr), pointBuckets(nullptr), bucketStarts(nullptr), threadCounts(nullptr), 
+    pointCapacity(0), bucketCapacity(0), threadCountsCapacity(0), pointCount(0), bucketCount(0), cellSize(1.0f), inverseCellSize(1.0f)
+{
+}
+
+SpatialHashGrid::SpatialHashGrid(const SpatialHashGrid& grid) : SpatialHashGrid() {
+    *this = grid;
+}
+
+SpatialHashGrid::SpatialHashGrid(SpatialHashGrid&& grid) : SpatialHashGrid() {
+    *this = std::move(grid);
+}
+
+SpatialHashGrid::~SpatialHashGrid() {
+    Release();
+}
+
+SpatialHashGrid& SpatialHashGrid::operator = (const SpatialHashGrid& grid) {
+    if (this != &grid) {
+        Reserve(grid.pointCount, grid.bucketCount, 0);
+        pointCount = grid.pointCount;
+        bucketCount = grid.bucketCount;
+        cellSize = grid.cellSize;
+        inverseCellSize = grid.inverseCellSize;
+        if (pointCount) {
+            memcpy(x, grid.x, pointCount * sizeof(float));
+            memcpy(y, grid.y, pointCount * sizeof(float));
+            memcpy(z, grid.z, pointCount * sizeof(float));
+            memcpy(indices, grid.indices, pointCount * sizeof(uint32_t));
+        }
+        if (bucketCount) {
+            memcpy(bucketStarts, grid.bucketStarts, (bucketCount + 1) * sizeof(uint32_t));
+        }
+    }
+    return *this;
+}
+
+SpatialHashGrid& SpatialHashGrid::operator = (SpatialHashGrid&& grid) {
+    if (this != &grid) {
+        Release();
+        x = grid.x;
+        y = grid.y;
+        z = grid.z;
+        indices = grid.indices;
+        pointBuckets = grid.pointBuckets;
+        bucketStarts = grid.bucketStarts;
+        threadCounts = grid.threadCounts;
+        pointCapacity = grid.pointCapacity;
+        bucketCapacity = grid.bucketCapacity;
+        threadCountsCapacity = grid.threadCountsCapacity;
+        pointCount = grid.pointCount;
+        bucketCount = grid.bucketCount;
+        cellSize = grid.cellSize;
+        inverseCellSize = grid.inverseCellSize;
+        grid.x = grid.y = grid.z = nullptr;
+        grid.indices = grid.pointBuckets = grid.bucketStarts = grid.threadCounts = nullptr;
+        grid.pointCapacity = grid.bucketCapacity = grid.threadCountsCapacity = grid.pointCount = grid.bucketCount = 0;
+    }
+    return *this;
+}
+
+uint32_t SpatialHashGrid::Bucket(int x, int y, int z) const {
+    // Each coordinate times a large odd constant, then the finishing mix of MurmurHash3 so the low bits the table uses 
+    // depend on every bit. The well known xor of three primes puts whole runs of nearby cells in one bucket.
+    uint32_t hash = (uint32_t)x * 0x8da6b343u + (uint32_t)y * 0xd8163841u + (uint32_t)z * 0xcb1ab31fu;
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+    return hash & (uint32_t)(bucketCount - 1);
+}
+
+void SpatialHashGrid::Reserve(size_t points, size_t buckets, unsigned threads) {
+    // room for a whole group past the last point, rounded up to keep each array aligned.
+    const size_t paddedPoints = (points + wide::Width + 15) & ~(size_t)15;
+    if (paddedPoints > pointCapacity) {
+        if (x) {
+            XO_ALIGNED_FREE(x);
+        }
+        x = (float*)XO_ALIGNED_MALLOC(paddedPoints * 5 * sizeof(float), 64);
+        y = x + paddedPoints;
+        z = y + paddedPoints;
+        indices = (uint32_t*)(z + paddedPoints);
+        pointBuckets = indices + paddedPoints;
+        pointCapacity = paddedPoints;
+    }
+    if (buckets + 1 > bucketCapacity) {
+        if (bucketStarts) {
+            XO_ALIGNED_FREE(bucketStarts);
+        }
+        bucketStarts = (uint32_t*)XO_ALIGNED_MALLOC((buckets + 1) * sizeof(uint32_t), 64);
+        bucketCapacity = buckets + 1;
+    }
+    if (buckets * threads > threadCountsCapacity) {
+        if (threadCounts) {
+            XO_ALIGNED_FREE(threadCounts);
+        }
+        threadCounts = (uint32_t*)XO_ALIGNED_MALLOC(buckets * threads * sizeof(uint32_t), 64);
+        threadCountsCapacity = buckets * threads;
+    }
+}
+
+void SpatialHashGrid::Release() {
+    if (x) {
+        XO_ALIGNED_FREE(x);
+    }
+    if (bucketStarts) {
+        XO_ALIGNED_FREE(bucketStarts);
+    }
+    if (threadCounts) {
+        XO_ALIGNED_FREE(threadCounts);
+    }
+    x = y = z = nullptr;
+    indices = pointBuckets = bucketStarts = threadCounts = nullptr;
+    pointCapacity = bucketCapacity = threadCountsCapacity = pointCount = bucketCount = 0;
+}
+
+void SpatialHashGrid::Clear() {
+    pointCount = bucketCount = 0;
+}
+
+template <class Points>
+void SpatialHashGrid::BuildPoints(const Points& points, size_t count, float cellSize, unsigned threadCount) {
+    XO_ASSERT(cellSize > 0.0f, "xo-math SpatialHashGrid::Build cell size must be positive.");
+    XO_ASSERT(count < 0xffffffffu, "xo-math SpatialHashGrid::Build too many points for 32 bit indices.");
+    size_t buckets = GridMinBuckets;
+    while (buckets < count) {
+        buckets <<= 1;
+    }
+    const unsigned threads = xo_internal::ThreadCount(threadCount, count, GridThreadShare);
+    Reserve(count, buckets, threads);
+    pointCount = count;
+    bucketCount = buckets;
+    this->cellSize = cellSize;
+    inverseCellSize = 1.0f / cellSize;
+
+    // A counting sort split between the threads. Each thread counts the points of its share per bucket, then the 
+    // buckets are split between the threads to find where each thread's points of each bucket go. The points of a 
+    // bucket end up in input order, whatever the number of threads.
+    const size_t share = (count + threads - 1) / threads;
+    const size_t bucketShare = (buckets + threads - 1) / threads;
+    size_t rangeStarts[xo_internal::MaxThreads];
+    xo_internal::Parallel(threads, [&](unsigned t) {
+        uint32_t* counts = threadCounts + t * buckets;
+        memset(counts, 0, buckets * sizeof(uint32_t));
+        const size_t end = _XO_MIN(share * (t + 1), count);
+        for (size_t i = share * t; i < end; ++i) {
+            const uint32_t bucket = Bucket(GridCell(points.X(i) * inverseCellSize), GridCell(points.Y(i) * inverseCellSize), 
+                                           GridCell(points.Z(i) * inverseCellSize));
+            pointBuckets[i] = bucket;
+            ++counts[bucket];
+        }
+    });
+    xo_internal::Parallel(threads, [&](unsigned t) {
+        size_t total = 0;
+        const size_t end = _XO_MIN(bucketShare * (t + 1), buckets);
+        for (size_t b = bucketShare * t; b < end; ++b) {
+            for (unsigned u = 0; u < threads; ++u) {
+                total += threadCounts[u * buckets + b];
+            }
+        }
+        rangeStarts[t] = total;
+    });
+    size_t start = 0;
+    for (unsigned t = 0; t < threads; ++t) {
+        const size_t total = rangeStarts[t];
+        rangeStarts[t] = start;
+        start += total;
+    }
+    xo_internal::Parallel(threads, [&](unsigned t) {
+        uint32_t next = (uint32_t)rangeStarts[t];
+        const size_t end = _XO_MIN(bucketShare * (t + 1), buckets);
+        for (size_t b = bucketShare * t; b < end; ++b) {
+            bucketStarts[b] = next;
+            for (unsigned u = 0; u < threads; ++u) {
+                const uint32_t counted = threadCounts[u * buckets + b];
+                threadCounts[u * buckets + b] = next;
+                next += counted;
+            }
+        }
+    });
+    bucketStarts[buckets] = (uint32_t)count;
+    xo_internal::Parallel(threads, [&](unsigned t) {
+        uint32_t* next = threadCounts + t * buckets;
+        const size_t end = _XO_MIN(share * (t + 1), count);
+        for (size_t i = share * t; i < end; ++i) {
+            const uint32_t to = next[pointBuckets[i]]++;
+            x[to] = points.X(i);
+            y[to] = points.Y(i);
+            z[to] = points.Z(i);
+            indices[to] = (uint32_t)i;
+        }
+    });
+}
+
+void SpatialHashGrid::Build(const Vector3* points, size_t count, float cellSize, unsigned threadCount) {
+    const GridArrayPoints array = { points };
+    BuildPoints(array, count, cellSize, threadCount);
+}
+
+void SpatialHashGrid::Build(const Vector3Stream& points, float cellSize, unsigned threadCount) {
+    const GridStreamPoints stream = { points.X(), points.Y(), points.Z() };
+    BuildPoints(stream, points.Size(), cellSize, threadCount);
+}
+
+size_t SpatialHashGrid::QueryRadius(const Vector3& center, float radius, uint32_t* outIndices, uint32_t* scratch) const {
+    if (pointCount == 0 || !(radius >= 0.0f)) {
+        return 0;
+    }
+    const wide::Float centerX = wide::Set(center.x), centerY = wide::Set(center.y), centerZ = wide::Set(center.z);
+    const wide::Float radiusSquared = wide::Set(radius * radius);
+    const int lowX = GridCell((center.x - radius) * inverseCellSize), highX = GridCell((center.x + radius) * inverseCellSize);
+    const int lowY = GridCell((center.y - radius) * inverseCellSize), highY = GridCell((center.y + radius) * inverseCellSize);
+    const int lowZ = GridCell((center.z - radius) * inverseCellSize), highZ = GridCell((center.z + radius) * inverseCellSize);
+    const double cells = ((double)highX - lowX + 1.0) * ((double)highY - lowY + 1.0) * ((double)highZ - lowZ + 1.0);
+    // once the cells outnumber the buckets by this much, testing every point is quicker than finding the buckets.
+    if (cells * 8.0 >= (double)bucketCount) {
+        return GridTestRange(x, y, z, indices, 0, pointCount, centerX, centerY, centerZ, radiusSquared, outIndices);
+    }
+
+    // Cells that hash to the same bucket must only have it tested once. Few cells are checked against each other, 
+    // many against a bit per bucket. The caller's scratch is cleared again once the query is done.
+    uint32_t seenBuckets[GridStackCells];
+    size_t seenCount = 0;
+    uint32_t* seen = nullptr;
+    if (cells > GridStackCells) {
+        if (scratch) {
+            seen = scratch;
+        }
+        else {
+            const size_t bytes = QueryScratchSize() * sizeof(uint32_t);
+            seen = (uint32_t*)XO_ALIGNED_MALLOC(bytes, 64);
+            memset(seen, 0, bytes);
+        }
+    }
+    size_t found = 0;
+    for (int cz = lowZ; cz <= highZ; ++cz) {
+        for (int cy = lowY; cy <= highY; ++cy) {
+            for (int cx = lowX; cx <= highX; ++cx) {
+                const uint32_t bucket = Bucket(cx, cy, cz);
+                const uint32_t begin = bucketStarts[bucket], end = bucketStarts[bucket + 1];
+                if (begin == end) {
+                    continue;
+                }
+                if (seen) {
+                    if (seen[bucket >> 5] & (1u << (bucket & 31))) {
+                        continue;
+                    }
+                    seen[bucket >> 5] |= 1u << (bucket & 31);
+                }
+                else {
+                    size_t s = 0;
+                    while (s < seenCount && seenBuckets[s] != bucket) {
+                        ++s;
+                    }
+                    if (s < seenCount) {
+                        continue;
+                    }
+                    seenBuckets[seenCount++] = bucket;
+                }
+                found += GridTestRange(x, y, z, indices, begin, end, centerX, centerY, centerZ, radiusSquared, outIndices + found);
+            }
+        }
+    }
+    if (seen && !scratch) {
+        XO_ALIGNED_FREE(seen);
+    }
+    else if (seen) {
+        for (int cz = lowZ; cz <= highZ; ++cz) {
+            for (int cy = lowY; cy <= highY; ++cy) {
+                for (int cx = lowX; cx <= highX; ++cx) {
+                    const uint32_t bucket = Bucket(cx, cy, cz);
+                    seen[bucket >> 5] &= ~(1u << (bucket & 31));
+                }
+            }
+        }
+    }
+    return found;
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -0,0 +1,213 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+const Transform Transform::Identity(Vector3(0.0f, 0.0f, 0.0f), Quaternion(0.0f, 0.0f, 0.0f, 1.0f), Vector3(1.0f, 1.0f, 1.0f));
+
+namespace
+{
+    // wide::Width transforms, one register per component. The w lanes of the translation and scale are loaded along 
+    // with everything else when compiled for SSE and are otherwise unused.
+    struct TransformLanes {
+        wide::Float tx, ty, tz, tw;
+        wide::Float qx, qy, qz, qw;
+        wide::Float sx, sy, sz, sw;
+    };
+
+    _XOCONSTEXPR const size_t TransformStride = sizeof(Transform) / sizeof(float);
+
+    _XOINL void TransformLoad(const Transform* t, TransformLanes& l) {
+#if defined(XO_SSE)
+        wide::LoadTransposed4(&t->translation.x, TransformStride, l.tx, l.ty, l.tz, l.tw);
+        wide::LoadTransposed4(&t->rotation.x, TransformStride, l.qx, l.qy, l.qz, l.qw);
+        wide::LoadTransposed4(&t->scale.x, TransformStride, l.sx, l.sy, l.sz, l.sw);
+#else
+        // Without SSE a Vector3 is three floats, so there's no fourth to load through.
+        l.tx = t->translation.x; l.ty = t->translation.y; l.tz = t->translation.z;
+        l.qx = t->rotation.x; l.qy = t->rotation.y; l.qz = t->rotation.z; l.qw = t->rotation.w;
+        l.sx = t->scale.x; l.sy = t->scale.y; l.sz = t->scale.z;
+#endif
+    }
+
+    // The three rows of the matrix of wide::Width transforms: the rotation matrix with each column multiplied by its 
+    // scale, and the translation in the fourth column.
+    _XOINL void TransformRows(const TransformLanes& l, wide::Float r[12]) {
+        using namespace wide;
+        const Float two = Set(2.0f), one = Set(1.0f);
+        const Float x2 = Mul(l.qx, two), y2 = Mul(l.qy, two), z2 = Mul(l.qz, two);
+        const Float xx = Mul(l.qx, x2), yy = Mul(l.qy, y2), zz = Mul(l.qz, z2);
+        const Float xy = Mul(l.qx, y2), xz = Mul(l.qx, z2), yz = Mul(l.qy, z2);
+        const Float wx = Mul(l.qw, x2), wy = Mul(l.qw, y2), wz = Mul(l.qw, z2);
+        r[0] = Mul(Sub(one, Add(yy, zz)), l.sx);
+        r[1] = Mul(Sub(xy, wz), l.sy);
+        r[2] = Mul(Add(xz, wy), l.sz);
+        r[3] = l.tx;
+        r[4] = Mul(Add(xy, wz), l.sx);
+        r[5] = Mul(Sub(one, Add(xx, zz)), l.sy);
+        r[6] = Mul(Sub(yz, wx), l.sz);
+        r[7] = l.ty;
+        r[8] = Mul(Sub(xz, wy), l.sx);
+        r[9] = Mul(Add(yz, wx), l.sy);
+        r[10] = Mul(Sub(one, Add(xx, yy)), l.sz);
+        r[11] = l.tz;
+    }
+
+    // Stores wide::Width matrices of rowCount rows each, stride floats apart, writing rows 0 to 2 from r and 
+    // 0, 0, 0, 1 to the fourth when there is one.
+    _XOINL void TransformStoreRows(float* f, size_t stride, int rowCount, const wide::Float r[12]) {
+        wide::StoreTransposed4(f, stride, r[0], r[1], r[2], r[3]);
+        wide::StoreTransposed4(f + 4, stride, r[4], r[5], r[6], r[7]);
+        wide::StoreTransposed4(f + 8, stride, r[8], r[9], r[10], r[11]);
+        if (rowCount == 4) {
+            wide::StoreTransposed4(f + 12, stride, wide::Zero(), wide::Zero(), wide::Zero(), wide::Set(1.0f));
+        }
+    }
+
+    // The top three rows of the matrix of t into m, four floats per row. As TransformRows for a single transform.
+    _XOINL void TransformToRows(const Transform& t, float* m) {
+        const Quaternion& q = t.rotation;
+        const float x2 = q.x * 2.0f, y2 = q.y * 2.0f, z2 = q.z * 2.0f;
+        const float xx = q.x * x2, yy = q.y * y2, zz = q.z * z2;
+        const float xy = q.x * y2, xz = q.x * z2, yz = q.y * z2;
+        const float wx = q.w * x2, wy = q.w * y2, wz = q.w * z2;
+        m[0] = (1.0f - (yy + zz)) * t.scale.x;
+        m[1] = (xy - wz) * t.scale.y;
+        m[2] = (xz + wy) * t.scale.z;
+        m[3] = t.translation.x;
+        m[4] = (xy + wz) * t.scale.x;
+        m[5] = (1.0f - (xx + zz)) * t.scale.y;
+        m[6] = (yz - wx) * t.scale.z;
+        m[7] = t.translation.y;
+        m[8] = (xz - wy) * t.scale.x;
+        m[9] = (yz + wx) * t.scale.y;
+        m[10] = (1.0f - (xx + yy)) * t.scale.z;
+        m[11] = t.translation.z;
+    }
+
+    template <class M>
+    _XOINL void TransformToMatrixArray(const Transform* transforms, M* outMatrices, size_t count) {
+        _XOCONSTEXPR const size_t stride = sizeof(M) / sizeof(float);
+        size_t i = 0;
+        for (; i + wide::Width <= count; i += wide::Width) {
+            TransformLanes l;
+            wide::Float r[12];
+            TransformLoad(transforms + i, l);
+            TransformRows(l, r);
+            TransformStoreRows(outMatrices[i].r[0].f, stride, (int)(stride / 4), r);
+        }
+        for (; i < count; ++i) {
+            transforms[i].ToMatrix(outMatrices[i]);
+        }
+    }
+}
+
+Transform::Transform() {
+}
+
+Transform::Transform(const Vector3& translation, const Quaternion& rotation, const Vector3& scale) :
+    translation(translation),
+    rotation(rotation),
+    scale(scale)
+{
+}
+
+Transform::Transform(const Vector3& translation, const Quaternion& rotation) :
+    translation(translation),
+    rotation(rotation),
+    scale(1.0f, 1.0f, 1.0f)
+{
+}
+
+Transform& Transform::MakeInverse() {
+#if defined(XO_SSE)
+    // The conjugate negates x, y and z. The scale is divided exactly rather than by the estimate Vector3 uses, with 
+    // its w lane kept finite.
+    const __m128 q = _mm_xor_ps(rotation.xmm, _mm_set_ps(0.0f, -0.0f, -0.0f, -0.0f));
+    const __m128 s = _mm_div_ps(_mm_set1_ps(1.0f), _mm_or_ps(_mm_and_ps(scale.xmm, _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1))), _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f)));
+    translation.xmm = _mm_mul_ps(s, xo_internal::TransformRotate(q, _mm_xor_ps(translation.xmm, _mm_set1_ps(-0.0f))));
+    rotation.xmm = q;
+    scale.xmm = s;
+#else
+    rotation.MakeConjugate();
+    scale = Vector3(1.0f / scale.x, 1.0f / scale.y, 1.0f / scale.z);
+    translation = scale * Rotate(rotation, -translation);
+#endif
+    return *this;
+}
+
+void Transform::ToMatrix(Matrix4x4& outMatrix) const {
+    TransformToRows(*this, outMatrix.m);
+    outMatrix.m30 = outMatrix.m31 = outMatrix.m32 = 0.0f;
+    outMatrix.m33 = 1.0f;
+}
+
+void Transform::ToMatrix(Matrix3x4& outMatrix) const {
+    TransformToRows(*this, outMatrix.m);
+}
+
+const Transform& Transform::TransformPoints(const Vector3* vecs, Vector3* outVecs, size_t count) const {
+    ToMatrix3x4().TransformPoints(vecs, outVecs, count);
+    return *this;
+}
+
+void Transform::MultiplyArray(const Transform* a, const Transform* b, Transform* outTransforms, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        Multiply(a[i], b[i], outTransforms[i]);
+    }
+}
+
+void Transform::MultiplyArray(const Transform& a, const Transform* b, Transform* outTransforms, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        Multiply(a, b[i], outTransforms[i]);
+    }
+}
+
+void Transform::ToMatrixArray(const Transform* transforms, Matrix4x4* outMatrices, size_t count) {
+    TransformToMatrixArray(transforms, outMatrices, count);
+}
+
+void Transform::ToMatrixArray(const Transform* transforms, Matrix3x4* outMatrices, size_t count) {
+    TransformToMatrixArray(transforms, outMatrices, count);
+}
+
+void Transform::Lerp(const Transform& a, const Transform& b, float t, Transform& outTransform) {
+    Quaternion rotation;
+    Quaternion::Nlerp(a.rotation, b.rotation, t, rotation);
+    outTransform.translation = a.translation + (b.translation - a.translation) * t;
+    outTransform.scale = a.scale + (b.scale - a.scale) * t;
+    outTransform.rotation = rotation;
+}
+
+void Transform::Slerp(const Transform& a, const Transform& b, float t, Transform& outTransform) {
+    Quaternion rotation;
+    Quaternion::Slerp(a.rotation, b.rotation, t, rotation);
+    outTransform.translation = a.translation + (b.translation - a.translation) * t;
+    outTransform.scale = a.scale + (b.scale - a.scale) * t;
+    outTransform.rotation = rotation;
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
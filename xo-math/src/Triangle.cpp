@@ -0,0 +1,123 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+Vector3 Triangle::ClosestPoint(const Vector3& point) const {
+    // Tests the regions in turn from the corners outward, by the signs of dot products with the edges from v0 and the 
+    // barycentric areas they give.
+    const Vector3 ab = v1 - v0, ac = v2 - v0, ap = point - v0;
+    const float d1 = ab.Dot(ap), d2 = ac.Dot(ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) {
+        return v0;
+    }
+    const Vector3 bp = point - v1;
+    const float d3 = ab.Dot(bp), d4 = ac.Dot(bp);
+    if (d3 >= 0.0f && d4 <= d3) {
+        return v1;
+    }
+    const float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+        return v0 + ab * (d1 / (d1 - d3));
+    }
+    const Vector3 cp = point - v2;
+    const float d5 = ab.Dot(cp), d6 = ac.Dot(cp);
+    if (d6 >= 0.0f && d5 <= d6) {
+        return v2;
+    }
+    const float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+        return v0 + ac * (d2 / (d2 - d6));
+    }
+    const float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f) {
+        return v1 + (v2 - v1) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+    const float inverseArea = 1.0f / (va + vb + vc);
+    return v0 + ab * (vb * inverseArea) + ac * (vc * inverseArea);
+}
+
+void Triangle::ClosestPoints(const Vector3Stream& points, const Vector3Stream& v0, const Vector3Stream& v1, const Vector3Stream& v2, 
+                             Vector3Stream& outPoints, float* outDistancesSquared) {
+    XO_ASSERT(points.Size() == v0.Size() && points.Size() == v1.Size() && points.Size() == v2.Size(), 
+              "xo-math Triangle::ClosestPoints streams must be the same size.");
+    using namespace wide;
+    const size_t count = points.Size();
+    outPoints.Resize(count);
+    const Float zero = Zero(), one = wide::Set(1.0f);
+    for (size_t i = 0; i < count; i += Width) {
+        const Float3 p = Load(points.X() + i, points.Y() + i, points.Z() + i);
+        const Float3 a = Load(v0.X() + i, v0.Y() + i, v0.Z() + i);
+        const Float3 ab = Sub(Load(v1.X() + i, v1.Y() + i, v1.Z() + i), a);
+        const Float3 ac = Sub(Load(v2.X() + i, v2.Y() + i, v2.Z() + i), a);
+        const Float3 ap = Sub(p, a), bp = Sub(ap, ab), cp = Sub(ap, ac);
+        const Float d1 = Dot(ab, ap), d2 = Dot(ac, ap);
+        const Float d3 = Dot(ab, bp), d4 = Dot(ac, bp);
+        const Float d5 = Dot(ab, cp), d6 = Dot(ac, cp);
+        const Float va = NegMulAdd(d5, d4, Mul(d3, d6)), vb = NegMulAdd(d1, d6, Mul(d5, d2)), vc = NegMulAdd(d3, d2, Mul(d1, d4));
+        const Float d43 = Sub(d4, d3), d56 = Sub(d5, d6);
+
+        // The closest point is v0 + ab * v + ac * w in every region. Starting from the face, each region's weights 
+        // replace the last where its test holds, in reverse of the order Triangle::ClosestPoint tests them so the 
+        // same region wins. Weights of regions that don't apply may divide by zero, and are never selected.
+        const Float inverseArea = Div(one, Add(va, Add(vb, vc)));
+        Float v = Mul(vb, inverseArea), w = Mul(vc, inverseArea);
+        const Float onBC = And(CmpLe(va, zero), And(CmpGe(d43, zero), CmpGe(d56, zero)));
+        const Float tBC = Div(d43, Add(d43, d56));
+        v = Select(onBC, Sub(one, tBC), v);
+        w = Select(onBC, tBC, w);
+        const Float onAC = And(CmpLe(vb, zero), And(CmpGe(d2, zero), CmpLe(d6, zero)));
+        v = Select(onAC, zero, v);
+        w = Select(onAC, Div(d2, Sub(d2, d6)), w);
+        const Float atC = And(CmpGe(d6, zero), CmpLe(d5, d6));
+        v = Select(atC, zero, v);
+        w = Select(atC, one, w);
+        const Float onAB = And(CmpLe(vc, zero), And(CmpGe(d1, zero), CmpLe(d3, zero)));
+        v = Select(onAB, Div(d1, Sub(d1, d3)), v);
+        w = Select(onAB, zero, w);
+        const Float atB = And(CmpGe(d3, zero), CmpLe(d4, d3));
+        v = Select(atB, one, v);
+        w = Select(atB, zero, w);
+        const Float atA = And(CmpLe(d1, zero), CmpLe(d2, zero));
+        v = Select(atA, zero, v);
+        w = Select(atA, zero, w);
+
+        const Float3 closest = MulAdd(ac, w, MulAdd(ab, v, a));
+        Store(outPoints.X() + i, outPoints.Y() + i, outPoints.Z() + i, closest);
+        if (outDistancesSquared) {
+            const Float3 offset = Sub(p, closest);
+            if (i + Width <= count) {
+                StoreUnaligned(outDistancesSquared + i, Dot(offset, offset));
+            }
+            else {
+                StorePartial(outDistancesSquared + i, Dot(offset, offset), count - i);
+            }
+        }
+    }
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
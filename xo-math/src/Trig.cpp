@@ -0,0 +1,67 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+namespace {
+    template <bool WantSin, bool WantCos>
+    _XOINL void SinCosFloats(const float* f, float* outSin, float* outCos, size_t count) {
+        using namespace wide;
+        Float s, c;
+        size_t i = 0;
+        const Float limit = Set(SinCosLimit);
+        for (; i + Width <= count; i += Width) {
+            const Float a = LoadUnaligned(f + i);
+            wide::SinCos(a, s, c);
+            if (WantSin) StoreUnaligned(outSin + i, s);
+            if (WantCos) StoreUnaligned(outCos + i, c);
+            if (const int large = MoveMask(CmpGt(wide::Abs(a), limit))) {
+                xo_internal::SinCosLargeLanes(f + i, WantSin ? outSin + i : nullptr, WantCos ? outCos + i : nullptr, large);
+            }
+        }
+        if (i < count) {
+            const Float a = LoadPartial(f + i, count - i);
+            wide::SinCos(a, s, c);
+            if (WantSin) StorePartial(outSin + i, s, count - i);
+            if (WantCos) StorePartial(outCos + i, c, count - i);
+            if (const int large = MoveMask(CmpGt(wide::Abs(a), limit))) {
+                xo_internal::SinCosLargeLanes(f + i, WantSin ? outSin + i : nullptr, WantCos ? outCos + i : nullptr, large);
+            }
+        }
+    }
+}
+
+void SinArray(const float* f, float* outSin, size_t count) {
+    SinCosFloats<true, false>(f, outSin, nullptr, count);
+}
+
+void CosArray(const float* f, float* outCos, size_t count) {
+    SinCosFloats<false, true>(f, nullptr, outCos, count);
+}
+
+void SinCosArray(const float* f, float* outSin, float* outCos, size_t count) {
+    SinCosFloats<true, true>(f, outSin, outCos, count);
+}
+
+XOMATH_END_XO_NS();
\ No newline at end of file
@@ -264,8 +264,8 @@ void Vector3::RotateRadians(const Vector3& v, const Vector3& axis, float angle,
     // Rodrigues' rotation formula
     // https://en.wikipedia.org/wiki/Rodrigues%27_rotation_formula
     Vector3 axv;
-    float sinAng = Sin(angle);
-    float cosAng = Cos(angle);
+    float sinAng, cosAng;
+    SinCos(angle, sinAng, cosAng);
     Vector3::Cross(axis, v, axv);
     float adv = Vector3::Dot(axis, v);
     outVec.Set(v * cosAng + axv * sinAng + axis * adv * (1.0f - cosAng));
@@ -278,27 +278,40 @@ float Vector3::AngleRadians(const Vector3& a, const Vector3& b) {
     return ATan2(Sqrt(cross.Sum()), Vector3::Dot(a, b));
 }
 
+namespace {
+    // The unit axis most nearly perpendicular to v, to cross with it. A fixed axis would be parallel to some v (either 
+    // way along it), leaving a zero cross product.
+    const Vector3& RandomHelperAxis(const Vector3& v) {
+        const float x = Abs(v.x), y = Abs(v.y), z = Abs(v.z);
+        return x <= y && x <= z ? Vector3::UnitX : (y <= z ? Vector3::UnitY : Vector3::UnitZ);
+    }
+}
+
 void Vector3::RandomInConeRadians(const Vector3& forward, float angle, Vector3& outVec) {
     Vector3 cross;
-    Vector3::Cross(forward, forward == Vector3::Up ? Vector3::Left : Vector3::Up, cross);
-    Vector3::RotateRadians(forward, cross, RandomRange(0.0f, angle*0.5f), outVec);
-    Vector3::RotateRadians(outVec, forward.Normalized(), RandomRange(0.0f, TAU), outVec);
+    RandomGenerator& rng = RandomGenerator::ThreadLocal();
+    Vector3::Cross(forward, RandomHelperAxis(forward), cross);
+    Vector3::RotateRadians(forward, cross, rng.Range(0.0f, angle*0.5f), outVec);
+    Vector3::RotateRadians(outVec, forward.Normalized(), rng.Range(0.0f, TAU), outVec);
 }
 
 void Vector3::RandomOnConeRadians(const Vector3& forward, float angle, Vector3& outVec) {
     Vector3 cross;
-    Vector3::Cross(forward, forward == Vector3::Up ? Vector3::Left : Vector3::Up, cross);
+    Vector3::Cross(forward, RandomHelperAxis(forward), cross);
     Vector3::RotateRadians(forward, cross, angle*0.5f, outVec);
-    Vector3::RotateRadians(outVec, forward.Normalized(), RandomRange(0.0f, TAU), outVec);
+    Vector3::RotateRadians(outVec, forward.Normalized(), RandomGenerator::ThreadLocal().Range(0.0f, TAU), outVec);
 }
 
 void Vector3::RandomOnSphere(float radius, Vector3& outVec) {
     // Marsaglia's method: https://projecteuclid.org/download/pdf_1/euclid.aoms/1177692644
+    RandomGenerator& rng = RandomGenerator::ThreadLocal();
     float x1, x2, x12, x22;
-    x1 = RandomRange(-1.0f, 1.0f);
-    x2 = RandomRange(-1.0f, 1.0f);
-    x12 = Square(x1);
-    x22 = Square(x1);
+    do {
+        x1 = rng.Range(-1.0f, 1.0f);
+        x2 = rng.Range(-1.0f, 1.0f);
+        x12 = Square(x1);
+        x22 = Square(x2);
+    } while (x12 + x22 >= 1.0f);
     outVec.Set(
         2.0f * x1 * Sqrt(1.0f - x12 - x22),
         2.0f * x2 * Sqrt(1.0f - x12 - x22),
@@ -308,31 +321,273 @@ void Vector3::RandomOnSphere(float radius, Vector3& outVec) {
 }
 
 void Vector3::RandomOnCube(float size, Vector3& outVec) {
-    switch (RandomRange(0, 5)) {
-        case 0: outVec.Set(RandomRange(-size, size),    RandomRange(-size, size),                size);         break;
-        case 1: outVec.Set(RandomRange(-size, size),    RandomRange(-size, size),               -size);         break;
-        case 2: outVec.Set(RandomRange(-size, size),                 size,          RandomRange(-size, size));  break;
-        case 3: outVec.Set(RandomRange(-size, size),                -size,          RandomRange(-size, size));  break;
-        case 4: outVec.Set(             size,           RandomRange(-size, size),   RandomRange(-size, size));  break;
-        case 5: outVec.Set(            -size,           RandomRange(-size, size),   RandomRange(-size, size));  break;
-    }
+    // Pick one of the 6 faces: face/2 is the axis held at +size or -size, the other two are random. Indexing rather 
+    // than switching on the face avoids a mispredicted branch per sample.
+    RandomGenerator& rng = RandomGenerator::ThreadLocal();
+    const int face = rng.Range(0, 5);
+    const int axis = face >> 1;
+    float f[3];
+    f[axis] = (face & 1) ? -size : size;
+    f[axis == 2 ? 0 : axis + 1] = rng.Range(-size, size);
+    f[axis == 0 ? 2 : axis - 1] = rng.Range(-size, size);
+    outVec.Set(f[0], f[1], f[2]);
 }
 
 void Vector3::RandomInCircle(const Vector3& up, float radius, Vector3& outVec) {
     Vector3 cross;
-    Vector3::Cross(up, up == Right ? Forward : Right, cross);
-    Vector3::RotateRadians(cross, up.Normalized(), RandomRange(0.0f, TAU), outVec);
-    outVec *= Sqrt(RandomRange(0.0f, 1.0f)) * radius;
+    Vector3::Cross(up, RandomHelperAxis(up), cross);
+    RandomGenerator& rng = RandomGenerator::ThreadLocal();
+    Vector3::RotateRadians(cross, up.Normalized(), rng.Range(0.0f, TAU), outVec);
+    outVec *= Sqrt(rng.NextFloat()) * radius;
 }
 
 void Vector3::RandomOnCircle(const Vector3& up, float radius, Vector3& outVec) {
     Vector3 cross;
-    Vector3::Cross(up, up == Right ? Forward : Right, cross);
-    Vector3::RotateRadians(cross, up.Normalized(), RandomRange(0.0f, TAU), outVec);
+    Vector3::Cross(up, RandomHelperAxis(up), cross);
+    Vector3::RotateRadians(cross, up.Normalized(), RandomGenerator::ThreadLocal().Range(0.0f, TAU), outVec);
     outVec *= radius;
 }
 
 
+namespace {
+    // Samples are made RandomBatch at a time from one fill of random floats per input, then stored wide::Width at a 
+    // time. A multiple of every wide::Width.
+    _XOCONSTEXPR const size_t RandomBatch = 256;
+
+    // An orthonormal frame around a direction: axis is the direction normalized, u and v are perpendicular to it and 
+    // to each other. u is perpendicular to the same helper vector the single sample methods rotate about.
+    struct RandomFrame {
+        RandomFrame(const Vector3& direction, const Vector3& helper) {
+            axis = direction.Normalized();
+            Vector3::Cross(axis, helper, u);
+            u.Normalize();
+            Vector3::Cross(axis, u, v);
+        }
+        Vector3 axis, u, v;
+    };
+
+    // Writes Width samples (count of them when fewer remain) to either a Vector3 array or three float arrays.
+    struct RandomOutput {
+        void Write(size_t i, wide::Float x, wide::Float y, wide::Float z, size_t count) const {
+            using namespace wide;
+            if (vecs) {
+#if defined(XO_SSE)
+                if (count == (size_t)Width) {
+                    StoreTransposed4(vecs[i].f, 4, x, y, z, Zero());
+                    return;
+                }
+#endif
+                _XOSIMDALIGN32 float tx[Width], ty[Width], tz[Width];
+                Store(tx, x);
+                Store(ty, y);
+                Store(tz, z);
+                for (size_t j = 0; j < count; ++j) {
+                    vecs[i + j].Set(tx[j], ty[j], tz[j]);
+                }
+            }
+            else if (count == (size_t)Width) {
+                StoreUnaligned(outX + i, x);
+                StoreUnaligned(outY + i, y);
+                StoreUnaligned(outZ + i, z);
+            }
+            else {
+                StorePartial(outX + i, x, count);
+                StorePartial(outY + i, y, count);
+                StorePartial(outZ + i, z, count);
+            }
+        }
+        Vector3* vecs;
+        float* outX;
+        float* outY;
+        float* outZ;
+    };
+
+    // Shape::Randoms uniform floats in [0, 1) are drawn per sample, Shape::Sample turns Width of them into Width points.
+    template <class Shape>
+    void SampleRandomShape(const Shape& shape, const RandomOutput& output, size_t count) {
+        using namespace wide;
+        RandomGenerator& rng = RandomGenerator::ThreadLocal();
+        _XOSIMDALIGN32 float randoms[Shape::Randoms][RandomBatch];
+        for (size_t batch = 0; batch < count; batch += RandomBatch) {
+            const size_t batchCount = _XO_MIN(RandomBatch, count - batch);
+            const size_t filled = (batchCount + Width - 1) & ~(size_t)(Width - 1);
+            for (int r = 0; r < Shape::Randoms; ++r) {
+                rng.Floats(randoms[r], filled);
+            }
+            for (size_t i = 0; i < batchCount; i += Width) {
+                Float u[Shape::Randoms];
+                for (int r = 0; r < Shape::Randoms; ++r) {
+                    u[r] = Load(randoms[r] + i);
+                }
+                Float x, y, z;
+                shape.Sample(u, x, y, z);
+                output.Write(batch + i, x, y, z, _XO_MIN((size_t)Width, batchCount - i));
+            }
+        }
+    }
+
+    // center + (u * cos(phi) + v * sin(phi)) * radius, for cones and circles alike.
+    _XOINL void RandomRing(const RandomFrame& frame, wide::Float center, wide::Float radius, wide::Float phi, wide::Float& x, wide::Float& y, wide::Float& z) {
+        using namespace wide;
+        Float s, c;
+        wide::SinCos(phi, s, c);
+        s = Mul(s, radius);
+        c = Mul(c, radius);
+        x = MulAdd(Set(frame.u.x), c, MulAdd(Set(frame.v.x), s, Mul(Set(frame.axis.x), center)));
+        y = MulAdd(Set(frame.u.y), c, MulAdd(Set(frame.v.y), s, Mul(Set(frame.axis.y), center)));
+        z = MulAdd(Set(frame.u.z), c, MulAdd(Set(frame.v.z), s, Mul(Set(frame.axis.z), center)));
+    }
+
+    // Tilted from forward by a random angle up to halfAngle (In) or by exactly halfAngle (On), then spun about it.
+    template <bool In>
+    struct RandomConeShape {
+        static const int Randoms = 2;
+        RandomConeShape(const Vector3& forward, float angle) :
+            frame(forward, RandomHelperAxis(forward)),
+            length(forward.Magnitude()),
+            halfAngle(angle * 0.5f) {
+        }
+        void Sample(const wide::Float* u, wide::Float& x, wide::Float& y, wide::Float& z) const {
+            using namespace wide;
+            Float s, c;
+            wide::SinCos(In ? Mul(u[1], Set(halfAngle)) : Set(halfAngle), s, c);
+            RandomRing(frame, Mul(c, Set(length)), Mul(s, Set(length)), Mul(u[0], Set(TAU)), x, y, z);
+        }
+        RandomFrame frame;
+        float length;
+        float halfAngle;
+    };
+
+    // A circle about up, uniform over its area (In) or on its edge (On).
+    template <bool In>
+    struct RandomCircleShape {
+        static const int Randoms = In ? 2 : 1;
+        RandomCircleShape(const Vector3& up, float radius) :
+            frame(up, RandomHelperAxis(up)),
+            radius(radius) {
+        }
+        void Sample(const wide::Float* u, wide::Float& x, wide::Float& y, wide::Float& z) const {
+            using namespace wide;
+            const Float r = In ? Mul(wide::Sqrt(u[Randoms - 1]), Set(radius)) : Set(radius);
+            RandomRing(frame, Zero(), r, Mul(u[0], Set(TAU)), x, y, z);
+        }
+        RandomFrame frame;
+        float radius;
+    };
+
+    // Archimedes: z is uniform in [-1, 1] on a sphere's surface, the angle about z is uniform too. No rejection needed.
+    struct RandomSphereShape {
+        static const int Randoms = 2;
+        explicit RandomSphereShape(float radius) : radius(radius) { }
+        void Sample(const wide::Float* u, wide::Float& x, wide::Float& y, wide::Float& z) const {
+            using namespace wide;
+            const Float h = MulAdd(u[1], Set(2.0f), Set(-1.0f));
+            const Float r = Mul(wide::Sqrt(wide::Max(NegMulAdd(h, h, Set(1.0f)), Zero())), Set(radius));
+            Float s, c;
+            wide::SinCos(Mul(u[0], Set(TAU)), s, c);
+            x = Mul(c, r);
+            y = Mul(s, r);
+            z = Mul(h, Set(radius));
+        }
+        float radius;
+    };
+
+    // Uniform in the cube (In), or on one of its 6 faces picked at random with the other two axes uniform (On).
+    template <bool In>
+    struct RandomCubeShape {
+        static const int Randoms = 3;
+        explicit RandomCubeShape(float size) : size(size) { }
+        void Sample(const wide::Float* u, wide::Float& x, wide::Float& y, wide::Float& z) const {
+            using namespace wide;
+            const Float a = MulAdd(u[0], Set(2.0f * size), Set(-size));
+            const Float b = MulAdd(u[1], Set(2.0f * size), Set(-size));
+            if (In) {
+                x = a;
+                y = b;
+                z = MulAdd(u[2], Set(2.0f * size), Set(-size));
+                return;
+            }
+            // face in 0..5: face/2 is the axis held at the surface, odd faces are on the negative side.
+            const Float face = Floor(Mul(u[2], Set(6.0f)));
+            const Float half = Floor(Mul(face, Set(0.5f)));
+            const Float surface = Select(CmpNeq(Add(half, half), face), Set(-size), Set(size));
+            const Float axis0 = CmpLt(face, Set(2.0f));
+            const Float axis2 = CmpGe(face, Set(4.0f));
+            x = Select(axis0, surface, a);
+            y = Select(axis0, a, Select(axis2, b, surface));
+            z = Select(axis2, surface, b);
+        }
+        float size;
+    };
+
+    _XOINL RandomOutput RandomVectors(Vector3* outVecs) {
+        RandomOutput output = { outVecs, nullptr, nullptr, nullptr };
+        return output;
+    }
+
+    _XOINL RandomOutput RandomStreams(float* outX, float* outY, float* outZ) {
+        RandomOutput output = { nullptr, outX, outY, outZ };
+        return output;
+    }
+}
+
+void Vector3::RandomInCircleArray(const Vector3& up, float radius, Vector3* outVecs, size_t count) {
+    SampleRandomShape(RandomCircleShape<true>(up, radius), RandomVectors(outVecs), count);
+}
+
+void Vector3::RandomInCircleArray(const Vector3& up, float radius, float* outX, float* outY, float* outZ, size_t count) {
+    SampleRandomShape(RandomCircleShape<true>(up, radius), RandomStreams(outX, outY, outZ), count);
+}
+
+void Vector3::RandomOnCircleArray(const Vector3& up, float radius, Vector3* outVecs, size_t count) {
+    SampleRandomShape(RandomCircleShape<false>(up, radius), RandomVectors(outVecs), count);
+}
+
+void Vector3::RandomOnCircleArray(const Vector3& up, float radius, float* outX, float* outY, float* outZ, size_t count) {
+    SampleRandomShape(RandomCircleShape<false>(up, radius), RandomStreams(outX, outY, outZ), count);
+}
+
+void Vector3::RandomInConeRadiansArray(const Vector3& forward, float angle, Vector3* outVecs, size_t count) {
+    SampleRandomShape(RandomConeShape<true>(forward, angle), RandomVectors(outVecs), count);
+}
+
+void Vector3::RandomInConeRadiansArray(const Vector3& forward, float angle, float* outX, float* outY, float* outZ, size_t count) {
+    SampleRandomShape(RandomConeShape<true>(forward, angle), RandomStreams(outX, outY, outZ), count);
+}
+
+void Vector3::RandomOnConeRadiansArray(const Vector3& forward, float angle, Vector3* outVecs, size_t count) {
+    SampleRandomShape(RandomConeShape<false>(forward, angle), RandomVectors(outVecs), count);
+}
+
+void Vector3::RandomOnConeRadiansArray(const Vector3& forward, float angle, float* outX, float* outY, float* outZ, size_t count) {
+    SampleRandomShape(RandomConeShape<false>(forward, angle), RandomStreams(outX, outY, outZ), count);
+}
+
+void Vector3::RandomInCubeArray(float size, Vector3* outVecs, size_t count) {
+    SampleRandomShape(RandomCubeShape<true>(size), RandomVectors(outVecs), count);
+}
+
+void Vector3::RandomInCubeArray(float size, float* outX, float* outY, float* outZ, size_t count) {
+    SampleRandomShape(RandomCubeShape<true>(size), RandomStreams(outX, outY, outZ), count);
+}
+
+void Vector3::RandomOnCubeArray(float size, Vector3* outVecs, size_t count) {
+    SampleRandomShape(RandomCubeShape<false>(size), RandomVectors(outVecs), count);
+}
+
+void Vector3::RandomOnCubeArray(float size, float* outX, float* outY, float* outZ, size_t count) {
+    SampleRandomShape(RandomCubeShape<false>(size), RandomStreams(outX, outY, outZ), count);
+}
+
+void Vector3::RandomOnSphereArray(float radius, Vector3* outVecs, size_t count) {
+    SampleRandomShape(RandomSphereShape(radius), RandomVectors(outVecs), count);
+}
+
+void Vector3::RandomOnSphereArray(float radius, float* outX, float* outY, float* outZ, size_t count) {
+    SampleRandomShape(RandomSphereShape(radius), RandomStreams(outX, outY, outZ), count);
+}
+
+
 
 #undef IDX_X
 #undef IDX_Y
@@ -0,0 +1,310 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 Jared Thomson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a 
+// copy of this software and associated documentation files (the "Software"), 
+// to deal in the Software without restriction, including without limitation 
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+// and/or sell copies of the Software, and to permit persons to whom the 
+// Software is furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included 
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT 
+// OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR 
+// THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#define _XO_MATH_OBJ
+#include "xo-math.h"
+
+XOMATH_BEGIN_XO_NS();
+
+static_assert(XO_STREAM_ALIGNMENT % 32 == 0, "xo-math XO_STREAM_ALIGNMENT must be a multiple of 32.");
+
+namespace xo_internal {
+    _XOINL size_t StreamCapacity(size_t count) {
+        const size_t floatsPerBlock = XO_STREAM_ALIGNMENT / sizeof(float);
+        return ((count + floatsPerBlock - 1) / floatsPerBlock) * floatsPerBlock;
+    }
+
+    // The number of floats a kernel walks: count rounded up to whole wide::Float steps. Never more than the capacity.
+    _XOINL size_t StreamSteps(size_t count) {
+        return ((count + wide::Width - 1) / wide::Width) * wide::Width;
+    }
+}
+
+Vector3Stream::Vector3Stream() :
+    x(nullptr), y(nullptr), z(nullptr), size(0), capacity(0)
+{
+}
+
+Vector3Stream::Vector3Stream(size_t count) :
+    x(nullptr), y(nullptr), z(nullptr), size(0), capacity(0)
+{
+    Resize(count);
+}
+
+Vector3Stream::Vector3Stream(const Vector3* vecs, size_t count) :
+    x(nullptr), y(nullptr), z(nullptr), size(0), capacity(0)
+{
+    Set(vecs, count);
+}
+
+Vector3Stream::Vector3Stream(const Vector3Stream& stream) :
+    x(nullptr), y(nullptr), z(nullptr), size(0), capacity(0)
+{
+    *this = stream;
+}
+
+Vector3Stream::Vector3Stream(Vector3Stream&& stream) :
+    x(stream.x), y(stream.y), z(stream.z), size(stream.size), capacity(stream.capacity)
+{
+    stream.x = stream.y = stream.z = nullptr;
+    stream.size = stream.capacity = 0;
+}
+
+Vector3Stream::~Vector3Stream() {
+    Release();
+}
+
+void Vector3Stream::Allocate(size_t count) {
+    capacity = xo_internal::StreamCapacity(count);
+    size = count;
+    if (capacity) {
+        x = (float*)XO_ALIGNED_MALLOC(capacity * 3 * sizeof(float), XO_STREAM_ALIGNMENT);
+        y = x + capacity;
+        z = y + capacity;
+    }
+}
+
+void Vector3Stream::Release() {
+    if (x) {
+        XO_ALIGNED_FREE(x);
+    }
+    x = y = z = nullptr;
+    size = capacity = 0;
+}
+
+Vector3Stream& Vector3Stream::operator = (const Vector3Stream& stream) {
+    if (this != &stream) {
+        if (capacity != stream.capacity) {
+            Release();
+            Allocate(stream.size);
+        }
+        size = stream.size;
+        if (capacity) {
+            memcpy(x, stream.x, capacity * 3 * sizeof(float));
+        }
+    }
+    return *this;
+}
+
+Vector3Stream& Vector3Stream::operator = (Vector3Stream&& stream) {
+    if (this != &stream) {
+        Release();
+        x = stream.x;
+        y = stream.y;
+        z = stream.z;
+        size = stream.size;
+        capacity = stream.capacity;
+        stream.x = stream.y = stream.z = nullptr;
+        stream.size = stream.capacity = 0;
+    }
+    return *this;
+}
+
+void Vector3Stream::Resize(size_t count) {
+    size_t keep = _XO_MIN(count, size);
+    if (xo_internal::StreamCapacity(count) != capacity) {
+        Vector3Stream old(std::move(*this));
+        Allocate(count);
+        if (keep) {
+            memcpy(x, old.x, keep * sizeof(float));
+            memcpy(y, old.y, keep * sizeof(float));
+            memcpy(z, old.z, keep * sizeof(float));
+        }
+    }
+    // new vectors and the padding past them start as zero.
+    for (size_t i = keep; i < capacity; ++i) {
+        x[i] = y[i] = z[i] = 0.0f;
+    }
+    size = count;
+}
+
+void Vector3Stream::Set(const Vector3* vecs, size_t count) {
+    Resize(count);
+    size_t i = 0;
+#if defined(XO_SSE)
+    // Four AoS vectors transpose into four SoA registers, the fourth (w) is dropped.
+    for (; i + 4 <= count; i += 4) {
+        __m128 r0 = vecs[i].xmm, r1 = vecs[i+1].xmm, r2 = vecs[i+2].xmm, r3 = vecs[i+3].xmm;
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_store_ps(x + i, r0);
+        _mm_store_ps(y + i, r1);
+        _mm_store_ps(z + i, r2);
+    }
+#endif
+    for (; i < count; ++i) {
+        x[i] = vecs[i].x;
+        y[i] = vecs[i].y;
+        z[i] = vecs[i].z;
+    }
+}
+
+void Vector3Stream::Get(Vector3* vecs) const {
+    size_t i = 0;
+#if defined(XO_SSE)
+    for (; i + 4 <= size; i += 4) {
+        __m128 r0 = _mm_load_ps(x + i), r1 = _mm_load_ps(y + i), r2 = _mm_load_ps(z + i), r3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        vecs[i].xmm = r0;
+        vecs[i+1].xmm = r1;
+        vecs[i+2].xmm = r2;
+        vecs[i+3].xmm = r3;
+    }
+#endif
+    for (; i < size; ++i) {
+        vecs[i].Set(x[i], y[i], z[i]);
+    }
+}
+
+void Vector3Stream::Add(const Vector3Stream& a, const Vector3Stream& b, Vector3Stream& o) {
+    XO_ASSERT(a.size == b.size, "xo-math Vector3Stream::Add streams must be the same size.");
+    o.Resize(a.size);
+    const size_t n = xo_internal::StreamSteps(a.size);
+    for (size_t i = 0; i < n; i += wide::Width) {
+        wide::Store(o.x + i, wide::Add(wide::Load(a.x + i), wide::Load(b.x + i)));
+        wide::Store(o.y + i, wide::Add(wide::Load(a.y + i), wide::Load(b.y + i)));
+        wide::Store(o.z + i, wide::Add(wide::Load(a.z + i), wide::Load(b.z + i)));
+    }
+}
+
+void Vector3Stream::Add(const Vector3Stream& a, const Vector3& v, Vector3Stream& o) {
+    o.Resize(a.size);
+    const wide::Float vx = wide::Set(v.x), vy = wide::Set(v.y), vz = wide::Set(v.z);
+    const size_t n = xo_internal::StreamSteps(a.size);
+    for (size_t i = 0; i < n; i += wide::Width) {
+        wide::Store(o.x + i, wide::Add(wide::Load(a.x + i), vx));
+        wide::Store(o.y + i, wide::Add(wide::Load(a.y + i), vy));
+        wide::Store(o.z + i, wide::Add(wide::Load(a.z + i), vz));
+    }
+}
+
+void Vector3Stream::Subtract(const Vector3Stream& a, const Vector3Stream& b, Vector3Stream& o) {
+    XO_ASSERT(a.size == b.size, "xo-math Vector3Stream::Subtract streams must be the same size.");
+    o.Resize(a.size);
+    const size_t n = xo_internal::StreamSteps(a.size);
+    for (size_t i = 0; i < n; i += wide::Width) {
+        wide::Store(o.x + i, wide::Sub(wide::Load(a.x + i), wide::Load(b.x + i)));
+        wide::Store(o.y + i, wide::Sub(wide::Load(a.y + i), wide::Load(b.y + i)));
+        wide::Store(o.z + i, wide::Sub(wide::Load(a.z + i), wide::Load(b.z + i)));
+    }
+}
+
+void Vector3Stream::Multiply(const Vector3Stream& a, const Vector3Stream& b, Vector3Stream& o) {
+    XO_ASSERT(a.size == b.size, "xo-math Vector3Stream::Multiply streams must be the same size.");
+    o.Resize(a.size);
+    const size_t n = xo_internal::StreamSteps(a.size);
+    for (size_t i = 0; i < n; i += wide::Width) {
+        wide::Store(o.x + i, wide::Mul(wide::Load(a.x + i), wide::Load(b.x + i)));
+        wide::Store(o.y + i, wide::Mul(wide::Load(a.y + i), wide::Load(b.y + i)));
+        wide::Store(o.z + i, wide::Mul(wide::Load(a.z + i), wide::Load(b.z + i)));
+    }
+}
+
+void Vector3Stream::Scale(const Vector3Stream& a, float f, Vector3Stream& o) {
+    o.Resize(a.size);
+    const wide::Float s = wide::Set(f);
+    const size_t n = xo_internal::StreamSteps(a.size);
+    for (size_t i = 0; i < n; i += wide::Width) {
+        wide::Store(o.x + i, wide::Mul(wide::Load(a.x + i), s));
+        wide::Store(o.y + i, wide::Mul(wide::Load(a.y + i), s));
+        wide::Store(o.z + i, wide::Mul(wide::Load(a.z + i), s));
+    }
+}
+
+void Vector3Stream::Lerp(const Vector3Stream& a, const Vector3Stream& b, float t, Vector3Stream& o) {
+    XO_ASSERT(a.size == b.size, "xo-math Vector3Stream::Lerp streams must be the same size.");
+    o.Resize(a.size);
+    const wide::Float wt = wide::Set(t);
+    const size_t n = xo_internal::StreamSteps(a.size);
+    for (size_t i = 0; i < n; i += wide::Width) {
+        wide::Float ax = wide::Load(a.x + i), ay = wide::Load(a.y + i), az = wide::Load(a.z + i);
+        wide::Store(o.x + i, wide::MulAdd(wide::Sub(wide::Load(b.x + i), ax), wt, ax));
+        wide::Store(o.y + i, wide::MulAdd(wide::Sub(wide::Load(b.y + i), ay), wt, ay));
+        wide::Store(o.z + i, wide::MulAdd(wide::Sub(wide::Load(b.z + i), az), wt, az));
+    }
+}
+
+void Vector3Stream::Cross(const Vector3Stream& a, const Vector3Stream& b, Vector3Stream& o) {
+    XO_ASSERT(a.size == b.size, "xo-math Vector3Stream::Cross streams must be the same size.");
+    o.Resize(a.size);
+    const size_t n = xo_internal::StreamSteps(a.size);
+    for (size_t i = 0; i < n; i += wide::Width) {
+        wide::Float ax = wide::Load(a.x + i), ay = wide::Load(a.y + i), az = wide::Load(a.z + i);
+        wide::Float bx = wide::Load(b.x + i), by = wide::Load(b.y + i), bz = wide::Load(b.z + i);
+        wide::Store(o.x + i, wide::NegMulAdd(az, by, wide::Mul(ay, bz)));
+        wide::Store(o.y + i, wide::NegMulAdd(ax, bz, wide::Mul(az, bx)));
+        wide::Store(o.z + i, wide::NegMulAdd(ay, bx, wide::Mul(ax, by)));
+    }
+}
+
+void Vector3Stream::Normalize(const Vector3Stream& a, Vector3Stream& o) {
+    o.Resize(a.size);
+    const size_t n = xo_internal::StreamSteps(a.size);
+    for (size_t i = 0; i < n; i += wide::Width) {
+        wide::Float ax = wide::Load(a.x + i), ay = wide::Load(a.y + i), az = wide::Load(a.z + i);
+        wide::Float magSq = wide::MulAdd(ax, ax, wide::MulAdd(ay, ay, wide::Mul(az, az)));
+        wide::Float nonZero = wide::CmpGt(magSq, wide::Zero());
+#if defined(XO_NO_INVERSE_DIVISION)
+        wide::Float inv = wide::Div(wide::Set(1.0f), wide::Sqrt(magSq));
+#else
+        wide::Float inv = wide::Rsqrt(magSq);
+#endif
+        inv = wide::And(nonZero, inv);
+        wide::Store(o.x + i, wide::Mul(ax, inv));
+        wide::Store(o.y + i, wide::Mul(ay, inv));
+        wide::Store(o.z + i, wide::Mul(az, inv));
+    }
+}
+
+void Vector3Stream::Dot(const Vector3Stream& a, const Vector3Stream& b, float* outFloats) {
+    XO_ASSERT(a.size == b.size, "xo-math Vector3Stream::Dot streams must be the same size.");
+    const size_t n = xo_internal::StreamSteps(a.size);
+    for (size_t i = 0; i < n; i += wide::Width) {
+        wide::Float d = wide::MulAdd(wide::Load(a.x + i), wide::Load(b.x + i),
+                        wide::MulAdd(wide::Load(a.y + i), wide::Load(b.y + i),
+                        wide::Mul(wide::Load(a.z + i), wide::Load(b.z + i))));
+        if (i + wide::Width <= a.size) {
+            wide::StoreUnaligned(outFloats + i, d);
+        }
+        else {
+            wide::StorePartial(outFloats + i, d, a.size - i);
+        }
+    }
+}
+
+void Vector3Stream::MagnitudeSquared(const Vector3Stream& a, float* outFloats) {
+    Dot(a, a, outFloats);
+}
+
+void Vector3Stream::Magnitude(const Vector3Stream& a, float* outFloats) {
+    const size_t n = xo_internal::StreamSteps(a.size);
+    for (size_t i = 0; i < n; i += wide::Width) {
+        wide::Float ax = wide::Load(a.x + i), ay = wide::Load(a.y + i), az = wide::Load(a.z + i);
+        wide::Float m = wide::Sqrt(wide::MulAdd(ax, ax, wide::MulAdd(ay, ay, wide::Mul(az, az))));
+        if (i + wide::Width <= a.size) {
+            wide::StoreUnaligned(outFloats + i, m);
+        }
+        else {
+            wide::StorePartial(outFloats + i, m, a.size - i);
+        }
+    }
+}
+
+XOMATH_END_XO_NS();
@@ -126,7 +126,7 @@ Vector4::Vector4(const class Vector3& vec, float w) :
     xmm(vec.xmm)
 {
     //! @todo there's likely an sse way to do this.
-    w = w;
+    this->w = w;
 }
 #else
     x(vec.x), y(vec.y), z(vec.z), w(w)
@@ -162,7 +162,7 @@ Vector4& Vector4::Set(float f) {
     this->x = f;
     this->y = f;
     this->z = f;
-    this->w = w;
+    this->w = f;
 #endif
     return *this;
 }
@@ -257,9 +257,12 @@ void Vector4::Get(float* f) const {
 }
  
 float Vector4::Sum() const {
-#if defined(XO_SSE)
+#if defined(XO_SSE3)
     __m128 s = _mm_hadd_ps(xmm, xmm);
     return _mm_cvtss_f32(_mm_hadd_ps(s, s));
+#elif defined(XO_SSE)
+    __m128 s = _mm_add_ps(xmm, _mm_movehl_ps(xmm, xmm));
+    return _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1))));
 #else
     return x+y+z+w;
 #endif
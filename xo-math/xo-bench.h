@@ -0,0 +1,227 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+// Bench.h (version 0.2, October 2016)
+//
+//  A public domain single header file benchmarking module. C++11 or newer required.
+//
+//  AUTHOR
+//    Jared Thomson (@xoorath)
+//
+//  STREET CRED
+//    Inspired by Sean Barrett's stb. https://github.com/nothings
+//
+//  LICENSE
+//
+//   This software is dual-licensed to the public domain and under the following
+//   license: you are granted a perpetual, irrevocable license to copy, modify,
+//   publish, and distribute this file as you see fit.
+//////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define BENCH_HAS_RDTSC 1
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Bench
+//////////////////////////////////////////////////////////////////////////////////////////
+// Runs a function a number of times and reports the median and slowest time per operation,
+// throughput, and cycles per operation where rdtsc is available. Every result is kept so
+// the whole run can be written out as json afterwards. Example below.
+//////////////////////////////////////////////////////////////////////////////////////////
+/*
+ Bench bench;
+ std::vector<float> values(1024, 1.0f);
+ // one run of the function performs values.size() operations over values.size() * 4 bytes.
+ double nsPerOp = bench("sum", values.size(), values.size() * sizeof(float), [&values]{
+    float sum = 0.0f;
+    for(float f : values) sum += f;
+    // keep the optimizer from removing the loop.
+    DoNotOptimize(sum);
+  });
+ bench.WriteJson(std::cout, "sse4.2");
+*/
+//////////////////////////////////////////////////////////////////////////////////////////
+
+// Forces value to be computed, without otherwise using it.
+template<typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(_MSC_VER)
+  static const volatile void* s_Sink;
+  s_Sink = &value;
+#else
+  asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+// Forces all pending writes to memory to be treated as observable.
+inline void ClobberMemory() {
+#if defined(_MSC_VER)
+  _ReadWriteBarrier();
+#else
+  asm volatile("" : : : "memory");
+#endif
+}
+
+// Reads the time stamp counter, or 0 where there isn't one.
+inline uint64_t ReadCycles() {
+#if defined(BENCH_HAS_RDTSC)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+struct BenchResult {
+  std::string name;
+  size_t ops;
+  size_t bytes;          // bytes read and written by one run, 0 if not given.
+  double medianNs;       // nanoseconds per operation.
+  double maxNs;          // nanoseconds per operation, of the slowest repetition.
+  double medianCycles;   // time stamp counter ticks per operation, 0 without rdtsc.
+
+  double OpsPerSecond() const { return 1e9 / medianNs; }
+  double GigabytesPerSecond() const { return bytes ? bytes / (medianNs * ops) : 0.0; }
+};
+
+class Bench {
+  typedef std::function<void()> TBenchFunc;
+  typedef std::chrono::steady_clock TClock;
+  typedef std::chrono::duration<double, std::nano> TNanoseconds;
+
+public:
+  explicit Bench(int repetitions = 15, int warmups = 2) :
+    m_Repetitions(repetitions),
+    m_Warmups(warmups),
+    m_Quiet(false)
+  {
+  }
+
+  // Runs func m_Warmups times to warm the caches up, then times it m_Repetitions times.
+  // ops is the number of operations a single call to func performs.
+  // Returns the median nanoseconds per operation.
+  double operator ()(const char* benchName, size_t ops, TBenchFunc func) {
+    return (*this)(benchName, ops, 0, func);
+  }
+
+  // As above, where bytes is the memory traffic of a single call to func, for GB/s.
+  double operator ()(const char* benchName, size_t ops, size_t bytes, TBenchFunc func);
+
+  // Stops results from being printed as they come in. They are still recorded.
+  void SetQuiet(bool quiet) { m_Quiet = quiet; }
+
+  const std::vector<BenchResult>& Results() const { return m_Results; }
+
+  // Writes every result so far as a json object. config names the build, such as "avx".
+  void WriteJson(std::ostream& stream, const char* config) const;
+
+private:
+  static double Percentile(const std::vector<double>& sorted, double p);
+  static void WriteJsonString(std::ostream& stream, const std::string& str);
+
+  int m_Repetitions;
+  int m_Warmups;
+  bool m_Quiet;
+  std::vector<BenchResult> m_Results;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Bench
+//////////////////////////////////////////////////////////////////////////////////////////
+double Bench::operator ()(const char* benchName, size_t ops, size_t bytes, TBenchFunc func) {
+  std::vector<double> samples, cycles;
+  samples.reserve(m_Repetitions);
+  cycles.reserve(m_Repetitions);
+
+  for(int i = 0; i < m_Warmups; ++i) {
+    func();
+  }
+  for(int i = 0; i < m_Repetitions; ++i) {
+    TClock::time_point start = TClock::now();
+    uint64_t startCycles = ReadCycles();
+    func();
+    uint64_t endCycles = ReadCycles();
+    TClock::time_point end = TClock::now();
+    samples.push_back(TNanoseconds(end - start).count() / (double)ops);
+    cycles.push_back((endCycles - startCycles) / (double)ops);
+  }
+
+  std::sort(samples.begin(), samples.end());
+  std::sort(cycles.begin(), cycles.end());
+
+  BenchResult result;
+  result.name = benchName;
+  result.ops = ops;
+  result.bytes = bytes;
+  result.medianNs = Percentile(samples, 0.5);
+  result.maxNs = samples.back();
+  result.medianCycles = Percentile(cycles, 0.5);
+  m_Results.push_back(result);
+
+  if(!m_Quiet) {
+    std::cout << benchName << ": " << result.medianNs << " ns/op (max " << result.maxNs << ", "
+      << (result.OpsPerSecond() / 1e6) << " Mops/s";
+#if defined(BENCH_HAS_RDTSC)
+    std::cout << ", " << result.medianCycles << " cycles/op";
+#endif
+    if(bytes) {
+      std::cout << ", " << result.GigabytesPerSecond() << " GB/s";
+    }
+    std::cout << ")" << std::endl;
+  }
+  return result.medianNs;
+}
+
+void Bench::WriteJson(std::ostream& stream, const char* config) const {
+  stream << "{\n  \"config\": ";
+  WriteJsonString(stream, config);
+  stream << ",\n  \"repetitions\": " << m_Repetitions << ",\n  \"results\": [";
+  for(size_t i = 0; i < m_Results.size(); ++i) {
+    const BenchResult& r = m_Results[i];
+    stream << (i ? ",\n" : "\n") << "    {\"name\": ";
+    WriteJsonString(stream, r.name);
+    stream << ", \"ops\": " << r.ops
+      << ", \"bytes\": " << r.bytes
+      << ", \"ns_per_op\": " << r.medianNs
+      << ", \"ns_per_op_max\": " << r.maxNs
+      << ", \"ops_per_sec\": " << r.OpsPerSecond()
+      << ", \"gb_per_sec\": " << r.GigabytesPerSecond()
+      << ", \"cycles_per_op\": " << r.medianCycles << "}";
+  }
+  stream << "\n  ]\n}" << std::endl;
+}
+
+// Nearest rank percentile of already sorted samples.
+double Bench::Percentile(const std::vector<double>& sorted, double p) {
+  size_t rank = (size_t)std::ceil(p * sorted.size());
+  return sorted[rank ? rank - 1 : 0];
+}
+
+void Bench::WriteJsonString(std::ostream& stream, const std::string& str) {
+  stream << '"';
+  for(char c : str) {
+    if(c == '"' || c == '\\') {
+      stream << '\\' << c;
+    }
+    else if((unsigned char)c < 0x20) {
+      stream << ' ';
+    }
+    else {
+      stream << c;
+    }
+  }
+  stream << '"';
+}
\ No newline at end of file